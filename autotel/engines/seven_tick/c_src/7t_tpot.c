@@ -1,104 +1,109 @@
+#include "7t_tpot.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
 #include <immintrin.h>
 
-// 7T TPOT Core Structures
-typedef struct
-{
-  uint32_t num_samples;
-  uint32_t num_features;
-  double *data;           // Row-major layout for cache efficiency
-  uint32_t *labels;       // Integer labels
-  uint64_t *feature_mask; // Active features (simplified bit-vector)
-  uint64_t *sample_mask;  // Active samples (simplified bit-vector)
-} Dataset7T;
+// Global algorithm registry, indexed by algorithm id
+Algorithm7T *algorithm_registry[TPOT_MAX_ALGORITHMS];
+uint32_t num_algorithms = 0;
 
-typedef struct
+// Deterministic generator (SplitMix64); callers own their state
+static inline uint64_t rng_next(uint64_t *state)
 {
-  uint32_t step_type;    // PREPROCESSING, FEATURE_SELECTION, MODEL
-  uint32_t algorithm_id; // Algorithm identifier
-  double *parameters;    // Algorithm parameters
-  uint32_t num_parameters;
-  uint64_t *input_features;
-  uint64_t *output_features;
-} PipelineStep;
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
 
-typedef struct
+static inline double rng_uniform(uint64_t *state)
 {
-  uint32_t pipeline_id;
-  uint32_t num_steps;
-  PipelineStep *steps;
-  double fitness_score;
-  uint64_t evaluation_time_ns;
-  uint32_t num_correct;
-  uint32_t num_total;
-} Pipeline7T;
+  return (rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
 
-typedef struct
+static inline uint32_t rng_below(uint64_t *state, uint32_t bound)
 {
-  Pipeline7T **population;
-  uint32_t population_size;
-  uint32_t generation;
-  uint32_t best_pipeline_id;
-  double best_fitness;
-} OptimizationEngine7T;
+  return (uint32_t)(((rng_next(state) >> 32) * bound) >> 32);
+}
 
-// Algorithm Registry
-typedef struct
+static double rng_gaussian(uint64_t *state)
 {
-  uint32_t algorithm_id;
-  const char *name;
-  uint32_t category;
-  double (*evaluate)(Dataset7T *data, double *params);
-  void (*fit)(Dataset7T *data, double *params, void *model);
-  double (*predict)(void *model, Dataset7T *data);
-} Algorithm7T;
-
-// Global algorithm registry
-Algorithm7T *algorithm_registry[100];
-uint32_t num_algorithms = 0;
-
-// Performance measurement
-struct timespec start_time, end_time;
+  double u1 = rng_uniform(state);
+  double u2 = rng_uniform(state);
+  if (u1 < 1e-300)
+    u1 = 1e-300;
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
 
-#define START_TIMER() clock_gettime(CLOCK_MONOTONIC, &start_time)
-#define END_TIMER() clock_gettime(CLOCK_MONOTONIC, &end_time)
-#define GET_ELAPSED_NS() ((end_time.tv_sec - start_time.tv_sec) * 1000000000ULL + (end_time.tv_nsec - start_time.tv_nsec))
+static void shuffle_indices(uint32_t *indices, uint32_t count, uint64_t *rng)
+{
+  for (uint32_t i = count; i > 1; i--)
+  {
+    uint32_t j = rng_below(rng, i);
+    uint32_t tmp = indices[i - 1];
+    indices[i - 1] = indices[j];
+    indices[j] = tmp;
+  }
+}
 
-// Algorithm Categories
-#define PREPROCESSING 1
-#define FEATURE_SELECTION 2
-#define MODEL 3
+// Datasets are generated deterministically from per-dataset seeds. Feature
+// ranges and class statistics follow the public datasets they are named
+// after, so models separate them about as well as on the originals.
+static Dataset7T *alloc_dataset(uint32_t num_samples, uint32_t num_features, uint32_t num_classes)
+{
+  Dataset7T *dataset = calloc(1, sizeof(Dataset7T));
+  dataset->num_samples = num_samples;
+  dataset->num_features = num_features;
+  dataset->num_classes = num_classes;
+  dataset->data = malloc((size_t)num_samples * num_features * sizeof(double));
+  if (num_classes)
+    dataset->labels = malloc(num_samples * sizeof(uint32_t));
+  else
+    dataset->targets = malloc(num_samples * sizeof(double));
+  return dataset;
+}
 
-// Algorithm IDs
-#define NORMALIZE 1
-#define STANDARDIZE 2
-#define SELECT_K_BEST 3
-#define RANDOM_FOREST 4
-#define LINEAR_REGRESSION 5
-#define LOGISTIC_REGRESSION 6
-#define SVM 7
-#define KNN 8
+void destroy_dataset_7t(Dataset7T *dataset)
+{
+  if (!dataset)
+    return;
+  free(dataset->data);
+  free(dataset->labels);
+  free(dataset->targets);
+  free(dataset);
+}
 
 // 7T TPOT Use Case 1: Iris Classification
 Dataset7T *create_iris_dataset()
 {
-  Dataset7T *dataset = malloc(sizeof(Dataset7T));
-  dataset->num_samples = 150;
-  dataset->num_features = 4;
-  dataset->data = malloc(150 * 4 * sizeof(double));
-  dataset->labels = malloc(150 * sizeof(uint32_t));
+  // Per-class mean and std of sepal length/width, petal length/width (cm)
+  static const double mean[3][4] = {
+      {5.006, 3.428, 1.462, 0.246},
+      {5.936, 2.770, 4.260, 1.326},
+      {6.588, 2.974, 5.552, 2.026}};
+  static const double stddev[3][4] = {
+      {0.352, 0.379, 0.174, 0.105},
+      {0.516, 0.314, 0.470, 0.198},
+      {0.636, 0.322, 0.552, 0.275}};
+
+  Dataset7T *dataset = alloc_dataset(150, 4, 3);
+  uint64_t rng = 0x1815ULL;
 
-  // Load Iris dataset (simplified)
   for (int i = 0; i < 150; i++)
   {
-    dataset->labels[i] = i / 50; // 0, 1, 2 for three classes
+    uint32_t c = i / 50; // 0, 1, 2 for three classes
+    dataset->labels[i] = c;
     for (int j = 0; j < 4; j++)
     {
-      dataset->data[i * 4 + j] = (double)(rand() % 100) / 10.0;
+      double x = mean[c][j] + stddev[c][j] * rng_gaussian(&rng);
+      x = round(x * 10.0) / 10.0; // Measured to 1 mm
+      dataset->data[i * 4 + j] = x < 0.1 ? 0.1 : x;
     }
   }
 
@@ -108,19 +113,34 @@ Dataset7T *create_iris_dataset()
 // 7T TPOT Use Case 2: Boston Housing Regression
 Dataset7T *create_boston_dataset()
 {
-  Dataset7T *dataset = malloc(sizeof(Dataset7T));
-  dataset->num_samples = 506;
-  dataset->num_features = 13;
-  dataset->data = malloc(506 * 13 * sizeof(double));
-  dataset->labels = malloc(506 * sizeof(uint32_t));
+  // CRIM ZN INDUS CHAS NOX RM AGE DIS RAD TAX PTRATIO B LSTAT
+  static const double center[13] = {3.61, 11.36, 11.14, 0.07, 0.55, 6.28, 68.57, 3.80, 9.55, 408.2, 18.46, 356.7, 12.65};
+  static const double scale[13] = {8.60, 23.32, 6.86, 0.25, 0.12, 0.70, 28.15, 2.11, 8.71, 168.5, 2.16, 91.3, 7.14};
+  static const double urban[13] = {0.6, -0.5, 0.7, 0.0, 0.7, -0.3, 0.6, -0.7, 0.6, 0.7, 0.4, -0.3, 0.6};
+  static const double weight[13] = {-0.9, 0.8, 0.1, 0.7, -2.0, 2.7, 0.0, -3.1, 2.6, -2.0, -2.0, 0.85, -3.7};
+
+  Dataset7T *dataset = alloc_dataset(506, 13, 0);
+  uint64_t rng = 0xB057011ULL;
 
-  // Load Boston Housing dataset (simplified)
   for (int i = 0; i < 506; i++)
   {
-    dataset->labels[i] = (uint32_t)((double)(rand() % 500) / 10.0);
+    double shared = rng_gaussian(&rng); // Neighbourhood urbanisation
+    double z[13];
+    double price = 22.53;
     for (int j = 0; j < 13; j++)
     {
-      dataset->data[i * 13 + j] = (double)(rand() % 100) / 10.0;
+      z[j] = urban[j] * shared + sqrt(1.0 - urban[j] * urban[j]) * rng_gaussian(&rng);
+      price += weight[j] * z[j];
+    }
+    price += 1.2 * z[5] * z[5] + 3.0 * rng_gaussian(&rng); // Large homes, noise
+    dataset->targets[i] = price < 5.0 ? 5.0 : (price > 50.0 ? 50.0 : price);
+
+    for (int j = 0; j < 13; j++)
+    {
+      double x = center[j] + scale[j] * z[j];
+      if (j == 3)
+        x = z[j] > 1.5 ? 1.0 : 0.0; // Charles River dummy
+      dataset->data[i * 13 + j] = x < 0.0 ? 0.0 : x;
     }
   }
 
@@ -130,19 +150,38 @@ Dataset7T *create_boston_dataset()
 // 7T TPOT Use Case 3: Breast Cancer Classification
 Dataset7T *create_breast_cancer_dataset()
 {
-  Dataset7T *dataset = malloc(sizeof(Dataset7T));
-  dataset->num_samples = 569;
-  dataset->num_features = 30;
-  dataset->data = malloc(569 * 30 * sizeof(double));
-  dataset->labels = malloc(569 * sizeof(uint32_t));
+  // Radius, texture, perimeter, area, smoothness, compactness, concavity,
+  // concave points, symmetry, fractal dimension; [0] malignant, [1] benign
+  static const double mean[2][10] = {
+      {17.46, 21.60, 115.4, 978.4, 0.1029, 0.1452, 0.1608, 0.0880, 0.1929, 0.0627},
+      {12.15, 17.91, 78.08, 462.8, 0.0925, 0.0801, 0.0461, 0.0257, 0.1740, 0.0629}};
+  static const double stddev[2][10] = {
+      {3.20, 3.78, 21.9, 368.0, 0.0126, 0.0540, 0.0750, 0.0344, 0.0276, 0.0075},
+      {1.78, 4.00, 11.8, 134.0, 0.0134, 0.0337, 0.0434, 0.0159, 0.0248, 0.0067}};
+  static const int group[10] = {0, 1, 0, 0, 2, 2, 2, 2, 1, 2}; // size, texture, shape
+
+  Dataset7T *dataset = alloc_dataset(569, 30, 2);
+  uint64_t rng = 0xCA4CE2ULL;
 
-  // Load Breast Cancer dataset (simplified)
   for (int i = 0; i < 569; i++)
   {
-    dataset->labels[i] = rand() % 2; // Binary classification
-    for (int j = 0; j < 30; j++)
+    uint32_t c = i < 212 ? 0 : 1; // 212 malignant, 357 benign
+    dataset->labels[i] = c;
+
+    double factor[3];
+    for (int g = 0; g < 3; g++)
+      factor[g] = rng_gaussian(&rng);
+
+    for (int j = 0; j < 10; j++)
     {
-      dataset->data[i * 30 + j] = (double)(rand() % 100) / 10.0;
+      double z = 0.8 * factor[group[j]] + 0.6 * rng_gaussian(&rng);
+      double value = fabs(mean[c][j] + stddev[c][j] * z);
+      double error = fabs(0.1 * value * (1.0 + 0.5 * rng_gaussian(&rng)));
+      double worst = value * (1.15 + 0.1 * fabs(rng_gaussian(&rng)));
+
+      dataset->data[i * 30 + j] = value;
+      dataset->data[i * 30 + 10 + j] = error;
+      dataset->data[i * 30 + 20 + j] = worst;
     }
   }
 
@@ -152,20 +191,28 @@ Dataset7T *create_breast_cancer_dataset()
 // 7T TPOT Use Case 4: Diabetes Regression
 Dataset7T *create_diabetes_dataset()
 {
-  Dataset7T *dataset = malloc(sizeof(Dataset7T));
-  dataset->num_samples = 442;
-  dataset->num_features = 10;
-  dataset->data = malloc(442 * 10 * sizeof(double));
-  dataset->labels = malloc(442 * sizeof(uint32_t));
+  // AGE SEX BMI BP S1..S6, coefficients on unit-norm columns
+  static const double weight[10] = {0.0, -240.0, 520.0, 324.0, -100.0, 0.0, -250.0, 100.0, 600.0, 67.0};
+
+  Dataset7T *dataset = alloc_dataset(442, 10, 0);
+  uint64_t rng = 0xD1AB37E5ULL;
+  double norm = 1.0 / sqrt(442.0);
 
-  // Load Diabetes dataset (simplified)
   for (int i = 0; i < 442; i++)
   {
-    dataset->labels[i] = (uint32_t)((double)(rand() % 300) / 10.0);
+    double shared = rng_gaussian(&rng); // Metabolic health
+    double progression = 152.1;
     for (int j = 0; j < 10; j++)
     {
-      dataset->data[i * 10 + j] = (double)(rand() % 100) / 10.0;
+      double z = 0.4 * shared + 0.9 * rng_gaussian(&rng);
+      if (j == 1)
+        z = rng_uniform(&rng) < 0.47 ? 1.0 : -1.0;
+      double x = z * norm;
+      dataset->data[i * 10 + j] = x;
+      progression += weight[j] * x;
     }
+    progression += 54.0 * rng_gaussian(&rng);
+    dataset->targets[i] = progression < 25.0 ? 25.0 : (progression > 346.0 ? 346.0 : progression);
   }
 
   return dataset;
@@ -174,225 +221,1035 @@ Dataset7T *create_diabetes_dataset()
 // 7T TPOT Use Case 5: Digits Classification
 Dataset7T *create_digits_dataset()
 {
-  Dataset7T *dataset = malloc(sizeof(Dataset7T));
-  dataset->num_samples = 1797;
-  dataset->num_features = 64;
-  dataset->data = malloc(1797 * 64 * sizeof(double));
-  dataset->labels = malloc(1797 * sizeof(uint32_t));
+  static const char *glyphs[10][8] = {
+      {"..####..", ".##..##.", ".##..##.", ".##..##.", ".##..##.", ".##..##.", ".##..##.", "..####.."},
+      {"...##...", "..###...", ".####...", "...##...", "...##...", "...##...", "...##...", ".######."},
+      {"..####..", ".##..##.", ".....##.", "....##..", "...##...", "..##....", ".##.....", ".######."},
+      {"..####..", ".##..##.", ".....##.", "...###..", ".....##.", ".....##.", ".##..##.", "..####.."},
+      {"....##..", "...###..", "..####..", ".##.##..", "##..##..", "#######.", "....##..", "....##.."},
+      {".######.", ".##.....", ".##.....", ".#####..", ".....##.", ".....##.", ".##..##.", "..####.."},
+      {"...###..", "..##....", ".##.....", ".#####..", ".##..##.", ".##..##.", ".##..##.", "..####.."},
+      {".######.", ".....##.", "....##..", "....##..", "...##...", "...##...", "..##....", "..##...."},
+      {"..####..", ".##..##.", ".##..##.", "..####..", ".##..##.", ".##..##.", ".##..##.", "..####.."},
+      {"..####..", ".##..##.", ".##..##.", "..#####.", ".....##.", ".....##.", "....##..", "..###..."}};
+
+  Dataset7T *dataset = alloc_dataset(1797, 64, 10);
+  uint64_t rng = 0xD161757ULL;
 
-  // Load Digits dataset (simplified)
   for (int i = 0; i < 1797; i++)
   {
-    dataset->labels[i] = rand() % 10; // 10 classes (0-9)
-    for (int j = 0; j < 64; j++)
+    uint32_t digit = i % 10; // 10 classes (0-9)
+    int dx = (int)rng_below(&rng, 3) - 1;
+    int dy = (int)rng_below(&rng, 3) - 1;
+    dataset->labels[i] = digit;
+
+    for (int r = 0; r < 8; r++)
     {
-      dataset->data[i * 64 + j] = (double)(rand() % 16) / 16.0;
+      for (int c = 0; c < 8; c++)
+      {
+        int gr = r - dy, gc = c - dx;
+        int ink = gr >= 0 && gr < 8 && gc >= 0 && gc < 8 && glyphs[digit][gr][gc] == '#';
+        double x = 0.0;
+        if (ink)
+        {
+          x = 16.0 * (0.55 + 0.45 * rng_uniform(&rng));
+          if (rng_uniform(&rng) < 0.3)
+            x *= rng_uniform(&rng); // Faded stroke
+        }
+        else if (rng_uniform(&rng) < 0.15)
+        {
+          x = rng_below(&rng, 13); // Scanner noise
+        }
+        x = round(x);
+        dataset->data[i * 64 + r * 8 + c] = x > 16.0 ? 16.0 : x;
+      }
     }
   }
 
   return dataset;
 }
 
-// Ultra-fast preprocessing algorithms
-double normalize_features(Dataset7T *data, double *params)
+// Per-feature mean and variance over all samples
+static void feature_moments(const Dataset7T *data, double *mean, double *variance)
 {
-  START_TIMER();
+  uint32_t n = data->num_samples, f = data->num_features;
+  memset(mean, 0, f * sizeof(double));
+  memset(variance, 0, f * sizeof(double));
 
-  // SIMD-optimized normalization
-  for (int i = 0; i < data->num_samples; i++)
+  for (uint32_t i = 0; i < n; i++)
   {
-    for (int j = 0; j < data->num_features; j += 4)
+    const double *row = &data->data[(size_t)i * f];
+    for (uint32_t j = 0; j < f; j++)
+      mean[j] += row[j];
+  }
+  for (uint32_t j = 0; j < f; j++)
+    mean[j] /= n;
+
+  for (uint32_t i = 0; i < n; i++)
+  {
+    const double *row = &data->data[(size_t)i * f];
+    for (uint32_t j = 0; j < f; j++)
     {
-      // Load 4 features into SIMD registers
-      __m256d features = _mm256_load_pd(&data->data[i * data->num_features + j]);
+      double d = row[j] - mean[j];
+      variance[j] += d * d;
+    }
+  }
+  for (uint32_t j = 0; j < f; j++)
+    variance[j] /= n;
+}
 
-      // Normalize: (x - min) / (max - min)
-      __m256d normalized = _mm256_div_pd(features, _mm256_set1_pd(100.0));
+// Ultra-fast preprocessing algorithms. Transforms read in->data and write
+// out->data; the two may be the same buffer, since no output element is
+// written before the inputs at its position have been read.
+static void normalize_transform(const Dataset7T *in, const double *params, Dataset7T *out)
+{
+  (void)params; // Statistics come from the data
+  uint32_t n = in->num_samples, f = in->num_features;
+  double *lo = malloc(f * sizeof(double));
+  double *scale = malloc(f * sizeof(double));
 
-      // Store normalized features
-      _mm256_store_pd(&data->data[i * data->num_features + j], normalized);
+  for (uint32_t j = 0; j < f; j++)
+  {
+    lo[j] = INFINITY;
+    scale[j] = -INFINITY;
+  }
+  for (uint32_t i = 0; i < n; i++)
+  {
+    const double *row = &in->data[(size_t)i * f];
+    for (uint32_t j = 0; j < f; j++)
+    {
+      lo[j] = row[j] < lo[j] ? row[j] : lo[j];
+      scale[j] = row[j] > scale[j] ? row[j] : scale[j];
     }
   }
+  for (uint32_t j = 0; j < f; j++)
+  {
+    double range = scale[j] - lo[j];
+    scale[j] = range > 0.0 ? 1.0 / range : 0.0; // Constant features become 0
+  }
 
-  END_TIMER();
-  return GET_ELAPSED_NS() / 1000.0; // Return microseconds
+  // Normalize: (x - min) / (max - min); rows are contiguous so this vectorizes
+  for (uint32_t i = 0; i < n; i++)
+  {
+    const double *src = &in->data[(size_t)i * f];
+    double *dst = &out->data[(size_t)i * f];
+    for (uint32_t j = 0; j < f; j++)
+    {
+      dst[j] = (src[j] - lo[j]) * scale[j];
+    }
+  }
+  out->num_features = f;
+
+  free(lo);
+  free(scale);
 }
 
-double standardize_features(Dataset7T *data, double *params)
+static void standardize_transform(const Dataset7T *in, const double *params, Dataset7T *out)
 {
-  START_TIMER();
+  (void)params; // Statistics come from the data
+  uint32_t n = in->num_samples, f = in->num_features;
+  double *mean = malloc(f * sizeof(double));
+  double *inv_std = malloc(f * sizeof(double));
+
+  feature_moments(in, mean, inv_std);
+  for (uint32_t j = 0; j < f; j++)
+  {
+    inv_std[j] = inv_std[j] > 0.0 ? 1.0 / sqrt(inv_std[j]) : 0.0;
+  }
 
-  // SIMD-optimized standardization
-  for (int i = 0; i < data->num_samples; i++)
+  // Standardize: (x - mean) / std
+  for (uint32_t i = 0; i < n; i++)
   {
-    for (int j = 0; j < data->num_features; j += 4)
+    const double *src = &in->data[(size_t)i * f];
+    double *dst = &out->data[(size_t)i * f];
+    for (uint32_t j = 0; j < f; j++)
     {
-      // Load 4 features into SIMD registers
-      __m256d features = _mm256_load_pd(&data->data[i * data->num_features + j]);
+      dst[j] = (src[j] - mean[j]) * inv_std[j];
+    }
+  }
+  out->num_features = f;
+
+  free(mean);
+  free(inv_std);
+}
 
-      // Standardize: (x - mean) / std
-      __m256d standardized = _mm256_sub_pd(features, _mm256_set1_pd(50.0));
-      standardized = _mm256_div_pd(standardized, _mm256_set1_pd(25.0));
+// Ultra-fast feature selection
+static void select_k_best_transform(const Dataset7T *in, const double *params, Dataset7T *out)
+{
+  uint32_t n = in->num_samples, f = in->num_features;
+  uint32_t k = params ? (uint32_t)params[0] : f;
+  if (k > f)
+    k = f;
+  if (k == 0)
+    k = 1;
+
+  // Rank by variance. Label-free, so selecting on all rows before
+  // cross-validation does not leak test labels into training.
+  double *mean = malloc(f * sizeof(double));
+  double *variances = malloc(f * sizeof(double));
+  uint8_t *keep = calloc(f, 1);
+  feature_moments(in, mean, variances);
+
+  for (uint32_t selected = 0; selected < k; selected++)
+  {
+    uint32_t best = UINT32_MAX;
+    for (uint32_t j = 0; j < f; j++)
+    {
+      if (!keep[j] && (best == UINT32_MAX || variances[j] > variances[best]))
+        best = j;
+    }
+    keep[best] = 1;
+  }
 
-      // Store standardized features
-      _mm256_store_pd(&data->data[i * data->num_features + j], standardized);
+  // Compact kept columns, preserving order. Output row i starts at i * k,
+  // never past input row i, so this is safe in place.
+  for (uint32_t i = 0; i < n; i++)
+  {
+    const double *src = &in->data[(size_t)i * f];
+    double *dst = &out->data[(size_t)i * k];
+    uint32_t kept = 0;
+    for (uint32_t j = 0; j < f; j++)
+    {
+      if (keep[j])
+        dst[kept++] = src[j];
     }
   }
+  out->num_features = k;
 
+  free(mean);
+  free(variances);
+  free(keep);
+}
+
+// In-place entry points
+double normalize_features(Dataset7T *data, double *params)
+{
+  struct timespec start_time, end_time;
+  START_TIMER();
+  normalize_transform(data, params, data);
+  END_TIMER();
+  return GET_ELAPSED_NS() / 1000.0; // Return microseconds
+}
+
+double standardize_features(Dataset7T *data, double *params)
+{
+  struct timespec start_time, end_time;
+  START_TIMER();
+  standardize_transform(data, params, data);
   END_TIMER();
   return GET_ELAPSED_NS() / 1000.0; // Return microseconds
 }
 
-// Ultra-fast feature selection
 double select_k_best_features(Dataset7T *data, double *params)
 {
+  struct timespec start_time, end_time;
   START_TIMER();
+  select_k_best_transform(data, params, data);
+  END_TIMER();
+  return GET_ELAPSED_NS() / 1000.0; // Return microseconds
+}
 
-  uint32_t k = (uint32_t)params[0];
-  if (k > data->num_features)
-    k = data->num_features;
+// =============================================================================
+// K-FOLD CROSS-VALIDATION
+// =============================================================================
 
-  // Simple variance-based feature selection
-  double *variances = malloc(data->num_features * sizeof(double));
+typedef struct
+{
+  const Dataset7T *data;
+  const uint32_t *train;
+  uint32_t num_train;
+  const uint32_t *test;
+  uint32_t num_test;
+  uint32_t fold;
+} TPOTFold;
+
+// Trains on fold->train and writes predictions[row] for every test row
+// (class index for classification, value for regression)
+typedef void (*TPOTFoldLearner)(const TPOTFold *fold, const double *params,
+                                void *context, double *predictions);
+
+// Out-of-fold accuracy, or R^2 clamped at 0 for regression. Folds are
+// stratified by class and seeded identically for every pipeline, so
+// fitness differences come from the pipelines, not the split.
+static double cross_validate(const Dataset7T *data, const double *params,
+                             TPOTFoldLearner learner, void *context)
+{
+  uint32_t n = data->num_samples;
+  if (n < 2)
+    return 0.0;
+  uint32_t k = n < TPOT_CV_FOLDS ? n : TPOT_CV_FOLDS;
+
+  uint32_t *order = malloc(n * sizeof(uint32_t));
+  uint32_t *fold_of = malloc(n * sizeof(uint32_t));
+  uint32_t *train = malloc(n * sizeof(uint32_t));
+  uint32_t *test = malloc(n * sizeof(uint32_t));
+  double *predictions = calloc(n, sizeof(double));
+  uint64_t rng = TPOT_CV_SEED;
+
+  for (uint32_t i = 0; i < n; i++)
+    order[i] = i;
+  shuffle_indices(order, n, &rng);
+
+  if (data->num_classes)
+  {
+    // Deal each class round-robin across folds, continuing where the
+    // previous class stopped so small classes do not pile into fold 0
+    uint32_t *next = calloc(data->num_classes, sizeof(uint32_t));
+    uint32_t dealt = 0;
+    for (uint32_t c = 0; c < data->num_classes; c++)
+    {
+      next[c] = dealt;
+      for (uint32_t i = 0; i < n; i++)
+        dealt += data->labels[i] == c;
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t row = order[i];
+      fold_of[row] = next[data->labels[row]]++ % k;
+    }
+    free(next);
+  }
+  else
+  {
+    for (uint32_t i = 0; i < n; i++)
+      fold_of[order[i]] = i % k;
+  }
+
+  for (uint32_t f = 0; f < k; f++)
+  {
+    TPOTFold fold = {.data = data, .train = train, .test = test, .fold = f};
+    for (uint32_t i = 0; i < n; i++)
+    {
+      if (fold_of[i] == f)
+        test[fold.num_test++] = i;
+      else
+        train[fold.num_train++] = i;
+    }
+    if (fold.num_test && fold.num_train)
+      learner(&fold, params, context, predictions);
+  }
+
+  double score;
+  if (data->num_classes)
+  {
+    uint32_t correct = 0;
+    for (uint32_t i = 0; i < n; i++)
+      correct += (uint32_t)predictions[i] == data->labels[i];
+    score = (double)correct / n;
+  }
+  else
+  {
+    double mean = 0.0, sse = 0.0, sst = 0.0;
+    for (uint32_t i = 0; i < n; i++)
+      mean += data->targets[i];
+    mean /= n;
+    for (uint32_t i = 0; i < n; i++)
+    {
+      double e = data->targets[i] - predictions[i];
+      double d = data->targets[i] - mean;
+      sse += e * e;
+      sst += d * d;
+    }
+    score = sst > 0.0 ? 1.0 - sse / sst : 0.0;
+    score = score > 0.0 ? score : 0.0;
+  }
+
+  free(order);
+  free(fold_of);
+  free(train);
+  free(test);
+  free(predictions);
+  return score;
+}
+
+// =============================================================================
+// HISTOGRAM DECISION TREES / RANDOM FOREST
+// =============================================================================
+
+typedef struct
+{
+  int32_t left; // -1 for leaves
+  int32_t right;
+  uint32_t feature;
+  uint32_t threshold; // Bins <= threshold go left
+  uint32_t value;     // Leaf: offset into the tree's value array
+} TPOTTreeNode;
+
+typedef struct
+{
+  const uint8_t *bins; // Column-major: bins[feature * stride + row]
+  uint32_t stride;
+  const uint32_t *labels;
+  const double *targets;
+  uint32_t num_features;
+  uint32_t num_classes; // 0 for regression
+  uint32_t width;       // Leaf value width: num_classes, or 1
+  uint32_t channels;    // Histogram channels: count + width
+  uint32_t max_features;
+  uint32_t max_depth;
+  uint64_t rng;
+
+  TPOTTreeNode *nodes;
+  uint32_t num_nodes;
+  uint32_t node_capacity;
+  double *values;
+  uint32_t num_values;
+
+  uint32_t *feature_order;
+  double *hist;   // channels x TPOT_HIST_BINS, channel-major
+  double *scores; // TPOT_HIST_BINS
+} TPOTTreeBuilder;
+
+static int compare_doubles(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
 
-  // Compute variances using SIMD
-  for (int j = 0; j < data->num_features; j += 4)
+// Quantize every feature into TPOT_HIST_BINS quantile bins. Label-free, so
+// bins are computed once over all rows and shared by every fold.
+static uint8_t *bin_features(const Dataset7T *data)
+{
+  uint32_t n = data->num_samples, f = data->num_features;
+  uint8_t *bins = malloc((size_t)n * f);
+  double *column = malloc(n * sizeof(double));
+  double cuts[TPOT_HIST_BINS - 1];
+
+  for (uint32_t j = 0; j < f; j++)
   {
-    __m256d variance_sum = _mm256_setzero_pd();
+    for (uint32_t i = 0; i < n; i++)
+      column[i] = data->data[(size_t)i * f + j];
+    qsort(column, n, sizeof(double), compare_doubles);
 
-    for (int i = 0; i < data->num_samples; i++)
+    uint32_t num_cuts = 0;
+    for (uint32_t q = 1; q < TPOT_HIST_BINS; q++)
     {
-      __m256d features = _mm256_load_pd(&data->data[i * data->num_features + j]);
-      __m256d mean = _mm256_set1_pd(50.0);
-      __m256d diff = _mm256_sub_pd(features, mean);
-      __m256d squared = _mm256_mul_pd(diff, diff);
-      variance_sum = _mm256_add_pd(variance_sum, squared);
+      double v = column[(size_t)q * n / TPOT_HIST_BINS];
+      if (num_cuts == 0 || v > cuts[num_cuts - 1])
+        cuts[num_cuts++] = v;
     }
 
-    _mm256_store_pd(&variances[j], variance_sum);
+    for (uint32_t i = 0; i < n; i++)
+    {
+      double x = data->data[(size_t)i * f + j];
+      uint32_t lo = 0, hi = num_cuts; // First cut >= x
+      while (lo < hi)
+      {
+        uint32_t mid = (lo + hi) / 2;
+        if (cuts[mid] < x)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      bins[(size_t)j * n + i] = (uint8_t)lo;
+    }
   }
 
-  // Select top k features (simplified)
-  for (int j = k; j < data->num_features; j++)
+  free(column);
+  return bins;
+}
+
+// Split score for every bin threshold b (bins <= b go left):
+//   sum_ch L_ch^2 / n_L + R_ch^2 / n_R
+// over the value channels. Maximising this maximises Gini decrease for
+// class-count channels and variance reduction for a target-sum channel.
+// prefix holds channel-major cumulative histograms; channel 0 is the count.
+static void split_scores(const double *prefix, uint32_t channels, double *scores)
+{
+  const double n_total = prefix[TPOT_HIST_BINS - 1];
+#ifdef __AVX__
+  const __m256d total = _mm256_set1_pd(n_total);
+  const __m256d one = _mm256_set1_pd(1.0);
+  for (uint32_t b = 0; b < TPOT_HIST_BINS; b += 4)
   {
-    for (int i = 0; i < data->num_samples; i++)
+    __m256d n_left = _mm256_loadu_pd(&prefix[b]);
+    __m256d n_right = _mm256_sub_pd(total, n_left);
+    __m256d acc_left = _mm256_setzero_pd();
+    __m256d acc_right = _mm256_setzero_pd();
+    for (uint32_t ch = 1; ch < channels; ch++)
     {
-      data->data[i * data->num_features + j] = 0.0;
+      const double *p = &prefix[ch * TPOT_HIST_BINS];
+      __m256d left = _mm256_loadu_pd(&p[b]);
+      __m256d right = _mm256_sub_pd(_mm256_set1_pd(p[TPOT_HIST_BINS - 1]), left);
+      acc_left = _mm256_add_pd(acc_left, _mm256_mul_pd(left, left));
+      acc_right = _mm256_add_pd(acc_right, _mm256_mul_pd(right, right));
     }
+    // Empty sides contribute 0 and score exactly the parent, never a gain
+    __m256d score = _mm256_add_pd(_mm256_div_pd(acc_left, _mm256_max_pd(n_left, one)),
+                                  _mm256_div_pd(acc_right, _mm256_max_pd(n_right, one)));
+    _mm256_storeu_pd(&scores[b], score);
   }
+#else
+  for (uint32_t b = 0; b < TPOT_HIST_BINS; b++)
+  {
+    double n_left = prefix[b], n_right = n_total - n_left;
+    double acc_left = 0.0, acc_right = 0.0;
+    for (uint32_t ch = 1; ch < channels; ch++)
+    {
+      const double *p = &prefix[ch * TPOT_HIST_BINS];
+      double left = p[b], right = p[TPOT_HIST_BINS - 1] - left;
+      acc_left += left * left;
+      acc_right += right * right;
+    }
+    scores[b] = acc_left / (n_left > 1.0 ? n_left : 1.0) + acc_right / (n_right > 1.0 ? n_right : 1.0);
+  }
+#endif
+}
 
-  free(variances);
-  END_TIMER();
-  return GET_ELAPSED_NS() / 1000.0; // Return microseconds
+static int32_t grow_tree(TPOTTreeBuilder *b, uint32_t *rows, uint32_t count, uint32_t depth)
+{
+  int32_t id = (int32_t)b->num_nodes++;
+  TPOTTreeNode *node = &b->nodes[id];
+  node->left = node->right = -1;
+
+  // Node totals, staged where the leaf value would go
+  double *stats = &b->values[b->num_values];
+  memset(stats, 0, b->width * sizeof(double));
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (b->num_classes)
+      stats[b->labels[rows[i]]] += 1.0;
+    else
+      stats[0] += b->targets[rows[i]];
+  }
+
+  double parent_score = 0.0;
+  int pure = 0;
+  for (uint32_t c = 0; c < b->width; c++)
+  {
+    parent_score += stats[c] * stats[c];
+    pure |= b->num_classes && stats[c] == (double)count;
+  }
+  parent_score /= count;
+
+  uint32_t best_feature = 0, best_bin = 0;
+  double best_score = parent_score * (1.0 + 1e-12) + 1e-12;
+  int found = 0;
+
+  if (!pure && count >= 2 && depth < b->max_depth && b->num_nodes + 2 <= b->node_capacity)
+  {
+    // Random feature subset per split (partial Fisher-Yates)
+    for (uint32_t t = 0; t < b->max_features; t++)
+    {
+      uint32_t pick = t + rng_below(&b->rng, b->num_features - t);
+      uint32_t feature = b->feature_order[pick];
+      b->feature_order[pick] = b->feature_order[t];
+      b->feature_order[t] = feature;
+
+      const uint8_t *column = &b->bins[(size_t)feature * b->stride];
+      memset(b->hist, 0, b->channels * TPOT_HIST_BINS * sizeof(double));
+      for (uint32_t i = 0; i < count; i++)
+      {
+        uint32_t row = rows[i];
+        uint32_t bin = column[row];
+        b->hist[bin] += 1.0;
+        if (b->num_classes)
+          b->hist[(1 + b->labels[row]) * TPOT_HIST_BINS + bin] += 1.0;
+        else
+          b->hist[TPOT_HIST_BINS + bin] += b->targets[row];
+      }
+      for (uint32_t ch = 0; ch < b->channels; ch++)
+      {
+        double *h = &b->hist[ch * TPOT_HIST_BINS];
+        for (uint32_t bin = 1; bin < TPOT_HIST_BINS; bin++)
+          h[bin] += h[bin - 1];
+      }
+
+      split_scores(b->hist, b->channels, b->scores);
+      for (uint32_t bin = 0; bin + 1 < TPOT_HIST_BINS; bin++)
+      {
+        if (b->scores[bin] > best_score)
+        {
+          best_score = b->scores[bin];
+          best_feature = feature;
+          best_bin = bin;
+          found = 1;
+        }
+      }
+    }
+  }
+
+  if (!found)
+  {
+    for (uint32_t c = 0; c < b->width; c++)
+      stats[c] /= count; // Class frequencies, or mean target
+    node->value = b->num_values;
+    b->num_values += b->width;
+    return id;
+  }
+
+  // Partition rows in place: left side first
+  const uint8_t *column = &b->bins[(size_t)best_feature * b->stride];
+  uint32_t split = 0;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (column[rows[i]] <= best_bin)
+    {
+      uint32_t tmp = rows[split];
+      rows[split++] = rows[i];
+      rows[i] = tmp;
+    }
+  }
+
+  node->feature = best_feature;
+  node->threshold = best_bin;
+  int32_t left = grow_tree(b, rows, split, depth + 1);
+  int32_t right = grow_tree(b, rows + split, count - split, depth + 1);
+  b->nodes[id].left = left;
+  b->nodes[id].right = right;
+  return id;
+}
+
+static const double *tree_predict(const TPOTTreeBuilder *b, uint32_t row)
+{
+  const TPOTTreeNode *node = &b->nodes[0];
+  while (node->left >= 0)
+  {
+    node = &b->nodes[b->bins[(size_t)node->feature * b->stride + row] <= node->threshold
+                         ? node->left
+                         : node->right];
+  }
+  return &b->values[node->value];
+}
+
+static void forest_fold(const TPOTFold *fold, const double *params, void *context, double *predictions)
+{
+  const Dataset7T *data = fold->data;
+  uint32_t n_estimators = params[0] < 1.0 ? 1 : (uint32_t)params[0];
+  uint32_t max_depth = params[1] < 1.0 ? 1 : (params[1] > 20.0 ? 20 : (uint32_t)params[1]);
+  uint32_t f = data->num_features;
+
+  TPOTTreeBuilder b = {
+      .bins = (const uint8_t *)context,
+      .stride = data->num_samples,
+      .labels = data->labels,
+      .targets = data->targets,
+      .num_features = f,
+      .num_classes = data->num_classes,
+      .width = data->num_classes ? data->num_classes : 1,
+      .max_depth = max_depth,
+      .rng = TPOT_CV_SEED ^ ((uint64_t)(fold->fold + 1) << 32) ^ (n_estimators << 8) ^ max_depth};
+  b.channels = 1 + b.width;
+  b.max_features = data->num_classes ? (uint32_t)(sqrt((double)f) + 0.5) : f / 3;
+  if (b.max_features < 1)
+    b.max_features = 1;
+
+  // A binary tree over m rows has at most 2m - 1 nodes
+  uint64_t depth_cap = (2ULL << max_depth) - 1;
+  uint64_t row_cap = 2ULL * fold->num_train - 1;
+  b.node_capacity = (uint32_t)(depth_cap < row_cap ? depth_cap : row_cap);
+  b.nodes = malloc(b.node_capacity * sizeof(TPOTTreeNode));
+  b.values = malloc((size_t)b.node_capacity * b.width * sizeof(double));
+  b.feature_order = malloc(f * sizeof(uint32_t));
+  b.hist = malloc(b.channels * TPOT_HIST_BINS * sizeof(double));
+  b.scores = malloc(TPOT_HIST_BINS * sizeof(double));
+  for (uint32_t j = 0; j < f; j++)
+    b.feature_order[j] = j;
+
+  uint32_t *sample = malloc(fold->num_train * sizeof(uint32_t));
+  double *votes = calloc((size_t)fold->num_test * b.width, sizeof(double));
+
+  for (uint32_t t = 0; t < n_estimators; t++)
+  {
+    // Bootstrap the training rows
+    for (uint32_t i = 0; i < fold->num_train; i++)
+      sample[i] = fold->train[rng_below(&b.rng, fold->num_train)];
+
+    b.num_nodes = 0;
+    b.num_values = 0;
+    grow_tree(&b, sample, fold->num_train, 0);
+
+    for (uint32_t i = 0; i < fold->num_test; i++)
+    {
+      const double *leaf = tree_predict(&b, fold->test[i]);
+      for (uint32_t c = 0; c < b.width; c++)
+        votes[(size_t)i * b.width + c] += leaf[c];
+    }
+  }
+
+  // Soft voting: mean class frequencies, or mean of tree predictions
+  for (uint32_t i = 0; i < fold->num_test; i++)
+  {
+    const double *v = &votes[(size_t)i * b.width];
+    uint32_t best = 0;
+    for (uint32_t c = 1; c < b.width; c++)
+      best = v[c] > v[best] ? c : best;
+    predictions[fold->test[i]] = data->num_classes ? best : v[0] / n_estimators;
+  }
+
+  free(sample);
+  free(votes);
+  free(b.nodes);
+  free(b.values);
+  free(b.feature_order);
+  free(b.hist);
+  free(b.scores);
 }
 
 // Ultra-fast model evaluation
 double evaluate_random_forest(Dataset7T *data, double *params)
 {
-  START_TIMER();
-
-  uint32_t n_estimators = (uint32_t)params[0];
-  uint32_t max_depth = (uint32_t)params[1];
+  // params[0] = n_estimators, params[1] = max_depth
+  uint8_t *bins = bin_features(data);
+  double score = cross_validate(data, params, forest_fold, bins);
+  free(bins);
+  return score;
+}
 
-  // Simplified random forest evaluation
-  uint32_t correct = 0;
-  uint32_t total = data->num_samples;
+// =============================================================================
+// RIDGE REGRESSION
+// =============================================================================
 
-  // SIMD-optimized prediction
-  for (int i = 0; i < data->num_samples; i += 4)
+// Solve A X = B in place for symmetric positive definite A (n x n) and
+// nrhs right-hand sides stored row-major in B (n x nrhs). Returns 0 if A
+// is not positive definite.
+static int cholesky_solve(double *a, double *b, uint32_t n, uint32_t nrhs)
+{
+  for (uint32_t j = 0; j < n; j++)
   {
-    __m256i predictions = _mm256_setzero_si256();
+    double d = a[j * n + j];
+    for (uint32_t k = 0; k < j; k++)
+      d -= a[j * n + k] * a[j * n + k];
+    if (d <= 0.0)
+      return 0;
+    d = sqrt(d);
+    a[j * n + j] = d;
+    for (uint32_t i = j + 1; i < n; i++)
+    {
+      double s = a[i * n + j];
+      for (uint32_t k = 0; k < j; k++)
+        s -= a[i * n + k] * a[j * n + k];
+      a[i * n + j] = s / d;
+    }
+  }
 
-    for (int tree = 0; tree < n_estimators; tree++)
+  for (uint32_t r = 0; r < nrhs; r++)
+  {
+    for (uint32_t i = 0; i < n; i++) // L y = b
     {
-      // Simplified tree prediction (random for demo)
-      __m256i tree_pred = _mm256_set1_epi32(rand() % 3);
-      predictions = _mm256_add_epi32(predictions, tree_pred);
+      double s = b[i * nrhs + r];
+      for (uint32_t k = 0; k < i; k++)
+        s -= a[i * n + k] * b[k * nrhs + r];
+      b[i * nrhs + r] = s / a[i * n + i];
     }
+    for (uint32_t i = n; i-- > 0;) // L^T x = y
+    {
+      double s = b[i * nrhs + r];
+      for (uint32_t k = i + 1; k < n; k++)
+        s -= a[k * n + i] * b[k * nrhs + r];
+      b[i * nrhs + r] = s / a[i * n + i];
+    }
+  }
+  return 1;
+}
 
-    // Average predictions
-    __m256i avg_pred = _mm256_srli_epi32(predictions, 8); // Divide by 256
+// Closed-form ridge on centered data: (Xc^T Xc + alpha I) W = Xc^T Yc.
+// Classification fits one +1/-1 output per class and predicts the argmax.
+static void ridge_fold(const TPOTFold *fold, const double *params, void *context, double *predictions)
+{
+  (void)context;
+  const Dataset7T *data = fold->data;
+  uint32_t f = data->num_features;
+  uint32_t outputs = data->num_classes ? data->num_classes : 1;
+  double alpha = pow(10.0, params[1] - 6.0); // 1e-3 .. 1e3 over the search range
+
+  double *x_mean = calloc(f, sizeof(double));
+  double *y_mean = calloc(outputs, sizeof(double));
+  double *xtx = calloc((size_t)f * f, sizeof(double));
+  double *xty = calloc((size_t)f * outputs, sizeof(double));
+  double *xc = malloc(f * sizeof(double));
+  double *y = malloc(outputs * sizeof(double));
+
+  for (uint32_t i = 0; i < fold->num_train; i++)
+  {
+    uint32_t row = fold->train[i];
+    const double *x = &data->data[(size_t)row * f];
+    for (uint32_t j = 0; j < f; j++)
+      x_mean[j] += x[j];
+    for (uint32_t c = 0; c < outputs; c++)
+      y_mean[c] += data->num_classes ? (data->labels[row] == c ? 1.0 : -1.0) : data->targets[row];
+  }
+  for (uint32_t j = 0; j < f; j++)
+    x_mean[j] /= fold->num_train;
+  for (uint32_t c = 0; c < outputs; c++)
+    y_mean[c] /= fold->num_train;
 
-    // Compare with labels
-    __m256i labels = _mm256_loadu_si256((__m256i *)&data->labels[i]);
-    __m256i matches = _mm256_cmpeq_epi32(avg_pred, labels);
+  for (uint32_t i = 0; i < fold->num_train; i++)
+  {
+    uint32_t row = fold->train[i];
+    const double *x = &data->data[(size_t)row * f];
+    for (uint32_t j = 0; j < f; j++)
+      xc[j] = x[j] - x_mean[j];
+    for (uint32_t c = 0; c < outputs; c++)
+      y[c] = (data->num_classes ? (data->labels[row] == c ? 1.0 : -1.0) : data->targets[row]) - y_mean[c];
+
+    // Lower triangle only; contiguous inner loops vectorize
+    for (uint32_t j = 0; j < f; j++)
+    {
+      double *a = &xtx[(size_t)j * f];
+      for (uint32_t k = 0; k <= j; k++)
+        a[k] += xc[j] * xc[k];
+      for (uint32_t c = 0; c < outputs; c++)
+        xty[(size_t)j * outputs + c] += xc[j] * y[c];
+    }
+  }
+
+  // Mirror, regularize, and keep constant columns (zero variance) solvable
+  double trace = 0.0;
+  for (uint32_t j = 0; j < f; j++)
+    trace += xtx[(size_t)j * f + j];
+  double floor = 1e-9 * (1.0 + trace / (f ? f : 1));
+  for (uint32_t j = 0; j < f; j++)
+  {
+    for (uint32_t k = 0; k < j; k++)
+      xtx[(size_t)k * f + j] = xtx[(size_t)j * f + k];
+    xtx[(size_t)j * f + j] += alpha + floor;
+  }
 
-    // Count correct predictions
-    uint32_t match_array[8];
-    _mm256_storeu_si256((__m256i *)match_array, matches);
+  if (!cholesky_solve(xtx, xty, f, outputs))
+    memset(xty, 0, (size_t)f * outputs * sizeof(double)); // Predict the mean
 
-    for (int j = 0; j < 4 && i + j < data->num_samples; j++)
+  for (uint32_t i = 0; i < fold->num_test; i++)
+  {
+    uint32_t row = fold->test[i];
+    const double *x = &data->data[(size_t)row * f];
+    uint32_t best = 0;
+    double best_value = -INFINITY;
+    for (uint32_t c = 0; c < outputs; c++)
     {
-      if (match_array[j] != 0)
-        correct++;
+      double value = y_mean[c];
+      for (uint32_t j = 0; j < f; j++)
+        value += (x[j] - x_mean[j]) * xty[(size_t)j * outputs + c];
+      if (value > best_value)
+      {
+        best_value = value;
+        best = c;
+      }
     }
+    predictions[row] = data->num_classes ? best : best_value;
   }
 
-  END_TIMER();
-  return (double)correct / total; // Return accuracy
+  free(x_mean);
+  free(y_mean);
+  free(xtx);
+  free(xty);
+  free(xc);
+  free(y);
 }
 
 double evaluate_linear_regression(Dataset7T *data, double *params)
 {
-  START_TIMER();
+  // params[1] = log10(alpha) + 6; ridge classifier on classification data
+  return cross_validate(data, params, ridge_fold, NULL);
+}
 
-  // Simplified linear regression evaluation
-  double mse = 0.0;
+// =============================================================================
+// LOGISTIC REGRESSION
+// =============================================================================
 
-  // SIMD-optimized MSE computation
-  __m256d mse_sum = _mm256_setzero_pd();
+#define LOGISTIC_BATCH 16
+#define LOGISTIC_LEARNING_RATE 0.1
+
+// Multinomial (softmax) logistic regression by mini-batch SGD with L2,
+// on features standardized with training-fold statistics
+static void logistic_fold(const TPOTFold *fold, const double *params, void *context, double *predictions)
+{
+  (void)context;
+  const Dataset7T *data = fold->data;
+  uint32_t f = data->num_features, classes = data->num_classes;
+  uint32_t stride = f + 1; // Weights then bias, per class
+  uint32_t epochs = params[0] < 1.0 ? 1 : (uint32_t)params[0];
+  double lambda = pow(10.0, params[1] - 8.0); // 1e-5 .. 0.1 over the search range
+
+  double *mean = calloc(f, sizeof(double));
+  double *inv_std = calloc(f, sizeof(double));
+  double *z = malloc((size_t)fold->num_train * f * sizeof(double));
+  double *w = calloc((size_t)classes * stride, sizeof(double));
+  double *grad = malloc((size_t)classes * stride * sizeof(double));
+  double *p = malloc(classes * sizeof(double));
+  uint32_t *order = malloc(fold->num_train * sizeof(uint32_t));
+  uint64_t rng = TPOT_CV_SEED ^ ((uint64_t)(fold->fold + 1) << 40);
+
+  for (uint32_t i = 0; i < fold->num_train; i++)
+  {
+    const double *x = &data->data[(size_t)fold->train[i] * f];
+    for (uint32_t j = 0; j < f; j++)
+    {
+      mean[j] += x[j];
+      inv_std[j] += x[j] * x[j];
+    }
+  }
+  for (uint32_t j = 0; j < f; j++)
+  {
+    mean[j] /= fold->num_train;
+    double var = inv_std[j] / fold->num_train - mean[j] * mean[j];
+    inv_std[j] = var > 1e-12 ? 1.0 / sqrt(var) : 0.0;
+  }
+  for (uint32_t i = 0; i < fold->num_train; i++)
+  {
+    const double *x = &data->data[(size_t)fold->train[i] * f];
+    double *zi = &z[(size_t)i * f];
+    for (uint32_t j = 0; j < f; j++)
+      zi[j] = (x[j] - mean[j]) * inv_std[j];
+    order[i] = i;
+  }
 
-  for (int i = 0; i < data->num_samples; i += 4)
+  for (uint32_t epoch = 0; epoch < epochs; epoch++)
   {
-    __m256d predictions = _mm256_set1_pd(50.0); // Simplified prediction
-    __m256d labels = _mm256_cvtepi32_pd(_mm256_loadu_si128((__m128i *)&data->labels[i]));
+    double rate = LOGISTIC_LEARNING_RATE / (1.0 + 0.1 * epoch);
+    shuffle_indices(order, fold->num_train, &rng);
 
-    __m256d diff = _mm256_sub_pd(predictions, labels);
-    __m256d squared = _mm256_mul_pd(diff, diff);
-    mse_sum = _mm256_add_pd(mse_sum, squared);
+    for (uint32_t start = 0; start < fold->num_train; start += LOGISTIC_BATCH)
+    {
+      uint32_t end = start + LOGISTIC_BATCH < fold->num_train ? start + LOGISTIC_BATCH : fold->num_train;
+      memset(grad, 0, (size_t)classes * stride * sizeof(double));
+
+      for (uint32_t s = start; s < end; s++)
+      {
+        const double *zi = &z[(size_t)order[s] * f];
+        uint32_t label = data->labels[fold->train[order[s]]];
+
+        double top = -INFINITY, total = 0.0;
+        for (uint32_t c = 0; c < classes; c++)
+        {
+          const double *wc = &w[(size_t)c * stride];
+          double logit = wc[f];
+          for (uint32_t j = 0; j < f; j++)
+            logit += wc[j] * zi[j];
+          p[c] = logit;
+          top = logit > top ? logit : top;
+        }
+        for (uint32_t c = 0; c < classes; c++)
+        {
+          p[c] = exp(p[c] - top);
+          total += p[c];
+        }
+        for (uint32_t c = 0; c < classes; c++)
+        {
+          double err = p[c] / total - (c == label ? 1.0 : 0.0);
+          double *gc = &grad[(size_t)c * stride];
+          for (uint32_t j = 0; j < f; j++)
+            gc[j] += err * zi[j];
+          gc[f] += err;
+        }
+      }
+
+      double step = rate / (end - start);
+      for (uint32_t c = 0; c < classes; c++)
+      {
+        double *wc = &w[(size_t)c * stride];
+        double *gc = &grad[(size_t)c * stride];
+        for (uint32_t j = 0; j < f; j++)
+          wc[j] -= step * gc[j] + rate * lambda * wc[j];
+        wc[f] -= step * gc[f];
+      }
+    }
   }
 
-  double mse_array[4];
-  _mm256_store_pd(mse_array, mse_sum);
-  mse = (mse_array[0] + mse_array[1] + mse_array[2] + mse_array[3]) / data->num_samples;
+  for (uint32_t i = 0; i < fold->num_test; i++)
+  {
+    uint32_t row = fold->test[i];
+    const double *x = &data->data[(size_t)row * f];
+    uint32_t best = 0;
+    double best_logit = -INFINITY;
+    for (uint32_t c = 0; c < classes; c++)
+    {
+      const double *wc = &w[(size_t)c * stride];
+      double logit = wc[f];
+      for (uint32_t j = 0; j < f; j++)
+        logit += wc[j] * (x[j] - mean[j]) * inv_std[j];
+      if (logit > best_logit)
+      {
+        best_logit = logit;
+        best = c;
+      }
+    }
+    predictions[row] = best;
+  }
 
-  END_TIMER();
-  return 1.0 / (1.0 + mse); // Return R²-like score
+  free(mean);
+  free(inv_std);
+  free(z);
+  free(w);
+  free(grad);
+  free(p);
+  free(order);
+}
+
+double evaluate_logistic_regression(Dataset7T *data, double *params)
+{
+  // params[0] = epochs, params[1] = log10(lambda) + 8; classification only
+  if (!data->num_classes)
+    return 0.0;
+  return cross_validate(data, params, logistic_fold, NULL);
 }
 
 // Register algorithms
+static Algorithm7T normalize_algorithm = {
+    .algorithm_id = NORMALIZE,
+    .name = "Normalize",
+    .category = PREPROCESSING,
+    .evaluate = normalize_features,
+    .transform = normalize_transform};
+
+static Algorithm7T standardize_algorithm = {
+    .algorithm_id = STANDARDIZE,
+    .name = "Standardize",
+    .category = PREPROCESSING,
+    .evaluate = standardize_features,
+    .transform = standardize_transform};
+
+static Algorithm7T select_k_best_algorithm = {
+    .algorithm_id = SELECT_K_BEST,
+    .name = "SelectKBest",
+    .category = FEATURE_SELECTION,
+    .evaluate = select_k_best_features,
+    .transform = select_k_best_transform,
+    .num_parameters = 1}; // k
+
+static Algorithm7T random_forest_algorithm = {
+    .algorithm_id = RANDOM_FOREST,
+    .name = "RandomForest",
+    .category = MODEL,
+    .evaluate = evaluate_random_forest};
+
+static Algorithm7T linear_regression_algorithm = {
+    .algorithm_id = LINEAR_REGRESSION,
+    .name = "LinearRegression",
+    .category = MODEL,
+    .evaluate = evaluate_linear_regression};
+
+static Algorithm7T logistic_regression_algorithm = {
+    .algorithm_id = LOGISTIC_REGRESSION,
+    .name = "LogisticRegression",
+    .category = MODEL,
+    .evaluate = evaluate_logistic_regression};
+
+static pthread_once_t registry_once = PTHREAD_ONCE_INIT;
+
+static void register_algorithms_once(void)
+{
+  Algorithm7T *algorithms[] = {
+      &normalize_algorithm, &standardize_algorithm, &select_k_best_algorithm,
+      &random_forest_algorithm, &linear_regression_algorithm, &logistic_regression_algorithm};
+
+  for (uint32_t i = 0; i < sizeof(algorithms) / sizeof(algorithms[0]); i++)
+  {
+    algorithm_registry[algorithms[i]->algorithm_id] = algorithms[i];
+    num_algorithms++;
+  }
+}
+
+// Idempotent and thread-safe
 void register_algorithms()
 {
-  // Preprocessing algorithms
-  algorithm_registry[num_algorithms++] = &(Algorithm7T){
-      .algorithm_id = NORMALIZE,
-      .name = "Normalize",
-      .category = PREPROCESSING,
-      .evaluate = normalize_features};
-
-  algorithm_registry[num_algorithms++] = &(Algorithm7T){
-      .algorithm_id = STANDARDIZE,
-      .name = "Standardize",
-      .category = PREPROCESSING,
-      .evaluate = standardize_features};
-
-  algorithm_registry[num_algorithms++] = &(Algorithm7T){
-      .algorithm_id = SELECT_K_BEST,
-      .name = "SelectKBest",
-      .category = FEATURE_SELECTION,
-      .evaluate = select_k_best_features};
-
-  algorithm_registry[num_algorithms++] = &(Algorithm7T){
-      .algorithm_id = RANDOM_FOREST,
-      .name = "RandomForest",
-      .category = MODEL,
-      .evaluate = evaluate_random_forest};
-
-  algorithm_registry[num_algorithms++] = &(Algorithm7T){
-      .algorithm_id = LINEAR_REGRESSION,
-      .name = "LinearRegression",
-      .category = MODEL,
-      .evaluate = evaluate_linear_regression};
+  pthread_once(&registry_once, register_algorithms_once);
+}
+
+// Direct dispatch by id
+static inline Algorithm7T *find_algorithm(uint32_t algorithm_id)
+{
+  return algorithm_id < TPOT_MAX_ALGORITHMS ? algorithm_registry[algorithm_id] : NULL;
 }
 
 // Create pipeline
@@ -401,7 +1258,7 @@ Pipeline7T *create_pipeline(uint32_t num_steps)
   Pipeline7T *pipeline = malloc(sizeof(Pipeline7T));
   pipeline->pipeline_id = rand();
   pipeline->num_steps = num_steps;
-  pipeline->steps = malloc(num_steps * sizeof(PipelineStep));
+  pipeline->steps = calloc(num_steps, sizeof(PipelineStep));
   pipeline->fitness_score = 0.0;
   pipeline->evaluation_time_ns = 0;
   pipeline->num_correct = 0;
@@ -410,71 +1267,376 @@ Pipeline7T *create_pipeline(uint32_t num_steps)
   return pipeline;
 }
 
-// Evaluate pipeline
-double evaluate_pipeline_7t(Pipeline7T *pipeline, Dataset7T *data)
+void destroy_pipeline_7t(Pipeline7T *pipeline)
 {
-  START_TIMER();
+  if (!pipeline)
+    return;
+  for (uint32_t i = 0; i < pipeline->num_steps; i++)
+  {
+    free(pipeline->steps[i].parameters);
+  }
+  free(pipeline->steps);
+  free(pipeline);
+}
 
-  // Create working copy of dataset
-  Dataset7T *working_data = malloc(sizeof(Dataset7T));
-  working_data->num_samples = data->num_samples;
-  working_data->num_features = data->num_features;
-  working_data->data = malloc(data->num_samples * data->num_features * sizeof(double));
-  working_data->labels = malloc(data->num_samples * sizeof(uint32_t));
+// =============================================================================
+// PIPELINE PREFIX CACHE
+// =============================================================================
 
-  // Copy data
-  memcpy(working_data->data, data->data, data->num_samples * data->num_features * sizeof(double));
-  memcpy(working_data->labels, data->labels, data->num_samples * sizeof(uint32_t));
+// Each step contributes its id and the parameters that affect its output
+#define TPOT_PREFIX_KEY_MAX (TPOT_PREFIX_MAX_STEPS * 3)
+#define TPOT_PREFIX_SLOTS (TPOT_PREFIX_CACHE_CAPACITY * 2) // At most half full
 
-  // Execute pipeline steps
-  for (uint32_t i = 0; i < pipeline->num_steps; i++)
+typedef struct
+{
+  uint64_t hash;
+  uint32_t length;
+  int valid;
+  double values[TPOT_PREFIX_KEY_MAX];
+} TPOTPrefixKey;
+
+typedef enum
+{
+  PREFIX_EMPTY,
+  PREFIX_BUILDING,
+  PREFIX_READY
+} TPOTPrefixState;
+
+typedef struct
+{
+  TPOTPrefixState state;
+  TPOTPrefixKey key;
+  Dataset7T view; // Owns view.data; labels and targets belong to the source
+} TPOTPrefixEntry;
+
+// Preprocessed views keyed by pipeline prefix, shared by every pipeline in
+// an optimization run. Views are immutable once published.
+typedef struct
+{
+  pthread_mutex_t lock;
+  pthread_cond_t built;
+  uint32_t num_entries;
+  uint64_t hits;
+  uint64_t misses;
+  TPOTPrefixEntry entries[TPOT_PREFIX_SLOTS];
+} TPOTPrefixCache;
+
+static TPOTPrefixCache *prefix_cache_create(void)
+{
+  TPOTPrefixCache *cache = calloc(1, sizeof(TPOTPrefixCache));
+  pthread_mutex_init(&cache->lock, NULL);
+  pthread_cond_init(&cache->built, NULL);
+  return cache;
+}
+
+static void prefix_cache_destroy(TPOTPrefixCache *cache)
+{
+  for (uint32_t i = 0; i < TPOT_PREFIX_SLOTS; i++)
   {
-    PipelineStep *step = &pipeline->steps[i];
+    if (cache->entries[i].state == PREFIX_READY)
+      free(cache->entries[i].view.data);
+  }
+  pthread_mutex_destroy(&cache->lock);
+  pthread_cond_destroy(&cache->built);
+  free(cache);
+}
 
-    // Find algorithm
-    Algorithm7T *alg = NULL;
-    for (int j = 0; j < num_algorithms; j++)
+// FNV-1a over the bit patterns of id and parameters
+static void prefix_key_append(TPOTPrefixKey *key, const Algorithm7T *alg, const PipelineStep *step)
+{
+  uint32_t num_params = step->parameters ? alg->num_parameters : 0;
+  if (num_params > step->num_parameters)
+    num_params = step->num_parameters;
+  if (!key->valid || key->length + 1 + num_params > TPOT_PREFIX_KEY_MAX)
+  {
+    key->valid = 0;
+    return;
+  }
+
+  key->values[key->length++] = alg->algorithm_id;
+  for (uint32_t i = 0; i < num_params; i++)
+    key->values[key->length++] = step->parameters[i];
+
+  key->hash = 0xCBF29CE484222325ULL;
+  for (uint32_t i = 0; i < key->length; i++)
+  {
+    uint64_t bits;
+    memcpy(&bits, &key->values[i], sizeof(bits));
+    key->hash = (key->hash ^ bits) * 0x100000001B3ULL;
+  }
+}
+
+// Returns a published entry, or a claimed one the caller must build and
+// publish (*build set), or NULL when the cache is full
+static TPOTPrefixEntry *prefix_cache_acquire(TPOTPrefixCache *cache, const TPOTPrefixKey *key, int *build)
+{
+  *build = 0;
+  pthread_mutex_lock(&cache->lock);
+
+  TPOTPrefixEntry *entry = NULL;
+  for (uint32_t probe = 0; probe < TPOT_PREFIX_SLOTS; probe++)
+  {
+    TPOTPrefixEntry *slot = &cache->entries[(key->hash + probe) & (TPOT_PREFIX_SLOTS - 1)];
+    if (slot->state == PREFIX_EMPTY)
     {
-      if (algorithm_registry[j]->algorithm_id == step->algorithm_id)
+      cache->misses++;
+      if (cache->num_entries < TPOT_PREFIX_CACHE_CAPACITY)
       {
-        alg = algorithm_registry[j];
-        break;
+        slot->state = PREFIX_BUILDING;
+        slot->key = *key;
+        cache->num_entries++;
+        entry = slot;
+        *build = 1;
       }
+      break;
     }
+    if (slot->key.hash == key->hash && slot->key.length == key->length &&
+        memcmp(slot->key.values, key->values, key->length * sizeof(double)) == 0)
+    {
+      // Another thread is building this prefix; wait rather than duplicate it
+      while (slot->state == PREFIX_BUILDING)
+        pthread_cond_wait(&cache->built, &cache->lock);
+      cache->hits++;
+      entry = slot;
+      break;
+    }
+  }
+
+  pthread_mutex_unlock(&cache->lock);
+  return entry;
+}
 
-    if (alg)
+static void prefix_cache_publish(TPOTPrefixCache *cache, TPOTPrefixEntry *entry)
+{
+  pthread_mutex_lock(&cache->lock);
+  entry->state = PREFIX_READY;
+  pthread_cond_broadcast(&cache->built);
+  pthread_mutex_unlock(&cache->lock);
+}
+
+// Copy-on-write: a transform writes fresh feature storage and never
+// touches its input, so views can be shared. Labels and targets are
+// read-only and shared with the source dataset.
+static Dataset7T transform_view(const Algorithm7T *alg, const Dataset7T *in, const double *params)
+{
+  Dataset7T out = *in;
+  out.data = malloc((size_t)in->num_samples * in->num_features * sizeof(double));
+  alg->transform(in, params, &out);
+  return out;
+}
+
+// Run a pipeline over read-only source data. Steps before the model see
+// views: cached by prefix when a cache is given, otherwise a private copy
+// made on the first transform and rewritten in place after that.
+static double evaluate_pipeline_view(Pipeline7T *pipeline, const Dataset7T *data, TPOTPrefixCache *cache)
+{
+  struct timespec start_time, end_time;
+  START_TIMER();
+
+  const Dataset7T *current = data;
+  Dataset7T private_view;
+  int owns_private = 0;
+  TPOTPrefixKey key = {.valid = cache != NULL};
+
+  for (uint32_t i = 0; i < pipeline->num_steps; i++)
+  {
+    PipelineStep *step = &pipeline->steps[i];
+    Algorithm7T *alg = find_algorithm(step->algorithm_id);
+    if (!alg)
+      continue;
+
+    // For models, result is fitness score; models only read the view
+    if (alg->category == MODEL)
     {
-      // Execute algorithm
-      double result = alg->evaluate(working_data, step->parameters);
+      pipeline->fitness_score = alg->evaluate((Dataset7T *)current, step->parameters);
+      continue;
+    }
+    if (!alg->transform)
+      continue;
 
-      // For models, result is fitness score
-      if (alg->category == MODEL)
+    int build = 0;
+    prefix_key_append(&key, alg, step);
+    TPOTPrefixEntry *entry = key.valid ? prefix_cache_acquire(cache, &key, &build) : NULL;
+    if (entry)
+    {
+      if (build)
       {
-        pipeline->fitness_score = result;
+        entry->view = transform_view(alg, current, step->parameters);
+        prefix_cache_publish(cache, entry);
       }
+      if (owns_private)
+        free(private_view.data);
+      owns_private = 0;
+      current = &entry->view;
+    }
+    else if (owns_private)
+    {
+      alg->transform(&private_view, step->parameters, &private_view);
+    }
+    else
+    {
+      private_view = transform_view(alg, current, step->parameters);
+      owns_private = 1;
+      current = &private_view;
     }
   }
 
   END_TIMER();
   pipeline->evaluation_time_ns = GET_ELAPSED_NS();
 
-  // Cleanup
-  free(working_data->data);
-  free(working_data->labels);
-  free(working_data);
+  if (owns_private)
+    free(private_view.data);
 
   return pipeline->fitness_score;
 }
 
+// Evaluate pipeline
+double evaluate_pipeline_7t(Pipeline7T *pipeline, Dataset7T *data)
+{
+  register_algorithms();
+  return evaluate_pipeline_view(pipeline, data, NULL);
+}
+
+// =============================================================================
+// THREAD POOL
+// =============================================================================
+
+typedef void (*TPOTTask)(void *context, uint32_t index);
+
+// Persistent workers that split index ranges with an atomic counter; the
+// calling thread works alongside them
+struct TPOTThreadPool
+{
+  pthread_t threads[TPOT_MAX_THREADS];
+  uint32_t num_workers;
+  pthread_mutex_t lock;
+  pthread_cond_t work_ready;
+  pthread_cond_t work_done;
+  uint64_t batch;   // Bumped per run; workers wake on change
+  uint32_t running; // Workers not yet finished with the current batch
+  int shutdown;
+
+  TPOTTask task;
+  void *context;
+  uint32_t count;
+  _Atomic uint32_t next;
+};
+
+static void thread_pool_drain(struct TPOTThreadPool *pool)
+{
+  uint32_t index;
+  while ((index = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed)) < pool->count)
+  {
+    pool->task(pool->context, index);
+  }
+}
+
+static void *thread_pool_worker(void *arg)
+{
+  struct TPOTThreadPool *pool = arg;
+  uint64_t seen = 0;
+
+  pthread_mutex_lock(&pool->lock);
+  for (;;)
+  {
+    while (pool->batch == seen && !pool->shutdown)
+      pthread_cond_wait(&pool->work_ready, &pool->lock);
+    if (pool->shutdown)
+      break;
+    seen = pool->batch;
+
+    pthread_mutex_unlock(&pool->lock);
+    thread_pool_drain(pool);
+    pthread_mutex_lock(&pool->lock);
+
+    if (--pool->running == 0)
+      pthread_cond_signal(&pool->work_done);
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+static struct TPOTThreadPool *thread_pool_create(uint32_t num_workers)
+{
+  struct TPOTThreadPool *pool = calloc(1, sizeof(struct TPOTThreadPool));
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_ready, NULL);
+  pthread_cond_init(&pool->work_done, NULL);
+
+  for (uint32_t i = 0; i < num_workers && i < TPOT_MAX_THREADS; i++)
+  {
+    if (pthread_create(&pool->threads[i], NULL, thread_pool_worker, pool) != 0)
+      break;
+    pool->num_workers++;
+  }
+  return pool;
+}
+
+static void thread_pool_destroy(struct TPOTThreadPool *pool)
+{
+  if (!pool)
+    return;
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = 1;
+  pthread_cond_broadcast(&pool->work_ready);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (uint32_t i = 0; i < pool->num_workers; i++)
+    pthread_join(pool->threads[i], NULL);
+
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->work_ready);
+  pthread_cond_destroy(&pool->work_done);
+  free(pool);
+}
+
+// Run task(context, 0 .. count-1) across the pool; returns when all are done
+static void thread_pool_run(struct TPOTThreadPool *pool, uint32_t count, TPOTTask task, void *context)
+{
+  if (!pool || pool->num_workers == 0)
+  {
+    for (uint32_t i = 0; i < count; i++)
+      task(context, i);
+    return;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  pool->task = task;
+  pool->context = context;
+  pool->count = count;
+  atomic_store(&pool->next, 0);
+  pool->running = pool->num_workers;
+  pool->batch++;
+  pthread_cond_broadcast(&pool->work_ready);
+  pthread_mutex_unlock(&pool->lock);
+
+  thread_pool_drain(pool);
+
+  pthread_mutex_lock(&pool->lock);
+  while (pool->running > 0)
+    pthread_cond_wait(&pool->work_done, &pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+// =============================================================================
+// OPTIMIZER
+// =============================================================================
+
 // Create optimization engine
 OptimizationEngine7T *create_optimizer_7t(uint32_t population_size, uint32_t num_generations)
 {
-  OptimizationEngine7T *optimizer = malloc(sizeof(OptimizationEngine7T));
+  OptimizationEngine7T *optimizer = calloc(1, sizeof(OptimizationEngine7T));
   optimizer->population_size = population_size;
   optimizer->generation = 0;
   optimizer->best_pipeline_id = 0;
   optimizer->best_fitness = 0.0;
 
+  // One evaluating thread per online CPU; the caller is one of them
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  optimizer->num_threads = cpus < 1 ? 1 : (cpus > TPOT_MAX_THREADS ? TPOT_MAX_THREADS : (uint32_t)cpus);
+  optimizer->pool = thread_pool_create(optimizer->num_threads - 1);
+  optimizer->num_threads = optimizer->pool->num_workers + 1;
+
   optimizer->population = malloc(population_size * sizeof(Pipeline7T *));
 
   // Initialize population with random pipelines
@@ -483,61 +1645,97 @@ OptimizationEngine7T *create_optimizer_7t(uint32_t population_size, uint32_t num
     uint32_t num_steps = 2 + (rand() % 3); // 2-4 steps
     optimizer->population[i] = create_pipeline(num_steps);
 
-    // Randomly assign algorithms
+    // Randomly assign algorithms; the last step is always the model
     for (uint32_t j = 0; j < num_steps; j++)
     {
       PipelineStep *step = &optimizer->population[i]->steps[j];
 
-      if (j == 0)
+      if (j == num_steps - 1)
+      {
+        static const uint32_t models[] = {RANDOM_FOREST, LINEAR_REGRESSION, LOGISTIC_REGRESSION};
+        step->step_type = MODEL;
+        step->algorithm_id = models[rand() % 3];
+      }
+      else if (j == 0)
       {
         step->step_type = PREPROCESSING;
         step->algorithm_id = (rand() % 2 == 0) ? NORMALIZE : STANDARDIZE;
       }
-      else if (j == 1)
+      else
       {
         step->step_type = FEATURE_SELECTION;
         step->algorithm_id = SELECT_K_BEST;
       }
-      else
-      {
-        step->step_type = MODEL;
-        step->algorithm_id = (rand() % 2 == 0) ? RANDOM_FOREST : LINEAR_REGRESSION;
-      }
 
       step->num_parameters = 2;
       step->parameters = malloc(2 * sizeof(double));
-      step->parameters[0] = 10.0 + (rand() % 20); // n_estimators or k
-      step->parameters[1] = 3.0 + (rand() % 7);   // max_depth or other param
+      step->parameters[0] = 10.0 + (rand() % 20); // n_estimators, epochs or k
+      step->parameters[1] = 3.0 + (rand() % 7);   // max_depth or log regularization
     }
   }
 
   return optimizer;
 }
 
+void destroy_optimizer_7t(OptimizationEngine7T *optimizer)
+{
+  if (!optimizer)
+    return;
+  for (uint32_t i = 0; i < optimizer->population_size; i++)
+  {
+    destroy_pipeline_7t(optimizer->population[i]);
+  }
+  thread_pool_destroy(optimizer->pool);
+  free(optimizer->population);
+  free(optimizer);
+}
+
+typedef struct
+{
+  Pipeline7T **population;
+  const Dataset7T *data;
+  TPOTPrefixCache *cache;
+} TPOTGenerationBatch;
+
+static void evaluate_population_member(void *context, uint32_t index)
+{
+  TPOTGenerationBatch *batch = context;
+  evaluate_pipeline_view(batch->population[index], batch->data, batch->cache);
+}
+
 // Optimize pipeline
 Pipeline7T *optimize_pipeline_7t(OptimizationEngine7T *optimizer, Dataset7T *data, uint32_t timeout_seconds)
 {
+  if (!optimizer || !data || optimizer->population_size == 0)
+    return NULL;
+
+  struct timespec start_time, end_time;
   START_TIMER();
 
   printf("Starting 7T TPOT optimization...\n");
   printf("Population size: %u\n", optimizer->population_size);
   printf("Dataset: %u samples, %u features\n", data->num_samples, data->num_features);
+  printf("Threads: %u\n", optimizer->num_threads);
 
+  register_algorithms();
+  TPOTPrefixCache *cache = prefix_cache_create();
+  TPOTGenerationBatch batch = {.population = optimizer->population, .data = data, .cache = cache};
   uint32_t generation = 0;
-  uint64_t start_time_ns = GET_ELAPSED_NS();
 
   while (generation < 10)
   { // Limit to 10 generations for demo
     printf("\nGeneration %u:\n", generation);
 
-    // Evaluate population
+    // Evaluate population in parallel, then report in order
+    thread_pool_run(optimizer->pool, optimizer->population_size, evaluate_population_member, &batch);
+
     double total_fitness = 0.0;
     double best_gen_fitness = 0.0;
     uint32_t best_gen_idx = 0;
 
     for (uint32_t i = 0; i < optimizer->population_size; i++)
     {
-      double fitness = evaluate_pipeline_7t(optimizer->population[i], data);
+      double fitness = optimizer->population[i]->fitness_score;
       total_fitness += fitness;
 
       if (fitness > best_gen_fitness)
@@ -561,7 +1759,8 @@ Pipeline7T *optimize_pipeline_7t(OptimizationEngine7T *optimizer, Dataset7T *dat
     printf("  Average fitness: %.4f\n", total_fitness / optimizer->population_size);
 
     // Check timeout
-    uint64_t elapsed_ns = GET_ELAPSED_NS() - start_time_ns;
+    END_TIMER();
+    uint64_t elapsed_ns = GET_ELAPSED_NS();
     if (elapsed_ns > timeout_seconds * 1000000000ULL)
     {
       printf("Timeout reached after %lu seconds\n", elapsed_ns / 1000000000ULL);
@@ -574,9 +1773,16 @@ Pipeline7T *optimize_pipeline_7t(OptimizationEngine7T *optimizer, Dataset7T *dat
   END_TIMER();
   uint64_t total_time_ns = GET_ELAPSED_NS();
 
+  optimizer->generation = generation;
+  optimizer->prefix_cache_hits = cache->hits;
+  optimizer->prefix_cache_misses = cache->misses;
+  prefix_cache_destroy(cache);
+
   printf("\nOptimization completed in %lu ns (%.3f seconds)\n",
          total_time_ns, total_time_ns / 1000000000.0);
   printf("Best pipeline fitness: %.4f\n", optimizer->best_fitness);
+  printf("Prefix cache: %lu hits, %lu misses\n",
+         (unsigned long)optimizer->prefix_cache_hits, (unsigned long)optimizer->prefix_cache_misses);
 
   return optimizer->population[optimizer->best_pipeline_id];
 }
@@ -632,33 +1838,72 @@ void benchmark_7t_tpot()
   // Performance comparison
   printf("Performance Summary:\n");
   printf("===================\n");
-  printf("Traditional TPOT: 1-10 seconds per pipeline evaluation\n");
-  printf("7T TPOT: 1-10 microseconds per pipeline evaluation\n");
-  printf("Speedup: 1,000,000x faster\n");
-  printf("Memory efficiency: 10x better\n");
-  printf("Energy efficiency: 100x better\n");
+  printf("Fitness: %d-fold cross-validated accuracy (classification) or R^2 (regression)\n",
+         TPOT_CV_FOLDS);
+  printf("Iris %.4f, Boston %.4f, Cancer %.4f, Diabetes %.4f, Digits %.4f\n",
+         iris_best->fitness_score, boston_best->fitness_score, cancer_best->fitness_score,
+         diabetes_best->fitness_score, digits_best->fitness_score);
 
   // Cleanup
-  free(iris_data->data);
-  free(iris_data->labels);
-  free(iris_data);
-  free(boston_data->data);
-  free(boston_data->labels);
-  free(boston_data);
-  free(cancer_data->data);
-  free(cancer_data->labels);
-  free(cancer_data);
-  free(diabetes_data->data);
-  free(diabetes_data->labels);
-  free(diabetes_data);
-  free(digits_data->data);
-  free(digits_data->labels);
-  free(digits_data);
-}
-
-int main()
+  destroy_optimizer_7t(iris_optimizer);
+  destroy_optimizer_7t(boston_optimizer);
+  destroy_optimizer_7t(cancer_optimizer);
+  destroy_optimizer_7t(diabetes_optimizer);
+  destroy_optimizer_7t(digits_optimizer);
+  destroy_dataset_7t(iris_data);
+  destroy_dataset_7t(boston_data);
+  destroy_dataset_7t(cancer_data);
+  destroy_dataset_7t(diabetes_data);
+  destroy_dataset_7t(digits_data);
+}
+
+// Regression check of the fold learners: datasets and CV folds are seeded,
+// so out-of-fold scores are fixed and any drift means a learner changed
+static int check_model_folds(void)
 {
+  static const struct
+  {
+    Dataset7T *(*create)(void);
+    const char *name;
+    double ridge;
+    double logistic; // 0 on regression data
+  } expected[] = {
+      {create_iris_dataset, "iris", 0.866667, 0.940000},
+      {create_boston_dataset, "boston", 0.759283, 0.0},
+      {create_breast_cancer_dataset, "breast_cancer", 0.952548, 0.980668},
+      {create_diabetes_dataset, "diabetes", 0.321713, 0.0},
+      {create_digits_dataset, "digits", 0.712855, 0.803561},
+  };
+  double ridge_params[2] = {0.0, 6.0};    // alpha = 1
+  double logistic_params[2] = {20.0, 4.0}; // 20 epochs, lambda = 1e-4
+  int failures = 0;
+
+  register_algorithms();
+  for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+  {
+    Dataset7T *data = expected[i].create();
+    double ridge = evaluate_linear_regression(data, ridge_params);
+    double logistic = evaluate_logistic_regression(data, logistic_params);
+    int ok = fabs(ridge - expected[i].ridge) < 1e-4 && fabs(logistic - expected[i].logistic) < 1e-4;
+    printf("  %-14s ridge=%.6f (%.6f) logistic=%.6f (%.6f) %s\n", expected[i].name, ridge,
+           expected[i].ridge, logistic, expected[i].logistic, ok ? "ok" : "FAILED");
+    failures += !ok;
+    destroy_dataset_7t(data);
+  }
+  return failures;
+}
+
+// Usage: 7t_tpot [--check]
+int main(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "--check") == 0)
+  {
+    int failures = check_model_folds();
+    printf(failures ? "❌ %d fold result(s) changed\n" : "✅ Fold results unchanged\n", failures);
+    return failures ? 1 : 0;
+  }
+
   srand(42); // For reproducible results
   benchmark_7t_tpot();
   return 0;
-}
\ No newline at end of file
+}
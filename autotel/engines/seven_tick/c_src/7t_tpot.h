@@ -17,8 +17,10 @@ typedef struct
 {
   uint32_t num_samples;
   uint32_t num_features;
+  uint32_t num_classes;    // 0 for regression datasets
   double *data;            // Row-major layout for cache efficiency
-  uint32_t *labels;        // Integer labels
+  uint32_t *labels;        // Integer labels (classification)
+  double *targets;         // Continuous targets (regression)
   TPOTBitVector *feature_mask; // Active features
   TPOTBitVector *sample_mask;  // Active samples
 } Dataset7T;
@@ -44,6 +46,8 @@ typedef struct
   uint32_t num_total;
 } Pipeline7T;
 
+struct TPOTThreadPool;
+
 typedef struct
 {
   Pipeline7T **population;
@@ -51,6 +55,10 @@ typedef struct
   uint32_t generation;
   uint32_t best_pipeline_id;
   double best_fitness;
+  uint32_t num_threads;        // Evaluating threads, including the caller
+  struct TPOTThreadPool *pool; // Persistent workers for population evaluation
+  uint64_t prefix_cache_hits;  // Preprocessed views reused in the last run
+  uint64_t prefix_cache_misses;
 } OptimizationEngine7T;
 
 // Algorithm Registry
@@ -62,6 +70,10 @@ typedef struct
   double (*evaluate)(Dataset7T *data, double *params);
   void (*fit)(Dataset7T *data, double *params, void *model);
   double (*predict)(void *model, Dataset7T *data);
+  // Preprocessing only: write the transformed features of in to out->data
+  // (sized like in->data, may alias it) and set out->num_features
+  void (*transform)(const Dataset7T *in, const double *params, Dataset7T *out);
+  uint32_t num_parameters; // Leading params that affect transform output
 } Algorithm7T;
 
 // Algorithm Categories
@@ -69,7 +81,7 @@ typedef struct
 #define FEATURE_SELECTION 2
 #define MODEL 3
 
-// Algorithm IDs
+// Algorithm IDs (index into the registry)
 #define NORMALIZE 1
 #define STANDARDIZE 2
 #define SELECT_K_BEST 3
@@ -78,6 +90,17 @@ typedef struct
 #define LOGISTIC_REGRESSION 6
 #define SVM 7
 #define KNN 8
+#define TPOT_MAX_ALGORITHMS 16
+
+// Model evaluation
+#define TPOT_CV_FOLDS 5               // k-fold cross-validation
+#define TPOT_CV_SEED 0x7A5C0DEULL     // Same folds for every pipeline
+#define TPOT_HIST_BINS 32             // Quantile bins per feature for trees
+
+// Population evaluation
+#define TPOT_MAX_THREADS 32
+#define TPOT_PREFIX_CACHE_CAPACITY 128 // Cached preprocessed views per run
+#define TPOT_PREFIX_MAX_STEPS 8        // Longer prefixes are not cached
 
 // Performance measurement macros
 #define START_TIMER() clock_gettime(CLOCK_MONOTONIC, &start_time)
@@ -91,19 +114,26 @@ Dataset7T *create_breast_cancer_dataset();
 Dataset7T *create_diabetes_dataset();
 Dataset7T *create_digits_dataset();
 
+void destroy_dataset_7t(Dataset7T *dataset);
+
 Pipeline7T *create_pipeline(uint32_t num_steps);
+void destroy_pipeline_7t(Pipeline7T *pipeline);
 double evaluate_pipeline_7t(Pipeline7T *pipeline, Dataset7T *data);
 OptimizationEngine7T *create_optimizer_7t(uint32_t population_size, uint32_t num_generations);
+void destroy_optimizer_7t(OptimizationEngine7T *optimizer);
 Pipeline7T *optimize_pipeline_7t(OptimizationEngine7T *optimizer, Dataset7T *data, uint32_t timeout_seconds);
 
 void register_algorithms();
 void benchmark_7t_tpot();
 
 // Algorithm evaluation functions
+// Preprocessing transforms data in place; models return k-fold
+// cross-validated accuracy (classification) or R^2 clamped at 0 (regression)
 double normalize_features(Dataset7T *data, double *params);
 double standardize_features(Dataset7T *data, double *params);
 double select_k_best_features(Dataset7T *data, double *params);
 double evaluate_random_forest(Dataset7T *data, double *params);
 double evaluate_linear_regression(Dataset7T *data, double *params);
+double evaluate_logistic_regression(Dataset7T *data, double *params);
 
 #endif // SEVEN_T_TPOT_H
\ No newline at end of file
@@ -46,6 +46,12 @@ extern "C" {
 #define CAUSAL_VECTOR_SIZE 64       // 64-bit causal state vector
 #define SIGNAL_BUFFER_SIZE 1024     // Input signal buffer
 
+// Slot bitmaps: one bit per BitActor, allocated with tzcnt
+#define BITACTOR_BITMAP_WORDS (BITACTOR_MATRIX_SIZE / 64)
+#define BITACTOR_DOMAIN_COUNT 8     // Domains own contiguous slot lanes
+#define BITACTOR_DOMAIN_SLOTS (BITACTOR_MATRIX_SIZE / BITACTOR_DOMAIN_COUNT)
+#define BITACTOR_DOMAIN_NONE 0xFF   // Domain of actors spawned without one
+
 // Performance targets
 #define TARGET_TICK_NS 125          // 8MHz tick rate (125ns per tick)
 #define TARGET_COLLAPSE_NS 1000     // 1μs max for full 8H collapse
@@ -121,6 +127,7 @@ typedef struct {
     uint64_t last_tick;                     // Last execution tick
     uint32_t actor_id;                      // Unique BitActor ID
     void* compiled_ttl;                     // Compiled TTL logic
+    uint8_t domain;                         // Domain requested at spawn or BITACTOR_DOMAIN_NONE
 } BitActorContext;
 
 /**
@@ -128,14 +135,35 @@ typedef struct {
  * 
  * A 256-element matrix of BitActors forming the computational mesh.
  * Each BitActor can signal to any other BitActor in the matrix.
+ *
+ * Slot state lives in bitmaps so spawn is a tzcnt and a tick visits only
+ * actors with queued signals. Domain d prefers slots
+ * [d * BITACTOR_DOMAIN_SLOTS, (d + 1) * BITACTOR_DOMAIN_SLOTS), keeping
+ * actors of one domain contiguous in memory and in tick order. The first
+ * spawn into a domain reserves its lane until the domain's last actor
+ * despawns; untagged spawns take reserved slots only once every unreserved
+ * slot is in use. Domain membership is tracked per slot, so actors that
+ * spilled out of their lane still tick with their domain.
  */
 typedef struct {
     BitActorContext actors[BITACTOR_MATRIX_SIZE];  // 256 BitActors
     uint64_t global_tick;                          // Global tick counter
     uint32_t active_count;                         // Active BitActors
+    uint64_t free_mask[BITACTOR_BITMAP_WORDS];     // 1 = slot available
+    uint64_t pending_mask[BITACTOR_BITMAP_WORDS];  // 1 = signals queued
+    uint64_t reserved_mask[BITACTOR_BITMAP_WORDS]; // 1 = slot in a reserved domain lane
+    uint64_t domain_mask[BITACTOR_DOMAIN_COUNT][BITACTOR_BITMAP_WORDS]; // 1 = actor of domain
     uint64_t entanglement_matrix[32][32];          // Inter-actor signals
     uint8_t matrix_hash[32];                       // Matrix state hash
     bool globally_entangled;                       // Global entanglement active
+
+    // Counters replacing per-event logging on the hot paths
+    uint64_t last_tick_ns;                         // Duration of the last tick
+    uint64_t tick_budget_overruns;                 // Ticks over TARGET_TICK_NS per actor
+    uint64_t collapse_count;
+    uint64_t collapse_ns_total;
+    uint64_t collapse_budget_overruns;             // Collapses over TARGET_COLLAPSE_NS
+    uint64_t signal_overflows;                     // Signals dropped on a full buffer
 } BitActorMatrix;
 
 /**
@@ -186,9 +214,32 @@ void bitactor_matrix_destroy(BitActorMatrix* matrix);
  * @param matrix Target matrix
  * @param compiled_ttl Compiled TTL logic
  * @return BitActor ID or 0 on failure
+ *
+ * The actor has no domain and prefers slots outside reserved domain
+ * lanes; fails only when the matrix is full.
  */
 uint32_t bitactor_spawn(BitActorMatrix* matrix, void* compiled_ttl);
 
+/**
+ * @brief Spawn a BitActor in a domain's slot lane
+ * @param matrix Target matrix
+ * @param compiled_ttl Compiled TTL logic (owned by the matrix afterwards)
+ * @param domain Domain (0 to BITACTOR_DOMAIN_COUNT - 1)
+ * @return BitActor ID or 0 on failure
+ *
+ * Reserves the domain's lane on first use. Once the lane is full, spills
+ * to the lowest free unreserved slot, then to another domain's lane.
+ */
+uint32_t bitactor_spawn_in_domain(BitActorMatrix* matrix, void* compiled_ttl, uint8_t domain);
+
+/**
+ * @brief Release a BitActor slot and free its compiled TTL logic
+ * @param matrix Target matrix
+ * @param actor_id BitActor ID
+ * @return true if the actor was active
+ */
+bool bitactor_despawn(BitActorMatrix* matrix, uint32_t actor_id);
+
 /**
  * @brief Send signal to BitActor
  * @param matrix Target matrix
@@ -205,6 +256,17 @@ bool bitactor_signal(BitActorMatrix* matrix, uint32_t actor_id, const BitActorSi
  */
 uint32_t bitactor_tick(BitActorMatrix* matrix);
 
+/**
+ * @brief Execute one domain's pending BitActors at the current global tick
+ * @param matrix Target matrix
+ * @param domain Domain (0 to BITACTOR_DOMAIN_COUNT - 1)
+ * @return Number of BitActors that executed
+ *
+ * Runs actors spawned into the domain wherever their slot is, and nothing
+ * else that shares its lane.
+ */
+uint32_t bitactor_tick_domain(BitActorMatrix* matrix, uint8_t domain);
+
 /**
  * @brief Trigger 8H causal collapse on specific BitActor
  * @param matrix Target matrix
@@ -0,0 +1,302 @@
+/**
+ * @file bitactor.h
+ * @brief BitActor Runtime - mailboxes, conductor and registry
+ *
+ * Message-passing runtime used by the backtest actors in src/bitactor_*.c.
+ * Each spawned actor owns a bounded MPSC mailbox of fixed-size envelopes.
+ * Actors are pinned to a conductor thread per core, and peers are found
+ * through a registry keyed on precomputed 64-bit name hashes.
+ */
+
+#ifndef CNS_BITACTOR_H
+#define CNS_BITACTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// RUNTIME CONSTANTS
+// =============================================================================
+
+#define BITACTOR_MAX_ACTORS 256        // Spawned actors per process
+#define BITACTOR_MAX_BEHAVIORS 64      // Distinct BITACTOR_BEHAVIOR definitions
+#define BITACTOR_MAX_CORES 16          // Conductor threads
+#define BITACTOR_MAILBOX_SIZE 1024     // Envelopes per mailbox (power of two)
+#define BITACTOR_MSG_PAYLOAD_MAX 32    // Inline payload bytes per envelope
+#define BITACTOR_DISPATCH_BATCH 64     // Messages per actor per conductor pass
+#define BITACTOR_NAME_MAX 32           // Manifest actor name field
+
+#define BITACTOR_MANIFEST_MAGIC 0x464D4142u // "BAMF"
+#define BITACTOR_MANIFEST_VERSION 1
+
+#define BITACTOR_PID_NONE 0xFFFFFFFFu
+#define BITACTOR_ID_NONE 0xFFFFFFFFu
+
+// Status codes
+#define BITACTOR_OK 0
+#define BITACTOR_ERR_INVALID -1
+#define BITACTOR_ERR_FULL -2
+#define BITACTOR_ERR_NOT_FOUND -3
+#define BITACTOR_ERR_IO -4
+
+// =============================================================================
+// CORE TYPES
+// =============================================================================
+
+typedef uint32_t bitactor_pid_t; // Spawned actor instance
+typedef uint32_t actor_id_t;     // Registered actor definition
+
+typedef enum {
+    BITACTOR_CAST = 0,  // Asynchronous, payload copied into the mailbox
+    BITACTOR_CALL = 1   // Synchronous request/reply
+} bitactor_msg_type_t;
+
+/**
+ * @brief Message as seen by senders and handlers
+ *
+ * Cast payloads are copied into the envelope (at most
+ * BITACTOR_MSG_PAYLOAD_MAX bytes). A reply payload must outlive the call,
+ * e.g. a static buffer owned by the replying actor.
+ */
+typedef struct {
+    uint8_t type;
+    const void* payload;
+    size_t payload_len;
+} bitactor_message_t;
+
+typedef void (*bitactor_cast_fn)(void* state, const void* msg, size_t msg_len);
+typedef void (*bitactor_call_fn)(void* state, const void* msg, size_t msg_len,
+                                 bitactor_message_t* reply);
+
+/**
+ * @brief Behavior registered by BITACTOR_BEHAVIOR
+ *
+ * Calls to a behavior without a call handler run the cast handler and
+ * return an empty reply.
+ */
+typedef struct {
+    const char* name;
+    uint64_t name_hash;
+    bitactor_cast_fn on_cast;
+    bitactor_call_fn on_call;
+} bitactor_behavior_t;
+
+/**
+ * @brief Mailbox slot - one cache line
+ */
+typedef struct bitactor_call_slot bitactor_call_slot_t;
+
+typedef struct {
+    uint64_t sequence;                          // Vyukov slot ticket
+    uint64_t sent_cycles;                       // Enqueue timestamp
+    bitactor_call_slot_t* call;                 // Reply rendezvous (CALL only)
+    bitactor_pid_t sender;
+    uint8_t type;
+    uint8_t payload_len;
+    uint8_t payload[BITACTOR_MSG_PAYLOAD_MAX];
+} __attribute__((aligned(64))) bitactor_envelope_t;
+
+/**
+ * @brief Bounded MPSC mailbox
+ *
+ * Producers claim slots with a CAS on tail; the single consumer (the
+ * owning conductor) advances head without atomics beyond the slot ticket.
+ */
+typedef struct {
+    uint64_t tail __attribute__((aligned(64)));
+    uint64_t head __attribute__((aligned(64)));
+    bitactor_envelope_t slots[BITACTOR_MAILBOX_SIZE];
+} bitactor_mailbox_t;
+
+typedef struct {
+    bitactor_mailbox_t mailbox;
+    const bitactor_behavior_t* behavior;
+    void* state;
+    const uint8_t* bytecode;
+    size_t bytecode_length;
+    bitactor_pid_t pid;
+    uint32_t core;
+    uint64_t processed;     // Written by the owning conductor
+    uint64_t dropped;       // Casts refused while the mailbox was full
+    volatile uint32_t running;
+} bitactor_actor_t;
+
+typedef struct bitactor_conductor bitactor_conductor_t;
+
+typedef struct {
+    bitactor_conductor_t* conductor;
+    pthread_t thread;
+    uint32_t core;
+    uint32_t actor_count;
+    bitactor_actor_t* actors[BITACTOR_MAX_ACTORS];
+    volatile uint32_t started;
+} bitactor_core_t;
+
+struct bitactor_conductor {
+    bitactor_core_t cores[BITACTOR_MAX_CORES];
+    uint32_t core_count;
+    uint32_t actor_count;
+    bitactor_actor_t* actors[BITACTOR_MAX_ACTORS];
+    uint64_t dropped;       // Casts to unknown pids
+    volatile uint32_t running;
+};
+
+/**
+ * @brief Compiled actor manifest (build/ *.bin)
+ *
+ * Layout: header, actor_count fixed-width names, then bytecode.
+ * Names are hashed once here so lookups never touch strings.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t actor_count;
+    uint32_t bytecode_length;
+} bitactor_manifest_header_t;
+
+typedef struct {
+    char name[BITACTOR_NAME_MAX];
+    uint64_t name_hash;
+} bitactor_manifest_entry_t;
+
+typedef struct {
+    uint32_t actor_count;
+    bitactor_manifest_entry_t actors[BITACTOR_MAX_ACTORS];
+    uint8_t* bytecode_buffer;
+    size_t bytecode_length;
+} actor_manifest_t;
+
+// =============================================================================
+// NAME HASHING
+// =============================================================================
+
+/**
+ * @brief FNV-1a over an actor name; folds to a constant for literals
+ */
+static inline uint64_t bitactor_name_hash(const char* name) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// =============================================================================
+// RUNTIME API
+// =============================================================================
+
+void bitactor_behavior_register(bitactor_behavior_t* behavior);
+
+int load_actor_manifest_from_bin(const char* path, actor_manifest_t* manifest);
+void actor_manifest_free(actor_manifest_t* manifest);
+
+actor_id_t registry_register(const char* name, const uint8_t* bytecode, size_t bytecode_length);
+bitactor_pid_t registry_lookup_hash(uint64_t name_hash);
+
+/**
+ * @brief Resolve a spawned actor by name
+ */
+static inline bitactor_pid_t registry_lookup(const char* name) {
+    return registry_lookup_hash(bitactor_name_hash(name));
+}
+
+// Bumped whenever a registered name gains or loses its pid
+extern uint32_t bitactor_registry_epoch;
+
+/**
+ * @brief Cached pid of a named peer: BITACTOR_PEER("strategy")
+ *
+ * Resolved on first use and again only after spawn or shutdown changes the
+ * registry, so handlers pay one load and compare per message.
+ */
+typedef struct {
+    const char* name;
+    bitactor_pid_t pid;
+    uint32_t epoch;
+} bitactor_peer_t;
+
+#define BITACTOR_PEER(name) {name, BITACTOR_PID_NONE, 0}
+
+static inline bitactor_pid_t bitactor_peer_pid(bitactor_peer_t* peer) {
+    uint32_t epoch = __atomic_load_n(&bitactor_registry_epoch, __ATOMIC_ACQUIRE);
+    if (__builtin_expect(peer->epoch != epoch, 0)) {
+        peer->pid = registry_lookup(peer->name);
+        peer->epoch = epoch;
+    }
+    return peer->pid;
+}
+
+/**
+ * @brief Initialize a conductor with one (lazily started) thread per core
+ */
+int bitactor_conductor_init(bitactor_conductor_t* conductor);
+bitactor_pid_t bitactor_conductor_spawn(bitactor_conductor_t* conductor, actor_id_t id);
+void bitactor_conductor_quiesce(bitactor_conductor_t* conductor);
+void bitactor_conductor_shutdown(bitactor_conductor_t* conductor);
+
+/**
+ * @brief Casts refused so far: unknown pids plus full mailboxes
+ */
+uint64_t bitactor_conductor_dropped(const bitactor_conductor_t* conductor);
+
+/**
+ * @brief Send without waiting; blocks only while the mailbox is full
+ * @param conductor Conductor, or NULL for the active one (from actors)
+ * @return BITACTOR_ERR_FULL when the target's mailbox is full and only the
+ *         calling thread could drain it (the target is up its call stack);
+ *         the message is dropped and counted
+ */
+int bitactor_cast(bitactor_conductor_t* conductor, bitactor_pid_t pid,
+                  const bitactor_message_t* msg);
+
+/**
+ * @brief Send and wait for the reply
+ *
+ * Runs inline when the target lives on the caller's conductor thread.
+ * Calls must not form cycles across conductor threads.
+ */
+int bitactor_call(bitactor_conductor_t* conductor, bitactor_pid_t pid,
+                  const bitactor_message_t* msg, bitactor_message_t* reply);
+
+/**
+ * @brief Context of the message being handled on this thread
+ */
+bitactor_pid_t bitactor_self(void);
+bitactor_pid_t bitactor_sender(void);
+uint64_t bitactor_message_latency(void); // Enqueue -> dispatch, in cycles
+uint64_t bitactor_cycles(void);
+
+// =============================================================================
+// BEHAVIOR REGISTRATION
+// =============================================================================
+
+/**
+ * @brief Define an actor behavior: BITACTOR_BEHAVIOR(name, cast_fn [, call_fn])
+ *
+ * Registered at load time, matched by name in registry_register().
+ */
+#define BITACTOR_BEHAVIOR(name, ...) \
+    BITACTOR_BEHAVIOR_SELECT(__VA_ARGS__, BITACTOR_BEHAVIOR_2, BITACTOR_BEHAVIOR_1)(name, __VA_ARGS__)
+
+#define BITACTOR_BEHAVIOR_SELECT(_1, _2, NAME, ...) NAME
+#define BITACTOR_BEHAVIOR_1(name, cast_fn) BITACTOR_BEHAVIOR_2(name, cast_fn, NULL)
+#define BITACTOR_BEHAVIOR_2(name, cast_fn, call_fn)                          \
+    static bitactor_behavior_t bitactor_behavior_##name = {                 \
+        #name, 0, cast_fn, call_fn};                                        \
+    __attribute__((constructor)) static void bitactor_register_##name(void) \
+    {                                                                       \
+        bitactor_behavior_register(&bitactor_behavior_##name);              \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CNS_BITACTOR_H
@@ -9,6 +9,22 @@
 #define LIKELY(x) __builtin_expect(!!(x), 1)
 #define UNLIKELY(x) __builtin_expect(!!(x), 0)
 
+// Span pool sizing - spans are preallocated per thread and recycled
+#define CNS_TELEMETRY_MAX_ATTRIBUTES 8   // Fixed attribute slots per span
+#define CNS_TELEMETRY_POOL_SIZE 1024     // Spans per thread (power of 2)
+#define CNS_TELEMETRY_MAX_THREADS 64     // Live threads with a pool (slots recycled on exit)
+#define CNS_TELEMETRY_EXPORT_BATCH 256   // Spans handed to the exporter per call
+
+// CNS Telemetry Attribute - Key-value pair for span attributes
+typedef struct
+{
+  const char *key;    // Attribute key (interned string)
+  const char *value;  // String value
+  int64_t int_value;  // Integer value
+  double float_value; // Float value
+  uint8_t type;       // Type: 0=string, 1=int, 2=float, 3=bool
+} CNSTelemetryAttribute;
+
 // CNS Telemetry Span - High-performance equivalent of OpenTelemetry spans
 typedef struct
 {
@@ -23,8 +39,67 @@ typedef struct
   uint32_t events_count;     // Number of events
   uint8_t status;            // Status: 0=OK, 1=ERROR, 2=UNSET
   uint8_t kind;              // Span kind: 0=INTERNAL, 1=SERVER, 2=CLIENT, 3=PRODUCER, 4=CONSUMER
+  uint8_t sampled;           // Kept by head sampling (else tail-sampled on duration)
+  uint8_t pool_id;           // Owning thread pool + 1 (0 = heap allocated)
+  uint16_t pool_slot;        // Slot in owning pool
+  uint64_t start_cycles;     // Start timestamp in cycles (hot path clock)
+  uint64_t end_cycles;       // End timestamp in cycles (0 if active)
+  CNSTelemetryAttribute attributes[CNS_TELEMETRY_MAX_ATTRIBUTES]; // Fixed attribute area
 } CNSTelemetrySpan;
 
+// Exporter callback - receives batches of finished spans. Spans are only
+// valid for the duration of the call; they are recycled afterwards.
+typedef void (*CNSTelemetryExportFn)(const CNSTelemetrySpan *const *spans,
+                                     size_t count,
+                                     void *user_data);
+
+// Span pool counters (summed over all registered threads)
+typedef struct
+{
+  uint64_t spans_recorded;  // Spans finished on any thread
+  uint64_t spans_exported;  // Spans delivered to the exporter
+  uint64_t spans_dropped;   // Spans shed because the pool was exhausted
+  uint64_t heap_fallbacks;  // Spans malloc'd by threads without a pool
+  uint64_t spans_sampled_out; // Spans discarded by head/tail sampling
+  uint64_t spans_remote;    // Spans ended off their owning thread, finished by the owner
+  uint32_t thread_count;    // Registered thread pools
+} CNSTelemetryPoolStats;
+
+// Span sampling. Head sampling keeps one span in head_sample_every (0 or 1
+// keeps all). Spans not head-sampled are still exported when they run for at
+// least tail_threshold_cycles (0 disables tail sampling, and unsampled spans
+// are then never created).
+typedef struct
+{
+  uint32_t head_sample_every;
+  uint64_t tail_threshold_cycles;
+} CNSTelemetrySamplingConfig;
+
+// Log-linear cycle histograms - 16 linear sub-buckets per power of two
+// (<= 6.25% relative error). Recorded per thread, merged on read. The
+// benchmark domain and shacl_benchmark take all their statistics from
+// here; the SQL/SPARQL domain benchmarks still keep their own min/max/avg.
+#define CNS_TELEMETRY_MAX_HISTOGRAMS 64
+#define CNS_HISTOGRAM_SUB_BITS 4
+#define CNS_HISTOGRAM_SUB_COUNT (1u << CNS_HISTOGRAM_SUB_BITS)
+#define CNS_HISTOGRAM_BUCKETS ((64 - CNS_HISTOGRAM_SUB_BITS + 1) * CNS_HISTOGRAM_SUB_COUNT)
+
+// Merged view of one operation's histogram
+typedef struct
+{
+  const char *name;
+  uint64_t count;
+  uint64_t min_cycles;
+  uint64_t max_cycles;
+  double avg_cycles;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p95;
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t violations; // cns_metric_record_violation calls
+} CNSTelemetryHistogramSummary;
+
 // CNS Telemetry Context - Manages active spans
 typedef struct
 {
@@ -37,16 +112,6 @@ typedef struct
   size_t memory_usage;
 } CNSTelemetryContext;
 
-// CNS Telemetry Attribute - Key-value pair for span attributes
-typedef struct
-{
-  const char *key;    // Attribute key (interned string)
-  const char *value;  // String value
-  int64_t int_value;  // Integer value
-  double float_value; // Float value
-  uint8_t type;       // Type: 0=string, 1=int, 2=float, 3=bool
-} CNSTelemetryAttribute;
-
 // CNS Telemetry Event - Span event with timestamp
 typedef struct
 {
@@ -121,6 +186,26 @@ CNSTelemetrySpan *cns_telemetry_template_span_begin(const char *template_type);
 CNSTelemetrySpan *cns_telemetry_pattern_span_begin(const char *pattern_type);
 void cns_telemetry_span_add_7t_metrics(CNSTelemetrySpan *span, const char *operation_type);
 
+// Span export - finished spans flow through a per-thread lock-free SPSC ring
+// to a single background exporter. Spans must be finished on the thread that
+// created them.
+int cns_telemetry_exporter_start(CNSTelemetryExportFn export_fn, void *user_data);
+void cns_telemetry_exporter_stop(void);
+size_t cns_telemetry_exporter_drain(void);
+void cns_telemetry_get_pool_stats(CNSTelemetryPoolStats *stats);
+
+// Sampling
+void cns_telemetry_set_sampling(const CNSTelemetrySamplingConfig *config);
+
+// Cycle histograms - finished spans are recorded under their name as well
+int cns_telemetry_histogram_id(const char *name);
+void cns_telemetry_histogram_record(const char *name, uint64_t cycles);
+void cns_telemetry_histogram_record_id(int id, uint64_t cycles);
+int cns_telemetry_histogram_summary(const char *name, CNSTelemetryHistogramSummary *summary);
+uint32_t cns_telemetry_histogram_count(void);
+int cns_telemetry_histogram_summary_at(uint32_t id, CNSTelemetryHistogramSummary *summary);
+void cns_telemetry_histogram_reset(const char *name); // Only while no thread records
+
 // Benchmarking
 void cns_telemetry_benchmark(void);
 void cns_telemetry_example_usage(void);
@@ -8,6 +8,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <regex.h>
+#include <pthread.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -101,6 +103,7 @@ typedef struct cns_constraint {
     cns_string_ref_t message;         // Custom validation message
     cns_severity_level_t severity;    // Severity level
     uint32_t flags;                   // Constraint flags
+    const struct cns_shacl_pattern *pattern; // Compiled sh:pattern (NULL if none)
     struct cns_constraint *next;      // Next constraint in list
 } cns_constraint_t;
 
@@ -110,6 +113,59 @@ typedef struct cns_constraint {
 #define CNS_CONSTRAINT_FLAG_CUSTOM      (1 << 2) // Custom constraint
 #define CNS_CONSTRAINT_FLAG_COMPILED    (1 << 3) // Pre-compiled constraint
 
+// ============================================================================
+// COMPILED PATTERN CACHE (sh:pattern)
+// ============================================================================
+
+// Each distinct (sh:pattern, sh:flags) pair is compiled once at shape-load
+// time. Patterns that reduce to a literal are matched without the regex
+// engine; everything else goes through POSIX ERE behind a literal prefilter.
+typedef enum {
+    CNS_PATTERN_MATCH_EXACT = 0,     // ^literal$
+    CNS_PATTERN_MATCH_PREFIX,        // ^literal
+    CNS_PATTERN_MATCH_SUFFIX,        // literal$
+    CNS_PATTERN_MATCH_CONTAINS,      // literal (or sh:flags "q")
+    CNS_PATTERN_MATCH_REGEX          // POSIX ERE fallback
+} cns_pattern_match_kind_t;
+
+// sh:flags bits
+#define CNS_PATTERN_FLAG_ICASE     (1 << 0)  // "i" - case insensitive
+#define CNS_PATTERN_FLAG_MULTILINE (1 << 1)  // "m" - ^/$ match at newlines
+#define CNS_PATTERN_FLAG_DOTALL    (1 << 2)  // "s" - POSIX default
+#define CNS_PATTERN_FLAG_LITERAL   (1 << 3)  // "q" - pattern is a literal
+
+#define CNS_PATTERN_LITERAL_MAX    64        // Longest literal kept for fast paths
+#define CNS_PATTERN_MEMO_SIZE      1024      // Memo entries per pattern (power of 2)
+#define CNS_PATTERN_CACHE_SIZE     256       // Distinct patterns per validator (power of 2)
+
+// Compiled sh:pattern matcher - shared by every constraint using the pattern
+typedef struct cns_shacl_pattern {
+    cns_string_ref_t source;         // Interned pattern source
+    uint32_t flags;                  // CNS_PATTERN_FLAG_* bits
+    cns_pattern_match_kind_t kind;   // Selected match strategy
+    
+    // Literal fast path / prefilter
+    char literal[CNS_PATTERN_LITERAL_MAX]; // Required literal
+    uint16_t literal_length;         // Literal length (0 = no prefilter)
+    bool literal_anchored;           // Literal must appear at offset 0
+    const char *literal_long;        // Interned source of a "q" literal too long to copy
+    size_t literal_long_length;      // Its length
+    
+    // POSIX fallback
+    regex_t regex;                   // Compiled regex (kind == REGEX)
+    bool regex_valid;                // regcomp succeeded
+    
+    // Result memo keyed by interned value id (offset + hash). Entries are
+    // single words so concurrent validators can share them lock-free.
+    uint64_t *memo;                  // CNS_PATTERN_MEMO_SIZE entries
+} cns_shacl_pattern_t;
+
+// Per-validator pattern cache - open addressed on (pattern hash ^ flags)
+typedef struct {
+    cns_shacl_pattern_t **entries;   // CNS_PATTERN_CACHE_SIZE slots
+    size_t count;                    // Compiled patterns
+} cns_shacl_pattern_cache_t;
+
 // ============================================================================
 // SHACL SHAPE STRUCTURE
 // ============================================================================
@@ -125,6 +181,11 @@ typedef struct cns_property_shape {
     struct cns_property_shape *next; // Next property shape
 } cns_property_shape_t;
 
+// Property shape flags
+#define CNS_PROPERTY_FLAG_INVERSE_PATH  (1 << 0)  // path is sh:inversePath
+
+#define CNS_PROPERTY_COUNT_UNBOUNDED    UINT32_MAX // max_count with no sh:maxCount
+
 // Main SHACL shape structure
 typedef struct cns_shape {
     cns_string_ref_t iri;            // Shape IRI
@@ -178,8 +239,88 @@ typedef struct {
     uint64_t validation_time_ticks;  // Time taken for validation
     size_t nodes_validated;          // Number of nodes validated
     size_t constraints_checked;      // Number of constraints checked
+    cns_arena_t *arena;              // Result storage (NULL = counters only)
+    cns_validation_result_t *results_tail; // Last result for O(1) append/concat
+    cns_validation_result_t *free_results; // Recycled results, used before arena
+    pthread_mutex_t *arena_lock;     // Set on worker reports sharing one arena
 } cns_validation_report_t;
 
+// ============================================================================
+// PARALLEL VALIDATION
+// ============================================================================
+
+#define CNS_SHACL_MAX_WORKERS        64    // Upper bound on worker threads
+#define CNS_SHACL_DEFAULT_CHUNK_SIZE 1024  // Focus nodes claimed per grab
+
+// Parallel validation configuration. Focus nodes are handed out in chunks
+// from a shared cursor; each worker fills its own report. With
+// worker_arenas, workers allocate results lock-free from their own arena;
+// without, they allocate from the caller's report->arena under a mutex
+// taken only per result. Either way the result lists are concatenated.
+// worker_arenas must come with worker_arena_count; the thread count is
+// capped by it.
+typedef struct {
+    uint32_t thread_count;           // Worker threads (0 = online CPUs)
+    size_t chunk_size;               // Focus nodes per claim (0 = default)
+    cns_arena_t **worker_arenas;     // Optional per-worker result arenas
+    uint32_t worker_arena_count;     // Entries in worker_arenas
+} cns_shacl_parallel_config_t;
+
+// ============================================================================
+// INCREMENTAL VALIDATION - DEPENDENCY INDEX
+// ============================================================================
+
+// How a changed triple reaches a focus node of a shape
+typedef enum {
+    CNS_SHACL_DEP_SUBJECT = 0,       // Triple subject may be a focus node
+    CNS_SHACL_DEP_OBJECT,            // Triple object may be a focus node
+    CNS_SHACL_DEP_VALUE_CLASS        // rdf:type change of a value reached via path
+} cns_shacl_dep_role_t;
+
+// Single (trigger predicate -> shape) dependency
+typedef struct {
+    cns_string_ref_t predicate;      // Predicate whose change triggers this entry
+    cns_string_ref_t object_filter;  // Required object (hash 0 = any)
+    cns_string_ref_t via_path;       // DEP_VALUE_CLASS: path from focus to value
+    const cns_shape_t *shape;        // Shape to re-evaluate
+    uint8_t role;                    // cns_shacl_dep_role_t
+    bool via_inverse;                // via_path is an inverse path
+} cns_shacl_dependency_t;
+
+// Predicate-keyed dependency index. Entries are sorted by predicate and the
+// hash table maps each predicate to its contiguous range.
+typedef struct {
+    cns_shacl_dependency_t *deps;    // Sorted dependency entries
+    size_t dep_count;                // Number of entries
+    uint32_t *range_start;           // Bucket -> first entry (UINT32_MAX = empty)
+    uint32_t *range_count;           // Bucket -> entry count
+    size_t bucket_count;             // Power of 2
+    size_t predicate_count;          // Distinct trigger predicates
+    size_t max_fanout;               // Largest per-predicate range
+    size_t memory_usage;             // Bytes held by the index
+    cns_string_ref_t rdf_type;       // Interned rdf:type
+} cns_shacl_dependency_index_t;
+
+// Triple delta - the data graph must already reflect the change
+typedef struct {
+    const cns_triple_t *inserted;    // Inserted triples
+    size_t inserted_count;
+    const cns_triple_t *deleted;     // Deleted triples
+    size_t deleted_count;
+} cns_shacl_delta_t;
+
+// Incremental validation counters
+typedef struct {
+    uint64_t deltas_applied;         // Calls to cns_shacl_incremental_apply
+    uint64_t triples_processed;      // Inserted + deleted triples seen
+    uint64_t dependencies_matched;   // Index entries fired
+    uint64_t pairs_revalidated;      // (focus, shape) pairs re-evaluated
+    uint64_t pairs_retired;          // Pairs whose node left the shape target
+    cns_tick_t total_apply_ticks;    // Time spent applying deltas
+} cns_shacl_incremental_stats_t;
+
+typedef struct cns_shacl_incremental cns_shacl_incremental_t;
+
 // ============================================================================
 // VALIDATOR STATISTICS
 // ============================================================================
@@ -195,6 +336,7 @@ typedef struct {
     cns_tick_t avg_validation_ticks;  // Average validation time
     cns_tick_t shape_loading_ticks;   // Time spent loading shapes
     cns_tick_t constraint_eval_ticks; // Time spent evaluating constraints
+    uint64_t patterns_compiled;      // Distinct sh:pattern matchers compiled
     size_t memory_usage;             // Total memory usage
 } cns_shacl_stats_t;
 
@@ -225,6 +367,9 @@ struct cns_shacl_validator {
     size_t target_hash_size;         // Target hash table size
     size_t target_hash_mask;         // Target hash table mask
     
+    // Compiled sh:pattern matchers
+    cns_shacl_pattern_cache_t pattern_cache;
+    
     // Performance tracking
     cns_shacl_stats_t stats;         // Validator statistics
     
@@ -302,7 +447,27 @@ cns_result_t cns_shacl_add_constraint(cns_shape_t *shape,
                                      cns_shacl_constraint_type_t type,
                                      const cns_constraint_value_t *value);
 
-// Add property shape to shape
+// Add sh:pattern constraint, compiling the pattern once via the cache
+// PERFORMANCE: O(p) on first use of a pattern, O(1) afterwards
+cns_result_t cns_shacl_add_pattern_constraint(cns_shacl_validator_t *validator,
+                                             cns_shape_t *shape,
+                                             const char *pattern,
+                                             const char *flags);
+
+// Compile (or fetch cached) matcher for a pattern/flags pair
+// PERFORMANCE: O(1) cache hit, O(p) regcomp on miss
+const cns_shacl_pattern_t* cns_shacl_compile_pattern(cns_shacl_validator_t *validator,
+                                                    cns_string_ref_t pattern,
+                                                    const char *flags);
+
+// Match value against a compiled pattern (memoized per interned value)
+// PERFORMANCE: O(1) memo hit, O(n) otherwise
+bool cns_shacl_pattern_match(const cns_shacl_pattern_t *pattern,
+                            cns_string_ref_t value,
+                            const char *value_str);
+
+// Add property shape to shape. property_shape->path holds the interned
+// predicate; a leading '^' in property_path marks an inverse path.
 // PERFORMANCE: O(1) - property list insertion
 cns_result_t cns_shacl_add_property_shape(cns_shape_t *shape,
                                          const char *property_path,
@@ -318,6 +483,42 @@ cns_result_t cns_shacl_validate_graph(cns_shacl_validator_t *validator,
                                      const cns_graph_t *data_graph,
                                      cns_validation_report_t *report);
 
+// Validate RDF graph on multiple threads - data graph must not be mutated
+// concurrently. Per-worker results are concatenated into report at the end.
+// PERFORMANCE: O(n * m / t) where t is number of worker threads
+cns_result_t cns_shacl_validate_graph_parallel(cns_shacl_validator_t *validator,
+                                              const cns_graph_t *data_graph,
+                                              const cns_shacl_parallel_config_t *config,
+                                              cns_validation_report_t *report);
+
+// Build dependency index and run the initial full validation of shapes
+// PERFORMANCE: O(n * s) once; later deltas cost O(affected focus nodes)
+cns_shacl_incremental_t* cns_shacl_incremental_create(cns_shacl_validator_t *validator,
+                                                     const cns_graph_t *data_graph,
+                                                     const cns_shape_t **shapes,
+                                                     size_t shape_count,
+                                                     cns_arena_t *result_arena);
+
+// Release incremental state (results stay in result_arena)
+void cns_shacl_incremental_destroy(cns_shacl_incremental_t *state);
+
+// Re-evaluate only focus nodes affected by delta and patch the report
+// PERFORMANCE: O(d * f) where d is delta size, f is dependency fanout
+cns_result_t cns_shacl_incremental_apply(cns_shacl_incremental_t *state,
+                                        const cns_graph_t *data_graph,
+                                        const cns_shacl_delta_t *delta);
+
+// Current persistent report; result list is relinked on each call
+// PERFORMANCE: O(p) where p is tracked (focus, shape) pairs
+const cns_validation_report_t* cns_shacl_incremental_report(cns_shacl_incremental_t *state);
+
+// Dependency index built at create time (for cost inspection)
+const cns_shacl_dependency_index_t* cns_shacl_incremental_index(const cns_shacl_incremental_t *state);
+
+// Incremental counters
+cns_result_t cns_shacl_incremental_get_stats(const cns_shacl_incremental_t *state,
+                                            cns_shacl_incremental_stats_t *stats);
+
 // Validate specific node against all applicable shapes
 // PERFORMANCE: O(k) where k is number of applicable shapes
 cns_result_t cns_shacl_validate_node(cns_shacl_validator_t *validator,
@@ -3,22 +3,34 @@
 
 #include "cns/types.h"
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 
 // Forward declarations
 typedef struct SPARQLEngine SPARQLEngine;
 typedef struct SPARQLResult SPARQLResult;
+typedef struct SPARQLPrepared SPARQLPrepared;
 
-// SPARQL Result structure (80/20: simplified for performance)
+// Query limits (80/20: basic graph patterns are small)
+#define SPARQL_MAX_PATTERNS 16
+#define SPARQL_MAX_VARIABLES 16
+#define SPARQL_MAX_VARIABLE_NAME 32
+
+// SPARQL Result structure
 struct SPARQLResult
 {
-  uint32_t count; // Number of result triples
+  uint32_t count; // Number of solutions
   struct
   {
     uint32_t subject;
     uint32_t predicate;
     uint32_t object;
-  } *triples; // Result triples (NULL for simplified results)
+  } *triples; // Matched triples for single-pattern queries without DISTINCT, NULL otherwise
+
+  // Projected bindings: count rows of variable_count ids, row-major
+  uint32_t variable_count;
+  char variables[SPARQL_MAX_VARIABLES][SPARQL_MAX_VARIABLE_NAME];
+  uint32_t *bindings;
 };
 
 // SPARQL Performance Statistics
@@ -26,15 +38,27 @@ typedef struct
 {
   uint64_t total_queries;      // Total queries executed
   uint64_t cache_hits;         // Number of cache hits
+  uint64_t cache_misses;       // Queries parsed and planned from scratch
   double cache_hit_rate;       // Cache hit rate (0.0 to 1.0)
+  uint32_t cache_entries;      // Cached query plans
+  size_t cache_bytes;          // Memory they hold
+  uint64_t cache_evictions;    // Plans dropped to stay under the cache limit
+  double avg_hit_cycles;       // Execute latency of cache hits and misses
+  double avg_miss_cycles;
+  uint64_t prepared_executions; // Prepared statement executions (not cache lookups)
+  double avg_prepared_cycles;
   uint32_t total_triples;      // Total triples in store
   double avg_cycles_per_query; // Average cycles per query
+  uint32_t distinct_subjects;   // Planner statistics, gathered when indexes are built
+  uint32_t distinct_predicates;
+  uint32_t distinct_objects;
+  uint32_t characteristic_sets; // Distinct predicate sets of subjects
 } SPARQLStats;
 
 // Core SPARQL Engine API (80/20 optimized)
 
-// Create SPARQL engine (7 cycles target)
-// 80/20: Single instance is sufficient for most use cases
+// Create SPARQL engine
+// Every call returns an independent engine; initial_capacity reserves room for that many triples
 SPARQLEngine *cns_sparql_create(size_t initial_capacity);
 
 // Destroy SPARQL engine (3 cycles target)
@@ -42,20 +66,63 @@ void cns_sparql_destroy(SPARQLEngine *engine);
 
 // Add triple to store (5 cycles target)
 // 80/20: Most operations are simple triple additions
+// Added triples are indexed on the next query; duplicates are stored once
 int cns_sparql_add_triple(SPARQLEngine *engine, uint32_t subject, uint32_t predicate, uint32_t object);
 
-// Execute SPARQL query (15 cycles target)
-// 80/20: Optimized for common SELECT patterns
+// Bulk load count triples given as interleaved (subject, predicate, object) ids
+int cns_sparql_load_triples(SPARQLEngine *engine, const uint32_t *triples, size_t count);
+
+// Sort pending triples into the SPO, POS and OSP indexes
+// Queries do this on demand; call it to keep load time out of the first query
+int cns_sparql_build_indexes(SPARQLEngine *engine);
+
+// Term dictionary
+// Terms are N-Triples strings ("<http://ex.org/a>", "\"text\"@en", "_:b0"); ids start at 1
+// Queries read bare integers as raw ids, so callers mixing both must keep their raw ids apart
+uint32_t cns_sparql_intern(SPARQLEngine *engine, const char *term);
+uint32_t cns_sparql_lookup(const SPARQLEngine *engine, const char *term); // 0 if unknown
+const char *cns_sparql_term(const SPARQLEngine *engine, uint32_t id);     // NULL if unknown
+
+// Intern three terms and add the triple
+int cns_sparql_add_terms(SPARQLEngine *engine, const char *subject, const char *predicate, const char *object);
+
+// Execute SPARQL query
+// Supports SELECT [DISTINCT] (* | ?vars) WHERE { basic graph pattern } [LIMIT n] with PREFIX
+// declarations. Patterns are joined in the order a cost-based planner picks from per-predicate
+// counts and characteristic sets, each by index nested loop or hash join over one permutation index;
+// cyclic patterns are joined all at once by a leapfrog triejoin.
+// Unsupported or malformed queries return an empty result; NULL on missing arguments or memory
+// Parses and plans are cached by query shape: queries differing only in constants or variable
+// names share one, least recently used shapes are evicted past the cache limit
 SPARQLResult *cns_sparql_execute(SPARQLEngine *engine, const char *query);
 
+// Limit the memory held by cached plans (default 1 MB); 0 disables caching
+void cns_sparql_set_cache_limit(SPARQLEngine *engine, size_t bytes);
+
+// Prepared statements: parse once, then execute with new constants without parsing or planning
+// Parameters are the query's constants in textual order, as ids; 0 (an unknown term) matches nothing.
+// NULL params runs the constants as written. Returns NULL on malformed queries or missing arguments
+SPARQLPrepared *cns_sparql_prepare(SPARQLEngine *engine, const char *query);
+uint32_t cns_sparql_prepared_params(const SPARQLPrepared *prepared);
+SPARQLResult *cns_sparql_execute_prepared(SPARQLEngine *engine, SPARQLPrepared *prepared, const uint32_t *params);
+void cns_sparql_free_prepared(SPARQLPrepared *prepared);
+
+// Cyclic patterns (triangles, cliques) run as one leapfrog triejoin over sorted permutation
+// indexes; disabling it forces pairwise joins, for comparison (enabled by default)
+void cns_sparql_set_leapfrog(SPARQLEngine *engine, bool enabled);
+
+// Describe the join order and algorithms chosen for a query, one line per pattern
+// Returns malloc'd text for the caller to free; NULL on malformed queries or missing arguments
+char *cns_sparql_explain(SPARQLEngine *engine, const char *query);
+
 // Free SPARQL result (3 cycles target)
 void cns_sparql_free_result(SPARQLResult *result);
 
 // Get performance statistics
 SPARQLStats cns_sparql_get_stats(SPARQLEngine *engine);
 
-// 80/20 optimized triple lookup (3 cycles target)
-// 80/20: Most lookups are simple pattern matches
+// Count triples matching a pattern; 0 is a wildcard
+// Answered by a binary search of the index whose prefix covers the bound positions
 uint32_t cns_sparql_find_triples(SPARQLEngine *engine, uint32_t subject, uint32_t predicate, uint32_t object);
 
 // 80/20 Optimization Macros
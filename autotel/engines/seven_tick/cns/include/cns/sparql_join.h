@@ -0,0 +1,38 @@
+/**
+ * SPARQL Join Kernel - Radix-partitioned hash join
+ *
+ * Both relations are split by hash into partitions whose hash tables fit in L2;
+ * each partition is built and probed while cache resident. Tables are bucketized
+ * linear probing over 32-bit tag + payload slots, probed four tags at a time.
+ */
+
+#ifndef CNS_SPARQL_JOIN_H
+#define CNS_SPARQL_JOIN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define S7T_JOIN_L2_BYTES (256u * 1024u) // Default partition table budget
+
+// Join tuning; a zeroed struct (or NULL) picks defaults
+typedef struct {
+    uint32_t threads;       // Partition, build and probe threads; 0 for one per online CPU
+    size_t partition_bytes; // Hash table bytes per partition; 0 for S7T_JOIN_L2_BYTES, SIZE_MAX for one table
+    bool semi;              // Emit each probe tuple at most once (semi-join)
+} s7t_join_options;
+
+/**
+ * s7t_join - Equi-join of (key, value) relations
+ *
+ * Writes the values of every matching (build, probe) pair to out_build / out_probe,
+ * stopping at capacity pairs; either output may be NULL. NULL value arrays stand for
+ * the keys. Pairs are grouped by partition rather than in probe order.
+ * Returns the number of matches, which exceeds capacity when output was dropped.
+ */
+size_t s7t_join(const uint32_t* build_keys, const uint32_t* build_values, size_t build_count,
+                const uint32_t* probe_keys, const uint32_t* probe_values, size_t probe_count,
+                uint32_t* out_build, uint32_t* out_probe, size_t capacity,
+                const s7t_join_options* options);
+
+#endif // CNS_SPARQL_JOIN_H
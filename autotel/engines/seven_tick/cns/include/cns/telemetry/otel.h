@@ -180,7 +180,7 @@ void cns_metric_record_memory(
     size_t used,
     size_t total);
 
-// Record performance violation
+// Record performance violation; actual_cycles also joins the latency histogram
 void cns_metric_record_violation(
     cns_telemetry_t *telemetry,
     const char *operation,
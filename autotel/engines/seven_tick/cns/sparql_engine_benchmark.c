@@ -0,0 +1,177 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+#include "cns/sparql.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Scalable SPARQL engine throughput benchmark
+// Usage: sparql_engine_benchmark [triples]   (default 100M; peak memory is about 60 bytes per triple)
+
+#define DEFAULT_TRIPLES 100000000ULL
+#define PREDICATE_COUNT 32
+#define LOOKUP_COUNT 1000000
+#define QUERY_COUNT 10000
+
+static double now_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// xorshift64* for reproducible data
+static uint64_t next_random(uint64_t *state)
+{
+  *state ^= *state >> 12;
+  *state ^= *state << 25;
+  *state ^= *state >> 27;
+  return *state * 2685821657736338717ULL;
+}
+
+// Ids: predicates 1..32, subjects and objects above them
+static void generate_triples(uint32_t *triples, size_t count, uint32_t subjects)
+{
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < count; i++)
+  {
+    uint64_t r = next_random(&state);
+    triples[i * 3] = PREDICATE_COUNT + 1 + (uint32_t)(i % subjects);
+    triples[i * 3 + 1] = 1 + (uint32_t)(r % PREDICATE_COUNT);
+    triples[i * 3 + 2] = PREDICATE_COUNT + 1 + (uint32_t)((r >> 32) % subjects);
+  }
+}
+
+static void report(const char *name, size_t operations, double seconds)
+{
+  printf("   %-34s %12.0f ops/s  %9.1f ns/op\n", name, operations / seconds, seconds * 1e9 / operations);
+}
+
+int main(int argc, char **argv)
+{
+  size_t count = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_TRIPLES;
+  uint32_t subjects = (uint32_t)(count / 10 > 0 ? count / 10 : 1);
+
+  printf("📊 SPARQL Engine Benchmark: %zu triples, %u subjects, %d predicates\n", count, subjects, PREDICATE_COUNT);
+
+  uint32_t *triples = malloc(count * 3 * sizeof(uint32_t));
+  SPARQLEngine *engine = cns_sparql_create(count);
+  if (!triples || !engine)
+  {
+    printf("❌ Allocation failed\n");
+    return 1;
+  }
+  generate_triples(triples, count, subjects);
+
+  // Bulk load and index build
+  double start = now_seconds();
+  if (cns_sparql_load_triples(engine, triples, count) != CNS_OK)
+  {
+    printf("❌ Load failed\n");
+    return 1;
+  }
+  double loaded = now_seconds();
+  if (cns_sparql_build_indexes(engine) != CNS_OK)
+  {
+    printf("❌ Index build failed\n");
+    return 1;
+  }
+  double indexed = now_seconds();
+
+  SPARQLStats stats = cns_sparql_get_stats(engine);
+  printf("🔧 Load\n");
+  report("append", count, loaded - start);
+  report("sort SPO/POS/OSP + statistics", count, indexed - loaded);
+  printf("   %u distinct triples\n", stats.total_triples);
+
+  // Pattern lookups answered by index range scans
+  printf("🔧 Pattern lookups (find_triples)\n");
+  uint64_t state = 42;
+  uint64_t checksum = 0;
+  const char *names[] = {"(s ? ?) via SPO", "(? p ?) via POS", "(? ? o) via OSP", "(s p ?) via SPO", "(? p o) via POS",
+                         "(s ? o) via OSP"};
+  for (int shape = 0; shape < 6; shape++)
+  {
+    start = now_seconds();
+    for (int i = 0; i < LOOKUP_COUNT; i++)
+    {
+      const uint32_t *t = &triples[(next_random(&state) % count) * 3];
+      uint32_t s = (shape == 0 || shape == 3 || shape == 5) ? t[0] : 0;
+      uint32_t p = (shape == 1 || shape == 3 || shape == 4) ? t[1] : 0;
+      uint32_t o = (shape == 2 || shape == 4 || shape == 5) ? t[2] : 0;
+      checksum += cns_sparql_find_triples(engine, s, p, o);
+    }
+    report(names[shape], LOOKUP_COUNT, now_seconds() - start);
+  }
+
+  // Full queries through cns_sparql_execute
+  printf("🔧 Queries (cns_sparql_execute)\n");
+  char query[256];
+  const char *query_names[] = {"SELECT ?p ?o { s ?p ?o }", "SELECT ?o { s p ?o }",
+                               "SELECT ?f ?o { s p ?f . ?f p ?o }"};
+  for (int shape = 0; shape < 3; shape++)
+  {
+    uint64_t rows = 0;
+    start = now_seconds();
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+      const uint32_t *t = &triples[(next_random(&state) % count) * 3];
+      if (shape == 0)
+        snprintf(query, sizeof(query), "SELECT ?p ?o WHERE { %u ?p ?o }", t[0]);
+      else if (shape == 1)
+        snprintf(query, sizeof(query), "SELECT ?o WHERE { %u %u ?o }", t[0], t[1]);
+      else
+        snprintf(query, sizeof(query), "SELECT ?f ?o WHERE { %u %u ?f . ?f %u ?o }", t[0], t[1], t[1]);
+
+      SPARQLResult *result = cns_sparql_execute(engine, query);
+      if (result)
+      {
+        rows += result->count;
+        cns_sparql_free_result(result);
+      }
+    }
+    double seconds = now_seconds() - start;
+    report(query_names[shape], QUERY_COUNT, seconds);
+    printf("   %-34s %12.1f rows/query\n", "", (double)rows / QUERY_COUNT);
+  }
+  stats = cns_sparql_get_stats(engine);
+  printf("   plan cache: %.1f%% hits, %.0f cycles/hit, %.0f cycles/miss\n", stats.cache_hit_rate * 100.0,
+         stats.avg_hit_cycles, stats.avg_miss_cycles);
+
+  // The same shapes as prepared statements: constants bound without parsing
+  printf("🔧 Queries (cns_sparql_execute_prepared)\n");
+  const char *statements[] = {"SELECT ?p ?o WHERE { 1 ?p ?o }", "SELECT ?o WHERE { 1 1 ?o }",
+                              "SELECT ?f ?o WHERE { 1 1 ?f . ?f 1 ?o }"};
+  for (int shape = 0; shape < 3; shape++)
+  {
+    SPARQLPrepared *prepared = cns_sparql_prepare(engine, statements[shape]);
+    if (!prepared)
+    {
+      printf("❌ Prepare failed\n");
+      return 1;
+    }
+    uint64_t rows = 0;
+    start = now_seconds();
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+      const uint32_t *t = &triples[(next_random(&state) % count) * 3];
+      uint32_t params[3] = {t[0], t[1], t[1]};
+      SPARQLResult *result = cns_sparql_execute_prepared(engine, prepared, params);
+      if (result)
+      {
+        rows += result->count;
+        cns_sparql_free_result(result);
+      }
+    }
+    double seconds = now_seconds() - start;
+    report(query_names[shape], QUERY_COUNT, seconds);
+    printf("   %-34s %12.1f rows/query\n", "", (double)rows / QUERY_COUNT);
+    cns_sparql_free_prepared(prepared);
+  }
+
+  printf("✅ Done (checksum %llu)\n", (unsigned long long)checksum);
+
+  cns_sparql_destroy(engine);
+  free(triples);
+  return 0;
+}
@@ -0,0 +1,162 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime, sysconf
+#include "cns/sparql_join.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Hash join benchmark across build/probe size ratios
+// Usage: sparql_join_benchmark [probe_tuples] [threads]   (default 16M probes, one thread per CPU)
+// Unique build keys; probe keys drawn from twice the build range, so about half match
+
+#define DEFAULT_PROBES 16000000ULL
+
+static double now_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// xorshift64* for reproducible data
+static uint64_t next_random(uint64_t *state)
+{
+  *state ^= *state >> 12;
+  *state ^= *state << 25;
+  *state ^= *state >> 27;
+  return *state * 2685821657736338717ULL;
+}
+
+// Baseline: chained table probed one row at a time, as the kernels did before partitioning
+static size_t chained_join(const uint32_t *build_keys, const uint32_t *build_values, size_t build_count,
+                           const uint32_t *probe_keys, const uint32_t *probe_values, size_t probe_count,
+                           uint32_t *out_build, uint32_t *out_probe)
+{
+  size_t size = 1;
+  while (size < build_count)
+    size <<= 1;
+  uint32_t *heads = malloc(size * sizeof(uint32_t));
+  uint32_t *next = malloc(build_count * sizeof(uint32_t));
+  if (!heads || !next)
+  {
+    free(heads);
+    free(next);
+    return 0;
+  }
+  memset(heads, 0xFF, size * sizeof(uint32_t));
+
+  for (size_t i = 0; i < build_count; i++)
+  {
+    size_t h = (size_t)(((uint64_t)build_keys[i] * 0x9E3779B97F4A7C15ULL) >> 32) & (size - 1);
+    next[i] = heads[h];
+    heads[h] = (uint32_t)i;
+  }
+
+  size_t matches = 0;
+  for (size_t i = 0; i < probe_count; i++)
+  {
+    size_t h = (size_t)(((uint64_t)probe_keys[i] * 0x9E3779B97F4A7C15ULL) >> 32) & (size - 1);
+    for (uint32_t e = heads[h]; e != UINT32_MAX; e = next[e])
+    {
+      if (build_keys[e] == probe_keys[i])
+      {
+        out_build[matches] = build_values[e];
+        out_probe[matches] = probe_values[i];
+        matches++;
+      }
+    }
+  }
+
+  free(heads);
+  free(next);
+  return matches;
+}
+
+int main(int argc, char **argv)
+{
+  size_t probe_count = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_PROBES;
+  long online = sysconf(_SC_NPROCESSORS_ONLN);
+  uint32_t threads = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : (online > 0 ? (uint32_t)online : 1);
+  const size_t ratios[] = {1, 4, 16, 64, 1024};
+  const int ratio_count = sizeof(ratios) / sizeof(ratios[0]);
+
+  printf("📊 SPARQL Join Benchmark: %zu probe tuples, %u threads, %u KB partitions\n", probe_count, threads,
+         S7T_JOIN_L2_BYTES / 1024);
+
+  uint32_t *build_keys = malloc(probe_count * sizeof(uint32_t));
+  uint32_t *build_values = malloc(probe_count * sizeof(uint32_t));
+  uint32_t *probe_keys = malloc(probe_count * sizeof(uint32_t));
+  uint32_t *probe_values = malloc(probe_count * sizeof(uint32_t));
+  uint32_t *out_build = malloc(probe_count * sizeof(uint32_t));
+  uint32_t *out_probe = malloc(probe_count * sizeof(uint32_t));
+  if (!build_keys || !build_values || !probe_keys || !probe_values || !out_build || !out_probe)
+  {
+    printf("❌ Allocation failed\n");
+    return 1;
+  }
+
+  printf("   %-7s %10s %10s %10s %13s %13s %13s %13s\n", "build:", "build", "probe", "matches", "chained",
+         "one table", "partitioned", "threaded");
+  printf("   %-7s %10s %10s %10s %13s %13s %13s %13s\n", "probe", "", "", "", "Mtuples/s", "Mtuples/s", "Mtuples/s",
+         "Mtuples/s");
+
+  for (int r = 0; r < ratio_count; r++)
+  {
+    size_t build_count = probe_count / ratios[r];
+    if (build_count == 0)
+      continue;
+
+    // Unique build keys: an odd multiplier permutes 32-bit values
+    uint64_t state = 0x9E3779B97F4A7C15ULL + r;
+    for (size_t i = 0; i < build_count; i++)
+    {
+      build_keys[i] = (uint32_t)(i * 2654435761u);
+      build_values[i] = (uint32_t)i;
+    }
+    for (size_t i = 0; i < probe_count; i++)
+    {
+      uint64_t pick = next_random(&state) % (build_count * 2);
+      probe_keys[i] = pick < build_count ? build_keys[pick] : (uint32_t)((build_count + pick) * 2654435761u);
+      probe_values[i] = (uint32_t)i;
+    }
+
+    double total = (double)(build_count + probe_count) / 1e6;
+    double start = now_seconds();
+    size_t expected = chained_join(build_keys, build_values, build_count, probe_keys, probe_values, probe_count,
+                                   out_build, out_probe);
+    double chained = now_seconds() - start;
+
+    s7t_join_options variants[3] = {
+        {.threads = 1, .partition_bytes = SIZE_MAX},
+        {.threads = 1},
+        {.threads = threads},
+    };
+    double seconds[3];
+    for (int v = 0; v < 3; v++)
+    {
+      start = now_seconds();
+      size_t matches = s7t_join(build_keys, build_values, build_count, probe_keys, probe_values, probe_count,
+                                out_build, out_probe, probe_count, &variants[v]);
+      seconds[v] = now_seconds() - start;
+      if (matches != expected)
+      {
+        printf("❌ Join mismatch: %zu matches, expected %zu\n", matches, expected);
+        return 1;
+      }
+    }
+
+    printf("   1:%-5zu %10zu %10zu %10zu %13.1f %13.1f %13.1f %13.1f\n", ratios[r], build_count, probe_count,
+           expected, total / chained, total / seconds[0], total / seconds[1], total / seconds[2]);
+  }
+
+  printf("✅ Done\n");
+
+  free(build_keys);
+  free(build_values);
+  free(probe_keys);
+  free(probe_values);
+  free(out_build);
+  free(out_probe);
+  return 0;
+}
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <inttypes.h>
 
 #ifdef __APPLE__
 #include <mach/mach_time.h>
@@ -35,6 +36,46 @@ static uint64_t get_precise_timestamp_ns(void) {
 #endif
 }
 
+// =============================================================================
+// SLOT BITMAPS
+// =============================================================================
+
+static inline void slot_bit_set(uint64_t* mask, uint32_t slot) {
+    mask[slot >> 6] |= 1ULL << (slot & 63);
+}
+
+static inline void slot_bit_clear(uint64_t* mask, uint32_t slot) {
+    mask[slot >> 6] &= ~(1ULL << (slot & 63));
+}
+
+static inline bool slot_bit_test(const uint64_t* mask, uint32_t slot) {
+    return (mask[slot >> 6] >> (slot & 63)) & 1;
+}
+
+// Lowest set bit in [first, first + count) with count <= 64 and the range
+// inside one word; BITACTOR_MATRIX_SIZE if none
+static inline uint32_t slot_find_in_lane(const uint64_t* mask, uint32_t first, uint32_t count) {
+    uint64_t word = mask[first >> 6] >> (first & 63);
+    if (count < 64) word &= (1ULL << count) - 1;
+    return word ? first + (uint32_t)__builtin_ctzll(word) : BITACTOR_MATRIX_SIZE;
+}
+
+static inline uint32_t slot_find_any(const uint64_t* mask) {
+    for (uint32_t w = 0; w < BITACTOR_BITMAP_WORDS; w++) {
+        if (mask[w]) return w * 64 + (uint32_t)__builtin_ctzll(mask[w]);
+    }
+    return BITACTOR_MATRIX_SIZE;
+}
+
+// Lowest set bit of mask that is clear in exclude
+static inline uint32_t slot_find_outside(const uint64_t* mask, const uint64_t* exclude) {
+    for (uint32_t w = 0; w < BITACTOR_BITMAP_WORDS; w++) {
+        uint64_t word = mask[w] & ~exclude[w];
+        if (word) return w * 64 + (uint32_t)__builtin_ctzll(word);
+    }
+    return BITACTOR_MATRIX_SIZE;
+}
+
 // =============================================================================
 // BITACTOR MATRIX MANAGEMENT
 // =============================================================================
@@ -66,14 +107,16 @@ BitActorMatrix* bitactor_matrix_create(void) {
         memset(ctx->proof.hops, 0, sizeof(ctx->proof.hops));
     }
     
+    // Every slot starts free, none pending
+    memset(matrix->free_mask, 0xFF, sizeof(matrix->free_mask));
+    memset(matrix->pending_mask, 0, sizeof(matrix->pending_mask));
+    memset(matrix->reserved_mask, 0, sizeof(matrix->reserved_mask));
+    memset(matrix->domain_mask, 0, sizeof(matrix->domain_mask));
+    
     // Initialize entanglement matrix
     memset(matrix->entanglement_matrix, 0, sizeof(matrix->entanglement_matrix));
     memset(matrix->matrix_hash, 0, sizeof(matrix->matrix_hash));
     
-    printf("🧬 BitActor Matrix initialized: %d BitActors ready\n", BITACTOR_MATRIX_SIZE);
-    printf("   Trinity: 8T/8H/8B architecture active\n");
-    printf("   Target: %dns per tick, %dns per collapse\n", TARGET_TICK_NS, TARGET_COLLAPSE_NS);
-    
     return matrix;
 }
 
@@ -87,7 +130,6 @@ void bitactor_matrix_destroy(BitActorMatrix* matrix) {
         }
     }
     
-    printf("🧬 BitActor Matrix destroyed: %u BitActors deactivated\n", matrix->active_count);
     free(matrix);
 }
 
@@ -95,38 +137,88 @@ void bitactor_matrix_destroy(BitActorMatrix* matrix) {
 // BITACTOR LIFECYCLE
 // =============================================================================
 
+static uint32_t bitactor_claim_slot(BitActorMatrix* matrix, uint32_t slot,
+                                    void* compiled_ttl, uint8_t domain) {
+    BitActorContext* ctx = &matrix->actors[slot];
+    slot_bit_clear(matrix->free_mask, slot);
+    slot_bit_clear(matrix->pending_mask, slot);
+    
+    // Initialize BitActor
+    ctx->compiled_ttl = compiled_ttl;
+    ctx->domain = domain;
+    if (domain != BITACTOR_DOMAIN_NONE) slot_bit_set(matrix->domain_mask[domain], slot);
+    ctx->bits = 0x01;  // Set trigger active bit
+    ctx->vector = 0;
+    ctx->last_tick = matrix->global_tick;
+    ctx->signal_length = 0;
+    
+    // Initialize proof chain
+    ctx->proof.current_hop = 0;
+    ctx->proof.valid = false;
+    ctx->proof.start_tick = matrix->global_tick;
+    ctx->proof.proof_hash = (uint64_t)ctx->actor_id * 0x9E3779B97F4A7C15ULL;
+    
+    matrix->active_count++;
+    return ctx->actor_id;
+}
+
 uint32_t bitactor_spawn(BitActorMatrix* matrix, void* compiled_ttl) {
-    if (!matrix) return 0;
+    if (!matrix || !compiled_ttl) return 0;
     
-    // Find available BitActor slot
-    for (int i = 0; i < BITACTOR_MATRIX_SIZE; i++) {
-        BitActorContext* ctx = &matrix->actors[i];
-        if (ctx->compiled_ttl == NULL) {  // Available slot
-            // Initialize BitActor
-            ctx->compiled_ttl = compiled_ttl;
-            ctx->bits = 0x01;  // Set trigger active bit
-            ctx->vector = 0;
-            ctx->last_tick = matrix->global_tick;
-            ctx->signal_length = 0;
-            
-            // Initialize proof chain
-            ctx->proof.current_hop = 0;
-            ctx->proof.valid = false;
-            ctx->proof.start_tick = matrix->global_tick;
-            ctx->proof.proof_hash = (uint64_t)ctx->actor_id * 0x9E3779B97F4A7C15ULL;
-            
-            matrix->active_count++;
-            
-            printf("🧬 BitActor spawned: ID=%u, Active=%u/%d\n", 
-                   ctx->actor_id, matrix->active_count, BITACTOR_MATRIX_SIZE);
-            
-            return ctx->actor_id;
+    // Reserved lanes belong to their domains while unreserved slots remain
+    uint32_t slot = slot_find_outside(matrix->free_mask, matrix->reserved_mask);
+    if (slot == BITACTOR_MATRIX_SIZE) slot = slot_find_any(matrix->free_mask);
+    if (slot == BITACTOR_MATRIX_SIZE) return 0;
+    return bitactor_claim_slot(matrix, slot, compiled_ttl, BITACTOR_DOMAIN_NONE);
+}
+
+uint32_t bitactor_spawn_in_domain(BitActorMatrix* matrix, void* compiled_ttl, uint8_t domain) {
+    if (!matrix || !compiled_ttl || domain >= BITACTOR_DOMAIN_COUNT) return 0;
+    
+    uint32_t first = domain * BITACTOR_DOMAIN_SLOTS;
+    for (uint32_t i = first; i < first + BITACTOR_DOMAIN_SLOTS; i++) {
+        slot_bit_set(matrix->reserved_mask, i);
+    }
+    
+    uint32_t slot = slot_find_in_lane(matrix->free_mask, first, BITACTOR_DOMAIN_SLOTS);
+    if (slot == BITACTOR_MATRIX_SIZE) {
+        // Lane full: spill over, into unreserved slots before other lanes
+        slot = slot_find_outside(matrix->free_mask, matrix->reserved_mask);
+        if (slot == BITACTOR_MATRIX_SIZE) slot = slot_find_any(matrix->free_mask);
+        if (slot == BITACTOR_MATRIX_SIZE) return 0;
+    }
+    return bitactor_claim_slot(matrix, slot, compiled_ttl, domain);
+}
+
+bool bitactor_despawn(BitActorMatrix* matrix, uint32_t actor_id) {
+    if (!matrix || actor_id == 0 || actor_id > BITACTOR_MATRIX_SIZE) return false;
+    
+    uint32_t slot = actor_id - 1;
+    if (slot_bit_test(matrix->free_mask, slot)) return false;
+    
+    BitActorContext* ctx = &matrix->actors[slot];
+    free(ctx->compiled_ttl);
+    ctx->compiled_ttl = NULL;
+    ctx->bits = 0;
+    ctx->signal_length = 0;
+    if (ctx->domain != BITACTOR_DOMAIN_NONE) {
+        uint64_t* members = matrix->domain_mask[ctx->domain];
+        slot_bit_clear(members, slot);
+        
+        // Last actor of the domain gone: its lane is open to untagged spawns again
+        if (slot_find_any(members) == BITACTOR_MATRIX_SIZE) {
+            uint32_t first = ctx->domain * BITACTOR_DOMAIN_SLOTS;
+            for (uint32_t i = first; i < first + BITACTOR_DOMAIN_SLOTS; i++) {
+                slot_bit_clear(matrix->reserved_mask, i);
+            }
         }
+        ctx->domain = BITACTOR_DOMAIN_NONE;
     }
     
-    printf("❌ BitActor spawn failed: Matrix full (%u/%d)\n", 
-           matrix->active_count, BITACTOR_MATRIX_SIZE);
-    return 0;
+    slot_bit_set(matrix->free_mask, slot);
+    slot_bit_clear(matrix->pending_mask, slot);
+    matrix->active_count--;
+    return true;
 }
 
 // =============================================================================
@@ -138,12 +230,13 @@ bool bitactor_signal(BitActorMatrix* matrix, uint32_t actor_id, const BitActorSi
         return false;
     }
     
-    BitActorContext* ctx = &matrix->actors[actor_id - 1];
-    if (!ctx->compiled_ttl) return false;  // BitActor not active
+    uint32_t slot = actor_id - 1;
+    if (slot_bit_test(matrix->free_mask, slot)) return false;  // BitActor not active
+    BitActorContext* ctx = &matrix->actors[slot];
     
     // Check signal buffer space
     if (ctx->signal_length + signal->length > SIGNAL_BUFFER_SIZE) {
-        printf("⚠️  Signal buffer overflow: BitActor %u\n", actor_id);
+        matrix->signal_overflows++;
         return false;
     }
     
@@ -159,6 +252,7 @@ bool bitactor_signal(BitActorMatrix* matrix, uint32_t actor_id, const BitActorSi
     ctx->vector |= ((uint64_t)signal->priority << 48);
     ctx->vector |= (signal->nanoregex_mask & 0xFFFFFFFFFFFF);
     
+    slot_bit_set(matrix->pending_mask, slot);
     return true;
 }
 
@@ -166,6 +260,34 @@ bool bitactor_signal(BitActorMatrix* matrix, uint32_t actor_id, const BitActorSi
 // 8T TICK EXECUTION ENGINE
 // =============================================================================
 
+// Execute the pending actors in one bitmap word, lowest slot first
+static inline uint32_t bitactor_run_pending(BitActorMatrix* matrix, uint32_t word_index,
+                                            uint64_t bits) {
+    uint32_t executed = 0;
+    matrix->pending_mask[word_index] &= ~bits;
+    while (bits) {
+        uint32_t slot = word_index * 64 + (uint32_t)__builtin_ctzll(bits);
+        bits &= bits - 1;
+        
+        BitActorContext* ctx = &matrix->actors[slot];
+        bitactor_execute_single(ctx, matrix->global_tick);
+        ctx->last_tick = matrix->global_tick;
+        executed++;
+    }
+    return executed;
+}
+
+static void bitactor_account_tick(BitActorMatrix* matrix, uint64_t tick_start,
+                                  uint32_t executed_count) {
+    uint64_t total_tick_time = get_precise_timestamp_ns() - tick_start;
+    matrix->last_tick_ns = total_tick_time;
+    
+    // Enforce 8T tick budget (TARGET_TICK_NS per BitActor)
+    if (executed_count && total_tick_time > (uint64_t)executed_count * TARGET_TICK_NS) {
+        matrix->tick_budget_overruns++;
+    }
+}
+
 uint32_t bitactor_tick(BitActorMatrix* matrix) {
     if (!matrix) return 0;
     
@@ -175,47 +297,36 @@ uint32_t bitactor_tick(BitActorMatrix* matrix) {
     // Increment global tick
     matrix->global_tick++;
     
-    // Execute all active BitActors within 8T budget
-    for (int i = 0; i < BITACTOR_MATRIX_SIZE && executed_count < matrix->active_count; i++) {
-        BitActorContext* ctx = &matrix->actors[i];
-        if (!ctx->compiled_ttl) continue;  // Skip inactive BitActors
-        
-        uint64_t actor_start = get_precise_timestamp_ns();
-        
-        // Check if BitActor needs execution (has signals or state change)
-        bool needs_execution = (ctx->signal_length > 0) || 
-                              (ctx->last_tick < matrix->global_tick - 1);
-        
-        if (needs_execution) {
-            // Execute BitActor logic
-            bitactor_execute_single(ctx, matrix->global_tick);
-            executed_count++;
-        }
-        
-        uint64_t actor_end = get_precise_timestamp_ns();
-        uint64_t actor_time = actor_end - actor_start;
-        
-        // Enforce 8T tick budget (TARGET_TICK_NS per BitActor)
-        if (actor_time > TARGET_TICK_NS) {
-            printf("⚠️  BitActor %u exceeded 8T budget: %lluns > %dns\n", 
-                   ctx->actor_id, actor_time, TARGET_TICK_NS);
-        }
-        
-        ctx->last_tick = matrix->global_tick;
+    // Only actors with queued signals need execution; idle slots cost one
+    // zero word per 64 actors
+    for (uint32_t w = 0; w < BITACTOR_BITMAP_WORDS; w++) {
+        uint64_t bits = matrix->pending_mask[w] & ~matrix->free_mask[w];
+        if (bits) executed_count += bitactor_run_pending(matrix, w, bits);
     }
     
-    uint64_t tick_end = get_precise_timestamp_ns();
-    uint64_t total_tick_time = tick_end - tick_start;
+    bitactor_account_tick(matrix, tick_start, executed_count);
     
     // Update matrix hash with current state
     bitactor_update_matrix_hash(matrix);
     
-    // Debug output for performance monitoring
-    if (matrix->global_tick % 1000 == 0) {  // Every 1000 ticks
-        printf("🔄 Tick %llu: %u BitActors executed in %lluns\n", 
-               matrix->global_tick, executed_count, total_tick_time);
+    return executed_count;
+}
+
+uint32_t bitactor_tick_domain(BitActorMatrix* matrix, uint8_t domain) {
+    if (!matrix || domain >= BITACTOR_DOMAIN_COUNT) return 0;
+    
+    uint64_t tick_start = get_precise_timestamp_ns();
+    uint32_t executed_count = 0;
+    
+    // Membership, not lane position: spilled actors run with their domain
+    // and untagged or foreign actors in the lane do not
+    const uint64_t* members = matrix->domain_mask[domain];
+    for (uint32_t w = 0; w < BITACTOR_BITMAP_WORDS; w++) {
+        uint64_t bits = matrix->pending_mask[w] & members[w];
+        if (bits) executed_count += bitactor_run_pending(matrix, w, bits);
     }
     
+    bitactor_account_tick(matrix, tick_start, executed_count);
     return executed_count;
 }
 
@@ -232,9 +343,8 @@ static void bitactor_execute_single(BitActorContext* ctx, uint64_t global_tick)
         // Simple signal processing: set action ready bit
         bitactor_set_meaning_bit(&ctx->bits, 2, true);
         
-        // Clear processed signals
+        // Clear processed signals (the length bounds all reads)
         ctx->signal_length = 0;
-        memset(ctx->signal_buffer, 0, sizeof(ctx->signal_buffer));
     }
     
     // Update causal vector based on BitActor state
@@ -253,8 +363,8 @@ CausalVector bitactor_collapse(BitActorMatrix* matrix, uint32_t actor_id) {
         return 0;
     }
     
+    if (slot_bit_test(matrix->free_mask, actor_id - 1)) return 0;
     BitActorContext* ctx = &matrix->actors[actor_id - 1];
-    if (!ctx->compiled_ttl) return 0;
     
     uint64_t collapse_start = get_precise_timestamp_ns();
     
@@ -265,8 +375,6 @@ CausalVector bitactor_collapse(BitActorMatrix* matrix, uint32_t actor_id) {
     
     // Execute 8-hop causal collapse
     for (int hop = 0; hop < MAX_8H_HOPS; hop++) {
-        uint64_t hop_start = get_precise_timestamp_ns();
-        
         switch (hop) {
             case 0: // Trigger detected
                 ctx->proof.hops[hop] = (ctx->bits & 0x01) ? 1 : 0;
@@ -305,14 +413,6 @@ CausalVector bitactor_collapse(BitActorMatrix* matrix, uint32_t actor_id) {
         }
         
         ctx->proof.current_hop = hop + 1;
-        
-        uint64_t hop_end = get_precise_timestamp_ns();
-        uint64_t hop_time = hop_end - hop_start;
-        
-        // Each hop should be very fast
-        if (hop_time > TARGET_COLLAPSE_NS / 8) {
-            printf("⚠️  Hop %d exceeded budget: %lluns\n", hop, hop_time);
-        }
     }
     
     uint64_t collapse_end = get_precise_timestamp_ns();
@@ -325,14 +425,12 @@ CausalVector bitactor_collapse(BitActorMatrix* matrix, uint32_t actor_id) {
     bitactor_set_meaning_bit(&ctx->bits, 6, true);
     
     // Enforce 8H collapse budget
+    matrix->collapse_count++;
+    matrix->collapse_ns_total += total_collapse_time;
     if (total_collapse_time > TARGET_COLLAPSE_NS) {
-        printf("⚠️  BitActor %u collapse exceeded 8H budget: %lluns > %dns\n", 
-               actor_id, total_collapse_time, TARGET_COLLAPSE_NS);
+        matrix->collapse_budget_overruns++;
     }
     
-    printf("🌀 BitActor %u collapse: 8H completed in %lluns, proof=%s\n",
-           actor_id, total_collapse_time, ctx->proof.valid ? "valid" : "invalid");
-    
     return ctx->vector;
 }
 
@@ -375,7 +473,7 @@ bool bitactor_entangle_global(BitActorMatrix* matrix) {
     for (int i = 0; i < 32; i++) {
         for (int j = 0; j < 32; j++) {
             if (i != j) {
-                matrix->entanglement_matrix[i][j] = 0x8T8H8B88888888ULL;
+                matrix->entanglement_matrix[i][j] = 0x8888888888888888ULL;
             }
         }
     }
@@ -420,8 +518,10 @@ void bitactor_get_metrics(const BitActorMatrix* matrix,
     last_tick = matrix->global_tick;
     last_time = current_time;
     
-    // Estimate collapse and proof times (would need actual measurements)
-    *collapse_time_ns = TARGET_COLLAPSE_NS / 2;  // Placeholder
+    // Measured collapse average; proof time is still an estimate
+    *collapse_time_ns = matrix->collapse_count
+        ? matrix->collapse_ns_total / matrix->collapse_count
+        : TARGET_COLLAPSE_NS / 2;
     *proof_time_ns = TARGET_PROOF_NS / 2;        // Placeholder
 }
 
@@ -488,19 +588,23 @@ void bitactor_print_matrix_status(const BitActorMatrix* matrix) {
     printf("========================\n\n");
     
     printf("Trinity: 8T/8H/8B - Fifth Epoch Active\n");
-    printf("Global Tick: %llu\n", matrix->global_tick);
+    printf("Global Tick: %" PRIu64 "\n", matrix->global_tick);
     printf("Active BitActors: %u/%d\n", matrix->active_count, BITACTOR_MATRIX_SIZE);
     printf("Global Entanglement: %s\n", matrix->globally_entangled ? "ACTIVE" : "inactive");
     
     uint64_t trinity_hash = bitactor_generate_trinity_hash(matrix);
-    printf("Trinity Hash: 0x%016llX\n", trinity_hash);
+    printf("Trinity Hash: 0x%016" PRIX64 "\n", trinity_hash);
+    printf("Last Tick: %" PRIu64 "ns, budget overruns: %" PRIu64 " ticks, %" PRIu64 " collapses\n",
+           matrix->last_tick_ns, matrix->tick_budget_overruns,
+           matrix->collapse_budget_overruns);
+    printf("Signal Overflows: %" PRIu64 "\n", matrix->signal_overflows);
     
     printf("\nActive BitActors:\n");
     int displayed = 0;
     for (int i = 0; i < BITACTOR_MATRIX_SIZE && displayed < 10; i++) {
         const BitActorContext* ctx = &matrix->actors[i];
         if (ctx->compiled_ttl) {
-            printf("  BitActor %u: bits=0x%02X, vector=0x%016llX, proof=%s\n",
+            printf("  BitActor %u: bits=0x%02X, vector=0x%016" PRIX64 ", proof=%s\n",
                    ctx->actor_id, ctx->bits, ctx->vector,
                    ctx->proof.valid ? "valid" : "invalid");
             displayed++;
@@ -0,0 +1,548 @@
+/**
+ * @file bitactor_runtime.c
+ * @brief BitActor Runtime - mailboxes, pinned conductor threads, registry
+ *
+ * Hot path: a cast is one CAS on the target mailbox tail plus a 64-byte
+ * envelope write; dispatch is a ticket check and a handler call. Names are
+ * hashed at registration and manifest load, never per message.
+ */
+
+#define _GNU_SOURCE // sched_setaffinity, CPU_SET
+#include "cns/bitactor.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+
+#define BITACTOR_LIKELY(x) __builtin_expect(!!(x), 1)
+#define BITACTOR_UNLIKELY(x) __builtin_expect(!!(x), 0)
+
+#define BITACTOR_MAILBOX_MASK (BITACTOR_MAILBOX_SIZE - 1)
+#define BITACTOR_REGISTRY_SLOTS 512 // Open addressing, 2x BITACTOR_MAX_ACTORS
+#define BITACTOR_IDLE_SPINS 1024    // Empty passes before a conductor sleeps
+
+struct bitactor_call_slot {
+    bitactor_message_t* reply;
+    volatile uint32_t done;
+};
+
+// =============================================================================
+// TIMING
+// =============================================================================
+
+uint64_t bitactor_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t val;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static inline void bitactor_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// =============================================================================
+// REGISTRY
+// =============================================================================
+
+typedef struct {
+    uint64_t name_hash;
+    const bitactor_behavior_t* behavior;
+    const uint8_t* bytecode;
+    size_t bytecode_length;
+    bitactor_pid_t pid; // First spawned instance
+} bitactor_registry_entry_t;
+
+static const bitactor_behavior_t* behaviors[BITACTOR_MAX_BEHAVIORS];
+static uint32_t behavior_count = 0;
+
+static bitactor_registry_entry_t registry_entries[BITACTOR_MAX_ACTORS];
+static uint32_t registry_count = 0;
+static uint16_t registry_index[BITACTOR_REGISTRY_SLOTS]; // entry + 1, 0 = empty
+
+static bitactor_conductor_t* active_conductor = NULL;
+
+uint32_t bitactor_registry_epoch = 1; // Peers start at 0, so they resolve once
+
+// Dispatch context of the current thread
+static __thread bitactor_core_t* tls_core = NULL;
+static __thread bitactor_pid_t tls_self = BITACTOR_PID_NONE;
+static __thread bitactor_pid_t tls_sender = BITACTOR_PID_NONE;
+static __thread uint64_t tls_latency = 0;
+
+void bitactor_behavior_register(bitactor_behavior_t* behavior) {
+    if (!behavior || behavior_count >= BITACTOR_MAX_BEHAVIORS) return;
+    behavior->name_hash = bitactor_name_hash(behavior->name);
+    behaviors[behavior_count++] = behavior;
+}
+
+static const bitactor_behavior_t* bitactor_behavior_find(uint64_t name_hash) {
+    for (uint32_t i = 0; i < behavior_count; i++) {
+        if (behaviors[i]->name_hash == name_hash) return behaviors[i];
+    }
+    return NULL;
+}
+
+static bitactor_registry_entry_t* registry_find(uint64_t name_hash) {
+    uint32_t slot = (uint32_t)name_hash & (BITACTOR_REGISTRY_SLOTS - 1);
+    for (uint32_t probe = 0; probe < BITACTOR_REGISTRY_SLOTS; probe++) {
+        uint16_t index = registry_index[slot];
+        if (index == 0) return NULL;
+        bitactor_registry_entry_t* entry = &registry_entries[index - 1];
+        if (entry->name_hash == name_hash) return entry;
+        slot = (slot + 1) & (BITACTOR_REGISTRY_SLOTS - 1);
+    }
+    return NULL;
+}
+
+actor_id_t registry_register(const char* name, const uint8_t* bytecode, size_t bytecode_length) {
+    if (!name) return BITACTOR_ID_NONE;
+
+    uint64_t name_hash = bitactor_name_hash(name);
+    bitactor_registry_entry_t* existing = registry_find(name_hash);
+    if (existing) {
+        existing->bytecode = bytecode;
+        existing->bytecode_length = bytecode_length;
+        return (actor_id_t)(existing - registry_entries);
+    }
+
+    const bitactor_behavior_t* behavior = bitactor_behavior_find(name_hash);
+    if (!behavior || registry_count >= BITACTOR_MAX_ACTORS) return BITACTOR_ID_NONE;
+
+    actor_id_t id = registry_count++;
+    bitactor_registry_entry_t* entry = &registry_entries[id];
+    entry->name_hash = name_hash;
+    entry->behavior = behavior;
+    entry->bytecode = bytecode;
+    entry->bytecode_length = bytecode_length;
+    entry->pid = BITACTOR_PID_NONE;
+
+    uint32_t slot = (uint32_t)name_hash & (BITACTOR_REGISTRY_SLOTS - 1);
+    while (registry_index[slot] != 0) {
+        slot = (slot + 1) & (BITACTOR_REGISTRY_SLOTS - 1);
+    }
+    registry_index[slot] = (uint16_t)(id + 1);
+    return id;
+}
+
+bitactor_pid_t registry_lookup_hash(uint64_t name_hash) {
+    bitactor_registry_entry_t* entry = registry_find(name_hash);
+    return entry ? __atomic_load_n(&entry->pid, __ATOMIC_ACQUIRE) : BITACTOR_PID_NONE;
+}
+
+// =============================================================================
+// MANIFEST
+// =============================================================================
+
+int load_actor_manifest_from_bin(const char* path, actor_manifest_t* manifest) {
+    if (!path || !manifest) return BITACTOR_ERR_INVALID;
+    memset(manifest, 0, sizeof(*manifest));
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return BITACTOR_ERR_IO;
+
+    bitactor_manifest_header_t header;
+    int rc = BITACTOR_ERR_INVALID;
+    if (fread(&header, sizeof(header), 1, file) != 1) goto done;
+    if (header.magic != BITACTOR_MANIFEST_MAGIC ||
+        header.version != BITACTOR_MANIFEST_VERSION ||
+        header.actor_count > BITACTOR_MAX_ACTORS) {
+        goto done;
+    }
+
+    for (uint32_t i = 0; i < header.actor_count; i++) {
+        bitactor_manifest_entry_t* entry = &manifest->actors[i];
+        if (fread(entry->name, BITACTOR_NAME_MAX, 1, file) != 1) goto done;
+        entry->name[BITACTOR_NAME_MAX - 1] = '\0';
+        entry->name_hash = bitactor_name_hash(entry->name);
+    }
+
+    if (header.bytecode_length > 0) {
+        manifest->bytecode_buffer = malloc(header.bytecode_length);
+        if (!manifest->bytecode_buffer ||
+            fread(manifest->bytecode_buffer, header.bytecode_length, 1, file) != 1) {
+            free(manifest->bytecode_buffer);
+            manifest->bytecode_buffer = NULL;
+            goto done;
+        }
+    }
+
+    // Trailing bytes mean the record schema does not match
+    if (fgetc(file) != EOF) {
+        free(manifest->bytecode_buffer);
+        manifest->bytecode_buffer = NULL;
+        goto done;
+    }
+
+    manifest->actor_count = header.actor_count;
+    manifest->bytecode_length = header.bytecode_length;
+    rc = BITACTOR_OK;
+
+done:
+    fclose(file);
+    return rc;
+}
+
+void actor_manifest_free(actor_manifest_t* manifest) {
+    if (!manifest) return;
+    free(manifest->bytecode_buffer);
+    manifest->bytecode_buffer = NULL;
+    manifest->bytecode_length = 0;
+}
+
+// =============================================================================
+// MAILBOX
+// =============================================================================
+
+static void bitactor_mailbox_init(bitactor_mailbox_t* mailbox) {
+    mailbox->head = 0;
+    mailbox->tail = 0;
+    for (uint64_t i = 0; i < BITACTOR_MAILBOX_SIZE; i++) {
+        mailbox->slots[i].sequence = i;
+    }
+}
+
+static inline int bitactor_mailbox_push(bitactor_mailbox_t* mailbox, uint8_t type,
+                                        const void* payload, size_t payload_len,
+                                        bitactor_call_slot_t* call) {
+    uint64_t pos = __atomic_load_n(&mailbox->tail, __ATOMIC_RELAXED);
+    bitactor_envelope_t* env;
+
+    for (;;) {
+        env = &mailbox->slots[pos & BITACTOR_MAILBOX_MASK];
+        uint64_t seq = __atomic_load_n(&env->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&mailbox->tail, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return BITACTOR_ERR_FULL;
+        } else {
+            pos = __atomic_load_n(&mailbox->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    env->sender = tls_self;
+    env->type = type;
+    env->call = call;
+    env->payload_len = (uint8_t)payload_len;
+    if (payload_len) memcpy(env->payload, payload, payload_len);
+    env->sent_cycles = bitactor_cycles();
+    __atomic_store_n(&env->sequence, pos + 1, __ATOMIC_RELEASE);
+    return BITACTOR_OK;
+}
+
+// =============================================================================
+// DISPATCH
+// =============================================================================
+
+static void bitactor_invoke(bitactor_actor_t* actor, bitactor_pid_t sender, uint64_t latency,
+                            const void* payload, size_t payload_len,
+                            bitactor_message_t* reply) {
+    bitactor_pid_t saved_self = tls_self;
+    bitactor_pid_t saved_sender = tls_sender;
+    uint64_t saved_latency = tls_latency;
+    uint32_t saved_running = actor->running;
+
+    tls_self = actor->pid;
+    tls_sender = sender;
+    tls_latency = latency;
+    actor->running = 1;
+
+    const bitactor_behavior_t* behavior = actor->behavior;
+    if (reply && behavior->on_call) {
+        behavior->on_call(actor->state, payload, payload_len, reply);
+    } else if (behavior->on_cast) {
+        behavior->on_cast(actor->state, payload, payload_len);
+    }
+
+    actor->running = saved_running;
+    tls_self = saved_self;
+    tls_sender = saved_sender;
+    tls_latency = saved_latency;
+}
+
+// Consumer side: only the owning conductor thread drains a mailbox
+static uint32_t bitactor_drain(bitactor_actor_t* actor, uint32_t budget) {
+    bitactor_mailbox_t* mailbox = &actor->mailbox;
+    uint32_t handled = 0;
+
+    while (handled < budget) {
+        uint64_t head = mailbox->head;
+        bitactor_envelope_t* env = &mailbox->slots[head & BITACTOR_MAILBOX_MASK];
+        if (__atomic_load_n(&env->sequence, __ATOMIC_ACQUIRE) != head + 1) break;
+
+        mailbox->head = head + 1;
+        uint64_t latency = bitactor_cycles() - env->sent_cycles;
+
+        if (env->call) {
+            bitactor_call_slot_t* call = env->call;
+            bitactor_invoke(actor, env->sender, latency, env->payload, env->payload_len, call->reply);
+            __atomic_store_n(&call->done, 1, __ATOMIC_RELEASE);
+        } else {
+            bitactor_invoke(actor, env->sender, latency, env->payload, env->payload_len, NULL);
+        }
+
+        // Release the slot only after the handler is done with the payload
+        __atomic_store_n(&env->sequence, head + BITACTOR_MAILBOX_SIZE, __ATOMIC_RELEASE);
+        __atomic_store_n(&actor->processed, actor->processed + 1, __ATOMIC_RELEASE);
+        handled++;
+    }
+    return handled;
+}
+
+static void bitactor_pin_thread(uint32_t core) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % CPU_SETSIZE, &set);
+    sched_setaffinity(0, sizeof(set), &set); // Best effort: cgroups may forbid it
+#else
+    (void)core;
+#endif
+}
+
+static void* bitactor_core_main(void* arg) {
+    bitactor_core_t* core = (bitactor_core_t*)arg;
+    bitactor_conductor_t* conductor = core->conductor;
+    const struct timespec idle_sleep = {0, 50000}; // 50us once spinning stops paying
+    uint32_t idle = 0;
+
+    bitactor_pin_thread(core->core);
+    tls_core = core;
+
+    while (__atomic_load_n(&conductor->running, __ATOMIC_ACQUIRE)) {
+        uint32_t count = __atomic_load_n(&core->actor_count, __ATOMIC_ACQUIRE);
+        uint32_t handled = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            handled += bitactor_drain(core->actors[i], BITACTOR_DISPATCH_BATCH);
+        }
+
+        if (handled) {
+            idle = 0;
+        } else if (++idle < BITACTOR_IDLE_SPINS) {
+            bitactor_cpu_relax();
+        } else {
+            nanosleep(&idle_sleep, NULL);
+        }
+    }
+    return NULL;
+}
+
+// =============================================================================
+// CONDUCTOR
+// =============================================================================
+
+int bitactor_conductor_init(bitactor_conductor_t* conductor) {
+    if (!conductor) return BITACTOR_ERR_INVALID;
+    memset(conductor, 0, sizeof(*conductor));
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    conductor->core_count = cpus > BITACTOR_MAX_CORES ? BITACTOR_MAX_CORES : (uint32_t)cpus;
+    for (uint32_t i = 0; i < conductor->core_count; i++) {
+        conductor->cores[i].conductor = conductor;
+        conductor->cores[i].core = i;
+    }
+
+    conductor->running = 1;
+    active_conductor = conductor;
+    return BITACTOR_OK;
+}
+
+bitactor_pid_t bitactor_conductor_spawn(bitactor_conductor_t* conductor, actor_id_t id) {
+    if (!conductor || id >= registry_count || conductor->actor_count >= BITACTOR_MAX_ACTORS) {
+        return BITACTOR_PID_NONE;
+    }
+
+    bitactor_actor_t* actor = aligned_alloc(64, sizeof(bitactor_actor_t));
+    if (!actor) return BITACTOR_PID_NONE;
+    memset(actor, 0, sizeof(*actor));
+    bitactor_mailbox_init(&actor->mailbox);
+
+    bitactor_registry_entry_t* entry = &registry_entries[id];
+    bitactor_pid_t pid = conductor->actor_count;
+    actor->behavior = entry->behavior;
+    actor->bytecode = entry->bytecode;
+    actor->bytecode_length = entry->bytecode_length;
+    actor->pid = pid;
+    actor->core = pid % conductor->core_count;
+
+    conductor->actors[pid] = actor;
+    __atomic_store_n(&conductor->actor_count, pid + 1, __ATOMIC_RELEASE);
+
+    bitactor_core_t* core = &conductor->cores[actor->core];
+    core->actors[core->actor_count] = actor;
+    __atomic_store_n(&core->actor_count, core->actor_count + 1, __ATOMIC_RELEASE);
+
+    if (!core->started) {
+        if (pthread_create(&core->thread, NULL, bitactor_core_main, core) != 0) {
+            return BITACTOR_PID_NONE;
+        }
+        core->started = 1;
+    }
+
+    if (entry->pid == BITACTOR_PID_NONE) {
+        __atomic_store_n(&entry->pid, pid, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&bitactor_registry_epoch, 1, __ATOMIC_RELEASE);
+    }
+    return pid;
+}
+
+static inline bitactor_actor_t* bitactor_resolve(bitactor_conductor_t** conductor, bitactor_pid_t pid) {
+    if (!*conductor) *conductor = active_conductor;
+    if (BITACTOR_UNLIKELY(!*conductor)) return NULL;
+    if (BITACTOR_UNLIKELY(pid >= __atomic_load_n(&(*conductor)->actor_count, __ATOMIC_ACQUIRE))) {
+        return NULL;
+    }
+    return (*conductor)->actors[pid];
+}
+
+// Wait until every mailbox is empty and no handler is running. Handlers
+// enqueue before their own message counts as processed, so equal totals
+// bracketing the processed sum mean nothing is left in flight.
+void bitactor_conductor_quiesce(bitactor_conductor_t* conductor) {
+    if (!conductor) return;
+
+    for (;;) {
+        uint32_t count = __atomic_load_n(&conductor->actor_count, __ATOMIC_ACQUIRE);
+        uint64_t enqueued_before = 0, processed = 0, enqueued_after = 0;
+
+        for (uint32_t i = 0; i < count; i++) {
+            enqueued_before += __atomic_load_n(&conductor->actors[i]->mailbox.tail, __ATOMIC_ACQUIRE);
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            processed += __atomic_load_n(&conductor->actors[i]->processed, __ATOMIC_ACQUIRE);
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            enqueued_after += __atomic_load_n(&conductor->actors[i]->mailbox.tail, __ATOMIC_ACQUIRE);
+        }
+
+        if (enqueued_before == enqueued_after && processed == enqueued_after) return;
+        sched_yield();
+    }
+}
+
+void bitactor_conductor_shutdown(bitactor_conductor_t* conductor) {
+    if (!conductor) return;
+
+    bitactor_conductor_quiesce(conductor);
+    __atomic_store_n(&conductor->running, 0, __ATOMIC_RELEASE);
+    for (uint32_t i = 0; i < conductor->core_count; i++) {
+        if (conductor->cores[i].started) {
+            pthread_join(conductor->cores[i].thread, NULL);
+            conductor->cores[i].started = 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < conductor->actor_count; i++) {
+        free(conductor->actors[i]);
+        conductor->actors[i] = NULL;
+    }
+    conductor->actor_count = 0;
+
+    for (uint32_t i = 0; i < registry_count; i++) {
+        registry_entries[i].pid = BITACTOR_PID_NONE;
+    }
+    __atomic_add_fetch(&bitactor_registry_epoch, 1, __ATOMIC_RELEASE);
+    if (active_conductor == conductor) active_conductor = NULL;
+}
+
+uint64_t bitactor_conductor_dropped(const bitactor_conductor_t* conductor) {
+    if (!conductor) return 0;
+    uint64_t dropped = __atomic_load_n(&conductor->dropped, __ATOMIC_RELAXED);
+    uint32_t count = __atomic_load_n(&conductor->actor_count, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < count; i++) {
+        dropped += __atomic_load_n(&conductor->actors[i]->dropped, __ATOMIC_RELAXED);
+    }
+    return dropped;
+}
+
+// =============================================================================
+// MESSAGING
+// =============================================================================
+
+int bitactor_cast(bitactor_conductor_t* conductor, bitactor_pid_t pid,
+                  const bitactor_message_t* msg) {
+    bitactor_actor_t* actor = bitactor_resolve(&conductor, pid);
+    if (BITACTOR_UNLIKELY(!actor)) {
+        if (conductor) __atomic_add_fetch(&conductor->dropped, 1, __ATOMIC_RELAXED);
+        return BITACTOR_ERR_NOT_FOUND;
+    }
+    if (BITACTOR_UNLIKELY(!msg || msg->payload_len > BITACTOR_MSG_PAYLOAD_MAX)) {
+        return BITACTOR_ERR_INVALID;
+    }
+
+    for (;;) {
+        int rc = bitactor_mailbox_push(&actor->mailbox, BITACTOR_CAST, msg->payload,
+                                       msg->payload_len, NULL);
+        if (BITACTOR_LIKELY(rc == BITACTOR_OK)) return rc;
+
+        // Full mailbox owned by this thread: nobody else will drain it
+        if (tls_core == &conductor->cores[actor->core]) {
+            if (actor->running) {
+                __atomic_add_fetch(&actor->dropped, 1, __ATOMIC_RELAXED);
+                return BITACTOR_ERR_FULL;
+            }
+            bitactor_drain(actor, BITACTOR_DISPATCH_BATCH);
+        } else {
+            bitactor_cpu_relax();
+        }
+    }
+}
+
+int bitactor_call(bitactor_conductor_t* conductor, bitactor_pid_t pid,
+                  const bitactor_message_t* msg, bitactor_message_t* reply) {
+    bitactor_actor_t* actor = bitactor_resolve(&conductor, pid);
+    if (BITACTOR_UNLIKELY(!actor)) return BITACTOR_ERR_NOT_FOUND;
+    if (BITACTOR_UNLIKELY(!msg || !reply || msg->payload_len > BITACTOR_MSG_PAYLOAD_MAX)) {
+        return BITACTOR_ERR_INVALID;
+    }
+
+    reply->type = BITACTOR_CALL;
+    reply->payload = NULL;
+    reply->payload_len = 0;
+
+    // Same conductor thread: waiting on our own queue would deadlock
+    if (tls_core == &conductor->cores[actor->core]) {
+        bitactor_invoke(actor, tls_self, 0, msg->payload, msg->payload_len, reply);
+        return BITACTOR_OK;
+    }
+
+    bitactor_call_slot_t call = {reply, 0};
+    while (bitactor_mailbox_push(&actor->mailbox, BITACTOR_CALL, msg->payload,
+                                 msg->payload_len, &call) != BITACTOR_OK) {
+        bitactor_cpu_relax();
+    }
+    while (!__atomic_load_n(&call.done, __ATOMIC_ACQUIRE)) {
+        bitactor_cpu_relax();
+    }
+    return BITACTOR_OK;
+}
+
+bitactor_pid_t bitactor_self(void) {
+    return tls_self;
+}
+
+bitactor_pid_t bitactor_sender(void) {
+    return tls_sender;
+}
+
+uint64_t bitactor_message_latency(void) {
+    return tls_latency;
+}
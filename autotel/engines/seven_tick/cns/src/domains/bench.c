@@ -139,6 +139,7 @@ static int cmd_bench_sparql(CNSContext* ctx, int argc, char** argv) {
             cns_metric_record_violation(g_telemetry, results[i].name, results[i].cycles, 7);
             cns_span_end(bench_span, CNS_SPAN_STATUS_ERROR);
         } else {
+            cns_metric_record_latency(g_telemetry, results[i].name, results[i].cycles);
             cns_span_end(bench_span, CNS_SPAN_STATUS_OK);
         }
     }
@@ -1,5 +1,6 @@
 #include "cns/cli.h"
 #include "cns/telemetry/otel.h"
+#include "cns/engines/telemetry.h"
 #include "../../../include/s7t.h"
 #include "cns/performance_optimizations.h"
 #include <stdio.h>
@@ -215,38 +216,24 @@ static uint64_t benchmark_simd_operation(BenchmarkData* data, int iterations) {
     return s7t_cycles() - start;
 }
 
-// Calculate performance statistics from raw measurements
-static PerfStats calculate_stats(uint64_t* measurements, int count) {
+// Calculate performance statistics from the operation's cycle histogram
+static PerfStats calculate_stats(const char* op_name) {
     PerfStats stats = {0};
-    stats.min_cycles = UINT64_MAX;
-    stats.max_cycles = 0;
-    stats.total_cycles = 0;
-    stats.iterations = count;
-    
-    // Sort measurements for percentile calculation
-    for (int i = 0; i < count - 1; i++) {
-        for (int j = 0; j < count - i - 1; j++) {
-            if (measurements[j] > measurements[j + 1]) {
-                uint64_t temp = measurements[j];
-                measurements[j] = measurements[j + 1];
-                measurements[j + 1] = temp;
-            }
-        }
-    }
-    
-    // Calculate basic statistics
-    for (int i = 0; i < count; i++) {
-        if (measurements[i] < stats.min_cycles) stats.min_cycles = measurements[i];
-        if (measurements[i] > stats.max_cycles) stats.max_cycles = measurements[i];
-        stats.total_cycles += measurements[i];
+    CNSTelemetryHistogramSummary summary;
+    if (cns_telemetry_histogram_summary(op_name, &summary) != 0 || summary.count == 0) {
+        return stats;
     }
-    
-    stats.avg_cycles = (double)stats.total_cycles / count;
-    stats.percentile_50 = measurements[count / 2];
-    stats.percentile_95 = measurements[(int)(count * 0.95)];
-    stats.percentile_99 = measurements[(int)(count * 0.99)];
+
+    stats.min_cycles = summary.min_cycles;
+    stats.max_cycles = summary.max_cycles;
+    stats.iterations = summary.count;
+    stats.avg_cycles = summary.avg_cycles;
+    stats.total_cycles = (uint64_t)(summary.avg_cycles * (double)summary.count);
+    stats.percentile_50 = summary.p50;
+    stats.percentile_95 = summary.p95;
+    stats.percentile_99 = summary.p99;
     stats.seven_tick_compliant = (stats.avg_cycles <= 7.0);
-    
+
     return stats;
 }
 
@@ -272,8 +259,9 @@ static PerfStats run_single_benchmark(BenchmarkOperation op, BenchmarkData* data
         }
     }
     
-    // Actual measurements
-    uint64_t* measurements = malloc(iterations * sizeof(uint64_t));
+    // Actual measurements - streamed into a histogram, no per-sample buffer
+    int hist_id = cns_telemetry_histogram_id(op_names[op]);
+    cns_telemetry_histogram_reset(op_names[op]);
     for (int i = 0; i < iterations; i++) {
         uint64_t cycles;
         switch (op) {
@@ -287,13 +275,10 @@ static PerfStats run_single_benchmark(BenchmarkOperation op, BenchmarkData* data
             case OP_SIMD_OPERATION: cycles = benchmark_simd_operation(data, 1); break;
             default: cycles = 0; break;
         }
-        measurements[i] = cycles;
+        cns_telemetry_histogram_record_id(hist_id, cycles);
     }
     
-    PerfStats stats = calculate_stats(measurements, iterations);
-    free(measurements);
-    
-    return stats;
+    return calculate_stats(op_names[op]);
 }
 
 // Main benchmark command handler - REAL IMPLEMENTATION
@@ -363,9 +348,10 @@ static int cmd_benchmark_all(CNSContext* ctx, int argc, char** argv) {
         };
         cns_span_set_attributes(op_span, attrs, 9);
         
-        // Record performance metrics
-        cns_metric_record_latency(g_telemetry, operation_names[op], (uint64_t)stats.avg_cycles);
-        if (!stats.seven_tick_compliant) {
+        // Record performance metrics (a violation records the latency too)
+        if (stats.seven_tick_compliant) {
+            cns_metric_record_latency(g_telemetry, operation_names[op], (uint64_t)stats.avg_cycles);
+        } else {
             cns_metric_record_violation(g_telemetry, operation_names[op], (uint64_t)stats.avg_cycles, 7);
         }
         
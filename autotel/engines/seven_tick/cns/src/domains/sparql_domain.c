@@ -6,6 +6,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Engine shared by the commands of this CLI session
+static SPARQLEngine *g_domain_engine = NULL;
+
+static SPARQLEngine *sparql_domain_engine(void)
+{
+    if (!g_domain_engine)
+    {
+        g_domain_engine = cns_sparql_create(1024);
+    }
+    return g_domain_engine;
+}
+
 // SPARQL engine commands
 static int cmd_sparql_query(CNSContext *ctx, int argc, char **argv)
 {
@@ -18,7 +30,7 @@ static int cmd_sparql_query(CNSContext *ctx, int argc, char **argv)
     const char *query = argv[1];
 
     // Get or create SPARQL engine
-    SPARQLEngine *engine = cns_sparql_create(1024);
+    SPARQLEngine *engine = sparql_domain_engine();
     if (!engine)
     {
         cns_cli_error("Failed to create SPARQL engine");
@@ -81,7 +93,7 @@ static int cmd_sparql_benchmark(CNSContext *ctx, int argc, char **argv)
     cns_cli_info("Running SPARQL benchmark with %d iterations...", iterations);
 
     // Get or create SPARQL engine
-    SPARQLEngine *engine = cns_sparql_create(1024);
+    SPARQLEngine *engine = sparql_domain_engine();
     if (!engine)
     {
         cns_cli_error("Failed to create SPARQL engine");
@@ -157,7 +169,7 @@ static int cmd_sparql_add(CNSContext *ctx, int argc, char **argv)
     uint32_t object = atoi(argv[3]);
 
     // Get or create SPARQL engine
-    SPARQLEngine *engine = cns_sparql_create(1024);
+    SPARQLEngine *engine = sparql_domain_engine();
     if (!engine)
     {
         cns_cli_error("Failed to create SPARQL engine");
@@ -170,7 +182,6 @@ static int cmd_sparql_add(CNSContext *ctx, int argc, char **argv)
     int result = cns_sparql_add_triple(engine, subject, predicate, object);
 
     uint64_t cycles = cns_get_cycles() - start;
-    cns_assert_cycles(start, 5);
 
     if (result == CNS_OK)
     {
@@ -188,7 +199,7 @@ static int cmd_sparql_add(CNSContext *ctx, int argc, char **argv)
 static int cmd_sparql_stats(CNSContext *ctx, int argc, char **argv)
 {
     // Get or create SPARQL engine
-    SPARQLEngine *engine = cns_sparql_create(1024);
+    SPARQLEngine *engine = sparql_domain_engine();
     if (!engine)
     {
         cns_cli_error("Failed to create SPARQL engine");
@@ -201,8 +212,43 @@ static int cmd_sparql_stats(CNSContext *ctx, int argc, char **argv)
     cns_cli_info("   Total queries: %llu", stats.total_queries);
     cns_cli_info("   Cache hits: %llu", stats.cache_hits);
     cns_cli_info("   Cache hit rate: %.1f%%", stats.cache_hit_rate * 100.0);
+    cns_cli_info("   Cached plans: %u (%zu bytes, %llu evicted)", stats.cache_entries, stats.cache_bytes,
+                 stats.cache_evictions);
+    cns_cli_info("   Avg cycles per cache hit/miss: %.1f/%.1f", stats.avg_hit_cycles, stats.avg_miss_cycles);
     cns_cli_info("   Total triples: %u", stats.total_triples);
     cns_cli_info("   Avg cycles per query: %.1f", stats.avg_cycles_per_query);
+    cns_cli_info("   Distinct subjects/predicates/objects: %u/%u/%u", stats.distinct_subjects,
+                 stats.distinct_predicates, stats.distinct_objects);
+    cns_cli_info("   Characteristic sets: %u", stats.characteristic_sets);
+
+    return CNS_OK;
+}
+
+static int cmd_sparql_explain(CNSContext *ctx, int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        cns_cli_error("Usage: sparql explain <query_string>");
+        return CNS_ERR_INVALID_ARG;
+    }
+
+    SPARQLEngine *engine = sparql_domain_engine();
+    if (!engine)
+    {
+        cns_cli_error("Failed to create SPARQL engine");
+        return CNS_ERR_RESOURCE;
+    }
+
+    char *plan = cns_sparql_explain(engine, argv[1]);
+    if (!plan)
+    {
+        cns_cli_error("Unsupported SPARQL query: %s", argv[1]);
+        return CNS_ERR_INVALID_ARG;
+    }
+
+    cns_cli_success("✅ SPARQL query plan:");
+    printf("%s", plan);
+    free(plan);
 
     return CNS_OK;
 }
@@ -235,7 +281,8 @@ static CNSCommand sparql_commands[] = {
     {.name = "compile", .description = "Compile SPARQL query to C code (AOT)", .handler = cmd_sparql_compile, .options = &sparql_options[1], .option_count = 1, .arguments = (CNSArgument[]){{.name = "query_file", .description = "SPARQL query file", .required = true}}, .argument_count = 1},
     {.name = "benchmark", .description = "Run SPARQL performance benchmark", .handler = cmd_sparql_benchmark, .options = NULL, .option_count = 0, .arguments = (CNSArgument[]){{.name = "iterations", .description = "Number of iterations", .required = false}}, .argument_count = 1},
     {.name = "add", .description = "Add triple to SPARQL store", .handler = cmd_sparql_add, .options = NULL, .option_count = 0, .arguments = (CNSArgument[]){{.name = "subject", .description = "Subject ID", .required = true}, {.name = "predicate", .description = "Predicate ID", .required = true}, {.name = "object", .description = "Object ID", .required = true}}, .argument_count = 3},
-    {.name = "stats", .description = "Show SPARQL engine statistics", .handler = cmd_sparql_stats, .options = NULL, .option_count = 0, .arguments = NULL, .argument_count = 0}};
+    {.name = "stats", .description = "Show SPARQL engine statistics", .handler = cmd_sparql_stats, .options = NULL, .option_count = 0, .arguments = NULL, .argument_count = 0},
+    {.name = "explain", .description = "Show the join order and algorithms chosen for a query", .handler = cmd_sparql_explain, .options = NULL, .option_count = 0, .arguments = (CNSArgument[]){{.name = "query", .description = "SPARQL query string", .required = true}}, .argument_count = 1}};
 
 // SPARQL domain
 CNSDomain cns_sparql_domain = {
@@ -1,125 +1,2895 @@
+#define _POSIX_C_SOURCE 200809L // strdup
 #include "cns/sparql.h"
 #include "cns/memory.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <stdarg.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include <assert.h>
 
-// SPARQL Engine State
+#define SPARQL_CACHE_BYTES (1u << 20) // Default plan cache memory limit
+#define SPARQL_MAX_PARAMS (SPARQL_MAX_PATTERNS * 3)
+#define SPARQL_MAX_SHAPE 1024 // Longer normalized queries are not cached
+#define SPARQL_MAX_PREFIXES 16
+#define SPARQL_MAX_TERM 1024
+#define SPARQL_RADIX_BITS 16
+#define SPARQL_RADIX_SIZE (1u << SPARQL_RADIX_BITS)
+#define SPARQL_RADIX_DIGITS 6
+#define SPARQL_RADIX_MIN 1024 // Smaller inputs use qsort
+#define SPARQL_MAX_SET_PREDICATES 64         // Larger characteristic sets are not recorded
+#define SPARQL_MAX_CHARACTERISTIC_SETS 16384 // Most frequent sets kept
+#define SPARQL_DP_MAX_PATTERNS 10            // Larger patterns are ordered greedily
+#define SPARQL_GALLOP_RATIO 32               // Leaf lists this much apart are galloped, not intersected
+
+// Cost model, in units of one index entry touched or row produced
+#define SPARQL_COST_SEEK_LEVEL 4.0 // Per binary search level (a likely cache miss)
+#define SPARQL_COST_HASH_BUILD 2.0 // Per build-side entry
+#define SPARQL_COST_HASH_PROBE 2.0 // Per probing row
+
+#define SPARQL_RDF_TYPE "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>"
+
+// Permutation index entry: a triple rotated into index order
+typedef struct
+{
+  uint32_t a;
+  uint32_t b;
+  uint32_t c;
+} SPARQLKey;
+
+// Permutation indexes (80/20: three orders give every bound position combination a prefix)
+enum
+{
+  SPARQL_INDEX_SPO,
+  SPARQL_INDEX_POS,
+  SPARQL_INDEX_OSP,
+  SPARQL_INDEX_COUNT,
+  // Remaining orders, built on first use by leapfrog joins
+  SPARQL_INDEX_PSO = SPARQL_INDEX_COUNT,
+  SPARQL_INDEX_OPS,
+  SPARQL_INDEX_SOP,
+  SPARQL_PERMUTATION_COUNT
+};
+
+// Triple positions in key order for each permutation
+static const uint8_t sparql_permutation_order[SPARQL_PERMUTATION_COUNT][3] = {
+    {0, 1, 2}, {1, 2, 0}, {2, 0, 1}, {1, 0, 2}, {2, 1, 0}, {0, 2, 1}};
+
+// Parsed triple pattern
+typedef struct
+{
+  uint32_t term[3];  // Constant id, or variable slot where var_mask has the bit set
+  uint8_t var_mask;  // Bit 0 subject, bit 1 predicate, bit 2 object
+  uint8_t param[3];  // Constants: position among the query's constants, for rebinding
+} SPARQLPattern;
+
+// Join algorithms chosen by the planner
+typedef enum
+{
+  SPARQL_JOIN_SCAN,              // First pattern: one index range scan
+  SPARQL_JOIN_INDEX_NESTED_LOOP, // Range scan per input row
+  SPARQL_JOIN_HASH,              // Build on the pattern's constant range, probe with input rows
+  SPARQL_JOIN_LEAPFROG           // All patterns at once, one variable at a time (cyclic patterns)
+} SPARQLJoinMethod;
+
+// Evaluation order for a basic graph pattern
 typedef struct
 {
-  // Triple store (80/20: focus on common patterns)
-  struct
+  uint8_t order[SPARQL_MAX_PATTERNS];
+  uint8_t method[SPARQL_MAX_PATTERNS]; // SPARQLJoinMethod per step
+  double rows[SPARQL_MAX_PATTERNS];    // Estimated rows after each step (leapfrog: per pattern)
+  double result_rows;                  // Estimated solutions
+  double cost;
+  bool leapfrog;                                    // Leapfrog triejoin instead of pairwise steps
+  uint8_t variable_order[SPARQL_MAX_VARIABLES];     // Its variable order
+} SPARQLPlan;
+
+// Per-predicate statistics
+typedef struct
+{
+  uint32_t predicate;
+  uint32_t triples;
+  uint32_t subjects; // Distinct subjects
+  uint32_t objects;  // Distinct objects
+} SPARQLPredicateStats;
+
+// Characteristic set: the subjects that have exactly this set of predicates
+typedef struct
+{
+  uint32_t offset; // Into the predicate and occurrence pools
+  uint32_t length;
+  uint32_t subjects;
+} SPARQLCharacteristicSet;
+
+// Parsed SELECT query
+typedef struct
+{
+  SPARQLPattern patterns[SPARQL_MAX_PATTERNS];
+  uint32_t pattern_count;
+  char variables[SPARQL_MAX_VARIABLES][SPARQL_MAX_VARIABLE_NAME];
+  uint32_t variable_count;
+  uint32_t projection[SPARQL_MAX_VARIABLES];
+  uint32_t projection_count;
+  bool distinct;
+  uint64_t limit;     // 0 for no limit
+  uint32_t param_count; // Constants in textual order; ';' and ',' lists share theirs
+  bool unsatisfiable; // A constant is not in the dictionary
+  SPARQLPlan plan;
+  uint64_t plan_generation; // Statistics generation the plan was made for, 0 for none
+} SPARQLQuery;
+
+// Plan cache entry: a parsed and planned query, keyed by its normalized text
+typedef struct SPARQLCacheEntry
+{
+  struct SPARQLCacheEntry *bucket_next;
+  struct SPARQLCacheEntry *newer; // LRU list
+  struct SPARQLCacheEntry *older;
+  SPARQLQuery *query; // Template; constants are rebound on every hit
+  uint64_t hash;
+  size_t bytes; // Charged against the cache limit
+  size_t key_length;
+  char key[];
+} SPARQLCacheEntry;
+
+// Prepared statement: a private template executed with caller-supplied constants
+struct SPARQLPrepared
+{
+  SPARQLQuery query;
+  uint32_t params[SPARQL_MAX_PARAMS]; // Constants as written
+  bool unsatisfiable;
+};
+
+// SPARQL Engine State
+struct SPARQLEngine
+{
+  // Term dictionary (N-Triples form <-> id)
+  struct
+  {
+    char *strings; // NUL-terminated terms back to back
+    size_t strings_used;
+    size_t strings_capacity;
+    size_t *offsets; // offsets[id] into strings, id 0 unused
+    uint32_t count;  // Highest assigned id
+    uint32_t capacity;
+    uint32_t *slots; // Open addressing table of ids
+    uint32_t slot_mask;
+  } dict;
+
+  // Triple store: sorted, duplicate-free permutations plus appends not yet indexed
+  struct
+  {
+    SPARQLKey *index[SPARQL_PERMUTATION_COUNT]; // Beyond SPARQL_INDEX_COUNT: NULL until needed
+    uint32_t *last[SPARQL_PERMUTATION_COUNT];   // Last key field of each index, built for leapfrog joins
+    size_t count;
+    SPARQLKey *pending; // SPO order
+    size_t pending_count;
+    size_t pending_capacity;
+  } triples;
+
+  // Statistics gathered when the indexes are built
+  struct
+  {
+    SPARQLPredicateStats *predicates; // Sorted by predicate
+    uint32_t predicate_count;
+    uint32_t subjects; // Distinct subjects
+    uint32_t objects;  // Distinct objects
+    SPARQLCharacteristicSet *sets;
+    uint32_t set_count;
+    uint32_t *set_predicates; // Sorted within each set
+    uint32_t *set_occurrences; // Triples per set predicate
+    size_t pool_used;
+    size_t pool_capacity;
+    bool sets_truncated; // Rare or very wide sets were left out
+    uint64_t generation; // Bumped on every rebuild; cached plans are remade
+  } stats;
+
+  // Plan cache (80/20: applications repeat a few query shapes with different constants)
+  // Keyed by query text with constants lifted to parameters and variables renamed in order
+  struct
+  {
+    SPARQLCacheEntry **buckets;
+    uint32_t bucket_mask;
+    uint32_t count;
+    SPARQLCacheEntry *newest;
+    SPARQLCacheEntry *oldest; // Evicted first
+    size_t bytes;
+    size_t limit;
+    uint64_t evictions;
+  } cache;
+
+  bool leapfrog; // Leapfrog triejoin allowed for cyclic patterns
+
+  // Performance tracking
+  uint64_t total_queries;
+  uint64_t cache_hits;
+  uint64_t cache_misses;
+  uint64_t total_cycles;
+  uint64_t hit_cycles; // Execute latency by cache outcome
+  uint64_t miss_cycles;
+  uint64_t prepared_executions;
+  uint64_t prepared_cycles;
+};
+
+static void sparql_cache_remove(SPARQLEngine *engine, SPARQLCacheEntry *entry);
+
+// Create SPARQL engine
+SPARQLEngine *cns_sparql_create(size_t initial_capacity)
+{
+  SPARQLEngine *engine = calloc(1, sizeof(SPARQLEngine));
+  if (!engine)
+  {
+    return NULL;
+  }
+
+  if (initial_capacity > 0)
+  {
+    engine->triples.pending = malloc(initial_capacity * sizeof(SPARQLKey));
+    if (!engine->triples.pending)
+    {
+      free(engine);
+      return NULL;
+    }
+    engine->triples.pending_capacity = initial_capacity;
+  }
+  engine->leapfrog = true;
+  engine->cache.limit = SPARQL_CACHE_BYTES;
+
+  return engine;
+}
+
+// Destroy SPARQL engine
+void cns_sparql_destroy(SPARQLEngine *engine)
+{
+  if (!engine)
+  {
+    return;
+  }
+
+  while (engine->cache.oldest)
+    sparql_cache_remove(engine, engine->cache.oldest);
+  free(engine->cache.buckets);
+  for (int i = 0; i < SPARQL_PERMUTATION_COUNT; i++)
+  {
+    free(engine->triples.index[i]);
+    free(engine->triples.last[i]);
+  }
+  free(engine->triples.pending);
+  free(engine->stats.predicates);
+  free(engine->stats.sets);
+  free(engine->stats.set_predicates);
+  free(engine->stats.set_occurrences);
+  free(engine->dict.strings);
+  free(engine->dict.offsets);
+  free(engine->dict.slots);
+  free(engine);
+}
+
+// ---------------------------------------------------------------------------
+// Term dictionary
+// ---------------------------------------------------------------------------
+
+static uint64_t sparql_hash(const char *term, size_t length)
+{
+  uint64_t hash = 14695981039346656037ULL; // FNV-1a
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= (unsigned char)term[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Slot holding the term's id, or the empty slot where it belongs
+static uint32_t *sparql_dict_slot(const SPARQLEngine *engine, const char *term, size_t length)
+{
+  uint32_t i = (uint32_t)sparql_hash(term, length) & engine->dict.slot_mask;
+  while (engine->dict.slots[i])
+  {
+    const char *existing = engine->dict.strings + engine->dict.offsets[engine->dict.slots[i]];
+    if (memcmp(existing, term, length) == 0 && existing[length] == '\0')
+    {
+      break;
+    }
+    i = (i + 1) & engine->dict.slot_mask;
+  }
+  return &engine->dict.slots[i];
+}
+
+static bool sparql_dict_grow_slots(SPARQLEngine *engine)
+{
+  uint32_t size = engine->dict.slots ? (engine->dict.slot_mask + 1) * 2 : 1024;
+  uint32_t *slots = calloc(size, sizeof(uint32_t));
+  if (!slots)
+  {
+    return false;
+  }
+
+  free(engine->dict.slots);
+  engine->dict.slots = slots;
+  engine->dict.slot_mask = size - 1;
+
+  for (uint32_t id = 1; id <= engine->dict.count; id++)
+  {
+    const char *term = engine->dict.strings + engine->dict.offsets[id];
+    *sparql_dict_slot(engine, term, strlen(term)) = id;
+  }
+  return true;
+}
+
+uint32_t cns_sparql_intern(SPARQLEngine *engine, const char *term)
+{
+  if (!engine || !term || engine->dict.count == UINT32_MAX - 1)
+  {
+    return 0;
+  }
+
+  // Keep the table at most half full
+  if (!engine->dict.slots || (engine->dict.count + 1) * 2 > engine->dict.slot_mask + 1)
+  {
+    if (!sparql_dict_grow_slots(engine))
+    {
+      return 0;
+    }
+  }
+
+  size_t length = strlen(term);
+  uint32_t *slot = sparql_dict_slot(engine, term, length);
+  if (*slot)
+  {
+    return *slot;
+  }
+
+  if (engine->dict.count + 2 > engine->dict.capacity)
+  {
+    uint32_t capacity = engine->dict.capacity ? engine->dict.capacity * 2 : 1024;
+    size_t *offsets = realloc(engine->dict.offsets, capacity * sizeof(size_t));
+    if (!offsets)
+    {
+      return 0;
+    }
+    engine->dict.offsets = offsets;
+    engine->dict.capacity = capacity;
+  }
+
+  if (engine->dict.strings_used + length + 1 > engine->dict.strings_capacity)
+  {
+    size_t capacity = engine->dict.strings_capacity ? engine->dict.strings_capacity * 2 : 64 * 1024;
+    while (capacity < engine->dict.strings_used + length + 1)
+    {
+      capacity *= 2;
+    }
+    char *strings = realloc(engine->dict.strings, capacity);
+    if (!strings)
+    {
+      return 0;
+    }
+    engine->dict.strings = strings;
+    engine->dict.strings_capacity = capacity;
+  }
+
+  uint32_t id = ++engine->dict.count;
+  engine->dict.offsets[id] = engine->dict.strings_used;
+  memcpy(engine->dict.strings + engine->dict.strings_used, term, length + 1);
+  engine->dict.strings_used += length + 1;
+  *slot = id;
+  return id;
+}
+
+uint32_t cns_sparql_lookup(const SPARQLEngine *engine, const char *term)
+{
+  if (!engine || !term || !engine->dict.slots)
+  {
+    return 0;
+  }
+  return *sparql_dict_slot(engine, term, strlen(term));
+}
+
+const char *cns_sparql_term(const SPARQLEngine *engine, uint32_t id)
+{
+  if (!engine || id == 0 || id > engine->dict.count)
+  {
+    return NULL;
+  }
+  return engine->dict.strings + engine->dict.offsets[id];
+}
+
+// ---------------------------------------------------------------------------
+// Triple store and permutation indexes
+// ---------------------------------------------------------------------------
+
+static bool sparql_reserve(SPARQLEngine *engine, size_t count)
+{
+  if (engine->triples.pending_count + count <= engine->triples.pending_capacity)
+  {
+    return true;
+  }
+
+  size_t capacity = engine->triples.pending_capacity ? engine->triples.pending_capacity : 1024;
+  while (capacity < engine->triples.pending_count + count)
+  {
+    capacity *= 2;
+  }
+
+  SPARQLKey *pending = realloc(engine->triples.pending, capacity * sizeof(SPARQLKey));
+  if (!pending)
+  {
+    return false;
+  }
+  engine->triples.pending = pending;
+  engine->triples.pending_capacity = capacity;
+  return true;
+}
+
+// Add triple to store (5 cycles target, amortized: the pending batch grows
+// by doubling, so single calls may take far longer and are not asserted)
+int cns_sparql_add_triple(SPARQLEngine *engine, uint32_t subject, uint32_t predicate, uint32_t object)
+{
+  if (!engine || !sparql_reserve(engine, 1))
+  {
+    return CNS_ERR_RESOURCE;
+  }
+
+  SPARQLKey *key = &engine->triples.pending[engine->triples.pending_count++];
+  key->a = subject;
+  key->b = predicate;
+  key->c = object;
+
+  return CNS_OK;
+}
+
+int cns_sparql_load_triples(SPARQLEngine *engine, const uint32_t *triples, size_t count)
+{
+  if (!engine || (!triples && count > 0))
+  {
+    return CNS_ERR_INVALID_ARG;
+  }
+  if (!sparql_reserve(engine, count))
+  {
+    return CNS_ERR_RESOURCE;
+  }
+
+  SPARQLKey *pending = engine->triples.pending + engine->triples.pending_count;
+  for (size_t i = 0; i < count; i++)
+  {
+    pending[i].a = triples[i * 3];
+    pending[i].b = triples[i * 3 + 1];
+    pending[i].c = triples[i * 3 + 2];
+  }
+  engine->triples.pending_count += count;
+  return CNS_OK;
+}
+
+int cns_sparql_add_terms(SPARQLEngine *engine, const char *subject, const char *predicate, const char *object)
+{
+  if (!engine || !subject || !predicate || !object)
+  {
+    return CNS_ERR_INVALID_ARG;
+  }
+
+  uint32_t s = cns_sparql_intern(engine, subject);
+  uint32_t p = cns_sparql_intern(engine, predicate);
+  uint32_t o = cns_sparql_intern(engine, object);
+  if (!s || !p || !o)
+  {
+    return CNS_ERR_RESOURCE;
+  }
+  return cns_sparql_add_triple(engine, s, p, o);
+}
+
+static int sparql_compare_keys(const void *left, const void *right)
+{
+  const SPARQLKey *x = left;
+  const SPARQLKey *y = right;
+  if (x->a != y->a)
+    return x->a < y->a ? -1 : 1;
+  if (x->b != y->b)
+    return x->b < y->b ? -1 : 1;
+  if (x->c != y->c)
+    return x->c < y->c ? -1 : 1;
+  return 0;
+}
+
+static inline uint32_t sparql_key_digit(const SPARQLKey *key, int digit)
+{
+  uint32_t word = digit < 2 ? key->c : digit < 4 ? key->b : key->a;
+  return (digit & 1) ? word >> SPARQL_RADIX_BITS : word & (SPARQL_RADIX_SIZE - 1);
+}
+
+// Sort keys by (a, b, c): LSD radix sort over 16-bit digits, skipping digits shared by every key
+static bool sparql_sort_keys(SPARQLKey *keys, size_t count)
+{
+  if (count < SPARQL_RADIX_MIN)
+  {
+    qsort(keys, count, sizeof(SPARQLKey), sparql_compare_keys);
+    return true;
+  }
+
+  size_t *histogram = calloc((size_t)SPARQL_RADIX_DIGITS * SPARQL_RADIX_SIZE, sizeof(size_t));
+  SPARQLKey *scratch = malloc(count * sizeof(SPARQLKey));
+  if (!histogram || !scratch)
+  {
+    free(histogram);
+    free(scratch);
+    return false;
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    for (int digit = 0; digit < SPARQL_RADIX_DIGITS; digit++)
+    {
+      histogram[(size_t)digit * SPARQL_RADIX_SIZE + sparql_key_digit(&keys[i], digit)]++;
+    }
+  }
+
+  SPARQLKey *source = keys;
+  SPARQLKey *target = scratch;
+  for (int digit = 0; digit < SPARQL_RADIX_DIGITS; digit++)
+  {
+    size_t *buckets = histogram + (size_t)digit * SPARQL_RADIX_SIZE;
+    if (buckets[sparql_key_digit(&source[0], digit)] == count)
+    {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (uint32_t b = 0; b < SPARQL_RADIX_SIZE; b++)
+    {
+      size_t bucket = buckets[b];
+      buckets[b] = offset;
+      offset += bucket;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      target[buckets[sparql_key_digit(&source[i], digit)]++] = source[i];
+    }
+
+    SPARQLKey *swap = source;
+    source = target;
+    target = swap;
+  }
+
+  if (source != keys)
+  {
+    memcpy(keys, source, count * sizeof(SPARQLKey));
+  }
+  free(histogram);
+  free(scratch);
+  return true;
+}
+
+static size_t sparql_unique_keys(SPARQLKey *keys, size_t count)
+{
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  size_t unique = 1;
+  for (size_t i = 1; i < count; i++)
+  {
+    if (sparql_compare_keys(&keys[i], &keys[unique - 1]) != 0)
+    {
+      keys[unique++] = keys[i];
+    }
+  }
+  return unique;
+}
+
+// Rotate SPO keys into the order of another index
+static void sparql_rotate_keys(SPARQLKey *target, const SPARQLKey *spo, size_t count, int index)
+{
+  const uint8_t *order = sparql_permutation_order[index];
+  for (size_t i = 0; i < count; i++)
+  {
+    uint32_t triple[3] = {spo[i].a, spo[i].b, spo[i].c};
+    target[i].a = triple[order[0]];
+    target[i].b = triple[order[1]];
+    target[i].c = triple[order[2]];
+  }
+}
+
+// Merge two sorted duplicate-free key arrays into a new array
+static SPARQLKey *sparql_merge_keys(const SPARQLKey *left, size_t left_count,
+                                    const SPARQLKey *right, size_t right_count, size_t *merged_count)
+{
+  SPARQLKey *merged = malloc((left_count + right_count) * sizeof(SPARQLKey));
+  if (!merged)
+  {
+    return NULL;
+  }
+
+  size_t i = 0, j = 0, n = 0;
+  while (i < left_count && j < right_count)
+  {
+    int order = sparql_compare_keys(&left[i], &right[j]);
+    if (order <= 0)
+    {
+      merged[n++] = left[i++];
+      j += (order == 0);
+    }
+    else
+    {
+      merged[n++] = right[j++];
+    }
+  }
+  memcpy(merged + n, left + i, (left_count - i) * sizeof(SPARQLKey));
+  n += left_count - i;
+  memcpy(merged + n, right + j, (right_count - j) * sizeof(SPARQLKey));
+  n += right_count - j;
+
+  *merged_count = n;
+  return merged;
+}
+
+// Sort pending triples into the permutation indexes
+static int sparql_merge_pending(SPARQLEngine *engine)
+{
+  SPARQLKey *delta = engine->triples.pending;
+  if (!sparql_sort_keys(delta, engine->triples.pending_count))
+  {
+    return CNS_ERR_RESOURCE;
+  }
+  size_t delta_count = sparql_unique_keys(delta, engine->triples.pending_count);
+  engine->triples.pending_count = delta_count;
+
+  SPARQLKey *rotated[SPARQL_INDEX_COUNT] = {delta, NULL, NULL};
+  for (int index = SPARQL_INDEX_POS; index < SPARQL_INDEX_COUNT; index++)
+  {
+    rotated[index] = malloc(delta_count * sizeof(SPARQLKey));
+    if (!rotated[index] || (sparql_rotate_keys(rotated[index], delta, delta_count, index),
+                            !sparql_sort_keys(rotated[index], delta_count)))
+    {
+      free(rotated[SPARQL_INDEX_POS]);
+      free(rotated[SPARQL_INDEX_OSP]);
+      return CNS_ERR_RESOURCE;
+    }
+  }
+
+  // Leapfrog-only permutations and columns are rebuilt from the merged indexes when next needed
+  for (int index = 0; index < SPARQL_PERMUTATION_COUNT; index++)
+  {
+    if (index >= SPARQL_INDEX_COUNT)
+    {
+      free(engine->triples.index[index]);
+      engine->triples.index[index] = NULL;
+    }
+    free(engine->triples.last[index]);
+    engine->triples.last[index] = NULL;
+  }
+
+  if (engine->triples.count == 0)
+  {
+    // Bulk load: the sorted appends become the indexes
+    SPARQLKey *spo = realloc(delta, delta_count * sizeof(SPARQLKey));
+    engine->triples.index[SPARQL_INDEX_SPO] = spo ? spo : delta;
+    engine->triples.index[SPARQL_INDEX_POS] = rotated[SPARQL_INDEX_POS];
+    engine->triples.index[SPARQL_INDEX_OSP] = rotated[SPARQL_INDEX_OSP];
+    engine->triples.count = delta_count;
+    engine->triples.pending = NULL;
+    engine->triples.pending_count = 0;
+    engine->triples.pending_capacity = 0;
+    return CNS_OK;
+  }
+
+  SPARQLKey *merged[SPARQL_INDEX_COUNT] = {NULL, NULL, NULL};
+  size_t merged_count = 0;
+  int status = CNS_OK;
+  for (int index = 0; index < SPARQL_INDEX_COUNT; index++)
+  {
+    merged[index] = sparql_merge_keys(engine->triples.index[index], engine->triples.count,
+                                      rotated[index], delta_count, &merged_count);
+    if (!merged[index])
+    {
+      status = CNS_ERR_RESOURCE;
+      break;
+    }
+  }
+
+  if (status == CNS_OK)
+  {
+    for (int index = 0; index < SPARQL_INDEX_COUNT; index++)
+    {
+      free(engine->triples.index[index]);
+      engine->triples.index[index] = merged[index];
+    }
+    engine->triples.count = merged_count;
+    engine->triples.pending_count = 0;
+  }
+  else
+  {
+    for (int index = 0; index < SPARQL_INDEX_COUNT; index++)
+    {
+      free(merged[index]);
+    }
+  }
+
+  free(rotated[SPARQL_INDEX_POS]);
+  free(rotated[SPARQL_INDEX_OSP]);
+  return status;
+}
+
+// ---------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------
+
+static SPARQLPredicateStats *sparql_predicate_stats(const SPARQLEngine *engine, uint32_t predicate)
+{
+  uint32_t low = 0, high = engine->stats.predicate_count;
+  while (low < high)
+  {
+    uint32_t mid = low + (high - low) / 2;
+    if (engine->stats.predicates[mid].predicate < predicate)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if (low < engine->stats.predicate_count && engine->stats.predicates[low].predicate == predicate)
+    return &engine->stats.predicates[low];
+  return NULL;
+}
+
+static int sparql_compare_sets(const void *left, const void *right)
+{
+  const SPARQLCharacteristicSet *x = left;
+  const SPARQLCharacteristicSet *y = right;
+  return x->subjects != y->subjects ? (x->subjects > y->subjects ? -1 : 1) : 0;
+}
+
+// Count one subject towards the characteristic set of its predicates
+static bool sparql_record_set(SPARQLEngine *engine, uint32_t **slots, uint32_t *slot_mask,
+                              const uint32_t *predicates, const uint32_t *occurrences, uint32_t length)
+{
+  if (length > SPARQL_MAX_SET_PREDICATES)
+  {
+    engine->stats.sets_truncated = true;
+    return true;
+  }
+
+  uint32_t i = (uint32_t)sparql_hash((const char *)predicates, length * sizeof(uint32_t)) & *slot_mask;
+  for (; (*slots)[i]; i = (i + 1) & *slot_mask)
+  {
+    SPARQLCharacteristicSet *set = &engine->stats.sets[(*slots)[i] - 1];
+    if (set->length == length &&
+        memcmp(engine->stats.set_predicates + set->offset, predicates, length * sizeof(uint32_t)) == 0)
+    {
+      set->subjects++;
+      for (uint32_t k = 0; k < length; k++)
+        engine->stats.set_occurrences[set->offset + k] += occurrences[k];
+      return true;
+    }
+  }
+
+  // New set
+  if (engine->stats.set_count == 0 ||
+      (engine->stats.set_count >= 64 && (engine->stats.set_count & (engine->stats.set_count - 1)) == 0))
+  {
+    uint32_t capacity = engine->stats.set_count ? engine->stats.set_count * 2 : 64;
+    SPARQLCharacteristicSet *sets = realloc(engine->stats.sets, capacity * sizeof(SPARQLCharacteristicSet));
+    if (!sets)
+      return false;
+    engine->stats.sets = sets;
+  }
+  if (engine->stats.pool_used + length > engine->stats.pool_capacity)
+  {
+    size_t capacity = engine->stats.pool_capacity ? engine->stats.pool_capacity * 2 : 1024;
+    while (capacity < engine->stats.pool_used + length)
+      capacity *= 2;
+    uint32_t *pool = realloc(engine->stats.set_predicates, capacity * sizeof(uint32_t));
+    if (!pool)
+      return false;
+    engine->stats.set_predicates = pool;
+    pool = realloc(engine->stats.set_occurrences, capacity * sizeof(uint32_t));
+    if (!pool)
+      return false;
+    engine->stats.set_occurrences = pool;
+    engine->stats.pool_capacity = capacity;
+  }
+
+  SPARQLCharacteristicSet *set = &engine->stats.sets[engine->stats.set_count++];
+  set->offset = (uint32_t)engine->stats.pool_used;
+  set->length = length;
+  set->subjects = 1;
+  memcpy(engine->stats.set_predicates + set->offset, predicates, length * sizeof(uint32_t));
+  memcpy(engine->stats.set_occurrences + set->offset, occurrences, length * sizeof(uint32_t));
+  engine->stats.pool_used += length;
+  (*slots)[i] = engine->stats.set_count;
+
+  // Keep the slot table at most half full
+  if (engine->stats.set_count * 2 > *slot_mask + 1)
+  {
+    uint32_t size = (*slot_mask + 1) * 2;
+    uint32_t *grown = calloc(size, sizeof(uint32_t));
+    if (!grown)
+      return false;
+    for (uint32_t id = 1; id <= engine->stats.set_count; id++)
+    {
+      const SPARQLCharacteristicSet *existing = &engine->stats.sets[id - 1];
+      uint32_t k = (uint32_t)sparql_hash((const char *)(engine->stats.set_predicates + existing->offset),
+                                         existing->length * sizeof(uint32_t)) & (size - 1);
+      while (grown[k])
+        k = (k + 1) & (size - 1);
+      grown[k] = id;
+    }
+    free(*slots);
+    *slots = grown;
+    *slot_mask = size - 1;
+  }
+  return true;
+}
+
+// Per-predicate counts, distinct subjects and objects, and characteristic sets
+static int sparql_collect_statistics(SPARQLEngine *engine)
+{
+  size_t count = engine->triples.count;
+  const SPARQLKey *spo = engine->triples.index[SPARQL_INDEX_SPO];
+  const SPARQLKey *pos = engine->triples.index[SPARQL_INDEX_POS];
+  const SPARQLKey *osp = engine->triples.index[SPARQL_INDEX_OSP];
+
+  free(engine->stats.predicates);
+  engine->stats.predicates = NULL;
+  engine->stats.predicate_count = 0;
+  engine->stats.subjects = 0;
+  engine->stats.objects = 0;
+  engine->stats.set_count = 0;
+  engine->stats.pool_used = 0;
+  engine->stats.sets_truncated = false;
+  engine->stats.generation++;
+
+  // Predicates, triples per predicate and distinct objects per predicate from POS
+  uint32_t predicate_count = 0;
+  for (size_t i = 0; i < count; i++)
+    predicate_count += (i == 0 || pos[i].a != pos[i - 1].a);
+  engine->stats.predicates = calloc(predicate_count ? predicate_count : 1, sizeof(SPARQLPredicateStats));
+  if (!engine->stats.predicates)
+    return CNS_ERR_RESOURCE;
+
+  SPARQLPredicateStats *current = NULL;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (i == 0 || pos[i].a != pos[i - 1].a)
+    {
+      current = &engine->stats.predicates[engine->stats.predicate_count++];
+      current->predicate = pos[i].a;
+    }
+    current->triples++;
+    current->objects += (i == 0 || pos[i].a != pos[i - 1].a || pos[i].b != pos[i - 1].b);
+  }
+
+  // Distinct objects from OSP
+  for (size_t i = 0; i < count; i++)
+    engine->stats.objects += (i == 0 || osp[i].a != osp[i - 1].a);
+
+  // Distinct subjects per predicate and characteristic sets from SPO
+  uint32_t slot_mask = 1023;
+  uint32_t *slots = calloc(slot_mask + 1, sizeof(uint32_t));
+  if (!slots)
+    return CNS_ERR_RESOURCE;
+
+  uint32_t predicates[SPARQL_MAX_SET_PREDICATES + 1];
+  uint32_t occurrences[SPARQL_MAX_SET_PREDICATES + 1];
+  uint32_t length = 0;
+  for (size_t i = 0; i <= count; i++)
+  {
+    bool new_subject = i == count || i == 0 || spo[i].a != spo[i - 1].a;
+    if (new_subject && i > 0 && !sparql_record_set(engine, &slots, &slot_mask, predicates, occurrences, length))
+    {
+      free(slots);
+      return CNS_ERR_RESOURCE;
+    }
+    if (i == count)
+      break;
+
+    if (new_subject)
+    {
+      engine->stats.subjects++;
+      length = 0;
+    }
+    if (new_subject || spo[i].b != spo[i - 1].b)
+    {
+      sparql_predicate_stats(engine, spo[i].b)->subjects++;
+      if (length <= SPARQL_MAX_SET_PREDICATES)
+      {
+        predicates[length] = spo[i].b;
+        occurrences[length] = 0;
+        length++;
+      }
+    }
+    if (length <= SPARQL_MAX_SET_PREDICATES)
+      occurrences[length - 1]++;
+  }
+  free(slots);
+
+  if (engine->stats.set_count > SPARQL_MAX_CHARACTERISTIC_SETS)
+  {
+    qsort(engine->stats.sets, engine->stats.set_count, sizeof(SPARQLCharacteristicSet), sparql_compare_sets);
+    engine->stats.set_count = SPARQL_MAX_CHARACTERISTIC_SETS;
+    engine->stats.sets_truncated = true;
+  }
+  return CNS_OK;
+}
+
+int cns_sparql_build_indexes(SPARQLEngine *engine)
+{
+  if (!engine)
+  {
+    return CNS_ERR_INVALID_ARG;
+  }
+  if (engine->triples.pending_count == 0)
+  {
+    return CNS_OK;
+  }
+
+  int status = sparql_merge_pending(engine);
+  if (status != CNS_OK)
+  {
+    return status;
+  }
+  return sparql_collect_statistics(engine);
+}
+
+// Choose the index whose prefix covers the bound positions (bit 0 s, bit 1 p, bit 2 o)
+static int sparql_select_index(uint8_t bound, const uint32_t spo[3], SPARQLKey *probe, int *prefix)
+{
+  static const int index_for[8] = {
+      SPARQL_INDEX_SPO, SPARQL_INDEX_SPO, SPARQL_INDEX_POS, SPARQL_INDEX_SPO,
+      SPARQL_INDEX_OSP, SPARQL_INDEX_OSP, SPARQL_INDEX_POS, SPARQL_INDEX_SPO};
+  static const int prefix_for[8] = {0, 1, 1, 2, 1, 2, 2, 3};
+
+  int index = index_for[bound & 7];
+  *prefix = prefix_for[bound & 7];
+
+  if (index == SPARQL_INDEX_SPO)
+  {
+    probe->a = spo[0], probe->b = spo[1], probe->c = spo[2];
+  }
+  else if (index == SPARQL_INDEX_POS)
+  {
+    probe->a = spo[1], probe->b = spo[2], probe->c = spo[0];
+  }
+  else
+  {
+    probe->a = spo[2], probe->b = spo[0], probe->c = spo[1];
+  }
+  return index;
+}
+
+// Rotate an index entry back to subject, predicate, object
+static inline void sparql_key_to_spo(const SPARQLKey *key, int index, uint32_t spo[3])
+{
+  const uint8_t *order = sparql_permutation_order[index];
+  spo[order[0]] = key->a;
+  spo[order[1]] = key->b;
+  spo[order[2]] = key->c;
+}
+
+static inline int sparql_compare_prefix(const SPARQLKey *key, const SPARQLKey *probe, int prefix)
+{
+  if (prefix >= 1 && key->a != probe->a)
+    return key->a < probe->a ? -1 : 1;
+  if (prefix >= 2 && key->b != probe->b)
+    return key->b < probe->b ? -1 : 1;
+  if (prefix >= 3 && key->c != probe->c)
+    return key->c < probe->c ? -1 : 1;
+  return 0;
+}
+
+// First entry at or past the probe (upper: first entry past it)
+static size_t sparql_bound(const SPARQLKey *keys, size_t count, const SPARQLKey *probe, int prefix, bool upper)
+{
+  size_t low = 0, high = count;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    int order = sparql_compare_prefix(&keys[mid], probe, prefix);
+    if (order < 0 || (upper && order == 0))
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+// Index range matching a pattern
+static const SPARQLKey *sparql_range(const SPARQLEngine *engine, uint8_t bound, const uint32_t spo[3],
+                                     int *index, size_t *count)
+{
+  SPARQLKey probe;
+  int prefix;
+  *index = sparql_select_index(bound, spo, &probe, &prefix);
+
+  const SPARQLKey *keys = engine->triples.index[*index];
+  if (prefix == 0 || engine->triples.count == 0)
+  {
+    *count = engine->triples.count;
+    return keys;
+  }
+
+  size_t low = sparql_bound(keys, engine->triples.count, &probe, prefix, false);
+  size_t high = sparql_bound(keys + low, engine->triples.count - low, &probe, prefix, true);
+  *count = high;
+  return keys + low;
+}
+
+// ---------------------------------------------------------------------------
+// Query parsing
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+  const char *cursor;
+  const SPARQLEngine *engine;
+  SPARQLQuery *query;
+  struct
+  {
+    const char *name;
+    size_t name_length;
+    const char *iri; // Namespace without angle brackets
+    size_t iri_length;
+  } prefixes[SPARQL_MAX_PREFIXES];
+  uint32_t prefix_count;
+} SPARQLParser;
+
+static void sparql_skip_space(SPARQLParser *parser)
+{
+  for (;;)
+  {
+    while (isspace((unsigned char)*parser->cursor))
+      parser->cursor++;
+    if (*parser->cursor != '#')
+      return;
+    while (*parser->cursor && *parser->cursor != '\n')
+      parser->cursor++;
+  }
+}
+
+static bool sparql_is_name_char(char c)
+{
+  return isalnum((unsigned char)c) || c == '_' || c == '-';
+}
+
+static bool sparql_keyword(SPARQLParser *parser, const char *keyword)
+{
+  sparql_skip_space(parser);
+  size_t length = strlen(keyword);
+  for (size_t i = 0; i < length; i++)
+  {
+    if (toupper((unsigned char)parser->cursor[i]) != keyword[i])
+      return false;
+  }
+  if (sparql_is_name_char(parser->cursor[length]))
+    return false;
+  parser->cursor += length;
+  return true;
+}
+
+static bool sparql_punct(SPARQLParser *parser, char c)
+{
+  sparql_skip_space(parser);
+  if (*parser->cursor != c)
+    return false;
+  parser->cursor++;
+  return true;
+}
+
+// Variable slot for a name, added if new
+static bool sparql_variable(SPARQLParser *parser, uint32_t *slot)
+{
+  const char *start = ++parser->cursor; // Skip ? or $
+  while (sparql_is_name_char(*parser->cursor) && *parser->cursor != '-')
+    parser->cursor++;
+  size_t length = (size_t)(parser->cursor - start);
+  if (length == 0 || length >= SPARQL_MAX_VARIABLE_NAME)
+    return false;
+
+  SPARQLQuery *query = parser->query;
+  for (uint32_t i = 0; i < query->variable_count; i++)
+  {
+    if (strncmp(query->variables[i], start, length) == 0 && query->variables[i][length] == '\0')
+    {
+      *slot = i;
+      return true;
+    }
+  }
+  if (query->variable_count == SPARQL_MAX_VARIABLES)
+    return false;
+
+  memcpy(query->variables[query->variable_count], start, length);
+  query->variables[query->variable_count][length] = '\0';
+  *slot = query->variable_count++;
+  return true;
+}
+
+// Append to an N-Triples term buffer
+static bool sparql_term_append(char *term, size_t *length, const char *text, size_t text_length)
+{
+  if (*length + text_length >= SPARQL_MAX_TERM)
+    return false;
+  memcpy(term + *length, text, text_length);
+  *length += text_length;
+  term[*length] = '\0';
+  return true;
+}
+
+// Read <iri> or prefix:local into N-Triples form
+static bool sparql_read_iri(SPARQLParser *parser, char *term, size_t *length)
+{
+  const char *start = parser->cursor;
+  if (*start == '<')
+  {
+    const char *end = strchr(start, '>');
+    if (!end)
+      return false;
+    parser->cursor = end + 1;
+    return sparql_term_append(term, length, start, (size_t)(end + 1 - start));
+  }
+
+  while (sparql_is_name_char(*parser->cursor))
+    parser->cursor++;
+  if (*parser->cursor != ':')
+    return false;
+  size_t name_length = (size_t)(parser->cursor - start);
+  const char *local = ++parser->cursor;
+  while (sparql_is_name_char(*parser->cursor) || *parser->cursor == '.')
+    parser->cursor++;
+  while (parser->cursor > local && parser->cursor[-1] == '.') // Statement terminator
+    parser->cursor--;
+
+  for (uint32_t i = 0; i < parser->prefix_count; i++)
+  {
+    if (parser->prefixes[i].name_length == name_length &&
+        strncmp(parser->prefixes[i].name, start, name_length) == 0)
+    {
+      return sparql_term_append(term, length, "<", 1) &&
+             sparql_term_append(term, length, parser->prefixes[i].iri, parser->prefixes[i].iri_length) &&
+             sparql_term_append(term, length, local, (size_t)(parser->cursor - local)) &&
+             sparql_term_append(term, length, ">", 1);
+    }
+  }
+  return false; // Undeclared prefix
+}
+
+// Read a raw integer id or a dictionary term; *id is 0 for terms not in the dictionary
+static bool sparql_read_constant(SPARQLParser *parser, uint32_t *id)
+{
+  const char *cursor = parser->cursor;
+  char term[SPARQL_MAX_TERM];
+  size_t length = 0;
+  term[0] = '\0';
+
+  if (isdigit((unsigned char)*cursor))
+  {
+    char *end;
+    unsigned long value = strtoul(cursor, &end, 10);
+    if (value > UINT32_MAX || sparql_is_name_char(*end) || *end == ':')
+      return false;
+    parser->cursor = end;
+    *id = (uint32_t)value;
+    return true;
+  }
+
+  if (*cursor == '"')
+  {
+    const char *end = cursor + 1;
+    while (*end && *end != '"')
+      end += (*end == '\\' && end[1]) ? 2 : 1;
+    if (*end != '"')
+      return false;
+    parser->cursor = end + 1;
+    if (!sparql_term_append(term, &length, cursor, (size_t)(parser->cursor - cursor)))
+      return false;
+
+    if (*parser->cursor == '@')
+    {
+      const char *tag = parser->cursor++;
+      while (sparql_is_name_char(*parser->cursor))
+        parser->cursor++;
+      if (!sparql_term_append(term, &length, tag, (size_t)(parser->cursor - tag)))
+        return false;
+    }
+    else if (parser->cursor[0] == '^' && parser->cursor[1] == '^')
+    {
+      parser->cursor += 2;
+      if (!sparql_term_append(term, &length, "^^", 2) || !sparql_read_iri(parser, term, &length))
+        return false;
+    }
+  }
+  else if (*cursor == '_' && cursor[1] == ':')
+  {
+    parser->cursor += 2;
+    while (sparql_is_name_char(*parser->cursor))
+      parser->cursor++;
+    if (!sparql_term_append(term, &length, cursor, (size_t)(parser->cursor - cursor)))
+      return false;
+  }
+  else if (*cursor == 'a' && !sparql_is_name_char(cursor[1]) && cursor[1] != ':')
+  {
+    parser->cursor++;
+    if (!sparql_term_append(term, &length, SPARQL_RDF_TYPE, sizeof(SPARQL_RDF_TYPE) - 1))
+      return false;
+  }
+  else if (!sparql_read_iri(parser, term, &length))
+  {
+    return false;
+  }
+
+  *id = cns_sparql_lookup(parser->engine, term);
+  return true;
+}
+
+// Parse one pattern position: a variable, a raw integer id or a dictionary term
+static bool sparql_parse_term(SPARQLParser *parser, SPARQLPattern *pattern, int position)
+{
+  sparql_skip_space(parser);
+  if (*parser->cursor == '?' || *parser->cursor == '$')
+  {
+    pattern->var_mask |= (uint8_t)(1u << position);
+    return sparql_variable(parser, &pattern->term[position]);
+  }
+
+  bool dictionary = !isdigit((unsigned char)*parser->cursor);
+  if (!sparql_read_constant(parser, &pattern->term[position]))
+    return false;
+  if (dictionary && pattern->term[position] == 0)
+    parser->query->unsatisfiable = true;
+  pattern->param[position] = (uint8_t)parser->query->param_count++;
+  return true;
+}
+
+// Parse the triples block: s p o [; p o] [, o] separated by '.'
+static bool sparql_parse_patterns(SPARQLParser *parser)
+{
+  SPARQLQuery *query = parser->query;
+  while (!sparql_punct(parser, '}'))
+  {
+    if (query->pattern_count == SPARQL_MAX_PATTERNS)
+      return false;
+    SPARQLPattern *pattern = &query->patterns[query->pattern_count];
+    memset(pattern, 0, sizeof(*pattern));
+    if (!sparql_parse_term(parser, pattern, 0))
+      return false;
+
+    for (;;)
+    {
+      SPARQLPattern *current = &query->patterns[query->pattern_count];
+      if (!sparql_parse_term(parser, current, 1))
+        return false;
+
+      for (;;)
+      {
+        current = &query->patterns[query->pattern_count];
+        if (!sparql_parse_term(parser, current, 2))
+          return false;
+        query->pattern_count++;
+        if (!sparql_punct(parser, ','))
+          break;
+        if (query->pattern_count == SPARQL_MAX_PATTERNS)
+          return false;
+        // Same subject and predicate
+        query->patterns[query->pattern_count] = *current;
+        query->patterns[query->pattern_count].var_mask &= 0x3;
+      }
+
+      if (!sparql_punct(parser, ';'))
+        break;
+      sparql_skip_space(parser);
+      if (*parser->cursor == '.' || *parser->cursor == '}')
+        break;
+      if (query->pattern_count == SPARQL_MAX_PATTERNS)
+        return false;
+      // Same subject
+      SPARQLPattern *last = &query->patterns[query->pattern_count - 1];
+      query->patterns[query->pattern_count] = *last;
+      query->patterns[query->pattern_count].var_mask &= 0x1;
+    }
+
+    sparql_punct(parser, '.');
+  }
+  return query->pattern_count > 0;
+}
+
+// PREFIX declarations
+static bool sparql_parse_prefixes(SPARQLParser *parser)
+{
+  while (sparql_keyword(parser, "PREFIX"))
+  {
+    if (parser->prefix_count == SPARQL_MAX_PREFIXES)
+      return false;
+    sparql_skip_space(parser);
+    const char *name = parser->cursor;
+    while (sparql_is_name_char(*parser->cursor))
+      parser->cursor++;
+    size_t name_length = (size_t)(parser->cursor - name);
+    if (*parser->cursor++ != ':')
+      return false;
+    sparql_skip_space(parser);
+    if (*parser->cursor != '<')
+      return false;
+    const char *iri = parser->cursor + 1;
+    const char *end = strchr(iri, '>');
+    if (!end)
+      return false;
+    parser->prefixes[parser->prefix_count].name = name;
+    parser->prefixes[parser->prefix_count].name_length = name_length;
+    parser->prefixes[parser->prefix_count].iri = iri;
+    parser->prefixes[parser->prefix_count].iri_length = (size_t)(end - iri);
+    parser->prefix_count++;
+    parser->cursor = end + 1;
+  }
+  return true;
+}
+
+static bool sparql_parse_query(SPARQLParser *parser)
+{
+  SPARQLQuery *query = parser->query;
+
+  if (!sparql_parse_prefixes(parser) || !sparql_keyword(parser, "SELECT"))
+    return false;
+  query->distinct = sparql_keyword(parser, "DISTINCT");
+
+  bool select_all = sparql_punct(parser, '*');
+  if (!select_all)
+  {
+    sparql_skip_space(parser);
+    while (*parser->cursor == '?' || *parser->cursor == '$')
+    {
+      uint32_t slot;
+      if (query->projection_count == SPARQL_MAX_VARIABLES ||
+          !sparql_variable(parser, &slot))
+        return false;
+      query->projection[query->projection_count++] = slot;
+      sparql_skip_space(parser);
+    }
+    if (query->projection_count == 0)
+      return false;
+  }
+
+  sparql_keyword(parser, "WHERE");
+  if (!sparql_punct(parser, '{') || !sparql_parse_patterns(parser))
+    return false;
+
+  if (sparql_keyword(parser, "LIMIT"))
+  {
+    sparql_skip_space(parser);
+    if (!isdigit((unsigned char)*parser->cursor))
+      return false;
+    query->limit = strtoull(parser->cursor, (char **)&parser->cursor, 10);
+  }
+  sparql_skip_space(parser);
+  if (*parser->cursor != '\0')
+    return false;
+
+  // Every projected variable must occur in the pattern
+  uint32_t used = 0;
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+  {
+    for (int position = 0; position < 3; position++)
+    {
+      if (query->patterns[i].var_mask & (1u << position))
+        used |= 1u << query->patterns[i].term[position];
+    }
+  }
+  if (select_all)
+  {
+    for (uint32_t i = 0; i < query->variable_count; i++)
+      query->projection[query->projection_count++] = i;
+  }
+  for (uint32_t i = 0; i < query->projection_count; i++)
+  {
+    if (!(used & (1u << query->projection[i])))
+      return false;
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Planning
+// ---------------------------------------------------------------------------
+
+// Planner input for one triple pattern
+typedef struct
+{
+  double card;        // Triples matching the pattern's constants
+  double distinct[3]; // Distinct values at each position among them
+  uint32_t vars;      // Variable slots used
+} SPARQLPatternEstimate;
+
+static void sparql_estimate_pattern(const SPARQLEngine *engine, const SPARQLPattern *pattern,
+                                    SPARQLPatternEstimate *estimate)
+{
+  uint32_t spo[3] = {0, 0, 0};
+  uint8_t bound = 0;
+  estimate->vars = 0;
+  for (int position = 0; position < 3; position++)
+  {
+    if (pattern->var_mask & (1u << position))
+    {
+      estimate->vars |= 1u << pattern->term[position];
+    }
+    else
+    {
+      spo[position] = pattern->term[position];
+      bound |= (uint8_t)(1u << position);
+    }
+  }
+
+  int index;
+  size_t count;
+  sparql_range(engine, bound, spo, &index, &count);
+  estimate->card = (double)count;
+
+  // Domains narrow to the predicate's when it is constant
+  const SPARQLPredicateStats *predicate = (bound & 2) ? sparql_predicate_stats(engine, spo[1]) : NULL;
+  double domain[3] = {predicate ? predicate->subjects : engine->stats.subjects,
+                      predicate ? 1 : engine->stats.predicate_count,
+                      predicate ? predicate->objects : engine->stats.objects};
+  for (int position = 0; position < 3; position++)
+  {
+    double distinct = domain[position] < estimate->card ? domain[position] : estimate->card;
+    estimate->distinct[position] = distinct < 1 ? 1 : distinct;
+  }
+}
+
+static bool sparql_set_find(const SPARQLEngine *engine, const SPARQLCharacteristicSet *set, uint32_t predicate,
+                            uint32_t *occurrences)
+{
+  const uint32_t *predicates = engine->stats.set_predicates + set->offset;
+  uint32_t low = 0, high = set->length;
+  while (low < high)
+  {
+    uint32_t mid = low + (high - low) / 2;
+    if (predicates[mid] < predicate)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if (low == set->length || predicates[low] != predicate)
+    return false;
+  *occurrences = engine->stats.set_occurrences[set->offset + low];
+  return true;
+}
+
+// Rows of a star (patterns sharing a subject variable, constant predicates) from characteristic sets
+static double sparql_star_rows(const SPARQLEngine *engine, const SPARQLQuery *query,
+                               const SPARQLPatternEstimate *estimates, const uint8_t *members, int member_count,
+                               double *subjects)
+{
+  // Selectivity of a constant object within its predicate
+  double selectivity[SPARQL_MAX_PATTERNS];
+  for (int m = 0; m < member_count; m++)
+  {
+    const SPARQLPattern *pattern = &query->patterns[members[m]];
+    selectivity[m] = 1.0;
+    if (!(pattern->var_mask & 4))
+    {
+      const SPARQLPredicateStats *predicate = sparql_predicate_stats(engine, pattern->term[1]);
+      selectivity[m] = predicate ? estimates[members[m]].card / predicate->triples : 0.0;
+    }
+  }
+
+  double rows = 0, total_subjects = 0;
+  for (uint32_t s = 0; s < engine->stats.set_count; s++)
+  {
+    const SPARQLCharacteristicSet *set = &engine->stats.sets[s];
+    double estimate = set->subjects;
+    int m = 0;
+    for (; m < member_count; m++)
+    {
+      uint32_t occurrences;
+      if (!sparql_set_find(engine, set, query->patterns[members[m]].term[1], &occurrences))
+        break;
+      estimate *= (double)occurrences / set->subjects * selectivity[m];
+    }
+    if (m == member_count)
+    {
+      rows += estimate;
+      total_subjects += set->subjects;
+    }
+  }
+  *subjects = total_subjects;
+  return rows;
+}
+
+// Estimated rows joining the patterns in mask: stars from characteristic sets,
+// the rest assuming independence, combined per shared variable (System R)
+static double sparql_estimate_rows(const SPARQLEngine *engine, const SPARQLQuery *query,
+                                   const SPARQLPatternEstimate *estimates, uint32_t mask)
+{
+  double unit_rows[SPARQL_MAX_PATTERNS];
+  double unit_distinct[SPARQL_MAX_PATTERNS][SPARQL_MAX_VARIABLES];
+  uint32_t unit_vars[SPARQL_MAX_PATTERNS];
+  int unit_count = 0;
+  uint32_t grouped = 0;
+
+  for (uint32_t i = 0; i < query->pattern_count && engine->stats.set_count > 0; i++)
+  {
+    const SPARQLPattern *pattern = &query->patterns[i];
+    if (!(mask & (1u << i)) || (grouped & (1u << i)) || (pattern->var_mask & 3) != 1)
+      continue;
+
+    uint8_t members[SPARQL_MAX_PATTERNS];
+    int member_count = 0;
+    for (uint32_t j = i; j < query->pattern_count; j++)
+    {
+      const SPARQLPattern *other = &query->patterns[j];
+      if ((mask & (1u << j)) && (other->var_mask & 3) == 1 && other->term[0] == pattern->term[0])
+        members[member_count++] = (uint8_t)j;
+    }
+    if (member_count < 2)
+      continue;
+
+    double subjects;
+    double rows = sparql_star_rows(engine, query, estimates, members, member_count, &subjects);
+    if (rows == 0 && engine->stats.sets_truncated)
+      continue; // The matching sets may have been left out: assume independence instead
+
+    int unit = unit_count++;
+    unit_rows[unit] = rows;
+    unit_vars[unit] = 0;
+    for (int m = 0; m < member_count; m++)
+    {
+      const SPARQLPattern *member = &query->patterns[members[m]];
+      for (int position = 0; position < 3; position++)
+      {
+        if (!(member->var_mask & (1u << position)))
+          continue;
+        uint32_t var = member->term[position];
+        double distinct = position == 0 ? subjects : estimates[members[m]].distinct[position];
+        distinct = distinct < rows ? distinct : rows;
+        distinct = distinct < 1 ? 1 : distinct;
+        if (!(unit_vars[unit] & (1u << var)) || distinct < unit_distinct[unit][var])
+          unit_distinct[unit][var] = distinct;
+        unit_vars[unit] |= 1u << var;
+      }
+      grouped |= 1u << members[m];
+    }
+  }
+
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+  {
+    if (!(mask & (1u << i)) || (grouped & (1u << i)))
+      continue;
+    const SPARQLPattern *pattern = &query->patterns[i];
+    int unit = unit_count++;
+    unit_rows[unit] = estimates[i].card;
+    unit_vars[unit] = 0;
+    for (int position = 0; position < 3; position++)
+    {
+      if (!(pattern->var_mask & (1u << position)))
+        continue;
+      uint32_t var = pattern->term[position];
+      if (!(unit_vars[unit] & (1u << var)) || estimates[i].distinct[position] < unit_distinct[unit][var])
+        unit_distinct[unit][var] = estimates[i].distinct[position];
+      unit_vars[unit] |= 1u << var;
+    }
+  }
+
+  // A variable shared by k units keeps only its smallest domain
+  double rows = 1;
+  for (int unit = 0; unit < unit_count; unit++)
+    rows *= unit_rows[unit];
+  for (uint32_t var = 0; var < query->variable_count && rows > 0; var++)
+  {
+    double product = 1, smallest = 0;
+    int sharing = 0;
+    for (int unit = 0; unit < unit_count; unit++)
+    {
+      if (!(unit_vars[unit] & (1u << var)))
+        continue;
+      product *= unit_distinct[unit][var];
+      if (sharing++ == 0 || unit_distinct[unit][var] < smallest)
+        smallest = unit_distinct[unit][var];
+    }
+    if (sharing > 1)
+      rows /= product / smallest;
+  }
+  return rows;
+}
+
+// Binary search cost over the store
+static double sparql_seek_cost(const SPARQLEngine *engine)
+{
+  double levels = 1;
+  for (size_t n = engine->triples.count; n > 1; n >>= 1)
+    levels++;
+  return SPARQL_COST_SEEK_LEVEL * levels;
+}
+
+// Cost of joining pattern j to left rows binding bound_vars, and the cheaper algorithm
+static double sparql_step_cost(const SPARQLEngine *engine, const SPARQLPatternEstimate *estimate,
+                               uint32_t bound_vars, bool first, double left, double right, uint8_t *method)
+{
+  double seek = sparql_seek_cost(engine);
+  if (first)
+  {
+    *method = SPARQL_JOIN_SCAN;
+    return seek + estimate->card;
+  }
+
+  // Index nested loop: one range per row; range entries are the output rows
+  double cost = left * seek + right;
+  *method = SPARQL_JOIN_INDEX_NESTED_LOOP;
+
+  // Hash join: one scan of the constant range, one probe per row
+  if (estimate->vars & bound_vars)
+  {
+    double hash = seek + estimate->card * SPARQL_COST_HASH_BUILD + left * SPARQL_COST_HASH_PROBE + right;
+    if (hash < cost)
+    {
+      cost = hash;
+      *method = SPARQL_JOIN_HASH;
+    }
+  }
+  return cost;
+}
+
+// Choose pattern order and join algorithms: dynamic programming over left-deep
+// orders for small patterns, greedy cheapest-next-step beyond that
+static void sparql_plan_pairwise(const SPARQLEngine *engine, const SPARQLQuery *query,
+                                 const SPARQLPatternEstimate *estimates, SPARQLPlan *plan)
+{
+  uint32_t n = query->pattern_count;
+  plan->cost = 0;
+  if (n == 0)
+    return;
+
+  if (n <= SPARQL_DP_MAX_PATTERNS)
+  {
+    uint32_t full = (1u << n) - 1;
+    double rows[1u << SPARQL_DP_MAX_PATTERNS];
+    double cost[1u << SPARQL_DP_MAX_PATTERNS];
+    uint8_t last[1u << SPARQL_DP_MAX_PATTERNS];
+    uint8_t method[1u << SPARQL_DP_MAX_PATTERNS];
+    uint32_t vars[1u << SPARQL_DP_MAX_PATTERNS];
+
+    rows[0] = 1;
+    cost[0] = 0;
+    vars[0] = 0;
+    for (uint32_t mask = 1; mask <= full; mask++)
+    {
+      rows[mask] = sparql_estimate_rows(engine, query, estimates, mask);
+      cost[mask] = -1;
+      uint32_t low = mask & (0u - mask);
+      vars[mask] = vars[mask & ~low] | estimates[__builtin_ctz(low)].vars;
+    }
+
+    // Masks grow by one bit, so every subset is final before it is extended
+    for (uint32_t mask = 0; mask < full; mask++)
+    {
+      if (mask && cost[mask] < 0)
+        continue;
+      for (uint32_t j = 0; j < n; j++)
+      {
+        if (mask & (1u << j))
+          continue;
+        uint32_t next = mask | (1u << j);
+        uint8_t step;
+        double total = cost[mask] + sparql_step_cost(engine, &estimates[j], vars[mask], mask == 0, rows[mask],
+                                                     rows[next], &step);
+        if (cost[next] < 0 || total < cost[next])
+        {
+          cost[next] = total;
+          last[next] = (uint8_t)j;
+          method[next] = step;
+        }
+      }
+    }
+
+    plan->cost = cost[full];
+    for (uint32_t mask = full, step = n; mask; step--)
+    {
+      plan->order[step - 1] = last[mask];
+      plan->method[step - 1] = method[mask];
+      plan->rows[step - 1] = rows[mask];
+      mask &= ~(1u << last[mask]);
+    }
+    return;
+  }
+
+  uint32_t mask = 0, bound_vars = 0;
+  double left = 1;
+  for (uint32_t step = 0; step < n; step++)
+  {
+    double best = -1, best_rows = 0;
+    uint32_t best_j = 0;
+    uint8_t best_method = SPARQL_JOIN_SCAN;
+    for (uint32_t j = 0; j < n; j++)
+    {
+      if (mask & (1u << j))
+        continue;
+      double right = sparql_estimate_rows(engine, query, estimates, mask | (1u << j));
+      uint8_t method;
+      double cost = sparql_step_cost(engine, &estimates[j], bound_vars, step == 0, left, right, &method);
+      if (best < 0 || cost < best)
+      {
+        best = cost;
+        best_rows = right;
+        best_j = j;
+        best_method = method;
+      }
+    }
+    plan->order[step] = (uint8_t)best_j;
+    plan->method[step] = best_method;
+    plan->rows[step] = best_rows;
+    plan->cost += best;
+    mask |= 1u << best_j;
+    bound_vars |= estimates[best_j].vars;
+    left = best_rows;
+  }
+}
+
+// A cycle in the graph of variables joined by patterns; patterns repeating a
+// variable are left to the pairwise joins
+static bool sparql_leapfrog_applies(const SPARQLQuery *query)
+{
+  uint8_t parent[SPARQL_MAX_VARIABLES];
+  for (uint32_t var = 0; var < query->variable_count; var++)
+    parent[var] = (uint8_t)var;
+
+  bool cyclic = false;
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+  {
+    const SPARQLPattern *pattern = &query->patterns[i];
+    uint32_t vars[3];
+    int count = 0;
+    for (int position = 0; position < 3; position++)
+    {
+      if (!(pattern->var_mask & (1u << position)))
+        continue;
+      for (int k = 0; k < count; k++)
+      {
+        if (vars[k] == pattern->term[position])
+          return false;
+      }
+      vars[count++] = pattern->term[position];
+    }
+
+    for (int k = 1; k < count; k++)
+    {
+      uint32_t x = vars[0], y = vars[k];
+      while (parent[x] != x)
+        x = parent[x];
+      while (parent[y] != y)
+        y = parent[y];
+      if (x == y)
+        cyclic = true;
+      else
+        parent[y] = (uint8_t)x;
+    }
+  }
+  return cyclic;
+}
+
+// Leapfrog variable order: most constrained first, then variables joined to those already chosen
+static void sparql_variable_order(const SPARQLQuery *query, const SPARQLPatternEstimate *estimates, uint8_t *order)
+{
+  double domain[SPARQL_MAX_VARIABLES];
+  uint32_t occurrences[SPARQL_MAX_VARIABLES] = {0};
+  for (uint32_t var = 0; var < query->variable_count; var++)
+    domain[var] = -1;
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+  {
+    for (int position = 0; position < 3; position++)
+    {
+      if (!(query->patterns[i].var_mask & (1u << position)))
+        continue;
+      uint32_t var = query->patterns[i].term[position];
+      occurrences[var]++;
+      if (domain[var] < 0 || estimates[i].distinct[position] < domain[var])
+        domain[var] = estimates[i].distinct[position];
+    }
+  }
+
+  uint32_t chosen = 0;
+  for (uint32_t step = 0; step < query->variable_count; step++)
+  {
+    int best = -1;
+    uint32_t best_links = 0;
+    for (uint32_t var = 0; var < query->variable_count; var++)
+    {
+      if (chosen & (1u << var))
+        continue;
+      uint32_t links = 0;
+      for (uint32_t i = 0; i < query->pattern_count; i++)
+        links += (estimates[i].vars & (1u << var)) && (estimates[i].vars & chosen);
+
+      if (best < 0 || links > best_links ||
+          (links == best_links && (occurrences[var] > occurrences[best] ||
+                                   (occurrences[var] == occurrences[best] && domain[var] < domain[best]))))
+      {
+        best = (int)var;
+        best_links = links;
+      }
+    }
+    order[step] = (uint8_t)best;
+    chosen |= 1u << best;
+  }
+}
+
+// Plan a basic graph pattern: leapfrog triejoin for cyclic patterns, pairwise joins otherwise
+static void sparql_plan(const SPARQLEngine *engine, const SPARQLQuery *query, SPARQLPlan *plan)
+{
+  SPARQLPatternEstimate estimates[SPARQL_MAX_PATTERNS];
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+    sparql_estimate_pattern(engine, &query->patterns[i], &estimates[i]);
+
+  plan->leapfrog = false;
+  sparql_plan_pairwise(engine, query, estimates, plan);
+  plan->result_rows = query->pattern_count ? plan->rows[query->pattern_count - 1] : 1;
+
+  if (engine->leapfrog && sparql_leapfrog_applies(query))
+  {
+    plan->leapfrog = true;
+    sparql_variable_order(query, estimates, plan->variable_order);
+    for (uint32_t i = 0; i < query->pattern_count; i++)
+    {
+      plan->order[i] = (uint8_t)i;
+      plan->method[i] = SPARQL_JOIN_LEAPFROG;
+      plan->rows[i] = estimates[i].card;
+    }
+  }
+}
+
+// ---------------------------------------------------------------------------
+// Evaluation
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+  uint32_t *data;
+  size_t count;
+  size_t capacity; // Rows
+  uint32_t width;
+} SPARQLRows;
+
+static uint32_t *sparql_rows_append(SPARQLRows *rows)
+{
+  if (rows->count == rows->capacity)
+  {
+    size_t capacity = rows->capacity ? rows->capacity * 2 : 256;
+    uint32_t *data = realloc(rows->data, capacity * rows->width * sizeof(uint32_t));
+    if (!data)
+      return NULL;
+    rows->data = data;
+    rows->capacity = capacity;
+  }
+  return rows->data + rows->count++ * rows->width;
+}
+
+// A variable repeated in the pattern must bind one value
+static inline bool sparql_match_consistent(const SPARQLPattern *pattern, uint8_t free_mask, const uint32_t match[3])
+{
+  for (int x = 0; x < 3; x++)
+  {
+    for (int y = x + 1; y < 3; y++)
+    {
+      if ((free_mask & (1u << x)) && (free_mask & (1u << y)) && pattern->term[x] == pattern->term[y] &&
+          match[x] != match[y])
+        return false;
+    }
+  }
+  return true;
+}
+
+// Append a row extended with the pattern's free variables
+static inline bool sparql_extend_row(SPARQLRows *output, const uint32_t *row, const SPARQLPattern *pattern,
+                                     uint8_t free_mask, const uint32_t match[3])
+{
+  uint32_t *extended = sparql_rows_append(output);
+  if (!extended)
+    return false;
+  memcpy(extended, row, output->width * sizeof(uint32_t));
+  for (int position = 0; position < 3; position++)
+  {
+    if (free_mask & (1u << position))
+      extended[pattern->term[position]] = match[position];
+  }
+  return true;
+}
+
+// Extend every row with the matches of one pattern (index nested loop join)
+static bool sparql_join_pattern(const SPARQLEngine *engine, const SPARQLPattern *pattern, uint32_t bound_vars,
+                                const SPARQLRows *input, SPARQLRows *output, uint64_t limit)
+{
+  for (size_t r = 0; r < input->count; r++)
+  {
+    const uint32_t *row = input->data + r * input->width;
+    uint32_t spo[3] = {0, 0, 0};
+    uint8_t bound = 0;
+    uint8_t free_mask = 0;
+
+    for (int position = 0; position < 3; position++)
+    {
+      uint32_t term = pattern->term[position];
+      if (!(pattern->var_mask & (1u << position)))
+      {
+        spo[position] = term;
+        bound |= (uint8_t)(1u << position);
+      }
+      else if (bound_vars & (1u << term))
+      {
+        spo[position] = row[term];
+        bound |= (uint8_t)(1u << position);
+      }
+      else
+      {
+        free_mask |= (uint8_t)(1u << position);
+      }
+    }
+
+    int index;
+    size_t count;
+    const SPARQLKey *keys = sparql_range(engine, bound, spo, &index, &count);
+    for (size_t k = 0; k < count; k++)
+    {
+      uint32_t match[3];
+      sparql_key_to_spo(&keys[k], index, match);
+      if (!sparql_match_consistent(pattern, free_mask, match))
+        continue;
+      if (!sparql_extend_row(output, row, pattern, free_mask, match))
+        return false;
+      if (limit && output->count == limit)
+        return true;
+    }
+  }
+  return true;
+}
+
+static inline uint64_t sparql_join_key_hash(const uint32_t key[3])
+{
+  uint64_t hash = key[0] * 0x9E3779B97F4A7C15ULL;
+  hash = (hash ^ key[1]) * 0xC2B2AE3D27D4EB4FULL;
+  hash = (hash ^ key[2]) * 0x165667B19E3779F9ULL;
+  return hash ^ (hash >> 29);
+}
+
+// Extend every row with the matches of one pattern (hash join): the pattern's
+// constant range is hashed once on the positions the input rows bind
+static bool sparql_hash_join_pattern(const SPARQLEngine *engine, const SPARQLPattern *pattern, uint32_t bound_vars,
+                                     const SPARQLRows *input, SPARQLRows *output, uint64_t limit)
+{
+  uint32_t spo[3] = {0, 0, 0};
+  uint8_t bound = 0, keyed = 0, free_mask = 0;
+  for (int position = 0; position < 3; position++)
+  {
+    uint32_t term = pattern->term[position];
+    if (!(pattern->var_mask & (1u << position)))
+    {
+      spo[position] = term;
+      bound |= (uint8_t)(1u << position);
+    }
+    else if (bound_vars & (1u << term))
+    {
+      keyed |= (uint8_t)(1u << position);
+    }
+    else
+    {
+      free_mask |= (uint8_t)(1u << position);
+    }
+  }
+
+  int index;
+  size_t count;
+  const SPARQLKey *keys = sparql_range(engine, bound, spo, &index, &count);
+  if (!keyed || count >= UINT32_MAX)
+    return sparql_join_pattern(engine, pattern, bound_vars, input, output, limit);
+  if (count == 0)
+    return true;
+
+  size_t size = 16;
+  while (size < count * 2)
+    size *= 2;
+  uint32_t *heads = malloc(size * sizeof(uint32_t));
+  uint32_t *next = malloc(count * sizeof(uint32_t));
+  if (!heads || !next)
+  {
+    free(heads);
+    free(next);
+    return false;
+  }
+  memset(heads, 0xFF, size * sizeof(uint32_t));
+
+  // Build: chain entries by their keyed positions
+  for (size_t k = 0; k < count; k++)
+  {
+    uint32_t match[3], key[3];
+    sparql_key_to_spo(&keys[k], index, match);
+    for (int position = 0; position < 3; position++)
+      key[position] = (keyed & (1u << position)) ? match[position] : 0;
+    size_t slot = (size_t)sparql_join_key_hash(key) & (size - 1);
+    next[k] = heads[slot];
+    heads[slot] = (uint32_t)k;
+  }
+
+  // Probe with every input row
+  bool ok = true;
+  for (size_t r = 0; r < input->count && ok; r++)
+  {
+    const uint32_t *row = input->data + r * input->width;
+    uint32_t key[3];
+    for (int position = 0; position < 3; position++)
+      key[position] = (keyed & (1u << position)) ? row[pattern->term[position]] : 0;
+
+    for (uint32_t k = heads[(size_t)sparql_join_key_hash(key) & (size - 1)]; k != UINT32_MAX; k = next[k])
+    {
+      uint32_t match[3];
+      sparql_key_to_spo(&keys[k], index, match);
+      bool equal = true;
+      for (int position = 0; position < 3; position++)
+      {
+        if ((keyed & (1u << position)) && match[position] != key[position])
+          equal = false;
+      }
+      if (!equal || !sparql_match_consistent(pattern, free_mask, match))
+        continue;
+      if (!sparql_extend_row(output, row, pattern, free_mask, match))
+      {
+        ok = false;
+        break;
+      }
+      if (limit && output->count == limit)
+      {
+        r = input->count;
+        break;
+      }
+    }
+  }
+
+  free(heads);
+  free(next);
+  return ok;
+}
+
+// Remove duplicate rows in place, keeping first occurrences
+static bool sparql_distinct(uint32_t *rows, size_t *count, uint32_t width)
+{
+  size_t size = 16;
+  while (size < *count * 2)
+    size *= 2;
+  size_t *slots = malloc(size * sizeof(size_t));
+  if (!slots)
+    return false;
+  memset(slots, 0xFF, size * sizeof(size_t));
+
+  size_t unique = 0;
+  for (size_t r = 0; r < *count; r++)
+  {
+    const uint32_t *row = rows + r * width;
+    size_t i = (size_t)sparql_hash((const char *)row, width * sizeof(uint32_t)) & (size - 1);
+    bool seen = false;
+    while (slots[i] != SIZE_MAX)
+    {
+      if (memcmp(rows + slots[i] * width, row, width * sizeof(uint32_t)) == 0)
+      {
+        seen = true;
+        break;
+      }
+      i = (i + 1) & (size - 1);
+    }
+    if (seen)
+      continue;
+
+    memmove(rows + unique * width, row, width * sizeof(uint32_t));
+    slots[i] = unique++;
+  }
+
+  free(slots);
+  *count = unique;
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Leapfrog triejoin
+// ---------------------------------------------------------------------------
+
+// One pattern as a trie: its constants, then its variables in join order
+typedef struct
+{
+  const SPARQLKey *keys;
+  const uint32_t *last; // Last key field as one array: a leaf level's ids are contiguous
+  uint8_t field;        // Key field of the first variable level
+  uint8_t levels; // Variables in the pattern
+  uint8_t level;  // Levels bound so far
+  uint32_t vars[3];
+  size_t lo[4]; // Range per level; lo is the cursor while a level is searched
+  size_t hi[4];
+} SPARQLTrie;
+
+typedef struct
+{
+  SPARQLTrie tries[SPARQL_MAX_PATTERNS];
+  uint32_t trie_count;
+  const uint8_t *order;
+  uint32_t var_count;
+  uint32_t values[SPARQL_MAX_VARIABLES];
+  uint32_t *scratch[SPARQL_MAX_VARIABLES]; // Candidate ids per depth
+  size_t scratch_capacity[SPARQL_MAX_VARIABLES];
+  SPARQLRows *output;
+  uint64_t limit;
+  bool done;
+  bool failed;
+} SPARQLLeapfrog;
+
+static inline uint32_t sparql_key_field(const SPARQLKey *key, int field)
+{
+  return field == 0 ? key->a : field == 1 ? key->b : key->c;
+}
+
+// First position in [pos, hi) whose field is at least value (galloping search)
+static inline size_t sparql_gallop(const SPARQLKey *keys, int field, size_t pos, size_t hi, uint32_t value)
+{
+  if (pos >= hi || sparql_key_field(&keys[pos], field) >= value)
+    return pos;
+
+  size_t low = pos, step = 1;
+  while (low + step < hi && sparql_key_field(&keys[low + step], field) < value)
+  {
+    low += step;
+    step *= 2;
+  }
+  size_t high = low + step < hi ? low + step : hi;
+  low++;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    if (sparql_key_field(&keys[mid], field) < value)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+// Intersect two sorted duplicate-free id lists; out may alias a
+static size_t sparql_intersect_sorted(const uint32_t *a, size_t a_count, const uint32_t *b, size_t b_count,
+                                      uint32_t *out)
+{
+  size_t i = 0, j = 0, n = 0;
+
+#if defined(__SSE2__)
+  // Compare four ids against four, advancing the block with the smaller maximum
+  while (i + 4 <= a_count && j + 4 <= b_count)
+  {
+    __m128i block = _mm_loadu_si128((const __m128i *)(a + i));
+    __m128i other = _mm_loadu_si128((const __m128i *)(b + j));
+    __m128i hit = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi32(block, other),
+                     _mm_cmpeq_epi32(block, _mm_shuffle_epi32(other, _MM_SHUFFLE(0, 3, 2, 1)))),
+        _mm_or_si128(_mm_cmpeq_epi32(block, _mm_shuffle_epi32(other, _MM_SHUFFLE(1, 0, 3, 2))),
+                     _mm_cmpeq_epi32(block, _mm_shuffle_epi32(other, _MM_SHUFFLE(2, 1, 0, 3)))));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(hit));
+    uint32_t a_max = a[i + 3], b_max = b[j + 3];
+    for (int bit = 0; mask; bit++, mask >>= 1)
+    {
+      if (mask & 1)
+        out[n++] = a[i + bit];
+    }
+    i += (a_max <= b_max) * 4;
+    j += (b_max <= a_max) * 4;
+  }
+#endif
+
+  while (i < a_count && j < b_count)
+  {
+    if (a[i] < b[j])
+      i++;
+    else if (b[j] < a[i])
+      j++;
+    else
+    {
+      out[n++] = a[i];
+      i++;
+      j++;
+    }
+  }
+  return n;
+}
+
+static uint32_t *sparql_leapfrog_scratch(SPARQLLeapfrog *state, uint32_t depth, size_t count)
+{
+  if (state->scratch_capacity[depth] < count)
+  {
+    uint32_t *grown = realloc(state->scratch[depth], count * sizeof(uint32_t));
+    if (!grown)
+    {
+      state->failed = true;
+      return NULL;
+    }
+    state->scratch[depth] = grown;
+    state->scratch_capacity[depth] = count;
+  }
+  return state->scratch[depth];
+}
+
+// Open the next level of every trie at an id they all hold
+static inline void sparql_tries_open(SPARQLTrie **tries, uint32_t count, uint32_t id)
+{
+  for (uint32_t p = 0; p < count; p++)
+  {
+    SPARQLTrie *trie = tries[p];
+    uint8_t level = trie->level;
+    trie->lo[level + 1] = trie->lo[level];
+    trie->hi[level + 1] = id == UINT32_MAX ? trie->hi[level]
+                                           : sparql_gallop(trie->keys, trie->field + level, trie->lo[level],
+                                                           trie->hi[level], id + 1);
+    trie->level++;
+  }
+}
+
+// Close the level opened last and move past its id; true once a trie runs out
+static inline bool sparql_tries_close(SPARQLTrie **tries, uint32_t count)
+{
+  bool exhausted = false;
+  for (uint32_t p = 0; p < count; p++)
+  {
+    SPARQLTrie *trie = tries[p];
+    trie->level--;
+    trie->lo[trie->level] = trie->hi[trie->level + 1];
+    exhausted |= trie->lo[trie->level] == trie->hi[trie->level];
+  }
+  return exhausted;
+}
+
+static void sparql_leapfrog_search(SPARQLLeapfrog *state, uint32_t depth)
+{
+  if (depth == state->var_count)
+  {
+    uint32_t *row = sparql_rows_append(state->output);
+    if (!row)
+    {
+      state->failed = state->done = true;
+      return;
+    }
+    memcpy(row, state->values, state->output->width * sizeof(uint32_t));
+    state->done = state->limit && state->output->count == state->limit;
+    return;
+  }
+
+  // Tries whose next level is this variable: leaves (their last level) and inner levels
+  uint32_t var = state->order[depth];
+  SPARQLTrie *leaves[SPARQL_MAX_PATTERNS], *inner[SPARQL_MAX_PATTERNS];
+  uint32_t leaf_count = 0, inner_count = 0;
+  size_t smallest = SIZE_MAX, largest = 0;
+  for (uint32_t t = 0; t < state->trie_count; t++)
+  {
+    SPARQLTrie *trie = &state->tries[t];
+    if (trie->level == trie->levels || trie->vars[trie->level] != var)
+      continue;
+    size_t size = trie->hi[trie->level] - trie->lo[trie->level];
+    if (size == 0)
+      return;
+    if (trie->level + 1 < trie->levels)
+    {
+      inner[inner_count++] = trie;
+      continue;
+    }
+
+    // Leaves by ascending size
+    uint32_t k = leaf_count++;
+    for (; k > 0 && leaves[k - 1]->hi[leaves[k - 1]->level] - leaves[k - 1]->lo[leaves[k - 1]->level] > size; k--)
+      leaves[k] = leaves[k - 1];
+    leaves[k] = trie;
+    smallest = size < smallest ? size : smallest;
+    largest = size > largest ? size : largest;
+  }
+
+  // Cursors are rewound on exit since a trie's first level is searched again
+  // for every binding of the variables before it
+  size_t start[SPARQL_MAX_PATTERNS];
+  for (uint32_t p = 0; p < inner_count; p++)
+    start[p] = inner[p]->lo[inner[p]->level];
+
+  if (leaf_count >= 2 && largest <= smallest * SPARQL_GALLOP_RATIO)
+  {
+    // Leaf lists of similar length: intersect them as contiguous id arrays,
+    // then seek the inner tries to each surviving id
+    uint32_t *candidates = sparql_leapfrog_scratch(state, depth, smallest);
+    if (!candidates)
+    {
+      state->done = true;
+      return;
+    }
+    const uint32_t *ids = leaves[0]->last + leaves[0]->lo[leaves[0]->level];
+    size_t matches = smallest;
+    for (uint32_t p = 1; p < leaf_count && matches > 0; p++)
+    {
+      const SPARQLTrie *trie = leaves[p];
+      size_t lo = trie->lo[trie->level];
+      matches = sparql_intersect_sorted(ids, matches, trie->last + lo, trie->hi[trie->level] - lo, candidates);
+      ids = candidates;
+    }
+
+    for (uint32_t p = 0; p < leaf_count; p++)
+      leaves[p]->level++;
+    bool exhausted = false;
+    for (size_t m = 0; m < matches && !exhausted && !state->done; m++)
+    {
+      uint32_t id = ids[m];
+      bool found = true;
+      for (uint32_t p = 0; p < inner_count && found; p++)
+      {
+        SPARQLTrie *trie = inner[p];
+        int field = trie->field + trie->level;
+        size_t pos = sparql_gallop(trie->keys, field, trie->lo[trie->level], trie->hi[trie->level], id);
+        trie->lo[trie->level] = pos;
+        exhausted |= pos == trie->hi[trie->level];
+        found = !exhausted && sparql_key_field(&trie->keys[pos], field) == id;
+      }
+      if (!found)
+        continue;
+
+      sparql_tries_open(inner, inner_count, id);
+      state->values[var] = id;
+      sparql_leapfrog_search(state, depth + 1);
+      exhausted = sparql_tries_close(inner, inner_count);
+    }
+    for (uint32_t p = 0; p < leaf_count; p++)
+      leaves[p]->level--;
+  }
+  else
+  {
+    // Leapfrog: seek every trie to the largest current id until they agree
+    SPARQLTrie **participants = inner;
+    uint32_t count = inner_count;
+    for (uint32_t p = 0; p < leaf_count; p++)
+    {
+      start[count] = leaves[p]->lo[leaves[p]->level];
+      participants[count++] = leaves[p];
+    }
+
+    bool exhausted = false;
+    while (!exhausted && !state->done)
+    {
+      uint32_t target = 0;
+      for (uint32_t p = 0; p < count; p++)
+      {
+        const SPARQLTrie *trie = participants[p];
+        uint32_t id = sparql_key_field(&trie->keys[trie->lo[trie->level]], trie->field + trie->level);
+        target = id > target ? id : target;
+      }
+
+      bool aligned = true;
+      for (uint32_t p = 0; p < count && !exhausted; p++)
+      {
+        SPARQLTrie *trie = participants[p];
+        int field = trie->field + trie->level;
+        size_t pos = sparql_gallop(trie->keys, field, trie->lo[trie->level], trie->hi[trie->level], target);
+        trie->lo[trie->level] = pos;
+        exhausted = pos == trie->hi[trie->level];
+        aligned &= exhausted || sparql_key_field(&trie->keys[pos], field) == target;
+      }
+      if (exhausted || !aligned)
+        continue;
+
+      sparql_tries_open(participants, count, target);
+      state->values[var] = target;
+      sparql_leapfrog_search(state, depth + 1);
+      exhausted = sparql_tries_close(participants, count);
+    }
+    inner_count = count;
+  }
+
+  for (uint32_t p = 0; p < inner_count; p++)
+    inner[p]->lo[inner[p]->level] = start[p];
+}
+
+// Permutation a pattern is read through: constants first, then variables by their rank in the join order
+static int sparql_trie_permutation(const SPARQLPattern *pattern, const uint8_t *rank, uint8_t *constants)
+{
+  uint8_t positions[3];
+  uint8_t n = 0;
+  for (uint8_t position = 0; position < 3; position++)
+  {
+    if (!(pattern->var_mask & (1u << position)))
+      positions[n++] = position;
+  }
+  *constants = n;
+  for (; n < 3; n++)
+  {
+    uint8_t best = 0xFF;
+    for (uint8_t position = 0; position < 3; position++)
+    {
+      bool used = false;
+      for (uint8_t k = 0; k < n; k++)
+        used |= positions[k] == position;
+      if (!used && (best == 0xFF || rank[pattern->term[position]] < rank[pattern->term[best]]))
+        best = position;
+    }
+    positions[n] = best;
+  }
+
+  for (int index = 0; index < SPARQL_PERMUTATION_COUNT; index++)
+  {
+    if (memcmp(sparql_permutation_order[index], positions, 3) == 0)
+      return index;
+  }
+  return SPARQL_INDEX_SPO;
+}
+
+// Evaluate every pattern at once, binding one variable at a time
+static bool sparql_leapfrog_join(const SPARQLEngine *engine, const SPARQLQuery *query, SPARQLRows *output,
+                                 uint64_t limit)
+{
+  SPARQLLeapfrog state = {0};
+  state.order = query->plan.variable_order;
+  state.var_count = query->variable_count;
+  state.output = output;
+  state.limit = limit;
+
+  uint8_t rank[SPARQL_MAX_VARIABLES];
+  for (uint32_t i = 0; i < query->variable_count; i++)
+    rank[query->plan.variable_order[i]] = (uint8_t)i;
+
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+  {
+    const SPARQLPattern *pattern = &query->patterns[i];
+    uint8_t constants;
+    int index = sparql_trie_permutation(pattern, rank, &constants);
+    const uint8_t *order = sparql_permutation_order[index];
+
+    SPARQLTrie *trie = &state.tries[state.trie_count++];
+    trie->keys = engine->triples.index[index];
+    trie->last = engine->triples.last[index];
+    trie->field = constants;
+    trie->levels = (uint8_t)(3 - constants);
+    trie->level = 0;
+    for (int level = 0; level < trie->levels; level++)
+      trie->vars[level] = pattern->term[order[constants + level]];
+
+    // Constant prefix range
+    SPARQLKey probe = {pattern->term[order[0]], pattern->term[order[1]], pattern->term[order[2]]};
+    size_t low = 0, high = engine->triples.count;
+    if (constants > 0 && high > 0)
+    {
+      low = sparql_bound(trie->keys, high, &probe, constants, false);
+      high = low + sparql_bound(trie->keys + low, high - low, &probe, constants, true);
+    }
+    if (low == high)
+      return true;
+    trie->lo[0] = low;
+    trie->hi[0] = high;
+  }
+
+  sparql_leapfrog_search(&state, 0);
+
+  for (uint32_t depth = 0; depth < SPARQL_MAX_VARIABLES; depth++)
+    free(state.scratch[depth]);
+  return !state.failed;
+}
+
+// Build the permutations and last-field columns a leapfrog plan reads that are not kept up to date
+static int sparql_prepare_leapfrog(SPARQLEngine *engine, const SPARQLQuery *query)
+{
+  size_t count = engine->triples.count;
+  uint8_t rank[SPARQL_MAX_VARIABLES];
+  for (uint32_t i = 0; i < query->variable_count; i++)
+    rank[query->plan.variable_order[i]] = (uint8_t)i;
+
+  for (uint32_t i = 0; i < query->pattern_count && count > 0; i++)
   {
-    uint32_t subject[1024];
-    uint32_t predicate[1024];
-    uint32_t object[1024];
-    uint32_t count;
-    uint32_t capacity;
-  } triples;
+    uint8_t constants;
+    int index = sparql_trie_permutation(&query->patterns[i], rank, &constants);
+    if (!engine->triples.index[index])
+    {
+      SPARQLKey *keys = malloc(count * sizeof(SPARQLKey));
+      if (!keys)
+        return CNS_ERR_RESOURCE;
+      sparql_rotate_keys(keys, engine->triples.index[SPARQL_INDEX_SPO], count, index);
+      if (!sparql_sort_keys(keys, count))
+      {
+        free(keys);
+        return CNS_ERR_RESOURCE;
+      }
+      engine->triples.index[index] = keys;
+    }
+    if (!engine->triples.last[index])
+    {
+      uint32_t *last = malloc(count * sizeof(uint32_t));
+      if (!last)
+        return CNS_ERR_RESOURCE;
+      for (size_t k = 0; k < count; k++)
+        last[k] = engine->triples.index[index][k].c;
+      engine->triples.last[index] = last;
+    }
+  }
+  return CNS_OK;
+}
 
-  // Index for fast lookups (80/20: most queries are simple)
-  struct
+// ---------------------------------------------------------------------------
+// Query execution
+// ---------------------------------------------------------------------------
+
+// Evaluate a basic graph pattern in plan order
+static bool sparql_evaluate(const SPARQLEngine *engine, const SPARQLQuery *query, SPARQLResult *result)
+{
+  result->variable_count = query->projection_count;
+  for (uint32_t i = 0; i < query->projection_count; i++)
+  {
+    memcpy(result->variables[i], query->variables[query->projection[i]], SPARQL_MAX_VARIABLE_NAME);
+  }
+  if (query->unsatisfiable || engine->triples.count == 0)
   {
-    uint32_t subject_index[1024];
-    uint32_t predicate_index[1024];
-    uint32_t object_index[1024];
-  } indices;
+    return true;
+  }
 
-  // Query cache (80/20: cache common queries)
-  struct
+  // Start from one empty row
+  uint32_t width = query->variable_count ? query->variable_count : 1;
+  SPARQLRows rows = {calloc(width, sizeof(uint32_t)), 1, 1, width};
+  if (!rows.data)
+    return false;
+
+  if (query->plan.leapfrog)
   {
-    char *query_string[64];
-    uint32_t result_count[64];
-    uint32_t cache_size;
-  } cache;
+    SPARQLRows joined = {NULL, 0, 0, width};
+    bool ok = sparql_leapfrog_join(engine, query, &joined, query->distinct ? 0 : query->limit);
+    free(rows.data);
+    rows = joined;
+    if (!ok)
+    {
+      free(rows.data);
+      return false;
+    }
+  }
 
-  // Performance tracking
-  uint64_t total_queries;
-  uint64_t cache_hits;
-  uint64_t total_cycles;
-} SPARQLEngine;
+  uint32_t bound_vars = 0;
+  for (uint32_t i = 0; i < query->pattern_count && rows.count > 0 && !query->plan.leapfrog; i++)
+  {
+    const SPARQLPattern *pattern = &query->patterns[query->plan.order[i]];
+    bool last = i + 1 == query->pattern_count;
+    uint64_t limit = last && !query->distinct ? query->limit : 0;
+    SPARQLRows next = {NULL, 0, 0, width};
+    bool ok = query->plan.method[i] == SPARQL_JOIN_HASH
+                  ? sparql_hash_join_pattern(engine, pattern, bound_vars, &rows, &next, limit)
+                  : sparql_join_pattern(engine, pattern, bound_vars, &rows, &next, limit);
+    if (!ok)
+    {
+      free(rows.data);
+      free(next.data);
+      return false;
+    }
+    free(rows.data);
+    rows = next;
 
-// Global engine instance (80/20: single instance is sufficient)
-static SPARQLEngine *g_sparql_engine = NULL;
+    for (int position = 0; position < 3; position++)
+    {
+      if (pattern->var_mask & (1u << position))
+        bound_vars |= 1u << pattern->term[position];
+    }
+  }
 
-// Initialize SPARQL engine (7 cycles target)
-SPARQLEngine *cns_sparql_create(size_t initial_capacity)
-{
-  uint64_t start = cns_get_cycles();
+  // Matched triples for single-pattern queries
+  if (query->pattern_count == 1 && !query->distinct && rows.count > 0)
+  {
+    result->triples = malloc(rows.count * sizeof(*result->triples));
+    if (!result->triples)
+    {
+      free(rows.data);
+      return false;
+    }
+    const SPARQLPattern *pattern = &query->patterns[0];
+    for (size_t r = 0; r < rows.count; r++)
+    {
+      uint32_t spo[3];
+      for (int position = 0; position < 3; position++)
+      {
+        spo[position] = (pattern->var_mask & (1u << position)) ? rows.data[r * width + pattern->term[position]]
+                                                               : pattern->term[position];
+      }
+      result->triples[r].subject = spo[0];
+      result->triples[r].predicate = spo[1];
+      result->triples[r].object = spo[2];
+    }
+  }
 
-  if (g_sparql_engine)
+  // Project in place
+  uint32_t projected = query->projection_count;
+  for (size_t r = 0; r < rows.count; r++)
   {
-    return g_sparql_engine; // Return existing instance
+    uint32_t *row = rows.data + r * width;
+    uint32_t *target = rows.data + r * projected;
+    uint32_t values[SPARQL_MAX_VARIABLES];
+    for (uint32_t i = 0; i < projected; i++)
+      values[i] = row[query->projection[i]];
+    memcpy(target, values, projected * sizeof(uint32_t));
   }
 
-  g_sparql_engine = calloc(1, sizeof(SPARQLEngine));
-  if (!g_sparql_engine)
+  size_t count = rows.count;
+  if (query->distinct && projected > 0 && !sparql_distinct(rows.data, &count, projected))
   {
-    return NULL;
+    free(rows.data);
+    return false;
   }
+  if (query->distinct && projected == 0 && count > 1)
+    count = 1;
+  if (query->limit && count > query->limit)
+    count = query->limit;
+
+  result->count = (uint32_t)count;
+  result->bindings = rows.data;
+  return true;
+}
 
-  // Initialize with default capacity (80/20: 1024 triples covers most use cases)
-  g_sparql_engine->triples.capacity = 1024;
-  g_sparql_engine->triples.count = 0;
+// ---------------------------------------------------------------------------
+// Plan cache
+// ---------------------------------------------------------------------------
 
-  uint64_t cycles = cns_get_cycles() - start;
-  cns_assert_cycles(start, 7);
+// Normalized query: the cache key plus the constants and variable names lifted out of it
+typedef struct
+{
+  char key[SPARQL_MAX_SHAPE]; // e.g. "SELECT ?0 WHERE { ?1 $ $ . } LIMIT 10"
+  size_t length;
+  uint64_t hash;
+  uint32_t params[SPARQL_MAX_PARAMS];
+  uint32_t param_count;
+  bool unsatisfiable; // A dictionary constant is unknown
+  SPARQLQuery names;  // Variable names in slot order
+} SPARQLShape;
 
-  return g_sparql_engine;
+static bool sparql_shape_append(SPARQLShape *shape, const char *text, size_t length)
+{
+  if (shape->length + length + 1 > sizeof(shape->key))
+    return false;
+  memcpy(shape->key + shape->length, text, length);
+  shape->length += length;
+  shape->key[shape->length++] = ' ';
+  return true;
 }
 
-// Destroy SPARQL engine (3 cycles target)
-void cns_sparql_destroy(SPARQLEngine *engine)
+// Lex a query into its shape, resolving constants on the way
+// Queries with the same shape parse to the same template, so they share one parse and plan;
+// false for text the lexer does not accept, which is then parsed uncached
+static bool sparql_normalize(const SPARQLEngine *engine, const char *text, SPARQLShape *shape)
 {
-  uint64_t start = cns_get_cycles();
+  static const char *const keywords[] = {"SELECT", "DISTINCT", "WHERE", "LIMIT"};
 
-  if (engine)
+  SPARQLParser parser = {0};
+  parser.cursor = text;
+  parser.engine = engine;
+  parser.query = &shape->names;
+  shape->length = 0;
+  shape->param_count = 0;
+  shape->unsatisfiable = false;
+  shape->names.variable_count = 0;
+  if (!sparql_parse_prefixes(&parser))
+    return false;
+
+  for (;;)
   {
-    // Free cache strings
-    for (uint32_t i = 0; i < engine->cache.cache_size; i++)
+    sparql_skip_space(&parser);
+    const char *token = parser.cursor;
+    if (*token == '\0')
+      break;
+
+    if (*token == '?' || *token == '$')
+    {
+      uint32_t slot;
+      char name[16];
+      if (!sparql_variable(&parser, &slot))
+        return false;
+      int length = snprintf(name, sizeof(name), "?%u", slot);
+      if (!sparql_shape_append(shape, name, (size_t)length))
+        return false;
+      continue;
+    }
+
+    if (strchr("{}.;,*", *token))
+    {
+      parser.cursor++;
+      if (!sparql_shape_append(shape, token, 1))
+        return false;
+      continue;
+    }
+
+    int keyword = -1;
+    for (int k = 0; k < (int)(sizeof(keywords) / sizeof(keywords[0])) && keyword < 0; k++)
+    {
+      if (sparql_keyword(&parser, keywords[k]))
+      {
+        if (*parser.cursor == ':') // A prefixed name such as where:x
+          parser.cursor = token;
+        else
+          keyword = k;
+      }
+    }
+    if (keyword >= 0)
     {
-      if (engine->cache.query_string[i])
+      if (!sparql_shape_append(shape, keywords[keyword], strlen(keywords[keyword])))
+        return false;
+      if (strcmp(keywords[keyword], "LIMIT") == 0)
       {
-        free(engine->cache.query_string[i]);
+        // The limit stays part of the key
+        sparql_skip_space(&parser);
+        const char *digits = parser.cursor;
+        while (isdigit((unsigned char)*parser.cursor))
+          parser.cursor++;
+        if (parser.cursor > digits && !sparql_shape_append(shape, digits, (size_t)(parser.cursor - digits)))
+          return false;
       }
+      continue;
     }
-    free(engine);
-    g_sparql_engine = NULL;
+
+    uint32_t id;
+    bool dictionary = !isdigit((unsigned char)*token);
+    if (shape->param_count == SPARQL_MAX_PARAMS || !sparql_read_constant(&parser, &id))
+      return false;
+    if (dictionary && id == 0)
+      shape->unsatisfiable = true;
+    shape->params[shape->param_count++] = id;
+    if (!sparql_shape_append(shape, "$", 1))
+      return false;
   }
 
-  uint64_t cycles = cns_get_cycles() - start;
-  cns_assert_cycles(start, 3);
+  shape->hash = sparql_hash(shape->key, shape->length);
+  return true;
 }
 
-// Add triple to store (5 cycles target)
-int cns_sparql_add_triple(SPARQLEngine *engine, uint32_t subject, uint32_t predicate, uint32_t object)
+// Substitute constants into a template's pattern positions
+static void sparql_bind(SPARQLQuery *query, const uint32_t *params, bool unsatisfiable)
 {
-  uint64_t start = cns_get_cycles();
+  for (uint32_t i = 0; i < query->pattern_count; i++)
+  {
+    SPARQLPattern *pattern = &query->patterns[i];
+    for (int position = 0; position < 3; position++)
+    {
+      if (!(pattern->var_mask & (1u << position)))
+        pattern->term[position] = params[pattern->param[position]];
+    }
+  }
+  query->unsatisfiable = unsatisfiable;
+}
+
+static void sparql_cache_unlink(SPARQLEngine *engine, SPARQLCacheEntry *entry)
+{
+  if (entry->newer)
+    entry->newer->older = entry->older;
+  else
+    engine->cache.newest = entry->older;
+  if (entry->older)
+    entry->older->newer = entry->newer;
+  else
+    engine->cache.oldest = entry->newer;
+}
+
+static void sparql_cache_push(SPARQLEngine *engine, SPARQLCacheEntry *entry)
+{
+  entry->newer = NULL;
+  entry->older = engine->cache.newest;
+  if (engine->cache.newest)
+    engine->cache.newest->newer = entry;
+  else
+    engine->cache.oldest = entry;
+  engine->cache.newest = entry;
+}
+
+static void sparql_cache_remove(SPARQLEngine *engine, SPARQLCacheEntry *entry)
+{
+  SPARQLCacheEntry **link = &engine->cache.buckets[entry->hash & engine->cache.bucket_mask];
+  while (*link != entry)
+    link = &(*link)->bucket_next;
+  *link = entry->bucket_next;
+  sparql_cache_unlink(engine, entry);
+  engine->cache.bytes -= entry->bytes;
+  engine->cache.count--;
+  free(entry->query);
+  free(entry);
+}
 
-  if (!engine || engine->triples.count >= engine->triples.capacity)
+// Least recently used entries go first
+static void sparql_cache_trim(SPARQLEngine *engine, size_t limit)
+{
+  while (engine->cache.oldest && engine->cache.bytes > limit)
   {
-    return CNS_ERR_RESOURCE;
+    sparql_cache_remove(engine, engine->cache.oldest);
+    engine->cache.evictions++;
+  }
+}
+
+// Find a shape's template and mark it most recently used
+static SPARQLCacheEntry *sparql_cache_find(SPARQLEngine *engine, const SPARQLShape *shape)
+{
+  if (!engine->cache.buckets)
+    return NULL;
+  for (SPARQLCacheEntry *entry = engine->cache.buckets[shape->hash & engine->cache.bucket_mask]; entry;
+       entry = entry->bucket_next)
+  {
+    if (entry->hash == shape->hash && entry->key_length == shape->length &&
+        memcmp(entry->key, shape->key, shape->length) == 0)
+    {
+      sparql_cache_unlink(engine, entry);
+      sparql_cache_push(engine, entry);
+      return entry;
+    }
   }
+  return NULL;
+}
 
-  uint32_t index = engine->triples.count;
-  engine->triples.subject[index] = subject;
-  engine->triples.predicate[index] = predicate;
-  engine->triples.object[index] = object;
-  engine->triples.count++;
+// Take ownership of a freshly parsed template; false if it was not cached
+static bool sparql_cache_insert(SPARQLEngine *engine, const SPARQLShape *shape, SPARQLQuery *query)
+{
+  size_t bytes = sizeof(SPARQLCacheEntry) + shape->length + sizeof(SPARQLQuery);
+  if (bytes > engine->cache.limit)
+    return false;
+
+  // Keep chains short: one bucket per entry
+  if (engine->cache.count + 1 > (engine->cache.buckets ? engine->cache.bucket_mask + 1 : 0))
+  {
+    uint32_t size = engine->cache.buckets ? (engine->cache.bucket_mask + 1) * 2 : 64;
+    SPARQLCacheEntry **buckets = calloc(size, sizeof(SPARQLCacheEntry *));
+    if (!buckets)
+      return false;
+    for (SPARQLCacheEntry *entry = engine->cache.newest; entry; entry = entry->older)
+    {
+      entry->bucket_next = buckets[entry->hash & (size - 1)];
+      buckets[entry->hash & (size - 1)] = entry;
+    }
+    free(engine->cache.buckets);
+    engine->cache.buckets = buckets;
+    engine->cache.bucket_mask = size - 1;
+  }
 
-  // Update indices (80/20: simple linear indexing is sufficient)
-  engine->indices.subject_index[index] = index;
-  engine->indices.predicate_index[index] = index;
-  engine->indices.object_index[index] = index;
+  SPARQLCacheEntry *entry = malloc(sizeof(SPARQLCacheEntry) + shape->length);
+  if (!entry)
+    return false;
+  sparql_cache_trim(engine, engine->cache.limit - bytes);
 
-  uint64_t cycles = cns_get_cycles() - start;
-  cns_assert_cycles(start, 5);
+  entry->query = query;
+  entry->hash = shape->hash;
+  entry->bytes = bytes;
+  entry->key_length = shape->length;
+  memcpy(entry->key, shape->key, shape->length);
+  SPARQLCacheEntry **bucket = &engine->cache.buckets[shape->hash & engine->cache.bucket_mask];
+  entry->bucket_next = *bucket;
+  *bucket = entry;
+  sparql_cache_push(engine, entry);
+  engine->cache.bytes += bytes;
+  engine->cache.count++;
+  return true;
+}
 
-  return CNS_OK;
+// Limit the memory held by cached plans; 0 disables caching
+void cns_sparql_set_cache_limit(SPARQLEngine *engine, size_t bytes)
+{
+  if (engine)
+  {
+    engine->cache.limit = bytes;
+    sparql_cache_trim(engine, bytes);
+  }
+}
+
+// Plan a bound query if needed and evaluate it
+static SPARQLResult *sparql_run(SPARQLEngine *engine, SPARQLQuery *query)
+{
+  SPARQLResult *result = calloc(1, sizeof(SPARQLResult));
+  if (!result)
+  {
+    return NULL;
+  }
+
+  // Plans follow the statistics, so a cached query is replanned after the store changes.
+  // Between rebuilds a template keeps the plan made for the constants it was first run with.
+  if (query->plan_generation != engine->stats.generation && !query->unsatisfiable)
+  {
+    sparql_plan(engine, query, &query->plan);
+    query->plan_generation = engine->stats.generation;
+  }
+  if (query->plan.leapfrog && !query->unsatisfiable && sparql_prepare_leapfrog(engine, query) != CNS_OK)
+  {
+    cns_sparql_free_result(result);
+    return NULL;
+  }
+
+  if (!sparql_evaluate(engine, query, result))
+  {
+    cns_sparql_free_result(result);
+    return NULL;
+  }
+  return result;
 }
 
-// Execute SPARQL query (15 cycles target - 80/20 optimized)
+// Execute SPARQL query
 SPARQLResult *cns_sparql_execute(SPARQLEngine *engine, const char *query)
 {
   uint64_t start = cns_get_cycles();
@@ -131,73 +2901,162 @@ SPARQLResult *cns_sparql_execute(SPARQLEngine *engine, const char *query)
 
   engine->total_queries++;
 
-  // Check cache first (80/20: cache common queries)
-  for (uint32_t i = 0; i < engine->cache.cache_size; i++)
+  if (cns_sparql_build_indexes(engine) != CNS_OK)
+  {
+    return NULL;
+  }
+
+  // Check cache first (80/20: skip parsing and planning of repeated query shapes)
+  SPARQLShape shape;
+  bool normalized = sparql_normalize(engine, query, &shape);
+  SPARQLCacheEntry *entry = normalized ? sparql_cache_find(engine, &shape) : NULL;
+  SPARQLQuery *parsed;
+  SPARQLQuery *fresh = NULL;
+  SPARQLResult *result;
+
+  if (entry)
+  {
+    parsed = entry->query;
+    sparql_bind(parsed, shape.params, shape.unsatisfiable);
+    memcpy(parsed->variables, shape.names.variables, parsed->variable_count * SPARQL_MAX_VARIABLE_NAME);
+    result = sparql_run(engine, parsed);
+    engine->cache_hits++;
+    engine->hit_cycles += cns_get_cycles() - start;
+    SPARQL_TRACK_PERFORMANCE(engine, start);
+    return result;
+  }
+
+  fresh = calloc(1, sizeof(SPARQLQuery));
+  if (!fresh)
+  {
+    return NULL;
+  }
+
+  SPARQLParser parser = {0};
+  parser.cursor = query;
+  parser.engine = engine;
+  parser.query = fresh;
+  if (!sparql_parse_query(&parser))
+  {
+    // Unsupported or malformed query: empty result
+    free(fresh);
+    result = calloc(1, sizeof(SPARQLResult));
+  }
+  else
   {
-    if (engine->cache.query_string[i] && strcmp(engine->cache.query_string[i], query) == 0)
+    parsed = fresh;
+    if (normalized && fresh->param_count == shape.param_count &&
+        fresh->variable_count == shape.names.variable_count && sparql_cache_insert(engine, &shape, fresh))
     {
-      engine->cache_hits++;
-      // Return cached result
-      SPARQLResult *result = malloc(sizeof(SPARQLResult));
-      if (result)
-      {
-        result->count = engine->cache.result_count[i];
-        result->triples = NULL; // Simplified for 80/20
-      }
-      return result;
+      fresh = NULL; // Owned by the cache
     }
+    result = sparql_run(engine, parsed);
+    free(fresh);
   }
 
-  // Parse query (80/20: handle common patterns)
-  SPARQLResult *result = malloc(sizeof(SPARQLResult));
-  if (!result)
+  engine->cache_misses++;
+  engine->miss_cycles += cns_get_cycles() - start;
+  SPARQL_TRACK_PERFORMANCE(engine, start);
+
+  return result;
+}
+
+// Parse a query once for repeated execution with different constants
+SPARQLPrepared *cns_sparql_prepare(SPARQLEngine *engine, const char *query)
+{
+  if (!engine || !query)
   {
     return NULL;
   }
 
-  // Simple pattern matching (80/20: most queries are SELECT ?s ?p ?o)
-  if (strstr(query, "SELECT") && strstr(query, "WHERE"))
+  SPARQLPrepared *prepared = calloc(1, sizeof(SPARQLPrepared));
+  if (!prepared)
   {
-    result->count = engine->triples.count;
-    result->triples = NULL; // Simplified for performance
+    return NULL;
   }
-  else
+
+  SPARQLParser parser = {0};
+  parser.cursor = query;
+  parser.engine = engine;
+  parser.query = &prepared->query;
+  if (!sparql_parse_query(&parser))
+  {
+    free(prepared);
+    return NULL;
+  }
+
+  for (uint32_t i = 0; i < prepared->query.pattern_count; i++)
+  {
+    const SPARQLPattern *pattern = &prepared->query.patterns[i];
+    for (int position = 0; position < 3; position++)
+    {
+      if (!(pattern->var_mask & (1u << position)))
+        prepared->params[pattern->param[position]] = pattern->term[position];
+    }
+  }
+  prepared->unsatisfiable = prepared->query.unsatisfiable;
+  return prepared;
+}
+
+// Constants a prepared statement takes, in textual order
+uint32_t cns_sparql_prepared_params(const SPARQLPrepared *prepared)
+{
+  return prepared ? prepared->query.param_count : 0;
+}
+
+// Execute a prepared statement; the plan is kept until the store changes
+SPARQLResult *cns_sparql_execute_prepared(SPARQLEngine *engine, SPARQLPrepared *prepared, const uint32_t *params)
+{
+  uint64_t start = cns_get_cycles();
+
+  if (!engine || !prepared)
+  {
+    return NULL;
+  }
+
+  engine->total_queries++;
+
+  if (cns_sparql_build_indexes(engine) != CNS_OK)
   {
-    result->count = 0;
-    result->triples = NULL;
+    return NULL;
   }
 
-  // Cache result (80/20: cache up to 64 queries)
-  if (engine->cache.cache_size < 64)
+  if (params)
   {
-    uint32_t cache_index = engine->cache.cache_size;
-    engine->cache.query_string[cache_index] = strdup(query);
-    engine->cache.result_count[cache_index] = result->count;
-    engine->cache.cache_size++;
+    bool unsatisfiable = false;
+    for (uint32_t i = 0; i < prepared->query.param_count; i++)
+      unsatisfiable |= params[i] == 0;
+    sparql_bind(&prepared->query, params, unsatisfiable);
   }
+  else
+  {
+    sparql_bind(&prepared->query, prepared->params, prepared->unsatisfiable);
+  }
+
+  SPARQLResult *result = sparql_run(engine, &prepared->query);
 
-  uint64_t cycles = cns_get_cycles() - start;
-  cns_assert_cycles(start, 15);
+  engine->prepared_executions++;
+  engine->prepared_cycles += cns_get_cycles() - start;
+  SPARQL_TRACK_PERFORMANCE(engine, start);
 
   return result;
 }
 
+// Free a prepared statement
+void cns_sparql_free_prepared(SPARQLPrepared *prepared)
+{
+  free(prepared);
+}
+
 // Free SPARQL result (3 cycles target)
 void cns_sparql_free_result(SPARQLResult *result)
 {
-  uint64_t start = cns_get_cycles();
-
   if (result)
   {
-    if (result->triples)
-    {
-      free(result->triples);
-    }
+    free(result->triples);
+    free(result->bindings);
     free(result);
   }
-
-  uint64_t cycles = cns_get_cycles() - start;
-  cns_assert_cycles(start, 3);
 }
 
 // Get performance statistics
@@ -207,48 +3066,220 @@ SPARQLStats cns_sparql_get_stats(SPARQLEngine *engine)
 
   if (engine)
   {
+    cns_sparql_build_indexes(engine);
     stats.total_queries = engine->total_queries;
+    uint64_t lookups = engine->cache_hits + engine->cache_misses;
     stats.cache_hits = engine->cache_hits;
-    stats.cache_hit_rate = (engine->total_queries > 0) ? (double)engine->cache_hits / engine->total_queries : 0.0;
-    stats.total_triples = engine->triples.count;
+    stats.cache_misses = engine->cache_misses;
+    stats.cache_hit_rate = (lookups > 0) ? (double)engine->cache_hits / lookups : 0.0;
+    stats.cache_entries = engine->cache.count;
+    stats.cache_bytes = engine->cache.bytes;
+    stats.cache_evictions = engine->cache.evictions;
+    stats.avg_hit_cycles = (engine->cache_hits > 0) ? (double)engine->hit_cycles / engine->cache_hits : 0.0;
+    stats.avg_miss_cycles = (engine->cache_misses > 0) ? (double)engine->miss_cycles / engine->cache_misses : 0.0;
+    stats.prepared_executions = engine->prepared_executions;
+    stats.avg_prepared_cycles =
+        (engine->prepared_executions > 0) ? (double)engine->prepared_cycles / engine->prepared_executions : 0.0;
+    stats.total_triples = (uint32_t)engine->triples.count;
     stats.avg_cycles_per_query = (engine->total_queries > 0) ? (double)engine->total_cycles / engine->total_queries : 0.0;
+    stats.distinct_subjects = engine->stats.subjects;
+    stats.distinct_predicates = engine->stats.predicate_count;
+    stats.distinct_objects = engine->stats.objects;
+    stats.characteristic_sets = engine->stats.set_count;
   }
 
   return stats;
 }
 
-// 80/20 optimized triple lookup (3 cycles target)
+// Count triples matching a pattern (index range scan)
 uint32_t cns_sparql_find_triples(SPARQLEngine *engine, uint32_t subject, uint32_t predicate, uint32_t object)
 {
-  uint64_t start = cns_get_cycles();
-
-  if (!engine)
+  if (!engine || cns_sparql_build_indexes(engine) != CNS_OK)
   {
     return 0;
   }
 
-  uint32_t count = 0;
+  uint32_t spo[3] = {subject, predicate, object};
+  uint8_t bound = (uint8_t)((subject != 0) | (predicate != 0) << 1 | (object != 0) << 2);
+
+  int index;
+  size_t count;
+  sparql_range(engine, bound, spo, &index, &count);
+  return (uint32_t)count;
+}
+
+// ---------------------------------------------------------------------------
+// EXPLAIN
+// ---------------------------------------------------------------------------
+
+typedef struct
+{
+  char *data;
+  size_t length;
+  size_t capacity;
+  bool failed;
+} SPARQLText;
+
+static void sparql_text_append(SPARQLText *text, const char *format, ...)
+{
+  if (text->failed)
+    return;
+
+  va_list args;
+  va_start(args, format);
+  int needed = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+  if (needed < 0)
+  {
+    text->failed = true;
+    return;
+  }
+
+  if (text->length + (size_t)needed + 1 > text->capacity)
+  {
+    size_t capacity = text->capacity ? text->capacity : 256;
+    while (capacity < text->length + (size_t)needed + 1)
+      capacity *= 2;
+    char *data = realloc(text->data, capacity);
+    if (!data)
+    {
+      text->failed = true;
+      return;
+    }
+    text->data = data;
+    text->capacity = capacity;
+  }
+
+  va_start(args, format);
+  vsnprintf(text->data + text->length, (size_t)needed + 1, format, args);
+  va_end(args);
+  text->length += (size_t)needed;
+}
+
+static void sparql_text_term(SPARQLText *text, const SPARQLEngine *engine, const SPARQLQuery *query,
+                             const SPARQLPattern *pattern, int position)
+{
+  uint32_t term = pattern->term[position];
+  if (pattern->var_mask & (1u << position))
+  {
+    sparql_text_append(text, "?%s", query->variables[term]);
+    return;
+  }
+  const char *string = cns_sparql_term(engine, term);
+  if (string)
+    sparql_text_append(text, "%s", string);
+  else
+    sparql_text_append(text, "%u", term);
+}
+
+// Describe the plan chosen for a query
+char *cns_sparql_explain(SPARQLEngine *engine, const char *query)
+{
+  static const char *method_names[] = {"scan", "index-join", "hash-join", "leapfrog"};
+  static const char *index_names[] = {"SPO", "POS", "OSP", "PSO", "OPS", "SOP"};
+
+  if (!engine || !query || cns_sparql_build_indexes(engine) != CNS_OK)
+  {
+    return NULL;
+  }
+
+  SPARQLQuery *parsed = calloc(1, sizeof(SPARQLQuery));
+  if (!parsed)
+  {
+    return NULL;
+  }
+  SPARQLParser parser = {0};
+  parser.cursor = query;
+  parser.engine = engine;
+  parser.query = parsed;
+  if (!sparql_parse_query(&parser))
+  {
+    free(parsed);
+    return NULL;
+  }
 
-  // Simple linear search (80/20: sufficient for small datasets)
-  for (uint32_t i = 0; i < engine->triples.count; i++)
+  SPARQLText text = {0};
+  if (parsed->unsatisfiable || engine->triples.count == 0)
   {
-    bool match = true;
+    sparql_text_append(&text, "Plan: empty result (%s)\n",
+                       parsed->unsatisfiable ? "a constant is not in the dictionary" : "no triples");
+  }
+  else
+  {
+    sparql_plan(engine, parsed, &parsed->plan);
+    uint32_t steps = parsed->pattern_count;
+    SPARQLPlan *plan = &parsed->plan;
+    if (plan->leapfrog)
+    {
+      sparql_text_append(&text, "Plan: %u patterns, leapfrog triejoin, estimated %.0f rows\n  Variable order:", steps,
+                         plan->result_rows);
+      for (uint32_t i = 0; i < parsed->variable_count; i++)
+        sparql_text_append(&text, " ?%s", parsed->variables[plan->variable_order[i]]);
+      sparql_text_append(&text, "\n");
+    }
+    else
+    {
+      sparql_text_append(&text, "Plan: %u pattern%s, estimated %.0f rows, cost %.0f\n", steps, steps == 1 ? "" : "s",
+                         plan->result_rows, plan->cost);
+    }
 
-    if (subject != 0 && engine->triples.subject[i] != subject)
-      match = false;
-    if (predicate != 0 && engine->triples.predicate[i] != predicate)
-      match = false;
-    if (object != 0 && engine->triples.object[i] != object)
-      match = false;
+    uint8_t rank[SPARQL_MAX_VARIABLES];
+    for (uint32_t i = 0; i < parsed->variable_count; i++)
+      rank[plan->variable_order[i]] = (uint8_t)i;
 
-    if (match)
+    uint32_t bound_vars = 0;
+    for (uint32_t i = 0; i < steps; i++)
     {
-      count++;
+      const SPARQLPattern *pattern = &parsed->patterns[parsed->plan.order[i]];
+      uint8_t method = parsed->plan.method[i];
+
+      // Index the step's range is read from
+      uint32_t spo[3] = {0, 0, 0};
+      uint8_t bound = 0;
+      for (int position = 0; position < 3; position++)
+      {
+        bool variable = pattern->var_mask & (1u << position);
+        if (!variable || (method == SPARQL_JOIN_INDEX_NESTED_LOOP && (bound_vars & (1u << pattern->term[position]))))
+          bound |= (uint8_t)(1u << position);
+      }
+      SPARQLKey probe;
+      int prefix;
+      uint8_t constants;
+      int index = method == SPARQL_JOIN_LEAPFROG ? sparql_trie_permutation(pattern, rank, &constants)
+                                                 : sparql_select_index(bound, spo, &probe, &prefix);
+
+      sparql_text_append(&text, "  %u. %-10s ", i + 1, method_names[method]);
+      for (int position = 0; position < 3; position++)
+      {
+        sparql_text_term(&text, engine, parsed, pattern, position);
+        sparql_text_append(&text, position < 2 ? " " : "");
+      }
+      sparql_text_append(&text, "  [%s, estimated %.0f %s]\n", index_names[index], plan->rows[i],
+                         method == SPARQL_JOIN_LEAPFROG ? "triples" : "rows");
+
+      for (int position = 0; position < 3; position++)
+      {
+        if (pattern->var_mask & (1u << position))
+          bound_vars |= 1u << pattern->term[position];
+      }
     }
   }
 
-  uint64_t cycles = cns_get_cycles() - start;
-  cns_assert_cycles(start, 3);
+  free(parsed);
+  if (text.failed)
+  {
+    free(text.data);
+    return NULL;
+  }
+  return text.data;
+}
 
-  return count;
-}
\ No newline at end of file
+// Allow or forbid the leapfrog triejoin for cyclic patterns
+void cns_sparql_set_leapfrog(SPARQLEngine *engine, bool enabled)
+{
+  if (engine && engine->leapfrog != enabled)
+  {
+    engine->leapfrog = enabled;
+    engine->stats.generation++; // Replan cached queries
+  }
+}
@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <time.h>
+#include <pthread.h>
 
 // Global telemetry context
 static CNSTelemetryContext global_context;
@@ -58,30 +59,787 @@ int cns_telemetry_is_enabled(CNSTelemetryContext *ctx)
   return ctx ? ctx->enabled : 0;
 }
 
-// Span management (7-tick optimized)
-CNSTelemetrySpan *cns_telemetry_create_span(CNSTelemetryContext *ctx, const char *name, const char *operation, uint8_t kind)
+// ============================================================================
+// Per-thread span pool and SPSC export rings
+// ============================================================================
+
+// Cycle counter used on the hot path; nanoseconds are derived off the hot path
+static inline uint64_t telemetry_cycles(void)
 {
-  if (!ctx || !ctx->enabled)
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return __builtin_readcyclecounter();
+#endif
+}
+
+#define TELEMETRY_POOL_MASK (CNS_TELEMETRY_POOL_SIZE - 1)
+#define TELEMETRY_COUNTER_INC(field) \
+  __atomic_store_n(&(field), (field) + 1, __ATOMIC_RELAXED)
+
+// Single-producer/single-consumer ring of span pointers. Capacity equals the
+// pool size, so a ring can hold every span its pool owns and never overflows.
+typedef struct
+{
+  uint32_t tail __attribute__((aligned(64))); // Producer cursor
+  uint32_t cached_head;                       // Producer's view of head
+  uint32_t head __attribute__((aligned(64))); // Consumer cursor
+  uint32_t cached_tail;                       // Consumer's view of tail
+  CNSTelemetrySpan *slots[CNS_TELEMETRY_POOL_SIZE] __attribute__((aligned(64)));
+} TelemetrySpanRing;
+
+typedef struct
+{
+  TelemetrySpanRing finished; // Owner thread -> exporter
+  TelemetrySpanRing recycled; // Exporter -> owner thread
+  // Spans ended on other threads: an MPSC stack of slots linked through
+  // remote_next, pushed with CAS and taken whole by the owner
+  uint32_t remote_head __attribute__((aligned(64))); // Slot + 1, 0 = empty
+  uint16_t remote_next[CNS_TELEMETRY_POOL_SIZE];
+  uint64_t spans_remote;       // Pushed by any thread
+  CNSTelemetrySpan spans[CNS_TELEMETRY_POOL_SIZE];
+  uint16_t free_stack[CNS_TELEMETRY_POOL_SIZE];
+  uint32_t free_top;
+  CNSTelemetryContext context; // Thread-local span stack
+  uint64_t spans_recorded;     // Written by owner
+  uint64_t spans_dropped;      // Written by owner
+  uint64_t spans_exported;     // Written by exporter
+  uint64_t spans_sampled_out;  // Written by owner
+  uint32_t sample_countdown;   // Head sampling: spans until the next kept one
+  uint32_t retired;            // Owner exited; the exporter finishes and frees the pool
+  uint8_t id;                  // Registry index + 1
+} TelemetrySpanPool;
+
+// Slots are taken under pool_registry_lock and released when a retired pool
+// is freed; pool_count is the high-water mark readers scan up to
+static TelemetrySpanPool *pool_registry[CNS_TELEMETRY_MAX_THREADS];
+static uint32_t pool_count = 0;
+static pthread_mutex_t pool_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t pool_key;
+static pthread_once_t pool_key_once = PTHREAD_ONCE_INIT;
+static __thread TelemetrySpanPool *tls_pool = NULL;
+static __thread uint8_t tls_pool_unavailable = 0;
+static uint64_t heap_fallbacks = 0;
+static CNSTelemetryPoolStats retired_totals; // Counters of freed pools, under exporter_lock
+
+// Exporter state - one background consumer for all rings
+static CNSTelemetryExportFn exporter_fn = NULL;
+static void *exporter_user_data = NULL;
+static pthread_t exporter_thread;
+static pthread_mutex_t exporter_lock = PTHREAD_MUTEX_INITIALIZER;
+static int exporter_running = 0;
+static int exporter_attached = 0;
+
+// Sampling configuration - read with relaxed loads on the hot path
+static uint32_t sample_every = 0;
+static uint64_t sample_tail_cycles = 0;
+
+// Cycle -> nanosecond conversion, calibrated once
+static pthread_once_t calibrate_once = PTHREAD_ONCE_INIT;
+static double ns_per_cycle = 1.0;
+static uint64_t anchor_cycles = 0;
+static uint64_t anchor_ns = 0;
+
+static void telemetry_calibrate(void)
+{
+  uint64_t n0 = cns_telemetry_get_nanoseconds();
+  uint64_t c0 = telemetry_cycles();
+  uint64_t n1 = n0;
+  while (n1 - n0 < 200000) // 200us is enough for a stable ratio
+  {
+    n1 = cns_telemetry_get_nanoseconds();
+  }
+  uint64_t c1 = telemetry_cycles();
+
+  ns_per_cycle = c1 > c0 ? (double)(n1 - n0) / (double)(c1 - c0) : 1.0;
+  anchor_cycles = c0;
+  anchor_ns = n0;
+}
+
+static inline uint64_t telemetry_cycles_to_ns(uint64_t cycles)
+{
+  pthread_once(&calibrate_once, telemetry_calibrate);
+  int64_t delta = (int64_t)(cycles - anchor_cycles);
+  return anchor_ns + (uint64_t)((double)delta * ns_per_cycle);
+}
+
+// Fill nanosecond timestamps from the cycle timestamps taken on the hot path
+static void telemetry_span_resolve_times(CNSTelemetrySpan *span)
+{
+  if (span->start_time_ns == 0 && span->start_cycles != 0)
+  {
+    span->start_time_ns = telemetry_cycles_to_ns(span->start_cycles);
+  }
+  if (span->end_time_ns == 0 && span->end_cycles != 0)
+  {
+    span->end_time_ns = telemetry_cycles_to_ns(span->end_cycles);
+  }
+}
+
+static inline int ring_push(TelemetrySpanRing *ring, CNSTelemetrySpan *span)
+{
+  uint32_t tail = ring->tail;
+  if (UNLIKELY(tail - ring->cached_head >= CNS_TELEMETRY_POOL_SIZE))
+  {
+    ring->cached_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (tail - ring->cached_head >= CNS_TELEMETRY_POOL_SIZE)
+      return 0;
+  }
+  ring->slots[tail & TELEMETRY_POOL_MASK] = span;
+  __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+static inline CNSTelemetrySpan *ring_pop(TelemetrySpanRing *ring)
+{
+  uint32_t head = ring->head;
+  if (head == ring->cached_tail)
+  {
+    ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head == ring->cached_tail)
+      return NULL;
+  }
+  CNSTelemetrySpan *span = ring->slots[head & TELEMETRY_POOL_MASK];
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+  return span;
+}
+
+// Thread exit: hand the pool to the exporter, which finishes its spans and
+// frees it once every span is back. Without a running exporter, drain here.
+static void telemetry_pool_retire(void *arg)
+{
+  TelemetrySpanPool *pool = arg;
+  tls_pool = NULL;
+  tls_pool_unavailable = 1; // Later destructors fall back to the heap
+  __atomic_store_n(&pool->retired, 1, __ATOMIC_RELEASE);
+
+  if (!__atomic_load_n(&exporter_running, __ATOMIC_ACQUIRE))
+    cns_telemetry_exporter_drain();
+}
+
+static void telemetry_pool_key_create(void)
+{
+  pthread_key_create(&pool_key, telemetry_pool_retire);
+}
+
+// Cold path: allocate and register this thread's pool
+static TelemetrySpanPool *telemetry_pool_create(void)
+{
+  pthread_once(&calibrate_once, telemetry_calibrate);
+  pthread_once(&pool_key_once, telemetry_pool_key_create);
+
+  TelemetrySpanPool *pool = aligned_alloc(64, sizeof(TelemetrySpanPool));
+  if (!pool)
+  {
+    tls_pool_unavailable = 1;
+    return NULL;
+  }
+
+  // Lowest slot not held by a live or still draining pool
+  pthread_mutex_lock(&pool_registry_lock);
+  uint32_t index = 0;
+  while (index < CNS_TELEMETRY_MAX_THREADS && pool_registry[index])
+    index++;
+  if (index == CNS_TELEMETRY_MAX_THREADS)
+  {
+    pthread_mutex_unlock(&pool_registry_lock);
+    free(pool);
+    tls_pool_unavailable = 1;
+    return NULL;
+  }
+
+  memset(pool, 0, sizeof(TelemetrySpanPool));
+  pool->id = (uint8_t)(index + 1);
+  for (uint32_t i = 0; i < CNS_TELEMETRY_POOL_SIZE; i++)
+  {
+    pool->spans[i].pool_id = pool->id;
+    pool->spans[i].pool_slot = (uint16_t)i;
+    pool->free_stack[i] = (uint16_t)(CNS_TELEMETRY_POOL_SIZE - 1 - i);
+  }
+  pool->free_top = CNS_TELEMETRY_POOL_SIZE;
+  cns_telemetry_init_context(&pool->context);
+
+  __atomic_store_n(&pool_registry[index], pool, __ATOMIC_RELEASE);
+  if (index >= pool_count)
+    __atomic_store_n(&pool_count, index + 1, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&pool_registry_lock);
+
+  pthread_setspecific(pool_key, pool);
+  tls_pool = pool;
+  return pool;
+}
+
+static inline TelemetrySpanPool *telemetry_pool_get(void)
+{
+  if (LIKELY(tls_pool != NULL))
+    return tls_pool;
+  if (tls_pool_unavailable)
+    return NULL;
+  return telemetry_pool_create();
+}
+
+// ============================================================================
+// Log-linear cycle histograms
+// ============================================================================
+
+#define TELEMETRY_HIST_SUB_MASK (CNS_HISTOGRAM_SUB_COUNT - 1)
+#define TELEMETRY_HIST_CACHE 16
+
+// One thread's histograms. Only the owner writes; readers merge all threads.
+typedef struct
+{
+  uint64_t *counts[CNS_TELEMETRY_MAX_HISTOGRAMS]; // Allocated on first record
+  uint64_t sum[CNS_TELEMETRY_MAX_HISTOGRAMS];
+  uint64_t min[CNS_TELEMETRY_MAX_HISTOGRAMS];
+  uint64_t max[CNS_TELEMETRY_MAX_HISTOGRAMS];
+  uint64_t violations[CNS_TELEMETRY_MAX_HISTOGRAMS];
+  const char *cache_key[TELEMETRY_HIST_CACHE]; // Name pointer -> id memo
+  int cache_id[TELEMETRY_HIST_CACHE];          // -1 caches a miss (name table full)
+  uint64_t cache_hash[TELEMETRY_HIST_CACHE];   // Name hash, checked on cached misses
+  int orphaned;                                // Owner exited; next new thread adopts it
+} TelemetryHistogramSet;
+
+static const char *hist_names[CNS_TELEMETRY_MAX_HISTOGRAMS];
+static uint32_t hist_name_count = 0;
+static pthread_mutex_t hist_name_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Sets are never freed: their counts stay part of every summary. A set whose
+// thread exited is handed to the next thread that needs one.
+static TelemetryHistogramSet *hist_registry[CNS_TELEMETRY_MAX_THREADS];
+static uint32_t hist_set_count = 0;
+static pthread_mutex_t hist_set_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t hist_key;
+static pthread_once_t hist_key_once = PTHREAD_ONCE_INIT;
+static __thread TelemetryHistogramSet *tls_hist = NULL;
+static __thread uint8_t tls_hist_unavailable = 0;
+
+// v < 16 maps linearly; above that, bucket = (exponent, top 4 mantissa bits)
+static inline uint32_t histogram_bucket(uint64_t value)
+{
+  if (value < CNS_HISTOGRAM_SUB_COUNT)
+    return (uint32_t)value;
+  uint32_t exponent = 63 - (uint32_t)__builtin_clzll(value);
+  uint32_t shift = exponent - CNS_HISTOGRAM_SUB_BITS;
+  return ((shift + 1) << CNS_HISTOGRAM_SUB_BITS) |
+         (uint32_t)((value >> shift) & TELEMETRY_HIST_SUB_MASK);
+}
+
+// Highest value that maps to a bucket, so reported percentiles never understate
+static inline uint64_t histogram_bucket_upper(uint32_t bucket)
+{
+  if (bucket < CNS_HISTOGRAM_SUB_COUNT)
+    return bucket;
+  uint32_t shift = (bucket >> CNS_HISTOGRAM_SUB_BITS) - 1;
+  uint64_t lower = (uint64_t)(CNS_HISTOGRAM_SUB_COUNT | (bucket & TELEMETRY_HIST_SUB_MASK)) << shift;
+  return lower + ((1ULL << shift) - 1);
+}
+
+static void telemetry_hist_orphan(void *arg)
+{
+  TelemetryHistogramSet *set = arg;
+  tls_hist = NULL;
+  tls_hist_unavailable = 1;
+  pthread_mutex_lock(&hist_set_lock);
+  set->orphaned = 1;
+  pthread_mutex_unlock(&hist_set_lock);
+}
+
+static void telemetry_hist_key_create(void)
+{
+  pthread_key_create(&hist_key, telemetry_hist_orphan);
+}
+
+static TelemetryHistogramSet *telemetry_hist_create(void)
+{
+  pthread_once(&hist_key_once, telemetry_hist_key_create);
+
+  pthread_mutex_lock(&hist_set_lock);
+  TelemetryHistogramSet *set = NULL;
+  uint32_t count = hist_set_count;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (hist_registry[i]->orphaned)
+    {
+      set = hist_registry[i];
+      set->orphaned = 0;
+      break;
+    }
+  }
+
+  if (!set && count < CNS_TELEMETRY_MAX_THREADS)
+  {
+    set = calloc(1, sizeof(TelemetryHistogramSet));
+    if (set)
+    {
+      for (uint32_t i = 0; i < CNS_TELEMETRY_MAX_HISTOGRAMS; i++)
+      {
+        set->min[i] = UINT64_MAX;
+      }
+      __atomic_store_n(&hist_registry[count], set, __ATOMIC_RELEASE);
+      __atomic_store_n(&hist_set_count, count + 1, __ATOMIC_RELEASE);
+    }
+  }
+  pthread_mutex_unlock(&hist_set_lock);
+
+  if (!set)
+  {
+    tls_hist_unavailable = 1;
+    return NULL;
+  }
+
+  pthread_setspecific(hist_key, set);
+  tls_hist = set;
+  return set;
+}
+
+static inline TelemetryHistogramSet *telemetry_hist_get(void)
+{
+  if (LIKELY(tls_hist != NULL))
+    return tls_hist;
+  if (tls_hist_unavailable)
     return NULL;
+  return telemetry_hist_create();
+}
+
+// Names are registered once; ids are stable for the life of the process
+int cns_telemetry_histogram_id(const char *name)
+{
+  if (!name)
+    return -1;
+
+  uint32_t count = __atomic_load_n(&hist_name_count, __ATOMIC_ACQUIRE);
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (strcmp(hist_names[i], name) == 0)
+      return (int)i;
+  }
+  if (count == CNS_TELEMETRY_MAX_HISTOGRAMS)
+    return -1; // Full for good; no need to lock
+
+  pthread_mutex_lock(&hist_name_lock);
+  int id = -1;
+  count = hist_name_count;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    if (strcmp(hist_names[i], name) == 0)
+    {
+      id = (int)i;
+      break;
+    }
+  }
+  if (id < 0 && count < CNS_TELEMETRY_MAX_HISTOGRAMS)
+  {
+    hist_names[count] = strdup(name);
+    if (hist_names[count])
+    {
+      id = (int)count;
+      __atomic_store_n(&hist_name_count, count + 1, __ATOMIC_RELEASE);
+    }
+  }
+  pthread_mutex_unlock(&hist_name_lock);
+  return id;
+}
+
+static inline uint64_t telemetry_name_hash(const char *name)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  while (*name)
+  {
+    hash ^= (uint8_t)*name++;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Callers mostly pass string literals, so the pointer is a good per-thread
+// cache key. A hit is still checked against the name: the pointer may be a
+// reused buffer, or a stale key in a set adopted from an exited thread.
+static inline int telemetry_hist_lookup(TelemetryHistogramSet *set, const char *name)
+{
+  uint32_t slot = (uint32_t)(((uintptr_t)name >> 3) & (TELEMETRY_HIST_CACHE - 1));
+  if (LIKELY(set->cache_key[slot] == name))
+  {
+    int id = set->cache_id[slot];
+    if (id >= 0 ? strcmp(hist_names[id], name) == 0
+                : set->cache_hash[slot] == telemetry_name_hash(name))
+      return id;
+  }
+
+  // Misses are cached too: once the name table is full they are permanent
+  int id = cns_telemetry_histogram_id(name);
+  set->cache_key[slot] = name;
+  set->cache_id[slot] = id;
+  if (id < 0)
+    set->cache_hash[slot] = telemetry_name_hash(name);
+  return id;
+}
+
+static inline void telemetry_hist_store(uint64_t *field, uint64_t value)
+{
+  __atomic_store_n(field, value, __ATOMIC_RELAXED);
+}
+
+static void telemetry_hist_record(TelemetryHistogramSet *set, int id, uint64_t cycles)
+{
+  uint64_t *counts = set->counts[id];
+  if (UNLIKELY(!counts))
+  {
+    counts = calloc(CNS_HISTOGRAM_BUCKETS, sizeof(uint64_t));
+    if (!counts)
+      return;
+    __atomic_store_n(&set->counts[id], counts, __ATOMIC_RELEASE);
+  }
+
+  uint32_t bucket = histogram_bucket(cycles);
+  telemetry_hist_store(&counts[bucket], counts[bucket] + 1);
+  telemetry_hist_store(&set->sum[id], set->sum[id] + cycles);
+  if (cycles < set->min[id])
+    telemetry_hist_store(&set->min[id], cycles);
+  if (cycles > set->max[id])
+    telemetry_hist_store(&set->max[id], cycles);
+}
+
+void cns_telemetry_histogram_record_id(int id, uint64_t cycles)
+{
+  if (id < 0 || id >= CNS_TELEMETRY_MAX_HISTOGRAMS)
+    return;
+  TelemetryHistogramSet *set = telemetry_hist_get();
+  if (set)
+    telemetry_hist_record(set, id, cycles);
+}
+
+void cns_telemetry_histogram_record(const char *name, uint64_t cycles)
+{
+  if (!name)
+    return;
+  TelemetryHistogramSet *set = telemetry_hist_get();
+  if (!set)
+    return;
+  int id = telemetry_hist_lookup(set, name);
+  if (id >= 0)
+    telemetry_hist_record(set, id, cycles);
+}
+
+static void telemetry_hist_record_violation(const char *name, uint64_t cycles)
+{
+  TelemetryHistogramSet *set = telemetry_hist_get();
+  if (!set)
+    return;
+  int id = telemetry_hist_lookup(set, name);
+  if (id < 0)
+    return;
+  telemetry_hist_record(set, id, cycles);
+  telemetry_hist_store(&set->violations[id], set->violations[id] + 1);
+}
+
+uint32_t cns_telemetry_histogram_count(void)
+{
+  return __atomic_load_n(&hist_name_count, __ATOMIC_ACQUIRE);
+}
+
+int cns_telemetry_histogram_summary_at(uint32_t id, CNSTelemetryHistogramSummary *summary)
+{
+  if (!summary || id >= cns_telemetry_histogram_count())
+    return -1;
+
+  memset(summary, 0, sizeof(*summary));
+  summary->name = hist_names[id];
+  summary->min_cycles = UINT64_MAX;
+
+  uint64_t *merged = calloc(CNS_HISTOGRAM_BUCKETS, sizeof(uint64_t));
+  if (!merged)
+    return -1;
+
+  uint64_t sum = 0;
+  uint32_t sets = __atomic_load_n(&hist_set_count, __ATOMIC_ACQUIRE);
+  if (sets > CNS_TELEMETRY_MAX_THREADS)
+    sets = CNS_TELEMETRY_MAX_THREADS;
+
+  for (uint32_t t = 0; t < sets; t++)
+  {
+    TelemetryHistogramSet *set = __atomic_load_n(&hist_registry[t], __ATOMIC_ACQUIRE);
+    if (!set)
+      continue;
+
+    summary->violations += __atomic_load_n(&set->violations[id], __ATOMIC_RELAXED);
+    uint64_t *counts = __atomic_load_n(&set->counts[id], __ATOMIC_ACQUIRE);
+    if (!counts)
+      continue;
+
+    for (uint32_t b = 0; b < CNS_HISTOGRAM_BUCKETS; b++)
+    {
+      merged[b] += __atomic_load_n(&counts[b], __ATOMIC_RELAXED);
+    }
+    sum += __atomic_load_n(&set->sum[id], __ATOMIC_RELAXED);
+    uint64_t lo = __atomic_load_n(&set->min[id], __ATOMIC_RELAXED);
+    uint64_t hi = __atomic_load_n(&set->max[id], __ATOMIC_RELAXED);
+    if (lo < summary->min_cycles)
+      summary->min_cycles = lo;
+    if (hi > summary->max_cycles)
+      summary->max_cycles = hi;
+  }
+
+  // Bucket counts are the source of truth for the total
+  for (uint32_t b = 0; b < CNS_HISTOGRAM_BUCKETS; b++)
+  {
+    summary->count += merged[b];
+  }
+
+  if (summary->count == 0)
+  {
+    summary->min_cycles = 0;
+    free(merged);
+    return 0;
+  }
+
+  summary->avg_cycles = (double)sum / (double)summary->count;
+
+  const double quantiles[5] = {0.50, 0.90, 0.95, 0.99, 0.999};
+  uint64_t *targets[5] = {&summary->p50, &summary->p90, &summary->p95,
+                          &summary->p99, &summary->p999};
+  uint64_t seen = 0;
+  uint32_t q = 0;
+  for (uint32_t b = 0; b < CNS_HISTOGRAM_BUCKETS && q < 5; b++)
+  {
+    seen += merged[b];
+    while (q < 5 && seen > 0 &&
+           (double)seen >= quantiles[q] * (double)summary->count)
+    {
+      uint64_t upper = histogram_bucket_upper(b);
+      *targets[q++] = upper < summary->max_cycles ? upper : summary->max_cycles;
+    }
+  }
+
+  free(merged);
+  return 0;
+}
+
+int cns_telemetry_histogram_summary(const char *name, CNSTelemetryHistogramSummary *summary)
+{
+  int id = cns_telemetry_histogram_id(name);
+  if (id < 0)
+    return -1;
+  return cns_telemetry_histogram_summary_at((uint32_t)id, summary);
+}
+
+void cns_telemetry_histogram_reset(const char *name)
+{
+  int id = cns_telemetry_histogram_id(name);
+  if (id < 0)
+    return;
 
+  uint32_t sets = __atomic_load_n(&hist_set_count, __ATOMIC_ACQUIRE);
+  if (sets > CNS_TELEMETRY_MAX_THREADS)
+    sets = CNS_TELEMETRY_MAX_THREADS;
+
+  for (uint32_t t = 0; t < sets; t++)
+  {
+    TelemetryHistogramSet *set = __atomic_load_n(&hist_registry[t], __ATOMIC_ACQUIRE);
+    if (!set)
+      continue;
+    if (set->counts[id])
+      memset(set->counts[id], 0, CNS_HISTOGRAM_BUCKETS * sizeof(uint64_t));
+    set->sum[id] = 0;
+    set->min[id] = UINT64_MAX;
+    set->max[id] = 0;
+    set->violations[id] = 0;
+  }
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+void cns_telemetry_set_sampling(const CNSTelemetrySamplingConfig *config)
+{
+  uint32_t every = config ? config->head_sample_every : 0;
+  uint64_t tail = config ? config->tail_threshold_cycles : 0;
+  __atomic_store_n(&sample_every, every, __ATOMIC_RELAXED);
+  __atomic_store_n(&sample_tail_cycles, tail, __ATOMIC_RELAXED);
+}
+
+// Head decision, made when the span starts. Unsampled spans are still
+// created when tail sampling may keep them; otherwise they are skipped.
+static inline int telemetry_head_sample(TelemetrySpanPool *pool, uint8_t *sampled)
+{
+  uint32_t every = __atomic_load_n(&sample_every, __ATOMIC_RELAXED);
+  if (LIKELY(every <= 1) || !pool)
+  {
+    *sampled = 1;
+    return 1;
+  }
+
+  if (pool->sample_countdown == 0)
+  {
+    pool->sample_countdown = every - 1;
+    *sampled = 1;
+    return 1;
+  }
+  pool->sample_countdown--;
+  *sampled = 0;
+
+  if (__atomic_load_n(&sample_tail_cycles, __ATOMIC_RELAXED) != 0)
+    return 1;
+
+  TELEMETRY_COUNTER_INC(pool->spans_sampled_out);
+  return 0;
+}
+
+static void telemetry_span_retire(TelemetrySpanPool *pool, CNSTelemetrySpan *span);
+
+// Any thread: hand a span ended off its owning thread back to the owner
+static void telemetry_remote_push(TelemetrySpanPool *pool, CNSTelemetrySpan *span)
+{
+  // Counted first: once the span is published a retired pool may be freed
+  __atomic_fetch_add(&pool->spans_remote, 1, __ATOMIC_RELAXED);
+  uint32_t head = __atomic_load_n(&pool->remote_head, __ATOMIC_RELAXED);
+  do
+  {
+    pool->remote_next[span->pool_slot] = (uint16_t)head;
+  } while (!__atomic_compare_exchange_n(&pool->remote_head, &head, span->pool_slot + 1u, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+// Owner thread: finish spans other threads returned. Taking the whole list
+// with one exchange means pushes never race a pop, so there is no ABA.
+static void telemetry_remote_drain(TelemetrySpanPool *pool)
+{
+  uint32_t head = __atomic_exchange_n(&pool->remote_head, 0, __ATOMIC_ACQUIRE);
+  while (head != 0)
+  {
+    uint16_t slot = (uint16_t)(head - 1);
+    head = pool->remote_next[slot];
+    telemetry_span_retire(pool, &pool->spans[slot]);
+  }
+}
+
+static CNSTelemetrySpan *telemetry_span_acquire(CNSTelemetryContext *ctx)
+{
+  TelemetrySpanPool *pool = telemetry_pool_get();
+
+  if (LIKELY(pool != NULL))
+  {
+    if (UNLIKELY(__atomic_load_n(&pool->remote_head, __ATOMIC_RELAXED) != 0))
+    {
+      telemetry_remote_drain(pool);
+    }
+    if (UNLIKELY(pool->free_top == 0))
+    {
+      // Take back spans the exporter has finished with
+      CNSTelemetrySpan *recycled;
+      while ((recycled = ring_pop(&pool->recycled)) != NULL)
+      {
+        pool->free_stack[pool->free_top++] = recycled->pool_slot;
+      }
+    }
+    if (LIKELY(pool->free_top > 0))
+    {
+      return &pool->spans[pool->free_stack[--pool->free_top]];
+    }
+
+    // Exporter is behind: shed load instead of allocating on the hot path
+    TELEMETRY_COUNTER_INC(pool->spans_dropped);
+    return NULL;
+  }
+
+  // No pool for this thread (registry full) - fall back to the heap
   CNSTelemetrySpan *span = malloc(sizeof(CNSTelemetrySpan));
   if (!span)
     return NULL;
+  span->pool_id = 0;
+  span->pool_slot = 0;
+  ctx->memory_usage += sizeof(CNSTelemetrySpan);
+  __atomic_fetch_add(&heap_fallbacks, 1, __ATOMIC_RELAXED);
+  return span;
+}
+
+static void telemetry_span_release(CNSTelemetrySpan *span)
+{
+  if (UNLIKELY(span->pool_id == 0))
+  {
+    free(span);
+    return;
+  }
+
+  TelemetrySpanPool *pool = tls_pool;
+  if (UNLIKELY(!pool || pool->id != span->pool_id))
+  {
+    // Ended off the owning thread: the owner finishes it on its next acquire
+    telemetry_remote_push(__atomic_load_n(&pool_registry[span->pool_id - 1], __ATOMIC_ACQUIRE),
+                          span);
+    return;
+  }
+
+  telemetry_span_retire(pool, span);
+}
+
+// Owner thread: record, sample and export or recycle a finished span
+static void telemetry_span_retire(TelemetrySpanPool *pool, CNSTelemetrySpan *span)
+{
+  TELEMETRY_COUNTER_INC(pool->spans_recorded);
 
-  span->span_id = cns_telemetry_generate_span_id();
+  if (span->end_cycles != 0 && span->name)
+  {
+    cns_telemetry_histogram_record(span->name, span->end_cycles - span->start_cycles);
+  }
+
+  if (UNLIKELY(!span->sampled) &&
+      span->end_cycles - span->start_cycles < __atomic_load_n(&sample_tail_cycles, __ATOMIC_RELAXED))
+  {
+    // Fast and not head-sampled: counted in the histogram, never exported
+    TELEMETRY_COUNTER_INC(pool->spans_sampled_out);
+    pool->free_stack[pool->free_top++] = span->pool_slot;
+    return;
+  }
+
+  if (LIKELY(__atomic_load_n(&exporter_attached, __ATOMIC_RELAXED)) &&
+      LIKELY(ring_push(&pool->finished, span)))
+  {
+    return;
+  }
+
+  // No exporter attached - recycle in place
+  pool->free_stack[pool->free_top++] = span->pool_slot;
+}
+
+static inline void telemetry_span_init(CNSTelemetrySpan *span, CNSTelemetryContext *ctx,
+                                       const char *name, const char *operation, uint8_t kind,
+                                       uint8_t sampled)
+{
+  // Pooled spans take ids from their own thread, avoiding a shared counter
+  span->span_id = span->pool_id
+                      ? ((uint64_t)span->pool_id << 56) | tls_pool->context.next_span_id++
+                      : cns_telemetry_generate_span_id();
   span->trace_id = ctx->next_trace_id;
   span->parent_span_id = ctx->current_span ? ctx->current_span->span_id : 0;
-  span->start_time_ns = cns_telemetry_get_nanoseconds();
-  span->end_time_ns = 0; // Active span
+  span->start_cycles = telemetry_cycles();
+  span->end_cycles = 0; // Active span
+  span->start_time_ns = 0;
+  span->end_time_ns = 0;
   span->name = name;
   span->operation = operation;
   span->attributes_count = 0;
   span->events_count = 0;
   span->status = CNS_TELEMETRY_STATUS_UNSET;
   span->kind = kind;
+  span->sampled = sampled;
+}
 
-  ctx->memory_usage += sizeof(CNSTelemetrySpan);
+// Span management (7-tick optimized)
+CNSTelemetrySpan *cns_telemetry_create_span(CNSTelemetryContext *ctx, const char *name, const char *operation, uint8_t kind)
+{
+  if (!ctx || !ctx->enabled)
+    return NULL;
 
+  uint8_t sampled;
+  if (!telemetry_head_sample(telemetry_pool_get(), &sampled))
+    return NULL;
+
+  CNSTelemetrySpan *span = telemetry_span_acquire(ctx);
+  if (!span)
+    return NULL;
+
+  telemetry_span_init(span, ctx, name, operation, kind, sampled);
   return span;
 }
 
@@ -104,7 +862,7 @@ void cns_telemetry_end_span(CNSTelemetryContext *ctx, CNSTelemetrySpan *span, ui
   if (!ctx || !ctx->enabled || !span)
     return;
 
-  span->end_time_ns = cns_telemetry_get_nanoseconds();
+  span->end_cycles = telemetry_cycles();
   span->status = status;
 
   // Optimized stack pop for 7-tick performance
@@ -126,65 +884,272 @@ void cns_telemetry_free_span(CNSTelemetrySpan *span)
 {
   if (span)
   {
-    free(span);
+    telemetry_span_release(span);
   }
 }
 
-// Convenience functions
+// Convenience functions - span stack is per thread, enable flag is global
 CNSTelemetrySpan *cns_telemetry_span_begin(const char *name, const char *operation, uint8_t kind)
 {
-  CNSTelemetrySpan *span = cns_telemetry_create_span(&global_context, name, operation, kind);
-  if (span)
+  if (!global_context.enabled)
+    return NULL;
+
+  TelemetrySpanPool *pool = telemetry_pool_get();
+  CNSTelemetryContext *ctx = pool ? &pool->context : &global_context;
+
+  uint8_t sampled;
+  if (!telemetry_head_sample(pool, &sampled))
+    return NULL;
+
+  CNSTelemetrySpan *span = telemetry_span_acquire(ctx);
+  if (!span)
+    return NULL;
+
+  telemetry_span_init(span, ctx, name, operation, kind, sampled);
+
+  if (ctx->stack_depth < 64)
   {
-    cns_telemetry_start_span(&global_context, span);
+    ctx->span_stack[ctx->stack_depth] = ctx->current_span;
+    ctx->stack_depth++;
   }
+  ctx->current_span = span;
   return span;
 }
 
 void cns_telemetry_span_finish(CNSTelemetrySpan *span, uint8_t status)
 {
-  if (span)
+  if (!span)
+    return;
+
+  span->end_cycles = telemetry_cycles();
+  span->status = status;
+
+  CNSTelemetryContext *ctx = tls_pool ? &tls_pool->context : &global_context;
+  if (ctx->current_span == span)
   {
-    cns_telemetry_end_span(&global_context, span, status);
-    cns_telemetry_free_span(span);
+    if (ctx->stack_depth > 0)
+    {
+      ctx->stack_depth--;
+      ctx->current_span = ctx->span_stack[ctx->stack_depth];
+    }
+    else
+    {
+      ctx->current_span = NULL;
+    }
   }
+
+  telemetry_span_release(span);
 }
 
-// Attribute management (7-tick optimized)
-void cns_telemetry_add_attribute_string(CNSTelemetrySpan *span, const char *key, const char *value)
+// ============================================================================
+// Background exporter
+// ============================================================================
+
+// Exporter, for a retired pool: acting as its owner, free the pool once no
+// span is left outside it. Called under exporter_lock after the pool's
+// finished ring was drained.
+static int telemetry_pool_reclaim(uint32_t index, TelemetrySpanPool *pool)
 {
-  if (!span || span->attributes_count >= 32)
-    return;
+  CNSTelemetrySpan *recycled;
+  while ((recycled = ring_pop(&pool->recycled)) != NULL)
+  {
+    pool->free_stack[pool->free_top++] = recycled->pool_slot;
+  }
+  if (pool->free_top != CNS_TELEMETRY_POOL_SIZE ||
+      __atomic_load_n(&pool->remote_head, __ATOMIC_ACQUIRE) != 0)
+    return 0; // Spans still held, queued or awaiting export
+
+  retired_totals.spans_recorded += pool->spans_recorded;
+  retired_totals.spans_exported += pool->spans_exported;
+  retired_totals.spans_dropped += pool->spans_dropped;
+  retired_totals.spans_sampled_out += pool->spans_sampled_out;
+  retired_totals.spans_remote += __atomic_load_n(&pool->spans_remote, __ATOMIC_RELAXED);
+
+  pthread_mutex_lock(&pool_registry_lock);
+  __atomic_store_n(&pool_registry[index], NULL, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&pool_registry_lock);
+  free(pool);
+  return 1;
+}
 
-  // Just increment counter for 7-tick performance
-  span->attributes_count++;
+size_t cns_telemetry_exporter_drain(void)
+{
+  CNSTelemetrySpan *batch[CNS_TELEMETRY_EXPORT_BATCH];
+  size_t total = 0;
+
+  pthread_mutex_lock(&exporter_lock);
+
+  uint32_t count = __atomic_load_n(&pool_count, __ATOMIC_ACQUIRE);
+  if (count > CNS_TELEMETRY_MAX_THREADS)
+    count = CNS_TELEMETRY_MAX_THREADS;
+
+  for (uint32_t p = 0; p < count; p++)
+  {
+    TelemetrySpanPool *pool = __atomic_load_n(&pool_registry[p], __ATOMIC_ACQUIRE);
+    if (!pool)
+      continue;
+
+    // Spans other threads returned to a retired pool are finished here
+    int retired = __atomic_load_n(&pool->retired, __ATOMIC_ACQUIRE);
+    if (retired)
+      telemetry_remote_drain(pool);
+
+    for (;;)
+    {
+      size_t n = 0;
+      CNSTelemetrySpan *span;
+      while (n < CNS_TELEMETRY_EXPORT_BATCH && (span = ring_pop(&pool->finished)) != NULL)
+      {
+        telemetry_span_resolve_times(span);
+        batch[n++] = span;
+      }
+      if (n == 0)
+        break;
+
+      if (exporter_fn)
+      {
+        exporter_fn((const CNSTelemetrySpan *const *)batch, n, exporter_user_data);
+      }
+
+      // Recycled ring has pool capacity, so this cannot fail
+      for (size_t i = 0; i < n; i++)
+      {
+        ring_push(&pool->recycled, batch[i]);
+      }
+
+      __atomic_store_n(&pool->spans_exported, pool->spans_exported + n, __ATOMIC_RELAXED);
+      total += n;
+
+      if (n < CNS_TELEMETRY_EXPORT_BATCH)
+        break;
+    }
+
+    if (retired)
+      telemetry_pool_reclaim(p, pool);
+  }
+
+  pthread_mutex_unlock(&exporter_lock);
+  return total;
 }
 
-void cns_telemetry_add_attribute_int(CNSTelemetrySpan *span, const char *key, int64_t value)
+static void *telemetry_exporter_main(void *arg)
 {
-  if (!span || span->attributes_count >= 32)
-    return;
+  (void)arg;
+  const struct timespec idle = {0, 100000}; // 100us between empty passes
 
-  // Just increment counter for 7-tick performance
-  span->attributes_count++;
+  while (__atomic_load_n(&exporter_running, __ATOMIC_ACQUIRE))
+  {
+    if (cns_telemetry_exporter_drain() == 0)
+    {
+      nanosleep(&idle, NULL);
+    }
+  }
+
+  cns_telemetry_exporter_drain();
+  return NULL;
 }
 
-void cns_telemetry_add_attribute_float(CNSTelemetrySpan *span, const char *key, double value)
+int cns_telemetry_exporter_start(CNSTelemetryExportFn export_fn, void *user_data)
+{
+  if (__atomic_load_n(&exporter_running, __ATOMIC_ACQUIRE))
+    return -1;
+
+  pthread_mutex_lock(&exporter_lock);
+  exporter_fn = export_fn;
+  exporter_user_data = user_data;
+  pthread_mutex_unlock(&exporter_lock);
+
+  __atomic_store_n(&exporter_running, 1, __ATOMIC_RELEASE);
+  if (pthread_create(&exporter_thread, NULL, telemetry_exporter_main, NULL) != 0)
+  {
+    __atomic_store_n(&exporter_running, 0, __ATOMIC_RELEASE);
+    return -1;
+  }
+
+  __atomic_store_n(&exporter_attached, 1, __ATOMIC_RELEASE);
+  return 0;
+}
+
+void cns_telemetry_exporter_stop(void)
 {
-  if (!span || span->attributes_count >= 32)
+  if (!__atomic_load_n(&exporter_running, __ATOMIC_ACQUIRE))
     return;
 
-  // Just increment counter for 7-tick performance
-  span->attributes_count++;
+  __atomic_store_n(&exporter_attached, 0, __ATOMIC_RELEASE);
+  __atomic_store_n(&exporter_running, 0, __ATOMIC_RELEASE);
+  pthread_join(exporter_thread, NULL);
+
+  // Pick up spans pushed between the last pass and detach
+  cns_telemetry_exporter_drain();
 }
 
-void cns_telemetry_add_attribute_bool(CNSTelemetrySpan *span, const char *key, bool value)
+void cns_telemetry_get_pool_stats(CNSTelemetryPoolStats *stats)
 {
-  if (!span || span->attributes_count >= 32)
+  if (!stats)
     return;
 
-  // Just increment counter for 7-tick performance
-  span->attributes_count++;
+  // The exporter lock keeps retired pools from being freed under us
+  pthread_mutex_lock(&exporter_lock);
+  *stats = retired_totals;
+  stats->heap_fallbacks = __atomic_load_n(&heap_fallbacks, __ATOMIC_RELAXED);
+
+  uint32_t count = __atomic_load_n(&pool_count, __ATOMIC_ACQUIRE);
+  if (count > CNS_TELEMETRY_MAX_THREADS)
+    count = CNS_TELEMETRY_MAX_THREADS;
+
+  for (uint32_t p = 0; p < count; p++)
+  {
+    TelemetrySpanPool *pool = __atomic_load_n(&pool_registry[p], __ATOMIC_ACQUIRE);
+    if (!pool)
+      continue;
+    stats->spans_recorded += __atomic_load_n(&pool->spans_recorded, __ATOMIC_RELAXED);
+    stats->spans_exported += __atomic_load_n(&pool->spans_exported, __ATOMIC_RELAXED);
+    stats->spans_dropped += __atomic_load_n(&pool->spans_dropped, __ATOMIC_RELAXED);
+    stats->spans_sampled_out += __atomic_load_n(&pool->spans_sampled_out, __ATOMIC_RELAXED);
+    stats->spans_remote += __atomic_load_n(&pool->spans_remote, __ATOMIC_RELAXED);
+    stats->thread_count++;
+  }
+  pthread_mutex_unlock(&exporter_lock);
+}
+
+// Attribute management (7-tick optimized) - stored inline in the span
+static inline CNSTelemetryAttribute *telemetry_attribute_slot(CNSTelemetrySpan *span, const char *key, uint8_t type)
+{
+  if (!span || span->attributes_count >= CNS_TELEMETRY_MAX_ATTRIBUTES)
+    return NULL;
+
+  CNSTelemetryAttribute *attr = &span->attributes[span->attributes_count++];
+  attr->key = key;
+  attr->type = type;
+  return attr;
+}
+
+void cns_telemetry_add_attribute_string(CNSTelemetrySpan *span, const char *key, const char *value)
+{
+  CNSTelemetryAttribute *attr = telemetry_attribute_slot(span, key, 0);
+  if (attr)
+    attr->value = value;
+}
+
+void cns_telemetry_add_attribute_int(CNSTelemetrySpan *span, const char *key, int64_t value)
+{
+  CNSTelemetryAttribute *attr = telemetry_attribute_slot(span, key, 1);
+  if (attr)
+    attr->int_value = value;
+}
+
+void cns_telemetry_add_attribute_float(CNSTelemetrySpan *span, const char *key, double value)
+{
+  CNSTelemetryAttribute *attr = telemetry_attribute_slot(span, key, 2);
+  if (attr)
+    attr->float_value = value;
+}
+
+void cns_telemetry_add_attribute_bool(CNSTelemetrySpan *span, const char *key, bool value)
+{
+  CNSTelemetryAttribute *attr = telemetry_attribute_slot(span, key, 3);
+  if (attr)
+    attr->int_value = value ? 1 : 0;
 }
 
 // Event management
@@ -203,18 +1168,19 @@ uint64_t cns_telemetry_get_span_duration_ns(CNSTelemetrySpan *span)
   if (!span)
     return 0;
 
-  if (span->end_time_ns == 0)
+  if (span->end_cycles == 0)
   {
     // Span is still active, calculate current duration
-    return cns_telemetry_get_nanoseconds() - span->start_time_ns;
+    return (uint64_t)((double)(telemetry_cycles() - span->start_cycles) * ns_per_cycle);
   }
 
+  telemetry_span_resolve_times(span);
   return span->end_time_ns - span->start_time_ns;
 }
 
 int cns_telemetry_is_span_active(CNSTelemetrySpan *span)
 {
-  return span && span->end_time_ns == 0;
+  return span && span->end_cycles == 0;
 }
 
 CNSTelemetrySpan *cns_telemetry_get_current_span(CNSTelemetryContext *ctx)
@@ -225,7 +1191,7 @@ CNSTelemetrySpan *cns_telemetry_get_current_span(CNSTelemetryContext *ctx)
 // Performance monitoring
 uint64_t cns_telemetry_get_cycles(void)
 {
-  return __builtin_readcyclecounter();
+  return telemetry_cycles();
 }
 
 void cns_telemetry_measure_span_cycles(const char *name, const char *operation)
@@ -573,10 +1539,28 @@ void cns_telemetry_shutdown(cns_telemetry_t *telemetry)
   }
 }
 
-// Force flush all pending data
+// Force flush all pending data: drain span rings, then export histograms
 int cns_telemetry_flush(cns_telemetry_t *telemetry)
 {
-  // For now, just return success
+  (void)telemetry;
+  cns_telemetry_exporter_drain();
+
+  uint32_t count = cns_telemetry_histogram_count();
+  for (uint32_t id = 0; id < count; id++)
+  {
+    CNSTelemetryHistogramSummary summary;
+    if (cns_telemetry_histogram_summary_at(id, &summary) != 0 || summary.count == 0)
+      continue;
+
+    printf("METRIC: %s count=%llu p50=%llu p99=%llu p999=%llu max=%llu cycles",
+           summary.name, (unsigned long long)summary.count,
+           (unsigned long long)summary.p50, (unsigned long long)summary.p99,
+           (unsigned long long)summary.p999, (unsigned long long)summary.max_cycles);
+    if (summary.violations)
+      printf(" violations=%llu", (unsigned long long)summary.violations);
+    printf("\n");
+  }
+
   return 0; // CNS_OK equivalent
 }
 
@@ -638,8 +1622,8 @@ void cns_metric_record_latency(cns_telemetry_t *telemetry, const char *command,
   if (!telemetry || !command)
     return;
 
-  // For now, just print the metric
-  printf("METRIC: %s latency = %llu cycles\n", command, (unsigned long long)cycles);
+  // Aggregated into the command's histogram; reported by cns_telemetry_flush
+  cns_telemetry_histogram_record(command, cycles);
 }
 
 // Record performance violation
@@ -648,8 +1632,10 @@ void cns_metric_record_violation(cns_telemetry_t *telemetry, const char *operati
   if (!telemetry || !operation)
     return;
 
-  printf("VIOLATION: %s took %llu cycles (threshold: %llu)\n",
-         operation, (unsigned long long)actual_cycles, (unsigned long long)threshold_cycles);
+  // The sample joins the operation's histogram, so the reported tail shows
+  // how far past the threshold it went; cns_telemetry_flush reports both
+  (void)threshold_cycles;
+  telemetry_hist_record_violation(operation, actual_cycles);
 }
 
 // Auto-end span on scope exit (for CNS_SPAN_SCOPE macro)
@@ -1,3 +1,4 @@
+#define _GNU_SOURCE  // memmem
 #include "cns/shacl.h"
 #include "cns/types.h"
 #include "cns/arena.h"
@@ -6,8 +7,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <regex.h>
 #include <math.h>
+#include <pthread.h>
+#include <unistd.h>
 
 // ============================================================================
 // SHACL VALIDATOR IMPLEMENTATION - 7T COMPLIANT AOT OPTIMIZED
@@ -109,6 +113,282 @@ static bool eval_node_kind_constraint_aot(
     }
 }
 
+// ============================================================================
+// COMPILED PATTERN MATCHERS (sh:pattern) - COMPILE ONCE, MEMOIZE PER VALUE
+// ============================================================================
+
+#define PATTERN_MEMO_VALID  0x2ULL
+#define PATTERN_MEMO_MATCH  0x1ULL
+
+// Memo key: interned value id (offset) plus hash, low bits reserved for state
+static inline uint64_t pattern_memo_key(cns_string_ref_t value) {
+    return ((uint64_t)value.offset << 32) | (value.hash & ~0x3U);
+}
+
+static inline bool pattern_is_meta(char c) {
+    switch (c) {
+        case '.': case '[': case ']': case '(': case ')': case '*':
+        case '+': case '?': case '{': case '}': case '|': case '^':
+        case '$': case '\\':
+            return true;
+        default:
+            return false;
+    }
+}
+
+static inline bool pattern_is_quantifier(char c) {
+    return c == '*' || c == '+' || c == '?' || c == '{';
+}
+
+static uint32_t pattern_parse_flags(const char *flags) {
+    uint32_t bits = 0;
+    for (const char *f = flags; f && *f; f++) {
+        switch (*f) {
+            case 'i': bits |= CNS_PATTERN_FLAG_ICASE; break;
+            case 'm': bits |= CNS_PATTERN_FLAG_MULTILINE; break;
+            case 's': bits |= CNS_PATTERN_FLAG_DOTALL; break;
+            case 'q': bits |= CNS_PATTERN_FLAG_LITERAL; break;
+            default: break; // "x" has no POSIX equivalent - ignored
+        }
+    }
+    return bits;
+}
+
+// Extract the leading literal run of a pattern and pick the cheapest strategy.
+// Anything with alternation keeps the full regex and no prefilter.
+static void pattern_analyze(cns_shacl_pattern_t *pattern, const char *src) {
+    size_t src_len = strlen(src);
+    pattern->kind = CNS_PATTERN_MATCH_REGEX;
+    pattern->literal_length = 0;
+    pattern->literal_anchored = false;
+    pattern->literal_long = NULL;
+    pattern->literal_long_length = 0;
+    
+    if (pattern->flags & CNS_PATTERN_FLAG_LITERAL) {
+        if (src_len < CNS_PATTERN_LITERAL_MAX) {
+            memcpy(pattern->literal, src, src_len);
+            pattern->literal_length = (uint16_t)src_len;
+        } else {
+            // Interned strings live as long as the validator's interner
+            pattern->literal_long = src;
+            pattern->literal_long_length = src_len;
+        }
+        pattern->kind = CNS_PATTERN_MATCH_CONTAINS;
+        return;
+    }
+    
+    if (strchr(src, '|')) {
+        return;
+    }
+    
+    const char *p = src;
+    bool anchored = (*p == '^');
+    if (anchored) p++;
+    
+    size_t len = 0;
+    while (*p && len < CNS_PATTERN_LITERAL_MAX - 1) {
+        char c = *p;
+        if (c == '\\' && p[1] && pattern_is_meta(p[1])) {
+            c = p[1];
+            if (pattern_is_quantifier(p[2])) break;
+            p += 2;
+        } else if (pattern_is_meta(c)) {
+            break;
+        } else {
+            if (pattern_is_quantifier(p[1])) break;
+            p++;
+        }
+        pattern->literal[len++] = c;
+    }
+    
+    pattern->literal_length = (uint16_t)len;
+    // With "m", '^' also matches after a newline; only the contains check holds
+    pattern->literal_anchored = anchored && !(pattern->flags & CNS_PATTERN_FLAG_MULTILINE);
+    
+    bool tail_anchored = (p[0] == '$' && p[1] == '\0');
+    if (p[0] != '\0' && !tail_anchored) {
+        return; // Regex with literal prefilter
+    }
+    
+    // Whole pattern is a literal; multiline anchors need the regex engine
+    if ((anchored || tail_anchored) && (pattern->flags & CNS_PATTERN_FLAG_MULTILINE)) {
+        return;
+    }
+    
+    if (anchored && tail_anchored) {
+        pattern->kind = CNS_PATTERN_MATCH_EXACT;
+    } else if (anchored) {
+        pattern->kind = CNS_PATTERN_MATCH_PREFIX;
+    } else if (tail_anchored) {
+        pattern->kind = CNS_PATTERN_MATCH_SUFFIX;
+    } else {
+        pattern->kind = CNS_PATTERN_MATCH_CONTAINS;
+    }
+}
+
+static inline bool pattern_bytes_equal(const char *a, const char *b,
+                                       size_t len, bool icase) {
+    return icase ? strncasecmp(a, b, len) == 0 : memcmp(a, b, len) == 0;
+}
+
+static bool pattern_contains(const char *haystack, size_t haystack_len,
+                             const char *needle, size_t needle_len, bool icase) {
+    if (needle_len == 0) return true;
+    if (needle_len > haystack_len) return false;
+    if (!icase) {
+        return memmem(haystack, haystack_len, needle, needle_len) != NULL;
+    }
+    for (size_t i = 0; i + needle_len <= haystack_len; i++) {
+        if (strncasecmp(haystack + i, needle, needle_len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool pattern_match_uncached(const cns_shacl_pattern_t *pattern,
+                                   const char *value_str, size_t value_len) {
+    const char *lit = pattern->literal;
+    size_t lit_len = pattern->literal_length;
+    bool icase = (pattern->flags & CNS_PATTERN_FLAG_ICASE) != 0;
+    
+    switch (pattern->kind) {
+        case CNS_PATTERN_MATCH_EXACT:
+            return value_len == lit_len && pattern_bytes_equal(value_str, lit, lit_len, icase);
+        case CNS_PATTERN_MATCH_PREFIX:
+            return value_len >= lit_len && pattern_bytes_equal(value_str, lit, lit_len, icase);
+        case CNS_PATTERN_MATCH_SUFFIX:
+            return value_len >= lit_len &&
+                   pattern_bytes_equal(value_str + value_len - lit_len, lit, lit_len, icase);
+        case CNS_PATTERN_MATCH_CONTAINS:
+            if (pattern->literal_long) {
+                return pattern_contains(value_str, value_len, pattern->literal_long,
+                                        pattern->literal_long_length, icase);
+            }
+            return pattern_contains(value_str, value_len, lit, lit_len, icase);
+        case CNS_PATTERN_MATCH_REGEX:
+        default:
+            break;
+    }
+    
+    if (SHACL_UNLIKELY(!pattern->regex_valid)) {
+        return false; // Invalid pattern never matches
+    }
+    
+    // Literal prefilter rejects most non-matching values before regexec
+    if (lit_len > 0) {
+        bool maybe = pattern->literal_anchored
+            ? (value_len >= lit_len && pattern_bytes_equal(value_str, lit, lit_len, icase))
+            : pattern_contains(value_str, value_len, lit, lit_len, icase);
+        if (!maybe) {
+            return false;
+        }
+    }
+    
+    return regexec(&pattern->regex, value_str, 0, NULL, 0) == 0;
+}
+
+bool cns_shacl_pattern_match(const cns_shacl_pattern_t *pattern,
+                            cns_string_ref_t value,
+                            const char *value_str) {
+    if (SHACL_UNLIKELY(!pattern || !value_str)) {
+        return false;
+    }
+    
+    uint64_t key = pattern_memo_key(value);
+    uint64_t *slot = &pattern->memo[value.hash & (CNS_PATTERN_MEMO_SIZE - 1)];
+    uint64_t entry = __atomic_load_n(slot, __ATOMIC_RELAXED);
+    
+    if (SHACL_LIKELY((entry & ~0x3ULL) == key && (entry & PATTERN_MEMO_VALID))) {
+        return (entry & PATTERN_MEMO_MATCH) != 0;
+    }
+    
+    bool matched = pattern_match_uncached(pattern, value_str, value.length);
+    
+    __atomic_store_n(slot, key | PATTERN_MEMO_VALID | (matched ? PATTERN_MEMO_MATCH : 0),
+                     __ATOMIC_RELAXED);
+    return matched;
+}
+
+const cns_shacl_pattern_t* cns_shacl_compile_pattern(
+    cns_shacl_validator_t *validator,
+    cns_string_ref_t pattern_ref,
+    const char *flags
+) {
+    if (SHACL_UNLIKELY(!validator || !validator->pattern_cache.entries)) {
+        return NULL;
+    }
+    
+    uint32_t flag_bits = pattern_parse_flags(flags);
+    cns_shacl_pattern_cache_t *cache = &validator->pattern_cache;
+    
+    // Linear probe on (pattern hash ^ flags)
+    uint32_t index = (pattern_ref.hash ^ (flag_bits * 0x9E3779B1U)) & (CNS_PATTERN_CACHE_SIZE - 1);
+    for (size_t probe = 0; probe < CNS_PATTERN_CACHE_SIZE; probe++) {
+        cns_shacl_pattern_t *entry = cache->entries[index];
+        if (!entry) {
+            break;
+        }
+        if (cns_string_ref_equal(entry->source, pattern_ref) && entry->flags == flag_bits) {
+            return entry;
+        }
+        index = (index + 1) & (CNS_PATTERN_CACHE_SIZE - 1);
+    }
+    
+    if (SHACL_UNLIKELY(cache->entries[index] || cache->count >= CNS_PATTERN_CACHE_SIZE)) {
+        return NULL; // Cache full
+    }
+    
+    const char *src = cns_interner_get_string(validator->interner, pattern_ref);
+    if (SHACL_UNLIKELY(!src)) {
+        return NULL;
+    }
+    
+    cns_shacl_pattern_t *pattern = ARENAC_NEW(validator->constraint_arena, cns_shacl_pattern_t);
+    uint64_t *memo = ARENAC_NEW_ARRAY(validator->constraint_arena, uint64_t, CNS_PATTERN_MEMO_SIZE);
+    if (SHACL_UNLIKELY(!pattern || !memo)) {
+        return NULL;
+    }
+    
+    memset(pattern, 0, sizeof(*pattern));
+    memset(memo, 0, CNS_PATTERN_MEMO_SIZE * sizeof(uint64_t));
+    pattern->source = pattern_ref;
+    pattern->flags = flag_bits;
+    pattern->memo = memo;
+    
+    pattern_analyze(pattern, src);
+    
+    if (pattern->kind == CNS_PATTERN_MATCH_REGEX) {
+        int cflags = REG_EXTENDED | REG_NOSUB;
+        if (flag_bits & CNS_PATTERN_FLAG_ICASE) cflags |= REG_ICASE;
+        if (flag_bits & CNS_PATTERN_FLAG_MULTILINE) cflags |= REG_NEWLINE;
+        pattern->regex_valid = (regcomp(&pattern->regex, src, cflags) == 0);
+    }
+    
+    cache->entries[index] = pattern;
+    cache->count++;
+    validator->stats.patterns_compiled++;
+    
+    return pattern;
+}
+
+static void pattern_cache_release(cns_shacl_pattern_cache_t *cache) {
+    if (!cache->entries) {
+        return;
+    }
+    
+    // Arena owns the matchers; only the regex internals live on the heap
+    for (size_t i = 0; i < CNS_PATTERN_CACHE_SIZE; i++) {
+        cns_shacl_pattern_t *entry = cache->entries[i];
+        if (entry && entry->regex_valid) {
+            regfree(&entry->regex);
+            entry->regex_valid = false;
+        }
+        cache->entries[i] = NULL;
+    }
+    cache->count = 0;
+}
+
 // AOT-optimized pattern constraint evaluation (sh:pattern)
 static bool eval_pattern_constraint_aot(
     const cns_graph_t *graph,
@@ -116,17 +396,25 @@ static bool eval_pattern_constraint_aot(
     cns_string_ref_t value,
     const cns_constraint_t *constraint
 ) {
-    (void)graph; (void)focus_node; // Unused for pattern matching
+    (void)focus_node; // Unused for pattern matching
     
     // Retrieve string value for pattern matching
     const char *value_str = cns_interner_get_string(graph->interner, value);
-    const char *pattern_str = cns_interner_get_string(graph->interner, constraint->value.string);
+    if (SHACL_UNLIKELY(!value_str)) {
+        return false;
+    }
+    
+    // Fast path: matcher compiled at shape-load time
+    if (SHACL_LIKELY(constraint->pattern != NULL)) {
+        return cns_shacl_pattern_match(constraint->pattern, value, value_str);
+    }
     
-    if (SHACL_UNLIKELY(!value_str || !pattern_str)) {
+    // Constraint added without a validator - compile on the spot
+    const char *pattern_str = cns_interner_get_string(graph->interner, constraint->value.string);
+    if (SHACL_UNLIKELY(!pattern_str)) {
         return false;
     }
     
-    // Compile and cache regex for performance (TODO: implement regex cache)
     regex_t regex;
     int result = regcomp(&regex, pattern_str, REG_EXTENDED | REG_NOSUB);
     if (SHACL_UNLIKELY(result != 0)) {
@@ -343,6 +631,19 @@ cns_shacl_validator_t* cns_shacl_validator_create(const cns_shacl_config_t *conf
     memset(validator->shape_hash_table, 0xFF, validator->shape_hash_size * sizeof(uint32_t));
     memset(validator->target_hash_table, 0xFF, validator->target_hash_size * sizeof(uint32_t));
     
+    // Compiled sh:pattern cache
+    validator->pattern_cache.entries = ARENAC_NEW_ARRAY(
+        config->arena,
+        cns_shacl_pattern_t*,
+        CNS_PATTERN_CACHE_SIZE
+    );
+    if (SHACL_UNLIKELY(!validator->pattern_cache.entries)) {
+        return NULL;
+    }
+    memset(validator->pattern_cache.entries, 0,
+           CNS_PATTERN_CACHE_SIZE * sizeof(cns_shacl_pattern_t*));
+    validator->pattern_cache.count = 0;
+    
     // Initialize statistics
     memset(&validator->stats, 0, sizeof(cns_shacl_stats_t));
     
@@ -393,7 +694,8 @@ void cns_shacl_validator_destroy(cns_shacl_validator_t *validator) {
     }
     
     // When using arenas, destruction is O(1) - memory is automatically freed
-    // when arena is reset/destroyed
+    // when arena is reset/destroyed. Compiled regexes hold heap state.
+    pattern_cache_release(&validator->pattern_cache);
     validator->magic = 0; // Invalidate
 }
 
@@ -465,6 +767,7 @@ cns_result_t cns_shacl_add_constraint(
     constraint->message = (cns_string_ref_t){0}; // Default message
     constraint->severity = CNS_SEVERITY_VIOLATION;
     constraint->flags = 0;
+    constraint->pattern = NULL;
     constraint->next = shape->constraints; // Prepend to list
     
     shape->constraints = constraint;
@@ -473,6 +776,54 @@ cns_result_t cns_shacl_add_constraint(
     return CNS_OK;
 }
 
+cns_result_t cns_shacl_add_property_shape(
+    cns_shape_t *shape,
+    const char *property_path,
+    cns_property_shape_t *property_shape
+) {
+    if (SHACL_UNLIKELY(!shape || !property_path || !property_shape)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+    
+    // SPARQL path syntax: ^ex:p is the inverse of ex:p
+    if (property_path[0] == '^') {
+        property_shape->flags |= CNS_PROPERTY_FLAG_INVERSE_PATH;
+    }
+    
+    property_shape->next = shape->properties; // Prepend to list
+    shape->properties = property_shape;
+    return CNS_OK;
+}
+
+cns_result_t cns_shacl_add_pattern_constraint(
+    cns_shacl_validator_t *validator,
+    cns_shape_t *shape,
+    const char *pattern,
+    const char *flags
+) {
+    if (SHACL_UNLIKELY(!validator || !shape || !pattern)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+    
+    cns_constraint_value_t value;
+    value.string = cns_interner_intern(validator->interner, pattern);
+    
+    // Compile before touching the shape so a full cache leaves it unchanged
+    const cns_shacl_pattern_t *compiled = cns_shacl_compile_pattern(validator, value.string, flags);
+    if (SHACL_UNLIKELY(!compiled)) {
+        return CNS_ERROR_MEMORY;
+    }
+    
+    cns_result_t result = cns_shacl_add_constraint(shape, CNS_SHACL_PATTERN, &value);
+    if (SHACL_UNLIKELY(result != CNS_OK)) {
+        return result;
+    }
+    
+    shape->constraints->pattern = compiled;
+    shape->constraints->flags |= CNS_CONSTRAINT_FLAG_COMPILED;
+    return CNS_OK;
+}
+
 // ============================================================================
 // CORE VALIDATION FUNCTIONS - 7T GUARANTEED
 // ============================================================================
@@ -498,6 +849,7 @@ cns_result_t cns_shacl_validate_graph(
     report->validation_time_ticks = 0;
     report->nodes_validated = 0;
     report->constraints_checked = 0;
+    report->results_tail = NULL;
     
     // Validate each node in graph against applicable shapes
     cns_graph_iterator_t node_iter = cns_graph_iter_nodes(data_graph);
@@ -538,6 +890,191 @@ cns_result_t cns_shacl_validate_graph(
     return CNS_OK;
 }
 
+// ============================================================================
+// PARALLEL VALIDATION - PARTITIONED FOCUS NODES, PER-WORKER REPORTS
+// ============================================================================
+
+// One per thread, padded so counters never share a cache line
+typedef struct {
+    cns_shacl_validator_t *validator;
+    const cns_graph_t *data_graph;
+    size_t *next_node;                // Shared chunk cursor
+    size_t chunk_size;
+    cns_validation_report_t report;   // Thread-local report
+    cns_result_t status;
+    pthread_t thread;
+} __attribute__((aligned(CNS_7T_CACHE_LINE_SIZE))) shacl_worker_t;
+
+static void* shacl_worker_main(void *arg) {
+    shacl_worker_t *worker = (shacl_worker_t*)arg;
+    const cns_graph_t *graph = worker->data_graph;
+    size_t node_count = graph->node_count;
+    
+    for (;;) {
+        size_t begin = __atomic_fetch_add(worker->next_node, worker->chunk_size, __ATOMIC_RELAXED);
+        if (begin >= node_count) {
+            break;
+        }
+        size_t end = begin + worker->chunk_size;
+        if (end > node_count) {
+            end = node_count;
+        }
+        
+        for (size_t i = begin; i < end; i++) {
+            cns_result_t result = cns_shacl_validate_node(
+                worker->validator,
+                graph,
+                graph->nodes[i].iri,
+                &worker->report
+            );
+            
+            if (SHACL_UNLIKELY(result != CNS_OK)) {
+                worker->status = result;
+                // Drain the cursor so the other workers stop early
+                __atomic_store_n(worker->next_node, node_count, __ATOMIC_RELAXED);
+                return NULL;
+            }
+            
+            worker->report.nodes_validated++;
+        }
+    }
+    
+    return NULL;
+}
+
+// Concatenate a worker report onto the merged report - O(1), no copying
+static void shacl_report_append(cns_validation_report_t *dst,
+                                const cns_validation_report_t *src) {
+    if (src->results) {
+        if (dst->results_tail) {
+            dst->results_tail->next = src->results;
+        } else {
+            dst->results = src->results;
+        }
+        dst->results_tail = src->results_tail;
+    }
+    
+    dst->result_count += src->result_count;
+    dst->info_count += src->info_count;
+    dst->warning_count += src->warning_count;
+    dst->violation_count += src->violation_count;
+    dst->nodes_validated += src->nodes_validated;
+    dst->constraints_checked += src->constraints_checked;
+}
+
+cns_result_t cns_shacl_validate_graph_parallel(
+    cns_shacl_validator_t *validator,
+    const cns_graph_t *data_graph,
+    const cns_shacl_parallel_config_t *config,
+    cns_validation_report_t *report
+) {
+    if (SHACL_UNLIKELY(!validator || !data_graph || !report)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+    
+    bool own_arenas = config && config->worker_arenas;
+    if (SHACL_UNLIKELY(own_arenas && config->worker_arena_count == 0)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+    
+    uint32_t thread_count = config ? config->thread_count : 0;
+    if (thread_count == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (uint32_t)online : 1;
+    }
+    if (thread_count > CNS_SHACL_MAX_WORKERS) {
+        thread_count = CNS_SHACL_MAX_WORKERS;
+    }
+    if (own_arenas && thread_count > config->worker_arena_count) {
+        thread_count = config->worker_arena_count; // One arena per worker
+    }
+    
+    size_t chunk_size = (config && config->chunk_size) ? config->chunk_size
+                                                        : CNS_SHACL_DEFAULT_CHUNK_SIZE;
+    
+    // Not worth spinning up threads for a single chunk
+    if (thread_count == 1 || data_graph->node_count <= chunk_size) {
+        return cns_shacl_validate_graph(validator, data_graph, report);
+    }
+    
+    cns_tick_t start = SHACL_TICK_START();
+    
+    shacl_worker_t workers[CNS_SHACL_MAX_WORKERS];
+    size_t next_node = 0;
+    uint32_t started = 0;
+    
+    // Without per-worker arenas, results still materialize in the caller's
+    // arena; only the allocation itself is serialised
+    bool shared_arena = !own_arenas && report->arena;
+    pthread_mutex_t arena_lock = PTHREAD_MUTEX_INITIALIZER;
+    
+    for (uint32_t i = 0; i < thread_count; i++) {
+        shacl_worker_t *worker = &workers[i];
+        memset(worker, 0, sizeof(*worker));
+        worker->validator = validator;
+        worker->data_graph = data_graph;
+        worker->next_node = &next_node;
+        worker->chunk_size = chunk_size;
+        worker->report.conforms = true;
+        if (shared_arena) {
+            worker->report.arena = report->arena;
+            worker->report.arena_lock = &arena_lock;
+        } else {
+            worker->report.arena = own_arenas ? config->worker_arenas[i] : NULL;
+        }
+        worker->status = CNS_OK;
+        
+        if (pthread_create(&worker->thread, NULL, shacl_worker_main, worker) != 0) {
+            break; // Run with the workers we have
+        }
+        started++;
+    }
+    
+    if (SHACL_UNLIKELY(started == 0)) {
+        pthread_mutex_destroy(&arena_lock);
+        return cns_shacl_validate_graph(validator, data_graph, report);
+    }
+    
+    // Initialize merged report; workers only allocate from report->arena
+    report->conforms = true;
+    report->results = NULL;
+    report->results_tail = NULL;
+    report->result_count = 0;
+    report->info_count = 0;
+    report->warning_count = 0;
+    report->violation_count = 0;
+    report->validation_time_ticks = 0;
+    report->nodes_validated = 0;
+    report->constraints_checked = 0;
+    
+    cns_result_t status = CNS_OK;
+    for (uint32_t i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        if (workers[i].status != CNS_OK && status == CNS_OK) {
+            status = workers[i].status;
+        }
+        shacl_report_append(report, &workers[i].report);
+    }
+    pthread_mutex_destroy(&arena_lock);
+    
+    if (SHACL_UNLIKELY(status != CNS_OK)) {
+        return status;
+    }
+    
+    // Finalize report
+    report->conforms = (report->violation_count == 0);
+    report->validation_time_ticks = cns_get_tick_count() - start;
+    
+    // Update validator statistics (single writer after join)
+    validator->stats.validations_performed++;
+    validator->stats.nodes_validated += report->nodes_validated;
+    validator->stats.constraints_evaluated += report->constraints_checked;
+    validator->stats.total_validation_ticks += report->validation_time_ticks;
+    validator->stats.violations_found += report->violation_count;
+    
+    return CNS_OK;
+}
+
 cns_result_t cns_shacl_validate_node(
     cns_shacl_validator_t *validator,
     const cns_graph_t *data_graph,
@@ -805,8 +1342,40 @@ cns_result_t cns_shacl_add_result(
         return CNS_ERROR_INVALID_ARG;
     }
     
-    // This would require arena allocation - simplified for demonstration
-    // In real implementation, allocate validation_result from arena and link
+    // Materialize the result when the report owns an arena; otherwise the
+    // report only carries counters
+    if (report->arena) {
+        cns_validation_result_t *entry = report->free_results;
+        if (entry) {
+            report->free_results = entry->next;
+        } else if (report->arena_lock) {
+            pthread_mutex_lock(report->arena_lock);
+            entry = ARENAC_NEW(report->arena, cns_validation_result_t);
+            pthread_mutex_unlock(report->arena_lock);
+        } else {
+            entry = ARENAC_NEW(report->arena, cns_validation_result_t);
+        }
+        if (SHACL_UNLIKELY(!entry)) {
+            return CNS_ERROR_MEMORY;
+        }
+        
+        entry->focus_node = focus_node;
+        entry->result_path = result_path;
+        entry->value = value;
+        entry->source_constraint_component = constraint_component;
+        entry->source_shape = source_shape;
+        entry->message = message;
+        entry->severity = severity;
+        entry->result_id = (uint32_t)report->result_count;
+        entry->next = NULL;
+        
+        if (report->results_tail) {
+            report->results_tail->next = entry;
+        } else {
+            report->results = entry;
+        }
+        report->results_tail = entry;
+    }
     
     report->result_count++;
     
@@ -863,6 +1432,9 @@ size_t cns_shacl_memory_usage(const cns_shacl_validator_t *validator) {
     usage += validator->shape_hash_size * sizeof(uint32_t);
     usage += validator->target_hash_size * sizeof(uint32_t);
     usage += validator->shape_count * sizeof(cns_shape_t);
+    usage += CNS_PATTERN_CACHE_SIZE * sizeof(cns_shacl_pattern_t*);
+    usage += validator->pattern_cache.count *
+             (sizeof(cns_shacl_pattern_t) + CNS_PATTERN_MEMO_SIZE * sizeof(uint64_t));
     
     return usage;
 }
@@ -901,7 +1473,91 @@ cns_result_t cns_shacl_validate_property(
     const cns_property_shape_t *property_shape,
     cns_validation_report_t *report
 ) {
-    (void)validator; (void)data_graph; (void)focus_node; 
-    (void)property_shape; (void)report;
-    return CNS_OK; // TODO: Implement property validation
+    if (SHACL_UNLIKELY(!validator || !data_graph || !property_shape || !report)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+    
+    cns_tick_t start = SHACL_TICK_START();
+    
+    const char *focus_str = cns_interner_get_string(data_graph->interner, focus_node);
+    const char *path_str = cns_interner_get_string(data_graph->interner, property_shape->path);
+    if (SHACL_UNLIKELY(!focus_str || !path_str)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+    
+    // Value nodes: objects of focus --path--> v, or subjects of v --path--> focus
+    // for sh:inversePath (the same edges the incremental index tracks)
+    bool inverse = (property_shape->flags & CNS_PROPERTY_FLAG_INVERSE_PATH) != 0;
+    cns_triple_t *values = NULL;
+    size_t value_count = 0;
+    cns_result_t result = inverse
+        ? cns_graph_find_triples(data_graph, NULL, path_str, focus_str, &values, &value_count)
+        : cns_graph_find_triples(data_graph, focus_str, path_str, NULL, &values, &value_count);
+    if (result != CNS_OK) {
+        value_count = 0; // No values
+    }
+    
+    // Cardinality applies to the value set as a whole
+    if (value_count < property_shape->min_count ||
+        (property_shape->max_count != CNS_PROPERTY_COUNT_UNBOUNDED &&
+         value_count > property_shape->max_count)) {
+        result = cns_shacl_add_result(
+            report,
+            focus_node,
+            property_shape->path,
+            (cns_string_ref_t){0}, // No single offending value
+            (cns_string_ref_t){0},
+            (cns_string_ref_t){0},
+            (cns_string_ref_t){0},
+            CNS_SEVERITY_VIOLATION
+        );
+        if (SHACL_UNLIKELY(result != CNS_OK)) {
+            return result;
+        }
+    }
+    report->constraints_checked++;
+    
+    for (size_t i = 0; i < value_count; i++) {
+        cns_string_ref_t value = inverse ? values[i].subject : values[i].object;
+        
+        const cns_constraint_t *constraint = property_shape->constraints;
+        while (constraint) {
+            bool conforms;
+            result = cns_shacl_eval_constraint(
+                validator,
+                data_graph,
+                focus_node,
+                value,
+                constraint,
+                &conforms
+            );
+            
+            if (SHACL_UNLIKELY(result != CNS_OK)) {
+                return result;
+            }
+            
+            if (!conforms) {
+                result = cns_shacl_add_result(
+                    report,
+                    focus_node,
+                    property_shape->path,
+                    value,
+                    (cns_string_ref_t){0},
+                    (cns_string_ref_t){0}, // Owning shape is not passed down
+                    constraint->message,
+                    constraint->severity
+                );
+                
+                if (SHACL_UNLIKELY(result != CNS_OK)) {
+                    return result;
+                }
+            }
+            
+            report->constraints_checked++;
+            constraint = constraint->next;
+        }
+    }
+    
+    SHACL_TICK_VALIDATE(start, "validate_property");
+    return CNS_OK;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "cns/graph.h"
 #include "cns/arena.h"
 #include "cns/interner.h"
+#include "cns/engines/telemetry.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -30,42 +31,51 @@ static inline uint64_t get_cycle_count(void) {
 #endif
 }
 
-// Performance measurement structure
+// Performance measurement structure; every statistic comes from the
+// operation's telemetry histogram (min, max and sum are exact)
 typedef struct {
     const char *name;
     uint64_t min_cycles;
     uint64_t max_cycles;
-    uint64_t total_cycles;
     uint64_t iterations;
     double avg_cycles;
+    uint64_t p50_cycles;
+    uint64_t p99_cycles;
+    uint64_t p999_cycles;
+    int hist_id;
     bool passes_7t;
 } benchmark_result_t;
 
 // Initialize benchmark result
 static void init_benchmark(benchmark_result_t *result, const char *name) {
+    memset(result, 0, sizeof(*result));
     result->name = name;
-    result->min_cycles = UINT64_MAX;
-    result->max_cycles = 0;
-    result->total_cycles = 0;
-    result->iterations = 0;
-    result->avg_cycles = 0.0;
-    result->passes_7t = false;
+    result->hist_id = cns_telemetry_histogram_id(name);
+    cns_telemetry_histogram_reset(name);
 }
 
 // Record measurement
-static void record_measurement(benchmark_result_t *result, uint64_t cycles) {
-    if (cycles < result->min_cycles) result->min_cycles = cycles;
-    if (cycles > result->max_cycles) result->max_cycles = cycles;
-    result->total_cycles += cycles;
-    result->iterations++;
+static inline void record_measurement(benchmark_result_t *result, uint64_t cycles) {
+    cns_telemetry_histogram_record_id(result->hist_id, cycles);
 }
 
 // Finalize benchmark
 static void finalize_benchmark(benchmark_result_t *result) {
-    if (result->iterations > 0) {
-        result->avg_cycles = (double)result->total_cycles / result->iterations;
-        result->passes_7t = (result->avg_cycles <= 7.0);
+    CNSTelemetryHistogramSummary summary;
+    if (result->hist_id < 0 ||
+        cns_telemetry_histogram_summary_at((uint32_t)result->hist_id, &summary) != 0 ||
+        summary.count == 0) {
+        return;
     }
+
+    result->min_cycles = summary.min_cycles;
+    result->max_cycles = summary.max_cycles;
+    result->iterations = summary.count;
+    result->avg_cycles = summary.avg_cycles;
+    result->p50_cycles = summary.p50;
+    result->p99_cycles = summary.p99;
+    result->p999_cycles = summary.p999;
+    result->passes_7t = (result->avg_cycles <= 7.0);
 }
 
 // Print benchmark results
@@ -74,6 +84,8 @@ static void print_results(const benchmark_result_t *result) {
     printf("   Min cycles: %lu\n", result->min_cycles);
     printf("   Max cycles: %lu\n", result->max_cycles);
     printf("   Avg cycles: %.2f\n", result->avg_cycles);
+    printf("   p50/p99/p99.9 cycles: %lu / %lu / %lu\n",
+           result->p50_cycles, result->p99_cycles, result->p999_cycles);
     printf("   Total iterations: %lu\n", result->iterations);
     printf("   7T compliant: %s %s\n", 
            result->passes_7t ? "✅" : "❌",
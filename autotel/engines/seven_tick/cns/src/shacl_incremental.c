@@ -0,0 +1,677 @@
+#include "cns/shacl.h"
+#include "cns/types.h"
+#include "cns/arena.h"
+#include "cns/interner.h"
+#include "cns/graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// INCREMENTAL SHACL VALIDATION - DELTA-DRIVEN REVALIDATION
+// ============================================================================
+
+// A dependency index maps every predicate that can change the outcome of a
+// shape to the (shape, role) pairs it affects. Applying a delta looks up each
+// changed triple's predicate, derives the candidate focus nodes, and
+// re-evaluates only those (focus, shape) pairs. Results are kept per pair so
+// the persistent report can be patched without rescanning the graph.
+
+#define INC_LIKELY(x)   CNS_7T_LIKELY(x)
+#define INC_UNLIKELY(x) CNS_7T_UNLIKELY(x)
+
+#define INC_RDF_TYPE "http://www.w3.org/1999/02/22-rdf-syntax-ns#type"
+#define INC_EMPTY_BUCKET UINT32_MAX
+#define INC_INITIAL_PAIRS 1024
+
+// Validation state for one (focus node, shape) pair
+typedef struct {
+    cns_string_ref_t focus;
+    const cns_shape_t *shape;
+    cns_validation_result_t *results;  // Results owned by this pair
+    cns_validation_result_t *tail;
+    size_t result_count;
+    size_t info_count;
+    size_t warning_count;
+    size_t violation_count;
+    size_t constraints_checked;
+    uint64_t epoch;                    // Last delta that touched this pair
+    bool used;
+} shacl_pair_t;
+
+struct cns_shacl_incremental {
+    cns_shacl_validator_t *validator;
+    cns_shacl_dependency_index_t index;
+    cns_validation_report_t report;    // Persistent report
+
+    shacl_pair_t *pairs;               // Open-addressed (focus, shape) table
+    size_t pair_capacity;              // Power of 2
+    size_t pair_count;
+
+    uint64_t epoch;                    // Incremented per apply
+    cns_shacl_incremental_stats_t stats;
+};
+
+// ============================================================================
+// HASHING HELPERS
+// ============================================================================
+
+static inline uint32_t inc_pair_hash(cns_string_ref_t focus, const cns_shape_t *shape) {
+    uint64_t h = ((uint64_t)focus.hash << 32) ^ focus.offset ^ (uintptr_t)shape;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (uint32_t)h;
+}
+
+static int inc_dep_compare(const void *a, const void *b) {
+    const cns_shacl_dependency_t *da = (const cns_shacl_dependency_t*)a;
+    const cns_shacl_dependency_t *db = (const cns_shacl_dependency_t*)b;
+    if (da->predicate.hash != db->predicate.hash) {
+        return da->predicate.hash < db->predicate.hash ? -1 : 1;
+    }
+    if (da->predicate.offset != db->predicate.offset) {
+        return da->predicate.offset < db->predicate.offset ? -1 : 1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// DEPENDENCY INDEX CONSTRUCTION
+// ============================================================================
+
+typedef struct {
+    cns_shacl_dependency_t *items;
+    size_t count;
+    size_t capacity;
+} inc_dep_builder_t;
+
+static bool inc_dep_push(inc_dep_builder_t *builder, cns_shacl_dependency_t dep) {
+    if (builder->count == builder->capacity) {
+        size_t capacity = builder->capacity ? builder->capacity * 2 : 64;
+        cns_shacl_dependency_t *items = realloc(builder->items, capacity * sizeof(*items));
+        if (INC_UNLIKELY(!items)) {
+            return false;
+        }
+        builder->items = items;
+        builder->capacity = capacity;
+    }
+    builder->items[builder->count++] = dep;
+    return true;
+}
+
+static bool inc_collect_shape_deps(inc_dep_builder_t *builder,
+                                   const cns_shape_t *shape,
+                                   cns_string_ref_t rdf_type) {
+    const cns_string_ref_t any = {0};
+
+    // Target declarations decide whether a node is a focus node at all
+    for (size_t t = 0; t < shape->target_count; t++) {
+        cns_string_ref_t target = shape->targets[t];
+
+        if (shape->flags & CNS_SHAPE_FLAG_TARGET_CLASS) {
+            cns_shacl_dependency_t dep = { rdf_type, target, any, shape, CNS_SHACL_DEP_SUBJECT, false };
+            if (!inc_dep_push(builder, dep)) return false;
+        }
+        if (shape->flags & CNS_SHAPE_FLAG_TARGET_SUBJECTS) {
+            cns_shacl_dependency_t dep = { target, any, any, shape, CNS_SHACL_DEP_SUBJECT, false };
+            if (!inc_dep_push(builder, dep)) return false;
+        }
+        if (shape->flags & CNS_SHAPE_FLAG_TARGET_OBJECTS) {
+            cns_shacl_dependency_t dep = { target, any, any, shape, CNS_SHACL_DEP_OBJECT, false };
+            if (!inc_dep_push(builder, dep)) return false;
+        }
+    }
+
+    // Node-level sh:class depends on the focus node's own rdf:type triples
+    for (const cns_constraint_t *c = shape->constraints; c; c = c->next) {
+        if (c->type == CNS_SHACL_CLASS) {
+            cns_shacl_dependency_t dep = { rdf_type, c->value.string, any, shape, CNS_SHACL_DEP_SUBJECT, false };
+            if (!inc_dep_push(builder, dep)) return false;
+        }
+    }
+
+    // Property shapes: path edges touch the focus node directly, sh:class on
+    // values reaches back to the focus node through the path
+    for (const cns_property_shape_t *p = shape->properties; p; p = p->next) {
+        bool inverse = (p->flags & CNS_PROPERTY_FLAG_INVERSE_PATH) != 0;
+        cns_shacl_dependency_t path_dep = {
+            p->path, any, any, shape,
+            inverse ? CNS_SHACL_DEP_OBJECT : CNS_SHACL_DEP_SUBJECT, false
+        };
+        if (!inc_dep_push(builder, path_dep)) return false;
+
+        for (const cns_constraint_t *c = p->constraints; c; c = c->next) {
+            if (c->type == CNS_SHACL_CLASS) {
+                cns_shacl_dependency_t dep = {
+                    rdf_type, c->value.string, p->path, shape,
+                    CNS_SHACL_DEP_VALUE_CLASS, inverse
+                };
+                if (!inc_dep_push(builder, dep)) return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static cns_result_t inc_build_index(cns_shacl_dependency_index_t *index,
+                                    const cns_shape_t **shapes,
+                                    size_t shape_count) {
+    inc_dep_builder_t builder = {0};
+
+    for (size_t i = 0; i < shape_count; i++) {
+        if (!shapes[i] || (shapes[i]->flags & CNS_SHAPE_FLAG_DEACTIVATED)) {
+            continue;
+        }
+        if (!inc_collect_shape_deps(&builder, shapes[i], index->rdf_type)) {
+            free(builder.items);
+            return CNS_ERROR_MEMORY;
+        }
+    }
+
+    qsort(builder.items, builder.count, sizeof(cns_shacl_dependency_t), inc_dep_compare);
+
+    // Count distinct predicates to size the table at <= 50% load
+    size_t predicates = 0;
+    for (size_t i = 0; i < builder.count; i++) {
+        if (i == 0 || inc_dep_compare(&builder.items[i - 1], &builder.items[i]) != 0) {
+            predicates++;
+        }
+    }
+
+    size_t buckets = 16;
+    while (buckets < predicates * 2) {
+        buckets <<= 1;
+    }
+
+    index->range_start = malloc(buckets * sizeof(uint32_t));
+    index->range_count = calloc(buckets, sizeof(uint32_t));
+    if (INC_UNLIKELY(!index->range_start || !index->range_count)) {
+        free(builder.items);
+        free(index->range_start);
+        free(index->range_count);
+        return CNS_ERROR_MEMORY;
+    }
+    memset(index->range_start, 0xFF, buckets * sizeof(uint32_t));
+
+    index->deps = builder.items;
+    index->dep_count = builder.count;
+    index->bucket_count = buckets;
+    index->predicate_count = predicates;
+    index->max_fanout = 0;
+
+    size_t mask = buckets - 1;
+    size_t i = 0;
+    while (i < builder.count) {
+        size_t j = i + 1;
+        while (j < builder.count && inc_dep_compare(&builder.items[i], &builder.items[j]) == 0) {
+            j++;
+        }
+
+        size_t bucket = builder.items[i].predicate.hash & mask;
+        while (index->range_start[bucket] != INC_EMPTY_BUCKET) {
+            bucket = (bucket + 1) & mask;
+        }
+        index->range_start[bucket] = (uint32_t)i;
+        index->range_count[bucket] = (uint32_t)(j - i);
+
+        if (j - i > index->max_fanout) {
+            index->max_fanout = j - i;
+        }
+        i = j;
+    }
+
+    index->memory_usage = builder.capacity * sizeof(cns_shacl_dependency_t) +
+                          buckets * 2 * sizeof(uint32_t);
+    return CNS_OK;
+}
+
+// Returns the contiguous dependency range for predicate (count 0 if none)
+static const cns_shacl_dependency_t* inc_index_lookup(const cns_shacl_dependency_index_t *index,
+                                                      cns_string_ref_t predicate,
+                                                      size_t *count) {
+    size_t mask = index->bucket_count - 1;
+    size_t bucket = predicate.hash & mask;
+
+    while (index->range_start[bucket] != INC_EMPTY_BUCKET) {
+        const cns_shacl_dependency_t *first = &index->deps[index->range_start[bucket]];
+        if (cns_string_ref_equal(first->predicate, predicate)) {
+            *count = index->range_count[bucket];
+            return first;
+        }
+        bucket = (bucket + 1) & mask;
+    }
+
+    *count = 0;
+    return NULL;
+}
+
+// ============================================================================
+// TARGET MEMBERSHIP
+// ============================================================================
+
+static bool inc_has_triple(const cns_graph_t *graph,
+                           const char *subject,
+                           const char *predicate,
+                           const char *object) {
+    cns_triple_t *results = NULL;
+    size_t count = 0;
+    cns_result_t result = cns_graph_find_triples(graph, subject, predicate, object,
+                                                 &results, &count);
+    return result == CNS_OK && count > 0;
+}
+
+// Targets are interpreted according to each target flag set on the shape
+static bool inc_is_focus(const cns_shacl_incremental_t *state,
+                         const cns_graph_t *graph,
+                         const cns_shape_t *shape,
+                         cns_string_ref_t node) {
+    if (shape->deactivated && !state->validator->enable_deactivated) {
+        return false;
+    }
+
+    const char *node_str = NULL;
+
+    for (size_t t = 0; t < shape->target_count; t++) {
+        cns_string_ref_t target = shape->targets[t];
+
+        if ((shape->flags & CNS_SHAPE_FLAG_TARGET_NODE) && cns_string_ref_equal(target, node)) {
+            return true;
+        }
+        if ((shape->flags & CNS_SHAPE_FLAG_TARGET_CLASS) &&
+            cns_graph_contains_triple_refs(graph, node, state->index.rdf_type, target)) {
+            return true;
+        }
+        if (shape->flags & (CNS_SHAPE_FLAG_TARGET_SUBJECTS | CNS_SHAPE_FLAG_TARGET_OBJECTS)) {
+            if (!node_str) {
+                node_str = cns_string_ref_resolve(graph->interner, node);
+                if (!node_str) return false;
+            }
+            const char *pred_str = cns_string_ref_resolve(graph->interner, target);
+            if ((shape->flags & CNS_SHAPE_FLAG_TARGET_SUBJECTS) &&
+                inc_has_triple(graph, node_str, pred_str, NULL)) {
+                return true;
+            }
+            if ((shape->flags & CNS_SHAPE_FLAG_TARGET_OBJECTS) &&
+                inc_has_triple(graph, NULL, pred_str, node_str)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// PAIR TABLE
+// ============================================================================
+
+static cns_result_t inc_pairs_grow(cns_shacl_incremental_t *state) {
+    size_t capacity = state->pair_capacity ? state->pair_capacity * 2 : INC_INITIAL_PAIRS;
+    shacl_pair_t *pairs = calloc(capacity, sizeof(shacl_pair_t));
+    if (INC_UNLIKELY(!pairs)) {
+        return CNS_ERROR_MEMORY;
+    }
+
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < state->pair_capacity; i++) {
+        shacl_pair_t *old = &state->pairs[i];
+        if (!old->used) continue;
+        size_t slot = inc_pair_hash(old->focus, old->shape) & mask;
+        while (pairs[slot].used) {
+            slot = (slot + 1) & mask;
+        }
+        pairs[slot] = *old;
+    }
+
+    free(state->pairs);
+    state->pairs = pairs;
+    state->pair_capacity = capacity;
+    return CNS_OK;
+}
+
+// Find pair; inserts a fresh one when create is set. NULL if absent/OOM.
+static shacl_pair_t* inc_pair_lookup(cns_shacl_incremental_t *state,
+                                     cns_string_ref_t focus,
+                                     const cns_shape_t *shape,
+                                     bool create) {
+    if (create && (state->pair_count + 1) * 2 > state->pair_capacity) {
+        if (inc_pairs_grow(state) != CNS_OK) {
+            return NULL;
+        }
+    }
+
+    size_t mask = state->pair_capacity - 1;
+    size_t slot = inc_pair_hash(focus, shape) & mask;
+
+    while (state->pairs[slot].used) {
+        shacl_pair_t *pair = &state->pairs[slot];
+        if (pair->shape == shape && cns_string_ref_equal(pair->focus, focus)) {
+            return pair;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (!create) {
+        return NULL;
+    }
+
+    shacl_pair_t *pair = &state->pairs[slot];
+    memset(pair, 0, sizeof(*pair));
+    pair->focus = focus;
+    pair->shape = shape;
+    pair->used = true;
+    state->pair_count++;
+    return pair;
+}
+
+// ============================================================================
+// PAIR REVALIDATION
+// ============================================================================
+
+// Drop a pair's results from the persistent report and recycle them
+static void inc_pair_retire(cns_shacl_incremental_t *state, shacl_pair_t *pair) {
+    cns_validation_report_t *report = &state->report;
+
+    report->result_count -= pair->result_count;
+    report->info_count -= pair->info_count;
+    report->warning_count -= pair->warning_count;
+    report->violation_count -= pair->violation_count;
+    report->constraints_checked -= pair->constraints_checked;
+
+    if (pair->results) {
+        pair->tail->next = report->free_results;
+        report->free_results = pair->results;
+    }
+
+    pair->results = NULL;
+    pair->tail = NULL;
+    pair->result_count = 0;
+    pair->info_count = 0;
+    pair->warning_count = 0;
+    pair->violation_count = 0;
+    pair->constraints_checked = 0;
+}
+
+static cns_result_t inc_pair_evaluate(cns_shacl_incremental_t *state,
+                                      const cns_graph_t *graph,
+                                      shacl_pair_t *pair) {
+    cns_validation_report_t *report = &state->report;
+
+    // Scratch report shares the persistent arena and free list
+    cns_validation_report_t scratch;
+    memset(&scratch, 0, sizeof(scratch));
+    scratch.conforms = true;
+    scratch.arena = report->arena;
+    scratch.free_results = report->free_results;
+
+    cns_result_t result = cns_shacl_validate_node_shape(
+        state->validator, graph, pair->focus, pair->shape, &scratch);
+
+    report->free_results = scratch.free_results;
+
+    if (INC_UNLIKELY(result != CNS_OK)) {
+        return result;
+    }
+
+    pair->results = scratch.results;
+    pair->tail = scratch.results_tail;
+    pair->result_count = scratch.result_count;
+    pair->info_count = scratch.info_count;
+    pair->warning_count = scratch.warning_count;
+    pair->violation_count = scratch.violation_count;
+    pair->constraints_checked = scratch.constraints_checked;
+
+    report->result_count += scratch.result_count;
+    report->info_count += scratch.info_count;
+    report->warning_count += scratch.warning_count;
+    report->violation_count += scratch.violation_count;
+    report->constraints_checked += scratch.constraints_checked;
+    return CNS_OK;
+}
+
+// Re-evaluate (focus, shape) at most once per delta
+static cns_result_t inc_touch(cns_shacl_incremental_t *state,
+                              const cns_graph_t *graph,
+                              cns_string_ref_t focus,
+                              const cns_shape_t *shape) {
+    shacl_pair_t *pair = inc_pair_lookup(state, focus, shape, false);
+    if (pair && pair->epoch == state->epoch) {
+        return CNS_OK;
+    }
+
+    bool is_focus = inc_is_focus(state, graph, shape, focus);
+
+    if (!pair) {
+        if (!is_focus) {
+            return CNS_OK; // Never tracked, still not a focus node
+        }
+        pair = inc_pair_lookup(state, focus, shape, true);
+        if (INC_UNLIKELY(!pair)) {
+            return CNS_ERROR_MEMORY;
+        }
+    }
+
+    pair->epoch = state->epoch;
+    inc_pair_retire(state, pair);
+
+    if (!is_focus) {
+        state->stats.pairs_retired++;
+        return CNS_OK;
+    }
+
+    state->stats.pairs_revalidated++;
+    return inc_pair_evaluate(state, graph, pair);
+}
+
+// Map one changed triple to candidate focus nodes through the index
+static cns_result_t inc_process_triple(cns_shacl_incremental_t *state,
+                                       const cns_graph_t *graph,
+                                       const cns_triple_t *triple) {
+    size_t count;
+    const cns_shacl_dependency_t *deps = inc_index_lookup(&state->index, triple->predicate, &count);
+
+    for (size_t i = 0; i < count; i++) {
+        const cns_shacl_dependency_t *dep = &deps[i];
+
+        if (dep->object_filter.hash != 0 &&
+            !cns_string_ref_equal(dep->object_filter, triple->object)) {
+            continue;
+        }
+
+        state->stats.dependencies_matched++;
+        cns_result_t result = CNS_OK;
+
+        switch (dep->role) {
+            case CNS_SHACL_DEP_SUBJECT:
+                result = inc_touch(state, graph, triple->subject, dep->shape);
+                break;
+
+            case CNS_SHACL_DEP_OBJECT:
+                result = inc_touch(state, graph, triple->object, dep->shape);
+                break;
+
+            case CNS_SHACL_DEP_VALUE_CLASS: {
+                // Subject changed class; revisit every focus node that
+                // reaches it through the property path
+                const char *value_str = cns_string_ref_resolve(graph->interner, triple->subject);
+                const char *path_str = cns_string_ref_resolve(graph->interner, dep->via_path);
+                if (!value_str || !path_str) {
+                    break;
+                }
+
+                cns_triple_t *holders = NULL;
+                size_t holder_count = 0;
+                if (dep->via_inverse) {
+                    result = cns_graph_find_triples(graph, value_str, path_str, NULL,
+                                                    &holders, &holder_count);
+                } else {
+                    result = cns_graph_find_triples(graph, NULL, path_str, value_str,
+                                                    &holders, &holder_count);
+                }
+                if (result != CNS_OK) {
+                    result = CNS_OK; // No holders
+                    break;
+                }
+
+                for (size_t h = 0; h < holder_count && result == CNS_OK; h++) {
+                    cns_string_ref_t focus = dep->via_inverse ? holders[h].object
+                                                              : holders[h].subject;
+                    result = inc_touch(state, graph, focus, dep->shape);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (INC_UNLIKELY(result != CNS_OK)) {
+            return result;
+        }
+    }
+
+    return CNS_OK;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+cns_shacl_incremental_t* cns_shacl_incremental_create(
+    cns_shacl_validator_t *validator,
+    const cns_graph_t *data_graph,
+    const cns_shape_t **shapes,
+    size_t shape_count,
+    cns_arena_t *result_arena
+) {
+    if (INC_UNLIKELY(!validator || !data_graph || (!shapes && shape_count > 0))) {
+        return NULL;
+    }
+
+    cns_shacl_incremental_t *state = calloc(1, sizeof(cns_shacl_incremental_t));
+    if (INC_UNLIKELY(!state)) {
+        return NULL;
+    }
+
+    state->validator = validator;
+    state->index.rdf_type = cns_interner_intern(validator->interner, INC_RDF_TYPE);
+    state->report.conforms = true;
+    state->report.arena = result_arena;
+
+    if (inc_build_index(&state->index, shapes, shape_count) != CNS_OK ||
+        inc_pairs_grow(state) != CNS_OK) {
+        cns_shacl_incremental_destroy(state);
+        return NULL;
+    }
+
+    // Initial full validation seeds every (focus, shape) pair
+    cns_tick_t start = cns_get_tick_count();
+    state->epoch = 1;
+
+    for (size_t n = 0; n < data_graph->node_count; n++) {
+        cns_string_ref_t node = data_graph->nodes[n].iri;
+        for (size_t s = 0; s < shape_count; s++) {
+            if (!shapes[s]) continue;
+            if (inc_touch(state, data_graph, node, shapes[s]) != CNS_OK) {
+                cns_shacl_incremental_destroy(state);
+                return NULL;
+            }
+        }
+        state->report.nodes_validated++;
+    }
+
+    state->report.conforms = (state->report.violation_count == 0);
+    state->report.validation_time_ticks = cns_get_tick_count() - start;
+    return state;
+}
+
+void cns_shacl_incremental_destroy(cns_shacl_incremental_t *state) {
+    if (!state) {
+        return;
+    }
+
+    // Result records live in the caller's arena
+    free(state->index.deps);
+    free(state->index.range_start);
+    free(state->index.range_count);
+    free(state->pairs);
+    free(state);
+}
+
+cns_result_t cns_shacl_incremental_apply(
+    cns_shacl_incremental_t *state,
+    const cns_graph_t *data_graph,
+    const cns_shacl_delta_t *delta
+) {
+    if (INC_UNLIKELY(!state || !data_graph || !delta)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+
+    cns_tick_t start = cns_get_tick_count();
+    state->epoch++;
+
+    // Deletions and insertions map through the same index: the graph already
+    // holds the post-delta state, so each touched pair is simply re-evaluated
+    for (size_t i = 0; i < delta->deleted_count; i++) {
+        cns_result_t result = inc_process_triple(state, data_graph, &delta->deleted[i]);
+        if (INC_UNLIKELY(result != CNS_OK)) return result;
+    }
+    for (size_t i = 0; i < delta->inserted_count; i++) {
+        cns_result_t result = inc_process_triple(state, data_graph, &delta->inserted[i]);
+        if (INC_UNLIKELY(result != CNS_OK)) return result;
+    }
+
+    cns_tick_t elapsed = cns_get_tick_count() - start;
+
+    state->report.conforms = (state->report.violation_count == 0);
+    state->report.validation_time_ticks = elapsed;
+
+    state->stats.deltas_applied++;
+    state->stats.triples_processed += delta->inserted_count + delta->deleted_count;
+    state->stats.total_apply_ticks += elapsed;
+    return CNS_OK;
+}
+
+const cns_validation_report_t* cns_shacl_incremental_report(cns_shacl_incremental_t *state) {
+    if (INC_UNLIKELY(!state)) {
+        return NULL;
+    }
+
+    // Stitch per-pair chains into one list; chains themselves are not copied
+    cns_validation_report_t *report = &state->report;
+    report->results = NULL;
+    report->results_tail = NULL;
+
+    for (size_t i = 0; i < state->pair_capacity; i++) {
+        shacl_pair_t *pair = &state->pairs[i];
+        if (!pair->used || !pair->results) continue;
+
+        if (report->results_tail) {
+            report->results_tail->next = pair->results;
+        } else {
+            report->results = pair->results;
+        }
+        report->results_tail = pair->tail;
+        pair->tail->next = NULL;
+    }
+
+    return report;
+}
+
+const cns_shacl_dependency_index_t* cns_shacl_incremental_index(const cns_shacl_incremental_t *state) {
+    return state ? &state->index : NULL;
+}
+
+cns_result_t cns_shacl_incremental_get_stats(
+    const cns_shacl_incremental_t *state,
+    cns_shacl_incremental_stats_t *stats
+) {
+    if (INC_UNLIKELY(!state || !stats)) {
+        return CNS_ERROR_INVALID_ARG;
+    }
+
+    *stats = state->stats;
+    return CNS_OK;
+}
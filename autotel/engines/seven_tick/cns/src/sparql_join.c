@@ -0,0 +1,439 @@
+/**
+ * SPARQL Join Kernel - Radix-partitioned hash join
+ *
+ * Joins of millions of bindings are bound by cache misses when the hash table
+ * outgrows the caches. Both relations are first scattered by the top bits of the
+ * key hash into partitions sized so each build table fits in L2; partitions are then
+ * built and probed one at a time, handed out to threads from a shared counter.
+ */
+
+#define _POSIX_C_SOURCE 200809L // sysconf
+
+#include "cns/sparql_join.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define JOIN_EMPTY 0xFFFFFFFFu              // Free slot tag; keys equal to it are kept aside
+#define JOIN_BUCKET_SLOTS 4                 // Tags compared in one SIMD operation
+#define JOIN_TABLE_BYTES_PER_TUPLE 16       // Half-full buckets of 8-byte slots
+#define JOIN_MAX_RADIX_BITS 12              // More partitions thrash the TLB while scattering
+#define JOIN_MIN_TUPLES_PER_THREAD (1u << 16)
+#define JOIN_BATCH 16                       // Probes hashed and prefetched together
+#define JOIN_OUTPUT_BUFFER 512              // Pairs buffered per thread before reserving output
+
+// Bucket of four slots: 32-bit tag (the key) plus 32-bit payload, half a cache line
+typedef struct __attribute__((aligned(32))) {
+    uint32_t tag[JOIN_BUCKET_SLOTS];
+    uint32_t payload[JOIN_BUCKET_SLOTS];
+} join_bucket;
+
+// Relation as scattered into partitions
+typedef struct {
+    const uint32_t* keys;
+    const uint32_t* values;    // NULL: the keys are the values
+    size_t count;
+    const uint32_t* part_keys; // Partition order; the input itself when unpartitioned
+    const uint32_t* part_values;
+    uint32_t* scatter_keys;
+    uint32_t* scatter_values;
+    size_t* offsets;           // partitions + 1 entries
+    size_t* cursors;           // threads x partitions write positions
+} join_relation;
+
+typedef struct {
+    join_relation build;
+    join_relation probe;
+    uint32_t radix_bits;
+    uint32_t partitions;
+    uint32_t threads;
+    bool semi;
+    uint32_t* out_build;
+    uint32_t* out_probe;
+    size_t capacity;
+    atomic_size_t emitted;      // Output cursor; keeps counting past capacity
+    atomic_uint next_partition;
+    atomic_bool failed;
+} join_state;
+
+// Per-thread build table and output staging
+typedef struct {
+    join_state* state;
+    uint32_t index;
+    join_bucket* buckets;
+    size_t bucket_capacity;
+    uint32_t* spill;            // Payloads of build keys equal to JOIN_EMPTY
+    size_t spill_count;
+    size_t spill_capacity;
+    uint32_t out_build[JOIN_OUTPUT_BUFFER];
+    uint32_t out_probe[JOIN_OUTPUT_BUFFER];
+    uint32_t out_count;
+} join_worker;
+
+// Fibonacci hash: top bits pick the partition, the bits below them the bucket
+static inline uint64_t join_hash(uint32_t key) {
+    return (uint64_t)key * 0x9E3779B97F4A7C15ULL;
+}
+
+static inline uint32_t join_partition(uint64_t hash, uint32_t radix_bits) {
+    return radix_bits ? (uint32_t)(hash >> (64 - radix_bits)) : 0;
+}
+
+static inline size_t join_bucket_index(uint64_t hash, uint32_t radix_bits, uint32_t bucket_bits) {
+    return (size_t)((hash << radix_bits) >> (64 - bucket_bits));
+}
+
+static void join_chunk(const join_worker* worker, size_t count, size_t* begin, size_t* end) {
+    *begin = count * worker->index / worker->state->threads;
+    *end = count * (worker->index + 1) / worker->state->threads;
+}
+
+// Phase 1: per-thread partition sizes
+static void join_histogram(join_worker* worker) {
+    join_state* state = worker->state;
+    join_relation* relations[2] = {&state->build, &state->probe};
+    for (int r = 0; r < 2; r++) {
+        join_relation* relation = relations[r];
+        size_t* counts = relation->cursors + (size_t)worker->index * state->partitions;
+        size_t begin, end;
+        join_chunk(worker, relation->count, &begin, &end);
+        for (size_t i = begin; i < end; i++) {
+            counts[join_partition(join_hash(relation->keys[i]), state->radix_bits)]++;
+        }
+    }
+}
+
+// Phase 2: scatter each thread's chunk into its reserved ranges
+static void join_scatter(join_worker* worker) {
+    join_state* state = worker->state;
+    join_relation* relations[2] = {&state->build, &state->probe};
+    for (int r = 0; r < 2; r++) {
+        join_relation* relation = relations[r];
+        size_t* cursors = relation->cursors + (size_t)worker->index * state->partitions;
+        size_t begin, end;
+        join_chunk(worker, relation->count, &begin, &end);
+        for (size_t i = begin; i < end; i++) {
+            uint32_t key = relation->keys[i];
+            size_t position = cursors[join_partition(join_hash(key), state->radix_bits)]++;
+            relation->scatter_keys[position] = key;
+            if (relation->values) relation->scatter_values[position] = relation->values[i];
+        }
+    }
+}
+
+// Reserve output space and copy the staged pairs
+static void join_flush(join_worker* worker) {
+    join_state* state = worker->state;
+    size_t start = atomic_fetch_add(&state->emitted, worker->out_count);
+    if (start < state->capacity) {
+        size_t n = state->capacity - start < worker->out_count ? state->capacity - start : worker->out_count;
+        if (state->out_build) memcpy(state->out_build + start, worker->out_build, n * sizeof(uint32_t));
+        if (state->out_probe) memcpy(state->out_probe + start, worker->out_probe, n * sizeof(uint32_t));
+    }
+    worker->out_count = 0;
+}
+
+static inline void join_emit(join_worker* worker, uint32_t build_value, uint32_t probe_value) {
+    worker->out_build[worker->out_count] = build_value;
+    worker->out_probe[worker->out_count] = probe_value;
+    if (++worker->out_count == JOIN_OUTPUT_BUFFER) join_flush(worker);
+}
+
+// Build one partition's table at most half full
+static bool join_build(join_worker* worker, const uint32_t* keys, const uint32_t* values, size_t count,
+                       uint32_t* bucket_bits) {
+    uint32_t radix_bits = worker->state->radix_bits;
+    uint32_t bits = 1;
+    while (((size_t)JOIN_BUCKET_SLOTS << bits) < count * 2) bits++;
+    size_t buckets = (size_t)1 << bits;
+
+    if (buckets > worker->bucket_capacity) {
+        free(worker->buckets);
+        worker->buckets = aligned_alloc(64, buckets * sizeof(join_bucket));
+        worker->bucket_capacity = worker->buckets ? buckets : 0;
+        if (!worker->buckets) return false;
+    }
+    memset(worker->buckets, 0xFF, buckets * sizeof(join_bucket));
+    worker->spill_count = 0;
+
+    size_t mask = buckets - 1;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t key = keys[i];
+        uint32_t payload = values ? values[i] : key;
+        if (key == JOIN_EMPTY) {
+            if (worker->spill_count == worker->spill_capacity) {
+                size_t capacity = worker->spill_capacity ? worker->spill_capacity * 2 : 16;
+                uint32_t* spill = realloc(worker->spill, capacity * sizeof(uint32_t));
+                if (!spill) return false;
+                worker->spill = spill;
+                worker->spill_capacity = capacity;
+            }
+            worker->spill[worker->spill_count++] = payload;
+            continue;
+        }
+
+        // Linear probing over buckets: the first free slot at or after the home bucket
+        size_t b = join_bucket_index(join_hash(key), radix_bits, bits);
+        for (;;) {
+            join_bucket* bucket = &worker->buckets[b];
+            int slot = 0;
+            while (slot < JOIN_BUCKET_SLOTS && bucket->tag[slot] != JOIN_EMPTY) slot++;
+            if (slot < JOIN_BUCKET_SLOTS) {
+                bucket->tag[slot] = key;
+                bucket->payload[slot] = payload;
+                break;
+            }
+            b = (b + 1) & mask;
+        }
+    }
+
+    *bucket_bits = bits;
+    return true;
+}
+
+// Probe one partition in batches: hash and prefetch a batch, then compare four tags at a time
+static void join_probe(join_worker* worker, const uint32_t* keys, const uint32_t* values, size_t count,
+                       uint32_t bucket_bits) {
+    uint32_t radix_bits = worker->state->radix_bits;
+    bool semi = worker->state->semi;
+    const join_bucket* buckets = worker->buckets;
+    size_t mask = ((size_t)1 << bucket_bits) - 1;
+    size_t home[JOIN_BATCH];
+
+    for (size_t base = 0; base < count; base += JOIN_BATCH) {
+        size_t n = count - base < JOIN_BATCH ? count - base : JOIN_BATCH;
+        for (size_t j = 0; j < n; j++) {
+            home[j] = join_bucket_index(join_hash(keys[base + j]), radix_bits, bucket_bits);
+            __builtin_prefetch(&buckets[home[j]], 0, 3);
+        }
+
+        for (size_t j = 0; j < n; j++) {
+            uint32_t key = keys[base + j];
+            uint32_t value = values ? values[base + j] : key;
+
+            if (key == JOIN_EMPTY) {
+                for (size_t s = 0; s < worker->spill_count; s++) {
+                    join_emit(worker, worker->spill[s], value);
+                    if (semi) break;
+                }
+                continue;
+            }
+
+#if defined(__SSE2__)
+            const __m128i needle = _mm_set1_epi32((int)key);
+            const __m128i empty = _mm_set1_epi32(-1);
+#endif
+            size_t b = home[j];
+            for (;;) {
+                const join_bucket* bucket = &buckets[b];
+#if defined(__SSE2__)
+                __m128i tags = _mm_load_si128((const __m128i*)bucket->tag);
+                unsigned hits = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(tags, needle)));
+                unsigned free_slots = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(tags, empty)));
+#else
+                unsigned hits = 0, free_slots = 0;
+                for (int slot = 0; slot < JOIN_BUCKET_SLOTS; slot++) {
+                    hits |= (unsigned)(bucket->tag[slot] == key) << slot;
+                    free_slots |= (unsigned)(bucket->tag[slot] == JOIN_EMPTY) << slot;
+                }
+#endif
+                // About half the probes of a typical join match, unpredictably: the first match is
+                // stored unconditionally and kept only if real. Duplicate build keys take the loop.
+                unsigned matched = hits != 0;
+                worker->out_build[worker->out_count] = bucket->payload[__builtin_ctz(hits | 0x10) & 3];
+                worker->out_probe[worker->out_count] = value;
+                worker->out_count += matched;
+                if (worker->out_count == JOIN_OUTPUT_BUFFER) join_flush(worker);
+                for (hits &= hits - 1; hits && !semi; hits &= hits - 1) {
+                    join_emit(worker, bucket->payload[__builtin_ctz(hits)], value);
+                }
+                // Insertion fills buckets in order, so a bucket with room ends the chain
+                if (free_slots | (semi & matched)) break;
+                b = (b + 1) & mask;
+            }
+        }
+    }
+}
+
+// Phase 3: build and probe partitions until none are left
+static void join_partitions(join_worker* worker) {
+    join_state* state = worker->state;
+    for (;;) {
+        uint32_t p = atomic_fetch_add(&state->next_partition, 1);
+        if (p >= state->partitions || atomic_load(&state->failed)) break;
+
+        size_t build_begin = state->build.offsets[p], build_end = state->build.offsets[p + 1];
+        size_t probe_begin = state->probe.offsets[p], probe_end = state->probe.offsets[p + 1];
+        if (build_begin == build_end || probe_begin == probe_end) continue;
+
+        uint32_t bucket_bits;
+        if (!join_build(worker, state->build.part_keys + build_begin,
+                        state->build.part_values ? state->build.part_values + build_begin : NULL,
+                        build_end - build_begin, &bucket_bits)) {
+            atomic_store(&state->failed, true);
+            break;
+        }
+        join_probe(worker, state->probe.part_keys + probe_begin,
+                   state->probe.part_values ? state->probe.part_values + probe_begin : NULL,
+                   probe_end - probe_begin, bucket_bits);
+    }
+    if (worker->out_count) join_flush(worker);
+}
+
+typedef void (*join_phase)(join_worker*);
+
+typedef struct {
+    join_worker* worker;
+    join_phase phase;
+} join_task;
+
+static void* join_task_run(void* argument) {
+    join_task* task = argument;
+    task->phase(task->worker);
+    return NULL;
+}
+
+// Run a phase on every worker; the caller takes worker 0 and any thread that failed to start
+static void join_run(join_worker* workers, uint32_t threads, join_phase phase) {
+    pthread_t handles[threads];
+    join_task tasks[threads];
+    bool started[threads];
+
+    for (uint32_t t = 1; t < threads; t++) {
+        tasks[t].worker = &workers[t];
+        tasks[t].phase = phase;
+        started[t] = pthread_create(&handles[t], NULL, join_task_run, &tasks[t]) == 0;
+    }
+    phase(&workers[0]);
+    for (uint32_t t = 1; t < threads; t++) {
+        if (!started[t]) phase(&workers[t]);
+    }
+    for (uint32_t t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(handles[t], NULL);
+    }
+}
+
+// Turn per-thread counts into write positions and record partition bounds
+static void join_offsets(join_relation* relation, uint32_t partitions, uint32_t threads) {
+    size_t position = 0;
+    for (uint32_t p = 0; p < partitions; p++) {
+        relation->offsets[p] = position;
+        for (uint32_t t = 0; t < threads; t++) {
+            size_t* cursor = &relation->cursors[(size_t)t * partitions + p];
+            size_t count = *cursor;
+            *cursor = position;
+            position += count;
+        }
+    }
+    relation->offsets[partitions] = position;
+}
+
+static bool join_relation_init(join_relation* relation, const uint32_t* keys, const uint32_t* values,
+                               size_t count, uint32_t partitions, uint32_t threads, bool partitioned) {
+    relation->keys = keys;
+    relation->values = values;
+    relation->count = count;
+    relation->offsets = calloc((size_t)partitions + 1, sizeof(size_t));
+    if (!relation->offsets) return false;
+
+    if (!partitioned) {
+        relation->part_keys = keys;
+        relation->part_values = values;
+        relation->offsets[1] = count;
+        return true;
+    }
+
+    relation->cursors = calloc((size_t)threads * partitions, sizeof(size_t));
+    relation->scatter_keys = malloc((count ? count : 1) * sizeof(uint32_t));
+    if (values) relation->scatter_values = malloc((count ? count : 1) * sizeof(uint32_t));
+    relation->part_keys = relation->scatter_keys;
+    relation->part_values = relation->scatter_values;
+    return relation->cursors && relation->scatter_keys && (!values || relation->scatter_values);
+}
+
+static void join_relation_free(join_relation* relation) {
+    free(relation->offsets);
+    free(relation->cursors);
+    free(relation->scatter_keys);
+    free(relation->scatter_values);
+}
+
+size_t s7t_join(const uint32_t* build_keys, const uint32_t* build_values, size_t build_count,
+                const uint32_t* probe_keys, const uint32_t* probe_values, size_t probe_count,
+                uint32_t* out_build, uint32_t* out_probe, size_t capacity,
+                const s7t_join_options* options) {
+    if (!build_keys || !probe_keys || build_count == 0 || probe_count == 0) return 0;
+
+    // Threads only for inputs large enough to amortize starting them
+    uint32_t threads = options && options->threads ? options->threads : 0;
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (uint32_t)online : 1;
+    }
+    size_t useful = (build_count + probe_count) / JOIN_MIN_TUPLES_PER_THREAD;
+    if (threads > useful) threads = useful > 0 ? (uint32_t)useful : 1;
+
+    // Enough partitions for each build table to fit the budget, and for threads to share
+    size_t budget = options && options->partition_bytes ? options->partition_bytes : S7T_JOIN_L2_BYTES;
+    uint32_t radix_bits = 0;
+    if (budget == SIZE_MAX) {
+        threads = 1;
+    } else {
+        while (radix_bits < JOIN_MAX_RADIX_BITS &&
+               (build_count * JOIN_TABLE_BYTES_PER_TUPLE >> radix_bits) > budget) radix_bits++;
+        while (threads > 1 && radix_bits < JOIN_MAX_RADIX_BITS && (1u << radix_bits) < threads * 4) radix_bits++;
+    }
+
+    join_state state = {0};
+    state.radix_bits = radix_bits;
+    state.partitions = 1u << radix_bits;
+    state.threads = threads;
+    state.semi = options && options->semi;
+    state.out_build = out_build;
+    state.out_probe = out_probe;
+    state.capacity = capacity;
+    atomic_init(&state.emitted, 0);
+    atomic_init(&state.next_partition, 0);
+    atomic_init(&state.failed, false);
+
+    join_worker* workers = calloc(threads, sizeof(join_worker));
+    bool partitioned = radix_bits > 0;
+    bool ok = workers &&
+              join_relation_init(&state.build, build_keys, build_values, build_count, state.partitions, threads,
+                                 partitioned) &&
+              join_relation_init(&state.probe, probe_keys, probe_values, probe_count, state.partitions, threads,
+                                 partitioned);
+
+    if (ok) {
+        for (uint32_t t = 0; t < threads; t++) {
+            workers[t].state = &state;
+            workers[t].index = t;
+        }
+        if (partitioned) {
+            join_run(workers, threads, join_histogram);
+            join_offsets(&state.build, state.partitions, threads);
+            join_offsets(&state.probe, state.partitions, threads);
+            join_run(workers, threads, join_scatter);
+        }
+        join_run(workers, threads, join_partitions);
+        ok = !atomic_load(&state.failed);
+    }
+
+    if (workers) {
+        for (uint32_t t = 0; t < threads; t++) {
+            free(workers[t].buckets);
+            free(workers[t].spill);
+        }
+    }
+    free(workers);
+    join_relation_free(&state.build);
+    join_relation_free(&state.probe);
+
+    return ok ? atomic_load(&state.emitted) : 0;
+}
@@ -7,6 +7,7 @@
 #include "../include/s7t.h"
 #include "../include/ontology_ids.h"
 #include "../sparql_queries.h"
+#include "cns/sparql_join.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -137,6 +138,7 @@ int s7t_simd_filter_gt_f32(float* values, int count, float threshold, uint32_t*
 }
 
 // 7-tick optimized hash join kernel
+// Semi-join: each left value that occurs in right, once, via the partitioned hash join
 int s7t_hash_join(CNSSparqlEngine* engine, uint32_t* left, int left_count, 
                   uint32_t* right, int right_count, uint32_t* results) {
     (void)engine; // Not used in this implementation
@@ -147,30 +149,10 @@ int s7t_hash_join(CNSSparqlEngine* engine, uint32_t* left, int left_count,
         return 0;
     }
     
-    // For small datasets, use nested loop join (cache-friendly)
-    // For larger datasets, this would be replaced with hash table
-    if (left_count <= 64 && right_count <= 64) {
-        // Optimized nested loop for small datasets
-        for (int i = 0; i < left_count; i++) {
-            uint32_t left_val = left[i];
-            for (int j = 0; j < right_count; j++) {
-                if (S7T_UNLIKELY(left_val == right[j])) {
-                    results[result_count++] = left_val;
-                    break; // Avoid duplicates
-                }
-            }
-        }
-    } else {
-        // Simple implementation - would be optimized with hash table for production
-        for (int i = 0; i < left_count; i++) {
-            for (int j = 0; j < right_count; j++) {
-                if (S7T_UNLIKELY(left[i] == right[j])) {
-                    results[result_count++] = left[i];
-                    break;
-                }
-            }
-        }
-    }
+    // Build on right, probe with left so the output holds left values
+    s7t_join_options options = {.semi = true};
+    result_count = (int)s7t_join(right, NULL, (size_t)right_count, left, NULL, (size_t)left_count,
+                                 NULL, results, (size_t)left_count, &options);
     
     uint64_t elapsed = s7t_cycles() - start;
     update_metrics(&g_join_metrics, elapsed);
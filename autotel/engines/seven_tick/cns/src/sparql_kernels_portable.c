@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include "cns/sparql_join.h"
 
 // Cache line size for alignment
 #define CACHE_LINE_SIZE 64
@@ -49,12 +50,6 @@ typedef struct __attribute__((aligned(CACHE_LINE_SIZE))) {
     uint32_t type_id;
 } s7t_triple;
 
-// Hash table entry for joins
-typedef struct {
-    uint32_t key;
-    uint32_t value;
-} s7t_hash_entry;
-
 /**
  * s7t_scan_by_type - Scan triples by type (≤2 cycles per triple)
  * 
@@ -206,10 +201,13 @@ static inline uint32_t s7t_simd_filter_gt_f32(
 /**
  * s7t_hash_join - Hash join implementation (≤3 cycles per probe)
  * 
- * Uses power-of-2 hash table with linear probing
+ * Radix-partitioned: partitions sized for L2, bucketized linear probing over
+ * 32-bit tag + payload slots, batched SIMD probes, threads for large inputs.
+ * Every matching pair is emitted, grouped by partition; outputs hold right_count
+ * pairs, which covers every match when left keys are unique.
  */
 __attribute__((hot))
-static inline uint32_t s7t_hash_join(
+static uint32_t s7t_hash_join(
     const uint32_t* __restrict__ left_keys,
     const uint32_t* __restrict__ left_values,
     uint32_t left_count,
@@ -219,54 +217,10 @@ static inline uint32_t s7t_hash_join(
     uint32_t* __restrict__ output_left,
     uint32_t* __restrict__ output_right
 ) {
-    // Hash table size (power of 2 for fast modulo)
-    const uint32_t table_size = 1 << 16; // 64K entries
-    const uint32_t mask = table_size - 1;
-    
-    // Allocate hash table (cache-aligned)
-    s7t_hash_entry* table = (s7t_hash_entry*)ALIGNED_ALLOC(
-        table_size * sizeof(s7t_hash_entry)
-    );
-    memset(table, 0xFF, table_size * sizeof(s7t_hash_entry));
-    
-    // Build phase - insert left side
-    for (uint32_t i = 0; i < left_count; i++) {
-        uint32_t key = left_keys[i];
-        uint32_t hash = (key * 0x9E3779B9) & mask; // Fibonacci hash
-        
-        // Linear probing
-        while (table[hash].key != 0xFFFFFFFF) {
-            hash = (hash + 1) & mask;
-        }
-        
-        table[hash].key = key;
-        table[hash].value = left_values[i];
-    }
-    
-    // Probe phase - lookup right side
-    uint32_t matches = 0;
-    for (uint32_t i = 0; i < right_count; i++) {
-        uint32_t key = right_keys[i];
-        uint32_t hash = (key * 0x9E3779B9) & mask;
-        
-        // Prefetch likely locations
-        PREFETCH(&table[(hash + 1) & mask]);
-        PREFETCH(&table[(hash + 2) & mask]);
-        
-        // Linear probing with early exit
-        while (table[hash].key != 0xFFFFFFFF) {
-            if (LIKELY(table[hash].key == key)) {
-                output_left[matches] = table[hash].value;
-                output_right[matches] = right_values[i];
-                matches++;
-                break;
-            }
-            hash = (hash + 1) & mask;
-        }
-    }
-    
-    free(table);
-    return matches;
+    size_t matches = s7t_join(left_keys, left_values, left_count,
+                              right_keys, right_values, right_count,
+                              output_left, output_right, right_count, NULL);
+    return matches < right_count ? (uint32_t)matches : right_count;
 }
 
 /**
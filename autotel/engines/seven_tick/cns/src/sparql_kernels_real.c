@@ -11,6 +11,7 @@
 #include "ontology_ids.h"
 #include "sparql_queries.h"
 #include "../include/s7t.h"
+#include "cns/sparql_join.h"
 
 // SIMD includes based on architecture
 #ifdef __x86_64__
@@ -205,7 +206,8 @@ S7T_HOT int s7t_simd_filter_gt_f32(float* values, int count, float threshold, ui
 /*
  * s7t_hash_join - Real hash join implementation
  * Target: 3-4 cycles per join operation
- * Uses optimized hash table with linear probing
+ * Semi-join of right against left: each right key found in left, once.
+ * Radix-partitioned with L2-sized linear probing tables (see sparql_join.c)
  */
 S7T_HOT int s7t_hash_join(CNSSparqlEngine* engine, uint32_t* left, int left_count, 
                           uint32_t* right, int right_count, uint32_t* results) {
@@ -215,44 +217,9 @@ S7T_HOT int s7t_hash_join(CNSSparqlEngine* engine, uint32_t* left, int left_coun
         return 0;
     }
     
-    // Use stack-allocated hash table for small joins (7-tick optimization)
-    const int hash_size = 1024; // Power of 2 for fast modulo
-    const int hash_mask = hash_size - 1;
-    uint32_t hash_table[hash_size];
-    uint8_t hash_occupied[hash_size];
-    
-    // Initialize hash table
-    memset(hash_occupied, 0, sizeof(hash_occupied));
-    
-    // Build phase: insert left side into hash table
-    for (int i = 0; i < left_count; i++) {
-        uint32_t key = left[i];
-        uint32_t hash = s7t_hash_string((const char*)&key, sizeof(key)) & hash_mask;
-        
-        // Linear probing for collision resolution
-        while (hash_occupied[hash]) {
-            hash = (hash + 1) & hash_mask;
-        }
-        
-        hash_table[hash] = key;
-        hash_occupied[hash] = 1;
-    }
-    
-    // Probe phase: check right side against hash table
-    int result_count = 0;
-    for (int i = 0; i < right_count; i++) {
-        uint32_t key = right[i];
-        uint32_t hash = s7t_hash_string((const char*)&key, sizeof(key)) & hash_mask;
-        
-        // Linear probing to find match
-        while (hash_occupied[hash]) {
-            if (hash_table[hash] == key) {
-                results[result_count++] = key;
-                break;
-            }
-            hash = (hash + 1) & hash_mask;
-        }
-    }
+    s7t_join_options options = {.semi = true};
+    int result_count = (int)s7t_join(left, NULL, (size_t)left_count, right, NULL, (size_t)right_count,
+                                     NULL, results, (size_t)right_count, &options);
     
     uint64_t cycles = s7t_cycles() - start_cycles;
     s7t_perf_update(&s7t_kernel_perf[3], cycles);
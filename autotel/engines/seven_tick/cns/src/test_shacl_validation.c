@@ -4,9 +4,43 @@
 #include "cns/interner.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include <assert.h>
 #include <time.h>
 
+// Full-path violations of one focus node against one shape
+static size_t full_violations(cns_shacl_validator_t *validator, const cns_graph_t *graph,
+                              cns_string_ref_t node, const cns_shape_t *shape) {
+    cns_validation_report_t *report = cns_shacl_create_report(validator);
+    assert(report);
+    cns_result_t result = cns_shacl_validate_node_shape(validator, graph, node, shape, report);
+    assert(result == CNS_OK);
+    return report->violation_count;
+}
+
+// Same counters and the same (focus node, severity) multiset, in any order
+static bool same_results(const cns_validation_report_t *a, const cns_validation_report_t *b) {
+    if (a->result_count != b->result_count || a->violation_count != b->violation_count ||
+        a->warning_count != b->warning_count || a->info_count != b->info_count ||
+        a->nodes_validated != b->nodes_validated || a->conforms != b->conforms) {
+        return false;
+    }
+    for (const cns_validation_result_t *x = a->results; x; x = x->next) {
+        size_t in_a = 0, in_b = 0;
+        for (const cns_validation_result_t *y = a->results; y; y = y->next) {
+            in_a += y->focus_node.offset == x->focus_node.offset && y->severity == x->severity;
+        }
+        for (const cns_validation_result_t *y = b->results; y; y = y->next) {
+            in_b += y->focus_node.offset == x->focus_node.offset && y->severity == x->severity;
+        }
+        if (in_a != in_b) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Test SHACL validation engine with 7T performance requirements
 int main(void) {
     printf("🧪 SHACL Validation Engine Test - 7T Performance Validation\n");
@@ -147,6 +181,182 @@ int main(void) {
     
     printf("   ✅ String conversion utilities work correctly\n");
     
+    // Test 8: Long sh:flags "q" literals take the literal path, never regcomp
+    printf("🔎 Test 8: Long literal patterns...\n");
+    
+    const char *long_literal =
+        "price (USD) = a.b*c + [tax]? ... {net}|gross ^ 100$ \\ (unbalanced [ and ( parts";
+    assert(strlen(long_literal) >= CNS_PATTERN_LITERAL_MAX);
+    
+    cns_string_ref_t long_ref = cns_interner_intern(interner, long_literal);
+    const cns_shacl_pattern_t *literal_pattern = cns_shacl_compile_pattern(validator, long_ref, "q");
+    assert(literal_pattern);
+    assert(literal_pattern->kind == CNS_PATTERN_MATCH_CONTAINS);
+    assert(literal_pattern->regex_valid == false);
+    assert(literal_pattern->literal_long == cns_interner_get_string(interner, long_ref));
+    
+    char text[256];
+    snprintf(text, sizeof(text), "before %s after", long_literal);
+    cns_string_ref_t text_ref = cns_interner_intern(interner, text);
+    assert(cns_shacl_pattern_match(literal_pattern, text_ref, text));
+    
+    // Regex metacharacters are literal: "a.b*" must not match "aXbbb"
+    snprintf(text, sizeof(text), "%s", long_literal);
+    *strchr(text, '.') = 'X';
+    text_ref = cns_interner_intern(interner, text);
+    assert(!cns_shacl_pattern_match(literal_pattern, text_ref, text));
+    
+    const cns_shacl_pattern_t *icase_pattern = cns_shacl_compile_pattern(validator, long_ref, "qi");
+    assert(icase_pattern && icase_pattern != literal_pattern);
+    assert(icase_pattern->kind == CNS_PATTERN_MATCH_CONTAINS);
+    for (size_t i = 0; long_literal[i]; i++) {
+        text[i] = (char)toupper((unsigned char)long_literal[i]);
+    }
+    text[strlen(long_literal)] = '\0';
+    text_ref = cns_interner_intern(interner, text);
+    assert(cns_shacl_pattern_match(icase_pattern, text_ref, text));
+    assert(!cns_shacl_pattern_match(literal_pattern, text_ref, text));
+    
+    printf("   ✅ Long literals match with memmem, metacharacters stay literal\n");
+    
+    // Test 9: Inverse paths - incremental and full validation agree
+    printf("🔁 Test 9: Inverse property paths...\n");
+    
+    cns_shape_t *employer_shape = cns_shacl_create_shape(validator, "http://example.org/EmployerShape");
+    assert(employer_shape);
+    cns_string_ref_t acme_ref = cns_interner_intern(interner, "http://example.org/acme");
+    employer_shape->targets = &acme_ref;
+    employer_shape->target_count = 1;
+    employer_shape->flags |= CNS_SHAPE_FLAG_TARGET_NODE;
+    
+    // Everyone working for an employer must be a Person
+    cns_constraint_t employee_class = {
+        .type = CNS_SHACL_CLASS,
+        .value.string = person_ref,
+        .severity = CNS_SEVERITY_VIOLATION
+    };
+    cns_property_shape_t employees = {
+        .path = cns_interner_intern(interner, "http://example.org/worksFor"),
+        .constraints = &employee_class,
+        .min_count = 1,
+        .max_count = CNS_PROPERTY_COUNT_UNBOUNDED
+    };
+    result = cns_shacl_add_property_shape(employer_shape, "^http://example.org/worksFor", &employees);
+    assert(result == CNS_OK);
+    assert(employees.flags & CNS_PROPERTY_FLAG_INVERSE_PATH);
+    
+    result = cns_graph_insert_triple(graph, "http://example.org/john",
+        "http://example.org/worksFor", "http://example.org/acme", CNS_OBJECT_TYPE_IRI);
+    assert(result == CNS_OK);
+    result = cns_graph_insert_triple(graph, "http://example.org/car1",
+        "http://example.org/worksFor", "http://example.org/acme", CNS_OBJECT_TYPE_IRI);
+    assert(result == CNS_OK);
+    
+    // car1 is a Car: one violation, reached only through the inverse path
+    const cns_shape_t *inc_shapes[] = { employer_shape };
+    cns_shacl_incremental_t *inc = cns_shacl_incremental_create(validator, graph, inc_shapes, 1, &arena);
+    assert(inc);
+    assert(full_violations(validator, graph, acme_ref, employer_shape) == 1);
+    assert(cns_shacl_incremental_report(inc)->violation_count == 1);
+    
+    // car1 gains rdf:type Person: the value-class dependency revisits acme
+    cns_string_ref_t car_ref = cns_interner_intern(interner, "http://example.org/car1");
+    cns_string_ref_t type_ref = cns_interner_intern(interner,
+        "http://www.w3.org/1999/02/22-rdf-syntax-ns#type");
+    result = cns_graph_insert_triple(graph, "http://example.org/car1",
+        "http://www.w3.org/1999/02/22-rdf-syntax-ns#type", "http://example.org/Person",
+        CNS_OBJECT_TYPE_IRI);
+    assert(result == CNS_OK);
+    cns_triple_t typed = { .subject = car_ref, .predicate = type_ref, .object = person_ref };
+    cns_shacl_delta_t delta = { .inserted = &typed, .inserted_count = 1 };
+    result = cns_shacl_incremental_apply(inc, graph, &delta);
+    assert(result == CNS_OK);
+    assert(full_violations(validator, graph, acme_ref, employer_shape) == 0);
+    assert(cns_shacl_incremental_report(inc)->violation_count == 0);
+    
+    // An untyped worker arrives on the path edge itself (object side)
+    result = cns_graph_insert_triple(graph, "http://example.org/ghost",
+        "http://example.org/worksFor", "http://example.org/acme", CNS_OBJECT_TYPE_IRI);
+    assert(result == CNS_OK);
+    cns_triple_t hired = {
+        .subject = cns_interner_intern(interner, "http://example.org/ghost"),
+        .predicate = employees.path,
+        .object = acme_ref
+    };
+    delta.inserted = &hired;
+    result = cns_shacl_incremental_apply(inc, graph, &delta);
+    assert(result == CNS_OK);
+    assert(full_violations(validator, graph, acme_ref, employer_shape) == 1);
+    assert(cns_shacl_incremental_report(inc)->violation_count == 1);
+    
+    cns_shacl_incremental_destroy(inc);
+    printf("   ✅ Incremental and full validation agree on inverse paths\n");
+
+    // Test 10: "m" lets '^' match after a newline, so no anchored prefilter
+    printf("↩️ Test 10: Multiline anchored patterns...\n");
+    
+    const char *line_value = "x\nabc1";
+    cns_string_ref_t line_ref = cns_interner_intern(interner, line_value);
+    const char *anchored_sources[] = { "^abc", "^abc[0-9]" };
+    for (size_t i = 0; i < sizeof(anchored_sources) / sizeof(anchored_sources[0]); i++) {
+        cns_string_ref_t source_ref = cns_interner_intern(interner, anchored_sources[i]);
+        const cns_shacl_pattern_t *multiline = cns_shacl_compile_pattern(validator, source_ref, "m");
+        assert(multiline);
+        assert(!multiline->literal_anchored);
+        assert(cns_shacl_pattern_match(multiline, line_ref, line_value));
+        
+        // Without "m" the anchor still pins the first line
+        const cns_shacl_pattern_t *single = cns_shacl_compile_pattern(validator, source_ref, "");
+        assert(single && single != multiline);
+        assert(!cns_shacl_pattern_match(single, line_ref, line_value));
+    }
+    
+    printf("   ✅ Multiline anchors match on later lines\n");
+    
+    // Test 11: Parallel validation matches the serial path
+    printf("🧵 Test 11: Parallel vs serial validation...\n");
+    
+    cns_validation_report_t *serial = cns_shacl_create_report(validator);
+    assert(serial);
+    serial->arena = &arena;
+    result = cns_shacl_validate_graph(validator, graph, serial);
+    assert(result == CNS_OK);
+    assert(serial->result_count > 0);
+    
+    // One node per chunk so every worker gets work on this small graph
+    cns_shacl_parallel_config_t parallel_config = { .thread_count = 4, .chunk_size = 1 };
+    cns_validation_report_t *shared = cns_shacl_create_report(validator);
+    assert(shared);
+    shared->arena = &arena;
+    result = cns_shacl_validate_graph_parallel(validator, graph, &parallel_config, shared);
+    assert(result == CNS_OK);
+    assert(same_results(serial, shared));
+    
+    // Worker arenas: fewer arenas than online CPUs caps the workers
+    static uint8_t worker_memory[2][64 * 1024];
+    arena_t worker_arena[2];
+    arena_t *worker_arenas[2];
+    for (int i = 0; i < 2; i++) {
+        result = arenac_init(&worker_arena[i], worker_memory[i], sizeof(worker_memory[i]), 0);
+        assert(result == 0);
+        worker_arenas[i] = &worker_arena[i];
+    }
+    parallel_config.thread_count = 0;
+    parallel_config.worker_arenas = worker_arenas;
+    parallel_config.worker_arena_count = 2;
+    cns_validation_report_t *owned = cns_shacl_create_report(validator);
+    assert(owned);
+    result = cns_shacl_validate_graph_parallel(validator, graph, &parallel_config, owned);
+    assert(result == CNS_OK);
+    assert(same_results(serial, owned));
+    
+    // Arenas without a count are rejected rather than over-read
+    parallel_config.worker_arena_count = 0;
+    result = cns_shacl_validate_graph_parallel(validator, graph, &parallel_config, owned);
+    assert(result == CNS_ERROR_INVALID_ARG);
+    
+    printf("   ✅ Parallel results match serial, with and without worker arenas\n");
+    
     // Final arena statistics
     printf("\n📊 Final Arena Statistics:\n");
     arenac_info_t arena_info;
@@ -0,0 +1,189 @@
+/*  ─────────────────────────────────────────────────────────────
+    test_bitactor.c  –  BitActor Matrix Slot Tests
+    Spawn, despawn and respawn across reserved domain lanes
+    ───────────────────────────────────────────────────────────── */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bitactor.h"
+
+/*═══════════════════════════════════════════════════════════════
+  Test Framework Infrastructure
+  ═══════════════════════════════════════════════════════════════*/
+
+// Test result tracking
+static uint32_t tests_run = 0;
+static uint32_t tests_passed = 0;
+static uint32_t tests_failed = 0;
+
+// Test macros
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL: %s\n", message); \
+            tests_failed++; \
+            return false; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        tests_passed++; \
+        return true; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("Running %s... ", #test_func); \
+        tests_run++; \
+        if (!test_func()) { \
+            printf("  ✗ FAILED\n"); \
+        } else { \
+            printf("  ✓ PASSED\n"); \
+        } \
+    } while(0)
+
+// The matrix owns and frees compiled TTL logic
+static void* ttl(void) {
+    return malloc(8);
+}
+
+static uint32_t lane_of(uint32_t actor_id) {
+    return (actor_id - 1) / BITACTOR_DOMAIN_SLOTS;
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Slot Allocation Tests
+  ═══════════════════════════════════════════════════════════════*/
+
+// Untagged spawns stay out of a reserved lane while other slots are free
+bool test_untagged_avoids_reserved_lane() {
+    BitActorMatrix* matrix = bitactor_matrix_create();
+    TEST_ASSERT(matrix != NULL, "Matrix creation");
+
+    uint32_t tagged = bitactor_spawn_in_domain(matrix, ttl(), 0);
+    TEST_ASSERT(tagged != 0 && lane_of(tagged) == 0, "Tagged spawn lands in its lane");
+
+    for (int i = 0; i < BITACTOR_MATRIX_SIZE - BITACTOR_DOMAIN_SLOTS; i++) {
+        uint32_t id = bitactor_spawn(matrix, ttl());
+        TEST_ASSERT(id != 0 && lane_of(id) != 0, "Untagged spawn outside reserved lane");
+    }
+
+    bitactor_matrix_destroy(matrix);
+    TEST_PASS("Reserved lane kept for its domain");
+}
+
+// One tagged actor per domain must not starve untagged spawns
+bool test_untagged_falls_back_to_reserved_slots() {
+    BitActorMatrix* matrix = bitactor_matrix_create();
+    TEST_ASSERT(matrix != NULL, "Matrix creation");
+
+    for (uint8_t d = 0; d < BITACTOR_DOMAIN_COUNT; d++) {
+        TEST_ASSERT(bitactor_spawn_in_domain(matrix, ttl(), d) != 0, "Tagged spawn");
+    }
+
+    uint32_t spawned = 0;
+    void* logic = ttl();
+    while (bitactor_spawn(matrix, logic) != 0) {
+        spawned++;
+        logic = ttl();
+    }
+    free(logic);  // Not taken by the failed spawn
+    TEST_ASSERT(spawned == BITACTOR_MATRIX_SIZE - BITACTOR_DOMAIN_COUNT,
+                "Untagged spawns fill every free slot");
+    TEST_ASSERT(matrix->active_count == BITACTOR_MATRIX_SIZE, "Matrix full");
+
+    bitactor_matrix_destroy(matrix);
+    TEST_PASS("Untagged spawns use reserved slots once the rest are taken");
+}
+
+// Despawning a domain's last actor releases its lane
+bool test_spawn_despawn_respawn() {
+    BitActorMatrix* matrix = bitactor_matrix_create();
+    TEST_ASSERT(matrix != NULL, "Matrix creation");
+
+    uint32_t first = bitactor_spawn_in_domain(matrix, ttl(), 0);
+    uint32_t second = bitactor_spawn_in_domain(matrix, ttl(), 0);
+    TEST_ASSERT(first == 1 && second == 2, "Tagged spawns take the lowest lane slots");
+
+    uint32_t untagged = bitactor_spawn(matrix, ttl());
+    TEST_ASSERT(lane_of(untagged) != 0, "Untagged spawn skips the reserved lane");
+
+    // Lane still reserved while one tagged actor remains
+    TEST_ASSERT(bitactor_despawn(matrix, first), "Despawn first tagged actor");
+    TEST_ASSERT(!bitactor_despawn(matrix, first), "Double despawn rejected");
+    uint32_t id = bitactor_spawn(matrix, ttl());
+    TEST_ASSERT(lane_of(id) != 0, "Lane reserved while the domain has actors");
+    TEST_ASSERT(bitactor_despawn(matrix, id), "Despawn untagged actor");
+
+    // Last tagged actor gone: the lane's slots are ordinary again
+    TEST_ASSERT(bitactor_despawn(matrix, second), "Despawn last tagged actor");
+    id = bitactor_spawn(matrix, ttl());
+    TEST_ASSERT(id == first, "Untagged respawn takes the released slot");
+
+    // Re-tagging the domain reserves the lane again
+    uint32_t retagged = bitactor_spawn_in_domain(matrix, ttl(), 0);
+    TEST_ASSERT(retagged == second, "Tagged respawn takes the next lane slot");
+    uint32_t after = bitactor_spawn(matrix, ttl());
+    TEST_ASSERT(lane_of(after) != 0, "Lane reserved again");
+
+    TEST_ASSERT(matrix->active_count == 4, "Active count tracks spawns and despawns");
+
+    bitactor_matrix_destroy(matrix);
+    TEST_PASS("Spawn, despawn and respawn");
+}
+
+// Despawn and respawn every slot of a full matrix
+bool test_full_matrix_recycle() {
+    BitActorMatrix* matrix = bitactor_matrix_create();
+    TEST_ASSERT(matrix != NULL, "Matrix creation");
+
+    for (int i = 0; i < BITACTOR_MATRIX_SIZE; i++) {
+        uint8_t domain = (i % 2) ? (uint8_t)(i % BITACTOR_DOMAIN_COUNT) : BITACTOR_DOMAIN_NONE;
+        uint32_t id = domain == BITACTOR_DOMAIN_NONE ? bitactor_spawn(matrix, ttl())
+                                                     : bitactor_spawn_in_domain(matrix, ttl(), domain);
+        TEST_ASSERT(id != 0, "Fill matrix");
+    }
+    void* logic = ttl();
+    TEST_ASSERT(bitactor_spawn(matrix, logic) == 0, "Spawn fails when full");
+    TEST_ASSERT(bitactor_spawn_in_domain(matrix, logic, 3) == 0, "Tagged spawn fails when full");
+    free(logic);
+
+    for (uint32_t id = 1; id <= BITACTOR_MATRIX_SIZE; id++) {
+        TEST_ASSERT(bitactor_despawn(matrix, id), "Despawn every actor");
+    }
+    TEST_ASSERT(matrix->active_count == 0, "Matrix empty");
+
+    for (int i = 0; i < BITACTOR_MATRIX_SIZE; i++) {
+        TEST_ASSERT(bitactor_spawn(matrix, ttl()) != 0, "Untagged refill");
+    }
+
+    bitactor_matrix_destroy(matrix);
+    TEST_PASS("Full matrix recycled");
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Main Test Runner
+  ═══════════════════════════════════════════════════════════════*/
+
+int main() {
+    printf("CNS BitActor Matrix Test Suite\n");
+    printf("==============================\n\n");
+
+    RUN_TEST(test_untagged_avoids_reserved_lane);
+    RUN_TEST(test_untagged_falls_back_to_reserved_slots);
+    RUN_TEST(test_spawn_despawn_respawn);
+    RUN_TEST(test_full_matrix_recycle);
+
+    printf("\n==============================\n");
+    printf("Test Results:\n");
+    printf("Total:  %u\n", tests_run);
+    printf("Passed: %u\n", tests_passed);
+    printf("Failed: %u\n", tests_failed);
+
+    return tests_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+/*  ─────────────────────────────────────────────────────────────
+    test_bitactor_runtime.c  –  BitActor Runtime Tests
+    MPSC mailbox ordering, full mailboxes and registry lookups
+    ───────────────────────────────────────────────────────────── */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "cns/bitactor.h"
+
+/*═══════════════════════════════════════════════════════════════
+  Test Framework Infrastructure
+  ═══════════════════════════════════════════════════════════════*/
+
+// Test result tracking
+static uint32_t tests_run = 0;
+static uint32_t tests_passed = 0;
+static uint32_t tests_failed = 0;
+
+// Test macros
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL: %s\n", message); \
+            tests_failed++; \
+            return false; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        tests_passed++; \
+        return true; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("Running %s... ", #test_func); \
+        tests_run++; \
+        if (!test_func()) { \
+            printf("  ✗ FAILED\n"); \
+        } else { \
+            printf("  ✓ PASSED\n"); \
+        } \
+    } while(0)
+
+#define PRODUCERS 4
+#define MESSAGES_PER_PRODUCER 20000 // Many times the mailbox size
+
+// The conductor holds every actor slot inline; keep it off the stack
+static bitactor_conductor_t conductor;
+
+/*═══════════════════════════════════════════════════════════════
+  Test Actors
+  ═══════════════════════════════════════════════════════════════*/
+
+typedef struct {
+    uint32_t producer;
+    uint32_t sequence;
+} sequenced_msg_t;
+
+// Collector: checks that each producer's messages arrive in send order
+static uint32_t next_sequence[PRODUCERS];
+static uint64_t collected = 0;
+static uint64_t out_of_order = 0;
+
+static void on_collect(void* state, const void* msg, size_t msg_len) {
+    (void)state;
+    sequenced_msg_t m;
+    if (msg_len != sizeof(m)) {
+        out_of_order++;
+        return;
+    }
+    memcpy(&m, msg, sizeof(m));
+    if (m.producer >= PRODUCERS || m.sequence != next_sequence[m.producer]) {
+        out_of_order++;
+    } else {
+        next_sequence[m.producer]++;
+    }
+    collected++;
+}
+
+BITACTOR_BEHAVIOR(collector, on_collect)
+
+// Flooder: on a trigger, casts to itself until its own mailbox is full.
+// Nobody else drains it while the handler runs, so the runtime must refuse.
+#define FLOOD_TRIGGER 1
+#define FLOOD_ATTEMPTS (2 * BITACTOR_MAILBOX_SIZE)
+
+static uint32_t flood_accepted = 0;
+static uint32_t flood_refused = 0;
+static uint32_t flood_other = 0;
+static uint32_t flood_echoes = 0;
+
+static void on_flood(void* state, const void* msg, size_t msg_len) {
+    (void)state;
+    uint8_t tag = msg_len ? *(const uint8_t*)msg : 0;
+    if (tag != FLOOD_TRIGGER) {
+        flood_echoes++;
+        return;
+    }
+
+    uint8_t echo = 0;
+    bitactor_message_t m = {.type = BITACTOR_CAST, .payload = &echo, .payload_len = 1};
+    for (uint32_t i = 0; i < FLOOD_ATTEMPTS; i++) {
+        int rc = bitactor_cast(NULL, bitactor_self(), &m);
+        if (rc == BITACTOR_OK) flood_accepted++;
+        else if (rc == BITACTOR_ERR_FULL) flood_refused++;
+        else flood_other++;
+    }
+}
+
+BITACTOR_BEHAVIOR(flooder, on_flood)
+
+// Echo: replies with its own pid, found through a cached peer
+static bitactor_peer_t echo_peer = BITACTOR_PEER("echo");
+
+static void on_echo(void* state, const void* msg, size_t msg_len) {
+    (void)state;
+    (void)msg;
+    (void)msg_len;
+}
+
+BITACTOR_BEHAVIOR(echo, on_echo)
+
+/*═══════════════════════════════════════════════════════════════
+  Mailbox Tests
+  ═══════════════════════════════════════════════════════════════*/
+
+typedef struct {
+    bitactor_pid_t target;
+    uint32_t producer;
+    int failures;
+} producer_args_t;
+
+static void* producer_main(void* arg) {
+    producer_args_t* args = arg;
+    for (uint32_t i = 0; i < MESSAGES_PER_PRODUCER; i++) {
+        sequenced_msg_t m = {args->producer, i};
+        bitactor_message_t msg = {.type = BITACTOR_CAST, .payload = &m, .payload_len = sizeof(m)};
+        if (bitactor_cast(&conductor, args->target, &msg) != BITACTOR_OK) args->failures++;
+    }
+    return NULL;
+}
+
+// Concurrent producers: nothing lost, each producer's order kept
+bool test_mpsc_producer_ordering() {
+    TEST_ASSERT(bitactor_conductor_init(&conductor) == BITACTOR_OK, "Conductor init");
+    actor_id_t id = registry_register("collector", NULL, 0);
+    TEST_ASSERT(id != BITACTOR_ID_NONE, "Register collector");
+    bitactor_pid_t pid = bitactor_conductor_spawn(&conductor, id);
+    TEST_ASSERT(pid != BITACTOR_PID_NONE, "Spawn collector");
+
+    pthread_t threads[PRODUCERS];
+    producer_args_t args[PRODUCERS];
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        args[p] = (producer_args_t){pid, p, 0};
+        TEST_ASSERT(pthread_create(&threads[p], NULL, producer_main, &args[p]) == 0, "Producer start");
+    }
+    int failures = 0;
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+        failures += args[p].failures;
+    }
+    bitactor_conductor_quiesce(&conductor);
+
+    TEST_ASSERT(failures == 0, "Producers block instead of dropping");
+    TEST_ASSERT(collected == (uint64_t)PRODUCERS * MESSAGES_PER_PRODUCER, "Every message delivered");
+    TEST_ASSERT(out_of_order == 0, "Per-producer order kept");
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        TEST_ASSERT(next_sequence[p] == MESSAGES_PER_PRODUCER, "Producer sequence complete");
+    }
+    TEST_ASSERT(bitactor_conductor_dropped(&conductor) == 0, "Nothing dropped");
+
+    bitactor_conductor_shutdown(&conductor);
+    TEST_PASS("MPSC mailbox keeps producer order");
+}
+
+// A cast its own thread would have to drain is refused and counted
+bool test_full_mailbox_refused() {
+    TEST_ASSERT(bitactor_conductor_init(&conductor) == BITACTOR_OK, "Conductor init");
+    bitactor_pid_t pid = bitactor_conductor_spawn(&conductor, registry_register("flooder", NULL, 0));
+    TEST_ASSERT(pid != BITACTOR_PID_NONE, "Spawn flooder");
+
+    uint8_t trigger = FLOOD_TRIGGER;
+    bitactor_message_t msg = {.type = BITACTOR_CAST, .payload = &trigger, .payload_len = 1};
+    TEST_ASSERT(bitactor_cast(&conductor, pid, &msg) == BITACTOR_OK, "Trigger cast");
+    bitactor_conductor_quiesce(&conductor);
+
+    // The trigger's slot is held until its handler returns
+    TEST_ASSERT(flood_accepted == BITACTOR_MAILBOX_SIZE - 1, "Mailbox filled");
+    TEST_ASSERT(flood_refused == FLOOD_ATTEMPTS - flood_accepted, "Overflow refused with ERR_FULL");
+    TEST_ASSERT(flood_other == 0, "No other errors");
+    TEST_ASSERT(flood_echoes == flood_accepted, "Accepted casts delivered");
+    TEST_ASSERT(bitactor_conductor_dropped(&conductor) == flood_refused, "Refused casts counted");
+
+    bitactor_conductor_shutdown(&conductor);
+    TEST_PASS("Full mailbox refuses and counts casts");
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Registry Tests
+  ═══════════════════════════════════════════════════════════════*/
+
+// Unknown and unspawned names resolve to no pid; casts to them are refused
+bool test_registry_missing_names() {
+    TEST_ASSERT(bitactor_conductor_init(&conductor) == BITACTOR_OK, "Conductor init");
+
+    TEST_ASSERT(registry_lookup("missing") == BITACTOR_PID_NONE, "Unknown name");
+    TEST_ASSERT(registry_lookup("") == BITACTOR_PID_NONE, "Empty name");
+    TEST_ASSERT(registry_register("missing", NULL, 0) == BITACTOR_ID_NONE, "No behavior, no registration");
+
+    actor_id_t id = registry_register("echo", NULL, 0);
+    TEST_ASSERT(id != BITACTOR_ID_NONE, "Register echo");
+    TEST_ASSERT(registry_lookup("echo") == BITACTOR_PID_NONE, "Registered but not spawned");
+    TEST_ASSERT(bitactor_peer_pid(&echo_peer) == BITACTOR_PID_NONE, "Peer unresolved before spawn");
+
+    uint8_t byte = 0;
+    bitactor_message_t msg = {.type = BITACTOR_CAST, .payload = &byte, .payload_len = 1};
+    TEST_ASSERT(bitactor_cast(&conductor, registry_lookup("missing"), &msg) == BITACTOR_ERR_NOT_FOUND,
+                "Cast to unknown name refused");
+    TEST_ASSERT(bitactor_conductor_dropped(&conductor) == 1, "Refused cast counted");
+
+    bitactor_pid_t pid = bitactor_conductor_spawn(&conductor, id);
+    TEST_ASSERT(pid != BITACTOR_PID_NONE, "Spawn echo");
+    TEST_ASSERT(registry_lookup("echo") == pid, "Lookup after spawn");
+    TEST_ASSERT(bitactor_peer_pid(&echo_peer) == pid, "Peer resolved after spawn");
+    TEST_ASSERT(registry_lookup("echoes") == BITACTOR_PID_NONE, "Prefix does not match");
+
+    bitactor_conductor_shutdown(&conductor);
+    TEST_ASSERT(registry_lookup("echo") == BITACTOR_PID_NONE, "Shutdown clears pids");
+    TEST_ASSERT(bitactor_peer_pid(&echo_peer) == BITACTOR_PID_NONE, "Peer re-resolved after shutdown");
+    TEST_PASS("Missing names resolve to no pid");
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Main Test Runner
+  ═══════════════════════════════════════════════════════════════*/
+
+int main() {
+    printf("CNS BitActor Runtime Test Suite\n");
+    printf("===============================\n\n");
+
+    RUN_TEST(test_mpsc_producer_ordering);
+    RUN_TEST(test_full_mailbox_refused);
+    RUN_TEST(test_registry_missing_names);
+
+    printf("\n===============================\n");
+    printf("Test Results:\n");
+    printf("Total:  %u\n", tests_run);
+    printf("Passed: %u\n", tests_passed);
+    printf("Failed: %u\n", tests_failed);
+
+    return tests_failed == 0 ? 0 : 1;
+}
@@ -30,11 +30,17 @@ int test_engine_lifecycle()
   SPARQLEngine *engine = cns_sparql_create(1024);
   TEST_ASSERT(engine != NULL, "Engine creation successful");
 
-  // Test singleton behavior
+  // Test independent instances
   SPARQLEngine *engine2 = cns_sparql_create(2048);
-  TEST_ASSERT(engine2 == engine, "Singleton pattern works");
+  TEST_ASSERT(engine2 != NULL && engine2 != engine, "Second engine is a separate instance");
+
+  cns_sparql_add_triple(engine, 1, 2, 3);
+  TEST_ASSERT(cns_sparql_find_triples(engine, 0, 0, 0) == 1, "First engine holds its triple");
+  TEST_ASSERT(cns_sparql_find_triples(engine2, 0, 0, 0) == 0, "Second engine is unaffected");
 
   // Test destruction
+  cns_sparql_destroy(engine2);
+  TEST_ASSERT(cns_sparql_find_triples(engine, 1, 2, 3) == 1, "First engine survives destroying the second");
   cns_sparql_destroy(engine);
   TEST_ASSERT(1, "Engine destruction successful");
 
@@ -105,6 +111,15 @@ int test_query_execution()
   TEST_ASSERT(result->count == 0, "Invalid query returned 0 results");
   cns_sparql_free_result(result);
 
+  // Test a projection longer than SPARQL_MAX_VARIABLES
+  char wide[256] = "SELECT";
+  for (int i = 0; i <= SPARQL_MAX_VARIABLES; i++)
+    strcat(wide, " ?s");
+  strcat(wide, " WHERE { ?s ?p ?o }");
+  result = cns_sparql_execute(engine, wide);
+  TEST_ASSERT(result != NULL && result->count == 0, "Over-long projection rejected");
+  cns_sparql_free_result(result);
+
   // Test NULL query
   result = cns_sparql_execute(engine, NULL);
   TEST_ASSERT(result == NULL, "NULL query returns NULL");
@@ -113,6 +128,217 @@ int test_query_execution()
   return 0;
 }
 
+// Test basic graph patterns over dictionary terms
+int test_basic_graph_patterns()
+{
+  TEST_SECTION("Basic Graph Patterns");
+
+  SPARQLEngine *engine = cns_sparql_create(0);
+  TEST_ASSERT(engine != NULL, "Engine created for pattern tests");
+
+  const char *knows = "<http://xmlns.com/foaf/0.1/knows>";
+  const char *name = "<http://xmlns.com/foaf/0.1/name>";
+  cns_sparql_add_terms(engine, "<http://ex.org/alice>", knows, "<http://ex.org/bob>");
+  cns_sparql_add_terms(engine, "<http://ex.org/alice>", knows, "<http://ex.org/carol>");
+  cns_sparql_add_terms(engine, "<http://ex.org/bob>", knows, "<http://ex.org/carol>");
+  cns_sparql_add_terms(engine, "<http://ex.org/bob>", name, "\"Bob\"");
+  cns_sparql_add_terms(engine, "<http://ex.org/carol>", name, "\"Carol\"@en");
+  cns_sparql_add_terms(engine, "<http://ex.org/carol>", name, "\"Carol\"@en");
+
+  uint32_t bob = cns_sparql_lookup(engine, "<http://ex.org/bob>");
+  TEST_ASSERT(bob != 0, "Terms are interned");
+  TEST_ASSERT(cns_sparql_intern(engine, "<http://ex.org/bob>") == bob, "Interning is idempotent");
+  TEST_ASSERT(strcmp(cns_sparql_term(engine, bob), "<http://ex.org/bob>") == 0, "Ids map back to terms");
+  TEST_ASSERT(cns_sparql_find_triples(engine, 0, 0, 0) == 5, "Duplicate triple stored once");
+
+  SPARQLResult *result = cns_sparql_execute(engine,
+                                            "PREFIX foaf: <http://xmlns.com/foaf/0.1/> "
+                                            "SELECT ?friend ?name WHERE { <http://ex.org/alice> foaf:knows ?friend . ?friend foaf:name ?name }");
+  TEST_ASSERT(result != NULL && result->count == 2, "Two-pattern join returned 2 results");
+  TEST_ASSERT(result->variable_count == 2 && strcmp(result->variables[1], "name") == 0, "Projected variables reported");
+  TEST_ASSERT(result->bindings[0] == bob && strcmp(cns_sparql_term(engine, result->bindings[1]), "\"Bob\"") == 0,
+              "Bindings resolve to terms");
+  cns_sparql_free_result(result);
+
+  result = cns_sparql_execute(engine, "SELECT DISTINCT ?s WHERE { ?s <http://xmlns.com/foaf/0.1/knows> ?o }");
+  TEST_ASSERT(result != NULL && result->count == 2, "DISTINCT removes duplicate subjects");
+  cns_sparql_free_result(result);
+
+  result = cns_sparql_execute(engine, "SELECT * WHERE { ?s <http://xmlns.com/foaf/0.1/knows> ?o ; <http://xmlns.com/foaf/0.1/name> \"Bob\" }");
+  TEST_ASSERT(result != NULL && result->count == 1 && result->bindings[0] == bob, "Predicate-object lists join on the subject");
+  cns_sparql_free_result(result);
+
+  result = cns_sparql_execute(engine, "SELECT ?o WHERE { ?s ?p ?o } LIMIT 3");
+  TEST_ASSERT(result != NULL && result->count == 3 && result->triples != NULL, "LIMIT caps results");
+  cns_sparql_free_result(result);
+
+  result = cns_sparql_execute(engine, "SELECT ?s WHERE { ?s <http://ex.org/unknown> ?o }");
+  TEST_ASSERT(result != NULL && result->count == 0, "Unknown constant matches nothing");
+  cns_sparql_free_result(result);
+
+  // Triples added after indexing are merged in
+  cns_sparql_add_terms(engine, "<http://ex.org/carol>", knows, "<http://ex.org/alice>");
+  result = cns_sparql_execute(engine, "SELECT ?a WHERE { ?a <http://xmlns.com/foaf/0.1/knows> ?b . ?b <http://xmlns.com/foaf/0.1/knows> ?a }");
+  TEST_ASSERT(result != NULL && result->count == 2, "Mutual acquaintance found after merge");
+  cns_sparql_free_result(result);
+  TEST_ASSERT(cns_sparql_find_triples(engine, 0, cns_sparql_lookup(engine, knows), 0) == 4, "Merged triple is indexed");
+
+  cns_sparql_destroy(engine);
+  return 0;
+}
+
+// Test bulk loading
+int test_bulk_load()
+{
+  TEST_SECTION("Bulk Load");
+
+  SPARQLEngine *engine = cns_sparql_create(0);
+  TEST_ASSERT(engine != NULL, "Engine created for bulk load");
+
+  // Enough triples to take the radix sort path
+  const size_t count = 100000;
+  uint32_t *triples = malloc(count * 3 * sizeof(uint32_t));
+  TEST_ASSERT(triples != NULL, "Test data allocated");
+  for (size_t i = 0; i < count; i++)
+  {
+    triples[i * 3] = (uint32_t)(i % 1000);
+    triples[i * 3 + 1] = 70000 + (uint32_t)(i % 7);
+    triples[i * 3 + 2] = (uint32_t)(i * 2654435761u);
+  }
+
+  TEST_ASSERT(cns_sparql_load_triples(engine, triples, count) == CNS_OK, "Triples loaded");
+  TEST_ASSERT(cns_sparql_build_indexes(engine) == CNS_OK, "Indexes built");
+  TEST_ASSERT(cns_sparql_find_triples(engine, 0, 0, 0) == count, "All triples indexed");
+  TEST_ASSERT(cns_sparql_find_triples(engine, 5, 0, 0) == 100, "Subject lookup uses SPO");
+  TEST_ASSERT(cns_sparql_find_triples(engine, 0, 70003, 0) == count / 7 + (count % 7 > 3), "Predicate lookup uses POS");
+  TEST_ASSERT(cns_sparql_find_triples(engine, 0, 0, triples[3 * 777 + 2]) == 1, "Object lookup uses OSP");
+  TEST_ASSERT(cns_sparql_find_triples(engine, 777, 0, triples[3 * 777 + 2]) == 1, "Subject-object lookup uses OSP");
+
+  uint32_t expected = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    expected += triples[i * 3] == 5 && triples[i * 3 + 1] == 70005;
+  }
+  SPARQLResult *result = cns_sparql_execute(engine, "SELECT ?o WHERE { 5 70005 ?o }");
+  TEST_ASSERT(result != NULL && result->count == expected, "Range scan query");
+  cns_sparql_free_result(result);
+
+  free(triples);
+  cns_sparql_destroy(engine);
+  return 0;
+}
+
+// Test cost-based join ordering and EXPLAIN
+int test_join_planning()
+{
+  TEST_SECTION("Join Planning");
+
+  SPARQLEngine *engine = cns_sparql_create(0);
+  TEST_ASSERT(engine != NULL, "Engine created for planning");
+
+  // 1000 people, every one typed and knowing the next; one is named
+  char person[64], next[64], name[64];
+  for (int i = 0; i < 1000; i++)
+  {
+    snprintf(person, sizeof(person), "<http://ex.org/p%d>", i);
+    snprintf(next, sizeof(next), "<http://ex.org/p%d>", (i + 1) % 1000);
+    snprintf(name, sizeof(name), "\"name%d\"", i);
+    cns_sparql_add_terms(engine, person, "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>", "<http://ex.org/Person>");
+    cns_sparql_add_terms(engine, person, "<http://ex.org/knows>", next);
+    cns_sparql_add_terms(engine, person, "<http://ex.org/name>", name);
+  }
+
+  SPARQLStats stats = cns_sparql_get_stats(engine);
+  TEST_ASSERT(stats.distinct_subjects == 1000, "Distinct subjects counted");
+  TEST_ASSERT(stats.distinct_predicates == 3, "Distinct predicates counted");
+  TEST_ASSERT(stats.distinct_objects == 2001, "Distinct objects counted");
+  TEST_ASSERT(stats.characteristic_sets == 1, "One characteristic set");
+
+  // The selective pattern comes last in the text but runs first
+  const char *query = "PREFIX ex: <http://ex.org/> "
+                      "SELECT ?f WHERE { ?p a ex:Person . ?p ex:knows ?f . ?p ex:name \"name41\" }";
+  char *plan = cns_sparql_explain(engine, query);
+  TEST_ASSERT(plan != NULL, "EXPLAIN produced a plan");
+  const char *first = plan ? strstr(plan, "1. ") : NULL;
+  TEST_ASSERT(first != NULL && strstr(first, "\"name41\"") < strstr(first, "2. "), "Selective pattern ordered first");
+  TEST_ASSERT(strstr(plan, "scan") && strstr(plan, "index-join"), "EXPLAIN names join algorithms");
+  free(plan);
+
+  SPARQLResult *result = cns_sparql_execute(engine, query);
+  TEST_ASSERT(result != NULL && result->count == 1 &&
+                  result->bindings[0] == cns_sparql_lookup(engine, "<http://ex.org/p42>"),
+              "Reordered query returns the textual-order answer");
+  cns_sparql_free_result(result);
+
+  // Two unselective patterns over the same subjects: one hash build beats 1000 seeks
+  query = "SELECT ?p ?f ?n WHERE { ?p <http://ex.org/knows> ?f . ?p <http://ex.org/name> ?n }";
+  plan = cns_sparql_explain(engine, query);
+  TEST_ASSERT(plan != NULL && strstr(plan, "hash-join") != NULL, "Hash join chosen for large inputs");
+  TEST_ASSERT(plan != NULL && strstr(plan, "estimated 1000 rows") != NULL, "Star estimated from characteristic sets");
+  free(plan);
+
+  result = cns_sparql_execute(engine, query);
+  TEST_ASSERT(result != NULL && result->count == 1000, "Hash join returns every match");
+  cns_sparql_free_result(result);
+
+  TEST_ASSERT(cns_sparql_explain(engine, "SELECT WHERE") == NULL, "EXPLAIN rejects malformed queries");
+
+  cns_sparql_destroy(engine);
+  return 0;
+}
+
+// Test leapfrog triejoin on cyclic patterns
+int test_cyclic_patterns()
+{
+  TEST_SECTION("Cyclic Patterns");
+
+  SPARQLEngine *engine = cns_sparql_create(0);
+  TEST_ASSERT(engine != NULL, "Engine created for cyclic patterns");
+
+  // Directed edges i -> j for i < j among 12 nodes where (i + j) % 3 != 0
+  uint32_t triangles = 0;
+  for (uint32_t i = 0; i < 12; i++)
+  {
+    for (uint32_t j = i + 1; j < 12; j++)
+    {
+      if ((i + j) % 3 != 0)
+        cns_sparql_add_triple(engine, 100 + i, 1, 100 + j);
+      for (uint32_t k = j + 1; k < 12; k++)
+        triangles += (i + j) % 3 != 0 && (j + k) % 3 != 0 && (i + k) % 3 != 0;
+    }
+  }
+
+  const char *query = "SELECT * WHERE { ?a 1 ?b . ?b 1 ?c . ?a 1 ?c }";
+  char *plan = cns_sparql_explain(engine, query);
+  TEST_ASSERT(plan != NULL && strstr(plan, "leapfrog triejoin") != NULL, "Cyclic pattern planned as leapfrog");
+  free(plan);
+
+  SPARQLResult *result = cns_sparql_execute(engine, query);
+  TEST_ASSERT(result != NULL && result->count == triangles, "Leapfrog finds every triangle");
+  uint32_t leapfrog_count = result ? result->count : 0;
+  cns_sparql_free_result(result);
+
+  cns_sparql_set_leapfrog(engine, false);
+  plan = cns_sparql_explain(engine, query);
+  TEST_ASSERT(plan != NULL && strstr(plan, "leapfrog") == NULL, "Leapfrog can be disabled");
+  free(plan);
+  result = cns_sparql_execute(engine, query);
+  TEST_ASSERT(result != NULL && result->count == leapfrog_count, "Pairwise joins agree");
+  cns_sparql_free_result(result);
+  cns_sparql_set_leapfrog(engine, true);
+
+  result = cns_sparql_execute(engine, "SELECT * WHERE { ?a 1 ?b . ?b 1 ?c . ?a 1 ?c } LIMIT 3");
+  TEST_ASSERT(result != NULL && result->count == 3, "Leapfrog honours LIMIT");
+  cns_sparql_free_result(result);
+
+  result = cns_sparql_execute(engine, "SELECT ?c WHERE { 100 1 ?b . ?b 1 ?c . 100 1 ?c }");
+  TEST_ASSERT(result != NULL && result->count > 0, "Constants combine with cycles");
+  cns_sparql_free_result(result);
+
+  cns_sparql_destroy(engine);
+  return 0;
+}
+
 // Test performance characteristics
 int test_performance()
 {
@@ -121,34 +347,24 @@ int test_performance()
   SPARQLEngine *engine = cns_sparql_create(1024);
   TEST_ASSERT(engine != NULL, "Engine created for performance tests");
 
-  // Test engine creation performance (7 cycles target)
-  uint64_t start = cns_get_cycles();
-  SPARQLEngine *test_engine = cns_sparql_create(512);
-  uint64_t cycles = cns_get_cycles() - start;
-  TEST_ASSERT(cycles <= 7, "Engine creation within 7-cycle limit");
-  cns_sparql_destroy(test_engine);
-
-  // Test triple addition performance (5 cycles target)
-  start = cns_get_cycles();
+  // The engine no longer answers from a fixed-size array, so add, query and
+  // lookup are not held to per-call cycle budgets here; throughput is
+  // measured by sparql_engine_benchmark instead
   int result = cns_sparql_add_triple(engine, 1, 2, 3);
-  cycles = cns_get_cycles() - start;
   TEST_ASSERT(result == CNS_OK, "Triple addition successful");
-  TEST_ASSERT(cycles <= 5, "Triple addition within 5-cycle limit");
 
-  // Test query execution performance (15 cycles target)
-  start = cns_get_cycles();
+  uint64_t start = cns_get_cycles();
   SPARQLResult *query_result = cns_sparql_execute(engine, "SELECT ?s ?p ?o WHERE { ?s ?p ?o }");
-  cycles = cns_get_cycles() - start;
+  uint64_t cycles = cns_get_cycles() - start;
   TEST_ASSERT(query_result != NULL, "Query execution successful");
-  TEST_ASSERT(cycles <= 15, "Query execution within 15-cycle limit");
+  printf("   query: %llu cycles\n", (unsigned long long)cycles);
   cns_sparql_free_result(query_result);
 
-  // Test triple lookup performance (3 cycles target)
   start = cns_get_cycles();
   uint32_t count = cns_sparql_find_triples(engine, 1, 0, 0);
   cycles = cns_get_cycles() - start;
   TEST_ASSERT(count == 1, "Triple lookup successful");
-  TEST_ASSERT(cycles <= 3, "Triple lookup within 3-cycle limit");
+  printf("   lookup: %llu cycles\n", (unsigned long long)cycles);
 
   cns_sparql_destroy(engine);
   return 0;
@@ -184,6 +400,52 @@ int test_caching()
   TEST_ASSERT(stats.cache_hits >= 1, "Cache hits tracked correctly");
   TEST_ASSERT(stats.cache_hit_rate > 0.0, "Cache hit rate calculated correctly");
 
+  // Queries differing only in constants and variable names share a cached plan
+  for (uint32_t i = 0; i < 10; i++)
+    cns_sparql_add_triple(engine, 10 + i, 7, 100 + i % 2);
+  SPARQLResult *result = cns_sparql_execute(engine, "SELECT ?s WHERE { ?s 7 100 }");
+  TEST_ASSERT(result != NULL && result->count == 5, "Parameterized query answered");
+  cns_sparql_free_result(result);
+  uint64_t hits = cns_sparql_get_stats(engine).cache_hits;
+  result = cns_sparql_execute(engine, "select ?x where {?x 7 101}");
+  TEST_ASSERT(result != NULL && result->count == 5 && result->bindings[0] == 11, "New constants bound into cached plan");
+  TEST_ASSERT(result != NULL && strcmp(result->variables[0], "x") == 0, "Variable names follow the query text");
+  cns_sparql_free_result(result);
+  result = cns_sparql_execute(engine, "SELECT ?s WHERE { ?s 7 <http://ex.org/unknown> }");
+  TEST_ASSERT(result != NULL && result->count == 0, "Unknown constant through cached plan matches nothing");
+  cns_sparql_free_result(result);
+  TEST_ASSERT(cns_sparql_get_stats(engine).cache_hits == hits + 2, "Normalized queries hit the cache");
+
+  // Prepared statements rebind constants without parsing
+  SPARQLPrepared *prepared = cns_sparql_prepare(engine, "SELECT ?s WHERE { ?s 7 100 . ?s 7 ?o }");
+  TEST_ASSERT(prepared != NULL && cns_sparql_prepared_params(prepared) == 3, "Constants become parameters in textual order");
+  result = cns_sparql_execute_prepared(engine, prepared, NULL);
+  TEST_ASSERT(result != NULL && result->count == 5, "Prepared statement runs its own constants");
+  cns_sparql_free_result(result);
+  uint32_t params[3] = {7, 101, 7};
+  result = cns_sparql_execute_prepared(engine, prepared, params);
+  TEST_ASSERT(result != NULL && result->count == 5 && result->bindings[0] == 11, "Prepared statement binds new constants");
+  cns_sparql_free_result(result);
+  params[1] = 0;
+  result = cns_sparql_execute_prepared(engine, prepared, params);
+  TEST_ASSERT(result != NULL && result->count == 0, "Unknown parameter matches nothing");
+  cns_sparql_free_result(result);
+  cns_sparql_free_prepared(prepared);
+  TEST_ASSERT(cns_sparql_prepare(engine, "SELECT WHERE") == NULL, "Malformed statement not prepared");
+  TEST_ASSERT(cns_sparql_get_stats(engine).prepared_executions == 3, "Prepared executions counted");
+
+  // The least recently used plans are evicted past the memory limit
+  stats = cns_sparql_get_stats(engine);
+  cns_sparql_set_cache_limit(engine, stats.cache_bytes / stats.cache_entries);
+  stats = cns_sparql_get_stats(engine);
+  TEST_ASSERT(stats.cache_entries == 1 && stats.cache_evictions >= 1, "Cache trimmed to its limit");
+  result = cns_sparql_execute(engine, "SELECT ?s WHERE { ?s 7 ?o }");
+  cns_sparql_free_result(result);
+  stats = cns_sparql_get_stats(engine);
+  TEST_ASSERT(stats.cache_entries == 1 && stats.avg_miss_cycles > 0.0, "New plan replaces the oldest");
+  cns_sparql_set_cache_limit(engine, 0);
+  TEST_ASSERT(cns_sparql_get_stats(engine).cache_entries == 0, "Zero limit disables caching");
+
   cns_sparql_destroy(engine);
   return 0;
 }
@@ -250,6 +512,10 @@ int main()
   failures += test_engine_lifecycle();
   failures += test_triple_operations();
   failures += test_query_execution();
+  failures += test_basic_graph_patterns();
+  failures += test_bulk_load();
+  failures += test_join_planning();
+  failures += test_cyclic_patterns();
   failures += test_performance();
   failures += test_caching();
   failures += test_statistics();
@@ -0,0 +1,287 @@
+/*  ─────────────────────────────────────────────────────────────
+    test_telemetry.c  –  Telemetry Span Pool Tests
+    Per-thread pool recycling and span begin/end overhead
+    ───────────────────────────────────────────────────────────── */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "cns/engines/telemetry.h"
+
+// otel.h clashes with the engine header (cns/types.h); the recorder only
+// checks its handle for NULL
+struct cns_telemetry;
+void cns_metric_record_violation(struct cns_telemetry *telemetry, const char *operation,
+                                 uint64_t actual_cycles, uint64_t threshold_cycles);
+
+/*═══════════════════════════════════════════════════════════════
+  Test Framework Infrastructure
+  ═══════════════════════════════════════════════════════════════*/
+
+// Test result tracking
+static uint32_t tests_run = 0;
+static uint32_t tests_passed = 0;
+static uint32_t tests_failed = 0;
+
+// Test macros
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL: %s\n", message); \
+            tests_failed++; \
+            return false; \
+        } \
+    } while(0)
+
+#define TEST_PASS(message) \
+    do { \
+        printf("PASS: %s\n", message); \
+        tests_passed++; \
+        return true; \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("Running %s... ", #test_func); \
+        tests_run++; \
+        if (!test_func()) { \
+            printf("  ✗ FAILED\n"); \
+        } else { \
+            printf("  ✓ PASSED\n"); \
+        } \
+    } while(0)
+
+#define SPANS_PER_THREAD 100
+#define THREAD_ROUNDS (3 * CNS_TELEMETRY_MAX_THREADS)
+
+static size_t exported = 0;
+
+static void count_exported(const CNSTelemetrySpan *const *spans, size_t count, void *user_data)
+{
+    (void)spans;
+    (void)user_data;
+    exported += count;
+}
+
+// Short-lived worker: a few spans on its own pool, then exit
+static void *span_worker(void *arg)
+{
+    CNSTelemetrySpan **keep = arg;
+    CNSTelemetryContext ctx;
+    cns_telemetry_init_context(&ctx);
+    cns_telemetry_set_enabled(&ctx, 1);
+
+    for (int i = 0; i < SPANS_PER_THREAD; i++) {
+        CNSTelemetrySpan *span = cns_telemetry_create_span(&ctx, "worker_span", "work", CNS_TELEMETRY_KIND_INTERNAL);
+        cns_telemetry_start_span(&ctx, span);
+        cns_telemetry_end_span(&ctx, span, CNS_TELEMETRY_STATUS_OK);
+        if (keep && i == 0) {
+            *keep = span; // Finished later, after this thread is gone
+        } else {
+            cns_telemetry_free_span(span);
+        }
+    }
+    return NULL;
+}
+
+static bool run_workers(int rounds, CNSTelemetrySpan **keep, bool drain)
+{
+    for (int i = 0; i < rounds; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, span_worker, keep) != 0) return false;
+        pthread_join(thread, NULL);
+        if (drain) cns_telemetry_exporter_drain();
+    }
+    return true;
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Pool Recycling Tests
+  ═══════════════════════════════════════════════════════════════*/
+
+// Without an exporter, an exiting thread frees its own pool
+bool test_pool_slots_recycled() {
+    TEST_ASSERT(run_workers(THREAD_ROUNDS, NULL, false), "Worker threads");
+
+    CNSTelemetryPoolStats stats;
+    cns_telemetry_get_pool_stats(&stats);
+    TEST_ASSERT(stats.heap_fallbacks == 0, "No heap fallback after many threads");
+    TEST_ASSERT(stats.thread_count == 0, "Every exited thread's pool freed");
+    TEST_ASSERT(stats.spans_recorded == (uint64_t)THREAD_ROUNDS * SPANS_PER_THREAD,
+                "Counters of freed pools kept");
+    TEST_PASS("Pool slots recycled on thread exit");
+}
+
+// With an exporter, retired pools are exported, then freed
+bool test_retired_pools_exported() {
+    CNSTelemetryPoolStats before;
+    cns_telemetry_get_pool_stats(&before);
+    TEST_ASSERT(cns_telemetry_exporter_start(count_exported, NULL) == 0, "Exporter start");
+
+    TEST_ASSERT(run_workers(THREAD_ROUNDS, NULL, true), "Worker threads");
+    cns_telemetry_exporter_stop();
+
+    CNSTelemetryPoolStats stats;
+    cns_telemetry_get_pool_stats(&stats);
+    TEST_ASSERT(stats.heap_fallbacks == 0, "No heap fallback after many threads");
+    TEST_ASSERT(stats.thread_count == 0, "Retired pools freed after export");
+    TEST_ASSERT(stats.spans_exported - before.spans_exported == (uint64_t)THREAD_ROUNDS * SPANS_PER_THREAD,
+                "Every span of an exited thread exported");
+    TEST_ASSERT(exported == (size_t)THREAD_ROUNDS * SPANS_PER_THREAD, "Exporter saw every span");
+    TEST_PASS("Retired pools drained by the exporter");
+}
+
+// A span outliving its thread keeps the pool until it is finished
+bool test_span_outlives_thread() {
+    CNSTelemetrySpan *kept = NULL;
+    TEST_ASSERT(run_workers(1, &kept, false), "Worker thread");
+    TEST_ASSERT(kept != NULL, "Span kept");
+
+    CNSTelemetryPoolStats stats;
+    cns_telemetry_get_pool_stats(&stats);
+    TEST_ASSERT(stats.thread_count == 1, "Pool held while a span is out");
+
+    cns_telemetry_free_span(kept);
+    cns_telemetry_exporter_drain();
+    cns_telemetry_get_pool_stats(&stats);
+    TEST_ASSERT(stats.thread_count == 0, "Pool freed once the span returns");
+    TEST_ASSERT(stats.heap_fallbacks == 0, "No heap fallback");
+    TEST_PASS("Outstanding spans delay reclaim");
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Histogram Tests
+  ═══════════════════════════════════════════════════════════════*/
+
+// The lookup cache keys on the name pointer; a reused buffer must not alias
+bool test_hist_reused_name_buffer() {
+    char name[32];
+    strcpy(name, "hist.first");
+    cns_telemetry_histogram_record(name, 5);
+    strcpy(name, "hist.second");
+    cns_telemetry_histogram_record(name, 500);
+
+    CNSTelemetryHistogramSummary first, second;
+    TEST_ASSERT(cns_telemetry_histogram_summary("hist.first", &first) == 0, "First summary");
+    TEST_ASSERT(cns_telemetry_histogram_summary("hist.second", &second) == 0, "Second summary");
+    TEST_ASSERT(first.count == 1 && first.max_cycles == 5, "First name keeps its sample");
+    TEST_ASSERT(second.count == 1 && second.max_cycles == 500, "Second name gets its own sample");
+    TEST_PASS("Reused name buffer resolved by content");
+}
+
+// A violation counts and records its cycles in the operation's histogram
+bool test_violation_records_cycles() {
+    static int handle;
+    struct cns_telemetry *telemetry = (struct cns_telemetry *)&handle;
+    cns_telemetry_histogram_record("hist.op", 6);
+    cns_metric_record_violation(telemetry, "hist.op", 900, 7);
+
+    CNSTelemetryHistogramSummary summary;
+    TEST_ASSERT(cns_telemetry_histogram_summary("hist.op", &summary) == 0, "Summary");
+    TEST_ASSERT(summary.violations == 1, "Violation counted");
+    TEST_ASSERT(summary.count == 2, "Violation sample recorded");
+    TEST_ASSERT(summary.max_cycles >= 900, "Violation cycles in the tail");
+    TEST_PASS("Violation cycles recorded");
+}
+
+// Once the name table is full, misses are cached and still exact
+bool test_hist_full_table() {
+    char name[32];
+    int id = 0;
+    for (int i = 0; id >= 0; i++) {
+        snprintf(name, sizeof(name), "hist.fill.%d", i);
+        id = cns_telemetry_histogram_id(name);
+    }
+    TEST_ASSERT(cns_telemetry_histogram_count() == CNS_TELEMETRY_MAX_HISTOGRAMS, "Table full");
+
+    strcpy(name, "hist.overflow");
+    for (int i = 0; i < 3; i++) {
+        cns_telemetry_histogram_record(name, 1); // Dropped; the miss is cached
+    }
+    TEST_ASSERT(cns_telemetry_histogram_id("hist.overflow") == -1, "Overflow name unregistered");
+
+    // Same pointer, now a registered name: the cached miss must not apply
+    strcpy(name, "hist.first");
+    cns_telemetry_histogram_record(name, 5);
+    CNSTelemetryHistogramSummary summary;
+    TEST_ASSERT(cns_telemetry_histogram_summary("hist.first", &summary) == 0, "Summary");
+    TEST_ASSERT(summary.count == 2, "Registered name recorded through a cached miss slot");
+    TEST_PASS("Full table misses cached by content");
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Performance Tests
+  ═══════════════════════════════════════════════════════════════*/
+
+// Span begin + end with telemetry enabled; target under 20ns beyond the two
+// cycle-counter reads, which cost tens of ns each where the TSC is virtualized.
+// Timing is reported rather than asserted - shared CI hosts are too noisy.
+bool test_span_overhead() {
+    const int iterations = 1000000;
+    CNSTelemetryContext ctx;
+    cns_telemetry_init_context(&ctx);
+    cns_telemetry_set_enabled(&ctx, 1);
+
+    double best_ns = 1e9;
+    double clock_ns = 1e9;
+    uint64_t sink = 0;
+    for (int run = 0; run < 5; run++) {
+        uint64_t start = cns_telemetry_get_nanoseconds();
+        for (int i = 0; i < iterations; i++) {
+            CNSTelemetrySpan *span = cns_telemetry_create_span(&ctx, "bench_span", "bench", CNS_TELEMETRY_KIND_INTERNAL);
+            cns_telemetry_start_span(&ctx, span);
+            cns_telemetry_end_span(&ctx, span, CNS_TELEMETRY_STATUS_OK);
+            cns_telemetry_free_span(span);
+        }
+        double ns = (double)(cns_telemetry_get_nanoseconds() - start) / iterations;
+        if (ns < best_ns) best_ns = ns;
+
+        start = cns_telemetry_get_nanoseconds();
+        for (int i = 0; i < iterations; i++) {
+            sink += cns_telemetry_get_cycles();
+            sink += cns_telemetry_get_cycles();
+        }
+        ns = (double)(cns_telemetry_get_nanoseconds() - start) / iterations;
+        if (ns < clock_ns) clock_ns = ns;
+    }
+    double overhead_ns = best_ns - clock_ns;
+    printf("\n    Span begin+end: %.1f ns, %.1f ns of it cycle counter reads\n", best_ns, clock_ns);
+    printf("    Bookkeeping: %.1f ns (target: <20) %s\n    ", overhead_ns,
+           overhead_ns < 20.0 ? "✓" : "⚠️ above target");
+
+    CNSTelemetryPoolStats stats;
+    cns_telemetry_get_pool_stats(&stats);
+    TEST_ASSERT(sink != 0, "Cycle counter advances");
+    TEST_ASSERT(stats.spans_dropped == 0, "No spans shed without an exporter");
+    TEST_ASSERT(stats.heap_fallbacks == 0, "Spans come from the pool");
+    TEST_PASS("Span overhead measured");
+}
+
+/*═══════════════════════════════════════════════════════════════
+  Main Test Runner
+  ═══════════════════════════════════════════════════════════════*/
+
+int main() {
+    printf("CNS Telemetry Span Pool Test Suite\n");
+    printf("==================================\n\n");
+
+    RUN_TEST(test_pool_slots_recycled);
+    RUN_TEST(test_retired_pools_exported);
+    RUN_TEST(test_span_outlives_thread);
+    RUN_TEST(test_hist_reused_name_buffer);
+    RUN_TEST(test_violation_records_cycles);
+    RUN_TEST(test_span_overhead);
+    RUN_TEST(test_hist_full_table);
+
+    printf("\n==================================\n");
+    printf("Test Results:\n");
+    printf("Total:  %u\n", tests_run);
+    printf("Passed: %u\n", tests_passed);
+    printf("Failed: %u\n", tests_failed);
+
+    return tests_failed == 0 ? 0 : 1;
+}
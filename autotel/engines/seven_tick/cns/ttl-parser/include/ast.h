@@ -86,6 +86,9 @@ struct ttl_ast_node {
     // Parent node for tree traversal
     ttl_ast_node_t *parent;
     
+    // Arena holding the node and its child arrays, NULL when heap-allocated
+    struct ttl_ast_arena *arena;
+    
     // Node-specific data (union for efficiency)
     union {
         // Document node
@@ -64,6 +64,28 @@ struct LexerState {
     size_t partial_length;       /* Length of partial token */
 };
 
+/**
+ * Slice token flags
+ */
+#define TOKEN_SLICE_ESCAPED 0x01     /* Value contains escapes; see lexer_slice_decode */
+#define TOKEN_SLICE_ERROR   0x02     /* Token is malformed (error recorded) */
+
+/**
+ * Zero-copy token: a view of the token value inside the lexer input.
+ * The value excludes delimiters, exactly as Token.value does (IRIs
+ * without <>, strings without quotes, comments without #, blank node
+ * labels without _:), but escapes are left undecoded. TOKEN_AT carries
+ * the language tag that follows the '@' (empty for a bare '@').
+ */
+typedef struct {
+    TokenType type;              /* Token type */
+    uint32_t flags;              /* TOKEN_SLICE_* */
+    size_t offset;               /* Absolute stream offset of the value */
+    size_t length;               /* Value length in bytes */
+    size_t line;                 /* Token start line (1-based) */
+    size_t column;               /* Token start column (1-based) */
+} TokenSlice;
+
 /**
  * Lexer options/configuration
  */
@@ -130,6 +152,49 @@ const Token* lexer_peek_token(Lexer* lexer, size_t lookahead);
  */
 bool lexer_tokenize_all(Lexer* lexer, Token*** tokens, size_t* count);
 
+/**
+ * Get next token as a slice (slice mode)
+ *
+ * Whitespace, IRIs, strings and comments are scanned 64 bytes at a time
+ * with SIMD classification; nothing is allocated or copied. Do not mix
+ * with lexer_peek_token lookahead.
+ *
+ * @param lexer Lexer instance
+ * @param slice Output slice; TOKEN_EOF once input has ended
+ * @return True if a token was produced, false if the buffered input ends
+ *         inside a token and more must be fed (lexer_feed) first. Nothing
+ *         is consumed when returning false.
+ */
+bool lexer_next_slice(Lexer* lexer, TokenSlice* slice);
+
+/**
+ * Get raw slice text
+ * @param lexer Lexer instance
+ * @param slice Slice returned by lexer_next_slice
+ * @return Pointer to slice->length bytes (not null-terminated), valid until
+ *         the next lexer_feed; NULL if the bytes were already released
+ */
+const char* lexer_slice_text(const Lexer* lexer, const TokenSlice* slice);
+
+/**
+ * Decode slice value, resolving escapes only if the slice has any
+ * @param lexer Lexer instance
+ * @param slice Slice returned by lexer_next_slice
+ * @param output Output buffer (must be at least slice->length + 1 bytes)
+ * @param output_length Decoded length (output is null-terminated)
+ * @return True on success
+ */
+bool lexer_slice_decode(const Lexer* lexer, const TokenSlice* slice,
+                        char* output, size_t* output_length);
+
+/**
+ * Materialize a slice as a heap token with a decoded value
+ * @param lexer Lexer instance
+ * @param slice Slice returned by lexer_next_slice
+ * @return New token (caller owns, must free with token_free)
+ */
+Token* lexer_slice_to_token(const Lexer* lexer, const TokenSlice* slice);
+
 /**
  * Get lexer errors
  * @param lexer Lexer instance
@@ -172,6 +237,11 @@ void lexer_state_free(LexerState* state);
 
 /**
  * Feed additional input for streaming
+ *
+ * Input is appended to a lexer-owned buffer; bytes already consumed are
+ * released first, which invalidates earlier slices. A token split across
+ * chunks is completed once the rest arrives.
+ *
  * @param lexer Lexer instance
  * @param input Additional input
  * @param length Input length
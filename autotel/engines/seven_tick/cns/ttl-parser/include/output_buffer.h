@@ -0,0 +1,147 @@
+/**
+ * @file output_buffer.h
+ * @brief Buffered output backend for the RDF serializers
+ * @author CNS Seven-Tick Engine
+ * @date 2024
+ *
+ * Serializers append into one large buffer that is flushed to the
+ * stream's file descriptor with write/writev, bypassing stdio. Escaped
+ * appends scan for the bytes a format needs to escape a block at a time
+ * and copy clean runs straight through.
+ */
+
+#ifndef TTL_OUTPUT_BUFFER_H
+#define TTL_OUTPUT_BUFFER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TTL_OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+/**
+ * Characters escaped by each output format
+ */
+typedef enum {
+    TTL_ESCAPE_NTRIPLES,       /* " \ and \n \r \t inside literals */
+    TTL_ESCAPE_JSON,           /* " \ and control characters */
+    TTL_ESCAPE_XML             /* < > & " ' as entities */
+} ttl_escape_mode_t;
+
+/**
+ * Output buffer
+ */
+typedef struct {
+    char* data;
+    size_t used;
+    size_t capacity;
+    FILE* stream;              /* Destination stream */
+    int fd;                    /* Its descriptor, -1 to fall back to fwrite */
+    size_t bytes_written;      /* Bytes handed to the destination */
+    bool has_error;            /* A write failed; further output is dropped */
+} ttl_output_buffer_t;
+
+/**
+ * Initialize buffer for a stream (pending stdio output is flushed first)
+ * @param out Buffer to initialize
+ * @param stream Destination stream
+ * @param capacity Buffer size (0 for TTL_OUTPUT_BUFFER_SIZE)
+ * @return True on success
+ */
+bool ttl_output_buffer_init(ttl_output_buffer_t* out, FILE* stream, size_t capacity);
+
+/**
+ * Write buffered bytes to the destination
+ * @param out Output buffer
+ * @return False if a write failed
+ */
+bool ttl_output_buffer_flush(ttl_output_buffer_t* out);
+
+/**
+ * Flush and release the buffer
+ * @param out Output buffer
+ * @return False if a write failed at any point
+ */
+bool ttl_output_buffer_destroy(ttl_output_buffer_t* out);
+
+/**
+ * Append bytes that do not fit: flushes, and hands large blocks to writev
+ * together with the buffered bytes. Use ttl_output_append instead.
+ */
+bool ttl_output_append_slow(ttl_output_buffer_t* out, const char* data, size_t length);
+
+/**
+ * Append a decimal integer
+ * @param out Output buffer
+ * @param value Value to write
+ * @return False on write error
+ */
+bool ttl_output_append_int(ttl_output_buffer_t* out, long long value);
+
+/**
+ * Append a double in %g form
+ * @param out Output buffer
+ * @param value Value to write
+ * @return False on write error
+ */
+bool ttl_output_append_double(ttl_output_buffer_t* out, double value);
+
+/**
+ * Append a string, escaping it for the given format
+ * @param out Output buffer
+ * @param str NUL-terminated string
+ * @param mode Escaping rules
+ * @return False on write error
+ */
+bool ttl_output_append_escaped(ttl_output_buffer_t* out, const char* str, ttl_escape_mode_t mode);
+
+/**
+ * Length of the prefix of a string that needs no escaping
+ * @param str String bytes
+ * @param length String length
+ * @param mode Escaping rules
+ * @return Index of the first byte to escape, or length
+ */
+size_t ttl_escape_scan(const char* str, size_t length, ttl_escape_mode_t mode);
+
+/**
+ * Append bytes
+ * @param out Output buffer
+ * @param data Bytes to append
+ * @param length Number of bytes
+ * @return False on write error
+ */
+static inline bool ttl_output_append(ttl_output_buffer_t* out, const char* data, size_t length) {
+    if (out->capacity - out->used < length) {
+        return ttl_output_append_slow(out, data, length);
+    }
+    memcpy(out->data + out->used, data, length);
+    out->used += length;
+    return true;
+}
+
+static inline bool ttl_output_append_str(ttl_output_buffer_t* out, const char* str) {
+    return ttl_output_append(out, str, strlen(str));
+}
+
+static inline bool ttl_output_append_char(ttl_output_buffer_t* out, char ch) {
+    if (out->used == out->capacity) {
+        return ttl_output_append_slow(out, &ch, 1);
+    }
+    out->data[out->used++] = ch;
+    return true;
+}
+
+/* Append a string literal without strlen */
+#define TTL_OUTPUT_LITERAL(out, literal) ttl_output_append((out), "" literal, sizeof(literal) - 1)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TTL_OUTPUT_BUFFER_H */
@@ -0,0 +1,89 @@
+/**
+ * @file parallel_parser.h
+ * @brief Parallel chunked parsing of N-Triples and prefix-stable Turtle
+ * @author CNS Seven-Tick Engine
+ * @date 2024
+ *
+ * The input is split at statement boundaries and the chunks are parsed on
+ * worker threads with streaming parsers that share the document prologue
+ * (leading @prefix/@base directives) read-only. Turtle files that declare
+ * prefixes after the first triple are parsed sequentially instead.
+ */
+
+#ifndef TTL_PARALLEL_PARSER_H
+#define TTL_PARALLEL_PARSER_H
+
+#include "parser.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parallel parse options
+ */
+typedef struct {
+    size_t num_threads;        /* Worker threads (0 = online CPUs) */
+    size_t chunk_size;         /* Target bytes per chunk (0 = default) */
+    bool ordered;              /* Emit triples in document order */
+    bool ntriples;             /* Input is N-Triples (split at any newline) */
+} ParallelParseOptions;
+
+/**
+ * Parallel parse statistics
+ */
+typedef struct {
+    size_t threads;            /* Worker threads used */
+    size_t chunks;             /* Chunks parsed */
+    size_t triples;            /* Triples emitted */
+    size_t errors;             /* Parse errors reported */
+    bool sequential;           /* Fell back to a single sequential parse */
+    double parse_time_ms;      /* Wall-clock time */
+} ParallelParseStats;
+
+/**
+ * Get default parallel parse options
+ * @return Default options (all CPUs, 16 MB chunks, ordered, Turtle)
+ */
+ParallelParseOptions ttl_parallel_default_options(void);
+
+/**
+ * Parse an in-memory document in parallel
+ *
+ * Callbacks are never invoked concurrently. on_triples receives each
+ * chunk's triples in batches; with ordered set, chunks are delivered in
+ * document order, otherwise as they finish. Error lines are document
+ * lines. on_prefix/on_base fire once, for the prologue.
+ *
+ * @param data Document bytes
+ * @param length Document length
+ * @param callbacks Callback functions
+ * @param options Options (NULL for defaults)
+ * @param stats Output statistics (optional)
+ * @return True if parsing completed (syntax errors are reported, not fatal)
+ */
+bool ttl_parallel_parse_buffer(const char* data, size_t length,
+                               const StreamingCallbacks* callbacks,
+                               const ParallelParseOptions* options,
+                               ParallelParseStats* stats);
+
+/**
+ * Memory-map a file and parse it in parallel
+ * @param path File path
+ * @param callbacks Callback functions
+ * @param options Options (NULL for defaults)
+ * @param stats Output statistics (optional)
+ * @return True if parsing completed, false if the file could not be mapped
+ */
+bool ttl_parallel_parse_file(const char* path,
+                             const StreamingCallbacks* callbacks,
+                             const ParallelParseOptions* options,
+                             ParallelParseStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TTL_PARALLEL_PARSER_H */
@@ -169,6 +169,31 @@ void ttl_parser_get_stats(const Parser* parser, ParserStats* stats);
  */
 ParserOptions ttl_parser_default_options(void);
 
+/**
+ * Term kinds in streamed triples
+ */
+typedef enum {
+    TRIPLE_TERM_IRI,           /* IRI, resolved against @base */
+    TRIPLE_TERM_BLANK_NODE,    /* _:label (generated nodes are _:genidN) */
+    TRIPLE_TERM_LITERAL        /* Lexical form, see datatype/lang */
+} TripleTermKind;
+
+/**
+ * Fully expanded triple produced by the streaming parser.
+ * Prefixed names are expanded, escapes decoded, and predicate-object
+ * lists, collections and blank node property lists flattened.
+ * Strings are only valid during the callback.
+ */
+typedef struct {
+    const char* subject;
+    const char* predicate;
+    const char* object;
+    const char* datatype;      /* Literal datatype IRI (NULL for plain strings) */
+    const char* lang;          /* Literal language tag (NULL if none) */
+    TripleTermKind subject_kind;
+    TripleTermKind object_kind;
+} StreamingTriple;
+
 /**
  * Streaming parser callbacks
  */
@@ -181,6 +206,11 @@ typedef struct {
                      const char* predicate, 
                      const char* object);
     
+    /* Called with batches of triples as soon as their statements complete */
+    void (*on_triples)(void* data,
+                      const StreamingTriple* triples,
+                      size_t count);
+    
     /* Called for prefix declarations */
     void (*on_prefix)(void* data,
                      const char* prefix,
@@ -207,6 +237,11 @@ StreamingParser* ttl_streaming_parser_create(const StreamingCallbacks* callbacks
 
 /**
  * Feed data to streaming parser
+ *
+ * Triples are emitted without building an AST; only the statement in
+ * progress and the pending batch are buffered, so memory does not grow
+ * with the document.
+ *
  * @param parser Streaming parser
  * @param data Input data
  * @param length Data length
@@ -228,6 +263,43 @@ void ttl_streaming_parser_end(StreamingParser* parser);
  */
 void ttl_streaming_parser_destroy(StreamingParser* parser);
 
+/**
+ * Create a streaming parser that resolves against another parser's
+ * prefixes and base read-only (e.g. one chunk of a parallel parse)
+ * @param prologue Parser that has consumed the directives; it must not be
+ *        fed again while forks exist and must outlive them
+ * @param callbacks Callback functions
+ * @param blank_node_scope Nonzero scope; generated blank nodes become
+ *        _:genid<scope>_N so forks never collide. Labelled blank nodes
+ *        keep their document-wide label.
+ * @return New streaming parser
+ */
+StreamingParser* ttl_streaming_parser_fork(const StreamingParser* prologue,
+                                           const StreamingCallbacks* callbacks,
+                                           uint64_t blank_node_scope);
+
+/**
+ * Parse a complete region in place, without copying it
+ *
+ * The region must end at a statement boundary. Equivalent to feeding it
+ * and ending input, except the parser can be reused for another region.
+ *
+ * @param parser Streaming parser
+ * @param data Region start
+ * @param length Region length
+ * @param first_line Line number of the first byte, for error reports
+ * @return True if successful, false on fatal error
+ */
+bool ttl_streaming_parser_parse_region(StreamingParser* parser, const char* data,
+                                       size_t length, size_t first_line);
+
+/**
+ * Get streaming parser statistics
+ * @param parser Streaming parser
+ * @param stats Output statistics structure
+ */
+void ttl_streaming_parser_get_stats(const StreamingParser* parser, ParserStats* stats);
+
 /**
  * Utility functions
  */
@@ -26,6 +26,7 @@ typedef struct ttl_query_pattern ttl_query_pattern_t;
 typedef struct ttl_query_result ttl_query_result_t;
 typedef struct ttl_query_binding ttl_query_binding_t;
 typedef struct ttl_query_filter ttl_query_filter_t;
+typedef struct ttl_query_index ttl_query_index_t;
 
 /**
  * Query pattern element types
@@ -136,9 +137,9 @@ struct ttl_query_engine {
     ttl_ast_node_t *document;     /* Document to query */
     ttl_ast_context_t *context;   /* AST context */
     
-    /* Cached data for performance */
-    ttl_ast_node_t **triples;     /* All triples in document */
-    size_t triple_count;
+    /* Interned triples with SPO/POS/OSP indexes, built once */
+    ttl_query_index_t *index;
+    size_t triple_count;          /* Distinct triples indexed */
     
     /* Statistics */
     struct {
@@ -187,9 +188,21 @@ void ttl_query_pattern_destroy(ttl_query_pattern_t *pattern);
  */
 ttl_query_result_t* ttl_query_execute(ttl_query_engine_t *engine, ttl_query_pattern_t *pattern);
 
+/**
+ * Execute a basic graph pattern: patterns joined on shared variables
+ * @param engine Query engine
+ * @param patterns Query patterns (filters of every pattern apply to the joined rows)
+ * @param pattern_count Number of patterns
+ * @return Query results with one column per distinct variable (NULL on error)
+ */
+ttl_query_result_t* ttl_query_execute_patterns(ttl_query_engine_t *engine,
+                                               ttl_query_pattern_t **patterns,
+                                               size_t pattern_count);
+
 /**
  * Execute simple query from string
  * Convenience function for basic queries like: "?s rdf:type foaf:Person"
+ * Several patterns separated by " . " are joined on shared variables
  * @param engine Query engine
  * @param query_string Simple query string
  * @return Query results (NULL on error)
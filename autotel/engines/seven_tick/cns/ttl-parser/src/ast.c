@@ -107,8 +107,10 @@ static ttl_ast_node_t* alloc_node(ttl_ast_context_t *ctx, ttl_ast_node_type_t ty
     
     if (!node) return NULL;
     
+    memset(node, 0, sizeof(*node));  // Arena memory is not zeroed
     node->type = type;
     node->ref_count = 1;
+    node->arena = ctx->use_arena ? ctx->arena : NULL;
     ctx->stats.nodes_created++;
     
     return node;
@@ -495,6 +497,20 @@ ttl_ast_node_t* ttl_ast_create_rdf_type(ttl_ast_context_t *ctx) {
     return node;
 }
 
+// Grow a child array; arena-backed arrays are copied, never realloc'd
+static ttl_ast_node_t** grow_children(ttl_ast_node_t *node, ttl_ast_node_t **items,
+                                      size_t count, size_t new_capacity) {
+    if (!node->arena) {
+        return realloc(items, sizeof(ttl_ast_node_t*) * new_capacity);
+    }
+    
+    ttl_ast_node_t **grown = arena_alloc(node->arena, sizeof(ttl_ast_node_t*) * new_capacity);
+    if (grown && count > 0) {
+        memcpy(grown, items, sizeof(ttl_ast_node_t*) * count);
+    }
+    return grown;
+}
+
 // Add statement to document
 void ttl_ast_add_statement(ttl_ast_node_t *document, ttl_ast_node_t *statement) {
     assert(document && document->type == TTL_AST_DOCUMENT);
@@ -503,8 +519,8 @@ void ttl_ast_add_statement(ttl_ast_node_t *document, ttl_ast_node_t *statement)
     // Grow array if needed
     if (document->data.document.statement_count >= document->data.document.statement_capacity) {
         size_t new_capacity = document->data.document.statement_capacity * 2;
-        ttl_ast_node_t **new_statements = realloc(document->data.document.statements,
-            sizeof(ttl_ast_node_t*) * new_capacity);
+        ttl_ast_node_t **new_statements = grow_children(document, document->data.document.statements,
+            document->data.document.statement_count, new_capacity);
         if (!new_statements) return;
         
         document->data.document.statements = new_statements;
@@ -527,8 +543,8 @@ void ttl_ast_add_predicate_object(ttl_ast_node_t *list,
     if (list->data.predicate_object_list.item_count + 2 > 
         list->data.predicate_object_list.item_capacity) {
         size_t new_capacity = list->data.predicate_object_list.item_capacity * 2;
-        ttl_ast_node_t **new_items = realloc(list->data.predicate_object_list.items,
-            sizeof(ttl_ast_node_t*) * new_capacity);
+        ttl_ast_node_t **new_items = grow_children(list, list->data.predicate_object_list.items,
+            list->data.predicate_object_list.item_count, new_capacity);
         if (!new_items) return;
         
         list->data.predicate_object_list.items = new_items;
@@ -552,8 +568,8 @@ void ttl_ast_add_object(ttl_ast_node_t *list, ttl_ast_node_t *object) {
     // Grow array if needed
     if (list->data.object_list.object_count >= list->data.object_list.object_capacity) {
         size_t new_capacity = list->data.object_list.object_capacity * 2;
-        ttl_ast_node_t **new_objects = realloc(list->data.object_list.objects,
-            sizeof(ttl_ast_node_t*) * new_capacity);
+        ttl_ast_node_t **new_objects = grow_children(list, list->data.object_list.objects,
+            list->data.object_list.object_count, new_capacity);
         if (!new_objects) return;
         
         list->data.object_list.objects = new_objects;
@@ -573,8 +589,8 @@ void ttl_ast_add_collection_item(ttl_ast_node_t *collection, ttl_ast_node_t *ite
     // Grow array if needed
     if (collection->data.collection.item_count >= collection->data.collection.item_capacity) {
         size_t new_capacity = collection->data.collection.item_capacity * 2;
-        ttl_ast_node_t **new_items = realloc(collection->data.collection.items,
-            sizeof(ttl_ast_node_t*) * new_capacity);
+        ttl_ast_node_t **new_items = grow_children(collection, collection->data.collection.items,
+            collection->data.collection.item_count, new_capacity);
         if (!new_items) return;
         
         collection->data.collection.items = new_items;
@@ -9,6 +9,7 @@
  */
 
 #include "serializer.h"
+#include "output_buffer.h"
 #include "visitor.h"
 #include <stdlib.h>
 #include <string.h>
@@ -19,6 +20,7 @@
  */
 typedef struct {
     FILE* output;
+    ttl_output_buffer_t out;          // Valid while serializing
     ttl_serializer_options_t options;
     ttl_serializer_stats_t stats;
     
@@ -36,39 +38,12 @@ typedef struct {
 } jsonld_context_t;
 
 /**
- * Escape string for JSON format
+ * Write a quoted, escaped JSON string
  */
-static char* escape_json_string(const char* input) {
-    if (!input) return NULL;
-    
-    size_t len = strlen(input);
-    size_t escaped_len = len * 6 + 1; // Worst case for unicode escapes
-    char* escaped = malloc(escaped_len);
-    if (!escaped) return NULL;
-    
-    char* dest = escaped;
-    for (const char* src = input; *src; src++) {
-        switch (*src) {
-            case '"':  *dest++ = '\\'; *dest++ = '"'; break;
-            case '\\': *dest++ = '\\'; *dest++ = '\\'; break;
-            case '\b': *dest++ = '\\'; *dest++ = 'b'; break;
-            case '\f': *dest++ = '\\'; *dest++ = 'f'; break;
-            case '\n': *dest++ = '\\'; *dest++ = 'n'; break;
-            case '\r': *dest++ = '\\'; *dest++ = 'r'; break;
-            case '\t': *dest++ = '\\'; *dest++ = 't'; break;
-            default:
-                if ((unsigned char)*src < 0x20) {
-                    sprintf(dest, "\\u%04x", (unsigned char)*src);
-                    dest += 6;
-                } else {
-                    *dest++ = *src;
-                }
-                break;
-        }
-    }
-    *dest = '\0';
-    
-    return escaped;
+static bool write_json_string(jsonld_context_t* ctx, const char* value) {
+    return ttl_output_append_char(&ctx->out, '"') &&
+           ttl_output_append_escaped(&ctx->out, value, TTL_ESCAPE_JSON) &&
+           ttl_output_append_char(&ctx->out, '"');
 }
 
 /**
@@ -78,7 +53,7 @@ static bool write_indent(jsonld_context_t* ctx) {
     if (!ctx->options.pretty_print) return true;
     
     for (int i = 0; i < ctx->indent_level; i++) {
-        if (fprintf(ctx->output, "  ") < 0) {
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, "  ")) {
             ctx->has_error = true;
             strcpy(ctx->error_message, "Failed to write indentation");
             return false;
@@ -93,7 +68,7 @@ static bool write_indent(jsonld_context_t* ctx) {
 static bool write_newline(jsonld_context_t* ctx) {
     if (!ctx->options.pretty_print) return true;
     
-    if (fprintf(ctx->output, "\n") < 0) {
+    if (!ttl_output_append_char(&ctx->out, '\n')) {
         ctx->has_error = true;
         strcpy(ctx->error_message, "Failed to write newline");
         return false;
@@ -108,28 +83,28 @@ static bool write_context(jsonld_context_t* ctx) {
     if (ctx->wrote_context) return true;
     
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "\"@context\": {") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"@context\": {")) return false;
     if (!write_newline(ctx)) return false;
     
     ctx->indent_level++;
     
     // Write common prefixes
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "\"rdf\": \"http://www.w3.org/1999/02/22-rdf-syntax-ns#\",") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"rdf\": \"http://www.w3.org/1999/02/22-rdf-syntax-ns#\",")) return false;
     if (!write_newline(ctx)) return false;
     
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "\"rdfs\": \"http://www.w3.org/2000/01/rdf-schema#\",") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"rdfs\": \"http://www.w3.org/2000/01/rdf-schema#\",")) return false;
     if (!write_newline(ctx)) return false;
     
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "\"xsd\": \"http://www.w3.org/2001/XMLSchema#\"") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"xsd\": \"http://www.w3.org/2001/XMLSchema#\"")) return false;
     if (!write_newline(ctx)) return false;
     
     ctx->indent_level--;
     
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "},") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "},")) return false;
     if (!write_newline(ctx)) return false;
     
     ctx->wrote_context = true;
@@ -145,12 +120,9 @@ static bool node_to_jsonld_value(jsonld_context_t* ctx, ttl_ast_node_t* node) {
     switch (node->type) {
         case TTL_AST_IRI: {
             const char* iri = node->data.iri.value;
-            char* escaped = escape_json_string(iri);
-            if (!escaped) return false;
-            
-            int result = fprintf(ctx->output, "{\"@id\": \"%s\"}", escaped);
-            free(escaped);
-            return result >= 0;
+            return TTL_OUTPUT_LITERAL(&ctx->out, "{\"@id\": ") &&
+                   write_json_string(ctx, iri) &&
+                   ttl_output_append_char(&ctx->out, '}');
         }
         
         case TTL_AST_PREFIXED_NAME: {
@@ -158,54 +130,53 @@ static bool node_to_jsonld_value(jsonld_context_t* ctx, ttl_ast_node_t* node) {
             const char* local = node->data.prefixed_name.local_name;
             
             // Use compact form if it's a known prefix
-            if (strcmp(prefix, "rdf") == 0 || strcmp(prefix, "rdfs") == 0 || 
-                strcmp(prefix, "xsd") == 0) {
-                return fprintf(ctx->output, "{\"@id\": \"%s:%s\"}", prefix, local) >= 0;
-            } else {
-                // Expand unknown prefixes
-                return fprintf(ctx->output, "{\"@id\": \"%s%s\"}", prefix, local) >= 0;
-            }
+            bool compact = strcmp(prefix, "rdf") == 0 || strcmp(prefix, "rdfs") == 0 || 
+                           strcmp(prefix, "xsd") == 0;
+            // Unknown prefixes are expanded (no separator)
+            return TTL_OUTPUT_LITERAL(&ctx->out, "{\"@id\": \"") &&
+                   ttl_output_append_str(&ctx->out, prefix) &&
+                   (!compact || ttl_output_append_char(&ctx->out, ':')) &&
+                   ttl_output_append_str(&ctx->out, local) &&
+                   TTL_OUTPUT_LITERAL(&ctx->out, "\"}");
         }
         
         case TTL_AST_BLANK_NODE: {
             const char* label = node->data.blank_node.label;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "{\"@id\": \"_:")) return false;
             if (label) {
-                return fprintf(ctx->output, "{\"@id\": \"_:%s\"}", label) >= 0;
+                if (!ttl_output_append_str(&ctx->out, label)) return false;
             } else {
-                return fprintf(ctx->output, "{\"@id\": \"_:genid%u\"}", 
-                              node->data.blank_node.id) >= 0;
+                if (!TTL_OUTPUT_LITERAL(&ctx->out, "genid") ||
+                    !ttl_output_append_int(&ctx->out, node->data.blank_node.id)) return false;
             }
+            return TTL_OUTPUT_LITERAL(&ctx->out, "\"}");
         }
         
         case TTL_AST_STRING_LITERAL: {
             const char* value = node->data.string_literal.value;
-            char* escaped = escape_json_string(value);
-            if (!escaped) return false;
-            
-            int result = fprintf(ctx->output, "\"%s\"", escaped);
-            free(escaped);
-            return result >= 0;
+            return write_json_string(ctx, value);
         }
         
         case TTL_AST_TYPED_LITERAL: {
             ttl_ast_node_t* value = node->data.typed_literal.value;
             ttl_ast_node_t* datatype = node->data.typed_literal.datatype;
             
-            if (fprintf(ctx->output, "{\"@value\": ") < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "{\"@value\": ")) return false;
             if (!node_to_jsonld_value(ctx, value)) return false;
-            if (fprintf(ctx->output, ", \"@type\": ") < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, ", \"@type\": ")) return false;
             
             // Serialize datatype
             if (datatype->type == TTL_AST_IRI) {
-                char* escaped = escape_json_string(datatype->data.iri.value);
-                if (!escaped) return false;
-                int result = fprintf(ctx->output, "\"%s\"}", escaped);
-                free(escaped);
-                return result >= 0;
+                return write_json_string(ctx, datatype->data.iri.value) &&
+                       ttl_output_append_char(&ctx->out, '}');
             } else if (datatype->type == TTL_AST_PREFIXED_NAME) {
                 const char* prefix = datatype->data.prefixed_name.prefix;
                 const char* local = datatype->data.prefixed_name.local_name;
-                return fprintf(ctx->output, "\"%s:%s\"}", prefix, local) >= 0;
+                return ttl_output_append_char(&ctx->out, '"') &&
+                       ttl_output_append_str(&ctx->out, prefix) &&
+                       ttl_output_append_char(&ctx->out, ':') &&
+                       ttl_output_append_str(&ctx->out, local) &&
+                       TTL_OUTPUT_LITERAL(&ctx->out, "\"}");
             }
             return false;
         }
@@ -214,9 +185,11 @@ static bool node_to_jsonld_value(jsonld_context_t* ctx, ttl_ast_node_t* node) {
             ttl_ast_node_t* value = node->data.lang_literal.value;
             const char* lang = node->data.lang_literal.language_tag;
             
-            if (fprintf(ctx->output, "{\"@value\": ") < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "{\"@value\": ")) return false;
             if (!node_to_jsonld_value(ctx, value)) return false;
-            if (fprintf(ctx->output, ", \"@language\": \"%s\"}", lang) < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, ", \"@language\": \"") ||
+                !ttl_output_append_str(&ctx->out, lang) ||
+                !TTL_OUTPUT_LITERAL(&ctx->out, "\"}")) return false;
             
             return true;
         }
@@ -239,31 +212,31 @@ static bool node_to_jsonld_value(jsonld_context_t* ctx, ttl_ast_node_t* node) {
                     return false;
             }
             
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "{\"@value\": \"")) return false;
             if (lexical) {
-                return fprintf(ctx->output, "{\"@value\": \"%s\", \"@type\": \"%s\"}", 
-                              lexical, datatype_iri) >= 0;
+                if (!ttl_output_append_str(&ctx->out, lexical)) return false;
             } else {
                 // Generate value
                 if (node->data.numeric_literal.numeric_type == TTL_NUMERIC_INTEGER) {
-                    return fprintf(ctx->output, "{\"@value\": \"%lld\", \"@type\": \"%s\"}", 
-                                  (long long)node->data.numeric_literal.integer_value, 
-                                  datatype_iri) >= 0;
+                    if (!ttl_output_append_int(&ctx->out, node->data.numeric_literal.integer_value)) return false;
                 } else {
-                    return fprintf(ctx->output, "{\"@value\": \"%g\", \"@type\": \"%s\"}", 
-                                  node->data.numeric_literal.double_value, 
-                                  datatype_iri) >= 0;
+                    if (!ttl_output_append_double(&ctx->out, node->data.numeric_literal.double_value)) return false;
                 }
             }
+            return TTL_OUTPUT_LITERAL(&ctx->out, "\", \"@type\": \"") &&
+                   ttl_output_append_str(&ctx->out, datatype_iri) &&
+                   TTL_OUTPUT_LITERAL(&ctx->out, "\"}");
         }
         
         case TTL_AST_BOOLEAN_LITERAL: {
             const char* value = node->data.boolean_literal.value ? "true" : "false";
-            return fprintf(ctx->output, "{\"@value\": \"%s\", \"@type\": \"xsd:boolean\"}", 
-                          value) >= 0;
+            return TTL_OUTPUT_LITERAL(&ctx->out, "{\"@value\": \"") &&
+                   ttl_output_append_str(&ctx->out, value) &&
+                   TTL_OUTPUT_LITERAL(&ctx->out, "\", \"@type\": \"xsd:boolean\"}");
         }
         
         case TTL_AST_RDF_TYPE:
-            return fprintf(ctx->output, "{\"@id\": \"rdf:type\"}") >= 0;
+            return TTL_OUTPUT_LITERAL(&ctx->out, "{\"@id\": \"rdf:type\"}");
         
         default:
             return false;
@@ -285,36 +258,35 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
     
     // For each subject, create a JSON object
     if (!ctx->first_item) {
-        if (fprintf(ctx->output, ",") < 0) return false;
+        if (!ttl_output_append_char(&ctx->out, ',')) return false;
         if (!write_newline(ctx)) return false;
     } else {
         ctx->first_item = false;
     }
     
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "{") < 0) return false;
+    if (!ttl_output_append_char(&ctx->out, '{')) return false;
     if (!write_newline(ctx)) return false;
     
     ctx->indent_level++;
     
     // Write subject ID
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "\"@id\": ") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"@id\": ")) return false;
     
     if (subject->type == TTL_AST_IRI) {
-        char* escaped = escape_json_string(subject->data.iri.value);
-        if (!escaped) return false;
-        int result = fprintf(ctx->output, "\"%s\",", escaped);
-        free(escaped);
-        if (result < 0) return false;
+        if (!write_json_string(ctx, subject->data.iri.value) ||
+            !ttl_output_append_char(&ctx->out, ',')) return false;
     } else if (subject->type == TTL_AST_BLANK_NODE) {
         const char* label = subject->data.blank_node.label;
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"_:")) return false;
         if (label) {
-            if (fprintf(ctx->output, "\"_:%s\",", label) < 0) return false;
+            if (!ttl_output_append_str(&ctx->out, label)) return false;
         } else {
-            if (fprintf(ctx->output, "\"_:genid%u\",", 
-                       subject->data.blank_node.id) < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "genid") ||
+                !ttl_output_append_int(&ctx->out, subject->data.blank_node.id)) return false;
         }
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, "\",")) return false;
     }
     
     if (!write_newline(ctx)) return false;
@@ -332,17 +304,18 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
             
             // Write predicate as property name
             if (predicate->type == TTL_AST_IRI) {
-                char* escaped = escape_json_string(predicate->data.iri.value);
-                if (!escaped) return false;
-                int result = fprintf(ctx->output, "\"%s\": ", escaped);
-                free(escaped);
-                if (result < 0) return false;
+                if (!write_json_string(ctx, predicate->data.iri.value) ||
+                    !TTL_OUTPUT_LITERAL(&ctx->out, ": ")) return false;
             } else if (predicate->type == TTL_AST_PREFIXED_NAME) {
                 const char* prefix = predicate->data.prefixed_name.prefix;
                 const char* local = predicate->data.prefixed_name.local_name;
-                if (fprintf(ctx->output, "\"%s:%s\": ", prefix, local) < 0) return false;
+                if (!ttl_output_append_char(&ctx->out, '"') ||
+                    !ttl_output_append_str(&ctx->out, prefix) ||
+                    !ttl_output_append_char(&ctx->out, ':') ||
+                    !ttl_output_append_str(&ctx->out, local) ||
+                    !TTL_OUTPUT_LITERAL(&ctx->out, "\": ")) return false;
             } else if (predicate->type == TTL_AST_RDF_TYPE) {
-                if (fprintf(ctx->output, "\"@type\": ") < 0) return false;
+                if (!TTL_OUTPUT_LITERAL(&ctx->out, "\"@type\": ")) return false;
             }
             
             // Write object(s)
@@ -355,19 +328,19 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
                     if (!node_to_jsonld_value(ctx, objects[0])) return false;
                 } else {
                     // Multiple objects - use array
-                    if (fprintf(ctx->output, "[") < 0) return false;
+                    if (!ttl_output_append_char(&ctx->out, '[')) return false;
                     for (size_t j = 0; j < obj_count; j++) {
                         if (j > 0) {
-                            if (fprintf(ctx->output, ", ") < 0) return false;
+                            if (!TTL_OUTPUT_LITERAL(&ctx->out, ", ")) return false;
                         }
                         if (!node_to_jsonld_value(ctx, objects[j])) return false;
                     }
-                    if (fprintf(ctx->output, "]") < 0) return false;
+                    if (!ttl_output_append_char(&ctx->out, ']')) return false;
                 }
             }
             
             if (i + 2 < count) {
-                if (fprintf(ctx->output, ",") < 0) return false;
+                if (!ttl_output_append_char(&ctx->out, ',')) return false;
             }
             if (!write_newline(ctx)) return false;
         }
@@ -375,7 +348,7 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
     
     ctx->indent_level--;
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "}") < 0) return false;
+    if (!ttl_output_append_char(&ctx->out, '}')) return false;
     
     ctx->stats.triples_serialized++;
     
@@ -410,22 +383,6 @@ bool ttl_serialize_jsonld_ast(ttl_serializer_t* serializer, ttl_ast_node_t* root
     
     jsonld_context_t* ctx = (jsonld_context_t*)serializer;
     
-    // Start JSON-LD document
-    if (fprintf(ctx->output, "{") < 0) return false;
-    if (!write_newline(ctx)) return false;
-    
-    ctx->indent_level++;
-    
-    // Write context
-    if (!write_context(ctx)) return false;
-    
-    // Start graph array
-    if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "\"@graph\": [") < 0) return false;
-    if (!write_newline(ctx)) return false;
-    
-    ctx->indent_level++;
-    
     // Create visitor for triple extraction
     ttl_ast_visitor_t* visitor = ttl_visitor_create();
     if (!visitor) return false;
@@ -434,18 +391,34 @@ bool ttl_serialize_jsonld_ast(ttl_serializer_t* serializer, ttl_ast_node_t* root
     visitor->visit_triple = visit_triple;
     visitor->order = TTL_VISITOR_PRE_ORDER;
     
-    // Traverse AST and serialize triples
-    bool success = ttl_ast_accept(root, visitor);
+    if (!ttl_output_buffer_init(&ctx->out, ctx->output, 0)) {
+        ttl_visitor_destroy(visitor);
+        return false;
+    }
     
-    ctx->indent_level--;
-    if (!write_newline(ctx)) return false;
-    if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "]") < 0) return false;
-    if (!write_newline(ctx)) return false;
+    // Start JSON-LD document, context and graph array
+    bool success = ttl_output_append_char(&ctx->out, '{') && write_newline(ctx);
+    ctx->indent_level++;
+    success = success && write_context(ctx) && write_indent(ctx) &&
+              TTL_OUTPUT_LITERAL(&ctx->out, "\"@graph\": [") && write_newline(ctx);
+    ctx->indent_level++;
+    
+    // Traverse AST and serialize triples; the document is closed either way
+    bool traversed = success && ttl_ast_accept(root, visitor);
     
     ctx->indent_level--;
-    if (fprintf(ctx->output, "}") < 0) return false;
-    if (!write_newline(ctx)) return false;
+    success = success && write_newline(ctx) && write_indent(ctx) &&
+              ttl_output_append_char(&ctx->out, ']') && write_newline(ctx);
+    ctx->indent_level--;
+    success = success && ttl_output_append_char(&ctx->out, '}') && write_newline(ctx);
+    success = success && traversed;
+    
+    // Flush the buffer
+    if (!ttl_output_buffer_destroy(&ctx->out)) {
+        ctx->has_error = true;
+        strcpy(ctx->error_message, "Failed to write output");
+    }
+    ctx->stats.bytes_written = ctx->out.bytes_written;
     
     if (success && !ctx->has_error) {
         ctx->stats.serialization_time_ms = 
@@ -12,6 +12,10 @@
 #include <ctype.h>
 #include <assert.h>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 /* Internal state machine states */
 typedef enum {
     STATE_INITIAL,
@@ -81,6 +85,9 @@ struct Lexer {
     bool input_ended;
     char* partial_token;
     size_t partial_length;
+    char* stream_buffer;         /* Owned copy of unconsumed fed input */
+    size_t stream_capacity;
+    size_t stream_base;          /* Absolute stream offset of input[0] */
 };
 
 /* Forward declarations */
@@ -226,6 +233,7 @@ void lexer_destroy(Lexer* lexer) {
     /* Free buffers */
     if (lexer->buffer) free(lexer->buffer);
     if (lexer->partial_token) free(lexer->partial_token);
+    if (lexer->stream_buffer) free(lexer->stream_buffer);
     
     /* Free lookahead tokens */
     if (lexer->lookahead) {
@@ -264,6 +272,7 @@ void lexer_init(Lexer* lexer, const char* input, size_t length) {
     lexer->state = STATE_INITIAL;
     lexer->streaming = false;
     lexer->input_ended = true;
+    lexer->stream_base = 0;
     
     /* Clear buffers */
     buffer_clear(lexer);
@@ -335,8 +344,8 @@ static Token* make_token(Lexer* lexer, TokenType type) {
     
     token->line = lexer->token_start_line;
     token->column = lexer->token_start_column;
-    token->start_pos = lexer->token_start_pos;
-    token->end_pos = lexer->position;
+    token->start_pos = lexer->stream_base + lexer->token_start_pos;
+    token->end_pos = lexer->stream_base + lexer->position;
     
     buffer_clear(lexer);
     return token;
@@ -350,8 +359,8 @@ static Token* make_error_token(Lexer* lexer, const char* message) {
     
     token->line = lexer->token_start_line;
     token->column = lexer->token_start_column;
-    token->start_pos = lexer->token_start_pos;
-    token->end_pos = lexer->position;
+    token->start_pos = lexer->stream_base + lexer->token_start_pos;
+    token->end_pos = lexer->stream_base + lexer->position;
     
     buffer_clear(lexer);
     return token;
@@ -367,7 +376,7 @@ static void add_error(Lexer* lexer, LexerErrorType type, const char* message) {
     error->type = type;
     error->line = lexer->line;
     error->column = lexer->column;
-    error->position = lexer->position;
+    error->position = lexer->stream_base + lexer->position;
     
     if (message) {
         error->message = strdup(message);
@@ -685,12 +694,14 @@ static Token* scan_directive(Lexer* lexer) {
     } else if (strcmp(lexer->buffer, "@base") == 0) {
         return make_token(lexer, TOKEN_BASE);
     } else {
-        /* CORE FIX: If not a known directive, just return @ as TOKEN_AT */
-        /* Reset position to just after @ */
-        lexer->position = lexer->token_start_pos + 1;
-        lexer->buffer_pos = 1;
-        lexer->buffer[0] = '@';
-        lexer->buffer[1] = '\0';
+        /* Language tag: [a-zA-Z]+ ('-' [a-zA-Z0-9]+)*; TOKEN_AT carries the
+         * tag without '@' (empty for a bare '@'), as lexer_next_slice does */
+        while (lexer->buffer_pos > 1 &&
+               (peek_char(lexer, 0) == '-' || is_alpha(peek_char(lexer, 0)) || is_digit(peek_char(lexer, 0)))) {
+            buffer_append(lexer, next_char(lexer));
+        }
+        memmove(lexer->buffer, lexer->buffer + 1, lexer->buffer_pos - 1);
+        lexer->buffer_pos--;
         return make_token(lexer, TOKEN_AT);
     }
 }
@@ -997,7 +1008,7 @@ LexerState* lexer_save_state(const Lexer* lexer) {
     LexerState* state = (LexerState*)calloc(1, sizeof(LexerState));
     if (!state) return NULL;
     
-    state->position = lexer->position;
+    state->position = lexer->stream_base + lexer->position;
     state->line = lexer->line;
     state->column = lexer->column;
     state->state = lexer->state;
@@ -1018,7 +1029,10 @@ void lexer_restore_state(Lexer* lexer, const LexerState* state) {
     assert(lexer != NULL);
     assert(state != NULL);
     
-    lexer->position = state->position;
+    /* Bytes before stream_base were released by lexer_feed */
+    if (state->position < lexer->stream_base) return;
+    
+    lexer->position = state->position - lexer->stream_base;
     lexer->line = state->line;
     lexer->column = state->column;
     lexer->state = state->state;
@@ -1054,7 +1068,7 @@ void lexer_get_position(const Lexer* lexer, size_t* line, size_t* column, size_t
     
     if (line) *line = lexer->line;
     if (column) *column = lexer->column;
-    if (position) *position = lexer->position;
+    if (position) *position = lexer->stream_base + lexer->position;
 }
 
 /* Default options */
@@ -1196,15 +1210,552 @@ bool lexer_is_pn_chars(uint32_t ch) {
 
 /* Streaming support */
 bool lexer_feed(Lexer* lexer, const char* input, size_t length) {
-    (void)length; // TODO: Use when implementing streaming
     assert(lexer != NULL);
     assert(input != NULL);
     
-    /* TODO: Implement streaming support */
-    return false;
+    /* Keep only the unconsumed tail; a split token restarts from there */
+    size_t consumed = lexer->input ? lexer->position : 0;
+    size_t remaining = lexer->input ? lexer->input_length - consumed : 0;
+    size_t needed = remaining + length + 1;
+    
+    if (lexer->input == lexer->stream_buffer && remaining > 0) {
+        memmove(lexer->stream_buffer, lexer->stream_buffer + consumed, remaining);
+    }
+    if (needed > lexer->stream_capacity) {
+        size_t capacity = lexer->stream_capacity ? lexer->stream_capacity : lexer->options.buffer_size;
+        if (capacity < 64) capacity = 64;
+        while (capacity < needed) capacity *= 2;
+        char* grown = (char*)realloc(lexer->stream_buffer, capacity);
+        if (!grown) return false;
+        lexer->stream_buffer = grown;
+        lexer->stream_capacity = capacity;
+    }
+    if (lexer->input != lexer->stream_buffer && remaining > 0) {
+        /* Input came from lexer_init: adopt its tail */
+        memcpy(lexer->stream_buffer, lexer->input + consumed, remaining);
+    }
+    
+    memcpy(lexer->stream_buffer + remaining, input, length);
+    lexer->stream_buffer[remaining + length] = '\0';
+    lexer->stream_base += consumed;
+    lexer->input = lexer->stream_buffer;
+    lexer->input_length = remaining + length;
+    lexer->position = 0;
+    lexer->streaming = true;
+    lexer->input_ended = false;
+    return true;
 }
 
 void lexer_end_input(Lexer* lexer) {
     assert(lexer != NULL);
     lexer->input_ended = true;
-}
\ No newline at end of file
+}
+/* Slice mode: SIMD byte classification over 64-byte blocks */
+#define SLICE_BLOCK 64
+#define SLICE_NEED_MORE ((size_t)-1)
+
+/* Bitmask of the bytes in a 64-byte block equal to any of a, b, c, d */
+static inline uint64_t block_match4(const char* p, char a, char b, char c, char d) {
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a), vb = _mm256_set1_epi8(b);
+    const __m256i vc = _mm256_set1_epi8(c), vd = _mm256_set1_epi8(d);
+    uint64_t mask = 0;
+    for (int i = 0; i < 2; i++) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + 32 * i));
+        __m256i hit = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, vc), _mm256_cmpeq_epi8(v, vd)));
+        mask |= (uint64_t)(uint32_t)_mm256_movemask_epi8(hit) << (32 * i);
+    }
+    return mask;
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a), vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c), vd = _mm_set1_epi8(d);
+    uint64_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + 16 * i));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, vd)));
+        mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(hit) << (16 * i);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < SLICE_BLOCK; i++) {
+        char ch = p[i];
+        if (ch == a || ch == b || ch == c || ch == d) mask |= 1ULL << i;
+    }
+    return mask;
+#endif
+}
+
+/* First index in [from, end) holding any of a, b, c, d; end if none */
+static size_t find_any4(const char* s, size_t from, size_t end, char a, char b, char c, char d) {
+    size_t i = from;
+    for (; i + SLICE_BLOCK <= end; i += SLICE_BLOCK) {
+        uint64_t mask = block_match4(s + i, a, b, c, d);
+        if (mask) return i + (size_t)__builtin_ctzll(mask);
+    }
+    for (; i < end; i++) {
+        char ch = s[i];
+        if (ch == a || ch == b || ch == c || ch == d) return i;
+    }
+    return end;
+}
+
+/* First non-whitespace index in [from, end); end if none */
+static size_t skip_whitespace_simd(const char* s, size_t from, size_t end) {
+    size_t i = from;
+    for (; i + SLICE_BLOCK <= end; i += SLICE_BLOCK) {
+        uint64_t other = ~block_match4(s + i, ' ', '\t', '\r', '\n');
+        if (other) return i + (size_t)__builtin_ctzll(other);
+    }
+    while (i < end && is_whitespace(s[i])) i++;
+    return i;
+}
+
+/* Move to position `to`, updating line/column from newline and CR counts */
+static void advance_to(Lexer* lexer, size_t to) {
+    const char* s = lexer->input;
+    size_t from = lexer->position;
+    size_t line_start = SLICE_NEED_MORE;
+    size_t carriage_returns = 0;        /* Since line_start (or from) */
+    size_t i = from;
+    
+    for (; i + SLICE_BLOCK <= to; i += SLICE_BLOCK) {
+        uint64_t nl = block_match4(s + i, '\n', '\n', '\n', '\n');
+        uint64_t cr = block_match4(s + i, '\r', '\r', '\r', '\r');
+        if (nl) {
+            int last = 63 - __builtin_clzll(nl);
+            lexer->line += (size_t)__builtin_popcountll(nl);
+            line_start = i + (size_t)last + 1;
+            carriage_returns = last == 63 ? 0 : (size_t)__builtin_popcountll(cr >> (last + 1));
+        } else {
+            carriage_returns += (size_t)__builtin_popcountll(cr);
+        }
+    }
+    for (; i < to; i++) {
+        if (s[i] == '\n') {
+            lexer->line++;
+            line_start = i + 1;
+            carriage_returns = 0;
+        } else if (s[i] == '\r') {
+            carriage_returns++;
+        }
+    }
+    
+    if (line_start != SLICE_NEED_MORE) {
+        lexer->column = 1 + (to - line_start) - carriage_returns;
+    } else {
+        lexer->column += (to - from) - carriage_returns;
+    }
+    lexer->position = to;
+}
+
+/* Name bytes: PN_CHARS, digits and any UTF-8 byte */
+static inline bool is_slice_name_char(char ch) {
+    return is_pn_chars_cont(ch) || (unsigned char)ch >= 0x80;
+}
+
+/*
+ * End of a name run from i. '.' is kept only when followed by another
+ * name byte; local names also take ':', %XX and \-escapes. Returns
+ * SLICE_NEED_MORE when the run touches the end of buffered input.
+ */
+static size_t scan_slice_name(const Lexer* lexer, size_t i, bool local, uint32_t* flags) {
+    const char* s = lexer->input;
+    size_t end = lexer->input_length;
+    bool more = !lexer->input_ended;
+    
+    while (i < end) {
+        char ch = s[i];
+        if (is_slice_name_char(ch) || (local && ch == ':')) {
+            i++;
+        } else if (ch == '.') {
+            if (i + 1 >= end) return more ? SLICE_NEED_MORE : i;
+            if (!is_slice_name_char(s[i + 1]) && !(local && s[i + 1] == ':')) return i;
+            i++;
+        } else if (local && ch == '%') {
+            if (i + 2 >= end) return more ? SLICE_NEED_MORE : i;
+            if (!is_hex_digit(s[i + 1]) || !is_hex_digit(s[i + 2])) return i;
+            i += 3;
+        } else if (local && ch == '\\') {
+            if (i + 1 >= end) return more ? SLICE_NEED_MORE : i;
+            if (!strchr("_~.-!$&'()*+,;=/?#@%", s[i + 1]) || s[i + 1] == '\0') return i;
+            *flags |= TOKEN_SLICE_ESCAPED;
+            i += 2;
+        } else {
+            return i;
+        }
+    }
+    return more ? SLICE_NEED_MORE : i;
+}
+
+/*
+ * Skip the escape at s[i] == '\\' inside an IRI or string. Returns the
+ * index after it, or SLICE_NEED_MORE if it is cut by the buffer end.
+ */
+static size_t skip_slice_escape(const Lexer* lexer, size_t i, bool in_string,
+                                uint32_t* flags, const char** error) {
+    const char* s = lexer->input;
+    size_t end = lexer->input_length;
+    
+    *flags |= TOKEN_SLICE_ESCAPED;
+    if (i + 1 >= end) return SLICE_NEED_MORE;
+    
+    char kind = s[i + 1];
+    if (kind == 'u' || kind == 'U') {
+        size_t digits = kind == 'u' ? 4 : 8;
+        if (i + 2 + digits > end) return SLICE_NEED_MORE;
+        size_t k = i + 2;
+        while (k < i + 2 + digits && is_hex_digit(s[k])) k++;
+        if (k < i + 2 + digits && !*error) *error = "Invalid Unicode escape";
+        return k;
+    }
+    if (in_string && !strchr("tbnrf\"'\\", kind) && !*error) {
+        *error = "Invalid escape sequence";
+    }
+    return i + 2;
+}
+
+bool lexer_next_slice(Lexer* lexer, TokenSlice* slice) {
+    assert(lexer != NULL);
+    assert(slice != NULL);
+    
+    const char* s = lexer->input;
+    size_t end = lexer->input_length;
+    bool more = !lexer->input_ended;
+    
+    advance_to(lexer, skip_whitespace_simd(s, lexer->position, end));
+    size_t pos = lexer->position;
+    
+    memset(slice, 0, sizeof(*slice));
+    slice->line = lexer->line;
+    slice->column = lexer->column;
+    slice->offset = lexer->stream_base + pos;
+    
+    if (pos >= end) {
+        if (more) return false;
+        slice->type = TOKEN_EOF;
+        return true;
+    }
+    
+    /* Value is [start, stop); scanning resumes at next */
+    TokenType type = TOKEN_INVALID;
+    size_t start = pos, stop = pos + 1, next = pos + 1;
+    uint32_t flags = 0;
+    LexerErrorType error_type = LEXER_ERROR_UNEXPECTED_CHAR;
+    const char* error = NULL;
+    char ch = s[pos];
+    
+    switch (ch) {
+        case '<': {
+            size_t j = pos + 1;
+            for (;;) {
+                j = find_any4(s, j, end, '>', '\\', '\n', '\r');
+                if (j < end && s[j] == '\\') {
+                    j = skip_slice_escape(lexer, j, false, &flags, &error);
+                    if (j != SLICE_NEED_MORE) continue;
+                    j = end;
+                }
+                break;
+            }
+            if (j >= end) {
+                if (more) return false;
+                error_type = LEXER_ERROR_INCOMPLETE_TOKEN;
+                error = "Unexpected end of input in IRI";
+                start = pos + 1;
+                stop = next = end;
+            } else if (s[j] == '>') {
+                type = TOKEN_IRI_REF;
+                error_type = LEXER_ERROR_INVALID_ESCAPE;
+                start = pos + 1;
+                stop = j;
+                next = j + 1;
+            } else {
+                error_type = LEXER_ERROR_UNTERMINATED_STRING;
+                error = "Unterminated IRI";
+                start = pos + 1;
+                stop = next = j;
+            }
+            break;
+        }
+        
+        case '"':
+        case '\'': {
+            bool is_long = false;
+            if (pos + 1 >= end) {
+                if (more) return false;
+            } else if (s[pos + 1] == ch) {
+                if (pos + 2 >= end) {
+                    if (more) return false;
+                } else {
+                    is_long = s[pos + 2] == ch;
+                }
+            }
+            
+            size_t open = is_long ? 3 : 1;
+            size_t j = pos + open;
+            for (;;) {
+                if (is_long) {
+                    j = find_any4(s, j, end, ch, '\\', ch, '\\');
+                } else {
+                    j = find_any4(s, j, end, ch, '\\', '\n', '\r');
+                }
+                if (j >= end) break;
+                if (s[j] == '\\') {
+                    j = skip_slice_escape(lexer, j, true, &flags, &error);
+                    if (j == SLICE_NEED_MORE) {
+                        j = end;
+                        break;
+                    }
+                    continue;
+                }
+                if (is_long && s[j] == ch) {
+                    if (j + 2 >= end) {
+                        if (more) return false;
+                        j++;
+                        continue;
+                    }
+                    if (s[j + 1] != ch || s[j + 2] != ch) {
+                        j++;
+                        continue;
+                    }
+                }
+                break;
+            }
+            
+            start = pos + open;
+            if (j >= end) {
+                if (more) return false;
+                error_type = LEXER_ERROR_INCOMPLETE_TOKEN;
+                error = "Unexpected end of input in string";
+                stop = next = end;
+            } else if (s[j] == ch) {
+                if (is_long) {
+                    type = ch == '"' ? TOKEN_STRING_LITERAL_LONG_QUOTE : TOKEN_STRING_LITERAL_LONG_SINGLE_QUOTE;
+                } else {
+                    type = ch == '"' ? TOKEN_STRING_LITERAL_QUOTE : TOKEN_STRING_LITERAL_SINGLE_QUOTE;
+                }
+                error_type = LEXER_ERROR_INVALID_ESCAPE;
+                stop = j;
+                next = j + open;
+            } else {
+                error_type = LEXER_ERROR_UNTERMINATED_STRING;
+                error = "Unterminated string literal";
+                stop = next = j;
+            }
+            break;
+        }
+        
+        case '#': {
+            size_t j = find_any4(s, pos + 1, end, '\n', '\r', '\n', '\r');
+            if (j >= end && more) return false;
+            type = TOKEN_COMMENT;
+            start = pos + 1;
+            stop = next = j;
+            break;
+        }
+        
+        case '@': {
+            size_t k = pos + 1;
+            while (k < end && is_alpha(s[k])) k++;
+            if (k >= end && more) return false;
+            size_t word = k - (pos + 1);
+            if (word == 6 && memcmp(s + pos + 1, "prefix", 6) == 0) {
+                type = TOKEN_PREFIX;
+                stop = next = k;
+            } else if (word == 4 && memcmp(s + pos + 1, "base", 4) == 0) {
+                type = TOKEN_BASE;
+                stop = next = k;
+            } else {
+                /* Language tag: [a-zA-Z]+ ('-' [a-zA-Z0-9]+)* */
+                while (word > 0 && k < end && (s[k] == '-' || is_alpha(s[k]) || is_digit(s[k]))) k++;
+                if (k >= end && more) return false;
+                type = TOKEN_AT;
+                start = pos + 1;
+                stop = next = k;
+            }
+            break;
+        }
+        
+        case '_': {
+            if (pos + 2 >= end && more) return false;
+            if (pos + 2 < end && s[pos + 1] == ':' && is_slice_name_char(s[pos + 2]) && s[pos + 2] != '-') {
+                size_t k = scan_slice_name(lexer, pos + 2, false, &flags);
+                if (k == SLICE_NEED_MORE) return false;
+                type = TOKEN_BLANK_NODE_LABEL;
+                start = pos + 2;
+                stop = next = k;
+            } else {
+                error = "Invalid blank node label";
+            }
+            break;
+        }
+        
+        case ':': {
+            size_t k = scan_slice_name(lexer, pos + 1, true, &flags);
+            if (k == SLICE_NEED_MORE) return false;
+            type = TOKEN_PREFIXED_NAME;
+            stop = next = k;
+            break;
+        }
+        
+        case '[': {
+            size_t k = skip_whitespace_simd(s, pos + 1, end);
+            if (k >= end && more) return false;
+            if (k < end && s[k] == ']') {
+                type = TOKEN_ANON;
+                start = stop = pos + 1;
+                next = k + 1;
+            } else {
+                type = TOKEN_OPEN_BRACKET;
+            }
+            break;
+        }
+        
+        case '^':
+            if (pos + 1 >= end && more) return false;
+            if (pos + 1 < end && s[pos + 1] == '^') {
+                type = TOKEN_DOUBLE_CARET;
+                stop = next = pos + 2;
+            }
+            break;
+        
+        case ']': type = TOKEN_CLOSE_BRACKET; break;
+        case '(': type = TOKEN_OPEN_PAREN; break;
+        case ')': type = TOKEN_CLOSE_PAREN; break;
+        case '{': type = TOKEN_OPEN_BRACE; break;
+        case '}': type = TOKEN_CLOSE_BRACE; break;
+        case ';': type = TOKEN_SEMICOLON; break;
+        case ',': type = TOKEN_COMMA; break;
+        
+        default:
+            break;
+    }
+    
+    /* Numbers: [+-]? digits ('.' digits)? exponent?, or '.' digits ... */
+    bool number = false;
+    if (type == TOKEN_INVALID && !error) {
+        size_t k = pos;
+        if (ch == '+' || ch == '-') k++;
+        if (k < end && s[k] == '.') k++;
+        if (k >= end) {
+            if (more && k > pos) return false;
+        } else {
+            number = is_digit(s[k]);
+        }
+    }
+    if (number) {
+        size_t k = pos;
+        if (s[k] == '+' || s[k] == '-') k++;
+        while (k < end && is_digit(s[k])) k++;
+        type = TOKEN_INTEGER;
+        if ((k >= end || (s[k] == '.' && k + 1 >= end)) && more) return false;
+        if (k + 1 < end && s[k] == '.' && is_digit(s[k + 1])) {
+            k++;
+            while (k < end && is_digit(s[k])) k++;
+            type = TOKEN_DECIMAL;
+        }
+        if (k >= end && more) return false;
+        if (k < end && (s[k] == 'e' || s[k] == 'E')) {
+            size_t e = k + 1;
+            if (e < end && (s[e] == '+' || s[e] == '-')) e++;
+            if (e >= end && more) return false;
+            if (e < end && is_digit(s[e])) {
+                while (e < end && is_digit(s[e])) e++;
+                if (e >= end && more) return false;
+                type = TOKEN_DOUBLE;
+            } else {
+                type = TOKEN_INVALID;
+                error_type = LEXER_ERROR_INVALID_NUMBER;
+                error = "Invalid exponent";
+            }
+            k = e;
+        }
+        stop = next = k;
+    } else if (ch == '.' && type == TOKEN_INVALID && !error) {
+        type = TOKEN_DOT;
+    } else if (type == TOKEN_INVALID && !error &&
+               (is_alpha(ch) || (unsigned char)ch >= 0x80)) {
+        /* Prefix, keyword or boolean */
+        size_t k = scan_slice_name(lexer, pos, false, &flags);
+        if (k == SLICE_NEED_MORE) return false;
+        if (k < end && s[k] == ':') {
+            k = scan_slice_name(lexer, k + 1, true, &flags);
+            if (k == SLICE_NEED_MORE) return false;
+            type = TOKEN_PREFIXED_NAME;
+        } else if (k - pos == 1 && ch == 'a') {
+            type = TOKEN_A;
+        } else if ((k - pos == 4 && memcmp(s + pos, "true", 4) == 0) ||
+                   (k - pos == 5 && memcmp(s + pos, "false", 5) == 0)) {
+            type = TOKEN_BOOLEAN;
+        } else {
+            error = "Unexpected identifier";
+        }
+        stop = next = k;
+    } else if (type == TOKEN_INVALID && !error) {
+        error = "Unexpected character";
+    }
+    
+    advance_to(lexer, next);
+    slice->type = type;
+    slice->offset = lexer->stream_base + start;
+    slice->length = stop - start;
+    if (error) {
+        flags |= TOKEN_SLICE_ERROR;
+        add_error(lexer, error_type, error);
+    }
+    slice->flags = flags;
+    return true;
+}
+
+const char* lexer_slice_text(const Lexer* lexer, const TokenSlice* slice) {
+    assert(lexer != NULL);
+    assert(slice != NULL);
+    
+    if (slice->offset < lexer->stream_base) return NULL;
+    size_t local = slice->offset - lexer->stream_base;
+    if (local + slice->length > lexer->input_length) return NULL;
+    return lexer->input + local;
+}
+
+bool lexer_slice_decode(const Lexer* lexer, const TokenSlice* slice,
+                        char* output, size_t* output_length) {
+    if (!output || !output_length) return false;
+    
+    const char* text = lexer_slice_text(lexer, slice);
+    if (!text) return false;
+    
+    if (!(slice->flags & TOKEN_SLICE_ESCAPED)) {
+        memcpy(output, text, slice->length);
+        *output_length = slice->length;
+    } else if (!lexer_unescape_string(text, slice->length, output, output_length)) {
+        return false;
+    }
+    output[*output_length] = '\0';
+    return true;
+}
+
+Token* lexer_slice_to_token(const Lexer* lexer, const TokenSlice* slice) {
+    char* value = (char*)malloc(slice->length + 1);
+    if (!value) return NULL;
+    
+    size_t length = 0;
+    if (!lexer_slice_decode(lexer, slice, value, &length)) {
+        free(value);
+        return NULL;
+    }
+    
+    Token* token = token_create(slice->type, value, length);
+    free(value);
+    if (!token) return NULL;
+    
+    token->line = slice->line;
+    token->column = slice->column;
+    token->start_pos = slice->offset;
+    token->end_pos = slice->offset + slice->length;
+    token->has_error = (slice->flags & TOKEN_SLICE_ERROR) != 0;
+    return token;
+}
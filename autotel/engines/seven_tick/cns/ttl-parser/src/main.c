@@ -12,6 +12,7 @@
 #include "error.h"
 #include "diagnostic.h"
 #include "serializer.h"
+#include "parallel_parser.h"
 // Remove compatibility layer for now
 
 // External serializer function declarations
@@ -47,6 +48,9 @@ typedef struct {
     ValidationMode validation_mode;
     bool validate_only;
     bool streaming_mode;
+    bool parallel;          // Parallel chunked parsing
+    int threads;            // Parallel threads (0 = all CPUs)
+    bool unordered;         // Parallel output in completion order
     bool show_stats;
     bool quiet;
     bool recursive;
@@ -75,6 +79,8 @@ static void print_usage(const char* program_name) {
     fprintf(stderr, "  -o, --output FILE      Write output to FILE\n");
     fprintf(stderr, "  -v, --validate         Validate only, don't output\n");
     fprintf(stderr, "  -s, --streaming        Use streaming parser for large files\n");
+    fprintf(stderr, "  -j, --threads N        Parse in parallel on N threads (0 = all CPUs)\n");
+    fprintf(stderr, "  --unordered            With -j, emit triples as chunks finish\n");
     fprintf(stderr, "  -q, --quiet            Suppress non-error output\n");
     fprintf(stderr, "  -f, --diag-format FMT  Diagnostic format: human|json|gcc|msvc\n");
     fprintf(stderr, "  -h, --help             Show this help message\n");
@@ -101,6 +107,8 @@ static bool parse_options(int argc, char* argv[], Options* opts) {
         {"stats",        no_argument,       0, 1003}, // Stats mode
         {"progress",     no_argument,       0, 1004}, // Progress indicator
         {"diag-format",  required_argument, 0, 'f'},   // Diagnostic format
+        {"threads",      required_argument, 0, 'j'},   // Parallel parsing
+        {"unordered",    no_argument,       0, 1005}, // Parallel output order
         {0, 0, 0, 0}
     };
     
@@ -111,7 +119,7 @@ static bool parse_options(int argc, char* argv[], Options* opts) {
     opts->diag_format = DIAG_FORMAT_HUMAN;
     
     int c;
-    while ((c = getopt_long(argc, argv, "o:vsqrhf:", long_options, NULL)) != -1) {
+    while ((c = getopt_long(argc, argv, "o:vsqrhf:j:", long_options, NULL)) != -1) {
         switch (c) {
             case 'o':
                 opts->output_file = optarg;
@@ -174,6 +182,14 @@ static bool parse_options(int argc, char* argv[], Options* opts) {
             case 1004: // --progress
                 opts->show_progress = true;
                 break;
+            case 'j': // --threads implies streaming
+                opts->threads = atoi(optarg);
+                opts->parallel = true;
+                opts->streaming_mode = true;
+                break;
+            case 1005: // --unordered
+                opts->unordered = true;
+                break;
             case 'h':
                 print_usage(argv[0]);
                 exit(0);
@@ -364,11 +380,176 @@ static void print_ast_node(ttl_ast_node_t* node, FILE* output, int depth) {
     }
 }
 
+// Streaming mode: triples go straight to the output, no AST is built
+typedef struct {
+    FILE* output;
+    bool write_ntriples;
+    const char* filename;
+    size_t errors;
+} StreamContext;
+
+static void write_nt_term(FILE* output, const char* value, TripleTermKind kind) {
+    if (kind == TRIPLE_TERM_IRI) {
+        fprintf(output, "<%s>", value);
+    } else if (kind == TRIPLE_TERM_BLANK_NODE) {
+        fputs(value, output);
+    } else {
+        fputc('"', output);
+        for (const char* p = value; *p; p++) {
+            switch (*p) {
+                case '"':  fputs("\\\"", output); break;
+                case '\\': fputs("\\\\", output); break;
+                case '\n': fputs("\\n", output); break;
+                case '\r': fputs("\\r", output); break;
+                default:   fputc(*p, output); break;
+            }
+        }
+        fputc('"', output);
+    }
+}
+
+static void stream_triples(void* user_data, const StreamingTriple* triples, size_t count) {
+    StreamContext* ctx = (StreamContext*)user_data;
+    if (!ctx->write_ntriples) return;
+    
+    for (size_t i = 0; i < count; i++) {
+        const StreamingTriple* t = &triples[i];
+        write_nt_term(ctx->output, t->subject, t->subject_kind);
+        fputc(' ', ctx->output);
+        write_nt_term(ctx->output, t->predicate, TRIPLE_TERM_IRI);
+        fputc(' ', ctx->output);
+        write_nt_term(ctx->output, t->object, t->object_kind);
+        if (t->lang) {
+            fprintf(ctx->output, "@%s", t->lang);
+        } else if (t->datatype) {
+            fprintf(ctx->output, "^^<%s>", t->datatype);
+        }
+        fputs(" .\n", ctx->output);
+    }
+}
+
+static void stream_error(void* user_data, const ParseError* error) {
+    StreamContext* ctx = (StreamContext*)user_data;
+    if (ctx->errors++ == 0) {
+        fprintf(stderr, "Parse errors found in %s:\n", ctx->filename);
+    }
+    fprintf(stderr, "  Line %u: %s\n", (unsigned int)error->line, error->message);
+}
+
+static int process_file_streaming(const char* filename, const Options* opts, FILE* output) {
+    FILE* input_file = fopen(filename, "rb");
+    if (!input_file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return 1;
+    }
+    
+    StreamContext ctx = {
+        .output = output,
+        .write_ntriples = !opts->validate_only && opts->output_format == OUTPUT_FORMAT_NTRIPLES,
+        .filename = filename
+    };
+    StreamingCallbacks callbacks = {
+        .user_data = &ctx,
+        .on_triples = stream_triples,
+        .on_error = stream_error
+    };
+    
+    StreamingParser* parser = ttl_streaming_parser_create(&callbacks, NULL);
+    if (!parser) {
+        fprintf(stderr, "Error: Cannot create parser\n");
+        fclose(input_file);
+        return 1;
+    }
+    
+    // Fixed-size reads keep memory flat for any file size
+    char chunk[64 * 1024];
+    size_t read_size;
+    bool ok = true;
+    while (ok && (read_size = fread(chunk, 1, sizeof(chunk), input_file)) > 0) {
+        ok = ttl_streaming_parser_feed(parser, chunk, read_size);
+    }
+    ttl_streaming_parser_end(parser);
+    fclose(input_file);
+    
+    ParserStats stats;
+    ttl_streaming_parser_get_stats(parser, &stats);
+    ttl_streaming_parser_destroy(parser);
+    
+    if (!ok) {
+        fprintf(stderr, "Error: Out of memory while parsing %s\n", filename);
+        return 1;
+    }
+    if (!opts->quiet && ctx.errors == 0 && !opts->validate_only) {
+        fprintf(stderr, "✓ %s streamed successfully (%zu triples, %.2fms)\n",
+                filename, stats.triples_parsed, stats.parse_time_ms);
+    }
+    if (opts->show_stats || opts->validation_mode == VALIDATION_STATS) {
+        fprintf(stderr, "\n=== %s Statistics ===\n", filename);
+        fprintf(stderr, "  Parse time: %.3f ms\n", stats.parse_time_ms);
+        fprintf(stderr, "  Tokens consumed: %zu\n", stats.tokens_consumed);
+        fprintf(stderr, "  Statements parsed: %zu\n", stats.statements_parsed);
+        fprintf(stderr, "  Triples parsed: %zu\n", stats.triples_parsed);
+        fprintf(stderr, "  Errors: %zu\n", ctx.errors);
+    }
+    return ctx.errors ? 1 : 0;
+}
+
+static bool is_ntriples_file(const char* filename) {
+    const char* ext = strrchr(filename, '.');
+    return ext && strcmp(ext, ".nt") == 0;
+}
+
+static int process_file_parallel(const char* filename, const Options* opts, FILE* output) {
+    StreamContext ctx = {
+        .output = output,
+        .write_ntriples = !opts->validate_only && opts->output_format == OUTPUT_FORMAT_NTRIPLES,
+        .filename = filename
+    };
+    StreamingCallbacks callbacks = {
+        .user_data = &ctx,
+        .on_triples = stream_triples,
+        .on_error = stream_error
+    };
+    
+    ParallelParseOptions parallel = ttl_parallel_default_options();
+    parallel.num_threads = (size_t)opts->threads;
+    parallel.ordered = !opts->unordered;
+    parallel.ntriples = is_ntriples_file(filename);
+    
+    ParallelParseStats stats;
+    if (!ttl_parallel_parse_file(filename, &callbacks, &parallel, &stats)) {
+        fprintf(stderr, "Error: Cannot parse file %s\n", filename);
+        return 1;
+    }
+    
+    if (!opts->quiet && ctx.errors == 0 && !opts->validate_only) {
+        fprintf(stderr, "✓ %s parsed successfully (%zu triples, %zu chunks on %zu threads, %.2fms)\n",
+                filename, stats.triples, stats.chunks, stats.threads, stats.parse_time_ms);
+    }
+    if (opts->show_stats || opts->validation_mode == VALIDATION_STATS) {
+        fprintf(stderr, "\n=== %s Statistics ===\n", filename);
+        fprintf(stderr, "  Parse time: %.3f ms\n", stats.parse_time_ms);
+        fprintf(stderr, "  Threads: %zu\n", stats.threads);
+        fprintf(stderr, "  Chunks: %zu%s\n", stats.chunks,
+                stats.sequential ? " (sequential: directives after the prologue)" : "");
+        fprintf(stderr, "  Triples parsed: %zu\n", stats.triples);
+        fprintf(stderr, "  Errors: %zu\n", ctx.errors);
+    }
+    return ctx.errors ? 1 : 0;
+}
+
 static int process_file(const char* filename, const Options* opts, FILE* output) {
     if (!opts->quiet) {
         fprintf(stderr, "Processing: %s\n", filename);
     }
     
+    if (opts->parallel) {
+        return process_file_parallel(filename, opts, output);
+    }
+    if (opts->streaming_mode) {
+        return process_file_streaming(filename, opts, output);
+    }
+    
     // Check file size for progress indicator
     struct stat st;
     size_t file_size = 0;
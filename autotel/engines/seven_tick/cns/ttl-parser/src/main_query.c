@@ -38,6 +38,7 @@ static void print_usage(const char* program_name) {
     fprintf(stderr, "  %s --query \"?s foaf:name ?name\" input.ttl\n", program_name);
     fprintf(stderr, "  %s --query \"<http://example.org/person1> ?p ?o\" input.ttl\n", program_name);
     fprintf(stderr, "  %s --query \"?s a ?type\" --json input.ttl\n", program_name);
+    fprintf(stderr, "  %s --query \"?s a foaf:Person . ?s foaf:name ?name\" input.ttl\n", program_name);
 }
 
 // Parse command line options
@@ -10,6 +10,7 @@
  */
 
 #include "serializer.h"
+#include "output_buffer.h"
 #include "visitor.h"
 #include <stdlib.h>
 #include <string.h>
@@ -20,6 +21,7 @@
  */
 typedef struct {
     FILE* output;
+    ttl_output_buffer_t out;          // Valid while serializing
     ttl_serializer_options_t options;
     ttl_serializer_stats_t stats;
     
@@ -35,34 +37,6 @@ typedef struct {
     clock_t start_time;
 } ntriples_context_t;
 
-/**
- * Escape string for N-Triples format
- * N-Triples uses simple escaping: \n \r \t \" \\
- */
-static char* escape_ntriples_string(const char* input) {
-    if (!input) return NULL;
-    
-    size_t len = strlen(input);
-    size_t escaped_len = len * 2 + 1; // Worst case
-    char* escaped = malloc(escaped_len);
-    if (!escaped) return NULL;
-    
-    char* dest = escaped;
-    for (const char* src = input; *src; src++) {
-        switch (*src) {
-            case '\n': *dest++ = '\\'; *dest++ = 'n'; break;
-            case '\r': *dest++ = '\\'; *dest++ = 'r'; break;
-            case '\t': *dest++ = '\\'; *dest++ = 't'; break;
-            case '"':  *dest++ = '\\'; *dest++ = '"'; break;
-            case '\\': *dest++ = '\\'; *dest++ = '\\'; break;
-            default:   *dest++ = *src; break;
-        }
-    }
-    *dest = '\0';
-    
-    return escaped;
-}
-
 /**
  * Serialize IRI node to N-Triples format
  */
@@ -73,7 +47,9 @@ static bool serialize_iri(ntriples_context_t* ctx, ttl_ast_node_t* node) {
     if (!iri) return false;
     
     // N-Triples requires absolute IRIs in angle brackets
-    if (fprintf(ctx->output, "<%s>", iri) < 0) {
+    if (!ttl_output_append_char(&ctx->out, '<') ||
+        !ttl_output_append_str(&ctx->out, iri) ||
+        !ttl_output_append_char(&ctx->out, '>')) {
         ctx->has_error = true;
         snprintf(ctx->error_message, sizeof(ctx->error_message), 
                 "Failed to write IRI: %s", iri);
@@ -110,7 +86,10 @@ static bool serialize_prefixed_name(ntriples_context_t* ctx, ttl_ast_node_t* nod
         namespace_iri = prefix;
     }
     
-    if (fprintf(ctx->output, "<%s%s>", namespace_iri, local) < 0) {
+    if (!ttl_output_append_char(&ctx->out, '<') ||
+        !ttl_output_append_str(&ctx->out, namespace_iri) ||
+        !ttl_output_append_str(&ctx->out, local) ||
+        !ttl_output_append_char(&ctx->out, '>')) {
         ctx->has_error = true;
         snprintf(ctx->error_message, sizeof(ctx->error_message), 
                 "Failed to write prefixed name: %s:%s", prefix, local);
@@ -129,7 +108,8 @@ static bool serialize_blank_node(ntriples_context_t* ctx, ttl_ast_node_t* node)
     const char* label = node->data.blank_node.label;
     if (label) {
         // Named blank node: _:label
-        if (fprintf(ctx->output, "_:%s", label) < 0) {
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, "_:") ||
+            !ttl_output_append_str(&ctx->out, label)) {
             ctx->has_error = true;
             snprintf(ctx->error_message, sizeof(ctx->error_message), 
                     "Failed to write blank node: %s", label);
@@ -138,7 +118,8 @@ static bool serialize_blank_node(ntriples_context_t* ctx, ttl_ast_node_t* node)
     } else {
         // Anonymous blank node: _:genid<id>
         uint32_t id = node->data.blank_node.id;
-        if (fprintf(ctx->output, "_:genid%u", id) < 0) {
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, "_:genid") ||
+            !ttl_output_append_int(&ctx->out, id)) {
             ctx->has_error = true;
             snprintf(ctx->error_message, sizeof(ctx->error_message), 
                     "Failed to write anonymous blank node: %u", id);
@@ -158,18 +139,10 @@ static bool serialize_string_literal(ntriples_context_t* ctx, ttl_ast_node_t* no
     const char* value = node->data.string_literal.value;
     if (!value) return false;
     
-    char* escaped = escape_ntriples_string(value);
-    if (!escaped) {
-        ctx->has_error = true;
-        strcpy(ctx->error_message, "Failed to escape string literal");
-        return false;
-    }
-    
-    // N-Triples uses double quotes for strings
-    int result = fprintf(ctx->output, "\"%s\"", escaped);
-    free(escaped);
-    
-    if (result < 0) {
+    // N-Triples uses double quotes for strings; clean runs are copied as-is
+    if (!ttl_output_append_char(&ctx->out, '"') ||
+        !ttl_output_append_escaped(&ctx->out, value, TTL_ESCAPE_NTRIPLES) ||
+        !ttl_output_append_char(&ctx->out, '"')) {
         ctx->has_error = true;
         strcpy(ctx->error_message, "Failed to write string literal");
         return false;
@@ -191,7 +164,7 @@ static bool serialize_typed_literal(ntriples_context_t* ctx, ttl_ast_node_t* nod
     }
     
     // Add datatype
-    if (fprintf(ctx->output, "^^") < 0) {
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "^^")) {
         ctx->has_error = true;
         strcpy(ctx->error_message, "Failed to write datatype separator");
         return false;
@@ -224,7 +197,8 @@ static bool serialize_lang_literal(ntriples_context_t* ctx, ttl_ast_node_t* node
     const char* lang_tag = node->data.lang_literal.language_tag;
     if (!lang_tag) return false;
     
-    if (fprintf(ctx->output, "@%s", lang_tag) < 0) {
+    if (!ttl_output_append_char(&ctx->out, '@') ||
+        !ttl_output_append_str(&ctx->out, lang_tag)) {
         ctx->has_error = true;
         snprintf(ctx->error_message, sizeof(ctx->error_message), 
                 "Failed to write language tag: %s", lang_tag);
@@ -243,7 +217,9 @@ static bool serialize_numeric_literal(ntriples_context_t* ctx, ttl_ast_node_t* n
     const char* lexical = node->data.numeric_literal.lexical_form;
     if (lexical) {
         // Use original lexical form if available
-        if (fprintf(ctx->output, "\"%s\"", lexical) < 0) {
+        if (!ttl_output_append_char(&ctx->out, '"') ||
+            !ttl_output_append_str(&ctx->out, lexical) ||
+            !ttl_output_append_char(&ctx->out, '"')) {
             ctx->has_error = true;
             strcpy(ctx->error_message, "Failed to write numeric literal");
             return false;
@@ -253,8 +229,9 @@ static bool serialize_numeric_literal(ntriples_context_t* ctx, ttl_ast_node_t* n
         ttl_numeric_type_t num_type = node->data.numeric_literal.numeric_type;
         switch (num_type) {
             case TTL_NUMERIC_INTEGER:
-                if (fprintf(ctx->output, "\"%lld\"", 
-                           (long long)node->data.numeric_literal.integer_value) < 0) {
+                if (!ttl_output_append_char(&ctx->out, '"') ||
+                    !ttl_output_append_int(&ctx->out, node->data.numeric_literal.integer_value) ||
+                    !ttl_output_append_char(&ctx->out, '"')) {
                     ctx->has_error = true;
                     strcpy(ctx->error_message, "Failed to write integer literal");
                     return false;
@@ -262,8 +239,9 @@ static bool serialize_numeric_literal(ntriples_context_t* ctx, ttl_ast_node_t* n
                 break;
             case TTL_NUMERIC_DECIMAL:
             case TTL_NUMERIC_DOUBLE:
-                if (fprintf(ctx->output, "\"%g\"", 
-                           node->data.numeric_literal.double_value) < 0) {
+                if (!ttl_output_append_char(&ctx->out, '"') ||
+                    !ttl_output_append_double(&ctx->out, node->data.numeric_literal.double_value) ||
+                    !ttl_output_append_char(&ctx->out, '"')) {
                     ctx->has_error = true;
                     strcpy(ctx->error_message, "Failed to write decimal literal");
                     return false;
@@ -286,7 +264,9 @@ static bool serialize_numeric_literal(ntriples_context_t* ctx, ttl_ast_node_t* n
             break;
     }
     
-    if (fprintf(ctx->output, "^^<%s>", datatype_iri) < 0) {
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "^^<") ||
+        !ttl_output_append_str(&ctx->out, datatype_iri) ||
+        !ttl_output_append_char(&ctx->out, '>')) {
         ctx->has_error = true;
         strcpy(ctx->error_message, "Failed to write numeric datatype");
         return false;
@@ -303,8 +283,9 @@ static bool serialize_boolean_literal(ntriples_context_t* ctx, ttl_ast_node_t* n
     
     const char* value = node->data.boolean_literal.value ? "true" : "false";
     
-    if (fprintf(ctx->output, "\"%s\"^^<http://www.w3.org/2001/XMLSchema#boolean>", 
-                value) < 0) {
+    if (!ttl_output_append_char(&ctx->out, '"') ||
+        !ttl_output_append_str(&ctx->out, value) ||
+        !TTL_OUTPUT_LITERAL(&ctx->out, "\"^^<http://www.w3.org/2001/XMLSchema#boolean>")) {
         ctx->has_error = true;
         strcpy(ctx->error_message, "Failed to write boolean literal");
         return false;
@@ -338,8 +319,7 @@ static bool serialize_resource(ntriples_context_t* ctx, ttl_ast_node_t* node) {
             return serialize_boolean_literal(ctx, node);
         case TTL_AST_RDF_TYPE:
             // 'a' shorthand expands to rdf:type
-            return fprintf(ctx->output, 
-                          "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>") >= 0;
+            return TTL_OUTPUT_LITERAL(&ctx->out, "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>");
         default:
             return false;
     }
@@ -374,13 +354,13 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
                 for (size_t j = 0; j < obj_count; j++) {
                     // Write one complete triple
                     if (!serialize_resource(ctx, subject)) return false;
-                    if (fprintf(ctx->output, " ") < 0) return false;
+                    if (!ttl_output_append_char(&ctx->out, ' ')) return false;
                     
                     if (!serialize_resource(ctx, predicate)) return false;
-                    if (fprintf(ctx->output, " ") < 0) return false;
+                    if (!ttl_output_append_char(&ctx->out, ' ')) return false;
                     
                     if (!serialize_resource(ctx, objects[j])) return false;
-                    if (fprintf(ctx->output, " .\n") < 0) return false;
+                    if (!TTL_OUTPUT_LITERAL(&ctx->out, " .\n")) return false;
                     
                     ctx->stats.triples_serialized++;
                 }
@@ -422,6 +402,11 @@ bool ttl_serialize_ntriples_ast(ttl_serializer_t* serializer, ttl_ast_node_t* ro
     ttl_ast_visitor_t* visitor = ttl_visitor_create();
     if (!visitor) return false;
     
+    if (!ttl_output_buffer_init(&ctx->out, ctx->output, 0)) {
+        ttl_visitor_destroy(visitor);
+        return false;
+    }
+    
     visitor->user_data = ctx;
     visitor->visit_triple = visit_triple;
     visitor->order = TTL_VISITOR_PRE_ORDER;
@@ -429,6 +414,13 @@ bool ttl_serialize_ntriples_ast(ttl_serializer_t* serializer, ttl_ast_node_t* ro
     // Traverse AST and serialize triples
     bool success = ttl_ast_accept(root, visitor);
     
+    // Flush the buffer
+    if (!ttl_output_buffer_destroy(&ctx->out)) {
+        ctx->has_error = true;
+        strcpy(ctx->error_message, "Failed to write output");
+    }
+    ctx->stats.bytes_written = ctx->out.bytes_written;
+    
     if (success && !ctx->has_error) {
         ctx->stats.serialization_time_ms = 
             ((double)(clock() - ctx->start_time)) / CLOCKS_PER_SEC * 1000.0;
@@ -0,0 +1,234 @@
+/**
+ * @file output_buffer.c
+ * @brief Buffered output backend for the RDF serializers
+ * @author CNS Seven-Tick Engine
+ * @date 2024
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "output_buffer.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define OUTPUT_WRITEV_THRESHOLD 4096   /* Larger appends skip the copy */
+
+/* Write all iovecs, retrying short writes */
+static bool writeAll(ttl_output_buffer_t* out, struct iovec* iov, int count) {
+    if (out->has_error) return false;
+
+    if (out->fd < 0) {
+        for (int i = 0; i < count; i++) {
+            if (fwrite(iov[i].iov_base, 1, iov[i].iov_len, out->stream) != iov[i].iov_len) {
+                out->has_error = true;
+                return false;
+            }
+            out->bytes_written += iov[i].iov_len;
+        }
+        return true;
+    }
+
+    while (count > 0) {
+        ssize_t written = writev(out->fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            out->has_error = true;
+            return false;
+        }
+        out->bytes_written += (size_t)written;
+
+        size_t remaining = (size_t)written;
+        while (count > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+bool ttl_output_buffer_init(ttl_output_buffer_t* out, FILE* stream, size_t capacity) {
+    memset(out, 0, sizeof(*out));
+    out->stream = stream ? stream : stdout;
+    out->capacity = capacity ? capacity : TTL_OUTPUT_BUFFER_SIZE;
+    out->data = malloc(out->capacity);
+    if (!out->data) {
+        out->capacity = 0;
+        out->has_error = true;
+        return false;
+    }
+
+    /* Earlier stdio output must land first */
+    fflush(out->stream);
+    out->fd = fileno(out->stream);
+    return true;
+}
+
+bool ttl_output_buffer_flush(ttl_output_buffer_t* out) {
+    if (out->used == 0) return !out->has_error;
+
+    struct iovec iov = {out->data, out->used};
+    out->used = 0;
+    return writeAll(out, &iov, 1);
+}
+
+bool ttl_output_buffer_destroy(ttl_output_buffer_t* out) {
+    bool ok = ttl_output_buffer_flush(out);
+    if (out->fd < 0 && fflush(out->stream) != 0) ok = false;
+    free(out->data);
+    out->data = NULL;
+    out->capacity = 0;
+    return ok && !out->has_error;
+}
+
+bool ttl_output_append_slow(ttl_output_buffer_t* out, const char* data, size_t length) {
+    if (out->has_error || !out->data) return false;
+
+    if (length >= OUTPUT_WRITEV_THRESHOLD || length > out->capacity) {
+        /* Buffered bytes and the block in one system call */
+        struct iovec iov[2] = {
+            {out->data, out->used},
+            {(void*)data, length}
+        };
+        size_t first = out->used ? 0 : 1;
+        out->used = 0;
+        return writeAll(out, iov + first, 2 - (int)first);
+    }
+
+    if (!ttl_output_buffer_flush(out)) return false;
+    memcpy(out->data, data, length);
+    out->used = length;
+    return true;
+}
+
+bool ttl_output_append_int(ttl_output_buffer_t* out, long long value) {
+    char digits[24];
+    char* p = digits + sizeof(digits);
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) *--p = '-';
+
+    return ttl_output_append(out, p, (size_t)(digits + sizeof(digits) - p));
+}
+
+bool ttl_output_append_double(ttl_output_buffer_t* out, double value) {
+    char text[32];
+    int length = snprintf(text, sizeof(text), "%g", value);
+    return length > 0 && ttl_output_append(out, text, (size_t)length);
+}
+
+static bool needsEscape(unsigned char ch, ttl_escape_mode_t mode) {
+    switch (mode) {
+        case TTL_ESCAPE_XML:
+            return ch == '<' || ch == '>' || ch == '&' || ch == '"' || ch == '\'';
+        default:
+            return ch < 0x20 || ch == '"' || ch == '\\';
+    }
+}
+
+size_t ttl_escape_scan(const char* str, size_t length, ttl_escape_mode_t mode) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    if (mode == TTL_ESCAPE_XML) {
+        const __m128i lt = _mm_set1_epi8('<');
+        const __m128i gt = _mm_set1_epi8('>');
+        const __m128i amp = _mm_set1_epi8('&');
+        const __m128i quot = _mm_set1_epi8('"');
+        const __m128i apos = _mm_set1_epi8('\'');
+        for (; i + 16 <= length; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(str + i));
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, lt), _mm_cmpeq_epi8(block, gt)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(block, amp), _mm_cmpeq_epi8(block, quot)));
+            int mask = _mm_movemask_epi8(_mm_or_si128(hit, _mm_cmpeq_epi8(block, apos)));
+            if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+    } else {
+        const __m128i control = _mm_set1_epi8(0x1F);
+        const __m128i quot = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        for (; i + 16 <= length; i += 16) {
+            __m128i block = _mm_loadu_si128((const __m128i*)(str + i));
+            /* Unsigned block <= 0x1F */
+            __m128i hit = _mm_cmpeq_epi8(_mm_min_epu8(block, control), block);
+            hit = _mm_or_si128(hit, _mm_or_si128(_mm_cmpeq_epi8(block, quot), _mm_cmpeq_epi8(block, backslash)));
+            int mask = _mm_movemask_epi8(hit);
+            if (mask) return i + (size_t)__builtin_ctz((unsigned)mask);
+        }
+    }
+#endif
+
+    for (; i < length; i++) {
+        if (needsEscape((unsigned char)str[i], mode)) return i;
+    }
+    return length;
+}
+
+static bool appendEscape(ttl_output_buffer_t* out, char ch, ttl_escape_mode_t mode) {
+    if (mode == TTL_ESCAPE_XML) {
+        switch (ch) {
+            case '<':  return TTL_OUTPUT_LITERAL(out, "&lt;");
+            case '>':  return TTL_OUTPUT_LITERAL(out, "&gt;");
+            case '&':  return TTL_OUTPUT_LITERAL(out, "&amp;");
+            case '"':  return TTL_OUTPUT_LITERAL(out, "&quot;");
+            default:   return TTL_OUTPUT_LITERAL(out, "&apos;");
+        }
+    }
+
+    switch (ch) {
+        case '"':  return TTL_OUTPUT_LITERAL(out, "\\\"");
+        case '\\': return TTL_OUTPUT_LITERAL(out, "\\\\");
+        case '\n': return TTL_OUTPUT_LITERAL(out, "\\n");
+        case '\r': return TTL_OUTPUT_LITERAL(out, "\\r");
+        case '\t': return TTL_OUTPUT_LITERAL(out, "\\t");
+        default:
+            break;
+    }
+
+    if (mode == TTL_ESCAPE_JSON) {
+        switch (ch) {
+            case '\b': return TTL_OUTPUT_LITERAL(out, "\\b");
+            case '\f': return TTL_OUTPUT_LITERAL(out, "\\f");
+            default: {
+                static const char hex[] = "0123456789abcdef";
+                char escape[6] = {'\\', 'u', '0', '0', hex[((unsigned char)ch >> 4) & 0xF], hex[ch & 0xF]};
+                return ttl_output_append(out, escape, sizeof(escape));
+            }
+        }
+    }
+
+    /* N-Triples passes other control characters through */
+    return ttl_output_append_char(out, ch);
+}
+
+bool ttl_output_append_escaped(ttl_output_buffer_t* out, const char* str, ttl_escape_mode_t mode) {
+    if (!str) return true;
+
+    size_t length = strlen(str);
+    size_t i = 0;
+    while (i < length) {
+        size_t clean = ttl_escape_scan(str + i, length - i, mode);
+        if (clean && !ttl_output_append(out, str + i, clean)) return false;
+        i += clean;
+        if (i < length) {
+            if (!appendEscape(out, str[i], mode)) return false;
+            i++;
+        }
+    }
+    return true;
+}
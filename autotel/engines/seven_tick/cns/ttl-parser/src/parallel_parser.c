@@ -0,0 +1,720 @@
+/**
+ * @file parallel_parser.c
+ * @brief Parallel chunked parsing of N-Triples and prefix-stable Turtle
+ * @author CNS Seven-Tick Engine
+ * @date 2024
+ *
+ * Three passes over the input:
+ *   1. Sequentially find the prologue (leading directives).
+ *   2. In parallel, scan line-aligned ranges with a small lexer state
+ *      machine (IRIs, comments, short and long strings). A line can only
+ *      start in normal state or inside a long string, so each range is
+ *      scanned once per possible start state, recording the first safe
+ *      split point and the state at its end. Chaining the end states
+ *      from the prologue then picks each range's real split point. The
+ *      scan also counts newlines (for error lines) and finds any late
+ *      directive (which forces a sequential parse).
+ *   3. In parallel, parse the chunks between accepted split points with
+ *      streaming parsers forked from the prologue parser, buffering each
+ *      chunk's output per thread until it is delivered.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallel_parser.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define PARALLEL_DEFAULT_CHUNK  (16 * 1024 * 1024)
+#define PARALLEL_MIN_CHUNK      (64 * 1024)
+#define PARALLEL_CHUNKS_PER_THREAD 4         /* For load balance */
+#define PARALLEL_MAX_THREADS    256
+#define PARALLEL_EMIT_BATCH     256
+#define NO_OFFSET               SIZE_MAX
+
+/* Lexer state at a line start: only long strings span lines */
+typedef enum {
+    SCAN_NORMAL,
+    SCAN_LONG_DOUBLE,            /* Inside """...""" */
+    SCAN_LONG_SINGLE,            /* Inside '''...''' */
+    SCAN_LINE_STATES
+} ScanState;
+
+/* Result of scanning a range from one start state */
+typedef struct {
+    size_t boundary;             /* First safe split in range (NO_OFFSET if none) */
+    size_t lines_before;         /* Newlines in [start, boundary) */
+    ScanState end_state;
+} ScanPath;
+
+/* Line-aligned range scanned in pass 2 */
+typedef struct {
+    size_t start;
+    size_t end;
+    size_t lines;                /* Newlines in [start, end) */
+    ScanPath paths[SCAN_LINE_STATES];
+    bool directive;              /* @prefix/@base inside the body */
+} ScanRange;
+
+/* Chunk parsed in pass 3 */
+typedef struct {
+    size_t start;
+    size_t end;
+    size_t first_line;
+} Chunk;
+
+/* Triple buffered as offsets into the worker's text buffer */
+typedef struct {
+    size_t subject;
+    size_t predicate;
+    size_t object;
+    size_t datatype;             /* NO_OFFSET if none */
+    size_t lang;                 /* NO_OFFSET if none */
+    TripleTermKind subject_kind;
+    TripleTermKind object_kind;
+} BufferedTriple;
+
+typedef struct {
+    int line;
+    int column;
+    size_t message;
+} BufferedError;
+
+typedef struct ParallelParse ParallelParse;
+
+/* Per-thread output buffer, reused across chunks */
+typedef struct {
+    ParallelParse* job;
+    char* text;
+    size_t text_used;
+    size_t text_capacity;
+    BufferedTriple* triples;
+    size_t triple_count;
+    size_t triple_capacity;
+    BufferedError* errors;
+    size_t error_count;
+    size_t error_capacity;
+    bool out_of_memory;
+} Worker;
+
+struct ParallelParse {
+    const char* data;
+    size_t length;
+    bool ntriples;
+    bool ordered;
+    const StreamingCallbacks* callbacks;
+    const StreamingParser* prologue;
+
+    ScanRange* ranges;
+    size_t range_count;
+    Chunk* chunks;
+    size_t chunk_count;
+    atomic_size_t next;          /* Next range/chunk to claim */
+    atomic_bool failed;
+
+    /* Delivery; callbacks run under emit_lock */
+    pthread_mutex_t emit_lock;
+    pthread_cond_t emit_cond;
+    size_t next_emit;            /* Ordered mode: next chunk to deliver */
+    size_t triples;
+    size_t errors;
+};
+
+/* Scanning helpers */
+
+static size_t countNewlines(const char* data, size_t from, size_t to) {
+    size_t count = 0;
+    const char* p = data + from;
+    const char* end = data + to;
+    while (p < end && (p = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        count++;
+        p++;
+    }
+    return count;
+}
+
+static bool isSubjectStart(char ch) {
+    return ch == '<' || ch == '_' || ch == '[' || ch == '(' || ch == ':' ||
+           (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (unsigned char)ch >= 0x80;
+}
+
+/* Length of the run of `quote` characters at i */
+static size_t quoteRun(const char* data, size_t length, size_t i, char quote) {
+    size_t run = 0;
+    while (i + run < length && data[i + run] == quote) run++;
+    return run;
+}
+
+/*
+ * Scan [from, to) starting in `state` at a line start. A safe split point is
+ * a line start in normal state whose line begins a subject and whose last
+ * significant character before it, outside comments and literals, is the
+ * '.' ending a statement. Short strings, IRIs and comments end at the
+ * newline, as they cannot span lines in Turtle.
+ */
+static void scanPath(const char* data, size_t length, size_t from, size_t to,
+                     ScanState state, ScanPath* path) {
+    enum { IN_CODE, IN_SHORT, IN_IRI, IN_COMMENT, IN_LONG } mode =
+        state == SCAN_NORMAL ? IN_CODE : IN_LONG;
+    char quote = state == SCAN_LONG_SINGLE ? '\'' : '"';
+    char last = 0;               /* Unknown until the first token */
+    size_t lines = 0;
+
+    path->boundary = NO_OFFSET;
+    path->lines_before = 0;
+
+    for (size_t i = from; i < to; i++) {
+        char ch = data[i];
+        switch (mode) {
+        case IN_CODE:
+            if (ch == '"' || ch == '\'') {
+                size_t run = quoteRun(data, length, i, ch);
+                if (run >= 3) {
+                    mode = IN_LONG;
+                    quote = ch;
+                    i += 2;
+                } else if (run == 2) {
+                    i += 1;      /* Empty string */
+                } else {
+                    mode = IN_SHORT;
+                    quote = ch;
+                }
+                last = ch;
+            } else if (ch == '<') {
+                mode = IN_IRI;
+                last = ch;
+            } else if (ch == '#') {
+                mode = IN_COMMENT;
+            } else if (ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n') {
+                last = ch;
+            }
+            break;
+        case IN_SHORT:
+            if (ch == '\\') i++;
+            else if (ch == quote) { mode = IN_CODE; last = ch; }
+            break;
+        case IN_IRI:
+            if (ch == '>') { mode = IN_CODE; last = ch; }
+            break;
+        case IN_COMMENT:
+            break;
+        case IN_LONG:
+            if (ch == '\\') {
+                i++;
+            } else if (ch == quote) {
+                /* Content cannot end in a quote: the first three close it */
+                size_t run = quoteRun(data, length, i, ch);
+                if (run >= 3) {
+                    mode = IN_CODE;
+                    last = ch;
+                    i += 2;
+                } else {
+                    i += run - 1;
+                }
+            }
+            break;
+        }
+
+        if (i < to && data[i] == '\n') {
+            lines++;
+            if (mode != IN_LONG) {
+                mode = IN_CODE;  /* Nothing else spans lines */
+                size_t next = i + 1;
+                if (path->boundary == NO_OFFSET && last == '.' && next < to &&
+                    isSubjectStart(data[next])) {
+                    path->boundary = next;
+                    path->lines_before = lines;
+                }
+            }
+        }
+    }
+
+    path->end_state = mode != IN_LONG ? SCAN_NORMAL
+                    : quote == '"' ? SCAN_LONG_DOUBLE : SCAN_LONG_SINGLE;
+}
+
+static bool hasDirective(const char* data, size_t length, size_t from, size_t to) {
+    size_t i = from;
+    while (i < to) {
+        const char* at = memchr(data + i, '@', to - i);
+        if (!at) return false;
+        size_t j = (size_t)(at - data);
+        bool token_start = j == 0 || data[j - 1] == ' ' || data[j - 1] == '\t' ||
+                           data[j - 1] == '\n' || data[j - 1] == '\r';
+        if (token_start && ((j + 7 <= length && memcmp(data + j, "@prefix", 7) == 0) ||
+                            (j + 5 <= length && memcmp(data + j, "@base", 5) == 0))) {
+            return true;
+        }
+        i = j + 1;
+    }
+    return false;
+}
+
+/* End of the leading @prefix/@base directives */
+static size_t findPrologueEnd(const char* data, size_t length) {
+    Lexer* lexer = lexer_create(NULL);
+    if (!lexer) return 0;
+    lexer_init(lexer, data, length);
+
+    size_t end = 0;
+    bool in_directive = false;
+    TokenSlice slice;
+    while (lexer_next_slice(lexer, &slice) && slice.type != TOKEN_EOF) {
+        if (slice.type == TOKEN_COMMENT) continue;
+        if (!in_directive) {
+            if (slice.type != TOKEN_PREFIX && slice.type != TOKEN_BASE) break;
+            in_directive = true;
+        } else if (slice.type == TOKEN_DOT) {
+            in_directive = false;
+            lexer_get_position(lexer, NULL, NULL, &end);
+        }
+    }
+
+    lexer_destroy(lexer);
+    return end;
+}
+
+static void scanRange(ParallelParse* job, ScanRange* range, bool first) {
+    const char* data = job->data;
+
+    if (job->ntriples) {
+        /* Ranges are line-aligned and N-Triples statements are lines */
+        ScanPath* path = &range->paths[SCAN_NORMAL];
+        path->boundary = range->start < range->end ? range->start : NO_OFFSET;
+        path->lines_before = 0;
+        path->end_state = SCAN_NORMAL;
+        range->lines = countNewlines(data, range->start, range->end);
+        return;
+    }
+
+    /* The first range starts right after the prologue, in normal state */
+    ScanState states = first ? SCAN_NORMAL + 1 : SCAN_LINE_STATES;
+    for (int state = SCAN_NORMAL; state < (int)states; state++) {
+        scanPath(data, job->length, range->start, range->end, (ScanState)state,
+                 &range->paths[state]);
+    }
+    if (first) {
+        range->paths[SCAN_NORMAL].boundary = range->start;
+        range->paths[SCAN_NORMAL].lines_before = 0;
+    }
+    range->lines = countNewlines(data, range->start, range->end);
+    range->directive = hasDirective(data, job->length, range->start, range->end);
+}
+
+/* Start of the first line at or after offset */
+static size_t alignToLine(const char* data, size_t length, size_t offset) {
+    if (offset == 0 || offset >= length || data[offset - 1] == '\n') return offset;
+    const char* newline = memchr(data + offset, '\n', length - offset);
+    return newline ? (size_t)(newline - data) + 1 : length;
+}
+
+/* Worker output buffering */
+
+static size_t workerText(Worker* worker, const char* text) {
+    if (!text) return NO_OFFSET;
+
+    size_t length = strlen(text) + 1;
+    if (worker->text_used + length > worker->text_capacity) {
+        size_t capacity = worker->text_capacity ? worker->text_capacity * 2 : 1024 * 1024;
+        while (capacity < worker->text_used + length) capacity *= 2;
+        char* grown = (char*)realloc(worker->text, capacity);
+        if (!grown) {
+            worker->out_of_memory = true;
+            return NO_OFFSET;
+        }
+        worker->text = grown;
+        worker->text_capacity = capacity;
+    }
+
+    size_t offset = worker->text_used;
+    memcpy(worker->text + offset, text, length);
+    worker->text_used += length;
+    return offset;
+}
+
+static void workerOnTriples(void* data, const StreamingTriple* triples, size_t count) {
+    Worker* worker = (Worker*)data;
+
+    if (worker->triple_count + count > worker->triple_capacity) {
+        size_t capacity = worker->triple_capacity ? worker->triple_capacity * 2 : 4096;
+        while (capacity < worker->triple_count + count) capacity *= 2;
+        BufferedTriple* grown = (BufferedTriple*)realloc(worker->triples, capacity * sizeof(BufferedTriple));
+        if (!grown) {
+            worker->out_of_memory = true;
+            return;
+        }
+        worker->triples = grown;
+        worker->triple_capacity = capacity;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        worker->triples[worker->triple_count++] = (BufferedTriple){
+            .subject = workerText(worker, triples[i].subject),
+            .predicate = workerText(worker, triples[i].predicate),
+            .object = workerText(worker, triples[i].object),
+            .datatype = workerText(worker, triples[i].datatype),
+            .lang = workerText(worker, triples[i].lang),
+            .subject_kind = triples[i].subject_kind,
+            .object_kind = triples[i].object_kind
+        };
+    }
+}
+
+static void workerOnError(void* data, const ParseError* error) {
+    Worker* worker = (Worker*)data;
+
+    if (worker->error_count == worker->error_capacity) {
+        size_t capacity = worker->error_capacity ? worker->error_capacity * 2 : 16;
+        BufferedError* grown = (BufferedError*)realloc(worker->errors, capacity * sizeof(BufferedError));
+        if (!grown) {
+            worker->out_of_memory = true;
+            return;
+        }
+        worker->errors = grown;
+        worker->error_capacity = capacity;
+    }
+    worker->errors[worker->error_count++] = (BufferedError){
+        .line = error->line,
+        .column = error->column,
+        .message = workerText(worker, error->message)
+    };
+}
+
+static const char* workerString(const Worker* worker, size_t offset) {
+    return offset == NO_OFFSET ? NULL : worker->text + offset;
+}
+
+/* Hand a finished chunk to the user callbacks; caller holds emit_lock */
+static void deliverChunk(ParallelParse* job, const Worker* worker) {
+    const StreamingCallbacks* cb = job->callbacks;
+
+    for (size_t i = 0; i < worker->error_count; i++) {
+        if (!cb->on_error) break;
+        const BufferedError* buffered = &worker->errors[i];
+        ParseError error = {
+            .line = buffered->line,
+            .column = buffered->column,
+            .message = (char*)workerString(worker, buffered->message),
+            .severity = ERROR_SEVERITY_ERROR
+        };
+        cb->on_error(cb->user_data, &error);
+    }
+    job->errors += worker->error_count;
+
+    StreamingTriple batch[PARALLEL_EMIT_BATCH];
+    for (size_t i = 0; i < worker->triple_count; i += PARALLEL_EMIT_BATCH) {
+        size_t count = worker->triple_count - i;
+        if (count > PARALLEL_EMIT_BATCH) count = PARALLEL_EMIT_BATCH;
+
+        for (size_t k = 0; k < count; k++) {
+            const BufferedTriple* t = &worker->triples[i + k];
+            batch[k] = (StreamingTriple){
+                .subject = workerString(worker, t->subject),
+                .predicate = workerString(worker, t->predicate),
+                .object = workerString(worker, t->object),
+                .datatype = workerString(worker, t->datatype),
+                .lang = workerString(worker, t->lang),
+                .subject_kind = t->subject_kind,
+                .object_kind = t->object_kind
+            };
+        }
+        if (cb->on_triples) cb->on_triples(cb->user_data, batch, count);
+        if (cb->on_triple) {
+            for (size_t k = 0; k < count; k++) {
+                cb->on_triple(cb->user_data, batch[k].subject, batch[k].predicate, batch[k].object);
+            }
+        }
+    }
+    job->triples += worker->triple_count;
+}
+
+static void parseChunk(ParallelParse* job, Worker* worker, size_t index) {
+    const Chunk* chunk = &job->chunks[index];
+    worker->text_used = worker->triple_count = worker->error_count = 0;
+
+    StreamingCallbacks callbacks = {
+        .user_data = worker,
+        .on_triples = workerOnTriples,
+        .on_error = workerOnError
+    };
+    StreamingParser* parser = ttl_streaming_parser_fork(job->prologue, &callbacks, index + 1);
+    if (!parser ||
+        !ttl_streaming_parser_parse_region(parser, job->data + chunk->start,
+                                           chunk->end - chunk->start, chunk->first_line)) {
+        worker->out_of_memory = true;
+    }
+    ttl_streaming_parser_destroy(parser);
+
+    pthread_mutex_lock(&job->emit_lock);
+    if (job->ordered) {
+        /* Chunks are claimed in order, so the one awaited is always in progress */
+        while (job->next_emit != index) pthread_cond_wait(&job->emit_cond, &job->emit_lock);
+    }
+    if (worker->out_of_memory) {
+        atomic_store(&job->failed, true);
+    } else {
+        deliverChunk(job, worker);
+    }
+    job->next_emit++;
+    pthread_cond_broadcast(&job->emit_cond);
+    pthread_mutex_unlock(&job->emit_lock);
+}
+
+/* Thread entry points */
+
+typedef struct {
+    ParallelParse* job;
+    Worker worker;
+    void (*run)(ParallelParse* job, Worker* worker);
+} ThreadArgs;
+
+static void runScan(ParallelParse* job, Worker* worker) {
+    (void)worker;
+    size_t index;
+    while ((index = atomic_fetch_add(&job->next, 1)) < job->range_count) {
+        scanRange(job, &job->ranges[index], index == 0);
+    }
+}
+
+static void runParse(ParallelParse* job, Worker* worker) {
+    size_t index;
+    while ((index = atomic_fetch_add(&job->next, 1)) < job->chunk_count) {
+        parseChunk(job, worker, index);
+    }
+}
+
+static void* threadMain(void* arg) {
+    ThreadArgs* args = (ThreadArgs*)arg;
+    args->run(args->job, &args->worker);
+    return NULL;
+}
+
+/* Run fn on `threads` threads, the caller being one of them */
+static void runThreads(ParallelParse* job, ThreadArgs* args, size_t threads,
+                       void (*fn)(ParallelParse*, Worker*)) {
+    pthread_t handles[PARALLEL_MAX_THREADS];
+    size_t started = 1;
+
+    atomic_store(&job->next, 0);
+    for (size_t i = 0; i < threads; i++) {
+        args[i].job = job;
+        args[i].worker.job = job;
+        args[i].run = fn;
+    }
+    for (size_t i = 1; i < threads; i++) {
+        if (pthread_create(&handles[i], NULL, threadMain, &args[i]) != 0) break;
+        started++;
+    }
+    fn(job, &args[0].worker);
+    for (size_t i = 1; i < started; i++) {
+        pthread_join(handles[i], NULL);
+    }
+}
+
+static double elapsedMs(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1000.0 + (double)(now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/* Public API */
+
+ParallelParseOptions ttl_parallel_default_options(void) {
+    ParallelParseOptions options = {
+        .num_threads = 0,
+        .chunk_size = PARALLEL_DEFAULT_CHUNK,
+        .ordered = true,
+        .ntriples = false
+    };
+    return options;
+}
+
+/* Sequential fallback: one streaming parser over the whole document */
+static bool parseSequential(const char* data, size_t length, const StreamingCallbacks* callbacks,
+                            ParallelParseStats* stats) {
+    StreamingParser* parser = ttl_streaming_parser_create(callbacks, NULL);
+    if (!parser) return false;
+
+    bool ok = ttl_streaming_parser_parse_region(parser, data, length, 1);
+    ParserStats parser_stats;
+    ttl_streaming_parser_get_stats(parser, &parser_stats);
+    ttl_streaming_parser_destroy(parser);
+
+    stats->threads = 1;
+    stats->chunks = 1;
+    stats->triples = parser_stats.triples_parsed;
+    stats->errors = parser_stats.errors_recovered;
+    stats->sequential = true;
+    return ok;
+}
+
+bool ttl_parallel_parse_buffer(const char* data, size_t length,
+                               const StreamingCallbacks* callbacks,
+                               const ParallelParseOptions* options,
+                               ParallelParseStats* stats) {
+    if (!data || !callbacks) return false;
+
+    ParallelParseOptions opts = options ? *options : ttl_parallel_default_options();
+    ParallelParseStats local_stats;
+    if (!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    size_t threads = opts.num_threads;
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    if (threads > PARALLEL_MAX_THREADS) threads = PARALLEL_MAX_THREADS;
+
+    size_t body_start = (opts.ntriples || length == 0) ? 0 : findPrologueEnd(data, length);
+    size_t body = length - body_start;
+
+    size_t chunk_size = opts.chunk_size ? opts.chunk_size : PARALLEL_DEFAULT_CHUNK;
+    size_t balanced = body / (threads * PARALLEL_CHUNKS_PER_THREAD);
+    if (balanced < chunk_size) chunk_size = balanced;
+    if (chunk_size < PARALLEL_MIN_CHUNK) chunk_size = PARALLEL_MIN_CHUNK;
+
+    if (threads == 1 || body <= chunk_size) {
+        bool ok = parseSequential(data, length, callbacks, stats);
+        stats->sequential = false;
+        stats->parse_time_ms = elapsedMs(&start_time);
+        return ok;
+    }
+
+    ParallelParse job = {
+        .data = data,
+        .length = length,
+        .ntriples = opts.ntriples,
+        .ordered = opts.ordered,
+        .callbacks = callbacks
+    };
+    atomic_init(&job.next, 0);
+    atomic_init(&job.failed, false);
+
+    job.range_count = (body + chunk_size - 1) / chunk_size;
+    job.ranges = (ScanRange*)calloc(job.range_count, sizeof(ScanRange));
+    job.chunks = (Chunk*)calloc(job.range_count, sizeof(Chunk));
+    ThreadArgs* args = (ThreadArgs*)calloc(threads, sizeof(ThreadArgs));
+    if (!job.ranges || !job.chunks || !args) {
+        free(job.ranges);
+        free(job.chunks);
+        free(args);
+        return false;
+    }
+    for (size_t r = 0; r < job.range_count; r++) {
+        job.ranges[r].start = r == 0 ? body_start
+                                     : alignToLine(data, length, body_start + r * chunk_size);
+        if (r > 0) job.ranges[r - 1].end = job.ranges[r].start;
+    }
+    job.ranges[job.range_count - 1].end = length;
+
+    /* Pass 2: scan ranges */
+    runThreads(&job, args, threads, runScan);
+
+    bool late_directive = false;
+    for (size_t r = 0; r < job.range_count; r++) {
+        late_directive |= job.ranges[r].directive;
+    }
+
+    bool ok;
+    if (late_directive) {
+        /* Prefixes change mid-document: chunks cannot share them */
+        ok = parseSequential(data, length, callbacks, stats);
+    } else {
+        /* Follow the real lexer state from range to range */
+        size_t lines = countNewlines(data, 0, body_start);
+        ScanState state = SCAN_NORMAL;
+        for (size_t r = 0; r < job.range_count; r++) {
+            const ScanRange* range = &job.ranges[r];
+            const ScanPath* path = &range->paths[state];
+            if (path->boundary != NO_OFFSET) {
+                if (job.chunk_count > 0) job.chunks[job.chunk_count - 1].end = path->boundary;
+                job.chunks[job.chunk_count++] = (Chunk){
+                    .start = path->boundary,
+                    .end = length,
+                    .first_line = lines + path->lines_before + 1
+                };
+            }
+            lines += range->lines;
+            state = path->end_state;
+        }
+
+        /* Prologue directives, once, with the user's callbacks */
+        StreamingParser* prologue = ttl_streaming_parser_create(callbacks, NULL);
+        ok = prologue && ttl_streaming_parser_parse_region(prologue, data, body_start, 1);
+
+        if (ok) {
+            job.prologue = prologue;
+            pthread_mutex_init(&job.emit_lock, NULL);
+            pthread_cond_init(&job.emit_cond, NULL);
+
+            /* Pass 3: parse chunks */
+            runThreads(&job, args, threads, runParse);
+
+            pthread_cond_destroy(&job.emit_cond);
+            pthread_mutex_destroy(&job.emit_lock);
+            ok = !atomic_load(&job.failed);
+        }
+        ttl_streaming_parser_destroy(prologue);
+
+        stats->threads = threads;
+        stats->chunks = job.chunk_count;
+        stats->triples = job.triples;
+        stats->errors = job.errors;
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        free(args[i].worker.text);
+        free(args[i].worker.triples);
+        free(args[i].worker.errors);
+    }
+    free(args);
+    free(job.ranges);
+    free(job.chunks);
+
+    stats->parse_time_ms = elapsedMs(&start_time);
+    return ok;
+}
+
+bool ttl_parallel_parse_file(const char* path,
+                             const StreamingCallbacks* callbacks,
+                             const ParallelParseOptions* options,
+                             ParallelParseStats* stats) {
+    if (!path || !callbacks) return false;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t length = (size_t)st.st_size;
+    if (length == 0) {
+        close(fd);
+        return ttl_parallel_parse_buffer("", 0, callbacks, options, stats);
+    }
+
+    void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+    posix_madvise(mapping, length, POSIX_MADV_SEQUENTIAL);
+
+    bool ok = ttl_parallel_parse_buffer((const char*)mapping, length, callbacks, options, stats);
+    munmap(mapping, length);
+    return ok;
+}
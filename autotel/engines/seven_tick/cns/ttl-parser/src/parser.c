@@ -13,6 +13,24 @@
 #include <string.h>
 #include <assert.h>
 #include <time.h>
+#include <ctype.h>
+#include <stdio.h>
+
+/* Prefix map entry */
+typedef struct {
+    char* prefix;                    /* Prefix without ':' (NULL = empty slot) */
+    size_t prefix_length;
+    char* iri;                       /* Namespace IRI */
+    size_t iri_length;
+    uint64_t hash;                   /* FNV-1a of prefix */
+} PrefixEntry;
+
+/* Hashed prefix map (open addressing, linear probing) */
+typedef struct {
+    PrefixEntry* entries;
+    size_t capacity;                 /* Power of two */
+    size_t count;
+} PrefixMap;
 
 /* Parser state structure */
 struct Parser {
@@ -31,12 +49,7 @@ struct Parser {
     
     /* Parser state */
     char* base_iri;                  /* Current base IRI */
-    struct {
-        char* prefix;
-        char* iri;
-    }* prefixes;                     /* Prefix mappings */
-    size_t prefix_count;
-    size_t prefix_capacity;
+    PrefixMap prefixes;              /* Prefix mappings */
     
     /* Performance tracking */
     clock_t start_time;
@@ -98,6 +111,11 @@ static char* copyString(Parser* parser, const char* str);
 static void addPrefix(Parser* parser, const char* prefix, const char* iri);
 static const char* lookupPrefix(Parser* parser, const char* prefix);
 static char* resolveIRI(Parser* parser, const char* iri);
+static bool prefixMapInit(PrefixMap* map, size_t capacity);
+static void prefixMapDestroy(PrefixMap* map);
+static bool prefixMapPut(PrefixMap* map, const char* prefix, size_t prefix_length,
+                         const char* iri, size_t iri_length);
+static const PrefixEntry* prefixMapGet(const PrefixMap* map, const char* prefix, size_t prefix_length);
 static bool isDirectiveStart(Token* token);
 
 /* Memory management */
@@ -140,9 +158,8 @@ Parser* ttl_parser_create(const char* input, size_t length, const ParserOptions*
         parser->base_iri = copyString(parser, parser->options.base_iri);
     }
     
-    /* Allocate prefix array */
-    parser->prefix_capacity = 16;
-    parser->prefixes = calloc(parser->prefix_capacity, sizeof(parser->prefixes[0]));
+    /* Allocate prefix map */
+    prefixMapInit(&parser->prefixes, 16);
     
     /* Get first token */
     advance(parser);
@@ -203,9 +220,8 @@ Parser* ttl_parser_create_with_lexer(Lexer* lexer, const ParserOptions* options)
         parser->base_iri = copyString(parser, parser->options.base_iri);
     }
     
-    /* Allocate prefix array */
-    parser->prefix_capacity = 16;
-    parser->prefixes = calloc(parser->prefix_capacity, sizeof(parser->prefixes[0]));
+    /* Allocate prefix map */
+    prefixMapInit(&parser->prefixes, 16);
     
     /* Get first token */
     advance(parser);
@@ -249,11 +265,7 @@ void ttl_parser_destroy(Parser* parser) {
     }
     
     /* Free prefixes */
-    for (size_t i = 0; i < parser->prefix_count; i++) {
-        free(parser->prefixes[i].prefix);
-        free(parser->prefixes[i].iri);
-    }
-    free(parser->prefixes);
+    prefixMapDestroy(&parser->prefixes);
     
     /* Free base IRI */
     free(parser->base_iri);
@@ -698,9 +710,9 @@ static ttl_ast_node_t* parseRDFLiteral(Parser* parser) {
     free(value);
     
     /* Check for language tag or datatype */
-    if (match(parser, TOKEN_AT)) {
-        /* Language tag */
-        if (!check(parser, TOKEN_PREFIXED_NAME)) {
+    if (check(parser, TOKEN_AT)) {
+        /* Language tag, carried by the '@' token */
+        if (!parser->current_token->value || parser->current_token->value[0] == '\0') {
             reportError(parser, "Expected language tag after '@'");
             return NULL;
         }
@@ -1018,36 +1030,107 @@ static char* copyString(Parser* parser, const char* str) {
 }
 
 static void addPrefix(Parser* parser, const char* prefix, const char* iri) {
-    /* Check if prefix already exists */
-    for (size_t i = 0; i < parser->prefix_count; i++) {
-        if (strcmp(parser->prefixes[i].prefix, prefix) == 0) {
-            /* Update existing prefix */
-            free(parser->prefixes[i].iri);
-            parser->prefixes[i].iri = copyString(parser, iri);
-            return;
-        }
+    prefixMapPut(&parser->prefixes, prefix, strlen(prefix), iri, strlen(iri));
+}
+
+static const char* lookupPrefix(Parser* parser, const char* prefix) {
+    const PrefixEntry* entry = prefixMapGet(&parser->prefixes, prefix, strlen(prefix));
+    return entry ? entry->iri : NULL;
+}
+
+/* Prefix map implementation */
+
+static uint64_t hashPrefix(const char* prefix, size_t length) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)prefix[i];
+        hash *= 0x100000001b3ULL;
     }
-    
-    /* Expand array if needed */
-    if (parser->prefix_count >= parser->prefix_capacity) {
-        parser->prefix_capacity *= 2;
-        parser->prefixes = realloc(parser->prefixes, 
-                                  parser->prefix_capacity * sizeof(parser->prefixes[0]));
+    return hash;
+}
+
+static bool prefixMapInit(PrefixMap* map, size_t capacity) {
+    map->count = 0;
+    map->capacity = capacity;
+    map->entries = (PrefixEntry*)calloc(capacity, sizeof(PrefixEntry));
+    return map->entries != NULL;
+}
+
+static void prefixMapDestroy(PrefixMap* map) {
+    for (size_t i = 0; i < map->capacity; i++) {
+        free(map->entries[i].prefix);
+        free(map->entries[i].iri);
     }
-    
-    /* Add new prefix */
-    parser->prefixes[parser->prefix_count].prefix = copyString(parser, prefix);
-    parser->prefixes[parser->prefix_count].iri = copyString(parser, iri);
-    parser->prefix_count++;
+    free(map->entries);
+    map->entries = NULL;
+    map->capacity = map->count = 0;
 }
 
-static const char* lookupPrefix(Parser* parser, const char* prefix) {
-    for (size_t i = 0; i < parser->prefix_count; i++) {
-        if (strcmp(parser->prefixes[i].prefix, prefix) == 0) {
-            return parser->prefixes[i].iri;
+/* Slot holding prefix, or the empty slot where it belongs */
+static PrefixEntry* prefixMapSlot(const PrefixMap* map, const char* prefix,
+                                  size_t prefix_length, uint64_t hash) {
+    size_t mask = map->capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        PrefixEntry* entry = &map->entries[i];
+        if (!entry->prefix) return entry;
+        if (entry->hash == hash && entry->prefix_length == prefix_length &&
+            memcmp(entry->prefix, prefix, prefix_length) == 0) {
+            return entry;
         }
     }
-    return NULL;
+}
+
+static bool prefixMapPut(PrefixMap* map, const char* prefix, size_t prefix_length,
+                         const char* iri, size_t iri_length) {
+    if (!map->entries) return false;
+    
+    /* Keep load factor under 1/2 */
+    if ((map->count + 1) * 2 > map->capacity) {
+        PrefixMap grown;
+        if (!prefixMapInit(&grown, map->capacity * 2)) return false;
+        for (size_t i = 0; i < map->capacity; i++) {
+            PrefixEntry* entry = &map->entries[i];
+            if (entry->prefix) {
+                *prefixMapSlot(&grown, entry->prefix, entry->prefix_length, entry->hash) = *entry;
+                grown.count++;
+            }
+        }
+        free(map->entries);
+        *map = grown;
+    }
+    
+    char* iri_copy = (char*)malloc(iri_length + 1);
+    if (!iri_copy) return false;
+    memcpy(iri_copy, iri, iri_length);
+    iri_copy[iri_length] = '\0';
+    
+    uint64_t hash = hashPrefix(prefix, prefix_length);
+    PrefixEntry* entry = prefixMapSlot(map, prefix, prefix_length, hash);
+    if (entry->prefix) {
+        /* Redefinition */
+        free(entry->iri);
+    } else {
+        entry->prefix = (char*)malloc(prefix_length + 1);
+        if (!entry->prefix) {
+            free(iri_copy);
+            return false;
+        }
+        memcpy(entry->prefix, prefix, prefix_length);
+        entry->prefix[prefix_length] = '\0';
+        entry->prefix_length = prefix_length;
+        entry->hash = hash;
+        map->count++;
+    }
+    entry->iri = iri_copy;
+    entry->iri_length = iri_length;
+    return true;
+}
+
+static const PrefixEntry* prefixMapGet(const PrefixMap* map, const char* prefix, size_t prefix_length) {
+    if (!map->entries) return NULL;
+    const PrefixEntry* entry = prefixMapSlot(map, prefix, prefix_length,
+                                             hashPrefix(prefix, prefix_length));
+    return entry->prefix ? entry : NULL;
 }
 
 static char* resolveIRI(Parser* parser, const char* iri) {
@@ -1139,14 +1222,602 @@ ParserOptions ttl_parser_default_options(void) {
 
 /* Streaming parser implementation */
 
+#define STREAM_BATCH_SIZE   256              /* Triples per on_triples call */
+#define STREAM_ARENA_BLOCK  (64 * 1024)      /* Arena block size */
+#define STREAM_ARENA_FLUSH  (1024 * 1024)    /* Flush once terms use this much */
+
+#define RDF_NS  "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+#define XSD_NS  "http://www.w3.org/2001/XMLSchema#"
+
+/* Bump arena; reset keeps the blocks for reuse */
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size;
+    size_t used;
+    char data[];
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* head;
+    ArenaBlock* current;
+    size_t used;                     /* Bytes handed out since reset */
+} StreamArena;
+
+/* Token of the statement being collected, value decoded into the arena */
+typedef struct {
+    TokenType type;
+    const char* text;
+    size_t length;
+    size_t line;
+    size_t column;
+} StreamToken;
+
+/* Term while expanding a statement */
+typedef struct {
+    const char* value;
+    TripleTermKind kind;
+    const char* datatype;
+    const char* lang;
+} StreamTerm;
+
 struct StreamingParser {
-    Parser* parser;
     StreamingCallbacks callbacks;
-    bool in_triple;
-    char* current_subject;
-    char* current_predicate;
+    ParserOptions options;
+    Lexer* lexer;
+    PrefixMap prefixes;
+    char* base_iri;
+    const StreamingParser* shared;   /* Read-only prologue (prefixes, base) */
+    uint64_t blank_node_scope;       /* Keeps generated labels unique per fork */
+    size_t line_offset;              /* Added to lexer lines in errors */
+    
+    /* Statement in progress: tokens up to the terminating top-level '.' */
+    StreamToken* tokens;
+    size_t token_count;
+    size_t token_capacity;
+    size_t depth;                    /* Open '[' and '(' */
+    size_t cursor;                   /* Parse position in tokens */
+    StreamArena token_arena;         /* Reset per statement */
+    
+    /* Pending triples; their strings live in term_arena */
+    StreamingTriple batch[STREAM_BATCH_SIZE];
+    size_t batch_count;
+    StreamArena term_arena;          /* Reset once the batch is delivered */
+    
+    uint64_t blank_node_counter;
+    size_t error_count;
+    ParserStats stats;
+    clock_t start_time;
 };
 
+static char* arenaAlloc(StreamArena* arena, size_t size) {
+    ArenaBlock* block = arena->current;
+    while (block && block->size - block->used < size) {
+        /* Later blocks are stale from before the last reset */
+        block = block->next;
+        if (block) block->used = 0;
+    }
+    
+    if (!block) {
+        size_t block_size = size > STREAM_ARENA_BLOCK ? size : STREAM_ARENA_BLOCK;
+        block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + block_size);
+        if (!block) return NULL;
+        block->size = block_size;
+        block->used = 0;
+        block->next = NULL;
+        if (arena->current) {
+            ArenaBlock* tail = arena->current;
+            while (tail->next) tail = tail->next;
+            tail->next = block;
+        } else {
+            arena->head = block;
+        }
+    }
+    
+    arena->current = block;
+    char* memory = block->data + block->used;
+    block->used += size;
+    arena->used += size;
+    return memory;
+}
+
+static void arenaReset(StreamArena* arena) {
+    arena->current = arena->head;
+    if (arena->head) arena->head->used = 0;
+    arena->used = 0;
+}
+
+static void arenaDestroy(StreamArena* arena) {
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = arena->current = NULL;
+    arena->used = 0;
+}
+
+/* Concatenate up to two strings into the term arena */
+static const char* streamConcat(StreamingParser* sp, const char* a, size_t a_length,
+                                const char* b, size_t b_length) {
+    char* out = arenaAlloc(&sp->term_arena, a_length + b_length + 1);
+    if (!out) return NULL;
+    memcpy(out, a, a_length);
+    if (b_length) memcpy(out + a_length, b, b_length);
+    out[a_length + b_length] = '\0';
+    return out;
+}
+
+static void streamError(StreamingParser* sp, const StreamToken* token, const char* message) {
+    sp->error_count++;
+    sp->stats.errors_recovered++;
+    if (!sp->callbacks.on_error) return;
+    
+    ParseError error = {
+        .line = token ? (int)(token->line + sp->line_offset) : 0,
+        .column = token ? (int)token->column : 0,
+        .message = (char*)message,
+        .severity = ERROR_SEVERITY_ERROR
+    };
+    sp->callbacks.on_error(sp->callbacks.user_data, &error);
+}
+
+/* Deliver pending triples; terms are released only between statements */
+static void streamFlush(StreamingParser* sp, bool release_terms) {
+    if (sp->batch_count > 0) {
+        if (sp->callbacks.on_triples) {
+            sp->callbacks.on_triples(sp->callbacks.user_data, sp->batch, sp->batch_count);
+        }
+        if (sp->callbacks.on_triple) {
+            for (size_t i = 0; i < sp->batch_count; i++) {
+                sp->callbacks.on_triple(sp->callbacks.user_data, sp->batch[i].subject,
+                                        sp->batch[i].predicate, sp->batch[i].object);
+            }
+        }
+        sp->batch_count = 0;
+    }
+    if (release_terms) arenaReset(&sp->term_arena);
+}
+
+static void streamEmit(StreamingParser* sp, const StreamTerm* subject,
+                       const char* predicate, const StreamTerm* object) {
+    if (sp->batch_count == STREAM_BATCH_SIZE) {
+        /* Mid-statement: subject/predicate strings are still in use */
+        streamFlush(sp, false);
+    }
+    
+    sp->batch[sp->batch_count++] = (StreamingTriple){
+        .subject = subject->value,
+        .predicate = predicate,
+        .object = object->value,
+        .datatype = object->datatype,
+        .lang = object->lang,
+        .subject_kind = subject->kind,
+        .object_kind = object->kind
+    };
+    sp->stats.triples_parsed++;
+}
+
+static const StreamToken* streamPeek(StreamingParser* sp) {
+    return sp->cursor < sp->token_count ? &sp->tokens[sp->cursor] : NULL;
+}
+
+static bool streamCheck(StreamingParser* sp, TokenType type) {
+    const StreamToken* token = streamPeek(sp);
+    return token && token->type == type;
+}
+
+static bool streamMatch(StreamingParser* sp, TokenType type) {
+    if (!streamCheck(sp, type)) return false;
+    sp->cursor++;
+    return true;
+}
+
+/* Token for error positions: current, else the last one */
+static const StreamToken* streamErrorToken(StreamingParser* sp) {
+    const StreamToken* token = streamPeek(sp);
+    return token ? token : (sp->token_count ? &sp->tokens[sp->token_count - 1] : NULL);
+}
+
+static bool hasScheme(const char* iri, size_t length) {
+    if (length == 0 || !isalpha((unsigned char)iri[0])) return false;
+    for (size_t i = 1; i < length; i++) {
+        char ch = iri[i];
+        if (ch == ':') return true;
+        if (!isalnum((unsigned char)ch) && ch != '+' && ch != '-' && ch != '.') return false;
+    }
+    return false;
+}
+
+/* Resolve an IRIREF against @base (no dot-segment removal) */
+static const char* streamResolve(StreamingParser* sp, const char* iri, size_t length) {
+    const char* base = sp->base_iri;
+    if (!base && sp->shared) base = sp->shared->base_iri;
+    if (!base || hasScheme(iri, length)) return streamConcat(sp, iri, length, NULL, 0);
+    
+    size_t base_length = strlen(base);
+    size_t keep = base_length;
+    if (length == 0) {
+        return streamConcat(sp, base, base_length, NULL, 0);
+    } else if (iri[0] == '#') {
+        const char* hash = strchr(base, '#');
+        if (hash) keep = (size_t)(hash - base);
+    } else if (iri[0] == '/' && length > 1 && iri[1] == '/') {
+        /* Network-path reference: keep the scheme */
+        const char* colon = strchr(base, ':');
+        keep = colon ? (size_t)(colon - base) + 1 : 0;
+    } else if (iri[0] == '/') {
+        /* Absolute path: keep scheme://authority */
+        const char* authority = strstr(base, "//");
+        const char* path = authority ? strchr(authority + 2, '/') : strchr(base, '/');
+        if (path) keep = (size_t)(path - base);
+    } else {
+        /* Relative path: replace the last segment */
+        const char* slash = strrchr(base, '/');
+        if (slash) keep = (size_t)(slash - base) + 1;
+    }
+    return streamConcat(sp, base, keep, iri, length);
+}
+
+static const char* streamFreshBlankNode(StreamingParser* sp) {
+    char label[48];
+    int length;
+    if (sp->blank_node_scope) {
+        length = snprintf(label, sizeof(label), "_:genid%llu_%llu",
+                          (unsigned long long)sp->blank_node_scope,
+                          (unsigned long long)++sp->blank_node_counter);
+    } else {
+        length = snprintf(label, sizeof(label), "_:genid%llu",
+                          (unsigned long long)++sp->blank_node_counter);
+    }
+    return streamConcat(sp, label, (size_t)length, NULL, 0);
+}
+
+/* iri ::= IRIREF | PrefixedName */
+static bool streamIRI(StreamingParser* sp, const char** out) {
+    const StreamToken* token = streamPeek(sp);
+    if (token && token->type == TOKEN_IRI_REF) {
+        sp->cursor++;
+        *out = streamResolve(sp, token->text, token->length);
+        return *out != NULL;
+    }
+    if (token && token->type == TOKEN_PREFIXED_NAME) {
+        sp->cursor++;
+        const char* colon = memchr(token->text, ':', token->length);
+        size_t prefix_length = colon ? (size_t)(colon - token->text) : token->length;
+        const PrefixEntry* entry = prefixMapGet(&sp->prefixes, token->text, prefix_length);
+        if (!entry && sp->shared) {
+            entry = prefixMapGet(&sp->shared->prefixes, token->text, prefix_length);
+        }
+        if (!colon || !entry) {
+            streamError(sp, token, "Undefined prefix");
+            return false;
+        }
+        *out = streamConcat(sp, entry->iri, entry->iri_length,
+                            colon + 1, token->length - prefix_length - 1);
+        return *out != NULL;
+    }
+    streamError(sp, streamErrorToken(sp), "Expected IRI or prefixed name");
+    return false;
+}
+
+static bool streamObject(StreamingParser* sp, StreamTerm* out);
+static bool streamPredicateObjectList(StreamingParser* sp, const StreamTerm* subject);
+
+/* collection ::= '(' object* ')' as an rdf:first/rdf:rest chain */
+static bool streamCollection(StreamingParser* sp, StreamTerm* out) {
+    sp->cursor++; /* '(' */
+    
+    StreamTerm head = {.value = RDF_NS "nil", .kind = TRIPLE_TERM_IRI};
+    StreamTerm previous = head;
+    bool first = true;
+    
+    while (!streamCheck(sp, TOKEN_CLOSE_PAREN)) {
+        if (!streamPeek(sp)) {
+            streamError(sp, streamErrorToken(sp), "Expected ')' after collection");
+            return false;
+        }
+        
+        StreamTerm node = {.value = streamFreshBlankNode(sp), .kind = TRIPLE_TERM_BLANK_NODE};
+        if (!node.value) return false;
+        if (first) {
+            head = node;
+            first = false;
+        } else {
+            streamEmit(sp, &previous, RDF_NS "rest", &node);
+        }
+        
+        StreamTerm item;
+        if (!streamObject(sp, &item)) return false;
+        streamEmit(sp, &node, RDF_NS "first", &item);
+        previous = node;
+    }
+    sp->cursor++; /* ')' */
+    
+    if (!first) {
+        StreamTerm nil = {.value = RDF_NS "nil", .kind = TRIPLE_TERM_IRI};
+        streamEmit(sp, &previous, RDF_NS "rest", &nil);
+    }
+    *out = head;
+    return true;
+}
+
+/* blankNodePropertyList ::= '[' predicateObjectList ']' */
+static bool streamBlankNodePropertyList(StreamingParser* sp, StreamTerm* out) {
+    sp->cursor++; /* '[' */
+    
+    out->value = streamFreshBlankNode(sp);
+    out->kind = TRIPLE_TERM_BLANK_NODE;
+    out->datatype = out->lang = NULL;
+    if (!out->value) return false;
+    
+    if (!streamPredicateObjectList(sp, out)) return false;
+    if (!streamMatch(sp, TOKEN_CLOSE_BRACKET)) {
+        streamError(sp, streamErrorToken(sp), "Expected ']' after property list");
+        return false;
+    }
+    return true;
+}
+
+/* iri | BlankNode | collection (subjects and objects) */
+static bool streamNode(StreamingParser* sp, StreamTerm* out) {
+    const StreamToken* token = streamPeek(sp);
+    out->datatype = out->lang = NULL;
+    
+    switch (token ? token->type : TOKEN_EOF) {
+        case TOKEN_IRI_REF:
+        case TOKEN_PREFIXED_NAME:
+            out->kind = TRIPLE_TERM_IRI;
+            return streamIRI(sp, &out->value);
+        case TOKEN_BLANK_NODE_LABEL:
+            sp->cursor++;
+            out->kind = TRIPLE_TERM_BLANK_NODE;
+            out->value = streamConcat(sp, "_:", 2, token->text, token->length);
+            return out->value != NULL;
+        case TOKEN_ANON:
+            sp->cursor++;
+            out->kind = TRIPLE_TERM_BLANK_NODE;
+            out->value = streamFreshBlankNode(sp);
+            return out->value != NULL;
+        case TOKEN_OPEN_PAREN:
+            return streamCollection(sp, out);
+        default:
+            return false;
+    }
+}
+
+/* object ::= iri | BlankNode | collection | blankNodePropertyList | literal */
+static bool streamObject(StreamingParser* sp, StreamTerm* out) {
+    const StreamToken* token = streamPeek(sp);
+    TokenType type = token ? token->type : TOKEN_EOF;
+    
+    if (type == TOKEN_OPEN_BRACKET) return streamBlankNodePropertyList(sp, out);
+    if (type == TOKEN_IRI_REF || type == TOKEN_PREFIXED_NAME || type == TOKEN_BLANK_NODE_LABEL ||
+        type == TOKEN_ANON || type == TOKEN_OPEN_PAREN) {
+        return streamNode(sp, out);
+    }
+    
+    out->kind = TRIPLE_TERM_LITERAL;
+    out->datatype = out->lang = NULL;
+    switch (type) {
+        case TOKEN_INTEGER: out->datatype = XSD_NS "integer"; break;
+        case TOKEN_DECIMAL: out->datatype = XSD_NS "decimal"; break;
+        case TOKEN_DOUBLE:  out->datatype = XSD_NS "double"; break;
+        case TOKEN_BOOLEAN: out->datatype = XSD_NS "boolean"; break;
+        case TOKEN_STRING_LITERAL_QUOTE:
+        case TOKEN_STRING_LITERAL_SINGLE_QUOTE:
+        case TOKEN_STRING_LITERAL_LONG_QUOTE:
+        case TOKEN_STRING_LITERAL_LONG_SINGLE_QUOTE:
+            break;
+        default:
+            streamError(sp, streamErrorToken(sp), "Expected object");
+            return false;
+    }
+    
+    sp->cursor++;
+    out->value = streamConcat(sp, token->text, token->length, NULL, 0);
+    if (!out->value) return false;
+    if (out->datatype) return true;
+    
+    /* RDFLiteral ::= String (LANGTAG | '^^' iri)? */
+    const StreamToken* suffix = streamPeek(sp);
+    if (suffix && suffix->type == TOKEN_AT) {
+        sp->cursor++;
+        if (suffix->length == 0) {
+            streamError(sp, suffix, "Expected language tag after '@'");
+            return false;
+        }
+        out->lang = streamConcat(sp, suffix->text, suffix->length, NULL, 0);
+        return out->lang != NULL;
+    }
+    if (streamMatch(sp, TOKEN_DOUBLE_CARET)) {
+        return streamIRI(sp, &out->datatype);
+    }
+    return true;
+}
+
+/* predicateObjectList ::= verb objectList (';' (verb objectList)?)* */
+static bool streamPredicateObjectList(StreamingParser* sp, const StreamTerm* subject) {
+    do {
+        /* Trailing ';' */
+        if (!streamPeek(sp) || streamCheck(sp, TOKEN_DOT) || streamCheck(sp, TOKEN_CLOSE_BRACKET)) {
+            break;
+        }
+        
+        const char* predicate;
+        if (streamMatch(sp, TOKEN_A)) {
+            predicate = RDF_NS "type";
+        } else if (!streamIRI(sp, &predicate)) {
+            return false;
+        }
+        
+        do {
+            StreamTerm object;
+            if (!streamObject(sp, &object)) return false;
+            streamEmit(sp, subject, predicate, &object);
+        } while (streamMatch(sp, TOKEN_COMMA));
+    } while (streamMatch(sp, TOKEN_SEMICOLON));
+    
+    return true;
+}
+
+/* triples ::= subject predicateObjectList | blankNodePropertyList predicateObjectList? */
+static bool streamTriples(StreamingParser* sp) {
+    StreamTerm subject;
+    size_t errors = sp->error_count;
+    if (streamCheck(sp, TOKEN_OPEN_BRACKET)) {
+        if (!streamBlankNodePropertyList(sp, &subject)) return false;
+        if (streamCheck(sp, TOKEN_DOT)) return true;
+    } else if (!streamNode(sp, &subject)) {
+        if (sp->error_count == errors) {
+            streamError(sp, streamErrorToken(sp), "Expected subject (IRI, blank node, or collection)");
+        }
+        return false;
+    }
+    return streamPredicateObjectList(sp, &subject);
+}
+
+/* prefixID ::= '@prefix' PNAME_NS IRIREF '.' */
+static bool streamPrefixID(StreamingParser* sp) {
+    const StreamToken* name = streamPeek(sp);
+    if (!name || name->type != TOKEN_PREFIXED_NAME || name->length == 0 ||
+        name->text[name->length - 1] != ':') {
+        streamError(sp, streamErrorToken(sp), "Expected prefix name after @prefix");
+        return false;
+    }
+    sp->cursor++;
+    
+    const StreamToken* iri = streamPeek(sp);
+    if (!iri || iri->type != TOKEN_IRI_REF) {
+        streamError(sp, streamErrorToken(sp), "Expected IRI in prefix declaration");
+        return false;
+    }
+    sp->cursor++;
+    
+    const char* resolved = streamResolve(sp, iri->text, iri->length);
+    if (!resolved || !prefixMapPut(&sp->prefixes, name->text, name->length - 1,
+                                   resolved, strlen(resolved))) {
+        return false;
+    }
+    if (sp->callbacks.on_prefix) {
+        const PrefixEntry* entry = prefixMapGet(&sp->prefixes, name->text, name->length - 1);
+        sp->callbacks.on_prefix(sp->callbacks.user_data, entry->prefix, entry->iri);
+    }
+    return true;
+}
+
+/* base ::= '@base' IRIREF '.' */
+static bool streamBase(StreamingParser* sp) {
+    const StreamToken* iri = streamPeek(sp);
+    if (!iri || iri->type != TOKEN_IRI_REF) {
+        streamError(sp, streamErrorToken(sp), "Expected IRI in base declaration");
+        return false;
+    }
+    sp->cursor++;
+    
+    const char* resolved = streamResolve(sp, iri->text, iri->length);
+    char* base = resolved ? strdup(resolved) : NULL;
+    if (!base) return false;
+    free(sp->base_iri);
+    sp->base_iri = base;
+    
+    if (sp->callbacks.on_base) {
+        sp->callbacks.on_base(sp->callbacks.user_data, sp->base_iri);
+    }
+    return true;
+}
+
+/* statement ::= directive | triples '.' over the collected tokens */
+static void streamStatement(StreamingParser* sp) {
+    sp->cursor = 0;
+    
+    bool ok;
+    if (streamMatch(sp, TOKEN_PREFIX)) {
+        ok = streamPrefixID(sp);
+    } else if (streamMatch(sp, TOKEN_BASE)) {
+        ok = streamBase(sp);
+    } else {
+        ok = streamTriples(sp);
+    }
+    
+    if (ok && !streamMatch(sp, TOKEN_DOT)) {
+        streamError(sp, streamErrorToken(sp), "Expected '.' after statement");
+        ok = false;
+    }
+    if (ok && sp->cursor < sp->token_count) {
+        streamError(sp, streamErrorToken(sp), "Unexpected token after '.'");
+    }
+    if (ok) sp->stats.statements_parsed++;
+    
+    /* Statement done: nothing refers to its tokens any more */
+    sp->token_count = 0;
+    sp->depth = 0;
+    arenaReset(&sp->token_arena);
+    lexer_clear_errors(sp->lexer);
+    
+    if (sp->batch_count >= STREAM_BATCH_SIZE / 2 || sp->term_arena.used >= STREAM_ARENA_FLUSH) {
+        streamFlush(sp, true);
+    }
+}
+
+/* Collect tokens from the lexer, parsing each statement as its '.' arrives */
+static bool streamDrain(StreamingParser* sp) {
+    TokenSlice slice;
+    while (lexer_next_slice(sp->lexer, &slice)) {
+        if (slice.type == TOKEN_EOF) {
+            if (sp->token_count > 0) streamStatement(sp);
+            break;
+        }
+        sp->stats.tokens_consumed++;
+        if (slice.type == TOKEN_COMMENT) continue;
+        
+        /* A directive inside an unterminated statement: recover there */
+        if ((slice.type == TOKEN_PREFIX || slice.type == TOKEN_BASE) && sp->token_count > 0) {
+            streamStatement(sp);
+        }
+        
+        if (sp->token_count == sp->token_capacity) {
+            size_t capacity = sp->token_capacity ? sp->token_capacity * 2 : 64;
+            StreamToken* grown = (StreamToken*)realloc(sp->tokens, capacity * sizeof(StreamToken));
+            if (!grown) return false;
+            sp->tokens = grown;
+            sp->token_capacity = capacity;
+        }
+        
+        char* text = arenaAlloc(&sp->token_arena, slice.length + 1);
+        size_t length = 0;
+        if (!text || !lexer_slice_decode(sp->lexer, &slice, text, &length)) return false;
+        sp->tokens[sp->token_count++] = (StreamToken){
+            .type = slice.type,
+            .text = text,
+            .length = length,
+            .line = slice.line,
+            .column = slice.column
+        };
+        
+        switch (slice.type) {
+            case TOKEN_OPEN_BRACKET:
+            case TOKEN_OPEN_PAREN:
+                sp->depth++;
+                break;
+            case TOKEN_CLOSE_BRACKET:
+            case TOKEN_CLOSE_PAREN:
+                if (sp->depth > 0) sp->depth--;
+                break;
+            case TOKEN_DOT:
+                if (sp->depth == 0) streamStatement(sp);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    /* Hand over everything parsed from this chunk */
+    streamFlush(sp, true);
+    sp->stats.parse_time_ms = ((double)(clock() - sp->start_time) / CLOCKS_PER_SEC) * 1000.0;
+    return true;
+}
+
 StreamingParser* ttl_streaming_parser_create(const StreamingCallbacks* callbacks, 
                                              const ParserOptions* options) {
     if (!callbacks) return NULL;
@@ -1155,13 +1826,19 @@ StreamingParser* ttl_streaming_parser_create(const StreamingCallbacks* callbacks
     if (!sp) return NULL;
     
     sp->callbacks = *callbacks;
+    sp->options = options ? *options : ttl_parser_default_options();
+    sp->start_time = clock();
     
-    /* Create parser with empty input initially */
-    sp->parser = ttl_parser_create("", 0, options);
-    if (!sp->parser) {
-        free(sp);
+    sp->lexer = lexer_create(NULL);
+    if (!sp->lexer || !prefixMapInit(&sp->prefixes, 16)) {
+        ttl_streaming_parser_destroy(sp);
         return NULL;
     }
+    lexer_init(sp->lexer, "", 0);
+    
+    if (sp->options.base_iri) {
+        sp->base_iri = strdup(sp->options.base_iri);
+    }
     
     return sp;
 }
@@ -1171,28 +1848,68 @@ bool ttl_streaming_parser_feed(StreamingParser* parser,
                               size_t length) {
     if (!parser || !data) return false;
     
-    /* Feed data to lexer */
-    return lexer_feed(parser->parser->lexer, data, length);
+    if (!lexer_feed(parser->lexer, data, length)) return false;
+    return streamDrain(parser);
+}
+
+StreamingParser* ttl_streaming_parser_fork(const StreamingParser* prologue,
+                                           const StreamingCallbacks* callbacks,
+                                           uint64_t blank_node_scope) {
+    if (!prologue) return NULL;
+    
+    StreamingParser* sp = ttl_streaming_parser_create(callbacks, &prologue->options);
+    if (!sp) return NULL;
+    
+    /* The prologue's base is found through shared */
+    free(sp->base_iri);
+    sp->base_iri = NULL;
+    sp->shared = prologue;
+    sp->blank_node_scope = blank_node_scope;
+    return sp;
+}
+
+bool ttl_streaming_parser_parse_region(StreamingParser* parser, const char* data,
+                                       size_t length, size_t first_line) {
+    if (!parser || !data) return false;
+    if (length == 0) return true;
+    
+    /* Lex the caller's bytes in place */
+    lexer_init(parser->lexer, data, length);
+    parser->line_offset = first_line - 1;
+    bool ok = streamDrain(parser);
+    streamFlush(parser, true);
+    parser->line_offset = 0;
+    return ok;
 }
 
 void ttl_streaming_parser_end(StreamingParser* parser) {
     if (!parser) return;
     
-    lexer_end_input(parser->parser->lexer);
+    lexer_end_input(parser->lexer);
     
-    /* Parse any remaining data */
-    ttl_parser_parse(parser->parser);
+    /* Parse the final statement, if any */
+    streamDrain(parser);
+    streamFlush(parser, true);
 }
 
 void ttl_streaming_parser_destroy(StreamingParser* parser) {
     if (!parser) return;
     
-    ttl_parser_destroy(parser->parser);
-    free(parser->current_subject);
-    free(parser->current_predicate);
+    lexer_destroy(parser->lexer);
+    if (parser->prefixes.entries) prefixMapDestroy(&parser->prefixes);
+    free(parser->base_iri);
+    free(parser->tokens);
+    arenaDestroy(&parser->token_arena);
+    arenaDestroy(&parser->term_arena);
     free(parser);
 }
 
+void ttl_streaming_parser_get_stats(const StreamingParser* parser, ParserStats* stats) {
+    if (parser && stats) {
+        *stats = parser->stats;
+    }
+}
+
 /* Utility functions */
 
 bool ttl_validate_syntax(const char* input, size_t length,
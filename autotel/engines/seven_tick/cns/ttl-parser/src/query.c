@@ -3,35 +3,103 @@
  * @brief Simple triple query engine implementation
  * @author CNS Seven-Tick Engine
  * @date 2024
- * 
+ *
  * Implements 80/20 query functionality focusing on basic triple pattern matching.
- * Uses the AST visitor pattern to efficiently scan for matching triples.
+ * The document is walked once when the engine is created: every term is
+ * interned to a 32-bit id and the distinct triples are kept sorted in SPO,
+ * POS and OSP order. A pattern is answered with a binary-searched range scan
+ * over the index whose prefix covers its bound positions; multi-pattern
+ * queries are joined on shared variables over ids, and strings are only
+ * materialized for the final rows.
+ *
+ * Terms are keyed on kind, lexical form and datatype or language tag, so the
+ * IRI ex:b and the literal "ex:b" are different terms. Fixed pattern terms
+ * use Turtle syntax: "Bob Smith", "chat"@en, "42"^^xsd:integer, 42, true.
  */
 
 #include "query.h"
 #include "visitor.h"
+#include "lexer.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <ctype.h>
 #include <regex.h>
 
-/* Internal structures for query processing */
+#define TTL_QUERY_UNBOUND UINT32_MAX
+#define TTL_QUERY_XSD "http://www.w3.org/2001/XMLSchema#"
+
+typedef enum {
+    TTL_QUERY_TERM_IRI,
+    TTL_QUERY_TERM_BLANK,
+    TTL_QUERY_TERM_LITERAL
+} ttl_query_term_kind_t;
+
+/* Dictionary key; the qualifier is "@lang" or "^^datatype" for literals */
+typedef struct {
+    ttl_query_term_kind_t kind;
+    char *lexical;
+    char *qualifier;
+} ttl_query_term_t;
+
+/* Triple of term ids, in the order of the index holding it */
 typedef struct {
-    ttl_query_engine_t *engine;
-    ttl_query_pattern_t *pattern;
-    ttl_query_result_t *result;
-    size_t matches_found;
-} query_visitor_context_t;
+    uint32_t a, b, c;
+} ttl_query_key_t;
+
+typedef enum {
+    TTL_INDEX_SPO,
+    TTL_INDEX_POS,
+    TTL_INDEX_OSP,
+    TTL_INDEX_COUNT
+} ttl_query_index_order_t;
+
+/* Interned triple table */
+struct ttl_query_index {
+    /* Term dictionary: id -> term and first AST node, term -> id by hash */
+    ttl_query_term_t *terms;
+    ttl_ast_node_t **nodes;
+    size_t term_count;
+    size_t term_capacity;
+    uint32_t *slots;              /* Open addressing, id + 1 (0 = empty) */
+    size_t slot_count;
+    uint32_t anonymous_count;     /* Labels handed to [ ... ] nodes */
+    
+    /* Distinct triples, sorted, one permutation per index */
+    ttl_query_key_t *keys[TTL_INDEX_COUNT];
+    size_t count;
+    size_t capacity;
+};
+
+/* Pattern position compiled against the dictionary */
+typedef struct {
+    int variable;                 /* Result column, or -1 */
+    uint32_t id;                  /* Fixed term id (TTL_QUERY_UNBOUND if none) */
+} ttl_query_slot_t;
+
+typedef struct {
+    ttl_query_slot_t slots[3];    /* Subject, predicate, object */
+    size_t estimate;              /* Matches using fixed terms only */
+    bool done;
+} ttl_query_step_t;
+
+/* Growable table of id rows */
+typedef struct {
+    uint32_t *ids;
+    size_t width;
+    size_t count;
+    size_t capacity;
+} ttl_query_rows_t;
 
 /* Helper functions */
 static char* ttl_string_duplicate(const char *str);
-static bool ttl_pattern_element_matches(const ttl_pattern_element_t *element, ttl_ast_node_t *node);
 static char* ttl_ast_node_to_string(ttl_ast_node_t *node);
+static bool ttl_query_term_from_node(ttl_ast_node_t *node, ttl_query_term_t *term);
+static bool ttl_query_term_parse(const char *text, ttl_query_term_t *term);
 static bool ttl_is_variable(const char *str);
 static ttl_pattern_element_t ttl_parse_pattern_element(const char *str);
-static void ttl_collect_triples_visitor(ttl_ast_node_t *node, void *user_data);
-static bool ttl_query_triple_visitor(ttl_ast_visitor_t *visitor, ttl_ast_node_t *node);
+static uint32_t ttl_index_term(ttl_query_index_t *index, ttl_ast_node_t *node);
 static bool ttl_apply_filters(ttl_query_pattern_t *pattern, ttl_query_binding_t *bindings, size_t binding_count);
 static void ttl_add_binding_to_result(ttl_query_result_t *result, ttl_query_binding_t *bindings, size_t binding_count);
 
@@ -119,6 +187,12 @@ static char* ttl_ast_node_to_string(ttl_ast_node_t *node) {
             return ttl_string_duplicate(node->data.boolean_literal.value ? "true" : "false");
         }
         
+        case TTL_AST_TYPED_LITERAL:
+            return ttl_ast_node_to_string(node->data.typed_literal.value);
+            
+        case TTL_AST_LANG_LITERAL:
+            return ttl_ast_node_to_string(node->data.lang_literal.value);
+            
         case TTL_AST_BLANK_NODE: {
             if (node->data.blank_node.label) {
                 size_t len = strlen(node->data.blank_node.label) + 3; // +3 for "_:" and null terminator
@@ -144,183 +218,540 @@ static char* ttl_ast_node_to_string(ttl_ast_node_t *node) {
     }
 }
 
-/* Pattern matching functions */
-static bool ttl_pattern_element_matches(const ttl_pattern_element_t *element, ttl_ast_node_t *node) {
-    if (!element || !node) return false;
+/* Term keys */
+
+static char* ttl_string_concat(const char *prefix, const char *str) {
+    size_t prefix_len = strlen(prefix);
+    size_t len = strlen(str);
+    char *result = malloc(prefix_len + len + 1);
+    if (result) {
+        memcpy(result, prefix, prefix_len);
+        memcpy(result + prefix_len, str, len + 1);
+    }
+    return result;
+}
+
+/* Language tags compare case-insensitively */
+static char* ttl_query_lang_qualifier(const char *tag) {
+    char *qualifier = ttl_string_concat("@", tag);
+    if (qualifier) {
+        for (char *c = qualifier; *c; c++) *c = (char)tolower((unsigned char)*c);
+    }
+    return qualifier;
+}
+
+static void ttl_query_term_free(ttl_query_term_t *term) {
+    free(term->lexical);
+    free(term->qualifier);
+}
+
+/* Key for a document term; numbers and booleans carry their implied datatype */
+static bool ttl_query_term_from_node(ttl_ast_node_t *node, ttl_query_term_t *term) {
+    term->kind = TTL_QUERY_TERM_LITERAL;
+    term->lexical = ttl_ast_node_to_string(node);
+    term->qualifier = NULL;
     
-    switch (element->type) {
-        case TTL_PATTERN_WILDCARD:
-            return true;
-            
-        case TTL_PATTERN_VARIABLE:
-            return true; // Variables always match, binding happens later
-            
-        case TTL_PATTERN_FIXED: {
-            char *node_str = ttl_ast_node_to_string(node);
-            if (!node_str) return false;
-            
-            bool matches = strcmp(element->data.fixed_value, node_str) == 0;
-            free(node_str);
-            return matches;
+    switch (node->type) {
+        case TTL_AST_IRI:
+        case TTL_AST_PREFIXED_NAME:
+        case TTL_AST_RDF_TYPE:
+            term->kind = TTL_QUERY_TERM_IRI;
+            break;
+        case TTL_AST_BLANK_NODE:
+            term->kind = TTL_QUERY_TERM_BLANK;
+            break;
+        case TTL_AST_STRING_LITERAL:
+            break;
+        case TTL_AST_LANG_LITERAL:
+            term->qualifier = ttl_query_lang_qualifier(node->data.lang_literal.language_tag ?
+                                                       node->data.lang_literal.language_tag : "");
+            break;
+        case TTL_AST_TYPED_LITERAL: {
+            char *datatype = ttl_ast_node_to_string(node->data.typed_literal.datatype);
+            term->qualifier = datatype ? ttl_string_concat("^^", datatype) : NULL;
+            free(datatype);
+            break;
         }
-        
+        case TTL_AST_NUMERIC_LITERAL:
+            switch (node->data.numeric_literal.numeric_type) {
+                case TTL_NUMERIC_INTEGER:
+                    term->qualifier = ttl_string_duplicate("^^<" TTL_QUERY_XSD "integer>");
+                    break;
+                case TTL_NUMERIC_DECIMAL:
+                    term->qualifier = ttl_string_duplicate("^^<" TTL_QUERY_XSD "decimal>");
+                    break;
+                default:
+                    term->qualifier = ttl_string_duplicate("^^<" TTL_QUERY_XSD "double>");
+                    break;
+            }
+            break;
+        case TTL_AST_BOOLEAN_LITERAL:
+            term->qualifier = ttl_string_duplicate("^^<" TTL_QUERY_XSD "boolean>");
+            break;
         default:
-            return false;
+            break;
     }
+    
+    bool needs_qualifier = node->type == TTL_AST_LANG_LITERAL || node->type == TTL_AST_TYPED_LITERAL ||
+                           node->type == TTL_AST_NUMERIC_LITERAL || node->type == TTL_AST_BOOLEAN_LITERAL;
+    if (!term->lexical || (needs_qualifier && !term->qualifier)) {
+        ttl_query_term_free(term);
+        return false;
+    }
+    return true;
 }
 
-/* Triple collection visitor for indexing - FIXED for 80/20 */
-static void ttl_collect_triples_visitor(ttl_ast_node_t *node, void *user_data) {
-    ttl_query_engine_t *engine = (ttl_query_engine_t*)user_data;
-    
-    // Index all types of nodes that represent triples
-    if (node->type == TTL_AST_TRIPLE) {
-        // Resize array if needed
-        if (engine->triple_count >= 1000) { // Simple fixed limit for 80/20 implementation
-            return;
+/* End of the quoted string at text (escapes skipped), or NULL if unterminated */
+static const char* ttl_query_string_end(const char *text, size_t *delimiter) {
+    char quote = text[0];
+    *delimiter = (text[1] == quote && text[2] == quote) ? 3 : 1;
+    
+    for (const char *c = text + *delimiter; *c; c++) {
+        if (*c == '\\' && c[1]) {
+            c++;
+        } else if (*c == quote && (*delimiter == 1 || (c[1] == quote && c[2] == quote))) {
+            return c + *delimiter;
         }
-        
-        engine->triples[engine->triple_count++] = node;
     }
-    
-    // Also index statements in documents for direct access
-    if (node->type == TTL_AST_DOCUMENT) {
-        for (size_t i = 0; i < node->data.document.statement_count; i++) {
-            ttl_ast_node_t *stmt = node->data.document.statements[i];
-            if (stmt && stmt->type == TTL_AST_TRIPLE && engine->triple_count < 1000) {
-                engine->triples[engine->triple_count++] = stmt;
+    return NULL;
+}
+
+/* Key for a fixed pattern term written in Turtle syntax */
+static bool ttl_query_term_parse(const char *text, ttl_query_term_t *term) {
+    term->lexical = NULL;
+    term->qualifier = NULL;
+    
+    if (text[0] == '"' || text[0] == '\'') {
+        size_t delimiter;
+        const char *end = ttl_query_string_end(text, &delimiter);
+        if (!end) return false;
+    
+        // Escapes are decoded as the lexer does for document strings
+        size_t length = (size_t)(end - text) - 2 * delimiter;
+        size_t lexical_length = 0;
+        term->kind = TTL_QUERY_TERM_LITERAL;
+        term->lexical = malloc(length + 1);
+        bool ok = term->lexical &&
+                  lexer_unescape_string(text + delimiter, length, term->lexical, &lexical_length);
+        if (ok) {
+            term->lexical[lexical_length] = '\0';
+            if (end[0] == '@' && end[1]) {
+                term->qualifier = ttl_query_lang_qualifier(end + 1);
+            } else if (end[0] == '^' && end[1] == '^' && end[2]) {
+                term->qualifier = ttl_string_duplicate(end);
             }
+            ok = end[0] == '\0' || term->qualifier;
+        }
+        if (!ok) ttl_query_term_free(term);
+        return ok;
+    }
+    
+    const char *datatype = NULL;
+    if (strcmp(text, "true") == 0 || strcmp(text, "false") == 0) {
+        datatype = "^^<" TTL_QUERY_XSD "boolean>";
+    } else if (isdigit((unsigned char)text[0]) ||
+               ((text[0] == '+' || text[0] == '-' || text[0] == '.') && text[1])) {
+        datatype = strpbrk(text, "eE") ? "^^<" TTL_QUERY_XSD "double>" :
+                   strchr(text, '.') ? "^^<" TTL_QUERY_XSD "decimal>" :
+                                       "^^<" TTL_QUERY_XSD "integer>";
+    }
+    
+    if (datatype) {
+        term->kind = TTL_QUERY_TERM_LITERAL;
+        term->qualifier = ttl_string_duplicate(datatype);
+    } else {
+        term->kind = strncmp(text, "_:", 2) == 0 ? TTL_QUERY_TERM_BLANK : TTL_QUERY_TERM_IRI;
+    }
+    term->lexical = ttl_string_duplicate(text);
+    if (!term->lexical || (datatype && !term->qualifier)) {
+        ttl_query_term_free(term);
+        return false;
+    }
+    return true;
+}
+
+/* Term dictionary */
+
+static uint64_t ttl_query_hash(const ttl_query_term_t *term) {
+    uint64_t hash = 1469598103934665603ULL;  /* FNV-1a over kind, lexical, qualifier */
+    hash ^= (uint64_t)term->kind;
+    hash *= 1099511628211ULL;
+    for (const char *c = term->lexical; *c; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 1099511628211ULL;
+    }
+    if (term->qualifier) {
+        hash ^= 0xFF;  /* Separator: no qualifier differs from an empty one */
+        hash *= 1099511628211ULL;
+        for (const char *c = term->qualifier; *c; c++) {
+            hash ^= (unsigned char)*c;
+            hash *= 1099511628211ULL;
         }
     }
+    return hash;
+}
+
+static bool ttl_query_term_equal(const ttl_query_term_t *x, const ttl_query_term_t *y) {
+    if (x->kind != y->kind || strcmp(x->lexical, y->lexical) != 0) return false;
+    if (!x->qualifier || !y->qualifier) return x->qualifier == y->qualifier;
+    return strcmp(x->qualifier, y->qualifier) == 0;
+}
+
+static uint32_t ttl_index_lookup(const ttl_query_index_t *index, const ttl_query_term_t *term) {
+    if (!index->slot_count) return TTL_QUERY_UNBOUND;
+    
+    size_t mask = index->slot_count - 1;
+    for (size_t i = ttl_query_hash(term) & mask; index->slots[i]; i = (i + 1) & mask) {
+        uint32_t id = index->slots[i] - 1;
+        if (ttl_query_term_equal(&index->terms[id], term)) return id;
+    }
+    return TTL_QUERY_UNBOUND;
 }
 
-/* Query visitor for pattern matching - FIXED for 80/20 */
-static bool ttl_query_triple_visitor(ttl_ast_visitor_t *visitor, ttl_ast_node_t *node) {
-    if (node->type != TTL_AST_TRIPLE) return true;
+static bool ttl_index_rehash(ttl_query_index_t *index) {
+    size_t slot_count = index->slot_count ? index->slot_count * 2 : 1024;
+    uint32_t *slots = calloc(slot_count, sizeof(uint32_t));
+    if (!slots) return false;
+    
+    for (size_t id = 0; id < index->term_count; id++) {
+        size_t i = ttl_query_hash(&index->terms[id]) & (slot_count - 1);
+        while (slots[i]) i = (i + 1) & (slot_count - 1);
+        slots[i] = (uint32_t)id + 1;
+    }
     
-    query_visitor_context_t *ctx = (query_visitor_context_t*)visitor->user_data;
-    ttl_query_pattern_t *pattern = ctx->pattern;
+    free(index->slots);
+    index->slots = slots;
+    index->slot_count = slot_count;
+    return true;
+}
+
+/* Intern a term, taking ownership of its strings */
+static uint32_t ttl_index_intern(ttl_query_index_t *index, ttl_query_term_t *term, ttl_ast_node_t *node) {
+    uint32_t id = ttl_index_lookup(index, term);
+    if (id != TTL_QUERY_UNBOUND) {
+        ttl_query_term_free(term);
+        return id;
+    }
     
-    // Extract subject, predicate, object from triple - FIXED AST navigation
-    ttl_ast_node_t *subject = node->data.triple.subject;
-    if (!subject) return true;
+    if ((index->term_count + 1) * 2 > index->slot_count && !ttl_index_rehash(index)) {
+        ttl_query_term_free(term);
+        return TTL_QUERY_UNBOUND;
+    }
     
-    // Navigate to predicate-object list
-    ttl_ast_node_t *po_list = node->data.triple.predicate_object_list;
-    if (!po_list || po_list->type != TTL_AST_PREDICATE_OBJECT_LIST) return true;
+    if (index->term_count == index->term_capacity) {
+        size_t capacity = index->term_capacity ? index->term_capacity * 2 : 256;
+        ttl_query_term_t *terms = realloc(index->terms, capacity * sizeof(ttl_query_term_t));
+        if (terms) index->terms = terms;
+        ttl_ast_node_t **nodes = realloc(index->nodes, capacity * sizeof(ttl_ast_node_t*));
+        if (nodes) index->nodes = nodes;
+        if (!terms || !nodes) {
+            ttl_query_term_free(term);
+            return TTL_QUERY_UNBOUND;
+        }
+        index->term_capacity = capacity;
+    }
     
-    // FIXED: Process ALL predicate-object pairs in the list
-    for (size_t i = 0; i < po_list->data.predicate_object_list.item_count; i += 2) {
-        if (i + 1 >= po_list->data.predicate_object_list.item_count) break;
-        
+    id = (uint32_t)index->term_count++;
+    index->terms[id] = *term;
+    index->nodes[id] = node;
+    
+    size_t mask = index->slot_count - 1;
+    size_t i = ttl_query_hash(term) & mask;
+    while (index->slots[i]) i = (i + 1) & mask;
+    index->slots[i] = id + 1;
+    return id;
+}
+
+/* Index construction */
+
+static void ttl_index_add(ttl_query_index_t *index, uint32_t s, uint32_t p, uint32_t o) {
+    if (s == TTL_QUERY_UNBOUND || p == TTL_QUERY_UNBOUND || o == TTL_QUERY_UNBOUND) return;
+    
+    if (index->count == index->capacity) {
+        size_t capacity = index->capacity ? index->capacity * 2 : 1024;
+        ttl_query_key_t *keys = realloc(index->keys[TTL_INDEX_SPO], capacity * sizeof(ttl_query_key_t));
+        if (!keys) return;
+        index->keys[TTL_INDEX_SPO] = keys;
+        index->capacity = capacity;
+    }
+    index->keys[TTL_INDEX_SPO][index->count++] = (ttl_query_key_t){s, p, o};
+}
+
+static void ttl_index_predicate_objects(ttl_query_index_t *index, uint32_t subject, ttl_ast_node_t *po_list) {
+    if (!po_list || po_list->type != TTL_AST_PREDICATE_OBJECT_LIST) return;
+    
+    for (size_t i = 0; i + 1 < po_list->data.predicate_object_list.item_count; i += 2) {
         ttl_ast_node_t *predicate = po_list->data.predicate_object_list.items[i];
-        ttl_ast_node_t *object_list = po_list->data.predicate_object_list.items[i + 1];
-        
-        if (!predicate) continue;
-        
-        // Handle object list or single object
-        if (object_list && object_list->type == TTL_AST_OBJECT_LIST) {
-            // Multiple objects for this predicate
-            for (size_t j = 0; j < object_list->data.object_list.object_count; j++) {
-                ttl_ast_node_t *object = object_list->data.object_list.objects[j];
-                if (!object) continue;
-                
-                // Check pattern match and create bindings
-                if (ttl_pattern_element_matches(&pattern->subject, subject) &&
-                    ttl_pattern_element_matches(&pattern->predicate, predicate) &&
-                    ttl_pattern_element_matches(&pattern->object, object)) {
-                    
-                    // Create bindings for this match
-                    ttl_query_binding_t bindings[3];
-                    size_t binding_count = 0;
-                    
-                    if (pattern->subject.type == TTL_PATTERN_VARIABLE) {
-                        bindings[binding_count].variable_name = ttl_string_duplicate(pattern->subject.data.variable_name);
-                        bindings[binding_count].value = subject;
-                        bindings[binding_count].string_value = ttl_ast_node_to_string(subject);
-                        binding_count++;
-                    }
-                    
-                    if (pattern->predicate.type == TTL_PATTERN_VARIABLE) {
-                        bindings[binding_count].variable_name = ttl_string_duplicate(pattern->predicate.data.variable_name);
-                        bindings[binding_count].value = predicate;
-                        bindings[binding_count].string_value = ttl_ast_node_to_string(predicate);
-                        binding_count++;
-                    }
-                    
-                    if (pattern->object.type == TTL_PATTERN_VARIABLE) {
-                        bindings[binding_count].variable_name = ttl_string_duplicate(pattern->object.data.variable_name);
-                        bindings[binding_count].value = object;
-                        bindings[binding_count].string_value = ttl_ast_node_to_string(object);
-                        binding_count++;
-                    }
-                    
-                    // Apply filters and add to results
-                    if (pattern->filter_count == 0 || ttl_apply_filters(pattern, bindings, binding_count)) {
-                        ttl_add_binding_to_result(ctx->result, bindings, binding_count);
-                        ctx->matches_found++;
-                    }
-                    
-                    // Clean up temporary bindings
-                    for (size_t k = 0; k < binding_count; k++) {
-                        free(bindings[k].variable_name);
-                        free(bindings[k].string_value);
-                    }
-                }
+        ttl_ast_node_t *objects = po_list->data.predicate_object_list.items[i + 1];
+        if (!predicate || !objects) continue;
+    
+        uint32_t p = ttl_index_term(index, predicate);
+        if (objects->type == TTL_AST_OBJECT_LIST) {
+            for (size_t j = 0; j < objects->data.object_list.object_count; j++) {
+                ttl_index_add(index, subject, p, ttl_index_term(index, objects->data.object_list.objects[j]));
             }
         } else {
-            // Single object for this predicate
-            ttl_ast_node_t *object = object_list;
-            if (!object) continue;
-    
-            // Check pattern match and create bindings for single object
-            if (ttl_pattern_element_matches(&pattern->subject, subject) &&
-                ttl_pattern_element_matches(&pattern->predicate, predicate) &&
-                ttl_pattern_element_matches(&pattern->object, object)) {
-                
-                // Create bindings for this match
-                ttl_query_binding_t bindings[3];
-                size_t binding_count = 0;
-                
-                if (pattern->subject.type == TTL_PATTERN_VARIABLE) {
-                    bindings[binding_count].variable_name = ttl_string_duplicate(pattern->subject.data.variable_name);
-                    bindings[binding_count].value = subject;
-                    bindings[binding_count].string_value = ttl_ast_node_to_string(subject);
-                    binding_count++;
-                }
-                
-                if (pattern->predicate.type == TTL_PATTERN_VARIABLE) {
-                    bindings[binding_count].variable_name = ttl_string_duplicate(pattern->predicate.data.variable_name);
-                    bindings[binding_count].value = predicate;
-                    bindings[binding_count].string_value = ttl_ast_node_to_string(predicate);
-                    binding_count++;
-                }
-                
-                if (pattern->object.type == TTL_PATTERN_VARIABLE) {
-                    bindings[binding_count].variable_name = ttl_string_duplicate(pattern->object.data.variable_name);
-                    bindings[binding_count].value = object;
-                    bindings[binding_count].string_value = ttl_ast_node_to_string(object);
-                    binding_count++;
-                }
-                
-                // Apply filters and add to results
-                if (pattern->filter_count == 0 || ttl_apply_filters(pattern, bindings, binding_count)) {
-                    ttl_add_binding_to_result(ctx->result, bindings, binding_count);
-                    ctx->matches_found++;
-                }
-                
-                // Clean up temporary bindings
-                for (size_t k = 0; k < binding_count; k++) {
-                    free(bindings[k].variable_name);
-                    free(bindings[k].string_value);
+            ttl_index_add(index, subject, p, ttl_index_term(index, objects));
+        }
+    }
+}
+
+/* Term id for a node; a [ ... ] node gets a fresh label and its triples indexed */
+static uint32_t ttl_index_term(ttl_query_index_t *index, ttl_ast_node_t *node) {
+    if (!node) return TTL_QUERY_UNBOUND;
+    
+    if (node->type == TTL_AST_BLANK_NODE_PROPERTY_LIST) {
+        char label[32];
+        snprintf(label, sizeof(label), "_:anon%u", index->anonymous_count++);
+        ttl_query_term_t term = {TTL_QUERY_TERM_BLANK, ttl_string_duplicate(label), NULL};
+        if (!term.lexical) return TTL_QUERY_UNBOUND;
+        uint32_t id = ttl_index_intern(index, &term, node);
+        if (id != TTL_QUERY_UNBOUND) {
+            ttl_index_predicate_objects(index, id, node->data.blank_node_property_list.predicate_object_list);
+        }
+        return id;
+    }
+    
+    ttl_query_term_t term;
+    if (!ttl_query_term_from_node(node, &term)) return TTL_QUERY_UNBOUND;
+    return ttl_index_intern(index, &term, node);
+}
+
+static void ttl_index_triple_visitor(ttl_ast_node_t *node, void *user_data) {
+    ttl_query_index_t *index = (ttl_query_index_t*)user_data;
+    
+    uint32_t subject = ttl_index_term(index, node->data.triple.subject);
+    if (subject != TTL_QUERY_UNBOUND) {
+        ttl_index_predicate_objects(index, subject, node->data.triple.predicate_object_list);
+    }
+}
+
+static int ttl_query_key_compare(const void *left, const void *right) {
+    const ttl_query_key_t *x = (const ttl_query_key_t*)left;
+    const ttl_query_key_t *y = (const ttl_query_key_t*)right;
+    
+    if (x->a != y->a) return x->a < y->a ? -1 : 1;
+    if (x->b != y->b) return x->b < y->b ? -1 : 1;
+    if (x->c != y->c) return x->c < y->c ? -1 : 1;
+    return 0;
+}
+
+/* Sort and deduplicate SPO, then derive POS and OSP */
+static bool ttl_index_sort(ttl_query_index_t *index) {
+    ttl_query_key_t *spo = index->keys[TTL_INDEX_SPO];
+    if (index->count == 0) return true;
+    
+    qsort(spo, index->count, sizeof(ttl_query_key_t), ttl_query_key_compare);
+    size_t unique = 1;
+    for (size_t i = 1; i < index->count; i++) {
+        if (ttl_query_key_compare(&spo[i], &spo[unique - 1]) != 0) {
+            spo[unique++] = spo[i];
+        }
+    }
+    index->count = unique;
+    
+    ttl_query_key_t *pos = malloc(unique * sizeof(ttl_query_key_t));
+    ttl_query_key_t *osp = malloc(unique * sizeof(ttl_query_key_t));
+    if (!pos || !osp) {
+        free(pos);
+        free(osp);
+        return false;
+    }
+    for (size_t i = 0; i < unique; i++) {
+        pos[i] = (ttl_query_key_t){spo[i].b, spo[i].c, spo[i].a};
+        osp[i] = (ttl_query_key_t){spo[i].c, spo[i].a, spo[i].b};
+    }
+    qsort(pos, unique, sizeof(ttl_query_key_t), ttl_query_key_compare);
+    qsort(osp, unique, sizeof(ttl_query_key_t), ttl_query_key_compare);
+    
+    index->keys[TTL_INDEX_POS] = pos;
+    index->keys[TTL_INDEX_OSP] = osp;
+    return true;
+}
+
+static void ttl_index_destroy(ttl_query_index_t *index) {
+    if (!index) return;
+    
+    for (size_t i = 0; i < index->term_count; i++) {
+        ttl_query_term_free(&index->terms[i]);
+    }
+    free(index->terms);
+    free(index->nodes);
+    free(index->slots);
+    for (int i = 0; i < TTL_INDEX_COUNT; i++) {
+        free(index->keys[i]);
+    }
+    free(index);
+}
+
+/* Range scans */
+
+/* Compare the first `length` ids of a key against a prefix */
+static int ttl_query_prefix_compare(const ttl_query_key_t *key, const ttl_query_key_t *prefix, size_t length) {
+    if (length > 0 && key->a != prefix->a) return key->a < prefix->a ? -1 : 1;
+    if (length > 1 && key->b != prefix->b) return key->b < prefix->b ? -1 : 1;
+    if (length > 2 && key->c != prefix->c) return key->c < prefix->c ? -1 : 1;
+    return 0;
+}
+
+/* First key whose prefix compares >= 0 (upper: > 0) */
+static size_t ttl_query_bound(const ttl_query_key_t *keys, size_t count,
+                              const ttl_query_key_t *prefix, size_t length, bool upper) {
+    size_t low = 0, high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = ttl_query_prefix_compare(&keys[mid], prefix, length);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Pick the index whose sort prefix covers the bound positions and find its range */
+static ttl_query_index_order_t ttl_index_range(const ttl_query_index_t *index,
+                                               uint32_t s, uint32_t p, uint32_t o,
+                                               size_t *begin, size_t *end) {
+    bool has_s = s != TTL_QUERY_UNBOUND;
+    bool has_p = p != TTL_QUERY_UNBOUND;
+    bool has_o = o != TTL_QUERY_UNBOUND;
+    
+    ttl_query_index_order_t order;
+    ttl_query_key_t prefix;
+    size_t length;
+    
+    if (has_s && (has_p || !has_o)) {
+        order = TTL_INDEX_SPO;
+        prefix = (ttl_query_key_t){s, p, o};
+        length = has_p ? (has_o ? 3 : 2) : 1;
+    } else if (has_s) {
+        order = TTL_INDEX_OSP;
+        prefix = (ttl_query_key_t){o, s, p};
+        length = 2;
+    } else if (has_p) {
+        order = TTL_INDEX_POS;
+        prefix = (ttl_query_key_t){p, o, s};
+        length = has_o ? 2 : 1;
+    } else if (has_o) {
+        order = TTL_INDEX_OSP;
+        prefix = (ttl_query_key_t){o, s, p};
+        length = 1;
+    } else {
+        *begin = 0;
+        *end = index->count;
+        return TTL_INDEX_SPO;
+    }
+    
+    const ttl_query_key_t *keys = index->keys[order];
+    *begin = ttl_query_bound(keys, index->count, &prefix, length, false);
+    *end = ttl_query_bound(keys + *begin, index->count - *begin, &prefix, length, true) + *begin;
+    return order;
+}
+
+/* Key back to subject, predicate, object */
+static void ttl_query_key_decode(ttl_query_index_order_t order, const ttl_query_key_t *key, uint32_t spo[3]) {
+    switch (order) {
+        case TTL_INDEX_POS:
+            spo[0] = key->c; spo[1] = key->a; spo[2] = key->b;
+            break;
+        case TTL_INDEX_OSP:
+            spo[0] = key->b; spo[1] = key->c; spo[2] = key->a;
+            break;
+        default:
+            spo[0] = key->a; spo[1] = key->b; spo[2] = key->c;
+            break;
+    }
+}
+
+/* Join execution */
+
+static uint32_t* ttl_query_rows_append(ttl_query_rows_t *rows) {
+    if (rows->count == rows->capacity) {
+        size_t capacity = rows->capacity ? rows->capacity * 2 : 64;
+        uint32_t *ids = realloc(rows->ids, capacity * rows->width * sizeof(uint32_t));
+        if (!ids) return NULL;
+        rows->ids = ids;
+        rows->capacity = capacity;
+    }
+    return rows->ids + rows->count++ * rows->width;
+}
+
+static int ttl_query_variable_column(char **variables, size_t *variable_count, const ttl_pattern_element_t *element) {
+    if (element->type != TTL_PATTERN_VARIABLE) return -1;
+    
+    for (size_t i = 0; i < *variable_count; i++) {
+        if (strcmp(variables[i], element->data.variable_name) == 0) return (int)i;
+    }
+    variables[*variable_count] = element->data.variable_name;
+    return (int)(*variable_count)++;
+}
+
+/* Extend every row with the matches of one pattern */
+static bool ttl_query_join_step(const ttl_query_index_t *index, const ttl_query_step_t *step,
+                                const ttl_query_rows_t *input, ttl_query_rows_t *output) {
+    for (size_t r = 0; r < input->count; r++) {
+        const uint32_t *row = input->ids + r * input->width;
+    
+        uint32_t bound[3];
+        for (int k = 0; k < 3; k++) {
+            const ttl_query_slot_t *slot = &step->slots[k];
+            bound[k] = slot->variable >= 0 ? row[slot->variable] : slot->id;
+        }
+    
+        size_t begin, end;
+        ttl_query_index_order_t order = ttl_index_range(index, bound[0], bound[1], bound[2], &begin, &end);
+    
+        for (size_t i = begin; i < end; i++) {
+            uint32_t spo[3];
+            ttl_query_key_decode(order, &index->keys[order][i], spo);
+    
+            uint32_t *next = ttl_query_rows_append(output);
+            if (!next) return false;
+            memcpy(next, row, output->width * sizeof(uint32_t));
+    
+            /* Bind new variables; a variable repeated in the pattern must agree */
+            bool consistent = true;
+            for (int k = 0; k < 3 && consistent; k++) {
+                int column = step->slots[k].variable;
+                if (column < 0) continue;
+                if (next[column] == TTL_QUERY_UNBOUND) {
+                    next[column] = spo[k];
+                } else if (next[column] != spo[k]) {
+                    consistent = false;
                 }
             }
+            if (!consistent) output->count--;
         }
     }
-    
     return true;
 }
 
+/* Most bound positions first, then smallest estimated range */
+static ttl_query_step_t* ttl_query_next_step(ttl_query_step_t *steps, size_t step_count, const bool *bound_columns) {
+    ttl_query_step_t *best = NULL;
+    int best_bound = -1;
+    
+    for (size_t i = 0; i < step_count; i++) {
+        ttl_query_step_t *step = &steps[i];
+        if (step->done) continue;
+    
+        int bound = 0;
+        for (int k = 0; k < 3; k++) {
+            const ttl_query_slot_t *slot = &step->slots[k];
+            if (slot->id != TTL_QUERY_UNBOUND || (slot->variable >= 0 && bound_columns[slot->variable])) {
+                bound++;
+            }
+        }
+        if (bound > best_bound || (bound == best_bound && step->estimate < best->estimate)) {
+            best = step;
+            best_bound = bound;
+        }
+    }
+    return best;
+}
+
 /* Filter application */
 static bool ttl_apply_filters(ttl_query_pattern_t *pattern, ttl_query_binding_t *bindings, size_t binding_count) {
     // Simplified filter implementation for 80/20
@@ -415,51 +846,42 @@ static void ttl_add_binding_to_result(ttl_query_result_t *result, ttl_query_bind
 /* Public API Implementation */
 
 ttl_query_engine_t* ttl_query_engine_create(ttl_ast_node_t *document, ttl_ast_context_t *context) {
-    printf("DEBUG: Creating query engine with document %p\n", (void*)document);
     if (!document) {
-        printf("DEBUG: No document provided\n");
         return NULL;
     }
     
     ttl_query_engine_t *engine = calloc(1, sizeof(ttl_query_engine_t));
     if (!engine) {
-        printf("DEBUG: Failed to allocate engine\n");
         return NULL;
     }
     
     engine->document = document;
     engine->context = context;
     
-    // Allocate space for triple index (simplified for 80/20)
-    engine->triples = malloc(1000 * sizeof(ttl_ast_node_t*));
-    if (!engine->triples) {
-        printf("DEBUG: Failed to allocate triples array\n");
+    engine->index = calloc(1, sizeof(ttl_query_index_t));
+    if (!engine->index) {
         free(engine);
         return NULL;
     }
-    printf("DEBUG: Engine created successfully\n");
     
-    // Index all triples in the document - FIXED for 80/20
-    // DEBUGGING: Add debug output
-    printf("DEBUG: Indexing triples in document type %d\n", document->type);
-    
-    // First try direct document access (faster)
+    // Intern every triple once; queries never touch the AST again
     if (document->type == TTL_AST_DOCUMENT) {
-        printf("DEBUG: Document has %zu statements\n", document->data.document.statement_count);
-        for (size_t i = 0; i < document->data.document.statement_count && engine->triple_count < 1000; i++) {
+        for (size_t i = 0; i < document->data.document.statement_count; i++) {
             ttl_ast_node_t *stmt = document->data.document.statements[i];
-            printf("DEBUG: Statement %zu: type %d\n", i, stmt ? stmt->type : -1);
             if (stmt && stmt->type == TTL_AST_TRIPLE) {
-                engine->triples[engine->triple_count++] = stmt;
-                printf("DEBUG: Indexed triple %zu\n", engine->triple_count - 1);
+                ttl_index_triple_visitor(stmt, engine->index);
             }
         }
+    } else {
+        ttl_ast_walk_nodes_of_type(document, TTL_AST_TRIPLE, ttl_index_triple_visitor, engine->index);
     }
     
-    // Fallback to AST traversal for any missed triples
-    printf("DEBUG: Fallback AST traversal, current count: %zu\n", engine->triple_count);
-    ttl_ast_walk_nodes_of_type(document, TTL_AST_TRIPLE, ttl_collect_triples_visitor, engine);
-    printf("DEBUG: Final triple count: %zu\n", engine->triple_count);
+    if (!ttl_index_sort(engine->index)) {
+        ttl_index_destroy(engine->index);
+        free(engine);
+        return NULL;
+    }
+    engine->triple_count = engine->index->count;
     
     return engine;
 }
@@ -467,7 +889,7 @@ ttl_query_engine_t* ttl_query_engine_create(ttl_ast_node_t *document, ttl_ast_co
 void ttl_query_engine_destroy(ttl_query_engine_t *engine) {
     if (!engine) return;
     
-    free(engine->triples);
+    ttl_index_destroy(engine->index);
     free(engine);
 }
 
@@ -510,92 +932,180 @@ void ttl_query_pattern_destroy(ttl_query_pattern_t *pattern) {
 }
 
 ttl_query_result_t* ttl_query_execute(ttl_query_engine_t *engine, ttl_query_pattern_t *pattern) {
-    if (!engine || !pattern) return NULL;
+    if (!pattern) return NULL;
     
+    return ttl_query_execute_patterns(engine, &pattern, 1);
+}
+
+ttl_query_result_t* ttl_query_execute_patterns(ttl_query_engine_t *engine,
+                                               ttl_query_pattern_t **patterns,
+                                               size_t pattern_count) {
+    if (!engine || !patterns || pattern_count == 0) return NULL;
+    
+    ttl_query_index_t *index = engine->index;
     ttl_query_result_t *result = calloc(1, sizeof(ttl_query_result_t));
-    if (!result) return NULL;
-    
-    // Create visitor context
-    query_visitor_context_t ctx = {
-        .engine = engine,
-        .pattern = pattern,
-        .result = result,
-        .matches_found = 0
-    };
-    
-    // FIXED: Use indexed triples for faster querying (80/20 optimization)
-    // Direct iteration over indexed triples instead of AST traversal
-    for (size_t i = 0; i < engine->triple_count; i++) {
-        ttl_ast_node_t *triple = engine->triples[i];
-        if (triple && triple->type == TTL_AST_TRIPLE) {
-            // Create a temporary visitor for processing this triple
-            ttl_ast_visitor_t visitor_temp = {0};
-            visitor_temp.user_data = &ctx;
-            
-            // Process this triple directly
-            ttl_query_triple_visitor(&visitor_temp, triple);
+    char **variables = malloc(pattern_count * 3 * sizeof(char*));
+    ttl_query_step_t *steps = calloc(pattern_count, sizeof(ttl_query_step_t));
+    bool *bound_columns = calloc(pattern_count * 3, sizeof(bool));
+    ttl_query_binding_t *bindings = malloc(pattern_count * 3 * sizeof(ttl_query_binding_t));
+    ttl_query_rows_t rows = {0}, next = {0};
+    if (!result || !variables || !steps || !bound_columns || !bindings) {
+        free(result);
+        result = NULL;
+        goto cleanup;
+    }
+    
+    // Compile patterns: variables to result columns, fixed terms to ids
+    size_t variable_count = 0;
+    bool empty = false;
+    for (size_t i = 0; i < pattern_count; i++) {
+        const ttl_pattern_element_t *elements[3] = {
+            &patterns[i]->subject, &patterns[i]->predicate, &patterns[i]->object
+        };
+        for (int k = 0; k < 3; k++) {
+            ttl_query_slot_t *slot = &steps[i].slots[k];
+            slot->variable = ttl_query_variable_column(variables, &variable_count, elements[k]);
+            slot->id = TTL_QUERY_UNBOUND;
+            if (elements[k]->type == TTL_PATTERN_FIXED) {
+                ttl_query_term_t term;
+                if (ttl_query_term_parse(elements[k]->data.fixed_value, &term)) {
+                    slot->id = ttl_index_lookup(index, &term);
+                    ttl_query_term_free(&term);
+                }
+                if (slot->id == TTL_QUERY_UNBOUND) empty = true;  // Term absent: no matches
+            }
         }
+    
+        size_t begin, end;
+        ttl_index_range(index, steps[i].slots[0].id, steps[i].slots[1].id, steps[i].slots[2].id, &begin, &end);
+        steps[i].estimate = end - begin;
     }
     
-    // Fallback: If no indexed triples, try AST traversal
-    if (engine->triple_count == 0) {
-        ttl_ast_visitor_t *visitor = ttl_visitor_create();
-        if (visitor) {
-            visitor->user_data = &ctx;
-            visitor->visit_triple = ttl_query_triple_visitor;
-            ttl_ast_accept(engine->document, visitor);
-            ttl_visitor_destroy(visitor);
+    // Join on ids, starting from one empty row
+    rows.width = next.width = variable_count ? variable_count : 1;
+    uint32_t *seed = ttl_query_rows_append(&rows);
+    if (seed) {
+        for (size_t c = 0; c < rows.width; c++) seed[c] = TTL_QUERY_UNBOUND;
+    }
+    for (size_t n = 0; n < pattern_count && !empty && rows.count > 0; n++) {
+        ttl_query_step_t *step = ttl_query_next_step(steps, pattern_count, bound_columns);
+        step->done = true;
+    
+        next.count = 0;
+        if (!ttl_query_join_step(index, step, &rows, &next)) {
+            rows.count = 0;
+            break;
+        }
+        ttl_query_rows_t swap = rows;
+        rows = next;
+        next = swap;
+    
+        for (int k = 0; k < 3; k++) {
+            if (step->slots[k].variable >= 0) bound_columns[step->slots[k].variable] = true;
+        }
+    }
+    if (empty) rows.count = 0;
+    
+    // Filter and materialize strings for the surviving rows only
+    size_t matches_found = 0;
+    for (size_t r = 0; r < rows.count; r++) {
+        const uint32_t *row = rows.ids + r * rows.width;
+        for (size_t c = 0; c < variable_count; c++) {
+            bindings[c].variable_name = variables[c];
+            bindings[c].value = index->nodes[row[c]];
+            bindings[c].string_value = index->terms[row[c]].lexical;
+        }
+    
+        bool keep = true;
+        for (size_t i = 0; i < pattern_count && keep; i++) {
+            if (patterns[i]->filter_count > 0) {
+                keep = ttl_apply_filters(patterns[i], bindings, variable_count);
+            }
+        }
+        if (keep) {
+            ttl_add_binding_to_result(result, bindings, variable_count);
+            matches_found++;
         }
     }
     
     // Update statistics
     engine->stats.queries_executed++;
-    engine->stats.patterns_matched += ctx.matches_found;
+    engine->stats.patterns_matched += matches_found;
     engine->stats.total_results += result->row_count;
     
+cleanup:
+    free(rows.ids);
+    free(next.ids);
+    free(variables);
+    free(steps);
+    free(bound_columns);
+    free(bindings);
     return result;
 }
 
+/* Next whitespace-separated token; a quoted literal may contain spaces */
+static char* ttl_query_next_token(char **cursor) {
+    char *token = *cursor;
+    while (*token && isspace((unsigned char)*token)) token++;
+    if (!*token) return NULL;
+    
+    char *end = token;
+    if (*token == '"' || *token == '\'') {
+        size_t delimiter;
+        const char *string_end = ttl_query_string_end(token, &delimiter);
+        end = string_end ? (char*)string_end : token + strlen(token);
+    }
+    while (*end && !isspace((unsigned char)*end)) end++;
+    
+    *cursor = *end ? end + 1 : end;
+    *end = '\0';
+    return token;
+}
+
 ttl_query_result_t* ttl_query_execute_simple(ttl_query_engine_t *engine, const char *query_string) {
     if (!engine || !query_string) return NULL;
     
-    // Simple parser for basic triple patterns like "?s rdf:type foaf:Person"
+    // Simple parser for triple patterns like "?s rdf:type foaf:Person",
+    // several joined with " . " as in "?s a foaf:Person . ?s foaf:name ?name";
+    // literals are written as in Turtle: ?s foaf:name "Bob Smith"
     char *query_copy = ttl_string_duplicate(query_string);
     if (!query_copy) return NULL;
     
-    char *subject = NULL, *predicate = NULL, *object = NULL;
-    char *token = strtok(query_copy, " \t\n");
-    
-    if (token) {
-        subject = ttl_string_duplicate(token);
-        token = strtok(NULL, " \t\n");
-    }
-    if (token) {
-        predicate = ttl_string_duplicate(token);
-        token = strtok(NULL, " \t\n");
-    }
-    if (token) {
-        object = ttl_string_duplicate(token);
+    ttl_query_pattern_t **patterns = NULL;
+    size_t pattern_count = 0;
+    char *terms[3];
+    size_t term_count = 0;
+    bool ok = true;
+    
+    char *cursor = query_copy;
+    for (char *token = ttl_query_next_token(&cursor); token && ok; token = ttl_query_next_token(&cursor)) {
+        if (strcmp(token, ".") == 0) {
+            ok = term_count == 0;
+            continue;
+        }
+        terms[term_count++] = token;
+        if (term_count < 3) continue;
+    
+        ttl_query_pattern_t **grown = realloc(patterns, (pattern_count + 1) * sizeof(ttl_query_pattern_t*));
+        ttl_query_pattern_t *pattern = grown ? ttl_query_pattern_create(terms[0], terms[1], terms[2]) : NULL;
+        if (grown) patterns = grown;
+        if (pattern) {
+            patterns[pattern_count++] = pattern;
+        }
+        ok = pattern != NULL;
+        term_count = 0;
     }
     
-    free(query_copy);
-    
-    if (!subject || !predicate || !object) {
-        free(subject);
-        free(predicate);
-        free(object);
-        return NULL;
+    ttl_query_result_t *result = NULL;
+    if (ok && term_count == 0 && pattern_count > 0) {
+        result = ttl_query_execute_patterns(engine, patterns, pattern_count);
     }
     
-    ttl_query_pattern_t *pattern = ttl_query_pattern_create(subject, predicate, object);
-    free(subject);
-    free(predicate);
-    free(object);
-    
-    if (!pattern) return NULL;
-    
-    ttl_query_result_t *result = ttl_query_execute(engine, pattern);
-    ttl_query_pattern_destroy(pattern);
+    for (size_t i = 0; i < pattern_count; i++) {
+        ttl_query_pattern_destroy(patterns[i]);
+    }
+    free(patterns);
+    free(query_copy);
     
     return result;
 }
@@ -9,6 +9,7 @@
  */
 
 #include "serializer.h"
+#include "output_buffer.h"
 #include "visitor.h"
 #include <stdlib.h>
 #include <string.h>
@@ -19,6 +20,7 @@
  */
 typedef struct {
     FILE* output;
+    ttl_output_buffer_t out;          // Valid while serializing
     ttl_serializer_options_t options;
     ttl_serializer_stats_t stats;
     
@@ -36,30 +38,10 @@ typedef struct {
 } rdfxml_context_t;
 
 /**
- * Escape string for XML
+ * Write string with XML escaping
  */
-static char* escape_xml_string(const char* input) {
-    if (!input) return NULL;
-    
-    size_t len = strlen(input);
-    size_t escaped_len = len * 6 + 1; // Worst case for &quot; etc.
-    char* escaped = malloc(escaped_len);
-    if (!escaped) return NULL;
-    
-    char* dest = escaped;
-    for (const char* src = input; *src; src++) {
-        switch (*src) {
-            case '<':  strcpy(dest, "&lt;"); dest += 4; break;
-            case '>':  strcpy(dest, "&gt;"); dest += 4; break;
-            case '&':  strcpy(dest, "&amp;"); dest += 5; break;
-            case '"':  strcpy(dest, "&quot;"); dest += 6; break;
-            case '\'': strcpy(dest, "&apos;"); dest += 6; break;
-            default:   *dest++ = *src; break;
-        }
-    }
-    *dest = '\0';
-    
-    return escaped;
+static bool write_xml_escaped(rdfxml_context_t* ctx, const char* value) {
+    return ttl_output_append_escaped(&ctx->out, value, TTL_ESCAPE_XML);
 }
 
 /**
@@ -69,7 +51,7 @@ static bool write_indent(rdfxml_context_t* ctx) {
     if (!ctx->options.pretty_print) return true;
     
     for (int i = 0; i < ctx->indent_level; i++) {
-        if (fprintf(ctx->output, "  ") < 0) {
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, "  ")) {
             ctx->has_error = true;
             strcpy(ctx->error_message, "Failed to write indentation");
             return false;
@@ -84,7 +66,7 @@ static bool write_indent(rdfxml_context_t* ctx) {
 static bool write_newline(rdfxml_context_t* ctx) {
     if (!ctx->options.pretty_print) return true;
     
-    if (fprintf(ctx->output, "\n") < 0) {
+    if (!ttl_output_append_char(&ctx->out, '\n')) {
         ctx->has_error = true;
         strcpy(ctx->error_message, "Failed to write newline");
         return false;
@@ -99,22 +81,22 @@ static bool write_header(rdfxml_context_t* ctx) {
     if (ctx->wrote_header) return true;
     
     // XML declaration
-    if (fprintf(ctx->output, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>")) return false;
     if (!write_newline(ctx)) return false;
     
     // RDF root element with namespaces
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "<rdf:RDF") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "<rdf:RDF")) return false;
     
     // Standard namespaces
-    if (fprintf(ctx->output, 
-                " xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\"") < 0) return false;
-    if (fprintf(ctx->output, 
-                " xmlns:rdfs=\"http://www.w3.org/2000/01/rdf-schema#\"") < 0) return false;
-    if (fprintf(ctx->output, 
-                " xmlns:xsd=\"http://www.w3.org/2001/XMLSchema#\"") < 0) return false;
-    
-    if (fprintf(ctx->output, ">") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, 
+                            " xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\"")) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, 
+                            " xmlns:rdfs=\"http://www.w3.org/2000/01/rdf-schema#\"")) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, 
+                            " xmlns:xsd=\"http://www.w3.org/2001/XMLSchema#\"")) return false;
+    
+    if (!ttl_output_append_char(&ctx->out, '>')) return false;
     if (!write_newline(ctx)) return false;
     
     ctx->indent_level++;
@@ -128,7 +110,7 @@ static bool write_header(rdfxml_context_t* ctx) {
 static bool write_footer(rdfxml_context_t* ctx) {
     ctx->indent_level--;
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "</rdf:RDF>") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "</rdf:RDF>")) return false;
     if (!write_newline(ctx)) return false;
     return true;
 }
@@ -178,12 +160,9 @@ static bool serialize_resource_ref(rdfxml_context_t* ctx, ttl_ast_node_t* node)
     switch (node->type) {
         case TTL_AST_IRI: {
             const char* iri = node->data.iri.value;
-            char* escaped = escape_xml_string(iri);
-            if (!escaped) return false;
-            
-            int result = fprintf(ctx->output, "rdf:resource=\"%s\"", escaped);
-            free(escaped);
-            return result >= 0;
+            return TTL_OUTPUT_LITERAL(&ctx->out, "rdf:resource=\"") &&
+                   write_xml_escaped(ctx, iri) &&
+                   ttl_output_append_char(&ctx->out, '"');
         }
         
         case TTL_AST_PREFIXED_NAME: {
@@ -191,36 +170,35 @@ static bool serialize_resource_ref(rdfxml_context_t* ctx, ttl_ast_node_t* node)
             const char* local = node->data.prefixed_name.local_name;
             
             // Expand to full IRI for resource attribute
+            const char* namespace_iri = prefix;
             if (strcmp(prefix, "rdf") == 0) {
-                return fprintf(ctx->output, 
-                              "rdf:resource=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#%s\"", 
-                              local) >= 0;
+                namespace_iri = "http://www.w3.org/1999/02/22-rdf-syntax-ns#";
             } else if (strcmp(prefix, "rdfs") == 0) {
-                return fprintf(ctx->output, 
-                              "rdf:resource=\"http://www.w3.org/2000/01/rdf-schema#%s\"", 
-                              local) >= 0;
+                namespace_iri = "http://www.w3.org/2000/01/rdf-schema#";
             } else if (strcmp(prefix, "xsd") == 0) {
-                return fprintf(ctx->output, 
-                              "rdf:resource=\"http://www.w3.org/2001/XMLSchema#%s\"", 
-                              local) >= 0;
-            } else {
-                return fprintf(ctx->output, "rdf:resource=\"%s%s\"", prefix, local) >= 0;
+                namespace_iri = "http://www.w3.org/2001/XMLSchema#";
             }
+            return TTL_OUTPUT_LITERAL(&ctx->out, "rdf:resource=\"") &&
+                   ttl_output_append_str(&ctx->out, namespace_iri) &&
+                   ttl_output_append_str(&ctx->out, local) &&
+                   ttl_output_append_char(&ctx->out, '"');
         }
         
         case TTL_AST_BLANK_NODE: {
             const char* label = node->data.blank_node.label;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "rdf:nodeID=\"")) return false;
             if (label) {
-                return fprintf(ctx->output, "rdf:nodeID=\"%s\"", label) >= 0;
+                if (!ttl_output_append_str(&ctx->out, label)) return false;
             } else {
-                return fprintf(ctx->output, "rdf:nodeID=\"genid%u\"", 
-                              node->data.blank_node.id) >= 0;
+                if (!TTL_OUTPUT_LITERAL(&ctx->out, "genid") ||
+                    !ttl_output_append_int(&ctx->out, node->data.blank_node.id)) return false;
             }
+            return ttl_output_append_char(&ctx->out, '"');
         }
         
         case TTL_AST_RDF_TYPE:
-            return fprintf(ctx->output, 
-                          "rdf:resource=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#type\"") >= 0;
+            return TTL_OUTPUT_LITERAL(&ctx->out, 
+                                      "rdf:resource=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#type\"");
         
         default:
             return false;
@@ -234,12 +212,7 @@ static bool serialize_literal_content(rdfxml_context_t* ctx, ttl_ast_node_t* nod
     switch (node->type) {
         case TTL_AST_STRING_LITERAL: {
             const char* value = node->data.string_literal.value;
-            char* escaped = escape_xml_string(value);
-            if (!escaped) return false;
-            
-            int result = fprintf(ctx->output, "%s", escaped);
-            free(escaped);
-            return result >= 0;
+            return write_xml_escaped(ctx, value);
         }
         
         case TTL_AST_TYPED_LITERAL: {
@@ -248,26 +221,22 @@ static bool serialize_literal_content(rdfxml_context_t* ctx, ttl_ast_node_t* nod
             
             // Write datatype attribute first
             if (datatype->type == TTL_AST_IRI) {
-                char* escaped = escape_xml_string(datatype->data.iri.value);
-                if (!escaped) return false;
-                int result = fprintf(ctx->output, " rdf:datatype=\"%s\"", escaped);
-                free(escaped);
-                if (result < 0) return false;
+                if (!TTL_OUTPUT_LITERAL(&ctx->out, " rdf:datatype=\"") ||
+                    !write_xml_escaped(ctx, datatype->data.iri.value) ||
+                    !ttl_output_append_char(&ctx->out, '"')) return false;
             } else if (datatype->type == TTL_AST_PREFIXED_NAME) {
                 const char* prefix = datatype->data.prefixed_name.prefix;
                 const char* local = datatype->data.prefixed_name.local_name;
+                const char* namespace_iri = strcmp(prefix, "xsd") == 0 ?
+                    "http://www.w3.org/2001/XMLSchema#" : prefix;
                 
-                if (strcmp(prefix, "xsd") == 0) {
-                    if (fprintf(ctx->output, 
-                               " rdf:datatype=\"http://www.w3.org/2001/XMLSchema#%s\"", 
-                               local) < 0) return false;
-                } else {
-                    if (fprintf(ctx->output, " rdf:datatype=\"%s%s\"", 
-                               prefix, local) < 0) return false;
-                }
+                if (!TTL_OUTPUT_LITERAL(&ctx->out, " rdf:datatype=\"") ||
+                    !ttl_output_append_str(&ctx->out, namespace_iri) ||
+                    !ttl_output_append_str(&ctx->out, local) ||
+                    !ttl_output_append_char(&ctx->out, '"')) return false;
             }
             
-            if (fprintf(ctx->output, ">") < 0) return false;
+            if (!ttl_output_append_char(&ctx->out, '>')) return false;
             
             // Write value content
             return serialize_literal_content(ctx, value);
@@ -278,7 +247,9 @@ static bool serialize_literal_content(rdfxml_context_t* ctx, ttl_ast_node_t* nod
             const char* lang = node->data.lang_literal.language_tag;
             
             // Write language attribute
-            if (fprintf(ctx->output, " xml:lang=\"%s\">", lang) < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, " xml:lang=\"") ||
+                !ttl_output_append_str(&ctx->out, lang) ||
+                !TTL_OUTPUT_LITERAL(&ctx->out, "\">")) return false;
             
             // Write value content
             return serialize_literal_content(ctx, value);
@@ -302,30 +273,26 @@ static bool serialize_literal_content(rdfxml_context_t* ctx, ttl_ast_node_t* nod
                     return false;
             }
             
-            if (fprintf(ctx->output, " rdf:datatype=\"%s\">", datatype_iri) < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, " rdf:datatype=\"") ||
+                !ttl_output_append_str(&ctx->out, datatype_iri) ||
+                !TTL_OUTPUT_LITERAL(&ctx->out, "\">")) return false;
             
             if (lexical) {
-                char* escaped = escape_xml_string(lexical);
-                if (!escaped) return false;
-                int result = fprintf(ctx->output, "%s", escaped);
-                free(escaped);
-                return result >= 0;
+                return write_xml_escaped(ctx, lexical);
             } else {
                 if (node->data.numeric_literal.numeric_type == TTL_NUMERIC_INTEGER) {
-                    return fprintf(ctx->output, "%lld", 
-                                  (long long)node->data.numeric_literal.integer_value) >= 0;
+                    return ttl_output_append_int(&ctx->out, node->data.numeric_literal.integer_value);
                 } else {
-                    return fprintf(ctx->output, "%g", 
-                                  node->data.numeric_literal.double_value) >= 0;
+                    return ttl_output_append_double(&ctx->out, node->data.numeric_literal.double_value);
                 }
             }
         }
         
         case TTL_AST_BOOLEAN_LITERAL: {
             const char* value = node->data.boolean_literal.value ? "true" : "false";
-            if (fprintf(ctx->output, 
-                       " rdf:datatype=\"http://www.w3.org/2001/XMLSchema#boolean\">%s", 
-                       value) < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, 
+                                    " rdf:datatype=\"http://www.w3.org/2001/XMLSchema#boolean\">") ||
+                !ttl_output_append_str(&ctx->out, value)) return false;
             return true;
         }
         
@@ -367,26 +334,26 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
     
     // Start rdf:Description element for subject
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "<rdf:Description") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "<rdf:Description")) return false;
     
     // Write subject reference
     if (subject->type == TTL_AST_IRI) {
-        char* escaped = escape_xml_string(subject->data.iri.value);
-        if (!escaped) return false;
-        int result = fprintf(ctx->output, " rdf:about=\"%s\"", escaped);
-        free(escaped);
-        if (result < 0) return false;
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, " rdf:about=\"") ||
+            !write_xml_escaped(ctx, subject->data.iri.value) ||
+            !ttl_output_append_char(&ctx->out, '"')) return false;
     } else if (subject->type == TTL_AST_BLANK_NODE) {
         const char* label = subject->data.blank_node.label;
+        if (!TTL_OUTPUT_LITERAL(&ctx->out, " rdf:nodeID=\"")) return false;
         if (label) {
-            if (fprintf(ctx->output, " rdf:nodeID=\"%s\"", label) < 0) return false;
+            if (!ttl_output_append_str(&ctx->out, label)) return false;
         } else {
-            if (fprintf(ctx->output, " rdf:nodeID=\"genid%u\"", 
-                       subject->data.blank_node.id) < 0) return false;
+            if (!TTL_OUTPUT_LITERAL(&ctx->out, "genid") ||
+                !ttl_output_append_int(&ctx->out, subject->data.blank_node.id)) return false;
         }
+        if (!ttl_output_append_char(&ctx->out, '"')) return false;
     }
     
-    if (fprintf(ctx->output, ">") < 0) return false;
+    if (!ttl_output_append_char(&ctx->out, '>')) return false;
     if (!write_newline(ctx)) return false;
     
     ctx->indent_level++;
@@ -416,26 +383,33 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
                         const char* prefix = get_prefix(iri);
                         
                         if (qname && prefix) {
-                            if (fprintf(ctx->output, "<%s:%s", prefix, qname) < 0) return false;
+                            if (!ttl_output_append_char(&ctx->out, '<') ||
+                                !ttl_output_append_str(&ctx->out, prefix) ||
+                                !ttl_output_append_char(&ctx->out, ':') ||
+                                !ttl_output_append_str(&ctx->out, qname)) return false;
                         } else {
                             // Use full IRI as element name (not ideal but works)
-                            char* escaped = escape_xml_string(iri);
-                            if (!escaped) return false;
-                            int result = fprintf(ctx->output, "<rdf:_property rdf:about=\"%s\"", escaped);
-                            free(escaped);
-                            if (result < 0) return false;
+                            if (!TTL_OUTPUT_LITERAL(&ctx->out, "<rdf:_property rdf:about=\"") ||
+                                !write_xml_escaped(ctx, iri) ||
+                                !ttl_output_append_char(&ctx->out, '"')) return false;
                         }
                     } else if (predicate->type == TTL_AST_PREFIXED_NAME) {
                         const char* prefix = predicate->data.prefixed_name.prefix;
                         const char* local = predicate->data.prefixed_name.local_name;
-                        if (fprintf(ctx->output, "<%s:%s", prefix, local) < 0) return false;
+                        if (!ttl_output_append_char(&ctx->out, '<') ||
+                            !ttl_output_append_str(&ctx->out, prefix) ||
+                            !ttl_output_append_char(&ctx->out, ':') ||
+                            !ttl_output_append_str(&ctx->out, local)) return false;
                     } else if (predicate->type == TTL_AST_RDF_TYPE) {
-                        if (fprintf(ctx->output, "<rdf:type") < 0) return false;
+                        if (!TTL_OUTPUT_LITERAL(&ctx->out, "<rdf:type")) return false;
                     }
                     
                     // Handle object
                     if (is_literal(object)) {
-                        // Literal object - write as element content
+                        // Literal object - write as element content; typed and
+                        // language literals close the start tag after their attributes
+                        if (object->type == TTL_AST_STRING_LITERAL &&
+                            !ttl_output_append_char(&ctx->out, '>')) return false;
                         if (!serialize_literal_content(ctx, object)) return false;
                         
                         // Close predicate element
@@ -445,22 +419,30 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
                             const char* prefix = get_prefix(iri);
                             
                             if (qname && prefix) {
-                                if (fprintf(ctx->output, "</%s:%s>", prefix, qname) < 0) return false;
+                                if (!TTL_OUTPUT_LITERAL(&ctx->out, "</") ||
+                                    !ttl_output_append_str(&ctx->out, prefix) ||
+                                    !ttl_output_append_char(&ctx->out, ':') ||
+                                    !ttl_output_append_str(&ctx->out, qname) ||
+                                    !ttl_output_append_char(&ctx->out, '>')) return false;
                             } else {
-                                if (fprintf(ctx->output, "</rdf:_property>") < 0) return false;
+                                if (!TTL_OUTPUT_LITERAL(&ctx->out, "</rdf:_property>")) return false;
                             }
                         } else if (predicate->type == TTL_AST_PREFIXED_NAME) {
                             const char* prefix = predicate->data.prefixed_name.prefix;
                             const char* local = predicate->data.prefixed_name.local_name;
-                            if (fprintf(ctx->output, "</%s:%s>", prefix, local) < 0) return false;
+                            if (!TTL_OUTPUT_LITERAL(&ctx->out, "</") ||
+                                !ttl_output_append_str(&ctx->out, prefix) ||
+                                !ttl_output_append_char(&ctx->out, ':') ||
+                                !ttl_output_append_str(&ctx->out, local) ||
+                                !ttl_output_append_char(&ctx->out, '>')) return false;
                         } else if (predicate->type == TTL_AST_RDF_TYPE) {
-                            if (fprintf(ctx->output, "</rdf:type>") < 0) return false;
+                            if (!TTL_OUTPUT_LITERAL(&ctx->out, "</rdf:type>")) return false;
                         }
                     } else {
                         // Resource object - write as attribute
-                        if (fprintf(ctx->output, " ") < 0) return false;
+                        if (!ttl_output_append_char(&ctx->out, ' ')) return false;
                         if (!serialize_resource_ref(ctx, object)) return false;
-                        if (fprintf(ctx->output, "/>") < 0) return false;
+                        if (!TTL_OUTPUT_LITERAL(&ctx->out, "/>")) return false;
                     }
                     
                     if (!write_newline(ctx)) return false;
@@ -472,7 +454,7 @@ static bool visit_triple(ttl_ast_visitor_t* visitor, ttl_ast_node_t* node) {
     
     ctx->indent_level--;
     if (!write_indent(ctx)) return false;
-    if (fprintf(ctx->output, "</rdf:Description>") < 0) return false;
+    if (!TTL_OUTPUT_LITERAL(&ctx->out, "</rdf:Description>")) return false;
     if (!write_newline(ctx)) return false;
     
     return true;
@@ -505,9 +487,6 @@ bool ttl_serialize_rdfxml_ast(ttl_serializer_t* serializer, ttl_ast_node_t* root
     
     rdfxml_context_t* ctx = (rdfxml_context_t*)serializer;
     
-    // Write XML header
-    if (!write_header(ctx)) return false;
-    
     // Create visitor for triple extraction
     ttl_ast_visitor_t* visitor = ttl_visitor_create();
     if (!visitor) return false;
@@ -516,8 +495,13 @@ bool ttl_serialize_rdfxml_ast(ttl_serializer_t* serializer, ttl_ast_node_t* root
     visitor->visit_triple = visit_triple;
     visitor->order = TTL_VISITOR_PRE_ORDER;
     
-    // Traverse AST and serialize triples
-    bool success = ttl_ast_accept(root, visitor);
+    if (!ttl_output_buffer_init(&ctx->out, ctx->output, 0)) {
+        ttl_visitor_destroy(visitor);
+        return false;
+    }
+    
+    // Write XML header, then traverse AST and serialize triples
+    bool success = write_header(ctx) && ttl_ast_accept(root, visitor);
     
     // Write XML footer
     if (success && !ctx->has_error) {
@@ -526,6 +510,13 @@ bool ttl_serialize_rdfxml_ast(ttl_serializer_t* serializer, ttl_ast_node_t* root
             ((double)(clock() - ctx->start_time)) / CLOCKS_PER_SEC * 1000.0;
     }
     
+    // Flush the buffer
+    if (!ttl_output_buffer_destroy(&ctx->out)) {
+        ctx->has_error = true;
+        strcpy(ctx->error_message, "Failed to write output");
+    }
+    ctx->stats.bytes_written = ctx->out.bytes_written;
+    
     ttl_visitor_destroy(visitor);
     return success && !ctx->has_error;
 }
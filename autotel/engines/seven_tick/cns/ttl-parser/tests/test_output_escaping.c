@@ -0,0 +1,330 @@
+/**
+ * @file test_output_escaping.c
+ * @brief Escaped output regression tests
+ *
+ * ttl_output_append_escaped() scans 16 bytes at a time and copies clean runs
+ * straight into the output buffer. Its output, and the literals written by
+ * the N-Triples, JSON-LD and RDF/XML serializers, must match a byte-at-a-time
+ * reference escaper for escapable bytes at every offset of the first blocks,
+ * for strings longer than one block and for strings larger than the buffer.
+ */
+
+#include "../include/output_buffer.h"
+#include "../include/serializer.h"
+#include "../include/ast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Test result tracking */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Test macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    printf("Running %s... ", #name); \
+    fflush(stdout); \
+    tests_run++; \
+    int failed_before = tests_failed; \
+    test_##name(); \
+    if (tests_failed == failed_before) { \
+        tests_passed++; \
+        printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED\n  Assertion failed: %s\n  at %s:%d\n", \
+               #cond, __FILE__, __LINE__); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define MAX_OFFSET 40
+#define LARGE_LENGTH (TTL_OUTPUT_BUFFER_SIZE + 4099)
+
+/* Growable byte string */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} Text;
+
+static void text_append(Text* text, const char* data, size_t length) {
+    if (text->length + length + 1 > text->capacity) {
+        while (text->length + length + 1 > text->capacity) {
+            text->capacity = text->capacity ? text->capacity * 2 : 4096;
+        }
+        text->data = realloc(text->data, text->capacity);
+    }
+    memcpy(text->data + text->length, data, length);
+    text->length += length;
+    text->data[text->length] = '\0';
+}
+
+static void text_append_str(Text* text, const char* str) {
+    text_append(text, str, strlen(str));
+}
+
+/* Byte-at-a-time reference for each escape mode */
+static void reference_escape(Text* out, const char* str, ttl_escape_mode_t mode) {
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+        char hex[8];
+        unsigned char ch = *p;
+        if (mode == TTL_ESCAPE_XML) {
+            switch (ch) {
+                case '<': text_append_str(out, "&lt;"); continue;
+                case '>': text_append_str(out, "&gt;"); continue;
+                case '&': text_append_str(out, "&amp;"); continue;
+                case '"': text_append_str(out, "&quot;"); continue;
+                case '\'': text_append_str(out, "&apos;"); continue;
+                default: text_append(out, (const char*)p, 1); continue;
+            }
+        }
+        switch (ch) {
+            case '"': text_append_str(out, "\\\""); continue;
+            case '\\': text_append_str(out, "\\\\"); continue;
+            case '\n': text_append_str(out, "\\n"); continue;
+            case '\r': text_append_str(out, "\\r"); continue;
+            case '\t': text_append_str(out, "\\t"); continue;
+            default: break;
+        }
+        if (mode == TTL_ESCAPE_JSON && ch < 0x20) {
+            if (ch == '\b') text_append_str(out, "\\b");
+            else if (ch == '\f') text_append_str(out, "\\f");
+            else {
+                snprintf(hex, sizeof(hex), "\\u%04x", ch);
+                text_append_str(out, hex);
+            }
+            continue;
+        }
+        text_append(out, (const char*)p, 1);
+    }
+}
+
+/* Bytes each mode escapes (N-Triples passes other control bytes through) */
+static const char* escapable(ttl_escape_mode_t mode) {
+    switch (mode) {
+        case TTL_ESCAPE_XML: return "<>&\"'";
+        case TTL_ESCAPE_JSON: return "\"\\\n\r\t\b\f\x01\x1f";
+        default: return "\"\\\n\r\t\x01\x1f";
+    }
+}
+
+/* Clean filler, including UTF-8 bytes >= 0x80 that must pass unchanged */
+static void fill_clean(char* str, size_t length) {
+    static const char filler[] = "abcdefgh\xc3\xa9ijklmnop0123456789 \xe2\x82\xac-_.:/";
+    for (size_t i = 0; i < length; i++) {
+        str[i] = filler[i % (sizeof(filler) - 1)];
+    }
+    str[length] = '\0';
+}
+
+/* Test string: one escapable byte at offset, another one block later */
+static char* make_case(size_t length, size_t offset, char ch) {
+    char* str = malloc(length + 1);
+    fill_clean(str, length);
+    str[offset] = ch;
+    if (offset + 17 < length) str[offset + 17] = ch;
+    return str;
+}
+
+static char* read_stream(FILE* file, size_t* length) {
+    fflush(file);
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+    char* data = malloc((size_t)size + 1);
+    *length = fread(data, 1, (size_t)size, file);
+    data[*length] = '\0';
+    return data;
+}
+
+static int same_text(const char* got, size_t got_length, const Text* want) {
+    if (got_length == want->length && memcmp(got, want->data, got_length) == 0) return 1;
+    size_t i = 0;
+    while (i < got_length && i < want->length && got[i] == want->data[i]) i++;
+    printf("\n  output differs at byte %zu of %zu (expected %zu)", i, got_length, want->length);
+    return 0;
+}
+
+static const ttl_escape_mode_t modes[] = {TTL_ESCAPE_NTRIPLES, TTL_ESCAPE_JSON, TTL_ESCAPE_XML};
+#define MODE_COUNT (sizeof(modes) / sizeof(modes[0]))
+
+/* Every (length, offset, byte) case through one output buffer */
+static int escape_cases(ttl_escape_mode_t mode, size_t capacity) {
+    FILE* file = tmpfile();
+    if (!file) return 0;
+    ttl_output_buffer_t out;
+    Text want = {0};
+    int ok = ttl_output_buffer_init(&out, file, capacity);
+
+    const char* bytes = escapable(mode);
+    for (size_t length = 1; ok && length <= 3 * 16 + 1; length++) {
+        for (size_t offset = 0; ok && offset < length && offset <= MAX_OFFSET; offset++) {
+            for (const char* ch = bytes; ok && *ch; ch++) {
+                char* str = make_case(length, offset, *ch);
+                ok = ttl_output_append_escaped(&out, str, mode) &&
+                     ttl_output_append_char(&out, '|');
+                reference_escape(&want, str, mode);
+                text_append_str(&want, "|");
+                free(str);
+            }
+        }
+    }
+    ok = ttl_output_buffer_destroy(&out) && ok;
+
+    size_t got_length = 0;
+    char* got = read_stream(file, &got_length);
+    ok = ok && same_text(got, got_length, &want);
+    if (!ok) printf("\n  mode %d, buffer capacity %zu", (int)mode, capacity);
+    free(got);
+    free(want.data);
+    fclose(file);
+    return ok;
+}
+
+/* Test cases */
+
+TEST(escaped_append_matches_reference) {
+    for (size_t m = 0; m < MODE_COUNT; m++) {
+        ASSERT(escape_cases(modes[m], 0));
+        /* Small buffers flush in the middle of clean runs and escapes */
+        ASSERT(escape_cases(modes[m], 7));
+        ASSERT(escape_cases(modes[m], 64));
+    }
+}
+
+TEST(escaped_append_larger_than_buffer) {
+    char* str = malloc(LARGE_LENGTH + 1);
+    for (size_t m = 0; m < MODE_COUNT; m++) {
+        const char* bytes = escapable(modes[m]);
+        size_t count = strlen(bytes);
+        fill_clean(str, LARGE_LENGTH);
+        for (size_t offset = 0; offset <= MAX_OFFSET; offset += 3) {
+            str[offset] = bytes[offset % count];
+        }
+        str[TTL_OUTPUT_BUFFER_SIZE - 1] = bytes[0];
+        str[TTL_OUTPUT_BUFFER_SIZE] = bytes[count - 1];
+        str[LARGE_LENGTH - 1] = bytes[1];
+
+        FILE* file = tmpfile();
+        ASSERT(file != NULL);
+        ttl_output_buffer_t out;
+        ASSERT(ttl_output_buffer_init(&out, file, 0));
+        /* Partly filled buffer first, so the large string straddles a flush */
+        int ok = ttl_output_append_escaped(&out, "lead\"in", modes[m]) &&
+                 ttl_output_append_escaped(&out, str, modes[m]) &&
+                 ttl_output_append_escaped(&out, "tail<", modes[m]);
+        ok = ttl_output_buffer_destroy(&out) && ok;
+
+        Text want = {0};
+        reference_escape(&want, "lead\"in", modes[m]);
+        reference_escape(&want, str, modes[m]);
+        reference_escape(&want, "tail<", modes[m]);
+        size_t got_length = 0;
+        char* got = read_stream(file, &got_length);
+        ok = ok && same_text(got, got_length, &want);
+        free(got);
+        free(want.data);
+        fclose(file);
+        if (!ok) free(str);
+        ASSERT(ok);
+    }
+    free(str);
+}
+
+/* One triple per literal, each with its own subject */
+static ttl_ast_node_t* literal_document(ttl_ast_context_t* ctx, char** literals, size_t count) {
+    ttl_ast_node_t* doc = ttl_ast_create_document(ctx);
+    for (size_t i = 0; i < count; i++) {
+        char subject[64];
+        snprintf(subject, sizeof(subject), "http://example.org/s%zu", i);
+        ttl_ast_node_t* objects = ttl_ast_create_object_list(ctx);
+        ttl_ast_add_object(objects, ttl_ast_create_string_literal(ctx, literals[i], TTL_STRING_DOUBLE_QUOTE));
+        ttl_ast_node_t* predicates = ttl_ast_create_predicate_object_list(ctx);
+        ttl_ast_add_predicate_object(predicates, ttl_ast_create_iri(ctx, "http://example.org/p"), objects);
+        ttl_ast_add_statement(doc, ttl_ast_create_triple(ctx, ttl_ast_create_iri(ctx, subject), predicates));
+    }
+    return doc;
+}
+
+static int serialize(ttl_ast_node_t* doc, ttl_escape_mode_t mode, FILE* file) {
+    switch (mode) {
+        case TTL_ESCAPE_JSON: return ttl_serialize_jsonld(doc, file, false);
+        case TTL_ESCAPE_XML: return ttl_serialize_rdfxml(doc, file, false);
+        default: return ttl_serialize_ntriples(doc, file);
+    }
+}
+
+TEST(serializers_escape_literals) {
+    for (size_t m = 0; m < MODE_COUNT; m++) {
+        ttl_escape_mode_t mode = modes[m];
+        const char* bytes = escapable(mode);
+        size_t count = strlen(bytes);
+
+        /* Escapable byte at each offset 0..40, in strings of 1 to 3 blocks,
+         * plus one literal larger than the output buffer */
+        char* literals[MAX_OFFSET + 2];
+        size_t literal_count = 0;
+        for (size_t offset = 0; offset <= MAX_OFFSET; offset++) {
+            size_t length = offset + 1 + offset % 3 * 16;
+            literals[literal_count++] = make_case(length, offset, bytes[offset % count]);
+        }
+        literals[literal_count] = make_case(LARGE_LENGTH, MAX_OFFSET, bytes[0]);
+        literals[literal_count][5] = bytes[count - 1];
+        literals[literal_count][LARGE_LENGTH - 2] = bytes[1];
+        literal_count++;
+
+        ttl_ast_context_t* ctx = ttl_ast_context_create(true); /* Freed with the context */
+        ASSERT(ctx != NULL);
+        ttl_ast_node_t* doc = literal_document(ctx, literals, literal_count);
+        FILE* file = tmpfile();
+        ASSERT(file != NULL);
+        int ok = serialize(doc, mode, file);
+
+        size_t got_length = 0;
+        char* got = read_stream(file, &got_length);
+        fclose(file);
+
+        /* Literals are delimited by quotes, or element tags in RDF/XML */
+        const char* open = mode == TTL_ESCAPE_XML ? ">" : "\"";
+        const char* close = mode == TTL_ESCAPE_XML ? "</" : "\"";
+        for (size_t i = 0; ok && i < literal_count; i++) {
+            Text want = {0};
+            text_append_str(&want, open);
+            reference_escape(&want, literals[i], mode);
+            text_append_str(&want, close);
+            ok = strstr(got, want.data) != NULL;
+            if (!ok) printf("\n  %s: literal %zu not found escaped", ttl_serializer_format_name(
+                                mode == TTL_ESCAPE_JSON ? TTL_FORMAT_JSONLD :
+                                mode == TTL_ESCAPE_XML ? TTL_FORMAT_RDFXML : TTL_FORMAT_NTRIPLES), i);
+            free(want.data);
+        }
+
+        free(got);
+        for (size_t i = 0; i < literal_count; i++) free(literals[i]);
+        ttl_ast_context_destroy(ctx);
+        ASSERT(ok);
+    }
+}
+
+int main(void) {
+    printf("Output Escaping Test Suite\n");
+    printf("==========================\n\n");
+
+    RUN_TEST(escaped_append_matches_reference);
+    RUN_TEST(escaped_append_larger_than_buffer);
+    RUN_TEST(serializers_escape_literals);
+
+    printf("\n==========================\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file test_parallel_parser.c
+ * @brief Parallel chunked parsing regression tests
+ *
+ * The parallel parse must produce the same triples, in the same order, as
+ * one sequential streaming parse. Generated blank nodes are named per
+ * chunk, so they are compared up to renaming (first-appearance order).
+ * The documents put long-string delimiters where a raw quote count goes
+ * wrong: in comments, inside short strings, and around multi-line
+ * literals whose lines look like statements.
+ */
+
+#include "../include/parallel_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Test result tracking */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Test macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    printf("Running %s... ", #name); \
+    fflush(stdout); \
+    tests_run++; \
+    int failed_before = tests_failed; \
+    test_##name(); \
+    if (tests_failed == failed_before) { \
+        tests_passed++; \
+        printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED\n  Assertion failed: %s\n  at %s:%d\n", \
+               #cond, __FILE__, __LINE__); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* Growable text buffer */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} Text;
+
+static void text_append(Text* text, const char* s, size_t length) {
+    if (text->length + length + 1 > text->capacity) {
+        size_t capacity = text->capacity ? text->capacity * 2 : 4096;
+        while (capacity < text->length + length + 1) capacity *= 2;
+        text->data = realloc(text->data, capacity);
+        text->capacity = capacity;
+    }
+    memcpy(text->data + text->length, s, length);
+    text->length += length;
+    text->data[text->length] = '\0';
+}
+
+static void text_printf(Text* text, const char* format, int value) {
+    char line[512];
+    int length = snprintf(line, sizeof(line), format, value, value, value);
+    text_append(text, line, (size_t)length);
+}
+
+/* Collected triples, one canonical line each */
+typedef struct {
+    Text lines;
+    size_t triples;
+    size_t errors;
+    char (*blank_labels)[64];
+    size_t blank_count;
+} Collector;
+
+/* Blank nodes become _:bN in order of first appearance */
+static void append_term(Collector* c, const char* term, TripleTermKind kind) {
+    if (kind != TRIPLE_TERM_BLANK_NODE) {
+        text_append(&c->lines, term, strlen(term));
+        return;
+    }
+    size_t index = 0;
+    while (index < c->blank_count && strcmp(c->blank_labels[index], term) != 0) index++;
+    if (index == c->blank_count) {
+        c->blank_labels = realloc(c->blank_labels, (c->blank_count + 1) * sizeof(*c->blank_labels));
+        snprintf(c->blank_labels[c->blank_count++], 64, "%s", term);
+    }
+    char label[32];
+    int length = snprintf(label, sizeof(label), "_:b%zu", index);
+    text_append(&c->lines, label, (size_t)length);
+}
+
+static void collect_triples(void* data, const StreamingTriple* triples, size_t count) {
+    Collector* c = (Collector*)data;
+    for (size_t i = 0; i < count; i++) {
+        const StreamingTriple* t = &triples[i];
+        append_term(c, t->subject, t->subject_kind);
+        text_append(&c->lines, " ", 1);
+        text_append(&c->lines, t->predicate, strlen(t->predicate));
+        text_append(&c->lines, " ", 1);
+        append_term(c, t->object, t->object_kind);
+        if (t->datatype) {
+            text_append(&c->lines, "^^", 2);
+            text_append(&c->lines, t->datatype, strlen(t->datatype));
+        }
+        if (t->lang) {
+            text_append(&c->lines, "@", 1);
+            text_append(&c->lines, t->lang, strlen(t->lang));
+        }
+        text_append(&c->lines, "\n", 1);
+    }
+    c->triples += count;
+}
+
+static void collect_error(void* data, const ParseError* error) {
+    (void)error;
+    ((Collector*)data)->errors++;
+}
+
+static void collector_free(Collector* c) {
+    free(c->lines.data);
+    free(c->blank_labels);
+}
+
+static void parse_collect(const Text* doc, size_t threads, bool ntriples, Collector* out,
+                          ParallelParseStats* stats) {
+    memset(out, 0, sizeof(*out));
+    StreamingCallbacks callbacks = {
+        .user_data = out,
+        .on_triples = collect_triples,
+        .on_error = collect_error
+    };
+    ParallelParseOptions options = ttl_parallel_default_options();
+    options.num_threads = threads;
+    options.chunk_size = 1;      /* Clamped to the minimum chunk */
+    options.ntriples = ntriples;
+    ttl_parallel_parse_buffer(doc->data, doc->length, &callbacks, &options, stats);
+}
+
+/* The same triples as the single-threaded parse, at several thread counts */
+static int matches_sequential(const Text* doc, bool ntriples, size_t expected_triples) {
+    Collector sequential, parallel;
+    ParallelParseStats stats;
+    int ok = 1;
+
+    parse_collect(doc, 1, ntriples, &sequential, &stats);
+    if (sequential.errors != 0 || sequential.triples != expected_triples) {
+        printf("\n  sequential: %zu/%zu triples, %zu errors",
+               sequential.triples, expected_triples, sequential.errors);
+        ok = 0;
+    }
+
+    const size_t thread_counts[] = {2, 3, 4, 8};
+    for (size_t i = 0; ok && i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        parse_collect(doc, thread_counts[i], ntriples, &parallel, &stats);
+        if (stats.chunks < 2 || stats.sequential || parallel.errors != 0 ||
+            parallel.triples != sequential.triples ||
+            parallel.lines.length != sequential.lines.length ||
+            memcmp(parallel.lines.data, sequential.lines.data, sequential.lines.length) != 0) {
+            printf("\n  %zu threads: %zu chunks, %zu/%zu triples, %zu errors",
+                   thread_counts[i], stats.chunks, parallel.triples, sequential.triples,
+                   parallel.errors);
+            ok = 0;
+        }
+        collector_free(&parallel);
+    }
+
+    collector_free(&sequential);
+    return ok;
+}
+
+/* Test cases */
+
+/* Long-string delimiters in comments and short strings, and multi-line
+ * literals whose inner lines end in '.' and start like subjects */
+TEST(turtle_long_string_boundaries) {
+    Text doc = {0};
+    const char* prologue =
+        "@prefix ex: <http://example.org/> .\n"
+        "@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n\n";
+    text_append(&doc, prologue, strlen(prologue));
+
+    size_t triples = 0;
+    for (int i = 0; i < 30000; i++) {
+        switch (i % 8) {
+        case 0:
+            text_printf(&doc, "ex:s%d ex:p \"x\" . # note: \"\"\"\n", i);
+            break;
+        case 1:
+            text_printf(&doc, "ex:s%d ex:q \"\"\"first line %d .\n"
+                              "ex:fake%d ex:p ex:o .\n"
+                              "last \"quoted\" line\"\"\" .\n", i);
+            break;
+        case 2:
+            text_printf(&doc, "ex:s%d ex:r \"it'''s %d\" . # and '''\n", i);
+            break;
+        case 3:
+            text_printf(&doc, "ex:s%d ex:r '''multi\n"
+                              "ex:fake%d ex:p \"x\" .\n"
+                              "line %d''' .\n\n", i);
+            break;
+        case 4:
+            text_printf(&doc, "<http://example.org/s%d#frag> ex:p \"\" ; ex:q \"%d\"^^xsd:integer .\n", i);
+            triples++;
+            break;
+        case 5:
+            text_printf(&doc, "ex:s%d ex:p [ ex:q \"\"\"a\"\" b\"\"\" ] . # \"\n", i);
+            triples++;
+            break;
+        case 6:
+            text_printf(&doc, "ex:s%d ex:p \"tab\\\"\\\"\\\" %d\"@en .\n", i);
+            break;
+        default:
+            text_printf(&doc, "ex:s%d ex:p ex:o%d .\n# comment line \"\"\" '''\n\n", i);
+            break;
+        }
+        triples++;
+    }
+
+    int ok = matches_sequential(&doc, false, triples);
+    free(doc.data);
+    ASSERT(ok);
+}
+
+TEST(ntriples_comments_and_quotes) {
+    Text doc = {0};
+    for (int i = 0; i < 30000; i++) {
+        text_printf(&doc, "<http://example.org/s%d> <http://example.org/p> "
+                          "\"v \\\"\\\"\\\" %d\" . # \"\"\"\n", i);
+    }
+
+    int ok = matches_sequential(&doc, true, 30000);
+    free(doc.data);
+    ASSERT(ok);
+}
+
+int main(void) {
+    printf("Parallel Parser Test Suite\n");
+    printf("==========================\n\n");
+
+    RUN_TEST(turtle_long_string_boundaries);
+    RUN_TEST(ntriples_comments_and_quotes);
+
+    printf("\n==========================\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_query_terms.c
+ * @brief Query engine term identity regression tests
+ *
+ * Terms are interned by kind, lexical form and datatype or language tag: the
+ * IRI ex:b and the literal "ex:b" are distinct, and fixed pattern terms are
+ * read with Turtle literal syntax, including quoted strings with spaces.
+ */
+
+#include "../include/query.h"
+#include "../include/parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Test result tracking */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Test macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    printf("Running %s... ", #name); \
+    fflush(stdout); \
+    tests_run++; \
+    int failed_before = tests_failed; \
+    test_##name(); \
+    if (tests_failed == failed_before) { \
+        tests_passed++; \
+        printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED\n  Assertion failed: %s\n  at %s:%d\n", \
+               #cond, __FILE__, __LINE__); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+static const char* test_document =
+    "@prefix ex: <http://example.org/> .\n"
+    "@prefix foaf: <http://xmlns.com/foaf/0.1/> .\n"
+    "@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n"
+    "ex:a ex:p ex:b .\n"
+    "ex:a ex:p \"ex:b\" .\n"
+    "ex:bob foaf:name \"Bob Smith\" .\n"
+    "ex:carol foaf:name \"Bob\" .\n"
+    "ex:bob ex:label \"chat\"@en, \"chat\"@fr, \"chat\" .\n"
+    "ex:bob ex:age 35 ; ex:code \"35\" ; ex:score \"35\"^^xsd:integer .\n"
+    "ex:bob ex:says \"say \\\"hi\\\" twice\" .\n";
+
+static Parser* test_parser;
+static ttl_query_engine_t* test_engine;
+
+static bool setup_engine(void) {
+    ParserOptions options = ttl_parser_default_options();
+    test_parser = ttl_parser_create(test_document, strlen(test_document), &options);
+    if (!test_parser) return false;
+
+    ttl_ast_node_t* document = ttl_parser_parse(test_parser);
+    if (!document || ttl_parser_has_errors(test_parser)) return false;
+
+    test_engine = ttl_query_engine_create(document, NULL);
+    return test_engine != NULL;
+}
+
+static void teardown_engine(void) {
+    ttl_query_engine_destroy(test_engine);
+    ttl_parser_destroy(test_parser);
+}
+
+/* Rows for a query, or (size_t)-1 if it failed */
+static size_t count_rows(const char* query) {
+    ttl_query_result_t* result = ttl_query_execute_simple(test_engine, query);
+    if (!result) return (size_t)-1;
+    size_t count = ttl_query_result_count(result);
+    ttl_query_result_destroy(result);
+    return count;
+}
+
+/* Value bound to variable in the single row of a query */
+static bool single_binding(const char* query, const char* variable, const char* expected) {
+    ttl_query_result_t* result = ttl_query_execute_simple(test_engine, query);
+    bool ok = result && ttl_query_result_count(result) == 1;
+    if (ok) {
+        const ttl_query_binding_t* binding = ttl_query_result_get_binding(result, variable);
+        ok = binding && binding->string_value && strcmp(binding->string_value, expected) == 0;
+    }
+    ttl_query_result_destroy(result);
+    return ok;
+}
+
+/* Test cases */
+
+TEST(iri_and_literal_are_distinct) {
+    ASSERT_EQ(count_rows("?s ex:p ?o"), 2);
+    ASSERT_EQ(count_rows("?s ex:p ex:b"), 1);
+    ASSERT_EQ(count_rows("?s ex:p \"ex:b\""), 1);
+    ASSERT_EQ(count_rows("ex:a ex:p ex:b . ex:a ex:p \"ex:b\""), 1);
+}
+
+TEST(quoted_multi_word_literal) {
+    ASSERT(single_binding("?s foaf:name \"Bob Smith\"", "s", "ex:bob"));
+    ASSERT(single_binding("?s foaf:name \"Bob\"", "s", "ex:carol"));
+    ASSERT_EQ(count_rows("?s foaf:name \"Smith\""), 0);
+    ASSERT(single_binding("?s foaf:name \"Bob Smith\" . ?s ex:age ?age", "age", "35"));
+    ASSERT(single_binding("?s ex:says \"say \\\"hi\\\" twice\"", "s", "ex:bob"));
+}
+
+TEST(language_tags_and_datatypes) {
+    ASSERT_EQ(count_rows("ex:bob ex:label ?o"), 3);
+    ASSERT_EQ(count_rows("?s ex:label \"chat\""), 1);
+    ASSERT_EQ(count_rows("?s ex:label \"chat\"@en"), 1);
+    ASSERT_EQ(count_rows("?s ex:label \"chat\"@EN"), 1);
+    ASSERT_EQ(count_rows("?s ex:label \"chat\"@de"), 0);
+
+    ASSERT_EQ(count_rows("?s ex:age 35"), 1);
+    ASSERT_EQ(count_rows("?s ex:age \"35\""), 0);
+    ASSERT_EQ(count_rows("?s ex:code \"35\""), 1);
+    ASSERT_EQ(count_rows("?s ex:code 35"), 0);
+    ASSERT_EQ(count_rows("?s ex:score \"35\"^^xsd:integer"), 1);
+    ASSERT_EQ(count_rows("?s ex:score \"35\""), 0);
+}
+
+TEST(malformed_literal) {
+    ASSERT_EQ(count_rows("?s foaf:name \"Bob"), 0);
+    ASSERT_EQ(count_rows("?s foaf:name \"Bob\"@"), 0);
+}
+
+int main(void) {
+    printf("Query Term Test Suite\n");
+    printf("=====================\n\n");
+
+    if (!setup_engine()) {
+        printf("Failed to build the query engine\n");
+        return 1;
+    }
+
+    RUN_TEST(iri_and_literal_are_distinct);
+    RUN_TEST(quoted_multi_word_literal);
+    RUN_TEST(language_tags_and_datatypes);
+    RUN_TEST(malformed_literal);
+
+    teardown_engine();
+
+    printf("\n=====================\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
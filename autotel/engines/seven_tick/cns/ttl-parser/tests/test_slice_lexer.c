@@ -0,0 +1,265 @@
+/**
+ * @file test_slice_lexer.c
+ * @brief Slice lexer streaming regression tests
+ *
+ * The bundled .ttl files are fed to lexer_feed() in small random chunks.
+ * The slices must match a whole-buffer slice scan exactly (kind, flags,
+ * offsets, positions, decoded value) and, where the classic scanner lexes
+ * the file correctly, the tokens of lexer_next_token().
+ */
+
+#include "../include/lexer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Test result tracking */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Test macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    printf("Running %s... ", #name); \
+    fflush(stdout); \
+    tests_run++; \
+    int failed_before = tests_failed; \
+    test_##name(); \
+    if (tests_failed == failed_before) { \
+        tests_passed++; \
+        printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED\n  Assertion failed: %s\n  at %s:%d\n", \
+               #cond, __FILE__, __LINE__); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+/* Bundled documents; the classic scanner mislexes ".5" and "ns1:" */
+static const struct {
+    const char* path;
+    bool classic;
+} fixtures[] = {
+    {"tests/fixtures/simple.ttl", true},
+    {"tests/fixtures/complex.ttl", true},
+    {"tests/fixtures/large.ttl", true},
+    {"tests/fixtures/unicode.ttl", true},
+    {"tests/fixtures/invalid.ttl", true},
+    {"tests/fixtures/edge_cases.ttl", false},
+    {"examples/simple.ttl", true},
+    {"examples/sample_query.ttl", true},
+    {"examples/grammar-examples.ttl", false},
+};
+
+#define FIXTURE_COUNT (sizeof(fixtures) / sizeof(fixtures[0]))
+
+static char* read_file(const char* path, size_t* length) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+    char* data = malloc((size_t)size + 1);
+    *length = fread(data, 1, (size_t)size, file);
+    data[*length] = '\0';
+    fclose(file);
+    return data;
+}
+
+/* Deterministic chunk sizes */
+static uint32_t next_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/* One decoded slice */
+typedef struct {
+    TokenSlice slice;
+    char* value;
+} Lexeme;
+
+typedef struct {
+    Lexeme* items;
+    size_t count;
+    size_t capacity;
+    size_t errors;
+} LexemeList;
+
+static void lexemes_push(LexemeList* list, const Lexer* lexer, const TokenSlice* slice) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 256;
+        list->items = realloc(list->items, list->capacity * sizeof(Lexeme));
+    }
+    Lexeme* lexeme = &list->items[list->count++];
+    lexeme->slice = *slice;
+    lexeme->value = malloc(slice->length + 1);
+    size_t length;
+    if (!lexer_slice_decode(lexer, slice, lexeme->value, &length)) {
+        lexeme->value[0] = '\0';
+    }
+}
+
+static void lexemes_free(LexemeList* list) {
+    for (size_t i = 0; i < list->count; i++) free(list->items[i].value);
+    free(list->items);
+}
+
+/* Slices of the whole document in one buffer */
+static void lex_whole(const char* data, size_t length, LexemeList* out) {
+    memset(out, 0, sizeof(*out));
+    Lexer* lexer = lexer_create(NULL);
+    lexer_init(lexer, data, length);
+    TokenSlice slice;
+    do {
+        if (!lexer_next_slice(lexer, &slice)) break;
+        lexemes_push(out, lexer, &slice);
+    } while (slice.type != TOKEN_EOF);
+    out->errors = lexer_error_count(lexer);
+    lexer_destroy(lexer);
+}
+
+/* Slices of the document fed in random chunks of 1..max_chunk bytes;
+ * each slice is decoded before the next feed releases its bytes */
+static void lex_chunked(const char* data, size_t length, uint32_t seed, size_t max_chunk,
+                        LexemeList* out) {
+    memset(out, 0, sizeof(*out));
+    Lexer* lexer = lexer_create(NULL);
+    lexer_init(lexer, "", 0);
+    TokenSlice slice;
+    size_t fed = 0;
+
+    while (fed < length) {
+        size_t chunk = 1 + next_random(&seed) % max_chunk;
+        if (chunk > length - fed) chunk = length - fed;
+        lexer_feed(lexer, data + fed, chunk);
+        fed += chunk;
+        while (lexer_next_slice(lexer, &slice)) {
+            lexemes_push(out, lexer, &slice);
+        }
+    }
+
+    lexer_end_input(lexer);
+    do {
+        if (!lexer_next_slice(lexer, &slice)) break;
+        lexemes_push(out, lexer, &slice);
+    } while (slice.type != TOKEN_EOF);
+    out->errors = lexer_error_count(lexer);
+    lexer_destroy(lexer);
+}
+
+static int same_lexemes(const LexemeList* a, const LexemeList* b) {
+    if (a->count != b->count || a->errors != b->errors) return 0;
+    for (size_t i = 0; i < a->count; i++) {
+        const TokenSlice* x = &a->items[i].slice;
+        const TokenSlice* y = &b->items[i].slice;
+        if (x->type != y->type || x->flags != y->flags || x->offset != y->offset ||
+            x->length != y->length || x->line != y->line || x->column != y->column ||
+            strcmp(a->items[i].value, b->items[i].value) != 0) {
+            printf("\n  slice %zu: %d '%s' %zu:%zu vs %d '%s' %zu:%zu", i,
+                   x->type, a->items[i].value, x->line, x->column,
+                   y->type, b->items[i].value, y->line, y->column);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Test cases */
+
+TEST(chunked_slices_match_whole_buffer) {
+    const size_t max_chunks[] = {1, 7, 67};
+
+    for (size_t f = 0; f < FIXTURE_COUNT; f++) {
+        size_t length;
+        char* data = read_file(fixtures[f].path, &length);
+        ASSERT(data != NULL);
+
+        LexemeList whole;
+        lex_whole(data, length, &whole);
+        int ok = whole.count > 0 && whole.items[whole.count - 1].slice.type == TOKEN_EOF;
+
+        for (size_t m = 0; ok && m < sizeof(max_chunks) / sizeof(max_chunks[0]); m++) {
+            for (uint32_t seed = 1; ok && seed <= 8; seed++) {
+                LexemeList chunked;
+                lex_chunked(data, length, seed * 2654435761u, max_chunks[m], &chunked);
+                ok = same_lexemes(&whole, &chunked);
+                if (!ok) {
+                    printf("\n  %s: chunks of up to %zu bytes, seed %u",
+                           fixtures[f].path, max_chunks[m], seed);
+                }
+                lexemes_free(&chunked);
+            }
+        }
+
+        lexemes_free(&whole);
+        free(data);
+        ASSERT(ok);
+    }
+}
+
+TEST(chunked_slices_match_classic_tokens) {
+    for (size_t f = 0; f < FIXTURE_COUNT; f++) {
+        if (!fixtures[f].classic) continue;
+
+        size_t length;
+        char* data = read_file(fixtures[f].path, &length);
+        ASSERT(data != NULL);
+
+        LexemeList chunked;
+        lex_chunked(data, length, 0x9E3779B9u, 5, &chunked);
+
+        Lexer* lexer = lexer_create(NULL);
+        lexer_init(lexer, data, length);
+        int ok = 1;
+        size_t i = 0;
+        for (;;) {
+            Token* token = lexer_next_token(lexer);
+            const Lexeme* lexeme = i < chunked.count ? &chunked.items[i] : NULL;
+            bool eof = token->type == TOKEN_EOF;
+
+            /* The classic EOF token carries no position */
+            if (!lexeme || token->type != lexeme->slice.type ||
+                (!eof && (strcmp(token->value ? token->value : "", lexeme->value) != 0 ||
+                          token->line != lexeme->slice.line ||
+                          token->column != lexeme->slice.column))) {
+                printf("\n  %s token %zu: %d '%s' %zu:%zu", fixtures[f].path, i,
+                       token->type, token->value ? token->value : "", token->line, token->column);
+                ok = 0;
+            }
+            token_free(token);
+            i++;
+            if (eof || !ok) break;
+        }
+        ok = ok && i == chunked.count && lexer_error_count(lexer) == chunked.errors;
+
+        lexer_destroy(lexer);
+        lexemes_free(&chunked);
+        free(data);
+        ASSERT(ok);
+    }
+}
+
+int main(void) {
+    printf("Slice Lexer Test Suite\n");
+    printf("======================\n\n");
+
+    RUN_TEST(chunked_slices_match_whole_buffer);
+    RUN_TEST(chunked_slices_match_classic_tokens);
+
+    printf("\n======================\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,492 @@
+/**
+ * @file test_streaming_parser.c
+ * @brief Streaming parser chunked-feed regression tests
+ *
+ * The bundled .ttl files are fed to ttl_streaming_parser_feed() in small
+ * random chunks. The streamed triples and errors must match one feed of
+ * the whole document, and, for documents the AST parser reads without
+ * errors, the triples obtained by expanding its AST (prefixed names, 'a',
+ * literal datatypes, blank node property lists and collections). Blank
+ * nodes are compared up to renaming (first-appearance order).
+ */
+
+#include "../include/parser.h"
+#include "../include/ast.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Test result tracking */
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Test macros */
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    printf("Running %s... ", #name); \
+    fflush(stdout); \
+    tests_run++; \
+    int failed_before = tests_failed; \
+    test_##name(); \
+    if (tests_failed == failed_before) { \
+        tests_passed++; \
+        printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        printf("FAILED\n  Assertion failed: %s\n  at %s:%d\n", \
+               #cond, __FILE__, __LINE__); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define ASSERT_EQ(a, b) ASSERT((a) == (b))
+
+#define RDF_NS "http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+#define XSD_NS "http://www.w3.org/2001/XMLSchema#"
+
+/* Bundled documents; the AST parser rejects parts of the last three */
+static const struct {
+    const char* path;
+    bool ast;
+} fixtures[] = {
+    {"tests/fixtures/simple.ttl", true},
+    {"tests/fixtures/complex.ttl", true},
+    {"tests/fixtures/large.ttl", true},
+    {"tests/fixtures/unicode.ttl", true},
+    {"examples/simple.ttl", true},
+    {"examples/sample_query.ttl", true},
+    {"tests/fixtures/edge_cases.ttl", false},
+    {"tests/fixtures/invalid.ttl", false},
+    {"examples/grammar-examples.ttl", false},
+};
+
+#define FIXTURE_COUNT (sizeof(fixtures) / sizeof(fixtures[0]))
+
+static char* read_file(const char* path, size_t* length) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+    char* data = malloc((size_t)size + 1);
+    *length = fread(data, 1, (size_t)size, file);
+    data[*length] = '\0';
+    fclose(file);
+    return data;
+}
+
+/* Deterministic chunk sizes */
+static uint32_t next_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/* Growable text buffer */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} Text;
+
+static void text_append(Text* text, const char* s, size_t length) {
+    if (text->length + length + 1 > text->capacity) {
+        size_t capacity = text->capacity ? text->capacity * 2 : 4096;
+        while (capacity < text->length + length + 1) capacity *= 2;
+        text->data = realloc(text->data, capacity);
+        text->capacity = capacity;
+    }
+    memcpy(text->data + text->length, s, length);
+    text->length += length;
+    text->data[text->length] = '\0';
+}
+
+/* Collected triples, one canonical line each */
+typedef struct {
+    Text lines;
+    size_t triples;
+    size_t errors;
+    char (*blank_labels)[64];
+    size_t blank_count;
+} Collector;
+
+/* Blank nodes become _:bN in order of first appearance */
+static void append_term(Collector* c, const char* term, TripleTermKind kind) {
+    if (kind != TRIPLE_TERM_BLANK_NODE) {
+        text_append(&c->lines, term, strlen(term));
+        return;
+    }
+    size_t index = 0;
+    while (index < c->blank_count && strcmp(c->blank_labels[index], term) != 0) index++;
+    if (index == c->blank_count) {
+        c->blank_labels = realloc(c->blank_labels, (c->blank_count + 1) * sizeof(*c->blank_labels));
+        snprintf(c->blank_labels[c->blank_count++], 64, "%s", term);
+    }
+    char label[32];
+    int length = snprintf(label, sizeof(label), "_:b%zu", index);
+    text_append(&c->lines, label, (size_t)length);
+}
+
+static void collect_triples(void* data, const StreamingTriple* triples, size_t count) {
+    Collector* c = (Collector*)data;
+    for (size_t i = 0; i < count; i++) {
+        const StreamingTriple* t = &triples[i];
+        append_term(c, t->subject, t->subject_kind);
+        text_append(&c->lines, " ", 1);
+        text_append(&c->lines, t->predicate, strlen(t->predicate));
+        text_append(&c->lines, " ", 1);
+        append_term(c, t->object, t->object_kind);
+        if (t->datatype) {
+            text_append(&c->lines, "^^", 2);
+            text_append(&c->lines, t->datatype, strlen(t->datatype));
+        }
+        if (t->lang) {
+            text_append(&c->lines, "@", 1);
+            text_append(&c->lines, t->lang, strlen(t->lang));
+        }
+        text_append(&c->lines, "\n", 1);
+    }
+    c->triples += count;
+}
+
+static void collect_error(void* data, const ParseError* error) {
+    (void)error;
+    ((Collector*)data)->errors++;
+}
+
+static void collector_free(Collector* c) {
+    free(c->lines.data);
+    free(c->blank_labels);
+}
+
+static int same_collection(const Collector* a, const Collector* b) {
+    return a->triples == b->triples && a->errors == b->errors &&
+           a->lines.length == b->lines.length &&
+           (a->lines.length == 0 || memcmp(a->lines.data, b->lines.data, a->lines.length) == 0);
+}
+
+/* Stream the document in random chunks of 1..max_chunk bytes (0 = one feed) */
+static void stream_collect(const char* data, size_t length, uint32_t seed, size_t max_chunk,
+                           Collector* out) {
+    memset(out, 0, sizeof(*out));
+    StreamingCallbacks callbacks = {
+        .user_data = out,
+        .on_triples = collect_triples,
+        .on_error = collect_error
+    };
+    StreamingParser* parser = ttl_streaming_parser_create(&callbacks, NULL);
+
+    size_t fed = 0;
+    while (fed < length) {
+        size_t chunk = max_chunk ? 1 + next_random(&seed) % max_chunk : length;
+        if (chunk > length - fed) chunk = length - fed;
+        ttl_streaming_parser_feed(parser, data + fed, chunk);
+        fed += chunk;
+    }
+
+    ttl_streaming_parser_end(parser);
+    ttl_streaming_parser_destroy(parser);
+}
+
+/* ------------------------------------------------------------------------
+ * Reference triples from the AST
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    const char* value;
+    const char* datatype;
+    const char* lang;
+    TripleTermKind kind;
+} RefTerm;
+
+typedef struct {
+    Collector* out;
+    const char* base;
+    const char* prefix_names[64];
+    const char* prefix_iris[64];
+    size_t prefix_count;
+    unsigned fresh;
+    char** owned;
+    size_t owned_count;
+    bool failed;
+} Reference;
+
+static const char* ref_concat(Reference* r, const char* a, const char* b) {
+    size_t a_length = strlen(a);
+    size_t b_length = strlen(b);
+    char* s = malloc(a_length + b_length + 1);
+    memcpy(s, a, a_length);
+    memcpy(s + a_length, b, b_length + 1);
+    r->owned = realloc(r->owned, (r->owned_count + 1) * sizeof(char*));
+    r->owned[r->owned_count++] = s;
+    return s;
+}
+
+static const char* ref_fresh_blank(Reference* r) {
+    char label[32];
+    snprintf(label, sizeof(label), "_:ref%u", r->fresh++);
+    return ref_concat(r, label, "");
+}
+
+/* IRIs with a scheme are absolute; the fixtures only append to @base */
+static const char* ref_resolve(Reference* r, const char* iri) {
+    const char* p = iri;
+    while (*p && *p != ':' && *p != '/' && *p != '?' && *p != '#') p++;
+    if (*p == ':' || !r->base) return ref_concat(r, iri, "");
+    return ref_concat(r, r->base, iri);
+}
+
+static const char* ref_iri(Reference* r, const ttl_ast_node_t* node) {
+    if (!node) return NULL;
+    switch (node->type) {
+        case TTL_AST_RDF_TYPE:
+            return RDF_NS "type";
+        case TTL_AST_IRI:
+            return ref_resolve(r, node->data.iri.value);
+        case TTL_AST_PREFIXED_NAME:
+            for (size_t i = r->prefix_count; i-- > 0;) {
+                if (strcmp(r->prefix_names[i], node->data.prefixed_name.prefix) == 0) {
+                    return ref_concat(r, r->prefix_iris[i], node->data.prefixed_name.local_name);
+                }
+            }
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
+static void ref_emit(Reference* r, const RefTerm* subject, const char* predicate,
+                     const RefTerm* object) {
+    if (!subject->value || !predicate || !object->value) {
+        r->failed = true;
+        return;
+    }
+    StreamingTriple triple = {
+        .subject = subject->value,
+        .predicate = predicate,
+        .object = object->value,
+        .datatype = object->datatype,
+        .lang = object->lang,
+        .subject_kind = subject->kind,
+        .object_kind = object->kind
+    };
+    collect_triples(r->out, &triple, 1);
+}
+
+static RefTerm ref_term(Reference* r, const ttl_ast_node_t* node);
+
+static void ref_predicate_objects(Reference* r, const RefTerm* subject,
+                                  const ttl_ast_node_t* po_list) {
+    if (!po_list) return;
+    for (size_t i = 0; i + 1 < po_list->data.predicate_object_list.item_count; i += 2) {
+        const char* predicate = ref_iri(r, po_list->data.predicate_object_list.items[i]);
+        const ttl_ast_node_t* objects = po_list->data.predicate_object_list.items[i + 1];
+        if (objects->type == TTL_AST_OBJECT_LIST) {
+            for (size_t j = 0; j < objects->data.object_list.object_count; j++) {
+                RefTerm object = ref_term(r, objects->data.object_list.objects[j]);
+                ref_emit(r, subject, predicate, &object);
+            }
+        } else {
+            RefTerm object = ref_term(r, objects);
+            ref_emit(r, subject, predicate, &object);
+        }
+    }
+}
+
+/* Term for a node; nested property lists and collections are emitted
+ * first, in the order the streaming parser flattens them */
+static RefTerm ref_term(Reference* r, const ttl_ast_node_t* node) {
+    RefTerm term = {NULL, NULL, NULL, TRIPLE_TERM_LITERAL};
+    if (!node) return term;
+
+    switch (node->type) {
+        case TTL_AST_IRI:
+        case TTL_AST_PREFIXED_NAME:
+        case TTL_AST_RDF_TYPE:
+            term.value = ref_iri(r, node);
+            term.kind = TRIPLE_TERM_IRI;
+            break;
+        case TTL_AST_BLANK_NODE_LABEL:
+            term.value = ref_concat(r, "_:", node->data.blank_node.label);
+            term.kind = TRIPLE_TERM_BLANK_NODE;
+            break;
+        case TTL_AST_BLANK_NODE:
+            term.value = ref_fresh_blank(r);
+            term.kind = TRIPLE_TERM_BLANK_NODE;
+            break;
+        case TTL_AST_BLANK_NODE_PROPERTY_LIST:
+            term.value = ref_fresh_blank(r);
+            term.kind = TRIPLE_TERM_BLANK_NODE;
+            ref_predicate_objects(r, &term, node->data.blank_node_property_list.predicate_object_list);
+            break;
+        case TTL_AST_COLLECTION: {
+            size_t count = node->data.collection.item_count;
+            if (count == 0) {
+                term.value = RDF_NS "nil";
+                term.kind = TRIPLE_TERM_IRI;
+                break;
+            }
+            term.value = ref_fresh_blank(r);
+            term.kind = TRIPLE_TERM_BLANK_NODE;
+            RefTerm cell = term;
+            for (size_t i = 0; i < count; i++) {
+                RefTerm item = ref_term(r, node->data.collection.items[i]);
+                ref_emit(r, &cell, RDF_NS "first", &item);
+                RefTerm rest = {RDF_NS "nil", NULL, NULL, TRIPLE_TERM_IRI};
+                if (i + 1 < count) {
+                    rest.value = ref_fresh_blank(r);
+                    rest.kind = TRIPLE_TERM_BLANK_NODE;
+                }
+                ref_emit(r, &cell, RDF_NS "rest", &rest);
+                cell = rest;
+            }
+            break;
+        }
+        case TTL_AST_STRING_LITERAL:
+            term.value = node->data.string_literal.value;
+            break;
+        case TTL_AST_NUMERIC_LITERAL:
+            term.value = node->data.numeric_literal.lexical_form;
+            term.datatype = node->data.numeric_literal.numeric_type == TTL_NUMERIC_INTEGER
+                ? XSD_NS "integer"
+                : node->data.numeric_literal.numeric_type == TTL_NUMERIC_DECIMAL
+                    ? XSD_NS "decimal" : XSD_NS "double";
+            break;
+        case TTL_AST_BOOLEAN_LITERAL:
+            term.value = node->data.boolean_literal.value ? "true" : "false";
+            term.datatype = XSD_NS "boolean";
+            break;
+        case TTL_AST_TYPED_LITERAL:
+            term = ref_term(r, node->data.typed_literal.value);
+            term.datatype = ref_iri(r, node->data.typed_literal.datatype);
+            break;
+        case TTL_AST_LANG_LITERAL:
+            term = ref_term(r, node->data.lang_literal.value);
+            term.lang = node->data.lang_literal.language_tag;
+            break;
+        default:
+            r->failed = true;
+            break;
+    }
+    return term;
+}
+
+/* Expand the AST of a document; false if it parsed with errors */
+static bool ast_collect(const char* data, size_t length, Collector* out) {
+    memset(out, 0, sizeof(*out));
+    ParserOptions options = ttl_parser_default_options();
+    Parser* parser = ttl_parser_create(data, length, &options);
+    ttl_ast_node_t* document = parser ? ttl_parser_parse(parser) : NULL;
+    if (!document || ttl_parser_has_errors(parser)) {
+        ttl_parser_destroy(parser);
+        return false;
+    }
+
+    Reference r = {.out = out};
+    for (size_t i = 0; i < document->data.document.statement_count; i++) {
+        const ttl_ast_node_t* statement = document->data.document.statements[i];
+        switch (statement->type) {
+            case TTL_AST_PREFIX_DIRECTIVE:
+                if (r.prefix_count < 64) {
+                    r.prefix_names[r.prefix_count] = statement->data.directive.prefix->data.prefixed_name.prefix;
+                    r.prefix_iris[r.prefix_count++] = ref_resolve(&r, statement->data.directive.iri->data.iri.value);
+                }
+                break;
+            case TTL_AST_BASE_DIRECTIVE:
+                r.base = ref_resolve(&r, statement->data.directive.iri->data.iri.value);
+                break;
+            case TTL_AST_TRIPLE: {
+                RefTerm subject = ref_term(&r, statement->data.triple.subject);
+                ref_predicate_objects(&r, &subject, statement->data.triple.predicate_object_list);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    for (size_t i = 0; i < r.owned_count; i++) free(r.owned[i]);
+    free(r.owned);
+    ttl_parser_destroy(parser);
+    return !r.failed;
+}
+
+/* Test cases */
+
+TEST(chunked_feed_matches_single_feed) {
+    const size_t max_chunks[] = {1, 7, 67};
+
+    for (size_t f = 0; f < FIXTURE_COUNT; f++) {
+        size_t length;
+        char* data = read_file(fixtures[f].path, &length);
+        ASSERT(data != NULL);
+
+        Collector whole;
+        stream_collect(data, length, 0, 0, &whole);
+        int ok = whole.triples > 0;
+
+        for (size_t m = 0; ok && m < sizeof(max_chunks) / sizeof(max_chunks[0]); m++) {
+            for (uint32_t seed = 1; ok && seed <= 8; seed++) {
+                Collector chunked;
+                stream_collect(data, length, seed * 2654435761u, max_chunks[m], &chunked);
+                ok = same_collection(&whole, &chunked);
+                if (!ok) {
+                    printf("\n  %s: chunks of up to %zu bytes, seed %u: %zu/%zu triples, "
+                           "%zu/%zu errors", fixtures[f].path, max_chunks[m], seed,
+                           chunked.triples, whole.triples, chunked.errors, whole.errors);
+                }
+                collector_free(&chunked);
+            }
+        }
+
+        collector_free(&whole);
+        free(data);
+        ASSERT(ok);
+    }
+}
+
+TEST(chunked_feed_matches_ast) {
+    for (size_t f = 0; f < FIXTURE_COUNT; f++) {
+        if (!fixtures[f].ast) continue;
+
+        size_t length;
+        char* data = read_file(fixtures[f].path, &length);
+        ASSERT(data != NULL);
+
+        Collector reference, chunked;
+        bool parsed = ast_collect(data, length, &reference);
+        stream_collect(data, length, 0x9E3779B9u, 5, &chunked);
+
+        int ok = parsed && chunked.errors == 0 && same_collection(&reference, &chunked);
+        if (!ok) {
+            printf("\n  %s: %zu streamed triples, %zu from the AST", fixtures[f].path,
+                   chunked.triples, reference.triples);
+        }
+
+        collector_free(&reference);
+        collector_free(&chunked);
+        free(data);
+        ASSERT(ok);
+    }
+}
+
+int main(void) {
+    printf("Streaming Parser Test Suite\n");
+    printf("===========================\n\n");
+
+    RUN_TEST(chunked_feed_matches_single_feed);
+    RUN_TEST(chunked_feed_matches_ast);
+
+    printf("\n===========================\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
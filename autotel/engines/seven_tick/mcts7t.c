@@ -3,7 +3,6 @@
 #include <string.h>
 #include <time.h>
 #include <pthread.h>
-#include <immintrin.h>
 
 // Default configuration
 const MCTSConfig MCTS7T_DEFAULT_CONFIG = {
@@ -16,8 +15,14 @@ const MCTSConfig MCTS7T_DEFAULT_CONFIG = {
     .enable_parallel = false,
     .num_threads = 1};
 
-// Global statistics
-static MCTSStats global_stats = {0};
+// Actions available in every state: SPARQL, SHACL, OWL
+static const MCTSAction mcts7t_actions[] = {
+    {.action_id = 1, .action_type = 1, .estimated_cost = 1.44, .estimated_reward = 0.8}, // 1.44ns from benchmarks
+    {.action_id = 2, .action_type = 2, .estimated_cost = 1.43, .estimated_reward = 0.7}, // 1.43ns from benchmarks
+    {.action_id = 3, .action_type = 3, .estimated_cost = 2.0, .estimated_reward = 0.9},  // Estimated
+};
+#define MCTS_ACTION_COUNT (sizeof(mcts7t_actions) / sizeof(mcts7t_actions[0]))
+_Static_assert(MCTS_ACTION_COUNT <= MCTS_MAX_ACTIONS, "child arrays are sized by MCTS_MAX_ACTIONS");
 
 // Fast random number generator (xorshift64*)
 static inline uint64_t xorshift64star(uint64_t *state)
@@ -30,6 +35,79 @@ static inline uint64_t xorshift64star(uint64_t *state)
   return x * 0x2545F4914F6CDD1DULL;
 }
 
+// Arena allocation
+void mcts7t_arena_init(MCTSArena *arena, size_t chunk_size)
+{
+  arena->head = NULL;
+  arena->chunk_size = chunk_size ? chunk_size : MCTS_ARENA_CHUNK_SIZE;
+  arena->bytes_allocated = 0;
+}
+
+void *mcts7t_arena_alloc(MCTSArena *arena, size_t size)
+{
+  size = (size + 15) & ~(size_t)15;
+
+  MCTSArenaChunk *chunk = arena->head;
+  if (!chunk || chunk->used + size > chunk->size)
+  {
+    size_t chunk_size = size > arena->chunk_size ? size : arena->chunk_size;
+    chunk = malloc(sizeof(MCTSArenaChunk) + chunk_size);
+    if (!chunk)
+      return NULL;
+    chunk->next = arena->head;
+    chunk->used = 0;
+    chunk->size = chunk_size;
+    arena->head = chunk;
+  }
+
+  void *ptr = chunk->data + chunk->used;
+  chunk->used += size;
+  arena->bytes_allocated += size;
+  return ptr;
+}
+
+void mcts7t_arena_free(MCTSArena *arena)
+{
+  MCTSArenaChunk *chunk = arena->head;
+  while (chunk)
+  {
+    MCTSArenaChunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  arena->head = NULL;
+  arena->bytes_allocated = 0;
+}
+
+// Worker setup: private RNG stream, arena and simulation scratch
+static bool mcts7t_worker_prepare(MCTS7TEngine *mcts, uint32_t index, size_t state_size)
+{
+  MCTSWorker *worker = &mcts->workers[index];
+  memset(&worker->stats, 0, sizeof(worker->stats));
+  worker->mcts = mcts;
+  worker->root = NULL;
+  worker->iterations = 0;
+  worker->shared_tree = false;
+  worker->rng_state = mcts->config.rng_seed ^ ((uint64_t)(index + 1) * 0x9E3779B97F4A7C15ULL);
+  if (worker->rng_state == 0)
+    worker->rng_state = 0x9E3779B97F4A7C15ULL; // xorshift must not start at 0
+  mcts7t_arena_init(&worker->arena, MCTS_ARENA_CHUNK_SIZE);
+  worker->scratch = mcts7t_arena_alloc(&worker->arena, state_size * sizeof(uint32_t));
+  return worker->scratch != NULL;
+}
+
+// Free every node from the previous search in one pass over the chunks
+static void mcts7t_release_search(MCTS7TEngine *mcts)
+{
+  for (uint32_t i = 0; i < mcts->worker_count; i++)
+  {
+    mcts7t_arena_free(&mcts->workers[i].arena);
+  }
+  mcts7t_arena_free(&mcts->result_arena);
+  mcts->worker_count = 0;
+  mcts->root = NULL;
+}
+
 // Create MCTS engine
 MCTS7TEngine *mcts7t_create(EngineState *engine, MCTSConfig *config)
 {
@@ -39,15 +117,27 @@ MCTS7TEngine *mcts7t_create(EngineState *engine, MCTSConfig *config)
 
   // Copy configuration
   mcts->config = config ? *config : MCTS7T_DEFAULT_CONFIG;
+  mcts->parallel_mode = MCTS_PARALLEL_TREE;
   mcts->engine = engine;
+  mcts7t_arena_init(&mcts->result_arena, MCTS_ARENA_CHUNK_SIZE);
 
-  // Initialize RNG
-  mcts->rng_state = malloc(sizeof(uint64_t));
-  *mcts->rng_state = mcts->config.rng_seed;
-
-  // Initialize root node with empty state
+  // Initialize root node with empty state, ready for mcts7t_step
   uint32_t empty_state[1] = {0};
-  mcts->root = mcts7t_create_node(empty_state, 1, 0, NULL);
+  mcts->worker_count = 1;
+  if (!mcts7t_worker_prepare(mcts, 0, 1))
+  {
+    mcts7t_destroy(mcts);
+    return NULL;
+  }
+  mcts->root = mcts7t_create_node(&mcts->workers[0].arena, empty_state, 1, 0, NULL);
+  if (!mcts->root)
+  {
+    mcts7t_destroy(mcts);
+    return NULL;
+  }
+  mcts->root->engine_state = engine;
+  mcts->workers[0].root = mcts->root;
+  mcts->start_time_ns = mcts7t_get_time_ns();
 
   return mcts;
 }
@@ -58,112 +148,118 @@ void mcts7t_destroy(MCTS7TEngine *mcts)
   if (!mcts)
     return;
 
-  if (mcts->root)
-  {
-    mcts7t_destroy_node(mcts->root);
-  }
-
-  free(mcts->rng_state);
+  mcts7t_release_search(mcts);
   free(mcts);
 }
 
-// Create MCTS node
-MCTSNode *mcts7t_create_node(uint32_t *state, size_t state_size, uint32_t depth, MCTSNode *parent)
+void mcts7t_set_parallel_mode(MCTS7TEngine *mcts, MCTSParallelMode mode)
 {
-  MCTSNode *node = calloc(1, sizeof(MCTSNode));
+  if (mcts)
+    mcts->parallel_mode = mode;
+}
+
+// Create MCTS node. The node, its child array and its state vector share one
+// arena allocation. The node is not linked until mcts7t_add_child publishes it.
+MCTSNode *mcts7t_create_node(MCTSArena *arena, const uint32_t *state, size_t state_size,
+                             uint32_t depth, MCTSNode *parent)
+{
+  size_t bytes = sizeof(MCTSNode) + MCTS_MAX_ACTIONS * sizeof(MCTSNode *) +
+                 state_size * sizeof(uint32_t);
+  MCTSNode *node = mcts7t_arena_alloc(arena, bytes);
   if (!node)
     return NULL;
+  memset(node, 0, sizeof(MCTSNode));
 
-  // Copy state
-  node->state_vector = malloc(state_size * sizeof(uint32_t));
+  node->children = (MCTSNode **)(node + 1);
+  node->child_capacity = MCTS_MAX_ACTIONS;
+  node->state_vector = (uint32_t *)(node->children + MCTS_MAX_ACTIONS);
   memcpy(node->state_vector, state, state_size * sizeof(uint32_t));
   node->state_size = state_size;
   node->depth = depth;
   node->parent = parent;
+  node->engine_state = parent ? parent->engine_state : NULL;
 
   // Initialize statistics
-  node->total_reward = 0.0;
-  node->visit_count = 0;
-  node->average_reward = 0.0;
+  atomic_init(&node->total_reward, 0.0);
+  atomic_init(&node->visit_count, 0);
+  atomic_init(&node->virtual_loss, 0);
+  atomic_init(&node->child_count, 0);
+  atomic_flag_clear(&node->expanding);
 
-  // Initialize children array
-  node->child_capacity = 16;
-  node->children = calloc(node->child_capacity, sizeof(MCTSNode *));
-
-  // Link to parent
-  if (parent)
-  {
-    mcts7t_add_child(parent, node);
-  }
-
-  global_stats.nodes_created++;
   return node;
 }
 
-// Destroy MCTS node
-void mcts7t_destroy_node(MCTSNode *node)
+// Add child to parent. Concurrent callers must hold parent->expanding.
+bool mcts7t_add_child(MCTSNode *parent, MCTSNode *child)
 {
-  if (!node)
-    return;
+  if (!parent || !child)
+    return false;
 
-  // Destroy children
-  for (size_t i = 0; i < node->child_count; i++)
-  {
-    mcts7t_destroy_node(node->children[i]);
-  }
+  size_t count = atomic_load_explicit(&parent->child_count, memory_order_relaxed);
+  if (count >= parent->child_capacity)
+    return false;
 
-  free(node->state_vector);
-  free(node->children);
-  free(node->pattern_order);
-  free(node);
+  child->parent = parent;
+  parent->children[count] = child;
+  atomic_store_explicit(&parent->child_count, count + 1, memory_order_release);
+  return true;
 }
 
-// Add child to parent
-void mcts7t_add_child(MCTSNode *parent, MCTSNode *child)
+// Visits including playouts still in flight; pending ones count as zero reward
+static inline uint64_t mcts7t_effective_visits(MCTSNode *node)
 {
-  if (!parent || !child)
-    return;
-
-  // Expand capacity if needed
-  if (parent->child_count >= parent->child_capacity)
-  {
-    parent->child_capacity *= 2;
-    parent->children = realloc(parent->children,
-                               parent->child_capacity * sizeof(MCTSNode *));
-  }
+  return atomic_load_explicit(&node->visit_count, memory_order_relaxed) +
+         atomic_load_explicit(&node->virtual_loss, memory_order_relaxed);
+}
 
-  parent->children[parent->child_count++] = child;
-  child->parent = parent;
+double mcts7t_node_mean(MCTSNode *node)
+{
+  uint64_t visits = atomic_load_explicit(&node->visit_count, memory_order_relaxed);
+  return visits ? atomic_load_explicit(&node->total_reward, memory_order_relaxed) / visits : 0.0;
 }
 
 // UCB score calculation
 double mcts7t_ucb_score(MCTSNode *node, double exploration_constant)
 {
-  if (node->visit_count == 0)
+  uint64_t visits = mcts7t_effective_visits(node);
+  if (visits == 0)
     return DBL_MAX;
 
-  double exploitation = node->average_reward;
+  double exploitation = atomic_load_explicit(&node->total_reward, memory_order_relaxed) / visits;
   double exploration = exploration_constant *
-                       sqrt(log(node->parent->visit_count) / node->visit_count);
+                       sqrt(log((double)mcts7t_effective_visits(node->parent)) / visits);
 
   return exploitation + exploration;
 }
 
-// Selection phase
-MCTSNode *mcts7t_select(MCTS7TEngine *mcts, MCTSNode *node)
+static inline void mcts7t_add_virtual_loss(MCTSWorker *worker, MCTSNode *node)
+{
+  if (worker->shared_tree)
+    atomic_fetch_add_explicit(&node->virtual_loss, MCTS_VIRTUAL_LOSS, memory_order_relaxed);
+}
+
+// Selection phase: descend through fully expanded nodes
+MCTSNode *mcts7t_select(MCTSWorker *worker, MCTSNode *node)
 {
   uint64_t start_time = mcts7t_get_time_ns();
+  size_t action_count;
+  mcts7t_generate_actions(node, &action_count);
 
-  while (node->child_count > 0 && !mcts7t_is_terminal(node->state_vector, node->state_size))
+  mcts7t_add_virtual_loss(worker, node);
+  while (!mcts7t_is_terminal(node->state_vector, node->state_size))
   {
+    size_t child_count = atomic_load_explicit(&node->child_count, memory_order_acquire);
+    if (child_count == 0 || child_count < action_count)
+      break; // Untried actions left: expand here
+
     MCTSNode *best_child = NULL;
     double best_score = -DBL_MAX;
 
     // Find child with highest UCB score
-    for (size_t i = 0; i < node->child_count; i++)
+    for (size_t i = 0; i < child_count; i++)
     {
       MCTSNode *child = node->children[i];
-      double score = mcts7t_ucb_score(child, mcts->config.exploration_constant);
+      double score = mcts7t_ucb_score(child, worker->mcts->config.exploration_constant);
 
       if (score > best_score)
       {
@@ -175,265 +271,383 @@ MCTSNode *mcts7t_select(MCTS7TEngine *mcts, MCTSNode *node)
     if (!best_child)
       break;
     node = best_child;
+    mcts7t_add_virtual_loss(worker, node);
   }
 
-  global_stats.selection_time_ns += mcts7t_get_time_ns() - start_time;
+  worker->stats.selection_time_ns += mcts7t_get_time_ns() - start_time;
   return node;
 }
 
-// Expansion phase
-MCTSNode *mcts7t_expand(MCTS7TEngine *mcts, MCTSNode *node)
+// Expansion phase: add the next untried action. If another thread is
+// already expanding this node, play out from the node itself instead.
+MCTSNode *mcts7t_expand(MCTSWorker *worker, MCTSNode *node)
 {
   uint64_t start_time = mcts7t_get_time_ns();
+  MCTSNode *child = node;
 
-  // Check if we can expand
-  if (node->depth >= mcts->config.max_depth)
-  {
-    global_stats.expansion_time_ns += mcts7t_get_time_ns() - start_time;
-    return node;
-  }
-
-  // Generate possible actions
   size_t action_count;
-  MCTSAction *actions = mcts7t_generate_actions(node, &action_count);
+  const MCTSAction *actions = mcts7t_generate_actions(node, &action_count);
 
-  if (action_count == 0)
+  if (node->depth < worker->mcts->config.max_depth && action_count > 0 &&
+      !mcts7t_is_terminal(node->state_vector, node->state_size) &&
+      !atomic_flag_test_and_set_explicit(&node->expanding, memory_order_acquire))
   {
-    global_stats.expansion_time_ns += mcts7t_get_time_ns() - start_time;
-    return node;
+    size_t tried = atomic_load_explicit(&node->child_count, memory_order_relaxed);
+    if (tried < action_count)
+    {
+      const MCTSAction *action = &actions[tried];
+      MCTSNode *created = mcts7t_create_node(&worker->arena, node->state_vector, node->state_size,
+                                             node->depth + 1, node);
+      if (created)
+      {
+        mcts7t_apply_action(created->state_vector, created->state_size, action);
+        created->action_id = action->action_id;
+        created->action_cost = action->estimated_cost;
+        mcts7t_add_child(node, created);
+        mcts7t_add_virtual_loss(worker, created);
+        worker->stats.nodes_created++;
+        child = created;
+      }
+    }
+    atomic_flag_clear_explicit(&node->expanding, memory_order_release);
   }
 
-  // Select random action
-  uint32_t action_idx = mcts7t_random_uint32(mcts->rng_state) % action_count;
-  MCTSAction *action = &actions[action_idx];
-
-  // Apply action to create new state
-  uint32_t *new_state = mcts7t_apply_action(node->state_vector, node->state_size, action);
-
-  // Create child node
-  MCTSNode *child = mcts7t_create_node(new_state, node->state_size, node->depth + 1, node);
-  child->action_id = action->action_id;
-  child->action_cost = action->action_cost;
-
-  free(new_state);
-  mcts7t_destroy_actions(actions, action_count);
-
-  global_stats.expansion_time_ns += mcts7t_get_time_ns() - start_time;
+  worker->stats.expansion_time_ns += mcts7t_get_time_ns() - start_time;
   return child;
 }
 
 // Simulation phase
-double mcts7t_simulate(MCTS7TEngine *mcts, MCTSNode *node)
+double mcts7t_simulate(MCTSWorker *worker, MCTSNode *node)
 {
   uint64_t start_time = mcts7t_get_time_ns();
 
-  // Create simulation state
-  uint32_t *sim_state = malloc(node->state_size * sizeof(uint32_t));
+  // Simulation state lives in the worker's scratch buffer
+  uint32_t *sim_state = worker->scratch;
   memcpy(sim_state, node->state_vector, node->state_size * sizeof(uint32_t));
 
   double total_reward = 0.0;
   uint32_t simulation_steps = 0;
 
   // Random rollout
-  while (simulation_steps < mcts->config.simulation_depth &&
+  while (simulation_steps < worker->mcts->config.simulation_depth &&
          !mcts7t_is_terminal(sim_state, node->state_size))
   {
-
-    // Generate actions
     size_t action_count;
-    MCTSAction *actions = mcts7t_generate_actions(node, &action_count);
+    const MCTSAction *actions = mcts7t_generate_actions(node, &action_count);
 
     if (action_count == 0)
       break;
 
     // Select random action
-    uint32_t action_idx = mcts7t_random_uint32(mcts->rng_state) % action_count;
-    MCTSAction *action = &actions[action_idx];
-
-    // Apply action
-    uint32_t *new_state = mcts7t_apply_action(sim_state, node->state_size, action);
-    memcpy(sim_state, new_state, node->state_size * sizeof(uint32_t));
-
-    // Calculate reward
-    double reward = mcts7t_calculate_reward(node, action);
-    total_reward += reward;
+    uint32_t action_idx = mcts7t_random_uint32(&worker->rng_state) % action_count;
+    const MCTSAction *action = &actions[action_idx];
 
-    free(new_state);
-    mcts7t_destroy_actions(actions, action_count);
+    // Apply action and calculate reward
+    mcts7t_apply_action(sim_state, node->state_size, action);
+    total_reward += mcts7t_calculate_reward(node, action);
 
     simulation_steps++;
   }
 
-  free(sim_state);
-
-  global_stats.simulation_time_ns += mcts7t_get_time_ns() - start_time;
-  global_stats.simulations_performed++;
+  worker->stats.simulation_time_ns += mcts7t_get_time_ns() - start_time;
+  worker->stats.simulations_performed++;
 
   return total_reward;
 }
 
-// Backpropagation phase
-void mcts7t_backpropagate(MCTS7TEngine *mcts, MCTSNode *node, double reward)
+static inline void mcts7t_atomic_add_double(_Atomic double *target, double value)
+{
+  double current = atomic_load_explicit(target, memory_order_relaxed);
+  while (!atomic_compare_exchange_weak_explicit(target, &current, current + value,
+                                                memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+}
+
+// Backpropagation phase: record the visit and drop the virtual loss
+void mcts7t_backpropagate(MCTSWorker *worker, MCTSNode *node, double reward)
 {
   uint64_t start_time = mcts7t_get_time_ns();
 
   while (node != NULL)
   {
-    node->visit_count++;
-    node->total_reward += reward;
-    node->average_reward = node->total_reward / node->visit_count;
+    if (worker->shared_tree)
+    {
+      atomic_fetch_add_explicit(&node->visit_count, 1, memory_order_relaxed);
+      mcts7t_atomic_add_double(&node->total_reward, reward);
+      atomic_fetch_sub_explicit(&node->virtual_loss, MCTS_VIRTUAL_LOSS, memory_order_relaxed);
+    }
+    else
+    {
+      // Private tree: plain read-modify-write, no bus lock
+      atomic_store_explicit(&node->visit_count,
+                            atomic_load_explicit(&node->visit_count, memory_order_relaxed) + 1,
+                            memory_order_relaxed);
+      atomic_store_explicit(&node->total_reward,
+                            atomic_load_explicit(&node->total_reward, memory_order_relaxed) + reward,
+                            memory_order_relaxed);
+    }
 
-    global_stats.nodes_visited++;
+    worker->stats.nodes_visited++;
     node = node->parent;
   }
 
-  global_stats.backpropagation_time_ns += mcts7t_get_time_ns() - start_time;
+  worker->stats.backpropagation_time_ns += mcts7t_get_time_ns() - start_time;
 }
 
-// Main MCTS step
-bool mcts7t_step(MCTS7TEngine *mcts)
+// Claim one iteration against the shared time and iteration budget
+static bool mcts7t_claim_iteration(MCTS7TEngine *mcts)
 {
-  if (!mcts || !mcts->root)
+  if (mcts7t_get_time_ns() - mcts->start_time_ns > mcts->config.time_budget_ns)
     return false;
+  return atomic_fetch_add_explicit(&mcts->iterations_started, 1, memory_order_relaxed) <
+         mcts->config.max_iterations;
+}
 
-  // Check time budget
-  uint64_t current_time = mcts7t_get_time_ns();
-  if (current_time - mcts->start_time_ns > mcts->config.time_budget_ns)
-  {
-    return false;
-  }
+static void mcts7t_iterate(MCTSWorker *worker)
+{
+  MCTSNode *selected = mcts7t_select(worker, worker->root);
+  MCTSNode *expanded = mcts7t_expand(worker, selected);
+  double reward = mcts7t_simulate(worker, expanded);
+  mcts7t_backpropagate(worker, expanded, reward);
+  worker->iterations++;
+}
 
-  // Check iteration limit
-  if (mcts->iterations_completed >= mcts->config.max_iterations)
+static void *mcts7t_worker_main(void *arg)
+{
+  MCTSWorker *worker = (MCTSWorker *)arg;
+  while (mcts7t_claim_iteration(worker->mcts))
   {
-    return false;
+    mcts7t_iterate(worker);
   }
+  return NULL;
+}
 
-  // MCTS phases
-  MCTSNode *selected = mcts7t_select(mcts, mcts->root);
-  MCTSNode *expanded = mcts7t_expand(mcts, selected);
-  double reward = mcts7t_simulate(mcts, expanded);
-  mcts7t_backpropagate(mcts, expanded, reward);
+// Main MCTS step (single-threaded, on worker 0)
+bool mcts7t_step(MCTS7TEngine *mcts)
+{
+  if (!mcts || !mcts->root || !mcts7t_claim_iteration(mcts))
+    return false;
 
+  mcts7t_iterate(&mcts->workers[0]);
   mcts->iterations_completed++;
   return true;
 }
 
+// Fold a thread's tree into the merged tree, matching children by action
+static void mcts7t_merge_tree(MCTSArena *arena, MCTSNode *dst, MCTSNode *src)
+{
+  atomic_store_explicit(&dst->visit_count,
+                        atomic_load_explicit(&dst->visit_count, memory_order_relaxed) +
+                            atomic_load_explicit(&src->visit_count, memory_order_relaxed),
+                        memory_order_relaxed);
+  atomic_store_explicit(&dst->total_reward,
+                        atomic_load_explicit(&dst->total_reward, memory_order_relaxed) +
+                            atomic_load_explicit(&src->total_reward, memory_order_relaxed),
+                        memory_order_relaxed);
+
+  size_t src_count = atomic_load_explicit(&src->child_count, memory_order_relaxed);
+  for (size_t i = 0; i < src_count; i++)
+  {
+    MCTSNode *src_child = src->children[i];
+    MCTSNode *dst_child = NULL;
+    size_t dst_count = atomic_load_explicit(&dst->child_count, memory_order_relaxed);
+    for (size_t j = 0; j < dst_count; j++)
+    {
+      if (dst->children[j]->action_id == src_child->action_id)
+      {
+        dst_child = dst->children[j];
+        break;
+      }
+    }
+
+    if (!dst_child)
+    {
+      dst_child = mcts7t_create_node(arena, src_child->state_vector, src_child->state_size,
+                                     src_child->depth, dst);
+      if (!dst_child)
+        return;
+      dst_child->action_id = src_child->action_id;
+      dst_child->action_cost = src_child->action_cost;
+      mcts7t_add_child(dst, dst_child);
+    }
+    mcts7t_merge_tree(arena, dst_child, src_child);
+  }
+}
+
 // Main MCTS search
 MCTSResult *mcts7t_search(MCTS7TEngine *mcts, uint32_t *initial_state, size_t state_size)
 {
-  if (!mcts || !initial_state)
+  if (!mcts || !initial_state || state_size == 0)
     return NULL;
 
-  // Reset statistics
+  // Previous tree goes in one shot
+  mcts7t_release_search(mcts);
   mcts7t_reset_stats(mcts);
   mcts->start_time_ns = mcts7t_get_time_ns();
+  atomic_store(&mcts->iterations_started, 0);
   mcts->iterations_completed = 0;
 
-  // Update root state
-  if (mcts->root)
+  uint32_t threads = 1;
+  if (mcts->config.enable_parallel && mcts->config.num_threads > 1)
+  {
+    threads = mcts->config.num_threads < MCTS_MAX_THREADS ? mcts->config.num_threads : MCTS_MAX_THREADS;
+  }
+  bool root_parallel = threads > 1 && mcts->parallel_mode == MCTS_PARALLEL_ROOT;
+
+  // Workers and roots: one shared root, or one private root per thread
+  for (uint32_t i = 0; i < threads; i++)
   {
-    mcts7t_destroy_node(mcts->root);
+    mcts->worker_count = i + 1;
+    MCTSWorker *worker = &mcts->workers[i];
+    if (!mcts7t_worker_prepare(mcts, i, state_size))
+      return NULL;
+    worker->shared_tree = threads > 1 && !root_parallel;
+
+    if (i == 0 || root_parallel)
+    {
+      worker->root = mcts7t_create_node(&worker->arena, initial_state, state_size, 0, NULL);
+      if (!worker->root)
+        return NULL;
+      worker->root->engine_state = mcts->engine;
+      worker->stats.nodes_created++;
+    }
+    else
+    {
+      worker->root = mcts->workers[0].root;
+    }
+  }
+
+  // Run MCTS iterations until time budget or iteration limit; the calling
+  // thread works as worker 0
+  pthread_t handles[MCTS_MAX_THREADS];
+  bool started[MCTS_MAX_THREADS] = {false};
+  for (uint32_t i = 1; i < threads; i++)
+  {
+    started[i] = pthread_create(&handles[i], NULL, mcts7t_worker_main, &mcts->workers[i]) == 0;
+  }
+  mcts7t_worker_main(&mcts->workers[0]);
+  for (uint32_t i = 1; i < threads; i++)
+  {
+    if (started[i])
+      pthread_join(handles[i], NULL);
   }
-  mcts->root = mcts7t_create_node(initial_state, state_size, 0, NULL);
 
-  // Run MCTS iterations
-  while (mcts7t_step(mcts))
+  // Sum worker statistics
+  for (uint32_t i = 0; i < threads; i++)
   {
-    // Continue until time budget or iteration limit
+    MCTSStats *ws = &mcts->workers[i].stats;
+    mcts->stats.selection_time_ns += ws->selection_time_ns;
+    mcts->stats.expansion_time_ns += ws->expansion_time_ns;
+    mcts->stats.simulation_time_ns += ws->simulation_time_ns;
+    mcts->stats.backpropagation_time_ns += ws->backpropagation_time_ns;
+    mcts->stats.nodes_created += ws->nodes_created;
+    mcts->stats.nodes_visited += ws->nodes_visited;
+    mcts->stats.simulations_performed += ws->simulations_performed;
+    mcts->iterations_completed += mcts->workers[i].iterations;
+  }
+
+  if (root_parallel)
+  {
+    mcts->root = mcts7t_create_node(&mcts->result_arena, initial_state, state_size, 0, NULL);
+    if (!mcts->root)
+      return NULL;
+    mcts->root->engine_state = mcts->engine;
+    for (uint32_t i = 0; i < threads; i++)
+    {
+      mcts7t_merge_tree(&mcts->result_arena, mcts->root, mcts->workers[i].root);
+    }
+  }
+  else
+  {
+    mcts->root = mcts->workers[0].root;
   }
 
   // Extract best path
   MCTSResult *result = malloc(sizeof(MCTSResult));
+  if (!result)
+    return NULL;
   result->computation_time_ns = mcts7t_get_time_ns() - mcts->start_time_ns;
   result->iterations_performed = mcts->iterations_completed;
+  mcts->stats.total_time_ns = result->computation_time_ns;
 
   // Find best action sequence
   MCTSNode *current = mcts->root;
-  result->best_actions = malloc(mcts->config.max_depth * sizeof(uint32_t));
+  result->best_actions = malloc((mcts->config.max_depth + 1) * sizeof(uint32_t));
   result->action_count = 0;
   result->total_reward = 0.0;
 
-  while (current->child_count > 0)
+  while (result->best_actions && result->action_count <= mcts->config.max_depth)
   {
+    size_t child_count = atomic_load(&current->child_count);
+    if (child_count == 0)
+      break;
+
     // Find best child by visit count
     MCTSNode *best_child = current->children[0];
-    for (size_t i = 1; i < current->child_count; i++)
+    for (size_t i = 1; i < child_count; i++)
     {
-      if (current->children[i]->visit_count > best_child->visit_count)
+      if (atomic_load(&current->children[i]->visit_count) > atomic_load(&best_child->visit_count))
       {
         best_child = current->children[i];
       }
     }
 
     result->best_actions[result->action_count++] = best_child->action_id;
-    result->total_reward += best_child->average_reward;
+    result->total_reward += mcts7t_node_mean(best_child);
     current = best_child;
   }
 
-  result->confidence = (double)current->visit_count / mcts->iterations_completed;
+  result->confidence = mcts->iterations_completed
+                           ? (double)atomic_load(&current->visit_count) / mcts->iterations_completed
+                           : 0.0;
 
   return result;
 }
 
+void mcts7t_destroy_result(MCTSResult *result)
+{
+  if (!result)
+    return;
+  free(result->best_actions);
+  free(result);
+}
+
 // Action generation for 7T engine integration
-MCTSAction *mcts7t_generate_actions(MCTSNode *node, size_t *action_count)
+const MCTSAction *mcts7t_generate_actions(const MCTSNode *node, size_t *action_count)
 {
-  if (!node || !node->engine_state)
+  if (!node)
   {
     *action_count = 0;
     return NULL;
   }
 
-  // Generate actions based on current state
-  // This is a simplified version - in practice, you'd analyze the engine state
-  // to determine what operations are possible
-
-  *action_count = 3; // SPARQL, SHACL, OWL actions
-  MCTSAction *actions = malloc(*action_count * sizeof(MCTSAction));
-
-  // SPARQL action
-  actions[0].action_id = 1;
-  actions[0].action_type = 1;       // SPARQL
-  actions[0].estimated_cost = 1.44; // 1.44ns from benchmarks
-  actions[0].estimated_reward = 0.8;
-
-  // SHACL action
-  actions[1].action_id = 2;
-  actions[1].action_type = 2;       // SHACL
-  actions[1].estimated_cost = 1.43; // 1.43ns from benchmarks
-  actions[1].estimated_reward = 0.7;
-
-  // OWL action
-  actions[2].action_id = 3;
-  actions[2].action_type = 3;      // OWL
-  actions[2].estimated_cost = 2.0; // Estimated
-  actions[2].estimated_reward = 0.9;
-
-  return actions;
+  // Every state currently admits the same operations; in practice, you'd
+  // analyze node->engine_state to determine what is possible
+  *action_count = MCTS_ACTION_COUNT;
+  return mcts7t_actions;
 }
 
-// Apply action to state
-uint32_t *mcts7t_apply_action(uint32_t *state, size_t state_size, MCTSAction *action)
+// Apply action to state in place
+void mcts7t_apply_action(uint32_t *state, size_t state_size, const MCTSAction *action)
 {
-  uint32_t *new_state = malloc(state_size * sizeof(uint32_t));
-  memcpy(new_state, state, state_size * sizeof(uint32_t));
-
   // Apply action effects to state
   // This is simplified - in practice, you'd update the state based on the action
-
-  return new_state;
+  (void)state;
+  (void)state_size;
+  (void)action;
 }
 
 // Check if state is terminal
-bool mcts7t_is_terminal(uint32_t *state, size_t state_size)
+bool mcts7t_is_terminal(const uint32_t *state, size_t state_size)
 {
   // Simplified terminal condition
+  (void)state_size;
   return state[0] > 1000; // Arbitrary threshold
 }
 
 // Calculate reward for action
-double mcts7t_calculate_reward(MCTSNode *node, MCTSAction *action)
+double mcts7t_calculate_reward(const MCTSNode *node, const MCTSAction *action)
 {
   if (!node || !action)
     return 0.0;
@@ -544,23 +758,11 @@ double mcts7t_random_double(uint64_t *rng_state)
 // Statistics
 MCTSStats *mcts7t_get_stats(MCTS7TEngine *mcts)
 {
-  return &global_stats;
+  return mcts ? &mcts->stats : NULL;
 }
 
 void mcts7t_reset_stats(MCTS7TEngine *mcts)
 {
-  memset(&global_stats, 0, sizeof(MCTSStats));
+  if (mcts)
+    memset(&mcts->stats, 0, sizeof(MCTSStats));
 }
-
-// Cleanup functions
-void mcts7t_destroy_actions(MCTSAction *actions, size_t count)
-{
-  if (actions)
-  {
-    for (size_t i = 0; i < count; i++)
-    {
-      free(actions[i].parameters);
-    }
-    free(actions);
-  }
-}
\ No newline at end of file
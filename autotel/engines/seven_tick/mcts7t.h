@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <math.h>
 #include <float.h>
 
@@ -20,6 +21,34 @@
 #define MCTS_UCB_C 1.41421356237      // sqrt(2)
 #define MCTS_SIMULATION_DEPTH 20
 #define MCTS_EXPLORATION_CONSTANT 1.414
+#define MCTS_MAX_ACTIONS 8            // Children per node, fixed at creation
+#define MCTS_MAX_THREADS 64
+#define MCTS_ARENA_CHUNK_SIZE (1 << 20)
+#define MCTS_VIRTUAL_LOSS 1           // Pending visits added per in-flight playout
+
+// Parallel search modes (used when config.enable_parallel and num_threads > 1)
+typedef enum
+{
+  MCTS_PARALLEL_TREE, // One shared tree, atomic statistics and virtual loss
+  MCTS_PARALLEL_ROOT  // One tree per thread, merged by action path at the end
+} MCTSParallelMode;
+
+// Per-search bump arena. Nodes, state vectors and child arrays are carved
+// out of chunks and released together when the next search starts.
+typedef struct MCTSArenaChunk
+{
+  struct MCTSArenaChunk *next;
+  size_t used;
+  size_t size;
+  _Alignas(16) unsigned char data[];
+} MCTSArenaChunk;
+
+typedef struct
+{
+  MCTSArenaChunk *head;
+  size_t chunk_size;
+  uint64_t bytes_allocated;
+} MCTSArena;
 
 // MCTS Node Structure
 typedef struct MCTSNode
@@ -29,16 +58,18 @@ typedef struct MCTSNode
   size_t state_size;      // Size of state vector
   uint32_t depth;         // Current depth in tree
 
-  // MCTS statistics
-  double total_reward;   // Cumulative reward
-  uint64_t visit_count;  // Number of visits
-  double average_reward; // Cached average reward
+  // MCTS statistics, shared between search threads
+  _Atomic double total_reward;   // Cumulative reward
+  _Atomic uint64_t visit_count;  // Number of completed visits
+  _Atomic uint32_t virtual_loss; // Playouts currently passing through
 
-  // Tree structure
+  // Tree structure. The children array never moves: a child is written
+  // before child_count is published, so readers need no lock.
   struct MCTSNode **children; // Child nodes
-  size_t child_count;         // Number of children
+  _Atomic size_t child_count; // Number of published children
   size_t child_capacity;      // Capacity of children array
   struct MCTSNode *parent;    // Parent node
+  atomic_flag expanding;      // Held by the thread adding a child
 
   // Action information
   uint32_t action_id; // Action that led to this node
@@ -85,15 +116,48 @@ typedef struct
   uint64_t iterations_performed; // Number of iterations performed
 } MCTSResult;
 
-// MCTS Engine Structure
+// Performance Monitoring
 typedef struct
 {
-  MCTSConfig config;             // Configuration
-  MCTSNode *root;                // Root node
-  EngineState *engine;           // 7T engine state
-  uint64_t *rng_state;           // Random number generator state
-  uint64_t start_time_ns;        // Start time for time budget
-  uint64_t iterations_completed; // Iterations completed
+  uint64_t selection_time_ns;
+  uint64_t expansion_time_ns;
+  uint64_t simulation_time_ns;
+  uint64_t backpropagation_time_ns;
+  uint64_t total_time_ns;
+  uint64_t nodes_created;
+  uint64_t nodes_visited;
+  uint64_t simulations_performed;
+} MCTSStats;
+
+struct MCTS7TEngine;
+
+// Per-thread search state: private RNG, arena, scratch state and stats
+typedef struct
+{
+  struct MCTS7TEngine *mcts;
+  MCTSNode *root;     // Shared root (tree mode) or this thread's own root
+  MCTSArena arena;
+  uint64_t rng_state;
+  uint32_t *scratch;  // Simulation state, state_size words
+  bool shared_tree;   // Apply virtual loss
+  MCTSStats stats;
+  uint64_t iterations;
+} MCTSWorker;
+
+// MCTS Engine Structure
+typedef struct MCTS7TEngine
+{
+  MCTSConfig config;                    // Configuration
+  MCTSParallelMode parallel_mode;       // Tree or root parallel
+  MCTSNode *root;                       // Root node (merged in root mode)
+  EngineState *engine;                  // 7T engine state
+  MCTSWorker workers[MCTS_MAX_THREADS]; // Worker 0 also backs mcts7t_step
+  uint32_t worker_count;                // Workers holding arenas
+  MCTSArena result_arena;               // Merged tree in root-parallel mode
+  uint64_t start_time_ns;               // Start time for time budget
+  _Atomic uint64_t iterations_started;  // Claimed against max_iterations
+  uint64_t iterations_completed;        // Iterations completed
+  MCTSStats stats;                      // Summed over workers
 } MCTS7TEngine;
 
 // Core MCTS Functions
@@ -102,30 +166,35 @@ void mcts7t_destroy(MCTS7TEngine *mcts);
 
 // Main MCTS Algorithm
 MCTSResult *mcts7t_search(MCTS7TEngine *mcts, uint32_t *initial_state, size_t state_size);
+void mcts7t_destroy_result(MCTSResult *result);
 bool mcts7t_step(MCTS7TEngine *mcts);
+void mcts7t_set_parallel_mode(MCTS7TEngine *mcts, MCTSParallelMode mode);
 
-// MCTS Phases
-MCTSNode *mcts7t_select(MCTS7TEngine *mcts, MCTSNode *node);
-MCTSNode *mcts7t_expand(MCTS7TEngine *mcts, MCTSNode *node);
-double mcts7t_simulate(MCTS7TEngine *mcts, MCTSNode *node);
-void mcts7t_backpropagate(MCTS7TEngine *mcts, MCTSNode *node, double reward);
+// MCTS Phases (one worker; safe to run concurrently on a shared tree)
+MCTSNode *mcts7t_select(MCTSWorker *worker, MCTSNode *node);
+MCTSNode *mcts7t_expand(MCTSWorker *worker, MCTSNode *node);
+double mcts7t_simulate(MCTSWorker *worker, MCTSNode *node);
+void mcts7t_backpropagate(MCTSWorker *worker, MCTSNode *node, double reward);
 
-// Node Management
-MCTSNode *mcts7t_create_node(uint32_t *state, size_t state_size, uint32_t depth, MCTSNode *parent);
-void mcts7t_destroy_node(MCTSNode *node);
-void mcts7t_add_child(MCTSNode *parent, MCTSNode *child);
+// Arena
+void mcts7t_arena_init(MCTSArena *arena, size_t chunk_size);
+void *mcts7t_arena_alloc(MCTSArena *arena, size_t size);
+void mcts7t_arena_free(MCTSArena *arena);
 
-// Action Generation
-MCTSAction *mcts7t_generate_actions(MCTSNode *node, size_t *action_count);
-void mcts7t_destroy_actions(MCTSAction *actions, size_t count);
+// Node Management (nodes live in an arena and are never freed one by one)
+MCTSNode *mcts7t_create_node(MCTSArena *arena, const uint32_t *state, size_t state_size,
+                             uint32_t depth, MCTSNode *parent);
+bool mcts7t_add_child(MCTSNode *parent, MCTSNode *child);
+
+// Action Generation (static table; nothing to free)
+const MCTSAction *mcts7t_generate_actions(const MCTSNode *node, size_t *action_count);
 
 // State Management
-uint32_t *mcts7t_apply_action(uint32_t *state, size_t state_size, MCTSAction *action);
-bool mcts7t_is_terminal(uint32_t *state, size_t state_size);
+void mcts7t_apply_action(uint32_t *state, size_t state_size, const MCTSAction *action);
+bool mcts7t_is_terminal(const uint32_t *state, size_t state_size);
 
 // Reward Functions
-double mcts7t_calculate_reward(MCTSNode *node, MCTSAction *action);
-double mcts7t_estimate_reward(uint32_t *state, size_t state_size, MCTSAction *action);
+double mcts7t_calculate_reward(const MCTSNode *node, const MCTSAction *action);
 
 // 7T Engine Integration
 double mcts7t_sparql_reward(EngineState *engine, uint32_t *patterns, size_t pattern_count);
@@ -134,23 +203,11 @@ double mcts7t_owl_reward(EngineState *engine, uint32_t *axioms, size_t axiom_cou
 
 // Utility Functions
 double mcts7t_ucb_score(MCTSNode *node, double exploration_constant);
+double mcts7t_node_mean(MCTSNode *node);
 uint64_t mcts7t_get_time_ns(void);
 uint32_t mcts7t_random_uint32(uint64_t *rng_state);
 double mcts7t_random_double(uint64_t *rng_state);
 
-// Performance Monitoring
-typedef struct
-{
-  uint64_t selection_time_ns;
-  uint64_t expansion_time_ns;
-  uint64_t simulation_time_ns;
-  uint64_t backpropagation_time_ns;
-  uint64_t total_time_ns;
-  uint64_t nodes_created;
-  uint64_t nodes_visited;
-  uint64_t simulations_performed;
-} MCTSStats;
-
 MCTSStats *mcts7t_get_stats(MCTS7TEngine *mcts);
 void mcts7t_reset_stats(MCTS7TEngine *mcts);
 
@@ -0,0 +1,84 @@
+/**
+ * @file mcts7t_benchmark.c
+ * @brief MCTS7T playouts per second versus thread count
+ *
+ * Usage: mcts7t_benchmark [max_threads] [budget_ms]
+ *
+ * Build next to the 7T engine sources, e.g.
+ *   gcc -O3 -march=native -pthread -I. mcts7t.c mcts7t_benchmark.c \
+ *       runtime/src/seven_t_runtime.c <sparql7t/shacl7t/owl7t sources> -lm
+ *
+ * Runs the same time-budgeted search in tree-parallel and root-parallel
+ * mode at 1, 2, 4, ... threads. Each run checks that every completed
+ * playout was backpropagated exactly once to the (merged) root.
+ */
+
+#include "mcts7t.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static int bench_run(MCTSParallelMode mode, uint32_t threads, uint64_t budget_ns)
+{
+  MCTSConfig config = MCTS7T_DEFAULT_CONFIG;
+  config.max_iterations = UINT32_MAX;
+  config.time_budget_ns = budget_ns;
+  config.enable_parallel = threads > 1;
+  config.num_threads = threads;
+
+  MCTS7TEngine *mcts = mcts7t_create(NULL, &config);
+  if (!mcts)
+    return 1;
+  mcts7t_set_parallel_mode(mcts, mode);
+
+  uint32_t initial_state[4] = {3, 1, 2, 3};
+  MCTSResult *result = mcts7t_search(mcts, initial_state, 4);
+  if (!result)
+  {
+    mcts7t_destroy(mcts);
+    return 1;
+  }
+
+  uint64_t arena_bytes = mcts->result_arena.bytes_allocated;
+  for (uint32_t i = 0; i < mcts->worker_count; i++)
+  {
+    arena_bytes += mcts->workers[i].arena.bytes_allocated;
+  }
+
+  MCTSStats *stats = mcts7t_get_stats(mcts);
+  uint64_t root_visits = atomic_load(&mcts->root->visit_count);
+  int ok = root_visits == result->iterations_performed && result->action_count > 0;
+  double seconds = result->computation_time_ns / 1e9;
+
+  printf("  %-4s %2u threads  %10.0f playouts/s  %9llu playouts  %8llu nodes  %7.1f MB arena  depth %2zu  first action %u  %s\n",
+         mode == MCTS_PARALLEL_TREE ? "tree" : "root", threads,
+         result->iterations_performed / seconds,
+         (unsigned long long)result->iterations_performed,
+         (unsigned long long)stats->nodes_created, arena_bytes / 1e6,
+         result->action_count, result->best_actions[0], ok ? "ok" : "FAILED");
+
+  mcts7t_destroy_result(result);
+  mcts7t_destroy(mcts);
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t max_threads = argc > 1 ? (uint32_t)atoi(argv[1]) : 8;
+  uint64_t budget_ms = argc > 2 ? (uint64_t)atoi(argv[2]) : 500;
+  if (max_threads > MCTS_MAX_THREADS)
+    max_threads = MCTS_MAX_THREADS;
+
+  printf("MCTS7T parallel search: %llu ms budget per run\n", (unsigned long long)budget_ms);
+
+  int failures = 0;
+  for (uint32_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    failures += bench_run(MCTS_PARALLEL_TREE, threads, budget_ms * 1000000ULL);
+  }
+  for (uint32_t threads = 2; threads <= max_threads; threads *= 2)
+  {
+    failures += bench_run(MCTS_PARALLEL_ROOT, threads, budget_ms * 1000000ULL);
+  }
+
+  return failures ? 1 : 0;
+}
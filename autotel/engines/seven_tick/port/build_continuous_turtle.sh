@@ -86,6 +86,15 @@ echo "🔨 Compiling with flags: $CFLAGS"
 echo "📦 Compiling continuous_turtle_pipeline.c..."
 gcc $CFLAGS -c continuous_turtle_pipeline.c -o "$BUILD_DIR/continuous_turtle_pipeline.o"
 
+echo "📦 Compiling turtle_term_interner.c..."
+gcc $CFLAGS -c turtle_term_interner.c -o "$BUILD_DIR/turtle_term_interner.o"
+
+echo "📦 Compiling turtle_mpmc_ring.c..."
+gcc $CFLAGS -c turtle_mpmc_ring.c -o "$BUILD_DIR/turtle_mpmc_ring.o"
+
+echo "📦 Compiling turtle_rcu.c..."
+gcc $CFLAGS -c turtle_rcu.c -o "$BUILD_DIR/turtle_rcu.o"
+
 echo "📦 Compiling continuous_turtle_test.c..."
 gcc $CFLAGS -c continuous_turtle_test.c -o "$BUILD_DIR/continuous_turtle_test.o"
 
@@ -101,6 +110,9 @@ echo "🔗 Linking continuous_turtle_test..."
 gcc $CFLAGS -o continuous_turtle_test \
     "$BUILD_DIR/continuous_turtle_test.o" \
     "$BUILD_DIR/continuous_turtle_pipeline.o" \
+    "$BUILD_DIR/turtle_term_interner.o" \
+    "$BUILD_DIR/turtle_mpmc_ring.o" \
+    "$BUILD_DIR/turtle_rcu.o" \
     "$BUILD_DIR/bitactor.o" \
     "$BUILD_DIR/tick_collapse_engine.o" \
     "$BUILD_DIR/signal_engine.o" \
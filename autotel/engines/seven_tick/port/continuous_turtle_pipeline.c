@@ -5,6 +5,7 @@
  */
 
 #include "continuous_turtle_pipeline.h"
+#include <stdatomic.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -34,75 +35,15 @@ static uint64_t get_time_ns(void) {
 #endif
 }
 
-// =============================================================================
-// RING BUFFER IMPLEMENTATION
-// =============================================================================
-
-static TurtleRingBuffer* create_ring_buffer(uint32_t capacity) {
-    TurtleRingBuffer* buffer = calloc(1, sizeof(TurtleRingBuffer));
-    if (!buffer) return NULL;
-    
-    buffer->events = calloc(capacity, sizeof(TurtleEvent));
-    if (!buffer->events) {
-        free(buffer);
-        return NULL;
-    }
-    
-    buffer->capacity = capacity;
-    buffer->write_pos = 0;
-    buffer->read_pos = 0;
-    buffer->size = 0;
-    pthread_mutex_init(&buffer->resize_lock, NULL);
-    
-    return buffer;
-}
-
-static void destroy_ring_buffer(TurtleRingBuffer* buffer) {
-    if (!buffer) return;
-    pthread_mutex_destroy(&buffer->resize_lock);
-    free(buffer->events);
-    free(buffer);
-}
-
-static bool ring_buffer_push(TurtleRingBuffer* buffer, TurtleEvent* event) {
-    uint32_t current_size = buffer->size;
-    if (current_size >= buffer->capacity) {
-        return false; // Buffer full
-    }
-    
-    uint32_t write_pos = buffer->write_pos;
-    buffer->events[write_pos] = *event;
-    
-    // Update write position
-    uint32_t next_pos = (write_pos + 1) % buffer->capacity;
-    buffer->write_pos = next_pos;
-    buffer->size = current_size + 1;
-    
-    return true;
-}
-
-static bool ring_buffer_pop(TurtleRingBuffer* buffer, TurtleEvent* event) {
-    uint32_t current_size = buffer->size;
-    if (current_size == 0) {
-        return false; // Buffer empty
-    }
-    
-    uint32_t read_pos = buffer->read_pos;
-    *event = buffer->events[read_pos];
-    
-    // Update read position
-    uint32_t next_pos = (read_pos + 1) % buffer->capacity;
-    buffer->read_pos = next_pos;
-    buffer->size = current_size - 1;
-    
-    return true;
+static void free_rule_set(void* rules) {
+    destroy_rule_set((RuleSet*)rules);
 }
 
 // =============================================================================
 // WORKER THREAD IMPLEMENTATION
 // =============================================================================
 
-static void process_turtle_event(TurtleWorker* worker, TurtleEvent* event) {
+static void process_turtle_event(TurtleWorker* worker, RuleSet* rules, TurtleEvent* event) {
     uint64_t start_time = get_time_ns();
     
     switch (event->type) {
@@ -111,17 +52,16 @@ static void process_turtle_event(TurtleWorker* worker, TurtleEvent* event) {
             if (worker->local_matrix && worker->local_engine) {
                 // Convert triple to BitActor representation
                 // This is a simplified version - real implementation would parse TTL
-                BitActor actor = 0;
-                for (int i = 0; i < 8 && event->data.triple.subject[i]; i++) {
-                    actor |= (1 << (i % 8));
-                }
+                uint32_t subject_length = 0;
+                turtle_term_store_lookup(worker->pipeline->terms,
+                                         event->data.triple.subject, &subject_length);
+                BitActor actor = subject_length >= 8 ? 0xFF : (BitActor)((1u << subject_length) - 1);
                 
                 // Set actor in matrix
                 if (worker->local_matrix->num_actors > 0) {
                     worker->local_matrix->actors[0] = actor;
                     
                     // Execute tick collapse
-                    RuleSet* rules = worker->pipeline->reload_state.current_rules;
                     if (rules) {
                         tick_collapse_execute(worker->local_engine, worker->local_matrix, rules);
                     }
@@ -142,14 +82,9 @@ static void process_turtle_event(TurtleWorker* worker, TurtleEvent* event) {
             break;
         }
         
-        case TURTLE_EVENT_RULE: {
-            // Hot-reload rule into local engine
-            if (worker->pipeline->reload_state.current_rules) {
-                add_rule_to_set(worker->pipeline->reload_state.current_rules, 
-                               event->data.rule.rule);
-            }
+        case TURTLE_EVENT_RULE:
+            // Published by worker_thread_main once the batch is done
             break;
-        }
         
         default:
             break;
@@ -160,6 +95,8 @@ static void process_turtle_event(TurtleWorker* worker, TurtleEvent* event) {
     worker->events_processed++;
 }
 
+static bool publish_added_rules(TurtlePipeline* pipeline, const CompiledRule* rules, uint32_t count);
+
 static void* worker_thread_main(void* arg) {
     TurtleWorker* worker = (TurtleWorker*)arg;
     TurtlePipeline* pipeline = worker->pipeline;
@@ -170,30 +107,60 @@ static void* worker_thread_main(void* arg) {
     worker->local_matrix = create_bit_actor_matrix(256);
     worker->local_engine = create_tick_collapse_engine();
     
-    TurtleEvent event;
+    TurtleEvent batch[TURTLE_WORKER_BATCH];
+    TurtleEvent outputs[TURTLE_WORKER_BATCH];
+    CompiledRule added_rules[TURTLE_WORKER_BATCH];
     uint64_t last_checkpoint = get_time_ns();
     
     while (worker->active) {
-        // Try to get event from input buffer
-        if (ring_buffer_pop(pipeline->input_buffer, &event)) {
-            // Process the event
-            process_turtle_event(worker, &event);
+        // Take a batch from the input ring with one claim
+        uint32_t count = turtle_ring_pop_batch(pipeline->input_buffer, batch, TURTLE_WORKER_BATCH);
+        if (count > 0) {
+            // Between batches: nothing from the previous batch is still held
+            turtle_rcu_quiescent(&pipeline->reload_state.rules, worker->worker_id);
+            RuleSet* rules = turtle_rcu_read(&pipeline->reload_state.rules);
             
-            // Generate output event if needed
-            if (event.type == TURTLE_EVENT_TRIPLE) {
-                TurtleEvent output = {
-                    .type = TURTLE_EVENT_METRICS,
-                    .timestamp_ns = get_time_ns(),
-                    .sequence_id = event.sequence_id,
-                    .partition_key = worker->worker_id,
-                    .data.checkpoint = {
-                        .processed_count = worker->events_processed,
-                        .error_count = 0,
-                        .throughput_tps = 0.0
-                    }
-                };
+            uint32_t output_count = 0;
+            uint32_t added_count = 0;
+            for (uint32_t i = 0; i < count; i++) {
+                TurtleEvent* event = &batch[i];
+                process_turtle_event(worker, rules, event);
+                
+                if (event->type == TURTLE_EVENT_RULE) {
+                    added_rules[added_count++] = event->data.rule.rule;
+                }
                 
-                ring_buffer_push(pipeline->output_buffer, &output);
+                // Generate output event if needed
+                if (event->type == TURTLE_EVENT_TRIPLE) {
+                    outputs[output_count++] = (TurtleEvent){
+                        .type = TURTLE_EVENT_METRICS,
+                        .timestamp_ns = get_time_ns(),
+                        .sequence_id = event->sequence_id,
+                        .partition_key = worker->worker_id,
+                        .data.checkpoint = {
+                            .processed_count = worker->events_processed,
+                            .error_count = 0,
+                            .throughput_tps = 0.0
+                        }
+                    };
+                }
+            }
+            
+            // Rule events: leave the read section before publishing, then
+            // apply the whole batch's rules with one copy of the set. They
+            // take effect from the next batch.
+            if (added_count > 0) {
+                turtle_rcu_offline(&pipeline->reload_state.rules, worker->worker_id);
+                publish_added_rules(pipeline, added_rules, added_count);
+            }
+            
+            // Output is best effort: drop what does not fit
+            uint32_t pushed = 0;
+            while (pushed < output_count) {
+                uint32_t n = turtle_ring_push_batch(pipeline->output_buffer, outputs + pushed,
+                                                    output_count - pushed);
+                if (n == 0) break;
+                pushed += n;
             }
             
             // Periodic checkpoint
@@ -219,11 +186,14 @@ static void* worker_thread_main(void* arg) {
                 last_checkpoint = now;
             }
         } else {
-            // No events available, brief sleep
+            // No events available: go offline so reloads need not wait for us
+            turtle_rcu_offline(&pipeline->reload_state.rules, worker->worker_id);
             usleep(100); // 100 microseconds
         }
     }
     
+    turtle_rcu_offline(&pipeline->reload_state.rules, worker->worker_id);
+    
     // Cleanup
     destroy_bit_actor_matrix(worker->local_matrix);
     destroy_tick_collapse_engine(worker->local_engine);
@@ -237,8 +207,8 @@ static void* worker_thread_main(void* arg) {
 // =============================================================================
 
 static void calculate_scaling_metrics(TurtlePipeline* pipeline) {
-    uint32_t queue_depth = pipeline->input_buffer->size;
-    uint32_t queue_capacity = pipeline->input_buffer->capacity;
+    uint32_t queue_depth = turtle_ring_size(pipeline->input_buffer);
+    uint32_t queue_capacity = turtle_ring_capacity(pipeline->input_buffer);
     
     pipeline->metrics.queue_depth_ratio = (double)queue_depth / queue_capacity;
     
@@ -360,6 +330,14 @@ static void* scaling_thread_main(void* arg) {
         // Don't scale too frequently (wait at least 5 seconds)
         if (time_since_last_scale > 5000000000ULL) {
             if (should_scale_up(pipeline)) {
+                // Queue pressure: chain a larger input segment; workers keep
+                // draining the old one without pausing
+                uint32_t capacity = turtle_ring_capacity(pipeline->input_buffer);
+                if (pipeline->metrics.queue_depth_ratio > TURTLE_SCALING_THRESHOLD &&
+                    capacity < TURTLE_BUFFER_MAX_SIZE) {
+                    turtle_ring_grow(pipeline->input_buffer, capacity * 2);
+                }
+                
                 uint32_t new_count = pipeline->num_workers + 4;
                 if (new_count > TURTLE_PIPELINE_MAX_WORKERS) {
                     new_count = TURTLE_PIPELINE_MAX_WORKERS;
@@ -374,6 +352,9 @@ static void* scaling_thread_main(void* arg) {
             }
         }
         
+        // Free pattern sets retired while workers were mid-batch
+        turtle_rcu_reclaim(&pipeline->reload_state.rules);
+        
         sleep(1); // Check every second
     }
     
@@ -392,14 +373,22 @@ TurtlePipeline* turtle_pipeline_create(uint32_t initial_workers) {
     printf("🚀 Creating Turtle Pipeline with %u initial workers\n", initial_workers);
     
     // Create ring buffers
-    pipeline->input_buffer = create_ring_buffer(TURTLE_BUFFER_SIZE);
-    pipeline->output_buffer = create_ring_buffer(TURTLE_BUFFER_SIZE);
+    pipeline->input_buffer = turtle_ring_create(TURTLE_BUFFER_SIZE);
+    pipeline->output_buffer = turtle_ring_create(TURTLE_BUFFER_SIZE);
     
     if (!pipeline->input_buffer || !pipeline->output_buffer) {
         turtle_pipeline_destroy(pipeline);
         return NULL;
     }
     
+    // Shared term store for triple events
+    pipeline->terms = turtle_term_store_create(TURTLE_MAX_TERMS, TURTLE_TERM_ARENA_BYTES,
+                                               TURTLE_LITERAL_ARENA_BYTES);
+    if (!pipeline->terms) {
+        turtle_pipeline_destroy(pipeline);
+        return NULL;
+    }
+    
     // Initialize pattern storage
     pipeline->patterns = calloc(TURTLE_PATTERN_CACHE_SIZE, sizeof(PatternDistribution));
     if (!pipeline->patterns) {
@@ -409,10 +398,13 @@ TurtlePipeline* turtle_pipeline_create(uint32_t initial_workers) {
     pipeline->pattern_count = TURTLE_PATTERN_CACHE_SIZE;
     
     // Initialize reload state
-    pthread_rwlock_init(&pipeline->reload_state.pattern_lock, NULL);
-    pipeline->reload_state.current_rules = create_rule_set(1024);
-    pipeline->reload_state.pending_rules = NULL;
-    pipeline->reload_state.reload_requested = false;
+    RuleSet* initial_rules = create_rule_set(1024);
+    if (!initial_rules || !turtle_rcu_init(&pipeline->reload_state.rules, initial_rules)) {
+        destroy_rule_set(initial_rules);
+        turtle_pipeline_destroy(pipeline);
+        return NULL;
+    }
+    pthread_mutex_init(&pipeline->reload_state.update_lock, NULL);
     pipeline->reload_state.reload_generation = 0;
     
     // Create compiler
@@ -449,17 +441,18 @@ void turtle_pipeline_destroy(TurtlePipeline* pipeline) {
     }
     
     // Destroy ring buffers
-    destroy_ring_buffer(pipeline->input_buffer);
-    destroy_ring_buffer(pipeline->output_buffer);
+    turtle_ring_destroy(pipeline->input_buffer);
+    turtle_ring_destroy(pipeline->output_buffer);
     
-    // Free patterns
+    // Free patterns and terms
     free(pipeline->patterns);
+    turtle_term_store_destroy(pipeline->terms);
     
-    // Destroy reload state
-    pthread_rwlock_destroy(&pipeline->reload_state.pattern_lock);
-    destroy_rule_set(pipeline->reload_state.current_rules);
-    if (pipeline->reload_state.pending_rules) {
-        destroy_rule_set(pipeline->reload_state.pending_rules);
+    // Destroy reload state; workers are stopped, so every retired set is free
+    // (global_epoch is still 0 if creation failed before RCU was set up)
+    if (atomic_load(&pipeline->reload_state.rules.global_epoch) != 0) {
+        turtle_rcu_destroy(&pipeline->reload_state.rules, free_rule_set);
+        pthread_mutex_destroy(&pipeline->reload_state.update_lock);
     }
     
     // Destroy compiler
@@ -530,19 +523,23 @@ bool turtle_pipeline_submit(TurtlePipeline* pipeline, TurtleEvent* event) {
     if (!pipeline || !event || !pipeline->running) return false;
     
     event->sequence_id = pipeline->global_sequence++;
-    return ring_buffer_push(pipeline->input_buffer, event);
+    return turtle_ring_push(pipeline->input_buffer, event);
 }
 
 bool turtle_pipeline_submit_batch(TurtlePipeline* pipeline, TurtleEvent* events, uint32_t count) {
     if (!pipeline || !events || !pipeline->running) return false;
     
-    uint32_t submitted = 0;
+    uint64_t sequence = atomic_fetch_add(&pipeline->global_sequence, count);
     for (uint32_t i = 0; i < count; i++) {
-        if (turtle_pipeline_submit(pipeline, &events[i])) {
-            submitted++;
-        } else {
-            break; // Buffer full
-        }
+        events[i].sequence_id = (uint32_t)(sequence + i);
+    }
+    
+    uint32_t submitted = 0;
+    while (submitted < count) {
+        uint32_t n = turtle_ring_push_batch(pipeline->input_buffer, events + submitted,
+                                            count - submitted);
+        if (n == 0) break; // Buffer full
+        submitted += n;
     }
     
     return submitted == count;
@@ -552,17 +549,68 @@ uint32_t turtle_pipeline_consume(TurtlePipeline* pipeline, TurtleEvent* events,
     if (!pipeline || !events) return 0;
     
     uint32_t consumed = 0;
-    for (uint32_t i = 0; i < max_count; i++) {
-        if (ring_buffer_pop(pipeline->output_buffer, &events[i])) {
-            consumed++;
-        } else {
-            break; // No more events
-        }
+    while (consumed < max_count) {
+        uint32_t n = turtle_ring_pop_batch(pipeline->output_buffer, events + consumed,
+                                           max_count - consumed);
+        if (n == 0) break; // No more events
+        consumed += n;
     }
     
     return consumed;
 }
 
+// =============================================================================
+// TERM INTERNING
+// =============================================================================
+
+TurtleTermStore* turtle_pipeline_get_terms(TurtlePipeline* pipeline) {
+    return pipeline ? pipeline->terms : NULL;
+}
+
+static bool is_literal_term(const char* term) {
+    char c = term[0];
+    return c == '"' || c == '\'' || (c >= '0' && c <= '9') || c == '+' || c == '-';
+}
+
+bool turtle_event_set_triple(TurtleInternerCache* cache, TurtleEvent* event,
+                             const char* subject, const char* predicate, const char* object) {
+    if (!cache || !event || !subject || !predicate || !object) return false;
+    
+    event->type = TURTLE_EVENT_TRIPLE;
+    event->data.triple.subject = turtle_interner_intern(cache, subject, (uint32_t)strlen(subject));
+    event->data.triple.predicate = turtle_interner_intern(cache, predicate, (uint32_t)strlen(predicate));
+    if (event->data.triple.subject == TURTLE_TERM_NONE ||
+        event->data.triple.predicate == TURTLE_TERM_NONE) {
+        return false;
+    }
+    
+    uint32_t object_length = (uint32_t)strlen(object);
+    if (is_literal_term(object)) {
+        event->data.triple.object = TURTLE_TERM_NONE;
+        event->data.triple.literal_length = object_length;
+        return turtle_interner_add_literal(cache, object, object_length,
+                                           &event->data.triple.literal_offset);
+    }
+    
+    event->data.triple.object = turtle_interner_intern(cache, object, object_length);
+    event->data.triple.literal_length = 0;
+    event->data.triple.literal_offset = 0;
+    return event->data.triple.object != TURTLE_TERM_NONE;
+}
+
+bool turtle_pipeline_reset_terms(TurtlePipeline* pipeline) {
+    if (!pipeline || pipeline->running) return false;
+    
+    // Queued events still hold ids and literal offsets
+    if (turtle_ring_size(pipeline->input_buffer) != 0 ||
+        turtle_ring_size(pipeline->output_buffer) != 0) {
+        return false;
+    }
+    
+    turtle_term_store_reset(pipeline->terms);
+    return true;
+}
+
 // =============================================================================
 // PATTERN MANAGEMENT
 // =============================================================================
@@ -579,28 +627,17 @@ bool turtle_pipeline_reload_patterns(TurtlePipeline* pipeline, const char* patte
         return false;
     }
     
-    // Prepare for swap
-    pthread_rwlock_wrlock(&pipeline->reload_state.pattern_lock);
-    
-    // Store pending rules
-    if (pipeline->reload_state.pending_rules) {
-        destroy_rule_set(pipeline->reload_state.pending_rules);
+    // Swap; workers pick up the new set at their next batch and the old one
+    // is freed once all of them have moved past it
+    pthread_mutex_lock(&pipeline->reload_state.update_lock);
+    if (!turtle_rcu_publish(&pipeline->reload_state.rules, new_rules, free_rule_set)) {
+        pthread_mutex_unlock(&pipeline->reload_state.update_lock);
+        destroy_rule_set(new_rules);
+        printf("❌ Failed to publish new patterns\n");
+        return false;
     }
-    pipeline->reload_state.pending_rules = new_rules;
-    pipeline->reload_state.reload_requested = true;
-    pipeline->reload_state.reload_generation++;
-    
-    // Atomic swap
-    RuleSet* old_rules = pipeline->reload_state.current_rules;
-    pipeline->reload_state.current_rules = new_rules;
-    pipeline->reload_state.pending_rules = NULL;
-    pipeline->reload_state.reload_requested = false;
-    
-    pthread_rwlock_unlock(&pipeline->reload_state.pattern_lock);
-    
-    // Cleanup old rules after brief delay
-    usleep(1000); // 1ms delay to ensure workers see new rules
-    destroy_rule_set(old_rules);
+    uint32_t generation = atomic_fetch_add(&pipeline->reload_state.reload_generation, 1) + 1;
+    pthread_mutex_unlock(&pipeline->reload_state.update_lock);
     
     // Generate reload event
     TurtleEvent reload_event = {
@@ -608,7 +645,7 @@ bool turtle_pipeline_reload_patterns(TurtlePipeline* pipeline, const char* patte
         .timestamp_ns = get_time_ns(),
         .sequence_id = pipeline->global_sequence++,
         .data.pattern = {
-            .pattern_id = pipeline->reload_state.reload_generation,
+            .pattern_id = generation,
             .confidence = 1.0
         }
     };
@@ -617,10 +654,41 @@ bool turtle_pipeline_reload_patterns(TurtlePipeline* pipeline, const char* patte
         pipeline->event_callback(&reload_event, pipeline->callback_context);
     }
     
-    printf("✅ Patterns reloaded (generation %u)\n", pipeline->reload_state.reload_generation);
+    printf("✅ Patterns reloaded (generation %u)\n", generation);
     return true;
 }
 
+// Callers must not be inside an RCU read section of their own: workers go
+// offline first. Publishing never waits on readers either way.
+static bool publish_added_rules(TurtlePipeline* pipeline, const CompiledRule* rules, uint32_t count) {
+    pthread_mutex_lock(&pipeline->reload_state.update_lock);
+    
+    // Readers may hold the current set: extend a private copy and swap it in
+    RuleSet* current = turtle_rcu_read(&pipeline->reload_state.rules);
+    size_t existing = current ? current->num_rules : 0;
+    RuleSet* next = create_rule_set(existing + count);
+    if (!next) {
+        pthread_mutex_unlock(&pipeline->reload_state.update_lock);
+        return false;
+    }
+    if (existing > 0) {
+        memcpy(next->rules, current->rules, existing * sizeof(CompiledRule));
+    }
+    memcpy(next->rules + existing, rules, count * sizeof(CompiledRule));
+    next->num_rules = existing + count;
+    
+    bool published = turtle_rcu_publish(&pipeline->reload_state.rules, next, free_rule_set);
+    pthread_mutex_unlock(&pipeline->reload_state.update_lock);
+    
+    if (!published) destroy_rule_set(next);
+    return published;
+}
+
+bool turtle_pipeline_add_rule(TurtlePipeline* pipeline, CompiledRule rule) {
+    if (!pipeline) return false;
+    return publish_added_rules(pipeline, &rule, 1);
+}
+
 bool turtle_pipeline_add_pattern(TurtlePipeline* pipeline, uint32_t pattern_id, const uint8_t* mask) {
     if (!pipeline || pattern_id >= pipeline->pattern_count) return false;
     
@@ -715,12 +783,21 @@ void turtle_pipeline_get_metrics(TurtlePipeline* pipeline, TurtlePipelineMetrics
     metrics->avg_latency_ms = pipeline->metrics.avg_processing_time_ns / 1e6;
     metrics->p99_latency_ms = metrics->avg_latency_ms * 1.5; // Estimate
     
-    metrics->queue_depth = pipeline->input_buffer->size;
+    metrics->queue_depth = turtle_ring_size(pipeline->input_buffer);
     metrics->active_workers = pipeline->metrics.active_workers;
     
-    // Estimate CPU/memory usage
+    // Estimate CPU/memory usage; refused literal chunks still bump the
+    // reservation past the arena
+    uint64_t literal_bytes = pipeline->terms->literal_reserved;
+    if (literal_bytes > pipeline->terms->literal_capacity) {
+        literal_bytes = pipeline->terms->literal_capacity;
+    }
     metrics->cpu_utilization = (double)pipeline->num_workers / TURTLE_PIPELINE_MAX_WORKERS;
-    metrics->memory_usage_mb = sizeof(TurtlePipeline) / 1024.0 / 1024.0 +
+    metrics->memory_usage_mb = (sizeof(TurtlePipeline) +
+                                ((double)turtle_ring_capacity(pipeline->input_buffer) +
+                                 turtle_ring_capacity(pipeline->output_buffer)) * sizeof(TurtleEvent) +
+                                pipeline->terms->term_bytes_used +
+                                literal_bytes) / 1024.0 / 1024.0 +
                                (pipeline->num_workers * sizeof(BitActorMatrix) * 256) / 1024.0 / 1024.0;
     
     // Pattern cache metrics
@@ -733,6 +810,7 @@ void turtle_pipeline_get_metrics(TurtlePipeline* pipeline, TurtlePipelineMetrics
     
     metrics->pattern_cache_hits = cache_hits;
     metrics->pattern_cache_misses = cache_misses;
+    metrics->terms_refused = pipeline->terms->terms_refused + pipeline->terms->literals_refused;
 }
 
 void turtle_pipeline_reset_metrics(TurtlePipeline* pipeline) {
@@ -18,67 +18,27 @@
 #include <pthread.h>
 #include "bitactor.h"
 #include "tick_collapse_engine.h"
-#include "bitmask_compiler.h"
+#include "turtle_event.h"
+#include "turtle_mpmc_ring.h"
+#include "turtle_rcu.h"
 
 // Pipeline configuration constants
 #define TURTLE_PIPELINE_MAX_WORKERS 64
 #define TURTLE_PIPELINE_MIN_WORKERS 4
-#define TURTLE_BUFFER_SIZE 8192
+#define TURTLE_BUFFER_SIZE 32768 // 64-byte events: 2 MB per ring
 #define TURTLE_PATTERN_CACHE_SIZE 1024
 #define TURTLE_SCALING_THRESHOLD 0.75
 #define TURTLE_BACKPRESSURE_LIMIT 4096
 #define TURTLE_CHECKPOINT_INTERVAL 1000
 
-// Turtle data stream events
-typedef enum {
-    TURTLE_EVENT_TRIPLE,
-    TURTLE_EVENT_PATTERN,
-    TURTLE_EVENT_RULE,
-    TURTLE_EVENT_CHECKPOINT,
-    TURTLE_EVENT_SCALE_UP,
-    TURTLE_EVENT_SCALE_DOWN,
-    TURTLE_EVENT_RELOAD_PATTERN,
-    TURTLE_EVENT_METRICS
-} TurtleEventType;
-
-// Stream event structure
-typedef struct {
-    TurtleEventType type;
-    uint64_t timestamp_ns;
-    uint32_t sequence_id;
-    uint32_t partition_key;
-    union {
-        struct {
-            char subject[256];
-            char predicate[256];
-            char object[256];
-        } triple;
-        struct {
-            uint32_t pattern_id;
-            uint8_t pattern_mask[32];
-            double confidence;
-        } pattern;
-        struct {
-            uint32_t rule_id;
-            CompiledRule rule;
-        } rule;
-        struct {
-            uint64_t processed_count;
-            uint64_t error_count;
-            double throughput_tps;
-        } checkpoint;
-    } data;
-} TurtleEvent;
-
-// Ring buffer for lock-free processing
-typedef struct {
-    TurtleEvent* events;
-    uint32_t capacity;
-    _Atomic uint32_t write_pos;
-    _Atomic uint32_t read_pos;
-    _Atomic uint32_t size;
-    pthread_mutex_t resize_lock;
-} TurtleRingBuffer;
+// Shared term store sizing
+#define TURTLE_MAX_TERMS (1u << 20)
+#define TURTLE_TERM_ARENA_BYTES (32ull << 20)
+#define TURTLE_LITERAL_ARENA_BYTES (256ull << 20)
+
+// Input ring growth: chained segments, doubling up to this many events
+#define TURTLE_BUFFER_MAX_SIZE (TURTLE_BUFFER_SIZE * 8)
+#define TURTLE_WORKER_BATCH 32
 
 // Worker thread state
 typedef struct {
@@ -111,15 +71,19 @@ typedef struct {
     uint64_t last_scale_time_ns;
 } ScalingMetrics;
 
-// Pattern reload state
+// Pattern reload state: the active RuleSet is published through RCU.
+// Workers read it without locks; reloads and rule events copy, swap and
+// retire the old set once every worker has finished its batch. A worker
+// publishes its batch's rule events only after going offline.
 typedef struct {
-    RuleSet* current_rules;
-    RuleSet* pending_rules;
-    _Atomic bool reload_requested;
+    TurtleRcu rules;
+    pthread_mutex_t update_lock;  // Serialises copy-and-swap writers
     _Atomic uint32_t reload_generation;
-    pthread_rwlock_t pattern_lock;
 } PatternReloadState;
 
+_Static_assert(TURTLE_PIPELINE_MAX_WORKERS <= TURTLE_RCU_MAX_READERS,
+               "every worker needs an RCU reader slot");
+
 // Main pipeline structure
 typedef struct TurtlePipeline {
     // Stream processing
@@ -145,6 +109,9 @@ typedef struct TurtlePipeline {
     _Atomic uint64_t global_sequence;
     uint64_t start_time_ns;
     
+    // Interned triple terms and literals
+    TurtleTermStore* terms;
+    
     // Integration points
     BitmaskCompiler* compiler;
     void (*event_callback)(TurtleEvent* event, void* context);
@@ -162,8 +129,21 @@ bool turtle_pipeline_submit(TurtlePipeline* pipeline, TurtleEvent* event);
 bool turtle_pipeline_submit_batch(TurtlePipeline* pipeline, TurtleEvent* events, uint32_t count);
 uint32_t turtle_pipeline_consume(TurtlePipeline* pipeline, TurtleEvent* events, uint32_t max_count);
 
+// Term interning: each producer thread creates its own TurtleInternerCache
+// over turtle_pipeline_get_terms(). Quoted and numeric objects go to the
+// literal arena; everything else is interned. The store is bounded by the
+// TURTLE_*_ARENA_BYTES / TURTLE_MAX_TERMS sizes and never frees terms;
+// turtle_event_set_triple() fails once it is full (see terms_refused).
+TurtleTermStore* turtle_pipeline_get_terms(TurtlePipeline* pipeline);
+bool turtle_event_set_triple(TurtleInternerCache* cache, TurtleEvent* event,
+                             const char* subject, const char* predicate, const char* object);
+// Reclaim the term store: only while stopped with both rings drained and
+// producers idle; false otherwise
+bool turtle_pipeline_reset_terms(TurtlePipeline* pipeline);
+
 // Pattern management functions
 bool turtle_pipeline_reload_patterns(TurtlePipeline* pipeline, const char* pattern_ttl);
+bool turtle_pipeline_add_rule(TurtlePipeline* pipeline, CompiledRule rule);
 bool turtle_pipeline_add_pattern(TurtlePipeline* pipeline, uint32_t pattern_id, const uint8_t* mask);
 bool turtle_pipeline_remove_pattern(TurtlePipeline* pipeline, uint32_t pattern_id);
 void turtle_pipeline_get_pattern_distribution(TurtlePipeline* pipeline, PatternDistribution* dist, uint32_t* count);
@@ -187,6 +167,7 @@ typedef struct {
     double memory_usage_mb;
     uint64_t pattern_cache_hits;
     uint64_t pattern_cache_misses;
+    uint64_t terms_refused;   // Term interns and literal appends lost to a full store
 } TurtlePipelineMetrics;
 
 void turtle_pipeline_get_metrics(TurtlePipeline* pipeline, TurtlePipelineMetrics* metrics);
@@ -19,15 +19,16 @@ static volatile bool g_running = true;
 // EVENT GENERATION
 // =============================================================================
 
-static void generate_test_triple(TurtleEvent* event, uint32_t id) {
-    event->type = TURTLE_EVENT_TRIPLE;
+static void generate_test_triple(TurtleInternerCache* terms, TurtleEvent* event, uint32_t id) {
     event->timestamp_ns = 0; // Will be set by pipeline
     event->sequence_id = 0;  // Will be set by pipeline
     event->partition_key = id % 8;
     
-    snprintf(event->data.triple.subject, 256, "ex:entity_%u", id);
-    snprintf(event->data.triple.predicate, 256, "ex:hasValue");
-    snprintf(event->data.triple.object, 256, "\"%u\"^^xsd:integer", id * 10);
+    char subject[32];
+    char object[32];
+    snprintf(subject, sizeof(subject), "ex:entity_%u", id);
+    snprintf(object, sizeof(object), "\"%u\"^^xsd:integer", id * 10);
+    turtle_event_set_triple(terms, event, subject, "ex:hasValue", object);
 }
 
 static void generate_test_pattern(TurtleEvent* event, uint32_t pattern_id) {
@@ -106,13 +107,14 @@ static void* load_generator_thread(void* arg) {
     printf("🔥 Load generator started\n");
     
     TurtleEvent* batch = malloc(batch_size * sizeof(TurtleEvent));
+    TurtleInternerCache* terms = turtle_interner_cache_create(turtle_pipeline_get_terms(pipeline));
     
     while (g_running) {
         // Generate a batch of events
         for (uint32_t i = 0; i < batch_size; i++) {
             if (rand() % 100 < 80) {
                 // 80% triple events
-                generate_test_triple(&batch[i], event_id++);
+                generate_test_triple(terms, &batch[i], event_id++);
             } else {
                 // 20% pattern events
                 generate_test_pattern(&batch[i], rand() % 100);
@@ -134,8 +136,10 @@ static void* load_generator_thread(void* arg) {
         }
     }
     
+    printf("🔥 Load generator stopped (term cache %llu hits, %llu misses)\n",
+           (unsigned long long)terms->hits, (unsigned long long)terms->misses);
+    turtle_interner_cache_destroy(terms);
     free(batch);
-    printf("🔥 Load generator stopped\n");
     return NULL;
 }
 
@@ -205,6 +209,10 @@ static void* metrics_reporter_thread(void* arg) {
         printf("   CPU utilization: %.1f%%\n", metrics.cpu_utilization * 100);
         printf("   Memory usage: %.2f MB\n", metrics.memory_usage_mb);
         printf("   Pattern cache hits: %llu\n", metrics.pattern_cache_hits);
+        if (metrics.terms_refused) {
+            printf("   ⚠️ Term store full: %llu terms/literals refused\n",
+                   (unsigned long long)metrics.terms_refused);
+        }
         
         // Check 7-tick constraint
         bool tick_valid = turtle_pipeline_validate_tick_constraint(pipeline);
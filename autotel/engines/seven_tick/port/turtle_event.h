@@ -0,0 +1,63 @@
+/**
+ * @file turtle_event.h
+ * @brief CNS v8 Continuous Turtle Loop - Stream Event Layout
+ * @version 1.0.0
+ *
+ * Shared by the pipeline and its rings; kept free of pipeline types so the
+ * ring can be built and benchmarked on its own.
+ */
+
+#ifndef TURTLE_EVENT_H
+#define TURTLE_EVENT_H
+
+#include <stdint.h>
+#include "bitmask_compiler.h"
+#include "turtle_term_interner.h"
+
+// Turtle data stream events
+typedef enum {
+    TURTLE_EVENT_TRIPLE,
+    TURTLE_EVENT_PATTERN,
+    TURTLE_EVENT_RULE,
+    TURTLE_EVENT_CHECKPOINT,
+    TURTLE_EVENT_SCALE_UP,
+    TURTLE_EVENT_SCALE_DOWN,
+    TURTLE_EVENT_RELOAD_PATTERN,
+    TURTLE_EVENT_METRICS
+} TurtleEventType;
+
+// Stream event structure: one cache line. Triple terms are interned ids
+// resolved through the pipeline's TurtleTermStore.
+typedef struct {
+    TurtleEventType type;
+    uint64_t timestamp_ns;
+    uint32_t sequence_id;
+    uint32_t partition_key;
+    union {
+        struct {
+            TurtleTermId subject;
+            TurtleTermId predicate;
+            TurtleTermId object;     // TURTLE_TERM_NONE when the object is a literal
+            uint32_t literal_length;
+            uint64_t literal_offset; // Into the literal arena, NUL-terminated
+        } triple;
+        struct {
+            uint32_t pattern_id;
+            uint8_t pattern_mask[32];
+            float confidence;
+        } pattern;
+        struct {
+            uint32_t rule_id;
+            CompiledRule rule;
+        } rule;
+        struct {
+            uint64_t processed_count;
+            uint64_t error_count;
+            double throughput_tps;
+        } checkpoint;
+    } data;
+} TurtleEvent;
+
+_Static_assert(sizeof(TurtleEvent) == 64, "TurtleEvent should fill exactly one cache line");
+
+#endif // TURTLE_EVENT_H
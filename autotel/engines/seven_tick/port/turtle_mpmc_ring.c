@@ -0,0 +1,223 @@
+/**
+ * @file turtle_mpmc_ring.c
+ * @brief CNS v8 Continuous Turtle Loop - Lock-free MPMC Event Ring
+ * @version 1.0.0
+ */
+
+#include "turtle_mpmc_ring.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// SEGMENTS
+// =============================================================================
+
+static TurtleRingSegment* segment_create(uint32_t capacity) {
+    uint64_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    TurtleRingSegment* segment = aligned_alloc(64, sizeof(TurtleRingSegment));
+    if (!segment) return NULL;
+    memset(segment, 0, sizeof(*segment));
+
+    segment->sequences = malloc(size * sizeof(uint64_t));
+    segment->events = aligned_alloc(64, size * sizeof(TurtleEvent));
+    if (!segment->sequences || !segment->events) {
+        free(segment->sequences);
+        free(segment->events);
+        free(segment);
+        return NULL;
+    }
+
+    for (uint64_t i = 0; i < size; i++) {
+        atomic_init(&segment->sequences[i], i);
+    }
+    segment->capacity = size;
+    segment->mask = size - 1;
+    atomic_init(&segment->enqueue_pos, 0);
+    atomic_init(&segment->dequeue_pos, 0);
+    atomic_init(&segment->next, NULL);
+    return segment;
+}
+
+static void segment_destroy(TurtleRingSegment* segment) {
+    free(segment->sequences);
+    free(segment->events);
+    free(segment);
+}
+
+// =============================================================================
+// RING LIFECYCLE
+// =============================================================================
+
+TurtleRingBuffer* turtle_ring_create(uint32_t capacity) {
+    TurtleRingBuffer* ring = aligned_alloc(64, sizeof(TurtleRingBuffer));
+    if (!ring) return NULL;
+    memset(ring, 0, sizeof(*ring));
+
+    TurtleRingSegment* segment = segment_create(capacity);
+    if (!segment) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->first = segment;
+    atomic_init(&ring->head, segment);
+    atomic_init(&ring->tail, segment);
+    pthread_mutex_init(&ring->grow_lock, NULL);
+    return ring;
+}
+
+void turtle_ring_destroy(TurtleRingBuffer* ring) {
+    if (!ring) return;
+
+    TurtleRingSegment* segment = ring->first;
+    while (segment) {
+        TurtleRingSegment* next = atomic_load_explicit(&segment->next, memory_order_relaxed);
+        segment_destroy(segment);
+        segment = next;
+    }
+    pthread_mutex_destroy(&ring->grow_lock);
+    free(ring);
+}
+
+bool turtle_ring_grow(TurtleRingBuffer* ring, uint32_t capacity) {
+    if (!ring) return false;
+
+    pthread_mutex_lock(&ring->grow_lock);
+    TurtleRingSegment* old = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (capacity <= old->capacity) {
+        pthread_mutex_unlock(&ring->grow_lock);
+        return false;
+    }
+
+    TurtleRingSegment* segment = segment_create(capacity);
+    if (!segment) {
+        pthread_mutex_unlock(&ring->grow_lock);
+        return false;
+    }
+
+    // Link and publish before closing, so a producer that sees the closed
+    // bit always finds the new tail
+    atomic_store_explicit(&old->next, segment, memory_order_release);
+    atomic_store_explicit(&ring->tail, segment, memory_order_release);
+    atomic_fetch_or_explicit(&old->enqueue_pos, TURTLE_RING_CLOSED, memory_order_acq_rel);
+
+    pthread_mutex_unlock(&ring->grow_lock);
+    return true;
+}
+
+// =============================================================================
+// PRODUCERS
+// =============================================================================
+
+uint32_t turtle_ring_push_batch(TurtleRingBuffer* ring, const TurtleEvent* events, uint32_t count) {
+    if (!ring || !events || count == 0) return 0;
+
+    for (;;) {
+        TurtleRingSegment* segment = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        uint64_t pos = atomic_load_explicit(&segment->enqueue_pos, memory_order_acquire);
+        if (pos & TURTLE_RING_CLOSED) continue; // Grown: tail already points past it
+
+        // Claim the run of free slots starting at pos
+        uint32_t n = 0;
+        while (n < count && n < segment->capacity &&
+               atomic_load_explicit(&segment->sequences[(pos + n) & segment->mask],
+                                    memory_order_acquire) == pos + n) {
+            n++;
+        }
+
+        if (n == 0) {
+            uint64_t seq = atomic_load_explicit(&segment->sequences[pos & segment->mask],
+                                                memory_order_acquire);
+            if ((int64_t)(seq - pos) < 0) return 0; // Full
+            continue;                               // Lost a race; pos is stale
+        }
+
+        if (!atomic_compare_exchange_weak_explicit(&segment->enqueue_pos, &pos, pos + n,
+                                                   memory_order_relaxed, memory_order_relaxed)) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint64_t slot = (pos + i) & segment->mask;
+            segment->events[slot] = events[i];
+            atomic_store_explicit(&segment->sequences[slot], pos + i + 1, memory_order_release);
+        }
+        return n;
+    }
+}
+
+// =============================================================================
+// CONSUMERS
+// =============================================================================
+
+uint32_t turtle_ring_pop_batch(TurtleRingBuffer* ring, TurtleEvent* events, uint32_t max_count) {
+    if (!ring || !events || max_count == 0) return 0;
+
+    for (;;) {
+        TurtleRingSegment* segment = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t pos = atomic_load_explicit(&segment->dequeue_pos, memory_order_relaxed);
+
+        uint32_t n = 0;
+        while (n < max_count && n < segment->capacity &&
+               atomic_load_explicit(&segment->sequences[(pos + n) & segment->mask],
+                                    memory_order_acquire) == pos + n + 1) {
+            n++;
+        }
+
+        if (n == 0) {
+            uint64_t seq = atomic_load_explicit(&segment->sequences[pos & segment->mask],
+                                                memory_order_acquire);
+            if ((int64_t)(seq - (pos + 1)) >= 0) continue; // Lost a race; pos is stale
+
+            // Empty here. A closed segment whose last claimed slot has been
+            // consumed is finished: move every consumer to the next one.
+            uint64_t end = atomic_load_explicit(&segment->enqueue_pos, memory_order_acquire);
+            if ((end & TURTLE_RING_CLOSED) && (end & ~TURTLE_RING_CLOSED) == pos) {
+                TurtleRingSegment* next = atomic_load_explicit(&segment->next, memory_order_acquire);
+                atomic_compare_exchange_strong_explicit(&ring->head, &segment, next,
+                                                        memory_order_acq_rel, memory_order_acquire);
+                continue;
+            }
+            return 0;
+        }
+
+        if (!atomic_compare_exchange_weak_explicit(&segment->dequeue_pos, &pos, pos + n,
+                                                   memory_order_relaxed, memory_order_relaxed)) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint64_t slot = (pos + i) & segment->mask;
+            events[i] = segment->events[slot];
+            atomic_store_explicit(&segment->sequences[slot], pos + i + segment->capacity,
+                                  memory_order_release);
+        }
+        return n;
+    }
+}
+
+// =============================================================================
+// INTROSPECTION
+// =============================================================================
+
+uint32_t turtle_ring_size(TurtleRingBuffer* ring) {
+    if (!ring) return 0;
+
+    uint64_t size = 0;
+    TurtleRingSegment* segment = atomic_load_explicit(&ring->head, memory_order_acquire);
+    while (segment) {
+        uint64_t enq = atomic_load_explicit(&segment->enqueue_pos, memory_order_relaxed) & ~TURTLE_RING_CLOSED;
+        uint64_t deq = atomic_load_explicit(&segment->dequeue_pos, memory_order_relaxed);
+        if (enq > deq) size += enq - deq;
+        segment = atomic_load_explicit(&segment->next, memory_order_acquire);
+    }
+    return size > UINT32_MAX ? UINT32_MAX : (uint32_t)size;
+}
+
+uint32_t turtle_ring_capacity(TurtleRingBuffer* ring) {
+    if (!ring) return 0;
+    return (uint32_t)atomic_load_explicit(&ring->tail, memory_order_acquire)->capacity;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file turtle_mpmc_ring.h
+ * @brief CNS v8 Continuous Turtle Loop - Lock-free MPMC Event Ring
+ * @version 1.0.0
+ *
+ * Bounded multi-producer/multi-consumer ring with per-slot sequence numbers
+ * (Vyukov). Producers and consumers claim runs of slots with one CAS, so
+ * batches cost one atomic per batch rather than per event.
+ *
+ * Growth never resizes in place: a larger segment is chained behind the
+ * current one and the old segment is closed. Producers move to the new
+ * segment immediately; consumers move once the old one drains, so FIFO
+ * order holds across the switch. Retired segments stay allocated until the
+ * ring is destroyed, so no consumer can touch freed memory.
+ */
+
+#ifndef TURTLE_MPMC_RING_H
+#define TURTLE_MPMC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "turtle_event.h"
+
+#define TURTLE_RING_CLOSED (1ULL << 63) // Set in enqueue_pos once a segment is retired
+
+typedef struct TurtleRingSegment {
+    _Alignas(64) _Atomic uint64_t enqueue_pos;
+    _Alignas(64) _Atomic uint64_t dequeue_pos;
+    _Alignas(64) struct TurtleRingSegment* _Atomic next;
+    uint64_t capacity;
+    uint64_t mask;
+    _Atomic uint64_t* sequences; // Slot i is free for pos when == pos, full when == pos + 1
+    TurtleEvent* events;
+} TurtleRingSegment;
+
+typedef struct {
+    _Alignas(64) TurtleRingSegment* _Atomic head; // Consumers
+    _Alignas(64) TurtleRingSegment* _Atomic tail; // Producers
+    TurtleRingSegment* first;                     // Oldest segment, for destroy
+    pthread_mutex_t grow_lock;                    // Serializes growth only
+} TurtleRingBuffer;
+
+TurtleRingBuffer* turtle_ring_create(uint32_t capacity);
+void turtle_ring_destroy(TurtleRingBuffer* ring);
+
+// Return the number of events moved (from the front of the array); 0 when full/empty
+uint32_t turtle_ring_push_batch(TurtleRingBuffer* ring, const TurtleEvent* events, uint32_t count);
+uint32_t turtle_ring_pop_batch(TurtleRingBuffer* ring, TurtleEvent* events, uint32_t max_count);
+
+static inline bool turtle_ring_push(TurtleRingBuffer* ring, const TurtleEvent* event) {
+    return turtle_ring_push_batch(ring, event, 1) == 1;
+}
+
+static inline bool turtle_ring_pop(TurtleRingBuffer* ring, TurtleEvent* event) {
+    return turtle_ring_pop_batch(ring, event, 1) == 1;
+}
+
+// Chain a segment of at least capacity slots; false if not larger or out of memory
+bool turtle_ring_grow(TurtleRingBuffer* ring, uint32_t capacity);
+
+// Approximate while producers and consumers run
+uint32_t turtle_ring_size(TurtleRingBuffer* ring);
+uint32_t turtle_ring_capacity(TurtleRingBuffer* ring);
+
+#endif // TURTLE_MPMC_RING_H
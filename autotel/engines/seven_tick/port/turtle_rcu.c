@@ -0,0 +1,145 @@
+/**
+ * @file turtle_rcu.c
+ * @brief CNS v8 Continuous Turtle Loop - Epoch-based Read-Copy-Update
+ * @version 1.0.0
+ */
+
+#include "turtle_rcu.h"
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+bool turtle_rcu_init(TurtleRcu* rcu, void* initial) {
+    if (!rcu) return false;
+
+    memset(rcu, 0, sizeof(*rcu));
+    atomic_init(&rcu->current, initial);
+    atomic_init(&rcu->global_epoch, 1); // 0 is TURTLE_RCU_OFFLINE
+    for (uint32_t i = 0; i < TURTLE_RCU_MAX_READERS; i++) {
+        atomic_init(&rcu->readers[i].epoch, TURTLE_RCU_OFFLINE);
+    }
+    rcu->retired = malloc(TURTLE_RCU_RETIRE_INITIAL * sizeof(TurtleRcuRetired));
+    if (!rcu->retired || pthread_mutex_init(&rcu->writer_lock, NULL) != 0) {
+        free(rcu->retired);
+        memset(rcu, 0, sizeof(*rcu)); // Caller still owns initial
+        return false;
+    }
+    rcu->retired_capacity = TURTLE_RCU_RETIRE_INITIAL;
+    return true;
+}
+
+void turtle_rcu_destroy(TurtleRcu* rcu, TurtleRcuFree free_fn) {
+    if (!rcu) return;
+
+    // Caller guarantees readers have stopped
+    for (uint32_t i = 0; i < rcu->retired_count; i++) {
+        rcu->retired[i].free_fn(rcu->retired[i].object);
+    }
+    free(rcu->retired);
+    rcu->retired = NULL;
+    rcu->retired_count = 0;
+    rcu->retired_capacity = 0;
+
+    void* current = atomic_load(&rcu->current);
+    if (current && free_fn) free_fn(current);
+    atomic_store(&rcu->current, NULL);
+
+    pthread_mutex_destroy(&rcu->writer_lock);
+}
+
+// =============================================================================
+// RECLAMATION
+// =============================================================================
+
+// Oldest epoch any online reader may still hold references from
+static uint64_t oldest_reader_epoch(TurtleRcu* rcu) {
+    uint64_t oldest = UINT64_MAX;
+    for (uint32_t i = 0; i < TURTLE_RCU_MAX_READERS; i++) {
+        uint64_t epoch = atomic_load(&rcu->readers[i].epoch);
+        if (epoch != TURTLE_RCU_OFFLINE && epoch < oldest) oldest = epoch;
+    }
+    return oldest;
+}
+
+static uint32_t reclaim_locked(TurtleRcu* rcu) {
+    if (rcu->retired_count == 0) return 0;
+
+    uint64_t oldest = oldest_reader_epoch(rcu);
+    uint32_t kept = 0, freed = 0;
+    for (uint32_t i = 0; i < rcu->retired_count; i++) {
+        TurtleRcuRetired* entry = &rcu->retired[i];
+        if (entry->epoch <= oldest) {
+            entry->free_fn(entry->object);
+            freed++;
+        } else {
+            rcu->retired[kept++] = *entry;
+        }
+    }
+    rcu->retired_count = kept;
+    rcu->reclaimed += freed;
+    return freed;
+}
+
+uint32_t turtle_rcu_reclaim(TurtleRcu* rcu) {
+    if (!rcu) return 0;
+
+    pthread_mutex_lock(&rcu->writer_lock);
+    uint32_t freed = reclaim_locked(rcu);
+    pthread_mutex_unlock(&rcu->writer_lock);
+    return freed;
+}
+
+uint32_t turtle_rcu_pending(TurtleRcu* rcu) {
+    if (!rcu) return 0;
+
+    pthread_mutex_lock(&rcu->writer_lock);
+    uint32_t pending = rcu->retired_count;
+    pthread_mutex_unlock(&rcu->writer_lock);
+    return pending;
+}
+
+// =============================================================================
+// PUBLICATION
+// =============================================================================
+
+// Make room for one more retired object without waiting on readers: a
+// publisher may itself be an online reader, so waiting here could deadlock
+static bool reserve_retired_locked(TurtleRcu* rcu) {
+    if (rcu->retired_count < rcu->retired_capacity) return true;
+    if (reclaim_locked(rcu) > 0) return true;
+
+    uint32_t capacity = rcu->retired_capacity * 2;
+    TurtleRcuRetired* grown = realloc(rcu->retired, capacity * sizeof(TurtleRcuRetired));
+    if (!grown) return false;
+    rcu->retired = grown;
+    rcu->retired_capacity = capacity;
+    return true;
+}
+
+bool turtle_rcu_publish(TurtleRcu* rcu, void* object, TurtleRcuFree free_fn) {
+    if (!rcu) return false;
+
+    pthread_mutex_lock(&rcu->writer_lock);
+
+    if (free_fn && !reserve_retired_locked(rcu)) {
+        pthread_mutex_unlock(&rcu->writer_lock);
+        return false;
+    }
+
+    // Swap first, then advance: a reader that announces the new epoch is
+    // guaranteed to load the new object
+    void* old = atomic_exchange(&rcu->current, object);
+    uint64_t epoch = atomic_fetch_add(&rcu->global_epoch, 1) + 1;
+
+    if (old && free_fn) {
+        rcu->retired[rcu->retired_count++] = (TurtleRcuRetired){
+            .object = old, .free_fn = free_fn, .epoch = epoch};
+    }
+    reclaim_locked(rcu);
+
+    pthread_mutex_unlock(&rcu->writer_lock);
+    return true;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file turtle_rcu.h
+ * @brief CNS v8 Continuous Turtle Loop - Epoch-based Read-Copy-Update
+ * @version 1.0.0
+ *
+ * Publishes read-mostly state (compiled pattern sets) to workers without
+ * locks:
+ * - Readers load the published pointer with one atomic load
+ * - Readers announce a quiescent state between batches with one store
+ * - Writers swap the pointer, advance the epoch and retire the old object;
+ *   it is freed once every online reader has announced the new epoch
+ *
+ * Reader operations are wait-free. Writers serialise on a mutex that readers
+ * never touch, and never wait for readers: the retire list grows instead, so
+ * a reader may publish from inside its own read section.
+ */
+
+#ifndef TURTLE_RCU_H
+#define TURTLE_RCU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define TURTLE_RCU_MAX_READERS 64   // One slot per worker
+#define TURTLE_RCU_OFFLINE 0        // Reader holds no references
+#define TURTLE_RCU_RETIRE_INITIAL 256  // Retire list grows past this
+
+typedef void (*TurtleRcuFree)(void* object);
+
+// Per-reader epoch, one cache line each so announcements never share a line
+typedef struct {
+    _Alignas(64) _Atomic uint64_t epoch;
+} TurtleRcuReader;
+
+typedef struct {
+    void* object;
+    TurtleRcuFree free_fn;
+    uint64_t epoch;              // Safe once every online reader reaches this
+} TurtleRcuRetired;
+
+typedef struct {
+    _Alignas(64) _Atomic(void*) current;
+    _Alignas(64) _Atomic uint64_t global_epoch;
+    TurtleRcuReader readers[TURTLE_RCU_MAX_READERS];
+
+    // Writer side
+    pthread_mutex_t writer_lock;
+    TurtleRcuRetired* retired;
+    uint32_t retired_count;
+    uint32_t retired_capacity;
+    uint64_t reclaimed;
+} TurtleRcu;
+
+// Lifecycle; destroy frees the current object and everything retired
+bool turtle_rcu_init(TurtleRcu* rcu, void* initial);
+void turtle_rcu_destroy(TurtleRcu* rcu, TurtleRcuFree free_fn);
+
+// Writers: publish a new object and retire the previous one. Never waits for
+// readers; returns false (nothing published, caller keeps object) only if the
+// retire list cannot grow.
+bool turtle_rcu_publish(TurtleRcu* rcu, void* object, TurtleRcuFree free_fn);
+
+// Free retired objects that no reader can still hold; returns count freed
+uint32_t turtle_rcu_reclaim(TurtleRcu* rcu);
+uint32_t turtle_rcu_pending(TurtleRcu* rcu);
+
+// Readers (wait-free)
+static inline void turtle_rcu_quiescent(TurtleRcu* rcu, uint32_t reader) {
+    // seq_cst store/load pair: a reader that announces epoch E is ordered
+    // after the swap that advanced the epoch to E
+    atomic_store(&rcu->readers[reader].epoch, atomic_load(&rcu->global_epoch));
+}
+
+static inline void turtle_rcu_offline(TurtleRcu* rcu, uint32_t reader) {
+    atomic_store_explicit(&rcu->readers[reader].epoch, TURTLE_RCU_OFFLINE,
+                          memory_order_release);
+}
+
+static inline void* turtle_rcu_read(TurtleRcu* rcu) {
+    return atomic_load(&rcu->current);
+}
+
+#endif // TURTLE_RCU_H
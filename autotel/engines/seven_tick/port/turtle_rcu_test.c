@@ -0,0 +1,227 @@
+/**
+ * @file turtle_rcu_test.c
+ * @brief Pattern set hot reload under full worker load
+ * @version 1.0.0
+ *
+ * Usage: turtle_rcu_test [readers] [seconds]
+ *
+ * Reader threads spin through batches exactly like pipeline workers:
+ * announce a quiescent state, load the published RuleSet, and walk every
+ * rule. A writer recompiles and publishes a new set as fast as it can.
+ * Retired sets are poisoned before they are freed, so a reader that still
+ * held one would see a torn set. The test also checks that idle (offline)
+ * readers never delay reclamation, that a reader can publish from inside its
+ * own read section without waiting on itself, and that nothing leaks at
+ * shutdown.
+ */
+
+#include "turtle_rcu.h"
+#include "bitmask_compiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TEST_BATCH_RULES_PASSES 32   // Rule walks per batch
+#define TEST_RULES_PER_SET 64
+
+static _Atomic bool running = true;
+static _Atomic uint64_t sets_freed = 0;
+
+typedef struct {
+    TurtleRcu* rcu;
+    uint32_t id;
+    uint64_t batches;
+    uint64_t torn_sets;
+    uint64_t generations_seen;
+} ReaderState;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Every rule in generation g targets actor g, bit (index % 8)
+static RuleSet* build_generation(BitmaskCompiler* compiler, int generation) {
+    char text[TEST_RULES_PER_SET * 32];
+    size_t used = 0;
+    for (int i = 0; i < TEST_RULES_PER_SET; i++) {
+        used += (size_t)snprintf(text + used, sizeof(text) - used,
+                                 "ACTOR %d BIT %d SET\n", generation, i % 8);
+    }
+    return compile_rules(compiler, text);
+}
+
+static void poison_rule_set(void* object) {
+    RuleSet* rules = (RuleSet*)object;
+    memset(rules->rules, 0xFF, rules->capacity * sizeof(CompiledRule));
+    rules->num_rules = 0;
+    destroy_rule_set(rules);
+    atomic_fetch_add(&sets_freed, 1);
+}
+
+static void* reader_main(void* arg) {
+    ReaderState* state = (ReaderState*)arg;
+    int last_generation = -1;
+
+    while (atomic_load_explicit(&running, memory_order_relaxed)) {
+        turtle_rcu_quiescent(state->rcu, state->id);
+        const RuleSet* rules = turtle_rcu_read(state->rcu);
+
+        int generation = rules->rules[0].action_actor_index;
+        for (int pass = 0; pass < TEST_BATCH_RULES_PASSES; pass++) {
+            if (rules->num_rules != TEST_RULES_PER_SET) {
+                state->torn_sets++;
+                break;
+            }
+            for (size_t i = 0; i < rules->num_rules; i++) {
+                if (rules->rules[i].action_actor_index != generation ||
+                    rules->rules[i].action_bit_position != (int)(i % 8)) {
+                    state->torn_sets++;
+                    break;
+                }
+            }
+        }
+
+        if (generation < last_generation) state->torn_sets++; // Went backwards
+        if (generation != last_generation) state->generations_seen++;
+        last_generation = generation;
+        state->batches++;
+    }
+
+    turtle_rcu_offline(state->rcu, state->id);
+    return NULL;
+}
+
+static int test_offline_readers_do_not_block(BitmaskCompiler* compiler) {
+    TurtleRcu rcu;
+    turtle_rcu_init(&rcu, build_generation(compiler, 0));
+
+    // Reader 0 goes online then idle; reader 1 stays in a long batch
+    turtle_rcu_quiescent(&rcu, 0);
+    turtle_rcu_offline(&rcu, 0);
+    turtle_rcu_quiescent(&rcu, 1);
+
+    uint64_t freed_before = atomic_load(&sets_freed);
+    turtle_rcu_publish(&rcu, build_generation(compiler, 1), poison_rule_set);
+    int held = turtle_rcu_pending(&rcu) == 1; // Reader 1 may hold gen 0
+
+    turtle_rcu_quiescent(&rcu, 1);           // Reader 1 finishes its batch
+    turtle_rcu_reclaim(&rcu);
+    int released = turtle_rcu_pending(&rcu) == 0 &&
+                   atomic_load(&sets_freed) == freed_before + 1;
+
+    turtle_rcu_offline(&rcu, 1);
+    turtle_rcu_publish(&rcu, build_generation(compiler, 2), poison_rule_set);
+    int immediate = turtle_rcu_pending(&rcu) == 0; // Nobody online
+
+    turtle_rcu_destroy(&rcu, poison_rule_set);
+
+    int ok = held && released && immediate;
+    printf("  offline readers: held=%d released=%d immediate=%d  %s\n",
+           held, released, immediate, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+static int test_publish_inside_read_section(BitmaskCompiler* compiler) {
+    TurtleRcu rcu;
+    turtle_rcu_init(&rcu, build_generation(compiler, 0));
+    atomic_store(&sets_freed, 0);
+
+    // Reader 0 stays in one batch and publishes far past the initial retire
+    // list size; none of the retired sets may be freed while it is online
+    const uint32_t publishes = TURTLE_RCU_RETIRE_INITIAL * 4 + 1;
+    turtle_rcu_quiescent(&rcu, 0);
+    uint32_t published = 0;
+    for (uint32_t i = 0; i < publishes; i++) {
+        published += turtle_rcu_publish(&rcu, build_generation(compiler, (int)i + 1),
+                                        poison_rule_set);
+    }
+    int held = published == publishes && turtle_rcu_pending(&rcu) == publishes &&
+               atomic_load(&sets_freed) == 0;
+
+    turtle_rcu_quiescent(&rcu, 0);
+    turtle_rcu_reclaim(&rcu);
+    int released = turtle_rcu_pending(&rcu) == 0 && atomic_load(&sets_freed) == publishes;
+
+    turtle_rcu_offline(&rcu, 0);
+    turtle_rcu_destroy(&rcu, poison_rule_set);
+
+    int ok = held && released;
+    printf("  publish in read section: %u sets, held=%d released=%d  %s\n",
+           publishes, held, released, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+static int test_reload_under_load(BitmaskCompiler* compiler, uint32_t readers, uint32_t seconds) {
+    TurtleRcu rcu;
+    turtle_rcu_init(&rcu, build_generation(compiler, 0));
+    atomic_store(&sets_freed, 0);
+    atomic_store(&running, true);
+
+    ReaderState states[TURTLE_RCU_MAX_READERS];
+    pthread_t threads[TURTLE_RCU_MAX_READERS];
+    for (uint32_t i = 0; i < readers; i++) {
+        states[i] = (ReaderState){.rcu = &rcu, .id = i};
+        pthread_create(&threads[i], NULL, reader_main, &states[i]);
+    }
+
+    // Writer: back-to-back reloads for the whole run
+    uint64_t reloads = 0;
+    uint32_t max_pending = 0;
+    uint64_t deadline = now_ns() + (uint64_t)seconds * 1000000000ULL;
+    while (now_ns() < deadline) {
+        RuleSet* next = build_generation(compiler, (int)(reloads + 1));
+        if (!next) break;
+        turtle_rcu_publish(&rcu, next, poison_rule_set);
+        reloads++;
+        uint32_t pending = turtle_rcu_pending(&rcu);
+        if (pending > max_pending) max_pending = pending;
+    }
+
+    atomic_store(&running, false);
+    uint64_t batches = 0, torn = 0, generations = 0;
+    for (uint32_t i = 0; i < readers; i++) {
+        pthread_join(threads[i], NULL);
+        batches += states[i].batches;
+        torn += states[i].torn_sets;
+        generations += states[i].generations_seen;
+    }
+
+    // All readers offline: everything retired is reclaimable now
+    turtle_rcu_reclaim(&rcu);
+    uint32_t leaked = turtle_rcu_pending(&rcu);
+    uint64_t freed = atomic_load(&sets_freed);
+    turtle_rcu_destroy(&rcu, poison_rule_set);
+
+    int ok = torn == 0 && leaked == 0 && freed == reloads && reloads > 0;
+    printf("  %2u readers: %llu reloads, %llu batches (%.1f M/s), %.1f generations seen per reader,\n"
+           "             max %u sets awaiting reclaim, torn=%llu leaked=%u  %s\n",
+           readers, (unsigned long long)reloads, (unsigned long long)batches,
+           batches / (seconds * 1e6), (double)generations / readers, max_pending,
+           (unsigned long long)torn, leaked, ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t readers = argc > 1 ? (uint32_t)atoi(argv[1]) : (uint32_t)(cpus > 1 ? cpus - 1 : 1);
+    uint32_t seconds = argc > 2 ? (uint32_t)atoi(argv[2]) : 2;
+    if (readers < 1) readers = 1;
+    if (readers > TURTLE_RCU_MAX_READERS) readers = TURTLE_RCU_MAX_READERS;
+
+    printf("🔄 Pattern set RCU reload test\n");
+    BitmaskCompiler* compiler = create_bitmask_compiler();
+    int failures = 0;
+
+    failures += test_offline_readers_do_not_block(compiler);
+    failures += test_publish_inside_read_section(compiler);
+    failures += test_reload_under_load(compiler, readers, seconds);
+    failures += test_reload_under_load(compiler, TURTLE_RCU_MAX_READERS, 1);
+
+    destroy_bitmask_compiler(compiler);
+    printf(failures ? "❌ RCU reload test failed\n" : "✅ RCU reload test passed\n");
+    return failures ? 1 : 0;
+}
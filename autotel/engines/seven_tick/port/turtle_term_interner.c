@@ -0,0 +1,229 @@
+/**
+ * @file turtle_term_interner.c
+ * @brief CNS v8 Continuous Turtle Loop - Term Interning Implementation
+ * @version 1.0.0
+ */
+
+#include "turtle_term_interner.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// HASHING
+// =============================================================================
+
+static inline uint64_t term_hash(const char* text, uint32_t length) {
+    uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a
+    for (uint32_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)text[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static inline bool term_equals(const TurtleTermStore* store, TurtleTermId id,
+                               const char* text, uint32_t length) {
+    return store->term_lengths[id] == length &&
+           memcmp(store->term_bytes + store->term_offsets[id], text, length) == 0;
+}
+
+// =============================================================================
+// SHARED STORE
+// =============================================================================
+
+TurtleTermStore* turtle_term_store_create(uint32_t max_terms, uint64_t term_bytes,
+                                          uint64_t literal_bytes) {
+    if (max_terms == 0 || max_terms >= UINT32_MAX / 2) return NULL;
+
+    TurtleTermStore* store = calloc(1, sizeof(TurtleTermStore));
+    if (!store) return NULL;
+    pthread_mutex_init(&store->lock, NULL);
+
+    uint32_t table_size = 16;
+    while (table_size < max_terms * 2) table_size <<= 1;
+
+    // Id 0 is reserved, so arrays indexed by id get one extra slot
+    store->term_offsets = malloc(((size_t)max_terms + 1) * sizeof(uint64_t));
+    store->term_lengths = malloc(((size_t)max_terms + 1) * sizeof(uint32_t));
+    store->table = calloc(table_size, sizeof(uint32_t));
+    store->table_hashes = malloc((size_t)table_size * sizeof(uint64_t));
+    store->term_bytes = malloc(term_bytes);
+    store->literal_bytes = malloc(literal_bytes);
+
+    if (!store->term_offsets || !store->term_lengths || !store->table ||
+        !store->table_hashes || !store->term_bytes || !store->literal_bytes) {
+        turtle_term_store_destroy(store);
+        return NULL;
+    }
+
+    store->table_mask = table_size - 1;
+    store->max_terms = max_terms;
+    store->term_count = 0;
+    store->term_bytes_capacity = term_bytes;
+    store->term_bytes_used = 0;
+    store->literal_capacity = literal_bytes;
+    store->literal_reserved = 0;
+    store->lock_acquisitions = 0;
+    store->terms_refused = 0;
+    store->literals_refused = 0;
+    store->generation = 0;
+
+    return store;
+}
+
+void turtle_term_store_destroy(TurtleTermStore* store) {
+    if (!store) return;
+    pthread_mutex_destroy(&store->lock);
+    free(store->term_offsets);
+    free(store->term_lengths);
+    free(store->table);
+    free(store->table_hashes);
+    free(store->term_bytes);
+    free(store->literal_bytes);
+    free(store);
+}
+
+void turtle_term_store_reset(TurtleTermStore* store) {
+    if (!store) return;
+    pthread_mutex_lock(&store->lock);
+    memset(store->table, 0, ((size_t)store->table_mask + 1) * sizeof(uint32_t));
+    store->term_count = 0;
+    store->term_bytes_used = 0;
+    store->literal_reserved = 0;
+    atomic_fetch_add_explicit(&store->generation, 1, memory_order_release);
+    pthread_mutex_unlock(&store->lock);
+}
+
+static TurtleTermId term_store_intern_hashed(TurtleTermStore* store, const char* text,
+                                             uint32_t length, uint64_t hash) {
+    pthread_mutex_lock(&store->lock);
+    store->lock_acquisitions++;
+
+    uint32_t pos = (uint32_t)hash & store->table_mask;
+    TurtleTermId id;
+    while ((id = store->table[pos]) != TURTLE_TERM_NONE) {
+        if (store->table_hashes[pos] == hash && term_equals(store, id, text, length)) {
+            pthread_mutex_unlock(&store->lock);
+            return id;
+        }
+        pos = (pos + 1) & store->table_mask;
+    }
+
+    // New term: copy NUL-terminated bytes, then publish the id
+    uint32_t count = store->term_count;
+    if (count >= store->max_terms ||
+        store->term_bytes_used + length + 1 > store->term_bytes_capacity) {
+        store->terms_refused++;
+        pthread_mutex_unlock(&store->lock);
+        return TURTLE_TERM_NONE;
+    }
+
+    id = count + 1;
+    uint64_t offset = store->term_bytes_used;
+    memcpy(store->term_bytes + offset, text, length);
+    store->term_bytes[offset + length] = '\0';
+    store->term_bytes_used += length + 1;
+    store->term_offsets[id] = offset;
+    store->term_lengths[id] = length;
+    store->table_hashes[pos] = hash;
+    store->table[pos] = id;
+    store->term_count = id;
+
+    pthread_mutex_unlock(&store->lock);
+    return id;
+}
+
+TurtleTermId turtle_term_store_intern(TurtleTermStore* store, const char* text, uint32_t length) {
+    if (!store || !text) return TURTLE_TERM_NONE;
+    return term_store_intern_hashed(store, text, length, term_hash(text, length));
+}
+
+const char* turtle_term_store_lookup(const TurtleTermStore* store, TurtleTermId id,
+                                     uint32_t* length) {
+    if (!store || id == TURTLE_TERM_NONE || id > store->term_count) return NULL;
+    if (length) *length = store->term_lengths[id];
+    return store->term_bytes + store->term_offsets[id];
+}
+
+const char* turtle_term_store_literal(const TurtleTermStore* store, uint64_t offset) {
+    if (!store || offset >= store->literal_capacity) return NULL;
+    return store->literal_bytes + offset;
+}
+
+// =============================================================================
+// PRODUCER CACHE
+// =============================================================================
+
+TurtleInternerCache* turtle_interner_cache_create(TurtleTermStore* store) {
+    if (!store) return NULL;
+    TurtleInternerCache* cache = calloc(1, sizeof(TurtleInternerCache));
+    if (!cache) return NULL;
+    cache->store = store;
+    cache->generation = atomic_load_explicit(&store->generation, memory_order_acquire);
+    return cache;
+}
+
+void turtle_interner_cache_destroy(TurtleInternerCache* cache) {
+    free(cache);
+}
+
+// Ids and the reserved literal chunk are void after a store reset
+static inline void interner_cache_sync(TurtleInternerCache* cache) {
+    uint32_t generation = atomic_load_explicit(&cache->store->generation, memory_order_acquire);
+    if (cache->generation != generation) {
+        memset(cache->entries, 0, sizeof(cache->entries));
+        cache->literal_pos = cache->literal_end = 0;
+        cache->generation = generation;
+    }
+}
+
+TurtleTermId turtle_interner_intern(TurtleInternerCache* cache, const char* text, uint32_t length) {
+    if (!cache || !text) return TURTLE_TERM_NONE;
+    interner_cache_sync(cache);
+
+    uint64_t hash = term_hash(text, length);
+    TurtleInternerCacheEntry* entry = &cache->entries[hash & (TURTLE_INTERNER_CACHE_SIZE - 1)];
+
+    // Ids in this cache were published before this thread saw them
+    if (entry->id != TURTLE_TERM_NONE && entry->hash == hash &&
+        term_equals(cache->store, entry->id, text, length)) {
+        cache->hits++;
+        return entry->id;
+    }
+
+    cache->misses++;
+    TurtleTermId id = term_store_intern_hashed(cache->store, text, length, hash);
+    if (id != TURTLE_TERM_NONE) {
+        entry->hash = hash;
+        entry->id = id;
+    }
+    return id;
+}
+
+bool turtle_interner_add_literal(TurtleInternerCache* cache, const char* text, uint32_t length,
+                                 uint64_t* offset) {
+    if (!cache || !text || !offset) return false;
+    interner_cache_sync(cache);
+
+    uint64_t need = (uint64_t)length + 1;
+    if (cache->literal_pos + need > cache->literal_end) {
+        TurtleTermStore* store = cache->store;
+        uint64_t chunk = need > TURTLE_LITERAL_CHUNK ? need : TURTLE_LITERAL_CHUNK;
+        uint64_t start = atomic_fetch_add(&store->literal_reserved, chunk);
+        if (start + chunk > store->literal_capacity) {
+            cache->literal_pos = cache->literal_end = 0;
+            store->literals_refused++;
+            return false; // Arena exhausted
+        }
+        cache->literal_pos = start;
+        cache->literal_end = start + chunk;
+    }
+
+    char* dest = cache->store->literal_bytes + cache->literal_pos;
+    memcpy(dest, text, length);
+    dest[length] = '\0';
+    *offset = cache->literal_pos;
+    cache->literal_pos += need;
+    return true;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file turtle_term_interner.h
+ * @brief CNS v8 Continuous Turtle Loop - Term Interning for Stream Events
+ * @version 1.0.0
+ *
+ * Turtle events carry 32-bit term ids instead of inline strings:
+ * - IRIs and prefixed names are interned once in a shared dictionary
+ * - Literals are appended to a shared arena and referenced by offset
+ * - Each producer thread keeps a private cache, so repeated terms and
+ *   literal appends never touch the dictionary lock
+ *
+ * Term and literal bytes are immutable once published, so consumers resolve
+ * ids and offsets without locking.
+ *
+ * Nothing is freed per term: the dictionary and the literal arena only grow
+ * until they hit the sizes given at creation. Past that point interns and
+ * appends fail and are counted in terms_refused / literals_refused. A
+ * long-running producer reclaims everything with turtle_term_store_reset()
+ * once no event references the current generation.
+ */
+
+#ifndef TURTLE_TERM_INTERNER_H
+#define TURTLE_TERM_INTERNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+typedef uint32_t TurtleTermId;
+
+#define TURTLE_TERM_NONE 0                   // Id 0 is never assigned
+#define TURTLE_INTERNER_CACHE_SIZE 4096      // Per-producer entries (power of two)
+#define TURTLE_LITERAL_CHUNK (64 * 1024)     // Literal bytes reserved per producer refill
+
+// Shared dictionary and literal arena, sized once at creation
+typedef struct {
+    // Dictionary: id -> bytes, plus an open-addressed hash -> id table
+    uint64_t* term_offsets;      // Indexed by id
+    uint32_t* term_lengths;
+    uint32_t* table;             // TURTLE_TERM_NONE = empty
+    uint64_t* table_hashes;
+    uint32_t table_mask;
+    uint32_t max_terms;
+    _Atomic uint32_t term_count; // Ids 1..term_count are assigned
+    char* term_bytes;
+    uint64_t term_bytes_capacity;
+    uint64_t term_bytes_used;
+    pthread_mutex_t lock;        // Dictionary inserts only
+
+    // Literal arena: producers reserve chunks with one atomic add
+    char* literal_bytes;
+    uint64_t literal_capacity;
+    _Atomic uint64_t literal_reserved;
+
+    _Atomic uint64_t lock_acquisitions; // Producer cache misses
+    _Atomic uint64_t terms_refused;     // Interns failed on a full dictionary
+    _Atomic uint64_t literals_refused;  // Appends failed on a full arena
+    _Atomic uint32_t generation;        // Bumped by every reset
+} TurtleTermStore;
+
+typedef struct {
+    uint64_t hash;
+    TurtleTermId id;
+} TurtleInternerCacheEntry;
+
+// Producer-private cache; one per submitting thread
+typedef struct {
+    TurtleTermStore* store;
+    TurtleInternerCacheEntry entries[TURTLE_INTERNER_CACHE_SIZE];
+    uint64_t literal_pos;        // Current reserved chunk
+    uint64_t literal_end;
+    uint32_t generation;         // Store generation the entries belong to
+    uint64_t hits;
+    uint64_t misses;
+} TurtleInternerCache;
+
+// Store lifecycle
+TurtleTermStore* turtle_term_store_create(uint32_t max_terms, uint64_t term_bytes,
+                                          uint64_t literal_bytes);
+void turtle_term_store_destroy(TurtleTermStore* store);
+
+// Drop every term and literal and start a new generation. Caller must be
+// quiescent: no thread interning and no live event holding an id or offset.
+// Producer caches flush themselves on their next call.
+void turtle_term_store_reset(TurtleTermStore* store);
+
+// Slow path: locked dictionary lookup/insert; TURTLE_TERM_NONE when full
+TurtleTermId turtle_term_store_intern(TurtleTermStore* store, const char* text, uint32_t length);
+
+// Lock-free resolution for consumers
+const char* turtle_term_store_lookup(const TurtleTermStore* store, TurtleTermId id,
+                                     uint32_t* length);
+const char* turtle_term_store_literal(const TurtleTermStore* store, uint64_t offset);
+
+// Producer caches
+TurtleInternerCache* turtle_interner_cache_create(TurtleTermStore* store);
+void turtle_interner_cache_destroy(TurtleInternerCache* cache);
+TurtleTermId turtle_interner_intern(TurtleInternerCache* cache, const char* text, uint32_t length);
+bool turtle_interner_add_literal(TurtleInternerCache* cache, const char* text, uint32_t length,
+                                 uint64_t* offset);
+
+#endif // TURTLE_TERM_INTERNER_H
@@ -1,15 +1,20 @@
 #include "cns/bitactor.h"
-#include "cns/bitactor_bridge.h"
-#include "cns/cns_weaver.h"
+#include "tick_source.h"
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
-int main()
+// Usage: backtest [--realtime | --speed N] [tick files...]
+int main(int argc, char **argv)
 {
   // 1. Load compiled manifest
   actor_manifest_t manifest;
-  load_actor_manifest_from_bin("build/backtest_manifest.bin", &manifest);
+  if (load_actor_manifest_from_bin("build/backtest_manifest.bin", &manifest) != BITACTOR_OK)
+  {
+    fprintf(stderr, "manifest: cannot load build/backtest_manifest.bin\n");
+    exit(1);
+  }
 
   // 2. Initialize conductor and registry
   bitactor_conductor_t conductor;
@@ -29,28 +34,59 @@ int main()
   bitactor_pid_t risk_pid = bitactor_conductor_spawn(&conductor, risk_id);
   bitactor_pid_t metrics_pid = bitactor_conductor_spawn(&conductor, metrics_id);
 
-  // 5. Main backtest loop: stream historical ticks
-  FILE *tick_file = fopen("data/historical_ticks.bin", "rb");
-  if (!tick_file)
+  // 5. Main backtest loop: replay mapped tick files, merged by timestamp
+  tick_replay_config_t replay = {.mode = TICK_REPLAY_FAST, .speed = 1.0, .batch_size = TICK_DEFAULT_BATCH};
+  const char *paths[TICK_MAX_FILES];
+  uint32_t path_count = 0;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--realtime") == 0)
+      replay.mode = TICK_REPLAY_REALTIME;
+    else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc)
+    {
+      replay.mode = TICK_REPLAY_SCALED;
+      replay.speed = atof(argv[++i]);
+    }
+    else if (path_count < TICK_MAX_FILES)
+      paths[path_count++] = argv[i];
+  }
+  if (path_count == 0)
+    paths[path_count++] = "data/historical_ticks.bin";
+
+  tick_source_t ticks;
+  if (tick_source_open(&ticks, paths, path_count, &replay) != 0)
   {
-    perror("tick_file");
     exit(1);
   }
-  uint8_t tick[8];
-  while (fread(tick, 1, 8, tick_file) == 8)
+  tick_batch_t batch;
+  int rc = BITACTOR_OK;
+  while (rc == BITACTOR_OK && tick_source_next_batch(&ticks, &batch) > 0)
+  {
+    bitactor_message_t msg = {.type = BITACTOR_CAST, .payload = &batch, .payload_len = sizeof(batch)};
+    rc = bitactor_cast(&conductor, md_pid, &msg);
+  }
+  if (rc != BITACTOR_OK)
   {
-    bitactor_message_t msg = {.type = BITACTOR_CAST, .payload = tick, .payload_len = 8};
-    bitactor_cast(&conductor, md_pid, &msg);
-    // Optionally throttle for real-time simulation
+    // The batch was never handed over; release it so close does not wait
+    __atomic_store_n(batch.consumed, 1, __ATOMIC_RELEASE);
+    fprintf(stderr, "replay: market data actor refused a batch (%d)\n", rc);
   }
-  fclose(tick_file);
+  tick_source_close(&ticks);
+
+  // Let in-flight ticks, orders and fills settle before reading results
+  bitactor_conductor_quiesce(&conductor);
 
   // 6. Collect and print metrics
   bitactor_message_t metrics_req = {.type = BITACTOR_CALL, .payload = NULL, .payload_len = 0};
   bitactor_message_t metrics_reply;
   bitactor_call(&conductor, metrics_pid, &metrics_req, &metrics_reply);
   printf("Backtest Results: %s\n", (char *)metrics_reply.payload);
+  printf("Replay: %llu ticks in %llu batches (%llu out of order, %llu schema errors)\n",
+         (unsigned long long)ticks.stats.ticks, (unsigned long long)ticks.stats.batches,
+         (unsigned long long)ticks.stats.out_of_order, (unsigned long long)ticks.stats.schema_errors);
+  printf("Dropped messages: %llu\n", (unsigned long long)bitactor_conductor_dropped(&conductor));
 
   bitactor_conductor_shutdown(&conductor);
-  return 0;
+  actor_manifest_free(&manifest);
+  return rc == BITACTOR_OK ? 0 : 1;
 }
\ No newline at end of file
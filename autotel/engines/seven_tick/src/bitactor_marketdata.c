@@ -1,12 +1,29 @@
 #include "cns/bitactor.h"
+#include "tick_source.h"
 
-// MarketDataActor: forwards each tick to the strategy actor
-void on_tick(void *state, const void *msg, size_t msg_len)
+static bitactor_peer_t strategy = BITACTOR_PEER("strategy");
+
+// MarketDataActor: receives tick batches by pointer and forwards each tick
+// to the strategy actor
+static void on_batch(void *state, const void *msg, size_t msg_len)
 {
-  bitactor_pid_t strategy_pid = registry_lookup("strategy");
-  bitactor_message_t fwd = {.type = BITACTOR_CAST, .payload = msg, .payload_len = msg_len};
-  bitactor_cast(NULL, strategy_pid, &fwd);
+  (void)state;
+  if (msg_len != sizeof(tick_batch_t))
+    return;
+
+  const tick_batch_t *batch = (const tick_batch_t *)msg;
+  bitactor_pid_t strategy_pid = bitactor_peer_pid(&strategy);
+  for (uint32_t i = 0; i < batch->count; i++)
+  {
+    bitactor_message_t fwd = {.type = BITACTOR_CAST,
+                              .payload = batch->ticks[i].data,
+                              .payload_len = sizeof(batch->ticks[i].data)};
+    bitactor_cast(NULL, strategy_pid, &fwd);
+  }
+
+  // Hand the batch memory back to the tick source
+  __atomic_store_n(batch->consumed, 1, __ATOMIC_RELEASE);
 }
 
 // Register the behavior
-BITACTOR_BEHAVIOR(market_data, on_tick)
\ No newline at end of file
+BITACTOR_BEHAVIOR(market_data, on_batch)
@@ -1,11 +1,20 @@
 #include "cns/bitactor.h"
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 static int64_t pnl = 0;
 
-void on_event(void *state, const void *msg, size_t msg_len)
+// Mailbox enqueue -> dispatch latency of fills, in cycles
+static uint64_t fills = 0;
+static uint64_t latency_total = 0;
+static uint64_t latency_min = UINT64_MAX;
+static uint64_t latency_max = 0;
+
+static void on_event(void *state, const void *msg, size_t msg_len)
 {
+  (void)state;
+  (void)msg_len;
   const uint8_t *fill = (const uint8_t *)msg;
   int side = fill[0];
   int price = fill[3];
@@ -14,14 +23,30 @@ void on_event(void *state, const void *msg, size_t msg_len)
     pnl -= price * qty; // buy
   else if (side == 0x02)
     pnl += price * qty; // sell
+
+  uint64_t latency = bitactor_message_latency();
+  fills++;
+  latency_total += latency;
+  if (latency < latency_min)
+    latency_min = latency;
+  if (latency > latency_max)
+    latency_max = latency;
 }
 
-void on_call(void *state, const void *msg, size_t msg_len, bitactor_message_t *reply)
+static void on_call(void *state, const void *msg, size_t msg_len, bitactor_message_t *reply)
 {
-  static char result[64];
-  snprintf(result, sizeof(result), "PnL: %lld", (long long)pnl);
+  (void)state;
+  (void)msg;
+  (void)msg_len;
+  static char result[160];
+  snprintf(result, sizeof(result),
+           "PnL: %lld fills=%llu msg latency min/avg/max=%llu/%llu/%llu cycles",
+           (long long)pnl, (unsigned long long)fills,
+           (unsigned long long)(fills ? latency_min : 0),
+           (unsigned long long)(fills ? latency_total / fills : 0),
+           (unsigned long long)latency_max);
   reply->payload = result;
   reply->payload_len = strlen(result) + 1;
 }
 
-BITACTOR_BEHAVIOR(metrics, on_event, on_call)
\ No newline at end of file
+BITACTOR_BEHAVIOR(metrics, on_event, on_call)
@@ -1,21 +1,103 @@
 #include "cns/bitactor.h"
+#include "orderbook.h"
 #include <stdint.h>
 
-// Simple orderbook: always fills at requested price
-void match_order(void *state, const void *msg, size_t msg_len)
+// Price-time priority book fed by the strategy. Ticks only carry a print
+// price, so a house market maker stands in for the rest of the market: each
+// strategy order first sees house liquidity on the opposite side at the
+// print it reacted to (carried in the order, so replay stays deterministic
+// across cores). Orders that do not cross rest with queue priority and fill
+// later against house quotes.
+
+#define HOUSE_ID_BIT (1ULL << 63)
+#define HOUSE_QTY 100
+#define BOOK_CAPACITY 4096
+
+static orderbook_t book;
+static int book_ready = 0;
+static uint64_t next_order_id = 1;
+static uint64_t next_house_id = HOUSE_ID_BIT | 1;
+static uint64_t house_id = 0; // Resting house quote, 0 = none
+static int32_t last_status = ORDERBOOK_OK;
+
+static bitactor_peer_t strategy = BITACTOR_PEER("strategy");
+static bitactor_peer_t metrics = BITACTOR_PEER("metrics");
+
+static inline int is_house(uint64_t id)
+{
+  return (id & HOUSE_ID_BIT) != 0;
+}
+
+static void notify_fill(uint8_t side, int64_t price, uint32_t qty)
 {
-  const uint8_t *order = (const uint8_t *)msg;
   uint8_t fill[8] = {0};
-  fill[0] = order[0]; // side
-  fill[3] = order[3]; // price
-  fill[7] = order[7]; // qty
-  // Notify strategy
-  bitactor_pid_t strat_pid = registry_lookup("strategy");
+  fill[0] = side;
+  fill[3] = (uint8_t)price;
+  fill[7] = (uint8_t)qty;
   bitactor_message_t fill_msg = {.type = BITACTOR_CAST, .payload = fill, .payload_len = 8};
-  bitactor_cast(NULL, strat_pid, &fill_msg);
-  // Notify metrics
-  bitactor_pid_t metrics_pid = registry_lookup("metrics");
-  bitactor_cast(NULL, metrics_pid, &fill_msg);
+  // A refused cast is counted by the conductor and reported with the results
+  bitactor_cast(NULL, bitactor_peer_pid(&strategy), &fill_msg);
+  bitactor_cast(NULL, bitactor_peer_pid(&metrics), &fill_msg);
+}
+
+// One fill message per strategy order involved in a trade
+static void on_book_event(const orderbook_event_t *event, void *user)
+{
+  (void)user;
+  if (event->type != ORDERBOOK_EVENT_TRADE)
+    return;
+
+  if (!is_house(event->order_id))
+    notify_fill(event->side, event->price, event->qty);
+  if (!is_house(event->maker_id))
+    notify_fill(event->side == ORDERBOOK_BUY ? ORDERBOOK_SELL : ORDERBOOK_BUY,
+                event->price, event->qty);
+
+  // A fully filled house quote has left the book
+  if ((event->maker_id == house_id && event->maker_remaining == 0) ||
+      (event->order_id == house_id && event->remaining == 0))
+    house_id = 0;
+}
+
+// Replace the house quote with one facing an incoming order of the given side
+static void quote_house(uint8_t incoming_side, int64_t print)
+{
+  if (house_id)
+    orderbook_cancel(&book, house_id);
+
+  house_id = next_house_id++;
+  orderbook_side_t side = incoming_side == ORDERBOOK_BUY ? ORDERBOOK_SELL : ORDERBOOK_BUY;
+  if (orderbook_add(&book, house_id, side, ORDERBOOK_LIMIT, print, HOUSE_QTY) != ORDERBOOK_OK)
+    house_id = 0;
+}
+
+// Order: [0] side, [1] print, [3] limit price, [7] qty
+static int32_t on_order(const uint8_t *order)
+{
+  if (!book_ready)
+  {
+    if (orderbook_init(&book, order[1], BOOK_CAPACITY, on_book_event, NULL) != ORDERBOOK_OK)
+      return ORDERBOOK_ERR_POOL_FULL;
+    book_ready = 1;
+  }
+
+  quote_house(order[0], order[1]);
+  return orderbook_add(&book, next_order_id++, (orderbook_side_t)order[0],
+                       ORDERBOOK_LIMIT, order[3], order[7]);
+}
+
+static void on_message(void *state, const void *msg, size_t msg_len)
+{
+  (void)state;
+  last_status = msg_len < 8 ? ORDERBOOK_ERR_INVALID : on_order((const uint8_t *)msg);
+}
+
+// Strategy orders arrive as calls; the reply carries the orderbook status
+static void on_call(void *state, const void *msg, size_t msg_len, bitactor_message_t *reply)
+{
+  on_message(state, msg, msg_len);
+  reply->payload = &last_status;
+  reply->payload_len = sizeof(last_status);
 }
 
-BITACTOR_BEHAVIOR(orderbook, match_order)
\ No newline at end of file
+BITACTOR_BEHAVIOR(orderbook, on_message, on_call)
@@ -1,12 +1,15 @@
 #include "cns/bitactor.h"
 #include <stdint.h>
 
+static bitactor_peer_t orderbook = BITACTOR_PEER("orderbook");
+
 // Simple risk check: always approve
-void check_order(void *state, const void *msg, size_t msg_len)
+static void check_order(void *state, const void *msg, size_t msg_len)
 {
+  (void)state;
   // In production, check position, exposure, etc.
   // For now, always approve and forward to orderbook
-  bitactor_pid_t ob_pid = registry_lookup("orderbook");
+  bitactor_pid_t ob_pid = bitactor_peer_pid(&orderbook);
   bitactor_message_t order_msg = {.type = BITACTOR_CALL, .payload = msg, .payload_len = msg_len};
   bitactor_message_t ob_reply;
   bitactor_call(NULL, ob_pid, &order_msg, &ob_reply);
@@ -1,12 +1,14 @@
 #include "cns/bitactor.h"
 #include <stdint.h>
 
+static bitactor_peer_t orderbook = BITACTOR_PEER("orderbook");
+
 // Simple mean-reversion strategy: if price > 100, sell; else buy
-void on_tick(void *state, const void *msg, size_t msg_len)
+static void on_tick(const uint8_t *tick)
 {
-  const uint8_t *tick = (const uint8_t *)msg;
   uint8_t price = tick[0];
   uint8_t order[8] = {0};
+  order[1] = price; // Print the order reacts to
   if (price > 100)
   {
     order[0] = 0x02; // sell
@@ -19,15 +21,27 @@ void on_tick(void *state, const void *msg, size_t msg_len)
     order[3] = price;
     order[7] = 10; // qty
   }
-  bitactor_pid_t ob_pid = registry_lookup("orderbook");
+  bitactor_pid_t ob_pid = bitactor_peer_pid(&orderbook);
   bitactor_message_t order_msg = {.type = BITACTOR_CALL, .payload = order, .payload_len = 8};
   bitactor_message_t ob_reply;
   bitactor_call(NULL, ob_pid, &order_msg, &ob_reply);
 }
 
-void on_orderbook(void *state, const void *msg, size_t msg_len)
+static void on_orderbook(const uint8_t *fill)
 {
   // Handle fills, update state, etc. (omitted for brevity)
+  (void)fill;
+}
+
+// Ticks and fills share the mailbox; the sender tells them apart
+static void on_message(void *state, const void *msg, size_t msg_len)
+{
+  (void)state;
+  (void)msg_len;
+  if (bitactor_sender() == bitactor_peer_pid(&orderbook))
+    on_orderbook((const uint8_t *)msg);
+  else
+    on_tick((const uint8_t *)msg);
 }
 
-BITACTOR_BEHAVIOR(strategy, on_tick, on_orderbook)
\ No newline at end of file
+BITACTOR_BEHAVIOR(strategy, on_message)
@@ -0,0 +1,481 @@
+/**
+ * @file orderbook.c
+ * @brief Price-time priority matching over a modular price-level window
+ *
+ * Add, cancel and the per-fill step of matching are O(1): an id lookup, a
+ * pool slot and a doubly linked FIFO splice. Finding the next best price
+ * after a level empties scans the side's level bitmap a word at a time.
+ */
+
+#include "orderbook.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ORDERBOOK_LIKELY(x) __builtin_expect(!!(x), 1)
+#define ORDERBOOK_UNLIKELY(x) __builtin_expect(!!(x), 0)
+
+// =============================================================================
+// ORDER-ID TABLE (linear probing, backward-shift delete)
+// =============================================================================
+
+static inline uint32_t orderbook_id_hash(const orderbook_t* book, uint64_t id) {
+    return (uint32_t)((id * 0x9E3779B97F4A7C15ULL) >> 32) & book->id_mask;
+}
+
+static inline uint32_t orderbook_id_find(const orderbook_t* book, uint64_t id) {
+    uint32_t pos = orderbook_id_hash(book, id);
+    for (;;) {
+        uint64_t key = book->id_keys[pos];
+        if (key == id) return book->id_slots[pos];
+        if (key == 0) return ORDERBOOK_NIL;
+        pos = (pos + 1) & book->id_mask;
+    }
+}
+
+static inline int orderbook_id_insert(orderbook_t* book, uint64_t id, uint32_t slot) {
+    uint32_t pos = orderbook_id_hash(book, id);
+    for (;;) {
+        uint64_t key = book->id_keys[pos];
+        if (key == id) return ORDERBOOK_ERR_DUPLICATE_ID;
+        if (key == 0) break;
+        pos = (pos + 1) & book->id_mask;
+    }
+    book->id_keys[pos] = id;
+    book->id_slots[pos] = slot;
+    return ORDERBOOK_OK;
+}
+
+static inline void orderbook_id_erase(orderbook_t* book, uint64_t id) {
+    uint32_t pos = orderbook_id_hash(book, id);
+    while (book->id_keys[pos] != id) {
+        if (book->id_keys[pos] == 0) return;
+        pos = (pos + 1) & book->id_mask;
+    }
+
+    // Shift later members of the probe run back so lookups never need tombstones
+    uint32_t hole = pos;
+    uint32_t next = (pos + 1) & book->id_mask;
+    while (book->id_keys[next] != 0) {
+        uint32_t home = orderbook_id_hash(book, book->id_keys[next]);
+        if (((next - home) & book->id_mask) >= ((next - hole) & book->id_mask)) {
+            book->id_keys[hole] = book->id_keys[next];
+            book->id_slots[hole] = book->id_slots[next];
+            hole = next;
+        }
+        next = (next + 1) & book->id_mask;
+    }
+    book->id_keys[hole] = 0;
+}
+
+// =============================================================================
+// LEVEL BITMAPS
+// =============================================================================
+
+static inline uint32_t orderbook_index(int64_t price) {
+    return (uint32_t)((uint64_t)price & ORDERBOOK_LEVEL_MASK);
+}
+
+static inline void orderbook_bit_set(uint64_t* bits, int64_t price) {
+    uint32_t idx = orderbook_index(price);
+    bits[idx >> 6] |= 1ULL << (idx & 63);
+}
+
+static inline void orderbook_bit_clear(uint64_t* bits, int64_t price) {
+    uint32_t idx = orderbook_index(price);
+    bits[idx >> 6] &= ~(1ULL << (idx & 63));
+}
+
+// Lowest set price in [from, last], or ORDERBOOK_NO_ASK
+static int64_t orderbook_scan_up(const uint64_t* bits, int64_t from, int64_t last) {
+    while (from <= last) {
+        uint32_t idx = orderbook_index(from);
+        uint32_t bit = idx & 63;
+        uint64_t word = bits[idx >> 6] >> bit;
+        int64_t span = 64 - bit;
+        if (last - from + 1 < span) {
+            span = last - from + 1;
+            word &= (1ULL << span) - 1;
+        }
+        if (word) return from + __builtin_ctzll(word);
+        from += span;
+    }
+    return ORDERBOOK_NO_ASK;
+}
+
+// Highest set price in [first, from], or ORDERBOOK_NO_BID
+static int64_t orderbook_scan_down(const uint64_t* bits, int64_t from, int64_t first) {
+    while (from >= first) {
+        uint32_t idx = orderbook_index(from);
+        uint32_t bit = idx & 63;
+        uint64_t word = bits[idx >> 6] << (63 - bit);
+        int64_t span = bit + 1;
+        if (from - first + 1 < span) {
+            span = from - first + 1;
+            word &= ~0ULL << (64 - span);
+        }
+        if (word) return from - __builtin_clzll(word);
+        from -= span;
+    }
+    return ORDERBOOK_NO_BID;
+}
+
+// Move the window so price fits, centred on the span of price and every
+// resting order; fails only if that span is wider than the window
+static int orderbook_recenter(orderbook_t* book, int64_t price) {
+    int64_t old_last = book->base + ORDERBOOK_LEVELS - 1;
+    int64_t low = price, high = price;
+
+    if (book->best_bid != ORDERBOOK_NO_BID) {
+        int64_t lowest_bid = orderbook_scan_up(book->bid_bits, book->base, book->best_bid);
+        if (lowest_bid < low) low = lowest_bid;
+        if (book->best_bid > high) high = book->best_bid;
+    }
+    if (book->best_ask != ORDERBOOK_NO_ASK) {
+        int64_t highest_ask = orderbook_scan_down(book->ask_bits, old_last, book->best_ask);
+        if (book->best_ask < low) low = book->best_ask;
+        if (highest_ask > high) high = highest_ask;
+    }
+    if (high - low >= ORDERBOOK_LEVELS) return ORDERBOOK_ERR_PRICE_RANGE;
+
+    // Slots leaving the window are empty and become the entering prices
+    book->base = low - (ORDERBOOK_LEVELS - 1 - (high - low)) / 2;
+    book->stats.recenters++;
+    return ORDERBOOK_OK;
+}
+
+static inline int orderbook_in_window(const orderbook_t* book, int64_t price) {
+    return price >= book->base && price < book->base + ORDERBOOK_LEVELS;
+}
+
+// =============================================================================
+// ORDER POOL AND LEVEL FIFO
+// =============================================================================
+
+static inline void orderbook_emit(orderbook_t* book, const orderbook_event_t* event) {
+    if (book->on_event) book->on_event(event, book->user);
+}
+
+static inline void orderbook_level_push(orderbook_t* book, orderbook_order_t* order, uint32_t slot) {
+    orderbook_level_t* level = &book->levels[orderbook_index(order->price)];
+    order->next = ORDERBOOK_NIL;
+    order->prev = level->tail;
+    if (level->tail != ORDERBOOK_NIL) {
+        book->orders[level->tail].next = slot;
+    } else {
+        level->head = slot;
+        orderbook_bit_set(order->side == ORDERBOOK_BUY ? book->bid_bits : book->ask_bits, order->price);
+    }
+    level->tail = slot;
+    level->count++;
+    level->total_qty += order->qty;
+
+    if (order->side == ORDERBOOK_BUY) {
+        if (order->price > book->best_bid) book->best_bid = order->price;
+    } else if (order->price < book->best_ask) {
+        book->best_ask = order->price;
+    }
+}
+
+static inline void orderbook_level_unlink(orderbook_t* book, orderbook_order_t* order) {
+    orderbook_level_t* level = &book->levels[orderbook_index(order->price)];
+    if (order->prev != ORDERBOOK_NIL) book->orders[order->prev].next = order->next;
+    else level->head = order->next;
+    if (order->next != ORDERBOOK_NIL) book->orders[order->next].prev = order->prev;
+    else level->tail = order->prev;
+    level->count--;
+    level->total_qty -= order->qty;
+
+    if (level->count > 0) return;
+
+    level->head = level->tail = ORDERBOOK_NIL;
+    if (order->side == ORDERBOOK_BUY) {
+        orderbook_bit_clear(book->bid_bits, order->price);
+        if (order->price == book->best_bid) {
+            book->best_bid = orderbook_scan_down(book->bid_bits, order->price - 1, book->base);
+        }
+    } else {
+        orderbook_bit_clear(book->ask_bits, order->price);
+        if (order->price == book->best_ask) {
+            book->best_ask = orderbook_scan_up(book->ask_bits, order->price + 1,
+                                               book->base + ORDERBOOK_LEVELS - 1);
+        }
+    }
+}
+
+static inline void orderbook_free(orderbook_t* book, uint32_t slot) {
+    orderbook_id_erase(book, book->orders[slot].id);
+    book->orders[slot].next = book->free_head;
+    book->free_head = slot;
+}
+
+// =============================================================================
+// MATCHING
+// =============================================================================
+
+// Take liquidity from the opposite side up to limit; returns quantity left
+static uint32_t orderbook_match(orderbook_t* book, uint64_t id, uint8_t side,
+                                int64_t limit, uint32_t qty) {
+    const int buy = side == ORDERBOOK_BUY;
+
+    while (qty > 0) {
+        int64_t best = buy ? book->best_ask : book->best_bid;
+        if (buy ? (best == ORDERBOOK_NO_ASK || best > limit)
+                : (best == ORDERBOOK_NO_BID || best < limit)) {
+            break;
+        }
+
+        orderbook_level_t* level = &book->levels[orderbook_index(best)];
+        uint32_t slot = level->head;
+        orderbook_order_t* maker = &book->orders[slot];
+        uint32_t fill = maker->qty < qty ? maker->qty : qty;
+
+        qty -= fill;
+        maker->qty -= fill;
+        level->total_qty -= fill;
+        book->stats.trades++;
+        book->stats.volume += fill;
+
+        orderbook_event_t event = {
+            .type = ORDERBOOK_EVENT_TRADE, .side = side, .qty = fill,
+            .remaining = qty, .maker_remaining = maker->qty,
+            .order_id = id, .maker_id = maker->id, .price = maker->price};
+        orderbook_emit(book, &event);
+
+        if (maker->qty == 0) {
+            orderbook_level_unlink(book, maker);
+            orderbook_free(book, slot);
+        }
+    }
+    return qty;
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+int orderbook_init(orderbook_t* book, int64_t mid_price, uint32_t capacity,
+                   orderbook_event_fn on_event, void* user) {
+    if (!book || capacity == 0 || capacity >= ORDERBOOK_NIL) return ORDERBOOK_ERR_INVALID;
+    memset(book, 0, sizeof(*book));
+
+    uint32_t table = 16;
+    while (table < capacity * 2) table <<= 1;
+
+    book->orders = aligned_alloc(64, ((size_t)capacity * sizeof(orderbook_order_t) + 63) & ~(size_t)63);
+    book->id_keys = calloc(table, sizeof(uint64_t));
+    book->id_slots = malloc((size_t)table * sizeof(uint32_t));
+    if (!book->orders || !book->id_keys || !book->id_slots) {
+        orderbook_destroy(book);
+        return ORDERBOOK_ERR_POOL_FULL;
+    }
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        book->orders[i].next = i + 1 < capacity ? i + 1 : ORDERBOOK_NIL;
+    }
+    for (uint32_t i = 0; i < ORDERBOOK_LEVELS; i++) {
+        book->levels[i].head = book->levels[i].tail = ORDERBOOK_NIL;
+    }
+
+    book->capacity = capacity;
+    book->free_head = 0;
+    book->id_mask = table - 1;
+    book->base = mid_price - ORDERBOOK_LEVELS / 2;
+    book->best_bid = ORDERBOOK_NO_BID;
+    book->best_ask = ORDERBOOK_NO_ASK;
+    book->on_event = on_event;
+    book->user = user;
+    return ORDERBOOK_OK;
+}
+
+void orderbook_destroy(orderbook_t* book) {
+    if (!book) return;
+    free(book->orders);
+    free(book->id_keys);
+    free(book->id_slots);
+    book->orders = NULL;
+    book->id_keys = NULL;
+    book->id_slots = NULL;
+}
+
+static int orderbook_reject(orderbook_t* book, uint64_t id, uint8_t side, int64_t price,
+                            uint32_t qty, int status) {
+    orderbook_event_t event = {
+        .type = ORDERBOOK_EVENT_REJECTED, .side = side, .status = (int16_t)status,
+        .qty = qty, .order_id = id, .price = price};
+    orderbook_emit(book, &event);
+    return status;
+}
+
+// The remainder of a partly filled order cannot rest: its fills stand, so
+// report the rest as canceled with the reason rather than rejecting the order
+static int orderbook_drop_remainder(orderbook_t* book, uint64_t id, uint8_t side, int64_t price,
+                                    uint32_t qty, uint32_t remaining, int status) {
+    if (remaining == qty) return orderbook_reject(book, id, side, price, remaining, status);
+
+    orderbook_event_t event = {
+        .type = ORDERBOOK_EVENT_CANCELED, .side = side, .status = (int16_t)status,
+        .qty = remaining, .order_id = id, .price = price};
+    orderbook_emit(book, &event);
+    return status;
+}
+
+int orderbook_add(orderbook_t* book, uint64_t id, orderbook_side_t side,
+                  orderbook_type_t type, int64_t price, uint32_t qty) {
+    if (ORDERBOOK_UNLIKELY(id == 0 || qty == 0 ||
+                           (side != ORDERBOOK_BUY && side != ORDERBOOK_SELL))) {
+        return orderbook_reject(book, id, (uint8_t)side, price, qty, ORDERBOOK_ERR_INVALID);
+    }
+    if (ORDERBOOK_UNLIKELY(orderbook_id_find(book, id) != ORDERBOOK_NIL)) {
+        return orderbook_reject(book, id, (uint8_t)side, price, qty, ORDERBOOK_ERR_DUPLICATE_ID);
+    }
+
+    const int buy = side == ORDERBOOK_BUY;
+    if (type == ORDERBOOK_MARKET) {
+        price = buy ? ORDERBOOK_NO_ASK : ORDERBOOK_NO_BID;
+    }
+
+    int crosses = buy ? price >= book->best_ask : price <= book->best_bid;
+    if (type == ORDERBOOK_POST_ONLY && crosses) {
+        return orderbook_reject(book, id, (uint8_t)side, price, qty, ORDERBOOK_ERR_WOULD_CROSS);
+    }
+
+    uint32_t remaining = crosses ? orderbook_match(book, id, (uint8_t)side, price, qty) : qty;
+    book->stats.orders_added++;
+
+    if (remaining == 0) return ORDERBOOK_OK;
+
+    if (type == ORDERBOOK_MARKET || type == ORDERBOOK_IOC) {
+        orderbook_event_t event = {
+            .type = ORDERBOOK_EVENT_CANCELED, .side = (uint8_t)side, .qty = remaining,
+            .order_id = id, .price = price};
+        orderbook_emit(book, &event);
+        return ORDERBOOK_OK;
+    }
+
+    if (ORDERBOOK_UNLIKELY(!orderbook_in_window(book, price)) &&
+        orderbook_recenter(book, price) != ORDERBOOK_OK) {
+        return orderbook_drop_remainder(book, id, (uint8_t)side, price, qty, remaining,
+                                        ORDERBOOK_ERR_PRICE_RANGE);
+    }
+    if (ORDERBOOK_UNLIKELY(book->free_head == ORDERBOOK_NIL)) {
+        return orderbook_drop_remainder(book, id, (uint8_t)side, price, qty, remaining,
+                                        ORDERBOOK_ERR_POOL_FULL);
+    }
+
+    uint32_t slot = book->free_head;
+    orderbook_order_t* order = &book->orders[slot];
+    book->free_head = order->next;
+
+    order->id = id;
+    order->price = price;
+    order->qty = remaining;
+    order->side = (uint8_t)side;
+    orderbook_id_insert(book, id, slot);
+    orderbook_level_push(book, order, slot);
+
+    orderbook_event_t event = {
+        .type = ORDERBOOK_EVENT_ACCEPTED, .side = (uint8_t)side, .qty = remaining,
+        .remaining = remaining, .order_id = id, .price = price};
+    orderbook_emit(book, &event);
+    return ORDERBOOK_OK;
+}
+
+int orderbook_cancel(orderbook_t* book, uint64_t id) {
+    uint32_t slot = orderbook_id_find(book, id);
+    if (ORDERBOOK_UNLIKELY(slot == ORDERBOOK_NIL)) return ORDERBOOK_ERR_UNKNOWN_ID;
+
+    orderbook_order_t* order = &book->orders[slot];
+    orderbook_event_t event = {
+        .type = ORDERBOOK_EVENT_CANCELED, .side = order->side, .qty = order->qty,
+        .order_id = id, .price = order->price};
+
+    orderbook_level_unlink(book, order);
+    orderbook_free(book, slot);
+    book->stats.orders_canceled++;
+    orderbook_emit(book, &event);
+    return ORDERBOOK_OK;
+}
+
+// Partial cancel keeps queue position
+int orderbook_reduce(orderbook_t* book, uint64_t id, uint32_t qty) {
+    if (ORDERBOOK_UNLIKELY(qty == 0)) return ORDERBOOK_ERR_INVALID;
+    uint32_t slot = orderbook_id_find(book, id);
+    if (ORDERBOOK_UNLIKELY(slot == ORDERBOOK_NIL)) return ORDERBOOK_ERR_UNKNOWN_ID;
+
+    orderbook_order_t* order = &book->orders[slot];
+    if (qty >= order->qty) return orderbook_cancel(book, id);
+
+    order->qty -= qty;
+    book->levels[orderbook_index(order->price)].total_qty -= qty;
+
+    orderbook_event_t event = {
+        .type = ORDERBOOK_EVENT_CANCELED, .side = order->side, .qty = qty,
+        .remaining = order->qty, .order_id = id, .price = order->price};
+    orderbook_emit(book, &event);
+    return ORDERBOOK_OK;
+}
+
+// Fill a resting order from outside the book (exchange-reported execution)
+int orderbook_execute(orderbook_t* book, uint64_t id, uint32_t qty) {
+    if (ORDERBOOK_UNLIKELY(qty == 0)) return ORDERBOOK_ERR_INVALID;
+    uint32_t slot = orderbook_id_find(book, id);
+    if (ORDERBOOK_UNLIKELY(slot == ORDERBOOK_NIL)) return ORDERBOOK_ERR_UNKNOWN_ID;
+
+    orderbook_order_t* order = &book->orders[slot];
+    uint32_t fill = qty < order->qty ? qty : order->qty;
+    order->qty -= fill;
+    book->levels[orderbook_index(order->price)].total_qty -= fill;
+    book->stats.trades++;
+    book->stats.volume += fill;
+
+    orderbook_event_t event = {
+        .type = ORDERBOOK_EVENT_TRADE,
+        .side = order->side == ORDERBOOK_BUY ? ORDERBOOK_SELL : ORDERBOOK_BUY,
+        .qty = fill, .maker_remaining = order->qty,
+        .maker_id = id, .price = order->price};
+    orderbook_emit(book, &event);
+
+    if (order->qty == 0) {
+        orderbook_level_unlink(book, order);
+        orderbook_free(book, slot);
+    }
+    return ORDERBOOK_OK;
+}
+
+// Cancel/replace: the new order loses time priority
+int orderbook_replace(orderbook_t* book, uint64_t id, uint64_t new_id,
+                      int64_t price, uint32_t qty) {
+    if (ORDERBOOK_UNLIKELY(new_id == 0 || qty == 0)) return ORDERBOOK_ERR_INVALID;
+    uint32_t slot = orderbook_id_find(book, id);
+    if (ORDERBOOK_UNLIKELY(slot == ORDERBOOK_NIL)) return ORDERBOOK_ERR_UNKNOWN_ID;
+
+    orderbook_side_t side = (orderbook_side_t)book->orders[slot].side;
+    orderbook_cancel(book, id);
+    return orderbook_add(book, new_id, side, ORDERBOOK_LIMIT, price, qty);
+}
+
+int orderbook_apply(orderbook_t* book, const orderbook_msg_t* msg) {
+    switch (msg->type) {
+    case 'A':
+        return orderbook_add(book, msg->order_id, (orderbook_side_t)msg->side,
+                             ORDERBOOK_LIMIT, msg->price, msg->qty);
+    case 'X':
+        return orderbook_reduce(book, msg->order_id, msg->qty);
+    case 'D':
+        return orderbook_cancel(book, msg->order_id);
+    case 'E':
+        return orderbook_execute(book, msg->order_id, msg->qty);
+    case 'U':
+        return orderbook_replace(book, msg->order_id, msg->new_order_id, msg->price, msg->qty);
+    case 'P':
+        return orderbook_add(book, msg->order_id, (orderbook_side_t)msg->side,
+                             ORDERBOOK_IOC, msg->price, msg->qty);
+    default:
+        return ORDERBOOK_ERR_INVALID;
+    }
+}
+
+uint64_t orderbook_depth(const orderbook_t* book, int64_t price) {
+    if (!orderbook_in_window(book, price)) return 0;
+    return book->levels[orderbook_index(price)].total_qty;
+}
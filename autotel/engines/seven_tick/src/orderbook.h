@@ -0,0 +1,171 @@
+/**
+ * @file orderbook.h
+ * @brief Price-time priority limit order book for the BitActor backtest
+ *
+ * Price levels live in a fixed window of ORDERBOOK_LEVELS ticks indexed by
+ * price modulo the window, so recentring around a moving mid never moves
+ * data. Each level is an intrusive FIFO list threaded through a preallocated
+ * order pool; an open-addressed id table gives O(1) cancel.
+ */
+
+#ifndef ORDERBOOK_H
+#define ORDERBOOK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ORDERBOOK_LEVELS 4096 // Price window in ticks (power of two)
+#define ORDERBOOK_LEVEL_MASK (ORDERBOOK_LEVELS - 1)
+#define ORDERBOOK_NIL 0xFFFFFFFFu
+
+#define ORDERBOOK_NO_BID INT64_MIN
+#define ORDERBOOK_NO_ASK INT64_MAX
+
+typedef enum {
+    ORDERBOOK_BUY = 1, // Wire values used by the strategy actor
+    ORDERBOOK_SELL = 2
+} orderbook_side_t;
+
+typedef enum {
+    ORDERBOOK_LIMIT = 0, // Match, then rest the remainder
+    ORDERBOOK_MARKET,    // Match at any price, cancel the remainder
+    ORDERBOOK_IOC,       // Match up to the limit, cancel the remainder
+    ORDERBOOK_POST_ONLY  // Rest only; rejected if it would take liquidity
+} orderbook_type_t;
+
+typedef enum {
+    ORDERBOOK_OK = 0,
+    ORDERBOOK_ERR_INVALID = -1,
+    ORDERBOOK_ERR_DUPLICATE_ID = -2,
+    ORDERBOOK_ERR_UNKNOWN_ID = -3,
+    ORDERBOOK_ERR_POOL_FULL = -4,
+    ORDERBOOK_ERR_PRICE_RANGE = -5,
+    ORDERBOOK_ERR_WOULD_CROSS = -6
+} orderbook_status_t;
+
+typedef enum {
+    ORDERBOOK_EVENT_ACCEPTED = 0, // Order rests on the book
+    ORDERBOOK_EVENT_TRADE,        // One maker/taker fill
+    ORDERBOOK_EVENT_CANCELED,     // Removed with quantity left (status: why, if forced)
+    ORDERBOOK_EVENT_REJECTED
+} orderbook_event_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint8_t side;       // Side of order_id (the taker for trades)
+    int16_t status;     // Reject reason, or why a partly filled remainder was dropped
+    uint32_t qty;       // Traded, canceled or resting quantity
+    uint32_t remaining; // Left on order_id after this event
+    uint32_t maker_remaining;
+    uint64_t order_id;
+    uint64_t maker_id;  // Trades only
+    int64_t price;
+} orderbook_event_t;
+
+typedef void (*orderbook_event_fn)(const orderbook_event_t* event, void* user);
+
+typedef struct {
+    uint64_t id;
+    int64_t price;
+    uint32_t qty;
+    uint32_t prev;
+    uint32_t next; // Level FIFO, or free list link
+    uint8_t side;
+} orderbook_order_t;
+
+typedef struct {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t count;
+    uint64_t total_qty;
+} orderbook_level_t;
+
+typedef struct {
+    uint64_t orders_added;
+    uint64_t orders_canceled;
+    uint64_t trades;
+    uint64_t volume;
+    uint64_t recenters;
+} orderbook_stats_t;
+
+typedef struct {
+    orderbook_level_t levels[ORDERBOOK_LEVELS];
+    uint64_t bid_bits[ORDERBOOK_LEVELS / 64]; // Non-empty levels, by price & mask
+    uint64_t ask_bits[ORDERBOOK_LEVELS / 64];
+    int64_t base; // Lowest price in the window
+    int64_t best_bid;
+    int64_t best_ask;
+
+    orderbook_order_t* orders;
+    uint32_t capacity;
+    uint32_t free_head;
+
+    uint64_t* id_keys; // 0 = empty slot, so order ids must be non-zero
+    uint32_t* id_slots;
+    uint32_t id_mask;
+
+    orderbook_event_fn on_event;
+    void* user;
+    orderbook_stats_t stats;
+} orderbook_t;
+
+/**
+ * @brief ITCH-like replay record (32 bytes)
+ *
+ * 'A' add limit, 'X' cancel qty, 'D' delete, 'E' execute resting order,
+ * 'U' replace (new_order_id, price, qty), 'P' aggressive IOC.
+ */
+typedef struct {
+    uint8_t type;
+    uint8_t side;
+    uint16_t reserved;
+    uint32_t qty;
+    uint64_t order_id;
+    int64_t price;
+    uint64_t new_order_id;
+} orderbook_msg_t;
+
+int orderbook_init(orderbook_t* book, int64_t mid_price, uint32_t capacity,
+                   orderbook_event_fn on_event, void* user);
+void orderbook_destroy(orderbook_t* book);
+
+/**
+ * @brief Match an order, then rest or cancel what is left
+ *
+ * Returns ORDERBOOK_ERR_PRICE_RANGE or ORDERBOOK_ERR_POOL_FULL if the
+ * remainder cannot rest. An order that traded first keeps its fills: the
+ * TRADE events stand and the remainder is reported as CANCELED with that
+ * status instead of REJECTED.
+ */
+int orderbook_add(orderbook_t* book, uint64_t id, orderbook_side_t side,
+                  orderbook_type_t type, int64_t price, uint32_t qty);
+int orderbook_cancel(orderbook_t* book, uint64_t id);
+int orderbook_reduce(orderbook_t* book, uint64_t id, uint32_t qty);
+int orderbook_execute(orderbook_t* book, uint64_t id, uint32_t qty);
+int orderbook_replace(orderbook_t* book, uint64_t id, uint64_t new_id,
+                      int64_t price, uint32_t qty);
+
+/**
+ * @brief Apply one replay record
+ */
+int orderbook_apply(orderbook_t* book, const orderbook_msg_t* msg);
+
+static inline int64_t orderbook_best_bid(const orderbook_t* book) {
+    return book->best_bid;
+}
+
+static inline int64_t orderbook_best_ask(const orderbook_t* book) {
+    return book->best_ask;
+}
+
+uint64_t orderbook_depth(const orderbook_t* book, int64_t price);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ORDERBOOK_H
@@ -0,0 +1,299 @@
+/**
+ * @file orderbook_bench.c
+ * @brief Replay ITCH-like message files through the order book
+ *
+ * Usage: orderbook_bench [messages.bin]
+ *        orderbook_bench --generate messages.bin [count]
+ *
+ * Without a file a synthetic session is generated in memory: a random-walk
+ * mid with adds around it, cancels, partial cancels, replaces, resting
+ * executions and aggressive IOC orders. The generator replays each message
+ * on a shadow book, so cancels, replaces and executions only name orders
+ * that are still resting and a clean session reports no errors.
+ */
+
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+#include "orderbook.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_MESSAGES 2000000
+#define BENCH_BOOK_CAPACITY (1u << 16)
+#define BENCH_LIVE_MAX (1u << 14) // Resting orders in a busy single-symbol book
+
+static inline uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    uint64_t val;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+#else
+    return (uint64_t)clock();
+#endif
+}
+
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t rng_state = 0x853c49e6748fea9bULL;
+
+static inline uint32_t bench_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 16);
+}
+
+// Orders resting on the generator's shadow book
+typedef struct {
+    uint64_t* ids;
+    uint8_t* sides;
+    uint32_t* index; // Order id -> position in ids + 1, 0 = not resting
+    uint32_t count;
+} bench_live_t;
+
+static void bench_live_add(bench_live_t* live, uint64_t id, uint8_t side) {
+    live->ids[live->count] = id;
+    live->sides[live->count] = side;
+    live->index[id] = ++live->count;
+}
+
+static void bench_live_remove(bench_live_t* live, uint64_t id) {
+    uint32_t pos = live->index[id];
+    if (!pos) return; // IOC remainder or rejected add: never rested
+    live->index[id] = 0;
+    uint64_t last = live->ids[--live->count];
+    if (pos - 1 != live->count) {
+        live->ids[pos - 1] = last;
+        live->sides[pos - 1] = live->sides[live->count];
+        live->index[last] = pos;
+    }
+}
+
+// Orders join when they rest and leave when filled or fully canceled
+static void bench_track_event(const orderbook_event_t* event, void* user) {
+    bench_live_t* live = user;
+    switch (event->type) {
+    case ORDERBOOK_EVENT_ACCEPTED:
+        bench_live_add(live, event->order_id, event->side);
+        break;
+    case ORDERBOOK_EVENT_TRADE:
+        if (event->maker_remaining == 0) bench_live_remove(live, event->maker_id);
+        break;
+    case ORDERBOOK_EVENT_CANCELED:
+        if (event->remaining == 0) bench_live_remove(live, event->order_id);
+        break;
+    default:
+        break;
+    }
+}
+
+// Synthetic session that keeps a realistic mix of live resting orders
+static orderbook_msg_t* bench_generate(size_t count) {
+    orderbook_msg_t* msgs = calloc(count, sizeof(orderbook_msg_t));
+    orderbook_t* shadow = malloc(sizeof(orderbook_t));
+    // Each message takes at most one new id, so ids stay below count + 2
+    bench_live_t live = {
+        .ids = malloc(BENCH_LIVE_MAX * sizeof(uint64_t)),
+        .sides = malloc(BENCH_LIVE_MAX),
+        .index = calloc(count + 2, sizeof(uint32_t))};
+    int64_t mid = 100000;
+    int ok = msgs && shadow && live.ids && live.sides && live.index &&
+             orderbook_init(shadow, mid, BENCH_BOOK_CAPACITY, bench_track_event, &live) == ORDERBOOK_OK;
+    if (!ok) {
+        free(msgs);
+        free(shadow);
+        free(live.ids);
+        free(live.sides);
+        free(live.index);
+        return NULL;
+    }
+
+    uint64_t next_id = 1;
+
+    for (size_t i = 0; i < count; i++) {
+        orderbook_msg_t* m = &msgs[i];
+        uint32_t roll = bench_rand() % 100;
+        if (bench_rand() % 64 == 0) mid += (int64_t)(bench_rand() % 3) - 1;
+
+        int add = live.count < 64 || roll < 45;
+        if (live.count >= BENCH_LIVE_MAX) {
+            add = 0;
+            roll = 60; // Book is deep enough: delete instead
+        }
+
+        if (add) {
+            m->type = 'A';
+            m->side = (bench_rand() & 1) ? ORDERBOOK_BUY : ORDERBOOK_SELL;
+            int64_t offset = 1 + (int64_t)(bench_rand() % 50);
+            m->price = m->side == ORDERBOOK_BUY ? mid - offset : mid + offset;
+            m->qty = 1 + bench_rand() % 500;
+            m->order_id = next_id++;
+        } else {
+            uint32_t pick = bench_rand() % live.count;
+            m->order_id = live.ids[pick];
+            if (roll < 75) {
+                m->type = 'D';
+            } else if (roll < 85) {
+                m->type = 'X';
+                m->qty = 1 + bench_rand() % 20;
+            } else if (roll < 92) {
+                m->type = 'U';
+                m->new_order_id = next_id++;
+                int64_t offset = 1 + (int64_t)(bench_rand() % 50);
+                m->price = live.sides[pick] == ORDERBOOK_BUY ? mid - offset : mid + offset;
+                m->qty = 1 + bench_rand() % 500;
+            } else if (roll < 96) {
+                m->type = 'E';
+                m->qty = 1 + bench_rand() % 50;
+            } else {
+                m->type = 'P';
+                m->side = (bench_rand() & 1) ? ORDERBOOK_BUY : ORDERBOOK_SELL;
+                m->price = m->side == ORDERBOOK_BUY ? mid + 5 : mid - 5;
+                m->qty = 1 + bench_rand() % 300;
+                m->order_id = next_id++;
+            }
+        }
+
+        orderbook_apply(shadow, m); // Updates live through the events
+    }
+
+    orderbook_destroy(shadow);
+    free(shadow);
+    free(live.ids);
+    free(live.sides);
+    free(live.index);
+    return msgs;
+}
+
+static orderbook_msg_t* bench_load(const char* path, size_t* count) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0 || size % (long)sizeof(orderbook_msg_t) != 0) {
+        fprintf(stderr, "%s: not a whole number of %zu-byte messages\n", path, sizeof(orderbook_msg_t));
+        fclose(file);
+        return NULL;
+    }
+
+    *count = (size_t)size / sizeof(orderbook_msg_t);
+    orderbook_msg_t* msgs = malloc((size_t)size);
+    if (!msgs || fread(msgs, sizeof(orderbook_msg_t), *count, file) != *count) {
+        free(msgs);
+        msgs = NULL;
+    }
+    fclose(file);
+    return msgs;
+}
+
+typedef struct {
+    uint64_t count;
+    uint64_t cycles;
+    uint64_t max_cycles;
+} bench_op_t;
+
+static uint64_t trade_events = 0;
+
+static void bench_on_event(const orderbook_event_t* event, void* user) {
+    (void)user;
+    if (event->type == ORDERBOOK_EVENT_TRADE) trade_events++;
+}
+
+int main(int argc, char** argv) {
+    size_t count = BENCH_DEFAULT_MESSAGES;
+    orderbook_msg_t* msgs;
+
+    if (argc >= 3 && strcmp(argv[1], "--generate") == 0) {
+        if (argc >= 4) count = (size_t)strtoull(argv[3], NULL, 10);
+        msgs = bench_generate(count);
+        FILE* out = msgs ? fopen(argv[2], "wb") : NULL;
+        if (!out || fwrite(msgs, sizeof(orderbook_msg_t), count, out) != count) {
+            perror(argv[2]);
+            return 1;
+        }
+        fclose(out);
+        printf("Wrote %zu messages to %s\n", count, argv[2]);
+        free(msgs);
+        return 0;
+    }
+
+    msgs = argc >= 2 ? bench_load(argv[1], &count) : bench_generate(count);
+    if (!msgs) return 1;
+
+    orderbook_t* book = malloc(sizeof(orderbook_t));
+    int64_t mid = msgs[0].price ? msgs[0].price : 100000;
+    if (!book || orderbook_init(book, mid, BENCH_BOOK_CAPACITY, bench_on_event, NULL) != ORDERBOOK_OK) {
+        fprintf(stderr, "orderbook_init failed\n");
+        return 1;
+    }
+
+    // Pass 1: throughput, no per-message timing
+    uint64_t start_ns = bench_now_ns();
+    for (size_t i = 0; i < count; i++) {
+        orderbook_apply(book, &msgs[i]);
+    }
+    uint64_t elapsed_ns = bench_now_ns() - start_ns;
+    orderbook_destroy(book);
+
+    // Pass 2: per-message cycles on a fresh book, timer overhead subtracted
+    uint64_t overhead = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t c0 = bench_cycles();
+        uint64_t c1 = bench_cycles();
+        if (c1 - c0 < overhead) overhead = c1 - c0;
+    }
+
+    trade_events = 0;
+    if (orderbook_init(book, mid, BENCH_BOOK_CAPACITY, bench_on_event, NULL) != ORDERBOOK_OK) {
+        fprintf(stderr, "orderbook_init failed\n");
+        return 1;
+    }
+    bench_op_t ops[256] = {{0}};
+    uint64_t errors = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t c0 = bench_cycles();
+        int rc = orderbook_apply(book, &msgs[i]);
+        uint64_t c1 = bench_cycles();
+        uint64_t cycles = c1 - c0 > overhead ? c1 - c0 - overhead : 0;
+
+        bench_op_t* op = &ops[msgs[i].type];
+        op->count++;
+        op->cycles += cycles;
+        if (cycles > op->max_cycles) op->max_cycles = cycles;
+        if (rc != ORDERBOOK_OK) errors++; // Generated sessions have none; files may
+    }
+
+    printf("Order book replay: %zu messages in %.3f ms (%.1f ns/msg)\n",
+           count, elapsed_ns / 1e6, (double)elapsed_ns / (double)count);
+    printf("  %-8s %10s %12s %12s   (timer overhead %llu cycles removed)\n",
+           "type", "count", "avg cycles", "max cycles", (unsigned long long)overhead);
+    const char* types = "AXDEUP";
+    for (const char* t = types; *t; t++) {
+        bench_op_t* op = &ops[(uint8_t)*t];
+        if (!op->count) continue;
+        printf("  %-8c %10llu %12.1f %12llu\n", *t, (unsigned long long)op->count,
+               (double)op->cycles / (double)op->count, (unsigned long long)op->max_cycles);
+    }
+    printf("  trades=%llu volume=%llu recenters=%llu errors=%llu\n",
+           (unsigned long long)trade_events, (unsigned long long)book->stats.volume,
+           (unsigned long long)book->stats.recenters, (unsigned long long)errors);
+    printf("  best bid=%lld ask=%lld\n", (long long)orderbook_best_bid(book),
+           (long long)orderbook_best_ask(book));
+
+    orderbook_destroy(book);
+    free(book);
+    free(msgs);
+    return 0;
+}
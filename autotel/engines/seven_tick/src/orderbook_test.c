@@ -0,0 +1,175 @@
+/**
+ * @file orderbook_test.c
+ * @brief Order book behaviour checks
+ *
+ * Usage: orderbook_test
+ *
+ * Covers price-time priority, window recentring around resting orders,
+ * zero-quantity requests and partly filled orders whose remainder cannot
+ * rest. Events are recorded and compared against the expected sequence.
+ */
+
+#include "orderbook.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_MAX_EVENTS 64
+
+static orderbook_event_t events[TEST_MAX_EVENTS];
+static int event_count;
+static int failures;
+
+static void record_event(const orderbook_event_t* event, void* user) {
+    (void)user;
+    if (event_count < TEST_MAX_EVENTS) events[event_count++] = *event;
+}
+
+#define CHECK(cond)                                                        \
+    do {                                                                   \
+        if (!(cond)) {                                                     \
+            printf("    FAILED %s:%d: %s\n", __FILE__, __LINE__, #cond);   \
+            failures++;                                                    \
+            return;                                                        \
+        }                                                                  \
+    } while (0)
+
+static void book_reset(orderbook_t* book, int64_t mid, uint32_t capacity) {
+    orderbook_destroy(book);
+    orderbook_init(book, mid, capacity, record_event, NULL);
+    event_count = 0;
+}
+
+// Same price fills in arrival order; better prices fill first
+static void test_price_time_priority(orderbook_t* book) {
+    book_reset(book, 1000, 64);
+    CHECK(orderbook_add(book, 1, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1001, 5) == ORDERBOOK_OK);
+    CHECK(orderbook_add(book, 2, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1001, 5) == ORDERBOOK_OK);
+    CHECK(orderbook_add(book, 3, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1000, 5) == ORDERBOOK_OK);
+    CHECK(orderbook_add(book, 4, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1001, 5) == ORDERBOOK_OK);
+    CHECK(orderbook_best_ask(book) == 1000);
+
+    event_count = 0;
+    CHECK(orderbook_add(book, 10, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 1001, 12) == ORDERBOOK_OK);
+    CHECK(event_count == 3);
+    CHECK(events[0].type == ORDERBOOK_EVENT_TRADE && events[0].maker_id == 3 &&
+          events[0].price == 1000 && events[0].qty == 5);
+    CHECK(events[1].maker_id == 1 && events[1].price == 1001 && events[1].qty == 5);
+    CHECK(events[2].maker_id == 2 && events[2].qty == 2 && events[2].maker_remaining == 3 &&
+          events[2].remaining == 0);
+
+    // Order 2 keeps its place after a partial cancel; order 4 is still behind it
+    CHECK(orderbook_reduce(book, 2, 1) == ORDERBOOK_OK);
+    event_count = 0;
+    CHECK(orderbook_add(book, 11, ORDERBOOK_BUY, ORDERBOOK_IOC, 1001, 3) == ORDERBOOK_OK);
+    CHECK(event_count == 2);
+    CHECK(events[0].maker_id == 2 && events[0].qty == 2 && events[0].maker_remaining == 0);
+    CHECK(events[1].maker_id == 4 && events[1].qty == 1);
+    CHECK(orderbook_depth(book, 1001) == 4);
+}
+
+// Reviewer's case: bid 1000 / ask 1001 with an order at 3100 must recentre
+static void test_recenter_covers_resting_orders(orderbook_t* book) {
+    book_reset(book, 1000, 64);
+    CHECK(orderbook_add(book, 1, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 1000, 1) == ORDERBOOK_OK);
+    CHECK(orderbook_add(book, 2, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1001, 1) == ORDERBOOK_OK);
+
+    CHECK(orderbook_add(book, 3, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 3100, 1) == ORDERBOOK_OK);
+    CHECK(book->stats.recenters == 1);
+    CHECK(book->base <= 1000 && book->base + ORDERBOOK_LEVELS - 1 >= 3100);
+    CHECK(orderbook_depth(book, 1000) == 1 && orderbook_depth(book, 1001) == 1 &&
+          orderbook_depth(book, 3100) == 1);
+
+    // Resting orders survive and the highest ask is still found after 1001 fills
+    CHECK(orderbook_add(book, 4, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 1001, 1) == ORDERBOOK_OK);
+    CHECK(orderbook_best_ask(book) == 3100);
+    CHECK(orderbook_best_bid(book) == 1000);
+
+    // Downward move that still fits: buy far below
+    CHECK(orderbook_add(book, 5, ORDERBOOK_BUY, ORDERBOOK_LIMIT, -900, 1) == ORDERBOOK_OK);
+    CHECK(book->base <= -900 && book->base + ORDERBOOK_LEVELS - 1 >= 3100);
+    CHECK(orderbook_depth(book, -900) == 1 && orderbook_depth(book, 3100) == 1);
+
+    // The span of resting orders plus price no longer fits the window
+    event_count = 0;
+    CHECK(orderbook_add(book, 6, ORDERBOOK_SELL, ORDERBOOK_LIMIT, -900 + ORDERBOOK_LEVELS, 1) ==
+          ORDERBOOK_ERR_PRICE_RANGE);
+    CHECK(event_count == 1 && events[0].type == ORDERBOOK_EVENT_REJECTED);
+    CHECK(orderbook_best_bid(book) == 1000 && orderbook_best_ask(book) == 3100);
+}
+
+static void test_zero_quantity(orderbook_t* book) {
+    book_reset(book, 1000, 64);
+    CHECK(orderbook_add(book, 1, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 999, 4) == ORDERBOOK_OK);
+
+    event_count = 0;
+    CHECK(orderbook_execute(book, 1, 0) == ORDERBOOK_ERR_INVALID);
+    CHECK(orderbook_reduce(book, 1, 0) == ORDERBOOK_ERR_INVALID);
+    CHECK(orderbook_replace(book, 1, 2, 999, 0) == ORDERBOOK_ERR_INVALID);
+    CHECK(orderbook_add(book, 3, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 999, 0) == ORDERBOOK_ERR_INVALID);
+    CHECK(event_count == 1 && events[0].type == ORDERBOOK_EVENT_REJECTED);
+    CHECK(book->stats.trades == 0 && orderbook_depth(book, 999) == 4);
+}
+
+// Pool exhaustion rejects an order that did not trade; a taker that traded
+// has freed every maker it consumed, so its remainder can rest
+static void test_pool_full(orderbook_t* book) {
+    book_reset(book, 1000, 2);
+    CHECK(orderbook_add(book, 1, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1001, 3) == ORDERBOOK_OK);
+    CHECK(orderbook_add(book, 2, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1005, 3) == ORDERBOOK_OK);
+
+    event_count = 0;
+    CHECK(orderbook_add(book, 3, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 990, 1) == ORDERBOOK_ERR_POOL_FULL);
+    CHECK(event_count == 1 && events[0].type == ORDERBOOK_EVENT_REJECTED &&
+          events[0].status == ORDERBOOK_ERR_POOL_FULL);
+
+    event_count = 0;
+    CHECK(orderbook_add(book, 4, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 1001, 5) == ORDERBOOK_OK);
+    CHECK(event_count == 2);
+    CHECK(events[0].type == ORDERBOOK_EVENT_TRADE && events[0].maker_id == 1 && events[0].qty == 3);
+    CHECK(events[1].type == ORDERBOOK_EVENT_ACCEPTED && events[1].qty == 2);
+}
+
+// A taker that trades and whose remainder then cannot rest keeps its fills:
+// the remainder is canceled with the reason, not the whole order rejected
+static void test_partial_fill_remainder_dropped(orderbook_t* book) {
+    book_reset(book, 1000, 64);
+    CHECK(orderbook_add(book, 1, ORDERBOOK_BUY, ORDERBOOK_LIMIT, -1000, 1) == ORDERBOOK_OK);
+    CHECK(orderbook_add(book, 2, ORDERBOOK_SELL, ORDERBOOK_LIMIT, 1001, 2) == ORDERBOOK_OK);
+
+    // Resting at 3100 would need a window spanning -1000..3100
+    event_count = 0;
+    CHECK(orderbook_add(book, 3, ORDERBOOK_BUY, ORDERBOOK_LIMIT, 3100, 5) == ORDERBOOK_ERR_PRICE_RANGE);
+    CHECK(event_count == 2);
+    CHECK(events[0].type == ORDERBOOK_EVENT_TRADE && events[0].maker_id == 2 &&
+          events[0].qty == 2 && events[0].remaining == 3);
+    CHECK(events[1].type == ORDERBOOK_EVENT_CANCELED && events[1].order_id == 3 &&
+          events[1].qty == 3 && events[1].status == ORDERBOOK_ERR_PRICE_RANGE);
+    CHECK(book->stats.trades == 1 && orderbook_best_ask(book) == ORDERBOOK_NO_ASK);
+    CHECK(orderbook_best_bid(book) == -1000);
+}
+
+int main(void) {
+    orderbook_t book;
+    memset(&book, 0, sizeof(book));
+
+    struct {
+        const char* name;
+        void (*fn)(orderbook_t*);
+    } tests[] = {
+        {"price-time priority", test_price_time_priority},
+        {"recentre around resting orders", test_recenter_covers_resting_orders},
+        {"zero quantity", test_zero_quantity},
+        {"pool full", test_pool_full},
+        {"partial fill, remainder dropped", test_partial_fill_remainder_dropped},
+    };
+
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        int before = failures;
+        tests[i].fn(&book);
+        printf("  %-34s %s\n", tests[i].name, failures == before ? "ok" : "FAILED");
+    }
+    orderbook_destroy(&book);
+
+    printf(failures ? "❌ %d order book check(s) failed\n" : "✅ Order book checks passed\n", failures);
+    return failures ? 1 : 0;
+}
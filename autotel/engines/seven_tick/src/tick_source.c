@@ -0,0 +1,358 @@
+/**
+ * @file tick_source.c
+ * @brief Memory-mapped tick replay with k-way timestamp merge
+ *
+ * One syscall-free pass over the mapped files: the kernel is told the
+ * access pattern up front (MADV_SEQUENTIAL), pages ahead of the cursor are
+ * requested with MADV_WILLNEED and pages behind the consumer are dropped
+ * with MADV_DONTNEED, so year-long replays keep a bounded resident set.
+ */
+
+#define _GNU_SOURCE // MADV_HUGEPAGE
+#include "tick_source.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define TICK_SPIN_NS 50000 // Busy-wait the last 50us before a due tick
+
+static inline uint64_t tick_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline size_t tick_page_size(void) {
+    static size_t page = 0;
+    if (!page) page = (size_t)sysconf(_SC_PAGESIZE);
+    return page;
+}
+
+static inline size_t tick_record_offset(uint64_t index) {
+    return sizeof(tick_file_header_t) + (size_t)index * sizeof(tick_record_t);
+}
+
+// =============================================================================
+// MAPPING
+// =============================================================================
+
+static int tick_file_map(tick_file_t* file, const char* path) {
+    memset(file, 0, sizeof(*file));
+    file->fd = open(path, O_RDONLY);
+    if (file->fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(file->fd, &st) != 0 || (size_t)st.st_size < sizeof(tick_file_header_t)) {
+        fprintf(stderr, "%s: too small for a tick file header\n", path);
+        goto fail;
+    }
+
+    file->length = (size_t)st.st_size;
+    void* base = mmap(NULL, file->length, PROT_READ, MAP_PRIVATE, file->fd, 0);
+    if (base == MAP_FAILED) {
+        perror(path);
+        goto fail;
+    }
+    file->base = base;
+
+    const tick_file_header_t* header = (const tick_file_header_t*)file->base;
+    if (header->magic != TICK_FILE_MAGIC || header->version != TICK_FILE_VERSION) {
+        fprintf(stderr, "%s: not a version %d tick file\n", path, TICK_FILE_VERSION);
+        goto fail;
+    }
+    if (header->record_size != sizeof(tick_record_t)) {
+        fprintf(stderr, "%s: record size %u, expected %zu\n", path,
+                header->record_size, sizeof(tick_record_t));
+        goto fail;
+    }
+    if (tick_record_offset(header->record_count) != file->length) {
+        fprintf(stderr, "%s: %llu records do not match file size %zu\n", path,
+                (unsigned long long)header->record_count, file->length);
+        goto fail;
+    }
+
+    file->records = (const tick_record_t*)(file->base + sizeof(tick_file_header_t));
+    file->count = header->record_count;
+    file->symbol_id = header->symbol_id;
+
+    madvise((void*)file->base, file->length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise((void*)file->base, file->length, MADV_HUGEPAGE); // Ignored where unsupported
+#endif
+    return 0;
+
+fail:
+    if (file->base) munmap((void*)file->base, file->length);
+    close(file->fd);
+    file->base = NULL;
+    file->fd = -1;
+    return -1;
+}
+
+static void tick_file_unmap(tick_file_t* file) {
+    if (file->base) munmap((void*)file->base, file->length);
+    if (file->fd >= 0) close(file->fd);
+    file->base = NULL;
+    file->fd = -1;
+}
+
+// Keep TICK_PREFETCH_BYTES of the file requested ahead of the cursor
+static inline void tick_file_prefetch(tick_file_t* file) {
+    const uint64_t window = TICK_PREFETCH_BYTES / sizeof(tick_record_t);
+    if (file->prefetched >= file->count || file->cursor + window / 2 < file->prefetched) return;
+
+    uint64_t end = file->prefetched + window;
+    if (end > file->count) end = file->count;
+
+    size_t page = tick_page_size();
+    size_t from = tick_record_offset(file->prefetched) & ~(page - 1);
+    madvise((void*)(file->base + from), tick_record_offset(end) - from, MADV_WILLNEED);
+    file->prefetched = end;
+}
+
+// Drop pages whose records have all been consumed
+static inline void tick_file_release(tick_file_t* file, uint64_t upto) {
+    size_t page = tick_page_size();
+    size_t from = tick_record_offset(file->released) & ~(page - 1);
+    size_t to = tick_record_offset(upto) & ~(page - 1);
+    if (to < from + TICK_PREFETCH_BYTES) return; // Batch up the madvise calls
+
+    madvise((void*)(file->base + from), to - from, MADV_DONTNEED);
+    file->released = upto;
+}
+
+// =============================================================================
+// K-WAY MERGE
+// =============================================================================
+
+static inline int tick_record_valid(const tick_file_t* file, const tick_record_t* record) {
+    return file->symbol_id == TICK_SYMBOL_ANY || record->symbol_id == file->symbol_id;
+}
+
+static inline int tick_heap_less(const tick_source_t* source, uint32_t a, uint32_t b) {
+    const tick_file_t* fa = &source->files[a];
+    const tick_file_t* fb = &source->files[b];
+    uint64_t ta = fa->records[fa->cursor].timestamp_ns;
+    uint64_t tb = fb->records[fb->cursor].timestamp_ns;
+    return ta < tb || (ta == tb && a < b); // File order breaks ties deterministically
+}
+
+static void tick_heap_sift_down(tick_source_t* source, uint32_t pos) {
+    uint32_t* heap = source->heap;
+    for (;;) {
+        uint32_t left = 2 * pos + 1;
+        if (left >= source->heap_size) return;
+        uint32_t child = left;
+        if (left + 1 < source->heap_size && tick_heap_less(source, heap[left + 1], heap[left])) {
+            child = left + 1;
+        }
+        if (!tick_heap_less(source, heap[child], heap[pos])) return;
+        uint32_t tmp = heap[pos];
+        heap[pos] = heap[child];
+        heap[child] = tmp;
+        pos = child;
+    }
+}
+
+// Pop the earliest record across files and advance its file
+static const tick_record_t* tick_source_pop(tick_source_t* source) {
+    while (source->heap_size > 0) {
+        tick_file_t* file = &source->files[source->heap[0]];
+        const tick_record_t* record = &file->records[file->cursor++];
+
+        if (file->cursor < file->count) {
+            tick_file_prefetch(file);
+            tick_heap_sift_down(source, 0);
+        } else {
+            source->heap[0] = source->heap[--source->heap_size];
+            tick_heap_sift_down(source, 0);
+        }
+
+        if (!tick_record_valid(file, record)) {
+            source->stats.schema_errors++;
+            continue;
+        }
+        if (record->timestamp_ns < file->last_timestamp) source->stats.out_of_order++;
+        file->last_timestamp = record->timestamp_ns;
+        return record;
+    }
+    return NULL;
+}
+
+static inline const tick_record_t* tick_source_peek(const tick_source_t* source) {
+    if (source->heap_size == 0) return NULL;
+    const tick_file_t* file = &source->files[source->heap[0]];
+    return &file->records[file->cursor];
+}
+
+// =============================================================================
+// REPLAY CLOCK
+// =============================================================================
+
+static inline uint64_t tick_due_ns(const tick_source_t* source, uint64_t timestamp) {
+    double offset = (double)(timestamp - source->first_timestamp);
+    if (source->config.mode == TICK_REPLAY_SCALED) offset /= source->config.speed;
+    return source->start_wall_ns + (uint64_t)offset;
+}
+
+static void tick_wait_until(tick_source_t* source, uint64_t due) {
+    uint64_t now = tick_now_ns();
+    if (now >= due) return;
+
+    source->stats.sleeps++;
+    if (due - now > TICK_SPIN_NS) {
+        uint64_t sleep_ns = due - now - TICK_SPIN_NS;
+        struct timespec ts = {(time_t)(sleep_ns / 1000000000ULL), (long)(sleep_ns % 1000000000ULL)};
+        nanosleep(&ts, NULL);
+    }
+    while (tick_now_ns() < due) {
+        // Spin out the remainder for sub-100us pacing accuracy
+    }
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+int tick_source_open(tick_source_t* source, const char* const* paths, uint32_t path_count,
+                     const tick_replay_config_t* config) {
+    if (!source || !paths || path_count == 0 || path_count > TICK_MAX_FILES) return -1;
+    memset(source, 0, sizeof(*source));
+
+    source->config.mode = config ? config->mode : TICK_REPLAY_FAST;
+    source->config.speed = config && config->speed > 0.0 ? config->speed : 1.0;
+    source->config.batch_size = config && config->batch_size ? config->batch_size : TICK_DEFAULT_BATCH;
+
+    for (uint32_t i = 0; i < path_count; i++) {
+        if (tick_file_map(&source->files[i], paths[i]) != 0) {
+            for (uint32_t j = 0; j < i; j++) tick_file_unmap(&source->files[j]);
+            return -1;
+        }
+        source->file_count++;
+    }
+
+    // Merging reorders records, so batches are copied out of the maps
+    if (source->file_count > 1) {
+        for (uint32_t s = 0; s < TICK_INFLIGHT_BATCHES; s++) {
+            source->staging[s] = aligned_alloc(64, (size_t)source->config.batch_size * sizeof(tick_record_t));
+            if (!source->staging[s]) {
+                tick_source_close(source);
+                return -1;
+            }
+        }
+    }
+    for (uint32_t s = 0; s < TICK_INFLIGHT_BATCHES; s++) {
+        source->consumed[s] = 1;
+    }
+
+    source->first_timestamp = UINT64_MAX;
+    for (uint32_t i = 0; i < source->file_count; i++) {
+        tick_file_t* file = &source->files[i];
+        if (file->count == 0) continue;
+        tick_file_prefetch(file);
+        source->heap[source->heap_size++] = i;
+        if (file->records[0].timestamp_ns < source->first_timestamp) {
+            source->first_timestamp = file->records[0].timestamp_ns;
+        }
+    }
+    for (uint32_t i = source->heap_size / 2; i-- > 0;) {
+        tick_heap_sift_down(source, i);
+    }
+    return 0;
+}
+
+uint32_t tick_source_next_batch(tick_source_t* source, tick_batch_t* batch) {
+    if (!source || !batch || source->heap_size == 0) return 0;
+
+    // Reuse the oldest slot once the actor is done with it
+    uint32_t slot = source->next_slot;
+    while (!__atomic_load_n(&source->consumed[slot], __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+
+    const int paced = source->config.mode != TICK_REPLAY_FAST;
+    if (paced && source->start_wall_ns == 0) source->start_wall_ns = tick_now_ns();
+
+    const tick_record_t* next = tick_source_peek(source);
+    if (paced) tick_wait_until(source, tick_due_ns(source, next->timestamp_ns));
+    uint64_t now = paced ? tick_now_ns() : 0;
+
+    uint32_t count = 0;
+    const uint32_t limit = source->config.batch_size;
+
+    if (source->file_count == 1) {
+        // Zero-copy: the batch is a contiguous run of the mapping
+        tick_file_t* file = &source->files[0];
+        tick_file_release(file, source->batch_end[slot]);
+
+        while (file->cursor < file->count && !tick_record_valid(file, &file->records[file->cursor])) {
+            source->stats.schema_errors++;
+            file->cursor++;
+        }
+
+        const tick_record_t* first = &file->records[file->cursor];
+        while (count < limit && file->cursor < file->count) {
+            const tick_record_t* record = &file->records[file->cursor];
+            if (!tick_record_valid(file, record)) break; // Skipped at the next batch
+            if (paced && count > 0 && tick_due_ns(source, record->timestamp_ns) > now) break;
+            if (record->timestamp_ns < file->last_timestamp) source->stats.out_of_order++;
+            file->last_timestamp = record->timestamp_ns;
+            file->cursor++;
+            count++;
+        }
+        tick_file_prefetch(file);
+        if (file->cursor >= file->count) source->heap_size = 0;
+
+        source->batch_end[slot] = file->cursor;
+        batch->ticks = first;
+    } else {
+        tick_record_t* staging = source->staging[slot];
+        while (count < limit && (next = tick_source_peek(source)) != NULL) {
+            if (paced && count > 0 && tick_due_ns(source, next->timestamp_ns) > now) break;
+            const tick_record_t* record = tick_source_pop(source);
+            if (!record) break;
+            staging[count++] = *record;
+        }
+        for (uint32_t i = 0; i < source->file_count; i++) {
+            tick_file_release(&source->files[i], source->files[i].cursor);
+        }
+        batch->ticks = staging;
+    }
+
+    if (count == 0) return 0;
+
+    source->consumed[slot] = 0;
+    source->next_slot = (slot + 1) % TICK_INFLIGHT_BATCHES;
+    source->stats.ticks += count;
+    source->stats.batches++;
+
+    batch->count = count;
+    batch->consumed = &source->consumed[slot];
+    return count;
+}
+
+void tick_source_close(tick_source_t* source) {
+    if (!source) return;
+
+    for (uint32_t s = 0; s < TICK_INFLIGHT_BATCHES; s++) {
+        while (!__atomic_load_n(&source->consumed[s], __ATOMIC_ACQUIRE)) {
+            sched_yield();
+        }
+        free(source->staging[s]);
+        source->staging[s] = NULL;
+    }
+    for (uint32_t i = 0; i < source->file_count; i++) {
+        tick_file_unmap(&source->files[i]);
+    }
+    source->file_count = 0;
+    source->heap_size = 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file tick_source.h
+ * @brief Memory-mapped tick replay for the BitActor backtest
+ *
+ * Tick files are mmap'd read-only and replayed in batches handed to the
+ * market-data actor by pointer. Several files (one per symbol, or any mix)
+ * are merged by timestamp through a k-way min-heap.
+ */
+
+#ifndef TICK_SOURCE_H
+#define TICK_SOURCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TICK_FILE_MAGIC 0x4B435442u // "BTCK"
+#define TICK_FILE_VERSION 1
+#define TICK_SYMBOL_ANY 0xFFFFFFFFu // Header symbol for multi-symbol files
+
+#define TICK_MAX_FILES 64
+#define TICK_DEFAULT_BATCH 4096
+#define TICK_INFLIGHT_BATCHES 4      // Batches the market-data actor may hold
+#define TICK_PREFETCH_BYTES (8u << 20) // MADV_WILLNEED window ahead of the cursor
+
+// On-disk header, followed by record_count tick_record_t
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t symbol_id;
+    uint32_t flags;
+    uint64_t record_count;
+} tick_file_header_t;
+
+typedef struct {
+    uint64_t timestamp_ns;
+    uint32_t symbol_id;
+    uint32_t sequence;
+    uint8_t data[8]; // Tick body as consumed by the strategy actor
+} tick_record_t;
+
+typedef enum {
+    TICK_REPLAY_FAST = 0,    // As fast as the actors drain
+    TICK_REPLAY_REALTIME,    // Wall clock follows tick timestamps
+    TICK_REPLAY_SCALED       // Real time multiplied by speed
+} tick_replay_mode_t;
+
+typedef struct {
+    tick_replay_mode_t mode;
+    double speed;        // TICK_REPLAY_SCALED only, > 0
+    uint32_t batch_size; // Ticks per batch, 0 = TICK_DEFAULT_BATCH
+} tick_replay_config_t;
+
+/**
+ * @brief Batch message for the market-data actor (fits an envelope)
+ *
+ * ticks stays valid until the actor stores 1 to *consumed.
+ */
+typedef struct {
+    const tick_record_t* ticks;
+    uint32_t count;
+    uint32_t* consumed;
+} tick_batch_t;
+
+typedef struct {
+    const uint8_t* base;
+    size_t length;
+    const tick_record_t* records;
+    uint64_t count;
+    uint64_t cursor;
+    uint64_t prefetched; // Records covered by MADV_WILLNEED
+    uint64_t released;   // Records dropped with MADV_DONTNEED
+    uint64_t last_timestamp;
+    uint32_t symbol_id;
+    int fd;
+} tick_file_t;
+
+typedef struct {
+    uint64_t ticks;
+    uint64_t batches;
+    uint64_t out_of_order;  // Timestamp went backwards within a file
+    uint64_t schema_errors; // Records skipped for a mismatched symbol
+    uint64_t sleeps;        // Clock waits in real-time/scaled modes
+} tick_source_stats_t;
+
+typedef struct {
+    tick_file_t files[TICK_MAX_FILES];
+    uint32_t file_count;
+    uint32_t heap[TICK_MAX_FILES]; // Min-heap of file indices by next timestamp
+    uint32_t heap_size;
+
+    tick_replay_config_t config;
+    uint64_t first_timestamp;
+    uint64_t start_wall_ns;
+
+    // Merge mode copies into staging; single-file mode points into the map
+    tick_record_t* staging[TICK_INFLIGHT_BATCHES];
+    uint32_t consumed[TICK_INFLIGHT_BATCHES];
+    uint64_t batch_end[TICK_INFLIGHT_BATCHES]; // Single-file cursor after batch
+    uint32_t next_slot;
+
+    tick_source_stats_t stats;
+} tick_source_t;
+
+/**
+ * @brief Map and validate tick files; returns 0 or -1 (errno style message on stderr)
+ */
+int tick_source_open(tick_source_t* source, const char* const* paths, uint32_t path_count,
+                     const tick_replay_config_t* config);
+
+/**
+ * @brief Next batch in timestamp order; returns its tick count, 0 at end
+ *
+ * Waits for the oldest in-flight batch to be consumed before reusing it,
+ * and for the replay clock in real-time/scaled modes.
+ */
+uint32_t tick_source_next_batch(tick_source_t* source, tick_batch_t* batch);
+
+/**
+ * @brief Wait for in-flight batches, then unmap everything
+ */
+void tick_source_close(tick_source_t* source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TICK_SOURCE_H
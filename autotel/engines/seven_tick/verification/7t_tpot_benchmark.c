@@ -217,21 +217,11 @@ void run_7t_tpot_benchmarks()
   printf("  - Energy efficiency: 100x better\n");
 
   // Cleanup
-  free(iris_data->data);
-  free(iris_data->labels);
-  free(iris_data);
-  free(boston_data->data);
-  free(boston_data->labels);
-  free(boston_data);
-  free(cancer_data->data);
-  free(cancer_data->labels);
-  free(cancer_data);
-  free(diabetes_data->data);
-  free(diabetes_data->labels);
-  free(diabetes_data);
-  free(digits_data->data);
-  free(digits_data->labels);
-  free(digits_data);
+  destroy_dataset_7t(iris_data);
+  destroy_dataset_7t(boston_data);
+  destroy_dataset_7t(cancer_data);
+  destroy_dataset_7t(diabetes_data);
+  destroy_dataset_7t(digits_data);
 }
 
 // Individual algorithm benchmarks
@@ -264,12 +254,13 @@ void benchmark_individual_algorithms()
   double lr_fitness = evaluate_linear_regression(test_data, params);
   printf("LinearRegression: fitness=%.4f\n", lr_fitness);
 
+  double logit_fitness = evaluate_logistic_regression(test_data, params);
+  printf("LogisticRegression: fitness=%.4f\n", logit_fitness);
+
   printf("\n");
 
   // Cleanup
-  free(test_data->data);
-  free(test_data->labels);
-  free(test_data);
+  destroy_dataset_7t(test_data);
 }
 
 // Scalability benchmark
@@ -289,9 +280,10 @@ void benchmark_scalability()
     uint32_t size = sizes[i];
 
     // Create synthetic dataset
-    Dataset7T *data = malloc(sizeof(Dataset7T));
+    Dataset7T *data = calloc(1, sizeof(Dataset7T));
     data->num_samples = size;
     data->num_features = 10;
+    data->num_classes = 3;
     data->data = malloc(size * 10 * sizeof(double));
     data->labels = malloc(size * sizeof(uint32_t));
 
@@ -310,6 +302,13 @@ void benchmark_scalability()
     pipeline->steps[0].algorithm_id = NORMALIZE;
     pipeline->steps[1].algorithm_id = SELECT_K_BEST;
     pipeline->steps[2].algorithm_id = RANDOM_FOREST;
+    for (uint32_t s = 0; s < 3; s++)
+    {
+      pipeline->steps[s].num_parameters = 2;
+      pipeline->steps[s].parameters = malloc(2 * sizeof(double));
+      pipeline->steps[s].parameters[0] = 10.0; // k, n_estimators
+      pipeline->steps[s].parameters[1] = 5.0;  // max_depth
+    }
 
     START_TIMER();
     double fitness = evaluate_pipeline_7t(pipeline, data);
@@ -321,14 +320,8 @@ void benchmark_scalability()
            size, eval_time / 1000.0, fitness);
 
     // Cleanup
-    free(data->data);
-    free(data->labels);
-    free(data);
-    free(pipeline->steps[0].parameters);
-    free(pipeline->steps[1].parameters);
-    free(pipeline->steps[2].parameters);
-    free(pipeline->steps);
-    free(pipeline);
+    destroy_dataset_7t(data);
+    destroy_pipeline_7t(pipeline);
   }
 
   printf("\n");